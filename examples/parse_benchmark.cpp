@@ -7,10 +7,35 @@
 
 #include "examples.hpp"
 #include <toml++/toml.hpp>
+#include <cmath>
+#include <cstdio>
 
 using namespace std::string_view_literals;
 
-static constexpr size_t iterations = 10000;
+static constexpr size_t default_iterations = 10000;
+
+template <typename Func>
+static void run_benchmark(std::string_view name, Func&& func, size_t iterations = default_iterations)
+{
+	using clock = std::chrono::steady_clock;
+
+	auto fastest = clock::duration::max();
+	const auto start = clock::now();
+	for (size_t i = 0; i < iterations; i++)
+	{
+		const auto iteration_start = clock::now();
+		func();
+		fastest = (std::min)(fastest, clock::now() - iteration_start);
+	}
+	const auto cumulative_sec =
+		std::chrono::duration_cast<std::chrono::duration<double>>(clock::now() - start).count();
+	const auto mean_sec	   = cumulative_sec / static_cast<double>(iterations);
+	const auto fastest_sec = std::chrono::duration_cast<std::chrono::duration<double>>(fastest).count();
+	std::cout << name << ":\n"sv
+			  << "    total: "sv << cumulative_sec << " s\n"sv
+			  << "     mean: "sv << mean_sec << " s\n"sv
+			  << "  fastest: "sv << fastest_sec << " s\n"sv;
+}
 
 int main(int argc, char** argv)
 {
@@ -65,17 +90,159 @@ int main(int argc, char** argv)
 #endif
 	}
 
-	// run the benchmark
-	std::cout << "Parsing '"sv << file_path << "' "sv << iterations << " times...\n"sv;
+	// run the benchmarks
+	std::cout << "Parsing '"sv << file_path << "' "sv << default_iterations << " times...\n"sv;
 
-	const auto start = std::chrono::steady_clock::now();
-	for (size_t i = 0; i < iterations; i++)
-		std::ignore = toml::parse(file_content, file_path);
-	const auto cumulative_sec =
-		std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
-	const auto mean_sec = cumulative_sec / static_cast<double>(iterations);
-	std::cout << "  total: "sv << cumulative_sec << " s\n"sv
-			  << "   mean: "sv << mean_sec << " s\n"sv;
+	run_benchmark("string"sv, [&]() { std::ignore = toml::parse(file_content, file_path); });
+
+	std::istringstream stream;
+	run_benchmark("stream"sv,
+				  [&]()
+				  {
+					  stream.clear();
+					  stream.str(file_content);
+					  std::ignore = toml::parse(stream, file_path);
+				  });
+
+	// floats in isolation, compared with the locale-independent stringstream approach toml++ used to take
+	{
+		std::vector<std::string> literals;
+		std::string float_doc;
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		for (size_t i = 0; i < 1000; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+
+			char buf[64];
+			const auto mantissa = static_cast<double>(state >> 11) / static_cast<double>(1ull << 53);
+			const auto exponent = static_cast<int>(state % 61u) - 30;
+			std::snprintf(buf, sizeof(buf), "%.*e", static_cast<int>(i % 17u), mantissa * std::pow(10.0, exponent));
+			literals.emplace_back(buf);
+
+			float_doc += "f";
+			float_doc += std::to_string(i);
+			float_doc += " = ";
+			float_doc += buf;
+			float_doc += "\n";
+		}
+
+		constexpr size_t float_iterations = default_iterations / 10u;
+		std::cout << "Parsing "sv << literals.size() << " floats "sv << float_iterations << " times...\n"sv;
+
+		run_benchmark(
+			"floats"sv,
+			[&]() { std::ignore = toml::parse(float_doc); },
+			float_iterations);
+
+		std::istringstream float_stream;
+		float_stream.imbue(std::locale::classic());
+		run_benchmark(
+			"floats (stringstream)"sv,
+			[&]()
+			{
+				double sum = {};
+				for (const auto& literal : literals)
+				{
+					float_stream.clear();
+					float_stream.str(literal);
+					double val;
+					float_stream >> val;
+					sum += val;
+				}
+				std::ignore = sum;
+			},
+			float_iterations);
+	}
+
+	// a number-heavy document, parsed from memory (where values are classified and converted in one pass) and
+	// from a stream (where they're scanned ahead to be classified first, then converted)
+	{
+		std::string number_doc;
+		uint64_t state = 0x2545F4914F6CDD1Dull;
+		for (size_t i = 0; i < 100; i++)
+		{
+			number_doc += "n";
+			number_doc += std::to_string(i);
+			number_doc += " = [";
+			for (size_t j = 0; j < 50; j++)
+			{
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+
+				char buf[64];
+				switch (state % 4u)
+				{
+					case 0: std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(state >> 40) - (1 << 23)); break;
+					case 1:
+						std::snprintf(buf, sizeof(buf), "0x%llX", static_cast<unsigned long long>(state >> 20));
+						break;
+					case 2: std::snprintf(buf, sizeof(buf), "%.6f", static_cast<double>(state >> 44) / 1000.0); break;
+					default:
+						std::snprintf(buf, sizeof(buf), "%.15e", static_cast<double>(state >> 11) * 1e-10);
+						break;
+				}
+				number_doc += j ? ", " : "";
+				number_doc += buf;
+			}
+			number_doc += "]\n";
+		}
+
+		constexpr size_t number_iterations = default_iterations / 10u;
+		std::cout << "Parsing 5000 numbers "sv << number_iterations << " times...\n"sv;
+
+		run_benchmark(
+			"numbers (string)"sv,
+			[&]() { std::ignore = toml::parse(number_doc); },
+			number_iterations);
+
+		std::istringstream number_stream;
+		run_benchmark(
+			"numbers (stream)"sv,
+			[&]()
+			{
+				number_stream.clear();
+				number_stream.str(number_doc);
+				std::ignore = toml::parse(number_stream);
+			},
+			number_iterations);
+	}
+
+	// lots of small documents, with and without a parse_context keeping the parser's buffers around between them
+	{
+		constexpr auto payload = R"(id = "3f2b9c1e"
+timestamp = 2024-03-01T12:34:56Z
+[source]
+host = "worker-17.example.com"
+tags = [ "ingest", "batch", "retry" ]
+[metrics]
+count = 1234
+mean.value = 42.5
+mean.unit = "ms"
+)"sv;
+
+		constexpr size_t payload_iterations = default_iterations * 10u;
+		std::cout << "Parsing a small document "sv << payload_iterations << " times...\n"sv;
+
+		run_benchmark(
+			"small (parse)"sv,
+			[&]() { std::ignore = toml::parse(payload); },
+			payload_iterations);
+
+		toml::parse_context ctx;
+		run_benchmark(
+			"small (parse_context)"sv,
+			[&]() { std::ignore = ctx.parse(payload); },
+			payload_iterations);
+
+		toml::parse_context arena_ctx{ toml::parse_flags::arena_allocation };
+		run_benchmark(
+			"small (parse_context + arena)"sv,
+			[&]() { std::ignore = arena_ctx.parse(payload); },
+			payload_iterations);
+	}
 
 	return 0;
 }
@@ -0,0 +1,128 @@
+// This file is a part of toml++ and is subject to the the terms of the MIT license.
+// Copyright (c) Mark Gillard <mark.gillard@outlook.com.au>
+// See https://github.com/marzer/tomlplusplus/blob/master/LICENSE for the full license text.
+// SPDX-License-Identifier: MIT
+
+// This example is a short benchmark of toml::table lookups, insertions, iteration and traversal.
+// Build it with and without TOML_ENABLE_FLAT_TABLES=1 to compare the two storage policies.
+
+#include "examples.hpp"
+#include <toml++/toml.hpp>
+#include <cstdio>
+
+using namespace std::string_view_literals;
+
+static constexpr size_t default_iterations = 1000;
+
+template <typename Func>
+static void run_benchmark(std::string_view name, Func&& func, size_t iterations = default_iterations)
+{
+	using clock = std::chrono::steady_clock;
+
+	auto fastest	 = clock::duration::max();
+	const auto start = clock::now();
+	for (size_t i = 0; i < iterations; i++)
+	{
+		const auto iteration_start = clock::now();
+		func();
+		fastest = (std::min)(fastest, clock::now() - iteration_start);
+	}
+	const auto cumulative_sec =
+		std::chrono::duration_cast<std::chrono::duration<double>>(clock::now() - start).count();
+	const auto mean_sec	   = cumulative_sec / static_cast<double>(iterations);
+	const auto fastest_sec = std::chrono::duration_cast<std::chrono::duration<double>>(fastest).count();
+	std::cout << name << ":\n"sv
+			  << "    total: "sv << cumulative_sec << " s\n"sv
+			  << "     mean: "sv << mean_sec << " s\n"sv
+			  << "  fastest: "sv << fastest_sec << " s\n"sv;
+}
+
+int main(int argc, char** argv)
+{
+	const auto key_count = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : size_t{ 512 };
+
+	std::vector<std::string> keys;
+	keys.reserve(key_count);
+	for (size_t i = 0; i < key_count; i++)
+	{
+		// scramble the order a bit so inserts aren't all appends
+		char buf[32];
+		std::snprintf(buf, sizeof(buf), "key_%08zx", (i * 2654435761u) % 0xFFFFFFFFu);
+		keys.emplace_back(buf);
+	}
+
+	std::cout << "toml::table with "sv << key_count << " keys"sv
+#if TOML_ENABLE_FLAT_TABLES
+			  << " (flat tables)"sv
+#endif
+			  << "\n"sv;
+
+	toml::table tbl;
+	run_benchmark("insert"sv,
+				  [&]()
+				  {
+					  toml::table t;
+					  for (const auto& k : keys)
+						  t.insert(k, 1);
+					  tbl = std::move(t);
+				  });
+
+	size_t hits = 0;
+	run_benchmark("lookup"sv,
+				  [&]()
+				  {
+					  for (const auto& k : keys)
+						  hits += tbl.get(k) ? 1u : 0u;
+				  });
+
+	int64_t sum = 0;
+	run_benchmark("iterate"sv,
+				  [&]()
+				  {
+					  for (auto&& [k, v] : tbl)
+						  sum += *v.value<int64_t>();
+				  });
+
+	// a few levels of nesting, looked up via tbl["x"]["y"]["z"]
+	toml::table nested;
+	for (size_t i = 0; i < 16u && i < keys.size(); i++)
+	{
+		toml::table inner;
+		for (size_t j = 0; j < 16u && j < keys.size(); j++)
+			inner.insert(keys[j], toml::table{ { "value"sv, static_cast<int64_t>(j) } });
+		nested.insert(keys[i], std::move(inner));
+	}
+	run_benchmark("nested lookup"sv,
+				  [&]()
+				  {
+					  for (size_t i = 0; i < 16u && i < keys.size(); i++)
+						  for (size_t j = 0; j < 16u && j < keys.size(); j++)
+							  sum += nested[keys[i]][keys[j]]["value"sv].value_or(int64_t{});
+				  });
+
+	// walks the whole tree, dispatching on each node's type
+	size_t leaves = 0;
+	const auto traverse = [&](auto&& self, const toml::node& n) -> void
+	{
+		n.visit(
+			[&](auto&& elem)
+			{
+				if constexpr (toml::is_table<decltype(elem)>)
+				{
+					for (auto&& [k, v] : elem)
+						self(self, v);
+				}
+				else if constexpr (toml::is_array<decltype(elem)>)
+				{
+					for (auto&& v : elem)
+						self(self, v);
+				}
+				else
+					leaves += elem.is_integer() ? 1u : 0u;
+			});
+	};
+	run_benchmark("traverse"sv, [&]() { traverse(traverse, nested); });
+
+	std::cout << "(checksum: "sv << hits << ", "sv << sum << ", "sv << leaves << ")\n"sv;
+	return 0;
+}
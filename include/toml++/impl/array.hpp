@@ -6,6 +6,8 @@
 
 #include "std_utility.hpp"
 #include "std_vector.hpp"
+#include "std_atomic.hpp"
+#include "std_mutex.hpp"
 #include "std_initializer_list.hpp"
 #include "value.hpp"
 #include "make_node.hpp"
@@ -34,6 +36,323 @@
 /// \cond
 TOML_IMPL_NAMESPACE_START
 {
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
+
+#if TOML_ENABLE_PMR
+	using array_vector = std::pmr::vector<node_ptr>;
+#else
+	using array_vector = std::vector<node_ptr>;
+#endif
+
+	// a scalar value stored in a compact array without a node (see parse_flags::compact_arrays)
+	struct compact_value
+	{
+		union
+		{
+			int64_t integer;
+			double floating_point;
+			bool boolean;
+			toml::time time; // time, date_time
+		};
+		toml::date date;		// date, date_time
+		int16_t offset_minutes; // date_time
+		bool has_offset;		// date_time
+		node_type type;			// anything but none, table, array or string
+
+		// (returns false if the node can't be stored as a compact_value; value_flags are not kept)
+		TOML_NODISCARD
+		bool assign(const node& n) noexcept
+		{
+			type = n.type();
+			switch (type)
+			{
+				case node_type::integer: integer = n.as_integer()->get(); return true;
+				case node_type::floating_point: floating_point = n.as_floating_point()->get(); return true;
+				case node_type::boolean: boolean = n.as_boolean()->get(); return true;
+				case node_type::date: date = n.as_date()->get(); return true;
+				case node_type::time: time = n.as_time()->get(); return true;
+
+				case node_type::date_time:
+				{
+					const auto& dt = n.as_date_time()->get();
+					date		   = dt.date;
+					time		   = dt.time;
+					has_offset	   = !!dt.offset;
+					offset_minutes = dt.offset ? dt.offset->minutes : int16_t{};
+					return true;
+				}
+
+				default: return false;
+			}
+		}
+
+		TOML_PURE_GETTER
+		friend bool operator==(const compact_value& lhs, const compact_value& rhs) noexcept
+		{
+			if (lhs.type != rhs.type)
+				return false;
+			switch (lhs.type)
+			{
+				case node_type::integer: return lhs.integer == rhs.integer;
+				case node_type::boolean: return lhs.boolean == rhs.boolean;
+				case node_type::date: return lhs.date == rhs.date;
+				case node_type::time: return lhs.time == rhs.time;
+
+				case node_type::floating_point:
+				{
+					// (same semantics as value<double>'s equality operators)
+					const auto lhs_nan = impl::fpclassify(lhs.floating_point) == impl::fp_class::nan;
+					const auto rhs_nan = impl::fpclassify(rhs.floating_point) == impl::fp_class::nan;
+					if (lhs_nan || rhs_nan)
+						return lhs_nan == rhs_nan;
+					return lhs.floating_point == rhs.floating_point;
+				}
+
+				case node_type::date_time:
+					return lhs.date == rhs.date && lhs.time == rhs.time && lhs.has_offset == rhs.has_offset
+						&& (!lhs.has_offset || lhs.offset_minutes == rhs.offset_minutes);
+
+				default: TOML_UNREACHABLE;
+			}
+		}
+	};
+	static_assert(std::is_trivially_copyable_v<compact_value>);
+
+	// the values of a packed array (see parse_flags::packed_arrays), stored contiguously instead of as nodes.
+	// allocated from the array's memory resource, the same as its nodes.
+	//
+	// the nodes are created from the values the first time something needs them, which can be through a const
+	// reference, and so from several threads at once; they're created exactly once (see array::create_packed_nodes()),
+	// and kept here until the array is next modified, at which point they're moved into the array.
+	struct packed_array_storage
+	{
+		node_type type; // integer, floating_point or boolean, or none for compact_values (parse_flags::compact_arrays)
+		size_t size				  = {};
+		size_t capacity			  = {};
+		void* data				  = {};
+		memory_resource* resource = {}; // null means the global heap
+
+		array_vector nodes; // empty until nodes_created is set
+		std::once_flag nodes_once;
+		std::atomic<bool> nodes_created = { false };
+
+		// packed integers, floats and booleans are kept until the array is next modified (there may be spans of them
+		// in use), but compact_values aren't needed once the nodes exist. const member functions reading them hold a
+		// reference, as does the storage itself until the nodes are created; whoever drops the last one releases them.
+		mutable std::atomic<uint32_t> value_refs = { 1u };
+
+		struct deleter
+		{
+			void operator()(packed_array_storage* storage) const noexcept
+			{
+				const auto resource = storage->resource;
+				storage->~packed_array_storage();
+				deallocate(resource, storage, sizeof(packed_array_storage), alignof(packed_array_storage));
+			}
+		};
+		using ptr = std::unique_ptr<packed_array_storage, deleter>;
+
+		TOML_NODISCARD
+		static ptr create(node_type t, memory_resource* resource)
+		{
+			return ptr{ ::new (allocate(resource, sizeof(packed_array_storage), alignof(packed_array_storage)))
+							packed_array_storage{ t, resource } };
+		}
+
+		// (copies the values, not the nodes)
+		TOML_NODISCARD
+		ptr clone(memory_resource* into) const
+		{
+			auto copy = create(type, into);
+			copy->reserve(size);
+			if (size)
+				std::memcpy(copy->data, data, size * element_size());
+			copy->size = size;
+			return copy;
+		}
+
+		packed_array_storage(const packed_array_storage&) = delete;
+		packed_array_storage& operator=(const packed_array_storage&) = delete;
+
+		~packed_array_storage() noexcept
+		{
+			if (data && !values_released())
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool has_nodes() const noexcept
+		{
+			return nodes_created.load(std::memory_order_acquire);
+		}
+
+		// (only meaningful outside of const member functions; see above)
+		TOML_PURE_INLINE_GETTER
+		bool values_released() const noexcept
+		{
+			return type == node_type::none && !value_refs.load(std::memory_order_acquire);
+		}
+
+		// returns false if the values have been released, in which case the nodes should be used instead
+		TOML_NODISCARD
+		bool begin_reading() const noexcept
+		{
+			if (type != node_type::none)
+				return true;
+
+			for (auto refs = value_refs.load(std::memory_order_relaxed); refs;)
+				if (value_refs.compare_exchange_weak(refs, refs + 1u, std::memory_order_acquire))
+					return true;
+			return false;
+		}
+
+		void end_reading() const noexcept
+		{
+			if (type == node_type::none && value_refs.fetch_sub(1u, std::memory_order_acq_rel) == 1u && data)
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t element_size() const noexcept
+		{
+			static_assert(sizeof(double) == sizeof(int64_t));
+			switch (type)
+			{
+				case node_type::none: return sizeof(compact_value);
+				case node_type::boolean: return sizeof(bool);
+				default: return sizeof(int64_t);
+			}
+		}
+
+		void reserve(size_t new_capacity)
+		{
+			if (new_capacity <= capacity)
+				return;
+
+			const auto new_data = allocate(resource, new_capacity * element_size(), alignof(compact_value));
+			if (size)
+				std::memcpy(new_data, data, size * element_size());
+			if (data)
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+			data	 = new_data;
+			capacity = new_capacity;
+		}
+
+		template <typename T>
+		void push_back(T val)
+		{
+			TOML_ASSERT(type == node_type_of<T>);
+
+			if (size == capacity)
+				reserve(capacity ? capacity * 2u : 8u);
+			::new (static_cast<void*>(static_cast<T*>(data) + size)) T{ val };
+			size++;
+		}
+
+		template <typename T>
+		TOML_PURE_INLINE_GETTER
+		const T* values() const noexcept
+		{
+			TOML_ASSERT(type == node_type_of<T>);
+
+			return static_cast<const T*>(data);
+		}
+
+		TOML_PURE_GETTER
+		bool is_homogeneous(node_type ntype) const noexcept
+		{
+			if (!size)
+				return false;
+			if (type != node_type::none)
+				return ntype == node_type::none || ntype == type;
+
+			const auto vals = values<compact_value>();
+			if (ntype == node_type::none)
+				ntype = vals[0].type;
+			for (size_t i = 0; i < size; i++)
+				if (vals[i].type != ntype)
+					return false;
+			return true;
+		}
+
+		// returns the value at the given index as a compact_value, whichever way the values are stored
+		TOML_PURE_GETTER
+		compact_value get(size_t index) const noexcept
+		{
+			TOML_ASSERT(index < size);
+
+			compact_value val;
+			val.type = type;
+			switch (type)
+			{
+				case node_type::none: return values<compact_value>()[index];
+				case node_type::integer: val.integer = values<int64_t>()[index]; break;
+				case node_type::floating_point: val.floating_point = values<double>()[index]; break;
+				case node_type::boolean: val.boolean = values<bool>()[index]; break;
+				default: TOML_UNREACHABLE;
+			}
+			return val;
+		}
+
+		// switches packed integers, floats or booleans to compact_values (so values of other types can be added)
+		void convert_to_compact()
+		{
+			if (type == node_type::none)
+				return;
+
+			const auto new_capacity = (std::max)(capacity, size_t{ 8u });
+			const auto new_data		= static_cast<compact_value*>(
+				allocate(resource, new_capacity * sizeof(compact_value), alignof(compact_value)));
+			for (size_t i = 0; i < size; i++)
+				::new (static_cast<void*>(new_data + i)) compact_value{ get(i) };
+
+			if (data)
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+			data	 = new_data;
+			capacity = new_capacity;
+			type	 = node_type::none;
+		}
+
+	  private:
+		TOML_NODISCARD_CTOR
+		packed_array_storage(node_type t, memory_resource* r) noexcept //
+			: type{ t },
+			  resource{ r }
+#if TOML_ENABLE_PMR
+			  ,
+			  nodes{ r ? r : std::pmr::get_default_resource() }
+#endif
+		{
+			TOML_ASSERT_ASSUME(t == node_type::none || t == node_type::integer || t == node_type::floating_point
+							   || t == node_type::boolean);
+		}
+
+		TOML_NODISCARD
+		static void* allocate([[maybe_unused]] memory_resource* resource, size_t size, [[maybe_unused]] size_t align)
+		{
+#if TOML_ENABLE_PMR
+			if (resource)
+				return resource->allocate(size, align);
+#endif
+			return ::operator new(size);
+		}
+
+		static void deallocate([[maybe_unused]] memory_resource* resource,
+							   void* ptr,
+							   [[maybe_unused]] size_t size,
+							   [[maybe_unused]] size_t align) noexcept
+		{
+#if TOML_ENABLE_PMR
+			if (resource)
+			{
+				resource->deallocate(ptr, size, align);
+				return;
+			}
+#endif
+			::operator delete(ptr);
+		}
+	};
+
 	template <bool IsConst>
 	class TOML_TRIVIAL_ABI array_iterator
 	{
@@ -41,8 +360,8 @@ TOML_IMPL_NAMESPACE_START
 		template <bool>
 		friend class array_iterator;
 
-		using mutable_vector_iterator = std::vector<node_ptr>::iterator;
-		using const_vector_iterator	  = std::vector<node_ptr>::const_iterator;
+		using mutable_vector_iterator = array_vector::iterator;
+		using const_vector_iterator	  = array_vector::const_iterator;
 		using vector_iterator		  = std::conditional_t<IsConst, const_vector_iterator, mutable_vector_iterator>;
 
 		mutable vector_iterator iter_;
@@ -219,6 +538,8 @@ TOML_IMPL_NAMESPACE_START
 			: value{ make_node(static_cast<T&&>(val), flags) }
 		{}
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_IMPL_NAMESPACE_END;
 /// \endcond
@@ -231,6 +552,79 @@ TOML_NAMESPACE_START
 	/// \brief A RandomAccessIterator for iterating over const elements in a toml::array.
 	using const_array_iterator = POXY_IMPLEMENTATION_DETAIL(impl::array_iterator<true>);
 
+	/// \brief	A read-only view of a contiguous run of values, in the style of `std::span<const T>`.
+	///
+	/// \detail Returned by toml::array::packed().
+	template <typename T>
+	class packed_span
+	{
+	  private:
+		const T* data_ = {};
+		size_t size_   = {};
+
+	  public:
+		using element_type	 = const T;
+		using value_type	 = T;
+		using size_type		 = size_t;
+		using iterator		 = const T*;
+		using const_iterator = const T*;
+
+		/// \brief	Constructs an empty view.
+		TOML_NODISCARD_CTOR
+		constexpr packed_span() noexcept = default;
+
+		/// \brief	Constructs a view of `size` values starting at `data`.
+		TOML_NODISCARD_CTOR
+		constexpr packed_span(const T* data, size_t size) noexcept //
+			: data_{ data },
+			  size_{ size }
+		{}
+
+		/// \brief	Returns a pointer to the first value.
+		TOML_PURE_INLINE_GETTER
+		constexpr const T* data() const noexcept
+		{
+			return data_;
+		}
+
+		/// \brief	Returns the number of values.
+		TOML_PURE_INLINE_GETTER
+		constexpr size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		/// \brief	Returns true if there are no values.
+		TOML_PURE_INLINE_GETTER
+		constexpr bool empty() const noexcept
+		{
+			return !size_;
+		}
+
+		/// \brief	Returns the value at the given index (without bounds checking).
+		TOML_PURE_INLINE_GETTER
+		constexpr const T& operator[](size_t index) const noexcept
+		{
+			return data_[index];
+		}
+
+		/// \brief	Returns an iterator to the first value.
+		TOML_PURE_INLINE_GETTER
+		constexpr const T* begin() const noexcept
+		{
+			return data_;
+		}
+
+		/// \brief	Returns an iterator to one-past-the-last value.
+		TOML_PURE_INLINE_GETTER
+		constexpr const T* end() const noexcept
+		{
+			return data_ + size_;
+		}
+	};
+
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
+
 	/// \brief	A TOML array.
 	///
 	/// \detail The interface of this type is modeled after std::vector, with some
@@ -286,10 +680,16 @@ TOML_NAMESPACE_START
 	  private:
 		/// \cond
 
-		using vector_type			= std::vector<impl::node_ptr>;
+		template <typename>
+		friend class TOML_PARSER_TYPENAME;
+
+		using vector_type			= impl::array_vector;
 		using vector_iterator		= typename vector_type::iterator;
 		using const_vector_iterator = typename vector_type::const_iterator;
-		vector_type elems_;
+
+		impl::arena_ref arena_; // the arena the nodes are in, if any (declared before elems_ so it outlives them)
+		vector_type elems_;		// empty while the array is packed
+		impl::packed_array_storage::ptr packed_;
 
 		TOML_NODISCARD_CTOR
 		TOML_EXPORTED_MEMBER_FUNCTION
@@ -300,6 +700,17 @@ TOML_NAMESPACE_START
 			: array{ elems.begin(), elems.end() }
 		{}
 
+		// the resource new child nodes are allocated from (null means the global heap)
+		TOML_PURE_INLINE_GETTER
+		impl::memory_resource* node_resource() const noexcept
+		{
+#if TOML_ENABLE_PMR
+			return elems_.get_allocator().resource();
+#else
+			return nullptr;
+#endif
+		}
+
 		TOML_EXPORTED_MEMBER_FUNCTION
 		void preinsertion_resize(size_t idx, size_t count);
 
@@ -317,7 +728,7 @@ TOML_NAMESPACE_START
 				if (!val)
 					return;
 			}
-			insert_at_back(impl::make_node(static_cast<T&&>(val), flags));
+			insert_at_back(impl::make_node(static_cast<T&&>(val), flags, node_resource()));
 		}
 
 		TOML_NODISCARD
@@ -325,7 +736,32 @@ TOML_NAMESPACE_START
 		size_t total_leaf_count() const noexcept;
 
 		TOML_EXPORTED_MEMBER_FUNCTION
-		void flatten_child(array&& child, size_t& dest_index) noexcept;
+		void flatten_child(array&& child, size_t& dest_index);
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void create_packed_nodes() const;
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void release_packed_storage();
+
+		// the elements as nodes, for anything only reading them (a packed array's are created the first time)
+		TOML_ALWAYS_INLINE
+		const vector_type& elem_nodes() const
+		{
+			if TOML_LIKELY(!packed_)
+				return elems_;
+			if TOML_UNLIKELY(!packed_->has_nodes())
+				create_packed_nodes();
+			return packed_->nodes;
+		}
+
+		// for anything that might modify the elements (or hand out something that can)
+		TOML_ALWAYS_INLINE
+		void unpack()
+		{
+			if TOML_UNLIKELY(packed_)
+				release_packed_storage();
+		}
 
 		/// \endcond
 
@@ -350,10 +786,53 @@ TOML_NAMESPACE_START
 		array(const array&);
 
 		/// \brief	Move constructor.
+		///
+		/// \remarks	Moving an array out of a document parsed with parse_flags::arena_allocation takes its nodes
+		/// 			along with a reference to the document's arena, which stays alive as long as either needs it.
 		TOML_NODISCARD_CTOR
 		TOML_EXPORTED_MEMBER_FUNCTION
 		array(array&& other) noexcept;
 
+#if TOML_ENABLE_PMR
+
+		/// \brief	The polymorphic allocator type used by arrays.
+		///
+		/// \detail An array allocates its element storage from the allocator's memory resource, as well as any
+		/// 		tables, arrays and values it creates for its elements (e.g. in push_back(), emplace_back() or when
+		/// 		being copied). Child tables and arrays created this way use the same resource.
+		///
+		/// \availability This type (and the constructors that take it) are only available when
+		/// 		#TOML_ENABLE_PMR is enabled.
+		using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+		/// \brief	Constructs an empty array that allocates from the given allocator's memory resource.
+		///
+		/// \remarks The memory resource must outlive the array and every node it allocates.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit array(const allocator_type& alloc) noexcept;
+
+		/// \brief	Copy constructor that allocates the copy from the given allocator's memory resource.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		array(const array& other, const allocator_type& alloc);
+
+		/// \brief	Move constructor that allocates from the given allocator's memory resource.
+		///
+		/// \remarks If `other` uses a different memory resource its contents are copied instead of moved.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		array(array&& other, const allocator_type& alloc);
+
+		/// \brief	Returns the array's allocator.
+		TOML_PURE_INLINE_GETTER
+		allocator_type get_allocator() const noexcept
+		{
+			return allocator_type{ elems_.get_allocator().resource() };
+		}
+
+#endif
+
 		/// \brief	Constructs an array with one or more initial elements.
 		///
 		/// \detail \cpp
@@ -386,7 +865,9 @@ TOML_NAMESPACE_START
 		/// \tparam	ElemTypes	One of the TOML node or value types (or a type promotable to one).
 		/// \param 	val 	The node or value used to initialize element 0.
 		/// \param 	vals	The nodes or values used to initialize elements 1...N.
-		TOML_CONSTRAINED_TEMPLATE((sizeof...(ElemTypes) > 0 || !std::is_same_v<impl::remove_cvref<ElemType>, array>),
+		TOML_CONSTRAINED_TEMPLATE((sizeof...(ElemTypes) > 0 || !std::is_same_v<impl::remove_cvref<ElemType>, array>)
+									  && !impl::is_node_allocator_arg<ElemType>
+									  && !(impl::is_node_allocator_arg<ElemTypes> || ...),
 								  typename ElemType,
 								  typename... ElemTypes)
 		TOML_NODISCARD_CTOR
@@ -401,15 +882,23 @@ TOML_NAMESPACE_START
 		array& operator=(const array&);
 
 		/// \brief	Move-assignment operator.
+		///
+		/// \remarks	\parblock Moving from an array in a document parsed with parse_flags::arena_allocation takes its
+		/// 			nodes along with a reference to the document's arena (see the move constructor). `rhs` may
+		/// 			be one of this array's descendants.
+		///
+		/// 			With #TOML_ENABLE_PMR the array keeps its own allocator, so if `rhs` uses a different memory
+		/// 			resource its elements are copied instead, which can throw.
+		/// \endparblock
 		TOML_EXPORTED_MEMBER_FUNCTION
-		array& operator=(array&& rhs) noexcept;
+		array& operator=(array&& rhs) noexcept(!TOML_ENABLE_PMR);
 
 		/// \name Type checks
 		/// @{
 
 		/// \brief Returns #toml::node_type::array.
 		TOML_CONST_INLINE_GETTER
-		node_type type() const noexcept final
+		node_type type() const noexcept
 		{
 			return node_type::array;
 		}
@@ -442,14 +931,14 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_table() const noexcept final
+		bool is_table() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `true`.
 		TOML_CONST_INLINE_GETTER
-		bool is_array() const noexcept final
+		bool is_array() const noexcept
 		{
 			return true;
 		}
@@ -463,63 +952,63 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_value() const noexcept final
+		bool is_value() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_string() const noexcept final
+		bool is_string() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_integer() const noexcept final
+		bool is_integer() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_floating_point() const noexcept final
+		bool is_floating_point() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_number() const noexcept final
+		bool is_number() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_boolean() const noexcept final
+		bool is_boolean() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_date() const noexcept final
+		bool is_date() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_time() const noexcept final
+		bool is_time() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_date_time() const noexcept final
+		bool is_date_time() const noexcept
 		{
 			return false;
 		}
@@ -531,126 +1020,126 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		table* as_table() noexcept final
+		table* as_table() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns a pointer to the array.
 		TOML_CONST_INLINE_GETTER
-		array* as_array() noexcept final
+		array* as_array() noexcept
 		{
 			return this;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<std::string>* as_string() noexcept final
+		toml::value<std::string>* as_string() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<int64_t>* as_integer() noexcept final
+		toml::value<int64_t>* as_integer() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<double>* as_floating_point() noexcept final
+		toml::value<double>* as_floating_point() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<bool>* as_boolean() noexcept final
+		toml::value<bool>* as_boolean() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<date>* as_date() noexcept final
+		toml::value<date>* as_date() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<time>* as_time() noexcept final
+		toml::value<time>* as_time() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<date_time>* as_date_time() noexcept final
+		toml::value<date_time>* as_date_time() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const table* as_table() const noexcept final
+		const table* as_table() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns a const-qualified pointer to the array.
 		TOML_CONST_INLINE_GETTER
-		const array* as_array() const noexcept final
+		const array* as_array() const noexcept
 		{
 			return this;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<std::string>* as_string() const noexcept final
+		const toml::value<std::string>* as_string() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<int64_t>* as_integer() const noexcept final
+		const toml::value<int64_t>* as_integer() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<double>* as_floating_point() const noexcept final
+		const toml::value<double>* as_floating_point() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<bool>* as_boolean() const noexcept final
+		const toml::value<bool>* as_boolean() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date>* as_date() const noexcept final
+		const toml::value<date>* as_date() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<time>* as_time() const noexcept final
+		const toml::value<time>* as_time() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date_time>* as_date_time() const noexcept final
+		const toml::value<date_time>* as_date_time() const noexcept
 		{
 			return nullptr;
 		}
@@ -681,9 +1170,10 @@ TOML_NAMESPACE_START
 		/// \param 	index	The element's index.
 		///
 		/// \returns	A pointer to the element at the specified index if one existed, or nullptr.
-		TOML_PURE_INLINE_GETTER
+		TOML_NODISCARD
 		node* get(size_t index) noexcept
 		{
+			unpack();
 			return index < elems_.size() ? elems_[index].get() : nullptr;
 		}
 
@@ -692,10 +1182,11 @@ TOML_NAMESPACE_START
 		/// \param 	index	The element's index.
 		///
 		/// \returns	A pointer to the element at the specified index if one existed, or nullptr.
-		TOML_PURE_INLINE_GETTER
+		TOML_NODISCARD
 		const node* get(size_t index) const noexcept
 		{
-			return const_cast<array&>(*this).get(index);
+			const auto& nodes = elem_nodes();
+			return index < nodes.size() ? nodes[index].get() : nullptr;
 		}
 
 		/// \brief	Gets a pointer to the element at a specific index if it is a particular type.
@@ -733,7 +1224,9 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		const impl::wrap_node<ElemType>* get_as(size_t index) const noexcept
 		{
-			return const_cast<array&>(*this).template get_as<ElemType>(index);
+			if (auto val = get(index))
+				return val->template as<ElemType>();
+			return nullptr;
 		}
 
 		/// \cond
@@ -744,6 +1237,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		node& operator[](size_t index) noexcept
 		{
+			unpack();
 			return *elems_[index];
 		}
 
@@ -751,7 +1245,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		const node& operator[](size_t index) const noexcept
 		{
-			return *elems_[index];
+			return *elem_nodes()[index];
 		}
 
 		/// \brief	Gets a reference to the element at a specific index, throwing `std::out_of_range` if none existed.
@@ -761,15 +1255,14 @@ TOML_NAMESPACE_START
 
 		/// \brief	Gets a reference to the element at a specific index, throwing `std::out_of_range` if none existed.
 		TOML_NODISCARD
-		const node& at(size_t index) const
-		{
-			return const_cast<array&>(*this).at(index);
-		}
+		TOML_EXPORTED_MEMBER_FUNCTION
+		const node& at(size_t index) const;
 
 		/// \brief	Returns a reference to the first element in the array.
 		TOML_NODISCARD
 		node& front() noexcept
 		{
+			unpack();
 			return *elems_.front();
 		}
 
@@ -777,13 +1270,14 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		const node& front() const noexcept
 		{
-			return *elems_.front();
+			return *elem_nodes().front();
 		}
 
 		/// \brief	Returns a reference to the last element in the array.
 		TOML_NODISCARD
 		node& back() noexcept
 		{
+			unpack();
 			return *elems_.back();
 		}
 
@@ -791,7 +1285,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		const node& back() const noexcept
 		{
-			return *elems_.back();
+			return *elem_nodes().back();
 		}
 
 		/// @}
@@ -809,6 +1303,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		iterator begin() noexcept
 		{
+			unpack();
 			return iterator{ elems_.begin() };
 		}
 
@@ -816,20 +1311,21 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		const_iterator begin() const noexcept
 		{
-			return const_iterator{ elems_.cbegin() };
+			return const_iterator{ elem_nodes().cbegin() };
 		}
 
 		/// \brief	Returns an iterator to the first element.
 		TOML_NODISCARD
 		const_iterator cbegin() const noexcept
 		{
-			return const_iterator{ elems_.cbegin() };
+			return const_iterator{ elem_nodes().cbegin() };
 		}
 
 		/// \brief	Returns an iterator to one-past-the-last element.
 		TOML_NODISCARD
 		iterator end() noexcept
 		{
+			unpack();
 			return iterator{ elems_.end() };
 		}
 
@@ -837,14 +1333,14 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		const_iterator end() const noexcept
 		{
-			return const_iterator{ elems_.cend() };
+			return const_iterator{ elem_nodes().cend() };
 		}
 
 		/// \brief	Returns an iterator to one-past-the-last element.
 		TOML_NODISCARD
 		const_iterator cend() const noexcept
 		{
-			return const_iterator{ elems_.cend() };
+			return const_iterator{ elem_nodes().cend() };
 		}
 
 	  private:
@@ -1121,6 +1617,81 @@ TOML_NAMESPACE_START
 
 		/// @}
 
+		/// \name Packed storage
+		/// @{
+
+		/// \brief	Returns true if the array's elements are packed integers, floats or booleans, or compact values
+		/// 		(see parse_flags::compact_arrays).
+		///
+		/// \detail A packed array stores its values contiguously rather than as individual nodes. Arrays are packed
+		/// 		by parsing with parse_flags::packed_arrays or parse_flags::compact_arrays, by calling pack(), or by
+		/// 		copying a packed array.
+		/// 		Packed arrays can still be used like any other; the first time something asks for one of their
+		/// 		elements as a node, nodes are created for all of them. After that the array stays packed until
+		/// 		it's modified, or until a non-const member function that gives access to its elements is called,
+		/// 		at which point the nodes are moved into the array and the packed values are released. Appending
+		/// 		values of the same type with push_back() keeps the array packed.
+		/// 		Compact values (see parse_flags::compact_arrays) are released as soon as the nodes are created,
+		/// 		so the array doesn't hold on to both.
+		///
+		/// \remark \parblock Const member functions can be called on a packed array from several threads at
+		/// 		 once, the same as on any other array: the nodes are created exactly once, by whichever call needs
+		/// 		 them first, and any others needing them in the meantime block until they're ready. As usual,
+		/// 		 non-const member functions mustn't be called while anything else is using the array.
+		///
+		/// 		 Creating the nodes allocates. The element accessors and iterators are `noexcept` regardless, so if
+		/// 		 that allocation fails in one of them, `std::terminate()` is called. Calling a function that can
+		/// 		 throw and needs the nodes first (e.g. at()) avoids that.
+		/// \endparblock
+		TOML_PURE_INLINE_GETTER
+		bool is_packed() const noexcept
+		{
+			return !!packed_;
+		}
+
+		/// \brief	Returns the array's values as one contiguous run, without going through their nodes.
+		///
+		/// \detail \cpp
+		/// auto tbl = toml::parse("buckets = [ 1, 2, 4, 8, 16 ]"sv, ""sv, toml::parse_flags::packed_arrays);
+		/// int64_t total{};
+		/// for (auto bucket : tbl["buckets"].as_array()->packed<int64_t>())
+		/// 	total += bucket;
+		/// std::cout << total << "\n";
+		/// \ecpp
+		///
+		/// \out
+		/// 31
+		/// \eout
+		///
+		/// \tparam T	`int64_t`, `double` or `bool`.
+		///
+		/// \returns	A view of the array's values if it is packed and they are of type `T`, or an empty view.
+		///
+		/// \remarks The view remains valid until the array is modified, or a non-const member function that gives
+		/// 		 access to its elements is called.
+		template <typename T>
+		TOML_PURE_GETTER
+		packed_span<T> packed() const noexcept
+		{
+			static_assert(impl::is_one_of<T, int64_t, double, bool>,
+						  "The template type argument of array::packed() must be int64_t, double or bool");
+
+			if (packed_ && packed_->type == impl::node_type_of<T>)
+				return { packed_->values<T>(), packed_->size };
+			return {};
+		}
+
+		/// \brief	Packs the array's elements if they are all integers, all floats or all booleans.
+		///
+		/// \returns	True if the array is now packed (see is_packed()).
+		///
+		/// \remarks An array can't be packed if it's empty, or if any of its values has value_flags (e.g. an
+		/// 		 integer formatted as hexadecimal). Packing discards the elements' source regions.
+		TOML_EXPORTED_MEMBER_FUNCTION
+		bool pack();
+
+		/// @}
+
 		/// \name Size and Capacity
 		/// @{
 
@@ -1128,14 +1699,14 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		bool empty() const noexcept
 		{
-			return elems_.empty();
+			return packed_ ? !packed_->size : elems_.empty();
 		}
 
 		/// \brief	Returns the number of elements in the array.
 		TOML_NODISCARD
 		size_t size() const noexcept
 		{
-			return elems_.size();
+			return packed_ ? packed_->size : elems_.size();
 		}
 
 		/// \brief	Returns the maximum number of elements that can be stored in an array on the current platform.
@@ -1149,7 +1720,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		size_t capacity() const noexcept
 		{
-			return elems_.capacity();
+			return packed_ ? packed_->capacity : elems_.capacity();
 		}
 
 		/// \brief	Reserves internal storage capacity up to a pre-determined number of elements.
@@ -1222,8 +1793,8 @@ TOML_NAMESPACE_START
 
 			if (!new_size)
 				clear();
-			else if (new_size > elems_.size())
-				insert(cend(), new_size - elems_.size(), static_cast<ElemType&&>(default_init_val), default_init_flags);
+			else if (new_size > size())
+				insert(cend(), new_size - size(), static_cast<ElemType&&>(default_init_val), default_init_flags);
 			else
 				truncate(new_size);
 		}
@@ -1384,7 +1955,7 @@ TOML_NAMESPACE_START
 					return end();
 			}
 			return iterator{ insert_at(const_vector_iterator{ pos },
-									   impl::make_node(static_cast<ElemType&&>(val), flags)) };
+									   impl::make_node(static_cast<ElemType&&>(val), flags, node_resource())) };
 		}
 
 		/// \brief	Repeatedly inserts a new element starting at a specific position in the array.
@@ -1435,6 +2006,7 @@ TOML_NAMESPACE_START
 				if (!val)
 					return end();
 			}
+			unpack();
 			switch (count)
 			{
 				case 0: return iterator{ elems_.begin() + (const_vector_iterator{ pos } - elems_.cbegin()) };
@@ -1445,10 +2017,10 @@ TOML_NAMESPACE_START
 					preinsertion_resize(start_idx, count);
 					size_t i = start_idx;
 					for (size_t e = start_idx + count - 1u; i < e; i++)
-						elems_[i] = impl::make_node(val, flags);
+						elems_[i] = impl::make_node(val, flags, node_resource());
 
 					//# potentially move the initial value into the last element
-					elems_[i] = impl::make_node(static_cast<ElemType&&>(val), flags);
+					elems_[i] = impl::make_node(static_cast<ElemType&&>(val), flags, node_resource());
 					return iterator{ elems_.begin() + static_cast<ptrdiff_t>(start_idx) };
 				}
 			}
@@ -1471,6 +2043,7 @@ TOML_NAMESPACE_START
 		template <typename Iter>
 		iterator insert(const_iterator pos, Iter first, Iter last, value_flags flags = preserve_source_value_flags)
 		{
+			unpack();
 			const auto distance = std::distance(first, last);
 			if (distance <= 0)
 				return iterator{ elems_.begin() + (const_vector_iterator{ pos } - elems_.cbegin()) };
@@ -1497,9 +2070,9 @@ TOML_NAMESPACE_START
 							continue;
 					}
 					if constexpr (std::is_rvalue_reference_v<deref_type>)
-						elems_[i++] = impl::make_node(std::move(*it), flags);
+						elems_[i++] = impl::make_node(std::move(*it), flags, node_resource());
 					else
-						elems_[i++] = impl::make_node(*it, flags);
+						elems_[i++] = impl::make_node(*it, flags, node_resource());
 				}
 				return iterator{ elems_.begin() + static_cast<ptrdiff_t>(start_idx) };
 			}
@@ -1562,8 +2135,9 @@ TOML_NAMESPACE_START
 			static_assert(impl::is_native<type> || impl::is_one_of<type, table, array>,
 						  "Emplacement type parameter must be one of:" TOML_SA_UNWRAPPED_NODE_TYPE_LIST);
 
-			return iterator{ insert_at(const_vector_iterator{ pos },
-									   impl::node_ptr{ new impl::wrap_node<type>{ static_cast<Args&&>(args)... } }) };
+			impl::node_ptr elem{ impl::create_node<impl::wrap_node<type>>(node_resource(),
+																		  static_cast<Args&&>(args)...) };
+			return iterator{ insert_at(const_vector_iterator{ pos }, std::move(elem)) };
 		}
 
 		/// \brief	Replaces the element at a specific position in the array with a different value.
@@ -1604,8 +2178,9 @@ TOML_NAMESPACE_START
 					return end();
 			}
 
+			unpack();
 			const auto it = elems_.begin() + (const_vector_iterator{ pos } - elems_.cbegin());
-			*it			  = impl::make_node(static_cast<ElemType&&>(val), flags);
+			*it			  = impl::make_node(static_cast<ElemType&&>(val), flags, node_resource());
 			return iterator{ it };
 		}
 
@@ -1629,9 +2204,28 @@ TOML_NAMESPACE_START
 		///
 		/// \attention	No insertion takes place if the input value is a null toml::node_view.
 		/// 			This is the only circumstance in which this can occur.
+		///
+		/// \remarks	Appending a value of the same type (and without any flags) to a packed array keeps it packed
+		/// 			(see is_packed()).
 		template <typename ElemType>
 		void push_back(ElemType&& val, value_flags flags = preserve_source_value_flags)
 		{
+			using raw_elem_type = impl::remove_cvref<ElemType>;
+			if constexpr (std::is_arithmetic_v<raw_elem_type>)
+			{
+				if constexpr (impl::value_traits<raw_elem_type>::is_losslessly_convertible_to_native)
+				{
+					using native_type = impl::native_type_of<raw_elem_type>;
+					if (packed_ && packed_->type == impl::node_type_of<native_type>
+						&& !packed_->has_nodes()
+						&& (flags == value_flags::none || flags == preserve_source_value_flags))
+					{
+						packed_->push_back(static_cast<native_type>(val));
+						return;
+					}
+				}
+			}
+
 			emplace_back_if_not_empty_view(static_cast<ElemType&&>(val), flags);
 		}
 
@@ -1682,7 +2276,8 @@ TOML_NAMESPACE_START
 			}
 			else
 			{
-				auto ptr = new impl::wrap_node<unwrapped_type>{ static_cast<Args&&>(args)... };
+				auto ptr = impl::create_node<impl::wrap_node<unwrapped_type>>(node_resource(),
+																			  static_cast<Args&&>(args)...);
 				insert_at_back(impl::node_ptr{ ptr });
 				return *ptr;
 			}
@@ -1784,6 +2379,8 @@ TOML_NAMESPACE_START
 
 #endif
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_NAMESPACE_END;
 
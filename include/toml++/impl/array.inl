@@ -14,10 +14,179 @@
 #include "array.hpp"
 #include "header_start.hpp"
 
+TOML_ANON_NAMESPACE_START
+{
+	// keeps a compact array's values from being released while a const member function reads them
+	class packed_values_reader
+	{
+		const impl::packed_array_storage* storage_;
+
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit packed_values_reader(const impl::packed_array_storage* storage) noexcept //
+			: storage_{ storage && storage->begin_reading() ? storage : nullptr }
+		{}
+
+		packed_values_reader(const packed_values_reader&) = delete;
+		packed_values_reader& operator=(const packed_values_reader&) = delete;
+
+		~packed_values_reader() noexcept
+		{
+			if (storage_)
+				storage_->end_reading();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		explicit operator bool() const noexcept
+		{
+			return !!storage_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const impl::packed_array_storage& operator*() const noexcept
+		{
+			return *storage_;
+		}
+	};
+
+	template <typename T>
+	TOML_INTERNAL_LINKAGE
+	bool packed_values_equal(const T* lhs, const T* rhs, size_t count) noexcept
+	{
+		if constexpr (std::is_same_v<T, double>)
+		{
+			// (same semantics as value<double>'s equality operators)
+			for (size_t i = 0; i < count; i++)
+			{
+				const auto lhs_nan = impl::fpclassify(lhs[i]) == impl::fp_class::nan;
+				const auto rhs_nan = impl::fpclassify(rhs[i]) == impl::fp_class::nan;
+				if (lhs_nan != rhs_nan || (!lhs_nan && lhs[i] != rhs[i]))
+					return false;
+			}
+			return true;
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+				if (lhs[i] != rhs[i])
+					return false;
+			return true;
+		}
+	}
+
+	TOML_INTERNAL_LINKAGE
+	bool packed_values_equal(const impl::packed_array_storage& lhs, const impl::packed_array_storage& rhs) noexcept
+	{
+		TOML_ASSERT(lhs.size == rhs.size);
+
+		if (lhs.type == rhs.type)
+		{
+			switch (lhs.type)
+			{
+				case node_type::integer:
+					return packed_values_equal(lhs.values<int64_t>(), rhs.values<int64_t>(), lhs.size);
+				case node_type::floating_point:
+					return packed_values_equal(lhs.values<double>(), rhs.values<double>(), lhs.size);
+				case node_type::boolean: return packed_values_equal(lhs.values<bool>(), rhs.values<bool>(), lhs.size);
+				default: break;
+			}
+		}
+
+		for (size_t i = 0; i < lhs.size; i++)
+			if (!(lhs.get(i) == rhs.get(i)))
+				return false;
+		return true;
+	}
+
+	TOML_INTERNAL_LINKAGE
+	bool packed_values_equal(const impl::packed_array_storage& lhs, const impl::array_vector& rhs) noexcept
+	{
+		TOML_ASSERT(lhs.size == rhs.size());
+
+		impl::compact_value val;
+		for (size_t i = 0; i < lhs.size; i++)
+			if (!val.assign(*rhs[i]) || !(lhs.get(i) == val))
+				return false;
+		return true;
+	}
+
+	TOML_INTERNAL_LINKAGE
+	void create_nodes(const impl::packed_array_storage& storage,
+					  impl::array_vector& nodes,
+					  impl::memory_resource* resource)
+	{
+		nodes.clear();
+		nodes.reserve(storage.size);
+		switch (storage.type)
+		{
+			case node_type::integer:
+				for (auto val = storage.values<int64_t>(), end = val + storage.size; val != end; val++)
+					nodes.emplace_back(impl::create_node<toml::value<int64_t>>(resource, *val));
+				break;
+
+			case node_type::floating_point:
+				for (auto val = storage.values<double>(), end = val + storage.size; val != end; val++)
+					nodes.emplace_back(impl::create_node<toml::value<double>>(resource, *val));
+				break;
+
+			case node_type::boolean:
+				for (auto val = storage.values<bool>(), end = val + storage.size; val != end; val++)
+					nodes.emplace_back(impl::create_node<toml::value<bool>>(resource, *val));
+				break;
+
+			case node_type::none:
+				for (auto val = storage.values<impl::compact_value>(), end = val + storage.size; val != end;
+					 val++)
+				{
+					switch (val->type)
+					{
+						case node_type::integer:
+							nodes.emplace_back(impl::create_node<toml::value<int64_t>>(resource, val->integer));
+							break;
+
+						case node_type::floating_point:
+							nodes.emplace_back(
+								impl::create_node<toml::value<double>>(resource, val->floating_point));
+							break;
+
+						case node_type::boolean:
+							nodes.emplace_back(impl::create_node<toml::value<bool>>(resource, val->boolean));
+							break;
+
+						case node_type::date:
+							nodes.emplace_back(impl::create_node<toml::value<toml::date>>(resource, val->date));
+							break;
+
+						case node_type::time:
+							nodes.emplace_back(impl::create_node<toml::value<toml::time>>(resource, val->time));
+							break;
+
+						case node_type::date_time:
+						{
+							auto dt = val->has_offset ? toml::date_time{ val->date, val->time, toml::time_offset{} }
+													  : toml::date_time{ val->date, val->time };
+							if (val->has_offset)
+								dt.offset->minutes = val->offset_minutes;
+							nodes.emplace_back(impl::create_node<toml::value<toml::date_time>>(resource, dt));
+							break;
+						}
+
+						default: TOML_UNREACHABLE;
+					}
+				}
+				break;
+
+			default: TOML_UNREACHABLE;
+		}
+	}
+}
+TOML_ANON_NAMESPACE_END;
+
 TOML_NAMESPACE_START
 {
 	TOML_EXTERNAL_LINKAGE
-	array::array() noexcept
+	array::array() noexcept //
+		: node(node_type::array)
 	{
 #if TOML_LIFETIME_HOOKS
 		TOML_ARRAY_CREATED;
@@ -33,7 +202,8 @@ TOML_NAMESPACE_START
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	array::array(const impl::array_init_elem* b, const impl::array_init_elem* e)
+	array::array(const impl::array_init_elem* b, const impl::array_init_elem* e) //
+		: node(node_type::array)
 	{
 #if TOML_LIFETIME_HOOKS
 		TOML_ARRAY_CREATED;
@@ -67,9 +237,14 @@ TOML_NAMESPACE_START
 	array::array(const array& other) //
 		: node(other)
 	{
-		elems_.reserve(other.elems_.size());
-		for (const auto& elem : other)
-			elems_.emplace_back(impl::make_node(elem));
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ other.packed_.get() })
+			packed_ = (*values).clone(node_resource());
+		else
+		{
+			elems_.reserve(other.size());
+			for (const auto& elem : other)
+				elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+		}
 
 #if TOML_LIFETIME_HOOKS
 		TOML_ARRAY_CREATED;
@@ -79,13 +254,84 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	array::array(array && other) noexcept //
 		: node(std::move(other)),
-		  elems_(std::move(other.elems_))
+		  arena_{ std::move(other.arena_) },
+		  elems_{ std::move(other.elems_) },
+		  packed_{ std::move(other.packed_) }
 	{
+		// (released compact values leave only the nodes)
+		if (packed_ && packed_->values_released())
+			release_packed_storage();
+
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+	}
+
+#if TOML_ENABLE_PMR
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(const allocator_type& alloc) noexcept //
+		: node(node_type::array),
+		  elems_{ alloc }
+	{
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(const array& other, const allocator_type& alloc) //
+		: node(other),
+		  elems_{ alloc }
+	{
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ other.packed_.get() })
+			packed_ = (*values).clone(node_resource());
+		else
+		{
+			elems_.reserve(other.size());
+			for (const auto& elem : other)
+				elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+		}
+
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(array && other, const allocator_type& alloc) //
+		: node(std::move(other)),
+		  elems_{ alloc }
+	{
+		if (other.packed_ && other.packed_->resource == node_resource())
+		{
+			arena_	= std::move(other.arena_);
+			packed_ = std::move(other.packed_);
+			if (packed_->values_released())
+				release_packed_storage();
+		}
+		else if (other.packed_ && !other.packed_->values_released())
+			packed_ = other.packed_->clone(node_resource());
+		else if (!other.packed_ && other.elems_.get_allocator() == elems_.get_allocator())
+		{
+			arena_ = std::move(other.arena_);
+			elems_ = std::move(other.elems_);
+		}
+		else
+		{
+			elems_.reserve(other.size());
+			for (const auto& elem : other)
+				elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+		}
+		other.clear();
+
 #if TOML_LIFETIME_HOOKS
 		TOML_ARRAY_CREATED;
 #endif
 	}
 
+#endif // TOML_ENABLE_PMR
+
 	TOML_EXTERNAL_LINKAGE
 	array& array::operator=(const array& rhs)
 	{
@@ -93,20 +339,44 @@ TOML_NAMESPACE_START
 		{
 			node::operator=(rhs);
 			elems_.clear();
-			elems_.reserve(rhs.elems_.size());
-			for (const auto& elem : rhs)
-				elems_.emplace_back(impl::make_node(elem));
+			packed_.reset();
+			arena_.reset(); // (after elems_, since the old nodes may have been in it)
+			if (const TOML_ANON_NAMESPACE::packed_values_reader values{ rhs.packed_.get() })
+				packed_ = (*values).clone(node_resource());
+			else
+			{
+				elems_.reserve(rhs.size());
+				for (const auto& elem : rhs)
+					elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+			}
 		}
 		return *this;
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	array& array::operator=(array&& rhs) noexcept
+	array& array::operator=(array&& rhs) noexcept(!TOML_ENABLE_PMR)
 	{
 		if (&rhs != this)
 		{
+#if TOML_ENABLE_PMR
+			// the array keeps its own allocator, so anything from a different memory resource gets copied
+			if (rhs.node_resource() != node_resource())
+				return *this = array{ std::move(rhs), get_allocator() };
+#endif
+
+			// rhs might be one of the nodes about to be released, so everything's taken from it first
+			auto arena	= std::move(rhs.arena_);
+			auto elems	= std::move(rhs.elems_);
+			auto packed = std::move(rhs.packed_);
 			node::operator=(std::move(rhs));
-			elems_ = std::move(rhs.elems_);
+
+			elems_	= std::move(elems);
+			packed_ = std::move(packed);
+			arena_	= std::move(arena); // after elems_, since the old nodes may have been in the old arena
+
+			// (released compact values leave only the nodes)
+			if (packed_ && packed_->values_released())
+				release_packed_storage();
 		}
 		return *this;
 	}
@@ -114,6 +384,7 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void array::preinsertion_resize(size_t idx, size_t count)
 	{
+		unpack();
 		TOML_ASSERT(idx <= elems_.size());
 		TOML_ASSERT_ASSUME(count >= 1u);
 		const auto old_size			= elems_.size();
@@ -131,26 +402,97 @@ TOML_NAMESPACE_START
 	void array::insert_at_back(impl::node_ptr && elem)
 	{
 		TOML_ASSERT(elem);
+		unpack();
 		elems_.push_back(std::move(elem));
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	array::vector_iterator array::insert_at(const_vector_iterator pos, impl::node_ptr && elem)
 	{
+		unpack();
 		return elems_.insert(pos, std::move(elem));
 	}
 
+	TOML_EXTERNAL_LINKAGE
+	void array::create_packed_nodes() const
+	{
+		TOML_ASSERT_ASSUME(packed_);
+
+		// the first call creates the nodes; any others needing them meanwhile block until it's done
+		// (if it throws, the next call tries again)
+		auto& storage = *packed_;
+		std::call_once(storage.nodes_once,
+					   [&]
+					   {
+						   TOML_ANON_NAMESPACE::create_nodes(storage, storage.nodes, node_resource());
+						   storage.nodes_created.store(true, std::memory_order_release);
+						   storage.end_reading(); // the storage's own reference to compact values
+					   });
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	void array::release_packed_storage()
+	{
+		TOML_ASSERT_ASSUME(packed_);
+
+		if (!packed_->has_nodes())
+			create_packed_nodes();
+		elems_ = std::move(packed_->nodes); // (elems_ is empty and has the same allocator, so iterators stay valid)
+		packed_.reset();
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	bool array::pack()
+	{
+		if (packed_)
+			return true;
+		if (elems_.empty())
+			return false;
+
+		const auto type = elems_[0]->type();
+		if (type != node_type::integer && type != node_type::floating_point && type != node_type::boolean)
+			return false;
+		for (const auto& elem : elems_)
+		{
+			if (elem->type() != type)
+				return false;
+			if (type == node_type::integer && elem->as_integer()->flags() != value_flags::none)
+				return false;
+		}
+
+		auto storage = impl::packed_array_storage::create(type, node_resource());
+		storage->reserve(elems_.size());
+		for (const auto& elem : elems_)
+		{
+			switch (type)
+			{
+				case node_type::integer: storage->push_back(elem->as_integer()->get()); break;
+				case node_type::floating_point: storage->push_back(elem->as_floating_point()->get()); break;
+				case node_type::boolean: storage->push_back(elem->as_boolean()->get()); break;
+				default: TOML_UNREACHABLE;
+			}
+		}
+
+		elems_.clear();
+		packed_ = std::move(storage);
+		return true;
+	}
+
 	TOML_PURE_GETTER
 	TOML_EXTERNAL_LINKAGE
 	bool array::is_homogeneous(node_type ntype) const noexcept
 	{
-		if (elems_.empty())
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ packed_.get() })
+			return (*values).is_homogeneous(ntype);
+
+		const auto& nodes = elem_nodes(); // (only packed if the values were released, in which case there are nodes)
+		if (nodes.empty())
 			return false;
 
 		if (ntype == node_type::none)
-			ntype = elems_[0]->type();
+			ntype = nodes[0]->type();
 
-		for (const auto& val : elems_)
+		for (const auto& val : nodes)
 			if (val->type() != ntype)
 				return false;
 
@@ -161,14 +503,37 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	bool array::is_homogeneous(node_type ntype, node * &first_nonmatch) noexcept
 	{
-		if (elems_.empty())
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ packed_.get() })
 		{
-			first_nonmatch = {};
-			return false;
+			if ((*values).is_homogeneous(ntype))
+				return true;
+		}
+
+		unpack();
+		const node* fnm	  = nullptr;
+		const auto result = static_cast<const array&>(*this).is_homogeneous(ntype, fnm);
+		if (!result)
+			first_nonmatch = const_cast<node*>(fnm);
+		return result;
+	}
+
+	TOML_NODISCARD
+	TOML_EXTERNAL_LINKAGE
+	bool array::is_homogeneous(node_type ntype, const node*& first_nonmatch) const noexcept
+	{
+		first_nonmatch = {};
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ packed_.get() })
+		{
+			if ((*values).is_homogeneous(ntype))
+				return true;
 		}
+
+		const auto& nodes = elem_nodes();
+		if (nodes.empty())
+			return false;
 		if (ntype == node_type::none)
-			ntype = elems_[0]->type();
-		for (const auto& val : elems_)
+			ntype = nodes[0]->type();
+		for (const auto& val : nodes)
 		{
 			if (val->type() != ntype)
 			{
@@ -179,22 +544,19 @@ TOML_NAMESPACE_START
 		return true;
 	}
 
-	TOML_NODISCARD
 	TOML_EXTERNAL_LINKAGE
-	bool array::is_homogeneous(node_type ntype, const node*& first_nonmatch) const noexcept
+	node& array::at(size_t index)
 	{
-		node* fnm		  = nullptr;
-		const auto result = const_cast<array&>(*this).is_homogeneous(ntype, fnm);
-		first_nonmatch	  = fnm;
-		return result;
+		unpack();
+		return const_cast<node&>(static_cast<const array&>(*this).at(index));
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	node& array::at(size_t index)
+	const node& array::at(size_t index) const
 	{
 #if TOML_COMPILER_HAS_EXCEPTIONS
 
-		return *elems_.at(index);
+		return *elem_nodes().at(index);
 
 #else
 
@@ -208,18 +570,37 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void array::reserve(size_t new_capacity)
 	{
+		// (so appending values with push_back() afterwards keeps it packed)
+		if (packed_ && !packed_->has_nodes())
+		{
+			packed_->reserve(new_capacity);
+			return;
+		}
+
+		unpack();
 		elems_.reserve(new_capacity);
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	void array::shrink_to_fit()
 	{
+		if (packed_)
+			return;
+
 		elems_.shrink_to_fit();
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	void array::truncate(size_t new_size)
 	{
+		if (packed_ && !packed_->has_nodes())
+		{
+			if (new_size < packed_->size)
+				packed_->size = new_size;
+			return;
+		}
+
+		unpack();
 		if (new_size < elems_.size())
 			elems_.resize(new_size);
 	}
@@ -227,18 +608,23 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	array::iterator array::erase(const_iterator pos) noexcept
 	{
+		unpack();
 		return iterator{ elems_.erase(const_vector_iterator{ pos }) };
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	array::iterator array::erase(const_iterator first, const_iterator last) noexcept
 	{
+		unpack();
 		return iterator{ elems_.erase(const_vector_iterator{ first }, const_vector_iterator{ last }) };
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	size_t array::total_leaf_count() const noexcept
 	{
+		if (packed_)
+			return packed_->size;
+
 		size_t leaves{};
 		for (size_t i = 0, e = elems_.size(); i < e; i++)
 		{
@@ -249,8 +635,15 @@ TOML_NAMESPACE_START
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	void array::flatten_child(array && child, size_t & dest_index) noexcept
+	void array::flatten_child(array && child, size_t & dest_index)
 	{
+		child.unpack();
+
+		// nodes in a document's arena can only be moved into an array holding a reference to the same arena
+		if (child.arena_ && !arena_)
+			arena_ = child.arena_;
+		const bool can_move = !child.arena_ || child.arena_.get() == arena_.get();
+
 		for (size_t i = 0, e = child.size(); i < e; i++)
 		{
 			auto type = child.elems_[i]->type();
@@ -260,15 +653,17 @@ TOML_NAMESPACE_START
 				if (!arr.empty())
 					flatten_child(std::move(arr), dest_index);
 			}
-			else
+			else if (can_move)
 				elems_[dest_index++] = std::move(child.elems_[i]);
+			else
+				elems_[dest_index++] = impl::make_node(*child.elems_[i], preserve_source_value_flags, node_resource());
 		}
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	array& array::flatten()&
 	{
-		if (elems_.empty())
+		if (packed_ || elems_.empty())
 			return *this;
 
 		bool requires_flattening	 = false;
@@ -317,7 +712,7 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	array& array::prune(bool recursive)& noexcept
 	{
-		if (elems_.empty())
+		if (packed_ || elems_.empty())
 			return *this;
 
 		for (size_t i = elems_.size(); i-- > 0u;)
@@ -344,13 +739,22 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void array::pop_back() noexcept
 	{
+		if (packed_ && !packed_->has_nodes())
+		{
+			packed_->size--;
+			return;
+		}
+
+		unpack();
 		elems_.pop_back();
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	void array::clear() noexcept
 	{
+		packed_.reset();
 		elems_.clear();
+		arena_.reset();
 	}
 
 	TOML_EXTERNAL_LINKAGE
@@ -358,17 +762,31 @@ TOML_NAMESPACE_START
 	{
 		if (&lhs == &rhs)
 			return true;
-		if (lhs.elems_.size() != rhs.elems_.size())
+		if (lhs.size() != rhs.size())
 			return false;
-		for (size_t i = 0, e = lhs.elems_.size(); i < e; i++)
+		if (lhs.empty())
+			return true;
+
+		// (arrays with released compact values have their nodes instead)
+		const TOML_ANON_NAMESPACE::packed_values_reader lhs_values{ lhs.packed_.get() };
+		const TOML_ANON_NAMESPACE::packed_values_reader rhs_values{ rhs.packed_.get() };
+		if (lhs_values && rhs_values)
+			return TOML_ANON_NAMESPACE::packed_values_equal(*lhs_values, *rhs_values);
+		if (lhs_values)
+			return TOML_ANON_NAMESPACE::packed_values_equal(*lhs_values, rhs.elem_nodes());
+		if (rhs_values)
+			return TOML_ANON_NAMESPACE::packed_values_equal(*rhs_values, lhs.elem_nodes());
+		const auto& lhs_nodes = lhs.elem_nodes();
+		const auto& rhs_nodes = rhs.elem_nodes();
+		for (size_t i = 0, e = lhs_nodes.size(); i < e; i++)
 		{
-			const auto lhs_type = lhs.elems_[i]->type();
-			const node& rhs_	= *rhs.elems_[i];
+			const auto lhs_type = lhs_nodes[i]->type();
+			const node& rhs_	= *rhs_nodes[i];
 			const auto rhs_type = rhs_.type();
 			if (lhs_type != rhs_type)
 				return false;
 
-			const bool equal = lhs.elems_[i]->visit(
+			const bool equal = lhs_nodes[i]->visit(
 				[&](const auto& lhs_) noexcept
 				{ return lhs_ == *reinterpret_cast<std::remove_reference_t<decltype(lhs_)>*>(&rhs_); });
 			if (!equal)
@@ -0,0 +1,32 @@
+//# This file is a part of toml++ and is subject to the the terms of the MIT license.
+//# Copyright (c) Mark Gillard <mark.gillard@outlook.com.au>
+//# See https://github.com/marzer/tomlplusplus/blob/master/LICENSE for the full license text.
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "preprocessor.hpp"
+#if TOML_ENABLE_PARSER
+
+#include "std_string.hpp"
+#include "header_start.hpp"
+/// \cond
+
+TOML_IMPL_NAMESPACE_START
+{
+	// converts the text of a decimal floating-point value (digits, an optional '.' and an optional exponent,
+	// e.g. "6.626e-34"; no sign or underscores) to the nearest double, without going through iostreams or locales.
+	// returns false if the value is too large to be represented.
+	TOML_NODISCARD
+	bool decimal_to_double(std::string_view text, double& value) noexcept;
+
+	// converts the whole and fractional hexadecimal digits of a hexadecimal floating-point value and its binary
+	// exponent (e.g. "1a", "8" and -3 for 0x1a.8p-3) to the nearest double.
+	// returns false if the value is too large to be represented.
+	TOML_NODISCARD
+	bool hex_to_double(std::string_view whole, std::string_view fraction, int64_t exponent, double& value) noexcept;
+}
+TOML_IMPL_NAMESPACE_END;
+
+/// \endcond
+#include "header_end.hpp"
+#endif // TOML_ENABLE_PARSER
@@ -360,7 +360,7 @@ TOML_IMPL_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void formatter::print(const value<std::string>& val)
 	{
-		print_string(val.get());
+		print_string(val.view());
 	}
 
 	TOML_EXTERNAL_LINKAGE
@@ -6,6 +6,7 @@
 
 #include "std_string.hpp"
 #include "std_new.hpp"
+#include "std_memory_resource.hpp"
 TOML_DISABLE_WARNINGS;
 #include <cstdint>
 #include <cstddef>
@@ -93,8 +94,12 @@ TOML_NAMESPACE_START
 	class node_view;
 
 	class key;
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
 	class array;
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 	class table;
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	template <typename>
 	class value;
 
@@ -105,21 +110,59 @@ TOML_NAMESPACE_START
 	class yaml_formatter;
 
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 #if TOML_EXCEPTIONS
 	using parse_result = table;
 #else
 	class parse_result;
 #endif
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 }
 TOML_NAMESPACE_END;
 
 TOML_IMPL_NAMESPACE_START
 {
-	using node_ptr = std::unique_ptr<node>;
+	class node_arena;
+
+#if TOML_ENABLE_PMR
+	using memory_resource = std::pmr::memory_resource;
+	using node_allocator  = std::pmr::polymorphic_allocator<std::byte>;
+
+	template <typename T>
+	inline constexpr bool is_node_allocator_arg = std::is_convertible_v<T, node_allocator>;
+#else
+	class memory_resource; // never defined; without TOML_ENABLE_PMR every resource pointer is null
+
+	template <typename T>
+	inline constexpr bool is_node_allocator_arg = false;
+#endif
+
+	enum class node_storage : uint8_t
+	{
+		heap,	 // new/delete
+		arena,	 // a node_arena
+		resource // a memory_resource (TOML_ENABLE_PMR), with a resource_node_header in front of the node
+	};
+
+	struct node_deleter
+	{
+		void operator()(node*) const noexcept;
+	};
+	using node_ptr = std::unique_ptr<node, node_deleter>;
+
+	template <typename T, typename... Args>
+	T* create_node(memory_resource*, Args&&...);
 
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, impl_ex, impl_noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, impl_pmralloc, impl_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+	template <typename>
 	class parser;
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 
 	// clang-format off
@@ -346,6 +389,68 @@ TOML_NAMESPACE_START // abi namespace
 	};
 	TOML_MAKE_FLAGS(format_flags);
 
+	/// \brief	Flags for modifying how TOML documents are parsed.
+	enum class TOML_CLOSED_FLAGS_ENUM parse_flags : uint32_t
+	{
+		/// \brief None.
+		none,
+
+		/// \brief Allocates every node of the document from a single arena, so building the document doesn't need an
+		/// allocation per node and destroying it releases them all at once.
+		///
+		/// \detail Keys and string values too long to be stored inline are kept in the arena as well.
+		///
+		/// \remarks	The arena is reference-counted: tables, arrays and string values moved out of such a document
+		///				take their nodes and text with them (without copying anything), and keep the arena alive
+		///				until they're destroyed too. `value<std::string>::get()` copies a string out of the arena
+		///				the first time it's called.
+		arena_allocation = (1u << 0),
+
+		/// \brief Doesn't record where each node and key came from in the source document.
+		///
+		/// \detail Parsing is faster (there's no bookkeeping per node, and no sweep over the finished document to
+		/// 		fix up region ends), and the resulting nodes and keys don't share ownership of the source path.
+		///
+		/// \remarks	`source()` returns an empty region for every node and key in the document. Parse errors still
+		/// 			report where they occurred.
+		no_source_tracking = (1u << 1),
+
+		/// \brief Stores arrays whose elements are all integers, all floats or all booleans as packed, contiguous
+		/// values rather than as a node per element (see toml::array::is_packed() and toml::array::packed()).
+		///
+		/// \remarks	Integers written in hexadecimal, octal or binary aren't packed (so they keep their formatting).
+		/// 			Packed values don't have source regions, so neither do the nodes created for them if the
+		/// 			array's elements are later accessed as nodes (or if it turns out to contain other types).
+		packed_arrays = (1u << 2),
+
+		/// \brief Stores arrays whose elements are all integers, floats, booleans, dates, times or date-times (in any
+		/// mix) as compact values rather than as a node per element.
+		///
+		/// \detail Implies parse_flags::packed_arrays: arrays of all integers, all floats or all booleans are packed
+		/// 		as usual, and other arrays of those types are stored as a tagged value per element (16 bytes each).
+		/// 		Arrays containing strings, tables or arrays are stored as nodes. Compact arrays behave like packed
+		/// 		arrays (see toml::array::is_packed()), except toml::array::packed() always returns an empty view,
+		/// 		and the compact values are released once the array's elements have been accessed as nodes.
+		///
+		/// \remarks	Only array elements are stored compactly. Values in tables are always nodes.
+		compact_arrays = (1u << 3),
+
+		/// \brief Leaves keys and string values without escape sequences pointing into the source document rather
+		/// than copying them.
+		///
+		/// \detail Only applies when parsing a string view (e.g. of a memory-mapped file); ignored by
+		/// 		toml::parse_file(), istream inputs and toml::push_parser, since their buffers don't outlive parsing.
+		/// 		Borrowed strings are copied the first time they're accessed through toml::value::get() (or
+		/// 		`operator*`/`operator->`), which is why those aren't `noexcept` for strings;
+		/// 		toml::value::view(), `node::value<std::string_view>()`, comparisons and the formatters all use
+		/// 		the source text directly. Copies of borrowed values and keys have their own copy of the text.
+		/// 		A borrowed key's toml::key::data() isn't null-terminated.
+		///
+		/// \warning	The source document must outlive the parsed table and everything moved out of it.
+		borrowed_strings = (1u << 4),
+	};
+	TOML_MAKE_FLAGS(parse_flags);
+
 	/// \brief	Helper class for suppressing move-construction in single-argument array constructors.
 	///
 	/// \detail \cpp
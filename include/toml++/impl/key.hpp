@@ -5,10 +5,131 @@
 #pragma once
 
 #include "source_region.hpp"
+#include "std_string.hpp"
 #include "std_utility.hpp"
 #include "print_to_stream.hpp"
 #include "header_start.hpp"
 
+/// \cond
+TOML_IMPL_NAMESPACE_START
+{
+	// the text of a key. usually a std::string, except in documents parsed with parse_flags::borrowed_strings (whose
+	// keys can point into the source document) or parse_flags::arena_allocation (whose long keys point into the
+	// document's arena). copies always have their own text.
+	class key_text
+	{
+	  private:
+		union
+		{
+			std::string str_;
+			std::string_view borrowed_; // used instead of str_ when is_borrowed_ is set
+		};
+		bool is_borrowed_ = false;
+
+		void take(key_text& other) noexcept
+		{
+			if (other.is_borrowed_)
+			{
+				::new (static_cast<void*>(&borrowed_)) std::string_view{ std::exchange(other.borrowed_, {}) };
+				is_borrowed_ = true;
+			}
+			else
+				::new (static_cast<void*>(&str_)) std::string{ std::move(other.str_) };
+		}
+
+		void release() noexcept
+		{
+			if (!is_borrowed_)
+				str_.~basic_string();
+			is_borrowed_ = false;
+		}
+
+	  public:
+		TOML_NODISCARD_CTOR
+		key_text() noexcept //
+			: str_{}
+		{}
+
+		TOML_NODISCARD_CTOR
+		explicit key_text(std::string_view text) //
+			: str_{ text }
+		{}
+
+		TOML_NODISCARD_CTOR
+		explicit key_text(std::string&& text) noexcept //
+			: str_{ std::move(text) }
+		{}
+
+		// refers to text owned by something else (the source document or a document's arena)
+		TOML_NODISCARD
+		static key_text borrow(std::string_view text) noexcept
+		{
+			key_text k;
+			k.release();
+			::new (static_cast<void*>(&k.borrowed_)) std::string_view{ text };
+			k.is_borrowed_ = true;
+			return k;
+		}
+
+		TOML_NODISCARD_CTOR
+		key_text(const key_text& other) //
+			: str_{ other.view() }
+		{}
+
+		TOML_NODISCARD_CTOR
+		key_text(key_text&& other) noexcept
+		{
+			take(other);
+		}
+
+		key_text& operator=(const key_text& rhs)
+		{
+			if (&rhs != this)
+			{
+				key_text copy{ rhs };
+				release();
+				take(copy);
+			}
+			return *this;
+		}
+
+		key_text& operator=(key_text&& rhs) noexcept
+		{
+			if (&rhs != this)
+			{
+				release();
+				take(rhs);
+			}
+			return *this;
+		}
+
+		~key_text() noexcept
+		{
+			release();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view view() const noexcept
+		{
+			return is_borrowed_ ? borrowed_ : std::string_view{ str_ };
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const char* data() const noexcept
+		{
+			return is_borrowed_ ? borrowed_.data() : str_.data();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t length() const noexcept
+		{
+			return is_borrowed_ ? borrowed_.length() : str_.length();
+		}
+	};
+}
+TOML_IMPL_NAMESPACE_END;
+/// \endcond
+
 TOML_NAMESPACE_START
 {
 	/// \brief A key parsed from a TOML document.
@@ -31,9 +152,23 @@ TOML_NAMESPACE_START
 	class key
 	{
 	  private:
-		std::string key_;
+		/// \cond
+
+		template <typename>
+		friend class TOML_PARSER_TYPENAME;
+
+		impl::key_text key_;
 		source_region source_;
 
+		// (for keys that point into a document's arena)
+		TOML_NODISCARD_CTOR
+		key(impl::key_text&& k, source_region&& src) noexcept //
+			: key_{ std::move(k) },
+			  source_{ std::move(src) }
+		{}
+
+		/// \endcond
+
 	  public:
 		/// \brief	Default constructor.
 		TOML_NODISCARD_CTOR
@@ -56,28 +191,28 @@ TOML_NAMESPACE_START
 		/// \brief	Constructs a key from a string and source region.
 		TOML_NODISCARD_CTOR
 		explicit key(std::string&& k, source_region&& src = {}) noexcept //
-			: key_{ std::move(k) },
+			: key_{ std::string{ std::move(k) } },
 			  source_{ std::move(src) }
 		{}
 
 		/// \brief	Constructs a key from a string and source region.
 		TOML_NODISCARD_CTOR
 		explicit key(std::string&& k, const source_region& src) noexcept //
-			: key_{ std::move(k) },
+			: key_{ std::string{ std::move(k) } },
 			  source_{ src }
 		{}
 
 		/// \brief	Constructs a key from a c-string and source region.
 		TOML_NODISCARD_CTOR
 		explicit key(const char* k, source_region&& src = {}) //
-			: key_{ k },
+			: key_{ std::string_view{ k } },
 			  source_{ std::move(src) }
 		{}
 
 		/// \brief	Constructs a key from a c-string view and source region.
 		TOML_NODISCARD_CTOR
 		explicit key(const char* k, const source_region& src) //
-			: key_{ k },
+			: key_{ std::string_view{ k } },
 			  source_{ src }
 		{}
 
@@ -110,7 +245,7 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		std::string_view str() const noexcept
 		{
-			return std::string_view{ key_ };
+			return key_.view();
 		}
 
 		/// \brief	Returns a view of the key's underlying string.
@@ -124,10 +259,13 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		bool empty() const noexcept
 		{
-			return key_.empty();
+			return !key_.length();
 		}
 
 		/// \brief	Returns a pointer to the start of the key's underlying string.
+		///
+		/// \remarks	The string isn't null-terminated if the key points into the source document or its arena
+		/// 			(see parse_flags::borrowed_strings and parse_flags::arena_allocation).
 		TOML_PURE_INLINE_GETTER
 		const char* data() const noexcept
 		{
@@ -163,126 +301,126 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ == rhs.key_;
+			return lhs.str() == rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() != rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ != rhs.key_;
+			return lhs.str() != rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() < rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ < rhs.key_;
+			return lhs.str() < rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() <= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ <= rhs.key_;
+			return lhs.str() <= rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() > rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ > rhs.key_;
+			return lhs.str() > rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() >= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ >= rhs.key_;
+			return lhs.str() >= rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() == rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ == rhs;
+			return lhs.str() == rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() != rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ != rhs;
+			return lhs.str() != rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() < rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ < rhs;
+			return lhs.str() < rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() <= rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ <= rhs;
+			return lhs.str() <= rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() > rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ > rhs;
+			return lhs.str() > rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() >= rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ >= rhs;
+			return lhs.str() >= rhs;
 		}
 
 		/// \brief	Returns true if `lhs == rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs == rhs.key_;
+			return lhs == rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs != rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs != rhs.key_;
+			return lhs != rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs < rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs < rhs.key_;
+			return lhs < rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs <= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs <= rhs.key_;
+			return lhs <= rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs > rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs > rhs.key_;
+			return lhs > rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs >= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs >= rhs.key_;
+			return lhs >= rhs.str();
 		}
 
 		/// @}
@@ -315,7 +453,7 @@ TOML_NAMESPACE_START
 		/// \brief	Prints the key's underlying string out to the stream.
 		friend std::ostream& operator<<(std::ostream& lhs, const key& rhs)
 		{
-			impl::print_to_stream(lhs, rhs.key_);
+			impl::print_to_stream(lhs, rhs.str());
 			return lhs;
 		}
 	};
@@ -13,7 +13,7 @@ TOML_IMPL_NAMESPACE_START
 	template <typename T>
 	TOML_NODISCARD
 	TOML_ATTR(returns_nonnull)
-	auto* make_node_impl_specialized(T && val, [[maybe_unused]] value_flags flags)
+	auto* make_node_impl_specialized(T && val, [[maybe_unused]] value_flags flags, memory_resource* resource)
 	{
 		using unwrapped_type = unwrap_node<remove_cvref<T>>;
 		static_assert(!std::is_same_v<unwrapped_type, node>);
@@ -22,7 +22,7 @@ TOML_IMPL_NAMESPACE_START
 		// arrays + tables - invoke copy/move ctor
 		if constexpr (is_one_of<unwrapped_type, array, table>)
 		{
-			return new unwrapped_type(static_cast<T&&>(val));
+			return create_node<unwrapped_type>(resource, static_cast<T&&>(val));
 		}
 
 		// values
@@ -36,7 +36,7 @@ TOML_IMPL_NAMESPACE_START
 			// copy/move ctor
 			if constexpr (std::is_same_v<remove_cvref<T>, value_type>)
 			{
-				out = new value_type{ static_cast<T&&>(val), flags };
+				out = create_node<value_type>(resource, static_cast<T&&>(val), flags);
 			}
 
 			// creating from raw value
@@ -63,13 +63,13 @@ TOML_IMPL_NAMESPACE_START
 				if constexpr (is_wide_string<T>)
 				{
 #if TOML_ENABLE_WINDOWS_COMPAT
-					out = new value_type{ narrow(static_cast<T&&>(val)) };
+					out = create_node<value_type>(resource, narrow(static_cast<T&&>(val)));
 #else
 					static_assert(always_false<T>, "Evaluated unreachable branch!");
 #endif
 				}
 				else
-					out = new value_type{ static_cast<T&&>(val) };
+					out = create_node<value_type>(resource, static_cast<T&&>(val));
 
 				if (flags != preserve_source_value_flags)
 					out->flags(flags);
@@ -81,7 +81,7 @@ TOML_IMPL_NAMESPACE_START
 
 	template <typename T>
 	TOML_NODISCARD
-	auto* make_node_impl(T && val, value_flags flags = preserve_source_value_flags)
+	auto* make_node_impl(T && val, value_flags flags = preserve_source_value_flags, memory_resource* resource = nullptr)
 	{
 		using unwrapped_type = unwrap_node<remove_cvref<T>>;
 		if constexpr (std::is_same_v<unwrapped_type, node> || is_node_view<unwrapped_type>)
@@ -93,20 +93,22 @@ TOML_IMPL_NAMESPACE_START
 			}
 
 			return static_cast<T&&>(val).visit(
-				[flags](auto&& concrete) {
+				[flags, resource](auto&& concrete) {
 					return static_cast<toml::node*>(
-						make_node_impl_specialized(static_cast<decltype(concrete)&&>(concrete), flags));
+						make_node_impl_specialized(static_cast<decltype(concrete)&&>(concrete), flags, resource));
 				});
 		}
 		else
-			return make_node_impl_specialized(static_cast<T&&>(val), flags);
+			return make_node_impl_specialized(static_cast<T&&>(val), flags, resource);
 	}
 
 	template <typename T>
 	TOML_NODISCARD
-	auto* make_node_impl(inserter<T> && val, value_flags flags = preserve_source_value_flags)
+	auto* make_node_impl(inserter<T> && val,
+						 value_flags flags		   = preserve_source_value_flags,
+						 memory_resource* resource = nullptr)
 	{
-		return make_node_impl(static_cast<T&&>(val.value), flags);
+		return make_node_impl(static_cast<T&&>(val.value), flags, resource);
 	}
 
 	template <typename T, bool = (is_node<T> || is_node_view<T> || is_value<T> || can_partially_represent_native<T>)>
@@ -129,9 +131,9 @@ TOML_IMPL_NAMESPACE_START
 
 	template <typename T>
 	TOML_NODISCARD
-	node_ptr make_node(T && val, value_flags flags = preserve_source_value_flags)
+	node_ptr make_node(T && val, value_flags flags = preserve_source_value_flags, memory_resource* resource = nullptr)
 	{
-		return node_ptr{ make_node_impl(static_cast<T&&>(val), flags) };
+		return node_ptr{ make_node_impl(static_cast<T&&>(val), flags, resource) };
 	}
 
 	template <typename... T>
@@ -7,6 +7,7 @@
 #include "std_utility.hpp"
 #include "forward_declarations.hpp"
 #include "source_region.hpp"
+#include "node_arena.hpp"
 #include "header_start.hpp"
 
 // workaround for this: https://github.com/marzer/tomlplusplus/issues/220
@@ -30,8 +31,15 @@ TOML_NAMESPACE_START
 	  private:
 		/// \cond
 
+		template <typename>
 		friend class TOML_PARSER_TYPENAME;
+		friend class impl::node_arena;
+		friend struct impl::node_deleter;
+		template <typename T, typename... Args>
+		friend T* impl::create_node(impl::memory_resource*, Args&&...);
 		source_region source_{};
+		impl::node_storage storage_ = impl::node_storage::heap; // describes the node, not its value; never copied
+		node_type type_;										 // set by the derived type's constructors; never changes
 
 		template <typename T>
 		TOML_NODISCARD
@@ -76,7 +84,7 @@ TOML_NAMESPACE_START
 
 	  protected:
 		TOML_EXPORTED_MEMBER_FUNCTION
-		node() noexcept;
+		explicit node(node_type type) noexcept;
 
 		TOML_EXPORTED_MEMBER_FUNCTION
 		node(const node&) noexcept;
@@ -90,6 +98,13 @@ TOML_NAMESPACE_START
 		TOML_EXPORTED_MEMBER_FUNCTION
 		node& operator=(node&&) noexcept;
 
+		// true if the node lives in a node_arena (see parse_flags::arena_allocation)
+		TOML_PURE_INLINE_GETTER
+		bool arena_allocated() const noexcept
+		{
+			return storage_ == impl::node_storage::arena;
+		}
+
 		template <typename T, typename N>
 		using ref_cast_type_ = std::conditional_t<											  //
 			std::is_reference_v<T>,															  //
@@ -255,56 +270,92 @@ TOML_NAMESPACE_START
 		}
 
 		/// \brief	Returns the node's type identifier.
-		TOML_PURE_GETTER
-		virtual node_type type() const noexcept TOML_NVCC_WORKAROUND;
+		TOML_PURE_INLINE_GETTER
+		node_type type() const noexcept
+		{
+			return type_;
+		}
 
 		/// \brief	Returns true if this node is a table.
-		TOML_PURE_GETTER
-		virtual bool is_table() const noexcept TOML_NVCC_WORKAROUND;
+		TOML_PURE_INLINE_GETTER
+		bool is_table() const noexcept
+		{
+			return type_ == node_type::table;
+		}
 
 		/// \brief	Returns true if this node is an array.
-		TOML_PURE_GETTER
-		virtual bool is_array() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_array() const noexcept
+		{
+			return type_ == node_type::array;
+		}
 
 		/// \brief	Returns true if this node is an array containing only tables.
 		TOML_PURE_GETTER
 		virtual bool is_array_of_tables() const noexcept TOML_NVCC_WORKAROUND;
 
 		/// \brief	Returns true if this node is a value.
-		TOML_PURE_GETTER
-		virtual bool is_value() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_value() const noexcept
+		{
+			return type_ >= node_type::string;
+		}
 
 		/// \brief	Returns true if this node is a string value.
-		TOML_PURE_GETTER
-		virtual bool is_string() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_string() const noexcept
+		{
+			return type_ == node_type::string;
+		}
 
 		/// \brief	Returns true if this node is an integer value.
-		TOML_PURE_GETTER
-		virtual bool is_integer() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_integer() const noexcept
+		{
+			return type_ == node_type::integer;
+		}
 
 		/// \brief	Returns true if this node is an floating-point value.
-		TOML_PURE_GETTER
-		virtual bool is_floating_point() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_floating_point() const noexcept
+		{
+			return type_ == node_type::floating_point;
+		}
 
 		/// \brief	Returns true if this node is an integer or floating-point value.
-		TOML_PURE_GETTER
-		virtual bool is_number() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_number() const noexcept
+		{
+			return type_ == node_type::integer || type_ == node_type::floating_point;
+		}
 
 		/// \brief	Returns true if this node is a boolean value.
-		TOML_PURE_GETTER
-		virtual bool is_boolean() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_boolean() const noexcept
+		{
+			return type_ == node_type::boolean;
+		}
 
 		/// \brief	Returns true if this node is a local date value.
-		TOML_PURE_GETTER
-		virtual bool is_date() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_date() const noexcept
+		{
+			return type_ == node_type::date;
+		}
 
 		/// \brief	Returns true if this node is a local time value.
-		TOML_PURE_GETTER
-		virtual bool is_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_time() const noexcept
+		{
+			return type_ == node_type::time;
+		}
 
 		/// \brief	Returns true if this node is a date-time value.
-		TOML_PURE_GETTER
-		virtual bool is_date_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_date_time() const noexcept
+		{
+			return type_ == node_type::date_time;
+		}
 
 		/// \brief	Checks if a node is a specific type.
 		///
@@ -347,76 +398,130 @@ TOML_NAMESPACE_START
 		/// @{
 
 		/// \brief	Returns a pointer to the node as a toml::table, if it is one.
-		TOML_PURE_GETTER
-		virtual table* as_table() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		table* as_table() noexcept
+		{
+			return type_ == node_type::table ? &ref_cast<table>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::array, if it is one.
-		TOML_PURE_GETTER
-		virtual array* as_array() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		array* as_array() noexcept
+		{
+			return type_ == node_type::array ? &ref_cast<array>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::value<std::string>, if it is one.
-		TOML_PURE_GETTER
-		virtual toml::value<std::string>* as_string() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<std::string>* as_string() noexcept
+		{
+			return type_ == node_type::string ? &ref_cast<std::string>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::value<int64_t>, if it is one.
-		TOML_PURE_GETTER
-		virtual toml::value<int64_t>* as_integer() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<int64_t>* as_integer() noexcept
+		{
+			return type_ == node_type::integer ? &ref_cast<int64_t>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::value<double>, if it is one.
-		TOML_PURE_GETTER
-		virtual toml::value<double>* as_floating_point() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<double>* as_floating_point() noexcept
+		{
+			return type_ == node_type::floating_point ? &ref_cast<double>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::value<bool>, if it is one.
-		TOML_PURE_GETTER
-		virtual toml::value<bool>* as_boolean() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<bool>* as_boolean() noexcept
+		{
+			return type_ == node_type::boolean ? &ref_cast<bool>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::value<toml::date>, if it is one.
-		TOML_PURE_GETTER
-		virtual toml::value<date>* as_date() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<date>* as_date() noexcept
+		{
+			return type_ == node_type::date ? &ref_cast<date>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::value<toml::time>, if it is one.
-		TOML_PURE_GETTER
-		virtual toml::value<time>* as_time() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<time>* as_time() noexcept
+		{
+			return type_ == node_type::time ? &ref_cast<time>() : nullptr;
+		}
 
 		/// \brief	Returns a pointer to the node as a toml::value<toml::date_time>, if it is one.
-		TOML_PURE_GETTER
-		virtual toml::value<date_time>* as_date_time() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<date_time>* as_date_time() noexcept
+		{
+			return type_ == node_type::date_time ? &ref_cast<date_time>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::table, if it is one.
-		TOML_PURE_GETTER
-		virtual const table* as_table() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const table* as_table() const noexcept
+		{
+			return type_ == node_type::table ? &ref_cast<table>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::array, if it is one.
-		TOML_PURE_GETTER
-		virtual const array* as_array() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const array* as_array() const noexcept
+		{
+			return type_ == node_type::array ? &ref_cast<array>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::value<std::string>, if it is one.
-		TOML_PURE_GETTER
-		virtual const toml::value<std::string>* as_string() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<std::string>* as_string() const noexcept
+		{
+			return type_ == node_type::string ? &ref_cast<std::string>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::value<int64_t>, if it is one.
-		TOML_PURE_GETTER
-		virtual const toml::value<int64_t>* as_integer() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<int64_t>* as_integer() const noexcept
+		{
+			return type_ == node_type::integer ? &ref_cast<int64_t>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::value<double>, if it is one.
-		TOML_PURE_GETTER
-		virtual const toml::value<double>* as_floating_point() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<double>* as_floating_point() const noexcept
+		{
+			return type_ == node_type::floating_point ? &ref_cast<double>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::value<bool>, if it is one.
-		TOML_PURE_GETTER
-		virtual const toml::value<bool>* as_boolean() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<bool>* as_boolean() const noexcept
+		{
+			return type_ == node_type::boolean ? &ref_cast<bool>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::value<toml::date>, if it is one.
-		TOML_PURE_GETTER
-		virtual const toml::value<date>* as_date() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<date>* as_date() const noexcept
+		{
+			return type_ == node_type::date ? &ref_cast<date>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::value<toml::time>, if it is one.
-		TOML_PURE_GETTER
-		virtual const toml::value<time>* as_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<time>* as_time() const noexcept
+		{
+			return type_ == node_type::time ? &ref_cast<time>() : nullptr;
+		}
 
 		/// \brief	Returns a const-qualified pointer to the node as a toml::value<toml::date_time>, if it is one.
-		TOML_PURE_GETTER
-		virtual const toml::value<date_time>* as_date_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<date_time>* as_date_time() const noexcept
+		{
+			return type_ == node_type::date_time ? &ref_cast<date_time>() : nullptr;
+		}
 
 		/// \brief	Gets a pointer to the node as a more specific node type.
 		///
@@ -1124,6 +1229,110 @@ TOML_IMPL_NAMESPACE_START
 	TOML_PURE_GETTER
 	TOML_EXPORTED_FREE_FUNCTION
 	bool TOML_CALLCONV node_deep_equality(const node*, const node*) noexcept;
+
+#if TOML_ENABLE_PMR
+
+	// prefixed to nodes allocated from a memory_resource so node_deleter knows where to give the memory back
+	struct resource_node_header
+	{
+		memory_resource* resource;
+		size_t size;
+	};
+
+	inline constexpr size_t resource_node_alignment = alignof(std::max_align_t);
+	inline constexpr size_t resource_node_header_size =
+		(sizeof(resource_node_header) + resource_node_alignment - 1u) & ~(resource_node_alignment - 1u);
+
+#endif
+
+	TOML_ALWAYS_INLINE
+	void node_deleter::operator()(node* n) const noexcept
+	{
+		switch (n->storage_)
+		{
+			case node_storage::heap: delete n; return;
+
+			// nodes in an arena are destroyed in-place; their storage goes away with the arena
+			case node_storage::arena: n->~node(); return;
+
+#if TOML_ENABLE_PMR
+			case node_storage::resource:
+			{
+				const auto header = reinterpret_cast<resource_node_header*>(reinterpret_cast<char*>(n)
+																			- resource_node_header_size);
+				const auto resource = header->resource;
+				const auto size		= header->size;
+				n->~node();
+				resource->deallocate(header, size, resource_node_alignment);
+				return;
+			}
+#endif
+
+			default: TOML_UNREACHABLE;
+		}
+	}
+
+	template <typename T, typename... Args>
+	T* node_arena::create(Args&&... args)
+	{
+		static_assert(std::is_base_of_v<node, T>);
+
+		T* n		= ::new (allocate(sizeof(T), alignof(T))) T{ static_cast<Args&&>(args)... };
+		n->storage_ = node_storage::arena;
+		return n;
+	}
+
+	template <typename T, typename... Args>
+	T* create_node([[maybe_unused]] memory_resource* resource, Args&&... args)
+	{
+		static_assert(std::is_base_of_v<node, T>);
+
+#if TOML_ENABLE_PMR
+		if (resource && resource != std::pmr::new_delete_resource())
+		{
+			static_assert(alignof(T) <= resource_node_alignment);
+
+			constexpr size_t size = resource_node_header_size + sizeof(T);
+			const auto header	  = ::new (resource->allocate(size, resource_node_alignment))
+				resource_node_header{ resource, size };
+			void* const storage = reinterpret_cast<char*>(header) + resource_node_header_size;
+
+			T* n;
+#if TOML_COMPILER_HAS_EXCEPTIONS
+			try
+			{
+#endif
+				// containers take the resource with them so their own children end up there too
+				if constexpr (is_one_of<T, table, array>)
+				{
+					if constexpr (sizeof...(Args) == 0u)
+						n = ::new (storage) T(node_allocator{ resource });
+					else if constexpr (sizeof...(Args) == 1u && (std::is_same_v<remove_cvref<Args>, T> && ...))
+						n = ::new (storage) T(static_cast<Args&&>(args)..., node_allocator{ resource });
+					else
+						n = ::new (storage) T(T(static_cast<Args&&>(args)...), node_allocator{ resource });
+				}
+				else
+					n = ::new (storage) T{ static_cast<Args&&>(args)... };
+#if TOML_COMPILER_HAS_EXCEPTIONS
+			}
+			catch (...)
+			{
+				resource->deallocate(header, size, resource_node_alignment);
+				throw;
+			}
+#endif
+			TOML_ASSERT(static_cast<void*>(static_cast<node*>(n)) == storage);
+			n->storage_ = node_storage::resource;
+			return n;
+		}
+#endif
+
+		if constexpr (is_one_of<T, table, array>)
+			return new T(static_cast<Args&&>(args)...);
+		else
+			return new T{ static_cast<Args&&>(args)... };
+	}
 }
 TOML_IMPL_NAMESPACE_END;
 /// \endcond
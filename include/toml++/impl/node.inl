@@ -22,18 +22,22 @@
 TOML_NAMESPACE_START
 {
 	TOML_EXTERNAL_LINKAGE
-	node::node() noexcept = default;
+	node::node(node_type type) noexcept //
+		: type_{ type }
+	{}
 
 	TOML_EXTERNAL_LINKAGE
 	node::~node() noexcept = default;
 
 	TOML_EXTERNAL_LINKAGE
 	node::node(node && other) noexcept //
-		: source_{ std::exchange(other.source_, {}) }
+		: source_{ std::exchange(other.source_, {}) },
+		  type_{ other.type_ }
 	{}
 
 	TOML_EXTERNAL_LINKAGE
-	node::node(const node& /*other*/) noexcept
+	node::node(const node& other) noexcept //
+		: type_{ other.type_ }
 	{
 		// does not copy source information - this is not an error
 		//
@@ -115,6 +119,53 @@ TOML_NAMESPACE_END;
 
 TOML_IMPL_NAMESPACE_START
 {
+	TOML_EXTERNAL_LINKAGE
+	node_arena::~node_arena() noexcept
+	{
+		while (blocks_)
+		{
+			auto next = blocks_->next;
+			::operator delete(static_cast<void*>(blocks_));
+			blocks_ = next;
+		}
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	void* node_arena::allocate_from_new_block(size_t size, size_t align)
+	{
+		constexpr size_t header =
+			(sizeof(block) + (alignof(std::max_align_t) - 1u)) & ~(alignof(std::max_align_t) - 1u);
+		const size_t needed = header + size + (align > alignof(std::max_align_t) ? align : 0u);
+
+		// requests that wouldn't fit in a regular block get one of their own, linked in behind the current block
+		// so the remainder of the current block is still used for subsequent allocations
+		const bool oversized	= needed > next_block_size_;
+		const size_t block_size = oversized ? needed : next_block_size_;
+
+		auto blk = static_cast<block*>(::operator new(block_size));
+		reserved_ += block_size;
+
+		const auto begin   = reinterpret_cast<uintptr_t>(blk) + header;
+		const auto aligned = (begin + (align - 1u)) & ~static_cast<uintptr_t>(align - 1u);
+
+		if (oversized && blocks_)
+		{
+			blk->next	  = blocks_->next;
+			blocks_->next = blk;
+		}
+		else
+		{
+			blk->next = blocks_;
+			blocks_	  = blk;
+			cursor_	  = reinterpret_cast<char*>(aligned + size);
+			end_	  = reinterpret_cast<char*>(blk) + block_size;
+			if (!oversized && next_block_size_ < max_block_size)
+				next_block_size_ *= 2u;
+		}
+
+		return reinterpret_cast<void*>(aligned);
+	}
+
 	TOML_PURE_GETTER
 	TOML_EXTERNAL_LINKAGE
 	bool TOML_CALLCONV node_deep_equality(const node* lhs, const node* rhs) noexcept
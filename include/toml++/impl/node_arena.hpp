@@ -0,0 +1,206 @@
+//# This file is a part of toml++ and is subject to the the terms of the MIT license.
+//# Copyright (c) Mark Gillard <mark.gillard@outlook.com.au>
+//# See https://github.com/marzer/tomlplusplus/blob/master/LICENSE for the full license text.
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "std_new.hpp"
+#include "std_utility.hpp"
+#include "std_string.hpp"
+#include "std_atomic.hpp"
+#include "forward_declarations.hpp"
+#include "header_start.hpp"
+
+/// \cond
+TOML_IMPL_NAMESPACE_START
+{
+	// a monotonic allocator for the nodes, long keys and long strings of a single document
+	// (see parse_flags::arena_allocation).
+	// memory is handed out from a chain of geometrically-growing blocks and only released when the arena is destroyed;
+	// nodes created in it still have their destructors run (by node_deleter), they just don't free anything.
+	//
+	// the arena is reference-counted (see arena_ref) by the root table and every table, array and long string value
+	// using memory in it, so moving any of them out of the document keeps it alive for as long as they need it.
+	class TOML_EXPORTED_CLASS node_arena
+	{
+	  private:
+		struct block
+		{
+			block* next;
+		};
+
+		friend class arena_ref;
+		std::atomic<size_t> refs_ = {};
+
+		static constexpr size_t initial_block_size = 4u * 1024u;
+		static constexpr size_t max_block_size	   = 1024u * 1024u;
+
+		block* blocks_			= {};
+		char* cursor_			= {};
+		char* end_				= {};
+		size_t next_block_size_ = initial_block_size;
+		size_t reserved_		= {};
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void* allocate_from_new_block(size_t size, size_t align);
+
+	  public:
+		TOML_NODISCARD_CTOR
+		node_arena() noexcept = default;
+
+		// starts with a block of 'size_hint' bytes (e.g. what a similar document needed last time) rather than working
+		// up to it from a small one
+		TOML_NODISCARD_CTOR
+		explicit node_arena(size_t size_hint) noexcept //
+			: next_block_size_{ size_hint > initial_block_size ? size_hint : initial_block_size }
+		{}
+
+		node_arena(const node_arena&)			 = delete;
+		node_arena& operator=(const node_arena&) = delete;
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		~node_arena() noexcept;
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		void* allocate(size_t size, size_t align)
+		{
+			TOML_ASSERT_ASSUME(align && !(align & (align - 1u)));
+
+			const auto addr	   = reinterpret_cast<uintptr_t>(cursor_);
+			const auto aligned = (addr + (align - 1u)) & ~static_cast<uintptr_t>(align - 1u);
+			if TOML_LIKELY(cursor_ && aligned + size <= reinterpret_cast<uintptr_t>(end_))
+			{
+				cursor_ += (aligned - addr) + size;
+				return reinterpret_cast<void*>(aligned);
+			}
+			return allocate_from_new_block(size, align);
+		}
+
+		template <typename T, typename... Args>
+		TOML_NODISCARD
+		T* create(Args&&... args);
+
+		// copies text into the arena (for long keys, which only ever move along with the table holding them)
+		TOML_NODISCARD
+		std::string_view copy(std::string_view text)
+		{
+			const auto str = static_cast<char*>(allocate(text.length(), 1u));
+			std::char_traits<char>::copy(str, text.data(), text.length());
+			return { str, text.length() };
+		}
+
+		// copies text into the arena behind a pointer back to the arena, so a string value moved out of the document
+		// can find it again (see of())
+		TOML_NODISCARD
+		std::string_view copy_string(std::string_view text)
+		{
+			const auto header = static_cast<node_arena**>(
+				allocate(sizeof(node_arena*) + text.length(), alignof(node_arena*)));
+			*header			  = this;
+			const auto str	  = reinterpret_cast<char*>(header + 1);
+			std::char_traits<char>::copy(str, text.data(), text.length());
+			return { str, text.length() };
+		}
+
+		// the arena holding text from copy_string()
+		TOML_PURE_INLINE_GETTER
+		static node_arena* of(std::string_view copied_string) noexcept
+		{
+			return reinterpret_cast<node_arena* const*>(copied_string.data())[-1];
+		}
+
+		// total bytes of block storage obtained from the global heap
+		TOML_PURE_INLINE_GETTER
+		size_t reserved() const noexcept
+		{
+			return reserved_;
+		}
+
+		// bytes of block storage handed out so far (give or take the unused ends of previous blocks)
+		TOML_PURE_INLINE_GETTER
+		size_t used() const noexcept
+		{
+			return reserved_ - static_cast<size_t>(end_ - cursor_);
+		}
+	};
+
+	// a counted reference to a node_arena; the arena is destroyed along with the last one
+	class arena_ref
+	{
+	  private:
+		node_arena* arena_ = {};
+
+	  public:
+		TOML_NODISCARD_CTOR
+		arena_ref() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		explicit arena_ref(node_arena* arena) noexcept //
+			: arena_{ arena }
+		{
+			if (arena_)
+				arena_->refs_.fetch_add(1u, std::memory_order_relaxed);
+		}
+
+		TOML_NODISCARD_CTOR
+		arena_ref(const arena_ref& other) noexcept //
+			: arena_ref{ other.arena_ }
+		{}
+
+		TOML_NODISCARD_CTOR
+		arena_ref(arena_ref&& other) noexcept //
+			: arena_{ std::exchange(other.arena_, nullptr) }
+		{}
+
+		arena_ref& operator=(arena_ref rhs) noexcept
+		{
+			std::swap(arena_, rhs.arena_);
+			return *this;
+		}
+
+		~arena_ref() noexcept
+		{
+			reset();
+		}
+
+		// (for things holding a reference without an arena_ref of their own, e.g. a string value's borrowed text)
+		TOML_NODISCARD
+		static arena_ref adopt(node_arena* arena) noexcept
+		{
+			arena_ref ref;
+			ref.arena_ = arena;
+			return ref;
+		}
+
+		TOML_NODISCARD
+		node_arena* detach() noexcept
+		{
+			return std::exchange(arena_, nullptr);
+		}
+
+		void reset() noexcept
+		{
+			// (this might be in the arena itself, so it's cleared before the arena can go)
+			const auto arena = detach();
+			if (arena && arena->refs_.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+				delete arena;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		node_arena* get() const noexcept
+		{
+			return arena_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		explicit operator bool() const noexcept
+		{
+			return !!arena_;
+		}
+	};
+}
+TOML_IMPL_NAMESPACE_END;
+/// \endcond
+
+#include "header_end.hpp"
@@ -14,6 +14,8 @@
 TOML_NAMESPACE_START
 {
 	TOML_ABI_NAMESPACE_START(noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
 	/// \brief	The result of a parsing operation.
 	///
@@ -491,6 +493,8 @@ TOML_NAMESPACE_START
 #endif
 	};
 
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END;
 }
 TOML_NAMESPACE_END;
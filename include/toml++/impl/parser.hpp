@@ -13,7 +13,77 @@
 
 TOML_NAMESPACE_START
 {
+	/// \brief	A source of raw bytes to parse a TOML document from.
+	///
+	/// \detail Wraps (without taking ownership of) any callable with the signature `size_t(char* buffer, size_t capacity)`,
+	///			which should write up to `capacity` bytes of the document to `buffer` and return how many it wrote.
+	///			This allows documents to be parsed directly from file descriptors, pipes, decompressors etc.
+	///			without going through `std::istream`. \cpp
+	/// const int fd = ::open("config.toml", O_RDONLY);
+	///
+	/// auto tbl = toml::parse([=](char* buffer, size_t capacity) noexcept -> size_t
+	/// {
+	///		const auto n = ::read(fd, buffer, capacity);
+	///		return n < 0 ? toml::byte_source::read_error : static_cast<size_t>(n);
+	/// });
+	/// \ecpp
+	///
+	/// \remarks	Returning zero signals the end of the document; returning toml::byte_source::read_error signals
+	///				that reading failed. Exceptions thrown by the callable are converted to toml::parse_error.
+	class byte_source
+	{
+	  public:
+		/// \brief	The default number of bytes requested from the callable each time it is invoked.
+		static constexpr size_t default_chunk_size = 64u * 1024u;
+
+		/// \brief	A value for the callable to return to signal that reading failed.
+		static constexpr size_t read_error = static_cast<size_t>(-1);
+
+	  private:
+		/// \cond
+		void* callable_;
+		size_t (*read_)(void*, char*, size_t);
+		size_t chunk_size_;
+		/// \endcond
+
+	  public:
+		/// \brief	Constructs a byte source from a callable.
+		///
+		/// \param	callable	The callable. Must outlive the byte_source.
+		/// \param	chunk_size	The number of bytes to request from the callable each time it is invoked.
+		TOML_CONSTRAINED_TEMPLATE((std::is_invocable_r_v<size_t, std::remove_reference_t<Callable>&, char*, size_t>
+								   && !std::is_same_v<impl::remove_cvref<Callable>, byte_source>),
+								  typename Callable)
+		TOML_NODISCARD_CTOR
+		byte_source(Callable&& callable, size_t chunk_size = default_chunk_size) noexcept
+			: callable_{ const_cast<void*>(static_cast<const volatile void*>(std::addressof(callable))) },
+			  read_{ [](void* c, char* buffer, size_t capacity) -> size_t
+					 {
+						 auto& func = *static_cast<std::remove_reference_t<Callable>*>(c);
+						 return static_cast<size_t>(func(buffer, capacity));
+					 } },
+			  chunk_size_{ chunk_size ? chunk_size : default_chunk_size }
+		{}
+
+		/// \brief	The number of bytes requested from the callable each time it is invoked.
+		TOML_PURE_INLINE_GETTER
+		size_t chunk_size() const noexcept
+		{
+			return chunk_size_;
+		}
+
+		/// \brief	Invokes the callable.
+		TOML_NODISCARD
+		TOML_ATTR(nonnull)
+		size_t operator()(char* buffer, size_t capacity) const
+		{
+			return read_(callable_, buffer, capacity);
+		}
+	};
+
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
 	/// \brief	Parses a TOML document from a string view.
 	///
@@ -30,6 +100,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -37,7 +108,9 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string_view source_path = {});
+	parse_result TOML_CALLCONV parse(std::string_view doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
 
 	/// \brief	Parses a TOML document from a string view.
 	///
@@ -54,6 +127,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -61,7 +135,9 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string && source_path);
+	parse_result TOML_CALLCONV parse(std::string_view doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
 
 	/// \brief	Parses a TOML document from a file.
 	///
@@ -73,6 +149,7 @@ TOML_NAMESPACE_START
 	/// \ecpp
 	///
 	/// \param 	file_path		The TOML document to parse. Must be valid UTF-8.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -80,7 +157,7 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse_file(std::string_view file_path);
+	parse_result TOML_CALLCONV parse_file(std::string_view file_path, parse_flags flags = parse_flags::none);
 
 #if TOML_HAS_CHAR8
 
@@ -99,6 +176,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -106,7 +184,9 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string_view source_path = {});
+	parse_result TOML_CALLCONV parse(std::u8string_view doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
 
 	/// \brief	Parses a TOML document from a char8_t string view.
 	///
@@ -123,6 +203,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -130,7 +211,9 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string && source_path);
+	parse_result TOML_CALLCONV parse(std::u8string_view doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
 
 	/// \brief	Parses a TOML document from a file.
 	///
@@ -142,6 +225,7 @@ TOML_NAMESPACE_START
 	/// \ecpp
 	///
 	/// \param 	file_path		The TOML document to parse. Must be valid UTF-8.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -149,7 +233,7 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path);
+	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path, parse_flags flags = parse_flags::none);
 
 #endif // TOML_HAS_CHAR8
 
@@ -172,6 +256,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -179,7 +264,9 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::wstring_view source_path);
+	parse_result TOML_CALLCONV parse(std::string_view doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
 
 	/// \brief	Parses a TOML document from a stream.
 	///
@@ -201,6 +288,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -208,7 +296,38 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::wstring_view source_path);
+	parse_result TOML_CALLCONV parse(std::istream & doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
+
+	/// \brief	Parses a TOML document from a byte source.
+	///
+	/// \availability This overload is only available when #TOML_ENABLE_WINDOWS_COMPAT is enabled.
+	///
+	/// \detail \cpp
+	/// auto tbl = toml::parse(toml::byte_source{ decompressor }, L"foo.toml");
+	/// std::cout << tbl["a"] << "\n";
+	/// \ecpp
+	///
+	/// \out
+	/// 3
+	/// \eout
+	///
+	/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+	/// \param 	source_path		The path used to initialize each node's `source().path`.
+	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
+	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
+	///
+	/// \returns	\conditional_return{With exceptions}
+	///				A toml::table.
+	/// 			\conditional_return{Without exceptions}
+	///				A toml::parse_result.
+	TOML_NODISCARD
+	TOML_EXPORTED_FREE_FUNCTION
+	parse_result TOML_CALLCONV parse(byte_source doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
 
 	/// \brief	Parses a TOML document from a file.
 	///
@@ -222,6 +341,7 @@ TOML_NAMESPACE_START
 	/// \ecpp
 	///
 	/// \param 	file_path		The TOML document to parse. Must be valid UTF-8.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -229,7 +349,7 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path);
+	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path, parse_flags flags = parse_flags::none);
 
 #endif // TOML_ENABLE_WINDOWS_COMPAT
 
@@ -252,6 +372,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -259,7 +380,9 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::wstring_view source_path);
+	parse_result TOML_CALLCONV parse(std::u8string_view doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
 
 #endif // TOML_HAS_CHAR8 && TOML_ENABLE_WINDOWS_COMPAT
 
@@ -281,6 +404,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -288,7 +412,9 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string_view source_path = {});
+	parse_result TOML_CALLCONV parse(std::istream & doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
 
 	/// \brief	Parses a TOML document from a stream.
 	///
@@ -308,6 +434,7 @@ TOML_NAMESPACE_START
 	/// \param 	source_path		The path used to initialize each node's `source().path`.
 	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
 	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
 	///
 	/// \returns	\conditional_return{With exceptions}
 	///				A toml::table.
@@ -315,13 +442,73 @@ TOML_NAMESPACE_START
 	///				A toml::parse_result.
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string && source_path);
+	parse_result TOML_CALLCONV parse(std::istream & doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
 
+	/// \brief	Parses a TOML document from a byte source.
+	///
+	/// \detail \cpp
+	/// auto tbl = toml::parse([&](char* buffer, size_t capacity) { return decompressor.read(buffer, capacity); });
+	/// std::cout << tbl["a"] << "\n";
+	/// \ecpp
+	///
+	/// \out
+	/// 3
+	/// \eout
+	///
+	/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+	/// \param 	source_path		The path used to initialize each node's `source().path`.
+	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
+	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
+	///
+	/// \returns	\conditional_return{With exceptions}
+	///				A toml::table.
+	/// 			\conditional_return{Without exceptions}
+	///				A toml::parse_result.
+	TOML_NODISCARD
+	TOML_EXPORTED_FREE_FUNCTION
+	parse_result TOML_CALLCONV parse(byte_source doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
+
+	/// \brief	Parses a TOML document from a byte source.
+	///
+	/// \detail \cpp
+	/// auto tbl = toml::parse(toml::byte_source{ decompressor, 16 * 1024 }, "foo.toml");
+	/// std::cout << tbl["a"] << "\n";
+	/// \ecpp
+	///
+	/// \out
+	/// 3
+	/// \eout
+	///
+	/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+	/// \param 	source_path		The path used to initialize each node's `source().path`.
+	/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
+	/// 						then this parameter can safely be left blank.
+	/// \param 	flags			Flags controlling how the document is parsed.
+	///
+	/// \returns	\conditional_return{With exceptions}
+	///				A toml::table.
+	/// 			\conditional_return{Without exceptions}
+	///				A toml::parse_result.
+	TOML_NODISCARD
+	TOML_EXPORTED_FREE_FUNCTION
+	parse_result TOML_CALLCONV parse(byte_source doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 
 	inline namespace literals
 	{
 		TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, lit_ex, lit_noex);
+		TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, lit_pmralloc, lit_stdalloc);
+		TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
 		/// \brief	Parses TOML data from a string literal.
 		///
@@ -381,10 +568,283 @@ TOML_NAMESPACE_START
 
 #endif // TOML_HAS_CHAR8
 
+		TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+		TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 		TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 	}
 }
 TOML_NAMESPACE_END;
 
+/// \cond
+TOML_IMPL_NAMESPACE_START
+{
+	struct parse_scratch;
+
+	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, impl_ex, impl_noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, impl_pmralloc, impl_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
+	class push_parser_state
+	{
+	  public:
+		virtual void feed(std::string_view chunk) = 0;
+
+		TOML_NODISCARD
+		virtual parse_result finish() = 0;
+
+		virtual ~push_parser_state() noexcept = default;
+	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
+	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
+}
+TOML_IMPL_NAMESPACE_END;
+/// \endcond
+
+TOML_NAMESPACE_START
+{
+	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
+	/// \brief	Parses a TOML document that arrives in pieces.
+	///
+	/// \detail Rather than pulling the whole document in at once like toml::parse(), a push_parser is handed
+	///			the document a chunk at a time as it becomes available (e.g. from a socket or pipe),
+	///			parsing as much as it can from each one. Chunks may be split anywhere, even in the middle of a
+	///			UTF-8 sequence; only the part of the document that can't be parsed yet is kept around. \cpp
+	/// toml::push_parser parser;
+	/// parser.feed("a = "sv);
+	/// parser.feed("3\nb = "sv);
+	/// parser.feed("4"sv);
+	///
+	/// auto tbl = parser.finish();
+	/// std::cout << tbl["a"] << "\n";
+	/// \ecpp
+	///
+	/// \out
+	/// 3
+	/// \eout
+	///
+	/// \remarks	The result is exactly what toml::parse() would give for the concatenation of all the chunks,
+	///				including the source regions of all nodes and the details of any toml::parse_error.
+	class TOML_EXPORTED_CLASS push_parser
+	{
+	  private:
+		/// \cond
+		std::unique_ptr<impl::push_parser_state> state_;
+		/// \endcond
+
+	  public:
+		/// \brief	Constructs a push_parser for a new document.
+		///
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		/// 						If you don't have a path (or you have no intention of using paths in diagnostics)
+		/// 						then this parameter can safely be left blank.
+		/// \param 	flags			Flags controlling how the document is parsed.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit push_parser(std::string_view source_path = {}, parse_flags flags = parse_flags::none);
+
+		/// \brief	Constructs a push_parser for a new document.
+		///
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		/// \param 	flags			Flags controlling how the document is parsed.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit push_parser(std::string && source_path, parse_flags flags = parse_flags::none);
+
+#if TOML_ENABLE_WINDOWS_COMPAT
+
+		/// \brief	Constructs a push_parser for a new document.
+		///
+		/// \availability This overload is only available when #TOML_ENABLE_WINDOWS_COMPAT is enabled.
+		///
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		/// \param 	flags			Flags controlling how the document is parsed.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit push_parser(std::wstring_view source_path, parse_flags flags = parse_flags::none);
+
+#endif
+
+		/// \brief	Move constructor.
+		TOML_NODISCARD_CTOR
+		push_parser(push_parser&&) noexcept = default;
+
+		/// \brief	Move-assignment operator.
+		push_parser& operator=(push_parser&&) noexcept = default;
+
+		/// \brief	Destructor.
+		~push_parser() noexcept = default;
+
+		/// \brief	Parses the next chunk of the document.
+		///
+		/// \detail	Everything in the chunk that completes one or more top-level expressions (key-value pairs,
+		///			table headers) is parsed right away; anything left over is held until the next chunk arrives.
+		///
+		/// \remarks	\conditional_return{With exceptions}
+		///				Throws a toml::parse_error if the document is found to be invalid, after which the
+		///				push_parser should not be used again.
+		/// 			\conditional_return{Without exceptions}
+		///				Errors are reported by finish(); any chunks fed in after an error are ignored.
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void feed(std::string_view chunk);
+
+		/// \brief	Parses whatever is left of the document and returns the result.
+		///
+		/// \remarks	The push_parser should not be used again after calling this.
+		///
+		/// \returns	\conditional_return{With exceptions}
+		///				A toml::table.
+		/// 			\conditional_return{Without exceptions}
+		///				A toml::parse_result.
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result finish();
+	};
+
+	/// \brief	Parses many TOML documents one after another, reusing the parser's working memory between them.
+	///
+	/// \detail Each call to toml::parse() starts the parser's internal buffers (for keys, strings, open tables etc.)
+	///			from empty and lets them grow to fit the document. A parse_context keeps hold of them instead,
+	///			so when lots of documents are parsed with it (e.g. by one worker of a service handling many small
+	///			payloads) they're only grown once. \cpp
+	/// toml::parse_context ctx;
+	///
+	/// for (auto&& payload : payloads)
+	/// {
+	///		auto tbl = ctx.parse(payload);
+	///		// ...
+	/// }
+	/// \ecpp
+	///
+	/// \remarks	Documents parsed with a context don't depend on it in any way; they can outlive it, be moved
+	///				to other threads etc., exactly like the ones returned by toml::parse(). With
+	///				parse_flags::arena_allocation, each document still gets an arena of its own, but it starts out
+	///				sized to fit the previous document rather than growing from a small initial block.
+	///
+	/// \attention	A parse_context can only be used to parse one document at a time. Give each thread its own.
+	class TOML_EXPORTED_CLASS parse_context
+	{
+	  private:
+		/// \cond
+		std::unique_ptr<impl::parse_scratch> scratch_;
+		parse_flags flags_;
+		/// \endcond
+
+	  public:
+		/// \brief	Constructs a parse_context.
+		///
+		/// \param 	flags	Flags controlling how documents are parsed.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit parse_context(parse_flags flags = parse_flags::none);
+
+		/// \brief	Move constructor.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_context(parse_context&&) noexcept;
+
+		/// \brief	Move-assignment operator.
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_context& operator=(parse_context&&) noexcept;
+
+		/// \brief	Destructor.
+		TOML_EXPORTED_MEMBER_FUNCTION
+		~parse_context() noexcept;
+
+		/// \brief	Returns the flags documents are parsed with.
+		TOML_PURE_INLINE_GETTER
+		parse_flags flags() const noexcept
+		{
+			return flags_;
+		}
+
+		/// \brief	Parses a TOML document from a string view.
+		///
+		/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		///
+		/// \returns	\conditional_return{With exceptions}
+		///				A toml::table.
+		/// 			\conditional_return{Without exceptions}
+		///				A toml::parse_result.
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::string_view doc, std::string_view source_path = {});
+
+		/// \brief	Parses a TOML document from a string view.
+		///
+		/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		///
+		/// \returns	\conditional_return{With exceptions}
+		///				A toml::table.
+		/// 			\conditional_return{Without exceptions}
+		///				A toml::parse_result.
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::string_view doc, std::string && source_path);
+
+		/// \brief	Parses a TOML document from a stream.
+		///
+		/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		///
+		/// \returns	\conditional_return{With exceptions}
+		///				A toml::table.
+		/// 			\conditional_return{Without exceptions}
+		///				A toml::parse_result.
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::istream & doc, std::string_view source_path = {});
+
+		/// \brief	Parses a TOML document from a stream.
+		///
+		/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		///
+		/// \returns	\conditional_return{With exceptions}
+		///				A toml::table.
+		/// 			\conditional_return{Without exceptions}
+		///				A toml::parse_result.
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::istream & doc, std::string && source_path);
+
+		/// \brief	Parses a TOML document from a toml::byte_source.
+		///
+		/// \param 	doc				The TOML document to parse. Must be valid UTF-8.
+		/// \param 	source_path		The path used to initialize each node's `source().path`.
+		///
+		/// \returns	\conditional_return{With exceptions}
+		///				A toml::table.
+		/// 			\conditional_return{Without exceptions}
+		///				A toml::parse_result.
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(byte_source doc, std::string_view source_path = {});
+
+		/// \brief	Parses a TOML document from a file.
+		///
+		/// \param 	file_path		The TOML document to parse. Must be valid UTF-8.
+		///
+		/// \returns	\conditional_return{With exceptions}
+		///				A toml::table.
+		/// 			\conditional_return{Without exceptions}
+		///				A toml::parse_result.
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse_file(std::string_view file_path);
+	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
+	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
+}
+TOML_NAMESPACE_END;
+
 #include "header_end.hpp"
 #endif // TOML_ENABLE_PARSER
@@ -21,6 +21,7 @@
 #include "array.hpp"
 #include "table.hpp"
 #include "unicode.hpp"
+#include "float_parsing.hpp"
 TOML_DISABLE_WARNINGS;
 #include <istream>
 #include <fstream>
@@ -33,13 +34,89 @@ TOML_DISABLE_WARNINGS;
 #if !TOML_INT_CHARCONV
 #include <iomanip>
 #endif
+#if !TOML_WINDOWS && (TOML_UNIX || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 TOML_ENABLE_WARNINGS;
+#if TOML_WINDOWS && !defined(_WINDOWS_)
+#if TOML_INCLUDE_WINDOWS_H
+#include <Windows.h>
+#else
+
+struct _SECURITY_ATTRIBUTES;
+
+extern "C" __declspec(dllimport) void* __stdcall CreateFileW(const wchar_t* lpFileName,
+															 unsigned long dwDesiredAccess,
+															 unsigned long dwShareMode,
+															 _SECURITY_ATTRIBUTES* lpSecurityAttributes,
+															 unsigned long dwCreationDisposition,
+															 unsigned long dwFlagsAndAttributes,
+															 void* hTemplateFile);
+
+extern "C" __declspec(dllimport) unsigned long __stdcall GetFileType(void* hFile);
+
+extern "C" __declspec(dllimport) unsigned long __stdcall GetFileSize(void* hFile, unsigned long* lpFileSizeHigh);
+
+extern "C" __declspec(dllimport) void* __stdcall CreateFileMappingW(void* hFile,
+																	_SECURITY_ATTRIBUTES* lpFileMappingAttributes,
+																	unsigned long flProtect,
+																	unsigned long dwMaximumSizeHigh,
+																	unsigned long dwMaximumSizeLow,
+																	const wchar_t* lpName);
+
+#ifdef _WIN64
+extern "C" __declspec(dllimport) void* __stdcall MapViewOfFile(void* hFileMappingObject,
+															   unsigned long dwDesiredAccess,
+															   unsigned long dwFileOffsetHigh,
+															   unsigned long dwFileOffsetLow,
+															   unsigned long long dwNumberOfBytesToMap);
+#else
+extern "C" __declspec(dllimport) void* __stdcall MapViewOfFile(void* hFileMappingObject,
+															   unsigned long dwDesiredAccess,
+															   unsigned long dwFileOffsetHigh,
+															   unsigned long dwFileOffsetLow,
+															   unsigned long dwNumberOfBytesToMap);
+#endif
+
+extern "C" __declspec(dllimport) int __stdcall UnmapViewOfFile(const void* lpBaseAddress);
+
+extern "C" __declspec(dllimport) int __stdcall CloseHandle(void* hObject);
+
+#endif // TOML_INCLUDE_WINDOWS_H
+#endif // TOML_WINDOWS && !_WINDOWS_
 #include "header_start.hpp"
 
 //#---------------------------------------------------------------------------------------------------------------------
 //# UTF8 STREAMS
 //#---------------------------------------------------------------------------------------------------------------------
 
+TOML_IMPL_NAMESPACE_START
+{
+	// the raw bytes read from a stream before they're decoded. kept in the parse_scratch when there's a
+	// toml::parse_context so each document parsed with it doesn't allocate a fresh chunk.
+	struct stream_chunk_buffer
+	{
+		std::unique_ptr<char[]> bytes;
+		size_t capacity = {};
+
+		char* reserve(size_t size)
+		{
+			if (capacity < size)
+			{
+				bytes.reset();
+				capacity = {};
+				bytes.reset(new char[size]);
+				capacity = size;
+			}
+			return bytes.get();
+		}
+	};
+}
+TOML_IMPL_NAMESPACE_END;
+
 TOML_ANON_NAMESPACE_START
 {
 	template <typename T>
@@ -48,118 +125,107 @@ TOML_ANON_NAMESPACE_START
 	TOML_INTERNAL_LINKAGE
 	constexpr auto utf8_byte_order_mark = "\xEF\xBB\xBF"sv;
 
-	template <typename Char>
-	class utf8_byte_stream<std::basic_string_view<Char>>
+	template <>
+	class utf8_byte_stream<std::istream>
 	{
-		static_assert(sizeof(Char) == 1);
-
 	  private:
-		std::basic_string_view<Char> source_;
-		size_t position_ = {};
+		std::istream* source_;
 
 	  public:
 		TOML_NODISCARD_CTOR
-		explicit constexpr utf8_byte_stream(std::basic_string_view<Char> sv) noexcept //
-			: source_{ sv }
-		{
-			// skip bom
-			if (source_.length() >= 3u && memcmp(utf8_byte_order_mark.data(), source_.data(), 3u) == 0)
-				position_ += 3u;
-		}
+		explicit utf8_byte_stream(std::istream& stream) noexcept //
+			: source_{ &stream }
+		{}
 
-		TOML_CONST_INLINE_GETTER
-		constexpr bool error() const noexcept
+		TOML_PURE_INLINE_GETTER
+		size_t chunk_size() const noexcept
 		{
-			return false;
+			return byte_source::default_chunk_size;
 		}
 
 		TOML_PURE_INLINE_GETTER
-		constexpr bool eof() const noexcept
+		bool error() const noexcept
 		{
-			return position_ >= source_.length();
+			return !!(source_->rdstate() & std::istream::badbit);
 		}
 
 		TOML_PURE_INLINE_GETTER
-		explicit constexpr operator bool() const noexcept
+		bool eof() const noexcept
 		{
-			return !eof();
+			return !!(source_->rdstate() & std::istream::eofbit);
 		}
 
 		TOML_PURE_INLINE_GETTER
-		constexpr bool peek_eof() const noexcept
+		explicit operator bool() const noexcept
 		{
-			return eof();
+			return !(source_->rdstate() & (std::istream::badbit | std::istream::eofbit));
 		}
 
 		TOML_NODISCARD
 		TOML_ATTR(nonnull)
-		size_t operator()(void* dest, size_t num) noexcept
+		size_t operator()(char* dest, size_t num) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
 		{
-			TOML_ASSERT_ASSUME(!eof());
+			TOML_ASSERT(*this);
 
-			num = impl::min(position_ + num, source_.length()) - position_;
-			std::memcpy(dest, source_.data() + position_, num);
-			position_ += num;
-			return num;
+			source_->read(dest, static_cast<std::streamsize>(num));
+			return static_cast<size_t>(source_->gcount());
 		}
 	};
 
 	template <>
-	class utf8_byte_stream<std::istream>
+	class utf8_byte_stream<byte_source>
 	{
 	  private:
-		std::istream* source_;
+		byte_source source_;
+		bool eof_	= false;
+		bool error_ = false;
 
 	  public:
 		TOML_NODISCARD_CTOR
-		explicit utf8_byte_stream(std::istream& stream) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) //
-			: source_{ &stream }
-		{
-			if (!*this) // eof, bad
-				return;
-
-			const auto initial_pos = source_->tellg();
-			char bom[3];
-			source_->read(bom, 3);
-			if (source_->bad() || (source_->gcount() == 3 && memcmp(utf8_byte_order_mark.data(), bom, 3u) == 0))
-				return;
+		explicit utf8_byte_stream(byte_source source) noexcept //
+			: source_{ source }
+		{}
 
-			source_->clear();
-			source_->seekg(initial_pos, std::istream::beg);
+		TOML_PURE_INLINE_GETTER
+		size_t chunk_size() const noexcept
+		{
+			return source_.chunk_size();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		bool error() const noexcept
 		{
-			return !!(source_->rdstate() & std::istream::badbit);
+			return error_;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		bool eof() const noexcept
 		{
-			return !!(source_->rdstate() & std::istream::eofbit);
+			return eof_;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		explicit operator bool() const noexcept
 		{
-			return !(source_->rdstate() & (std::istream::badbit | std::istream::eofbit));
-		}
-
-		TOML_NODISCARD
-		bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
-		{
-			return eof() || source_->peek() == std::istream::traits_type::eof();
+			return !eof_ && !error_;
 		}
 
 		TOML_NODISCARD
 		TOML_ATTR(nonnull)
-		size_t operator()(void* dest, size_t num) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		size_t operator()(char* dest, size_t num)
 		{
 			TOML_ASSERT(*this);
 
-			source_->read(static_cast<char*>(dest), static_cast<std::streamsize>(num));
-			return static_cast<size_t>(source_->gcount());
+			const auto read = source_(dest, num);
+			if TOML_UNLIKELY(read == byte_source::read_error)
+			{
+				error_ = true;
+				return {};
+			}
+			TOML_ASSERT(read <= num);
+
+			eof_ = !read;
+			return read;
 		}
 	};
 
@@ -182,29 +248,18 @@ TOML_ANON_NAMESPACE_START
 			return value;
 		}
 	};
-	static_assert(std::is_trivial_v<utf8_codepoint>);
+	static_assert(std::is_trivially_copyable_v<utf8_codepoint>);
 	static_assert(std::is_standard_layout_v<utf8_codepoint>);
 
-	struct TOML_ABSTRACT_INTERFACE utf8_reader_interface
-	{
-		TOML_NODISCARD
-		virtual const source_path_ptr& source_path() const noexcept = 0;
-
-		TOML_NODISCARD
-		virtual const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) = 0;
-
-		TOML_NODISCARD
-		virtual bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) = 0;
-
-#if !TOML_EXCEPTIONS
-
-		TOML_NODISCARD
-		virtual optional<parse_error>&& error() noexcept = 0;
-
-#endif
-
-		virtual ~utf8_reader_interface() noexcept = default;
-	};
+	// utf8_reader<T> specializations all provide the same interface:
+	//
+	//	const source_path_ptr& source_path() const noexcept;
+	//	const utf8_codepoint* read_next();
+	//	bool peek_eof();
+	//	source_index end_offset() const noexcept;
+	//	optional<parse_error>&& error() noexcept; // noexcept mode only
+	//
+	// the parser is templated on the concrete reader type so reading each codepoint can be inlined.
 
 #if TOML_EXCEPTIONS
 #define utf8_reader_error(...)				throw parse_error(__VA_ARGS__)
@@ -229,13 +284,28 @@ TOML_ANON_NAMESPACE_START
 #define TOML_OVERALIGNED alignas(32)
 #endif
 
+	// reader for documents that arrive in pieces (streams, byte sources).
+	// raw bytes are read from the source in large chunks, then decoded into blocks of codepoints.
 	template <typename T>
-	class TOML_EMPTY_BASES utf8_reader final : public utf8_reader_interface
+	class utf8_reader
 	{
 	  private:
 		static constexpr size_t block_capacity = 32;
 		utf8_byte_stream<T> stream_;
 		source_position next_pos_ = { 1, 1 };
+		source_position last_pos_ = { 1, 1 }; // position of the most recently decoded codepoint
+
+		impl::stream_chunk_buffer own_buffer_;
+		impl::stream_chunk_buffer* borrowed_buffer_ = {};
+
+		struct chunk_t
+		{
+			char* bytes;
+			size_t capacity;
+			size_t pos;
+			size_t count;
+			bool first;
+		} chunk_;
 
 		impl::utf8_decoder decoder_;
 		struct currently_decoding_t
@@ -257,24 +327,18 @@ TOML_ANON_NAMESPACE_START
 		optional<parse_error> err_;
 #endif
 
-		bool read_next_block() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		size_t read_from_stream(char* dest, size_t num) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
 		{
-			TOML_ASSERT(stream_);
-
-			TOML_OVERALIGNED char raw_bytes[block_capacity];
-			size_t raw_bytes_read;
-
-			// read the next raw (encoded) block in from the stream
-			if constexpr (noexcept(stream_(raw_bytes, block_capacity)) || !TOML_EXCEPTIONS)
+			if constexpr (noexcept(stream_(dest, num)) || !TOML_EXCEPTIONS)
 			{
-				raw_bytes_read = stream_(raw_bytes, block_capacity);
+				return stream_(dest, num);
 			}
 #if TOML_EXCEPTIONS
 			else
 			{
 				try
 				{
-					raw_bytes_read = stream_(raw_bytes, block_capacity);
+					return stream_(dest, num);
 				}
 				catch (const std::exception& exc)
 				{
@@ -286,9 +350,41 @@ TOML_ANON_NAMESPACE_START
 				}
 			}
 #endif // TOML_EXCEPTIONS
+		}
+
+		bool read_next_chunk() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			TOML_ASSERT(chunk_.pos == chunk_.count);
+
+			if (!stream_)
+				return false;
+
+			if (!chunk_.bytes)
+				chunk_.bytes = (borrowed_buffer_ ? *borrowed_buffer_ : own_buffer_).reserve(chunk_.capacity);
+
+			chunk_.pos	 = {};
+			chunk_.count = read_from_stream(chunk_.bytes, chunk_.capacity);
+
+			// skip the BOM
+			// (sources are allowed to hand it over in pieces)
+			if (chunk_.first)
+			{
+				chunk_.first = false;
+				while (chunk_.count && chunk_.count < 3u && stream_
+					   && memcmp(utf8_byte_order_mark.data(), chunk_.bytes, chunk_.count) == 0)
+					chunk_.count += read_from_stream(chunk_.bytes + chunk_.count, chunk_.capacity - chunk_.count);
+
+				if (chunk_.count >= 3u && memcmp(utf8_byte_order_mark.data(), chunk_.bytes, 3u) == 0)
+				{
+					chunk_.pos		 = 3u;
+					next_pos_.offset = 3u;
+					if (chunk_.pos == chunk_.count)
+						return read_next_chunk();
+				}
+			}
 
 			// handle a zero-byte read
-			if TOML_UNLIKELY(!raw_bytes_read)
+			if TOML_UNLIKELY(chunk_.pos == chunk_.count)
 			{
 				if (stream_.eof())
 				{
@@ -297,9 +393,15 @@ TOML_ANON_NAMESPACE_START
 					// the EOF flag, and that's totally fine
 					if (decoder_.needs_more_input())
 						utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
-										  next_pos_,
+										  last_pos_,
 										  source_path_);
 				}
+				else if (stream_.error())
+				{
+					utf8_reader_error("An I/O error occurred while reading from the underlying stream",
+									  next_pos_,
+									  source_path_);
+				}
 				else
 				{
 					utf8_reader_error("Reading from the underlying stream failed - zero bytes read",
@@ -309,16 +411,31 @@ TOML_ANON_NAMESPACE_START
 				return false;
 			}
 
+			return true;
+		}
+
+		bool read_next_block() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			// read the next raw (encoded) block in from the current chunk
+			if (chunk_.pos == chunk_.count && !read_next_chunk())
+				return false;
+
+			const char* const raw_bytes = chunk_.bytes + chunk_.pos;
+			const size_t raw_bytes_read = impl::min(chunk_.count - chunk_.pos, block_capacity);
+			chunk_.pos += raw_bytes_read;
+
 			TOML_ASSERT_ASSUME(raw_bytes_read);
-			std::memset(&codepoints_, 0, sizeof(codepoints_));
+			std::memset(static_cast<void*>(&codepoints_), 0, sizeof(codepoints_));
 
-			// helper for calculating decoded codepoint line+cols
+			// helper for calculating decoded codepoint line+cols (and offsets)
+			// (the text is gone once it's decoded, so unlike the contiguous reader these can't be worked out later)
 			const auto calc_positions = [&]() noexcept
 			{
 				for (size_t i = 0; i < codepoints_.count; i++)
 				{
 					auto& cp	= codepoints_.buffer[i];
 					cp.position = next_pos_;
+					next_pos_.offset += static_cast<source_index>(cp.count);
 
 					if (cp == U'\n')
 					{
@@ -355,7 +472,7 @@ TOML_ANON_NAMESPACE_START
 				// helper for getting precise error location
 				const auto error_pos = [&]() noexcept -> const source_position&
 				{ //
-					return codepoints_.count ? codepoints_.buffer[codepoints_.count - 1u].position : next_pos_;
+					return codepoints_.count ? codepoints_.buffer[codepoints_.count - 1u].position : last_pos_;
 				};
 
 				for (size_t i = 0; i < raw_bytes_read; i++)
@@ -386,7 +503,7 @@ TOML_ANON_NAMESPACE_START
 						utf8_reader_return_after_error(false);
 					}
 				}
-				if TOML_UNLIKELY(decoder_.needs_more_input() && stream_.eof())
+				if TOML_UNLIKELY(decoder_.needs_more_input() && chunk_.pos == chunk_.count && stream_.eof())
 				{
 					calc_positions();
 					utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
@@ -394,10 +511,15 @@ TOML_ANON_NAMESPACE_START
 									  source_path_);
 					utf8_reader_return_after_error(false);
 				}
+
+				// the whole block was the start of a sequence that continues in the next one
+				if TOML_UNLIKELY(!codepoints_.count)
+					return read_next_block();
 			}
 
 			TOML_ASSERT_ASSUME(codepoints_.count);
 			calc_positions();
+			last_pos_ = codepoints_.buffer[codepoints_.count - 1u].position;
 
 			// handle general I/O errors
 			// (down here so the next_pos_ benefits from calc_positions())
@@ -419,6 +541,12 @@ TOML_ANON_NAMESPACE_START
 			std::is_nothrow_constructible_v<utf8_byte_stream<T>, U&&>)
 			: stream_{ static_cast<U&&>(source) }
 		{
+			chunk_.bytes	= {};
+			chunk_.capacity = stream_.chunk_size();
+			chunk_.pos		= {};
+			chunk_.count	= {};
+			chunk_.first	= true;
+
 			currently_decoding_.count = {};
 
 			codepoints_.current = {};
@@ -428,20 +556,34 @@ TOML_ANON_NAMESPACE_START
 				source_path_ = std::make_shared<const std::string>(static_cast<String&&>(source_path));
 		}
 
+		// reads into the given buffer instead of one of the reader's own (must be called before anything is read)
+		void use_chunk_buffer(impl::stream_chunk_buffer& buffer) noexcept
+		{
+			TOML_ASSERT(!chunk_.bytes);
+			borrowed_buffer_ = &buffer;
+		}
+
 		TOML_PURE_INLINE_GETTER
-		const source_path_ptr& source_path() const noexcept final
+		const source_path_ptr& source_path() const noexcept
 		{
 			return source_path_;
 		}
 
+		// offset of the byte following everything read so far (i.e. of EOF, once it's been reached)
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return next_pos_.offset;
+		}
+
 		TOML_NODISCARD
-		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) final
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
 		{
 			utf8_reader_error_check({});
 
 			if (codepoints_.current == codepoints_.count)
 			{
-				if TOML_UNLIKELY(!stream_ || !read_next_block())
+				if TOML_UNLIKELY(!read_next_block())
 					return nullptr;
 
 				TOML_ASSERT_ASSUME(!codepoints_.current);
@@ -454,15 +596,22 @@ TOML_ANON_NAMESPACE_START
 		}
 
 		TOML_NODISCARD
-		bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) final
+		bool peek_eof() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
 		{
-			return stream_.peek_eof();
+			if (codepoints_.current < codepoints_.count || chunk_.pos < chunk_.count || read_next_chunk())
+				return false;
+
+#if TOML_EXCEPTIONS
+			return true;
+#else
+			return !err_; // errors are reported by the next read_next()
+#endif
 		}
 
 #if !TOML_EXCEPTIONS
 
 		TOML_NODISCARD
-		optional<parse_error>&& error() noexcept final
+		optional<parse_error>&& error() noexcept
 		{
 			return std::move(err_);
 		}
@@ -470,195 +619,1202 @@ TOML_ANON_NAMESPACE_START
 #endif
 	};
 
+	// reader for documents that are entirely in memory already (strings, memory-mapped files).
+	// rather than decoding fixed-size blocks into an intermediate buffer, codepoints are produced one at a time
+	// straight from the source; runs of ASCII are located up-front with SIMD and converted without touching the
+	// utf-8 decoder. only non-ASCII sequences go through impl::utf8_decoder.
+	// read_next() still fills in a utf8_codepoint for everything it returns; it's remaining() and skip_ascii()
+	// that let the parser consume runs of bytes (strings, whitespace, comments) without one per character.
+	// the positions of those codepoints only have their offsets filled in; lines and columns are worked out on demand
+	// by position(), so they cost nothing for text that never ends up in a source region or error.
 	template <typename Char>
-	utf8_reader(std::basic_string_view<Char>, std::string_view) -> utf8_reader<std::basic_string_view<Char>>;
-	template <typename Char>
-	utf8_reader(std::basic_string_view<Char>, std::string&&) -> utf8_reader<std::basic_string_view<Char>>;
-	template <typename Char>
-	utf8_reader(std::basic_istream<Char>&, std::string_view) -> utf8_reader<std::basic_istream<Char>>;
-	template <typename Char>
-	utf8_reader(std::basic_istream<Char>&, std::string&&) -> utf8_reader<std::basic_istream<Char>>;
+	class utf8_reader<std::basic_string_view<Char>>
+	{
+		static_assert(sizeof(Char) == 1);
 
-#if TOML_EXCEPTIONS
-#define utf8_buffered_reader_error_check(...) static_assert(true)
-#else
-#define utf8_buffered_reader_error_check(...)                                                                          \
-	do                                                                                                                 \
-	{                                                                                                                  \
-		if TOML_UNLIKELY(reader_.error())                                                                              \
-			return __VA_ARGS__;                                                                                        \
-	}                                                                                                                  \
-	while (false)
+	  private:
+		// codepoints handed out by read_next() are written into a small ring so the last few remain valid
+		// (the parser keeps hold of the previous codepoint in a few places)
+		static constexpr size_t ring_size	   = 4;
+		static constexpr size_t ascii_scan_size = 256;
+
+		const char* begin_;
+		const char* pos_;
+		const char* end_;
+		const char* ascii_end_;
+		source_index begin_offset_ = {}; // offset of begin_ from the start of the document
+		utf8_codepoint codepoints_[ring_size] = {};
+		size_t current_ = ring_size - 1u;
+		bool returned_eof_ = false;
+		bool valid_utf8_   = false;
+		source_path_ptr source_path_;
 
-#endif
+		// the furthest position worked out by position() so far, and the offsets of the lines it's passed
+		// (the start of line N is line_starts_[N - 2], line 1 starting at first_line_offset_)
+		source_position known_			 = { 1, 1 };
+		source_index first_line_offset_ = {};
+		std::vector<source_index> line_starts_;
+		source_position previous_piece_last_ = { 1, 1 }; // (see finish_piece())
 
-	class TOML_EMPTY_BASES utf8_buffered_reader
-	{
-	  public:
-		static constexpr size_t max_history_length = 128;
+#if !TOML_EXCEPTIONS
+		optional<parse_error> err_;
+#endif
 
-	  private:
-		static constexpr size_t history_buffer_size = max_history_length - 1; //'head' is stored in the reader
-		utf8_reader_interface& reader_;
-		struct
+		TOML_PURE_INLINE_GETTER
+		source_index offset_of(const char* p) const noexcept
 		{
-			utf8_codepoint buffer[history_buffer_size];
-			size_t count, first;
-		} history_					= {};
-		const utf8_codepoint* head_ = {};
-		size_t negative_offset_		= {};
-
-	  public:
-		TOML_NODISCARD_CTOR
-		explicit utf8_buffered_reader(utf8_reader_interface& reader) noexcept //
-			: reader_{ reader }
-		{}
+			return static_cast<source_index>(begin_offset_ + static_cast<size_t>(p - begin_));
+		}
 
 		TOML_PURE_INLINE_GETTER
-		const source_path_ptr& source_path() const noexcept
+		const char* at_offset(source_index offset) const noexcept
 		{
-			return reader_.source_path();
+			TOML_ASSERT_ASSUME(offset >= begin_offset_);
+			return begin_ + (offset - begin_offset_);
+		}
+
+		// (every byte that isn't a utf-8 continuation byte begins a codepoint)
+		TOML_PURE_GETTER
+		static source_index count_codepoints(const char* str, const char* end) noexcept
+		{
+			size_t count = {};
+			while (str < end)
+			{
+				const auto ascii = impl::ascii_prefix_length(str, static_cast<size_t>(end - str));
+				count += ascii;
+				for (str += ascii; str < end && static_cast<unsigned char>(*str) >= 0x80u; str++)
+					count += (static_cast<unsigned char>(*str) & 0xC0u) != 0x80u;
+			}
+			return static_cast<source_index>(count);
 		}
 
 		TOML_NODISCARD
-		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		utf8_codepoint& next_codepoint() noexcept
 		{
-			utf8_buffered_reader_error_check({});
+			current_ = (current_ + 1u) % ring_size;
 
-			if (negative_offset_)
+			auto& cp		   = codepoints_[current_];
+			cp.position.offset = offset_of(pos_);
+
+			return cp;
+		}
+
+		TOML_NODISCARD
+		TOML_NEVER_INLINE
+		const utf8_codepoint* read_next_non_ascii() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			// the whole document was already validated up-front, so we can decode without checking anything
+			if (valid_utf8_)
 			{
-				negative_offset_--;
+				auto& cp		= next_codepoint();
+				const auto lead = static_cast<unsigned char>(*pos_);
+				TOML_ASSERT_ASSUME(lead >= 0xC0u);
 
-				// an entry negative offset of 1 just means "replay the current head"
-				if (!negative_offset_)
-					return head_;
+				cp.count = lead < 0xE0u ? 2u : (lead < 0xF0u ? 3u : 4u);
+				cp.value = static_cast<char32_t>(lead & (0x7Fu >> cp.count));
+				TOML_ASSERT_ASSUME(static_cast<size_t>(end_ - pos_) >= cp.count);
 
-				// otherwise step back into the history buffer
-				else
-					return history_.buffer
-						 + ((history_.first + history_.count - negative_offset_) % history_buffer_size);
+				cp.bytes[0] = *pos_++;
+				for (size_t i = 1; i < cp.count; i++)
+				{
+					cp.bytes[i] = *pos_++;
+					cp.value	= (cp.value << 6) | (static_cast<unsigned char>(cp.bytes[i]) & 0x3Fu);
+				}
+
+				return &cp;
 			}
-			else
-			{
-				// first character read from stream
-				if TOML_UNLIKELY(!history_.count && !head_)
-					head_ = reader_.read_next();
 
-				// subsequent characters and not eof
-				else if (head_)
+			// errors are reported at the last successfully-decoded codepoint (same as the stream reader)
+			const auto last_offset = codepoints_[current_].position.offset;
+			const auto error_pos   = last_offset < begin_offset_ ? previous_piece_last_ : position(last_offset);
+
+			auto& cp = next_codepoint();
+			cp.count = {};
+
+			impl::utf8_decoder decoder;
+			do
+			{
+				if TOML_UNLIKELY(pos_ == end_)
 				{
-					if TOML_UNLIKELY(history_.count < history_buffer_size)
-						history_.buffer[history_.count++] = *head_;
-					else
-						history_.buffer[(history_.first++ + history_buffer_size) % history_buffer_size] = *head_;
+					utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
+									  error_pos,
+									  source_path_);
+					utf8_reader_return_after_error(nullptr);
+				}
 
-					head_ = reader_.read_next();
+				decoder(static_cast<uint8_t>(*pos_));
+				if TOML_UNLIKELY(decoder.error())
+				{
+					utf8_reader_error("Encountered invalid utf-8 sequence", error_pos, source_path_);
+					utf8_reader_return_after_error(nullptr);
 				}
 
-				return head_;
+				cp.bytes[cp.count++] = *pos_++;
+
+				if TOML_UNLIKELY(!decoder.has_code_point() && cp.count == 4u)
+				{
+					utf8_reader_error("Encountered overlong utf-8 sequence", error_pos, source_path_);
+					utf8_reader_return_after_error(nullptr);
+				}
 			}
+			while (!decoder.has_code_point());
+
+			cp.value = decoder.codepoint;
+			return &cp;
 		}
 
-		TOML_NODISCARD
-		const utf8_codepoint* step_back(size_t count) noexcept
+		void validate() noexcept
 		{
-			utf8_buffered_reader_error_check({});
+			// validate everything up-front; invalid documents fall back to checking each codepoint as it's read
+			// so errors are still reported in the right place.
+			// (only worth it with a vectorized validator, otherwise it's just decoding everything twice)
+			valid_utf8_ = false;
+			if (impl::active_simd_tier() >= impl::simd_tier::sse4_1)
+				valid_utf8_ = begin_ == end_ || impl::is_valid_utf8(begin_, static_cast<size_t>(end_ - begin_));
+		}
 
-			TOML_ASSERT_ASSUME(history_.count);
-			TOML_ASSERT_ASSUME(negative_offset_ + count <= history_.count);
+	  public:
+		template <typename String = std::string_view>
+		TOML_NODISCARD_CTOR
+		explicit utf8_reader(std::basic_string_view<Char> source, String&& source_path = {}) noexcept(
+			std::is_nothrow_constructible_v<std::string, String&&>)
+			: begin_{ reinterpret_cast<const char*>(source.data()) },
+			  pos_{ begin_ },
+			  end_{ begin_ + source.length() },
+			  ascii_end_{ begin_ }
+		{
+			// skip bom
+			if (source.length() >= 3u && memcmp(utf8_byte_order_mark.data(), begin_, 3u) == 0)
+			{
+				ascii_end_ = pos_ = begin_ += 3u;
+				skipped_bom();
+			}
 
-			negative_offset_ += count;
+			validate();
 
-			return negative_offset_
-					 ? history_.buffer + ((history_.first + history_.count - negative_offset_) % history_buffer_size)
-					 : head_;
+			if (!source_path.empty())
+				source_path_ = std::make_shared<const std::string>(static_cast<String&&>(source_path));
 		}
 
-		TOML_NODISCARD
-		bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		TOML_PURE_INLINE_GETTER
+		const source_path_ptr& source_path() const noexcept
 		{
-			return reader_.peek_eof();
+			return source_path_;
 		}
 
-#if !TOML_EXCEPTIONS
+		// offset of the end of the source (i.e. of EOF)
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return offset_of(end_);
+		}
 
+		// works out the line and column of an offset from one of the codepoints handed out by read_next().
+		// positions ahead of the furthest one so far are found by counting forward from it, and ones behind it from
+		// the start of their line (or back from the furthest one, if they're on the same line).
 		TOML_NODISCARD
-		optional<parse_error>&& error() noexcept
+		source_position position(source_index offset)
 		{
-			return reader_.error();
-		}
+			if (offset >= known_.offset)
+			{
+				if (offset == known_.offset)
+					return known_;
 
-#endif
-	};
-}
-TOML_ANON_NAMESPACE_END;
+				auto str		  = at_offset(known_.offset);
+				const auto target = at_offset(offset);
+				while (const auto nl =
+						   static_cast<const char*>(std::memchr(str, '\n', static_cast<size_t>(target - str))))
+				{
+					str = nl + 1;
+					line_starts_.push_back(offset_of(str));
+					known_.line++;
+					known_.column = source_index{ 1 };
+				}
+				known_.column += count_codepoints(str, target);
+				known_.offset = offset;
+				return known_;
+			}
+
+			// (the number of lines starting at or before the offset, not using std::upper_bound to avoid <algorithm>)
+			size_t first = {}, count = line_starts_.size();
+			while (count)
+			{
+				const auto step = count / 2u;
+				if (line_starts_[first + step] <= offset)
+				{
+					first += step + 1u;
+					count -= step + 1u;
+				}
+				else
+					count = step;
+			}
+
+			const auto line = static_cast<source_index>(first + 1u);
+			if (line == known_.line)
+				return { line,
+						 static_cast<source_index>(known_.column
+												   - count_codepoints(at_offset(offset), at_offset(known_.offset))),
+						 offset };
+
+			const auto line_start = line == 1u ? first_line_offset_ : line_starts_[line - 2u];
+			return { line,
+					 static_cast<source_index>(1u + count_codepoints(at_offset(line_start), at_offset(offset))),
+					 offset };
+		}
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			utf8_reader_error_check({});
+
+			if TOML_UNLIKELY(pos_ == end_)
+			{
+				returned_eof_ = true;
+				return nullptr;
+			}
+
+			// find the next run of ASCII characters
+			// (checking the first byte here saves a trip through the SIMD dispatch table for every character
+			// of text that's mostly non-ASCII)
+			if (pos_ >= ascii_end_)
+			{
+				if (static_cast<unsigned char>(*pos_) >= 0x80u)
+					return read_next_non_ascii();
+
+				ascii_end_ = pos_ + 1
+						   + impl::ascii_prefix_length(pos_ + 1,
+													   impl::min(static_cast<size_t>(end_ - pos_) - 1u, ascii_scan_size));
+			}
+
+			// ASCII fast-path
+			TOML_ASSERT_ASSUME(pos_ < ascii_end_);
+			auto& cp	= next_codepoint();
+			cp.value	= static_cast<char32_t>(static_cast<unsigned char>(*pos_));
+			cp.bytes[0] = *pos_++;
+			cp.count	= 1u;
+			return &cp;
+		}
+
+		// the rest of the source, starting at the codepoint most recently returned by read_next()
+		TOML_PURE_INLINE_GETTER
+		std::string_view remaining() const noexcept
+		{
+			TOML_ASSERT_ASSUME(!returned_eof_);
+
+			const auto head = pos_ - codepoints_[current_].count;
+			return { head, static_cast<size_t>(end_ - head) };
+		}
+
+		// skips 'count' bytes of the source, starting at the codepoint most recently returned by read_next(),
+		// and returns the codepoint that follows them. the skipped bytes must all be ASCII and not line breaks.
+		TOML_NODISCARD
+		const utf8_codepoint* skip_ascii(size_t count) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			TOML_ASSERT_ASSUME(!returned_eof_);
+			TOML_ASSERT_ASSUME(count);
+
+			auto& head = codepoints_[current_];
+			TOML_ASSERT_ASSUME(head.count == 1u);
+			TOML_ASSERT_ASSUME(count <= static_cast<size_t>(end_ - pos_) + 1u);
+
+			pos_ += count - 1u;
+
+			// the head's slot in the ring now stands in for the last skipped character
+			// (it's what step_back() and error reporting work from)
+			head.position.offset = offset_of(pos_ - 1);
+			head.value			 = static_cast<char32_t>(static_cast<unsigned char>(pos_[-1]));
+			head.bytes[0]		 = pos_[-1];
+
+			return read_next();
+		}
+
+		// steps back to the codepoint 'count' positions before the one most recently returned by read_next()
+		// (or before EOF). the document is all in memory so this is just a matter of walking back over the source
+		// and decoding the codepoint found there again.
+		TOML_NODISCARD
+		const utf8_codepoint* step_back(size_t count) noexcept
+		{
+			utf8_reader_error_check({});
+			TOML_ASSERT_ASSUME(count);
+
+			const char* p;
+			bool all_ascii;
+			if (returned_eof_)
+			{
+				p		  = end_;
+				all_ascii = true;
+			}
+			else
+			{
+				const auto& head = codepoints_[current_];
+				p				 = pos_ - head.count;
+				all_ascii		 = head.count == 1u;
+			}
+
+			for (; count; count--)
+			{
+				TOML_ASSERT_ASSUME(p > begin_);
+
+				do
+					p--;
+				while ((static_cast<unsigned char>(*p) & 0xC0u) == 0x80u);
+
+				all_ascii = all_ascii && static_cast<unsigned char>(*p) < 0x80u;
+			}
+
+			// [p, pos_) is only known to be pure ASCII if we didn't step back over anything else
+			if (!all_ascii)
+				ascii_end_ = p;
+
+			returned_eof_ = false;
+			pos_		  = p;
+			return read_next();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool peek_eof() const noexcept
+		{
+			return pos_ == end_;
+		}
+
+		// moves on to the next piece of a document that's arriving in pieces (see toml::push_parser).
+		// positions carry on from where the previous piece left off, so the pieces must be split after line breaks
+		// (and follow on from one another directly, so the offsets stay correct).
+		void reset(std::basic_string_view<Char> source) noexcept
+		{
+			TOML_ASSERT(known_.offset == end_offset());
+
+			begin_offset_ = end_offset();
+			begin_		  = reinterpret_cast<const char*>(source.data());
+			pos_		  = begin_;
+			end_		  = begin_ + source.length();
+			ascii_end_	  = begin_;
+			returned_eof_ = false;
+
+			validate();
+		}
+
+		// counts the lines in the rest of the current piece, which must be done before it goes away
+		// (along with working out where its last codepoint is, in case an error is reported there)
+		void finish_piece()
+		{
+			static_cast<void>(position(end_offset()));
+			previous_piece_last_ = position(codepoints_[current_].position.offset);
+		}
+
+		// accounts for a byte order mark skipped at the start of the document
+		// (the push parser strips it itself, since it might arrive split across chunks)
+		void skipped_bom() noexcept
+		{
+			TOML_ASSERT(!known_.offset);
+
+			begin_offset_ += 3u;
+			known_.offset	   = begin_offset_;
+			first_line_offset_ = begin_offset_;
+			codepoints_[current_].position.offset = begin_offset_;
+		}
+
+#if !TOML_EXCEPTIONS
+
+		TOML_NODISCARD
+		optional<parse_error>&& error() noexcept
+		{
+			return std::move(err_);
+		}
+
+#endif
+	};
+
+	template <typename Char>
+	utf8_reader(std::basic_string_view<Char>, std::string_view) -> utf8_reader<std::basic_string_view<Char>>;
+	template <typename Char>
+	utf8_reader(std::basic_string_view<Char>, std::string&&) -> utf8_reader<std::basic_string_view<Char>>;
+	template <typename Char>
+	utf8_reader(std::basic_istream<Char>&, std::string_view) -> utf8_reader<std::basic_istream<Char>>;
+	template <typename Char>
+	utf8_reader(std::basic_istream<Char>&, std::string&&) -> utf8_reader<std::basic_istream<Char>>;
+
+#if TOML_EXCEPTIONS
+#define utf8_buffered_reader_error_check(...) static_assert(true)
+#else
+#define utf8_buffered_reader_error_check(...)                                                                          \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if TOML_UNLIKELY(reader_.error())                                                                              \
+			return __VA_ARGS__;                                                                                        \
+	}                                                                                                                  \
+	while (false)
+
+#endif
+
+	template <typename Reader>
+	class utf8_buffered_reader
+	{
+	  public:
+		static constexpr size_t max_history_length = 128;
+		static constexpr bool is_contiguous		   = false;
+
+	  private:
+		static constexpr size_t history_buffer_size = max_history_length - 1; //'head' is stored in the reader
+		Reader& reader_;
+		struct
+		{
+			utf8_codepoint buffer[history_buffer_size];
+			size_t count, first;
+		} history_					= {};
+		const utf8_codepoint* head_ = {};
+		size_t negative_offset_		= {};
+
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit utf8_buffered_reader(Reader& reader) noexcept //
+			: reader_{ reader }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		const source_path_ptr& source_path() const noexcept
+		{
+			return reader_.source_path();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return reader_.end_offset();
+		}
+
+		// (the reader works out the positions of codepoints as they're decoded)
+		TOML_PURE_INLINE_GETTER
+		const source_position& resolve(const source_position& pos) const noexcept
+		{
+			return pos;
+		}
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			utf8_buffered_reader_error_check({});
+
+			if (negative_offset_)
+			{
+				negative_offset_--;
+
+				// an entry negative offset of 1 just means "replay the current head"
+				if (!negative_offset_)
+					return head_;
+
+				// otherwise step back into the history buffer
+				else
+					return history_.buffer
+						 + ((history_.first + history_.count - negative_offset_) % history_buffer_size);
+			}
+			else
+			{
+				// first character read from stream
+				if TOML_UNLIKELY(!history_.count && !head_)
+					head_ = reader_.read_next();
+
+				// subsequent characters and not eof
+				else if (head_)
+				{
+					if TOML_UNLIKELY(history_.count < history_buffer_size)
+						history_.buffer[history_.count++] = *head_;
+					else
+						history_.buffer[(history_.first++ + history_buffer_size) % history_buffer_size] = *head_;
+
+					head_ = reader_.read_next();
+				}
+
+				return head_;
+			}
+		}
+
+		TOML_NODISCARD
+		const utf8_codepoint* step_back(size_t count) noexcept
+		{
+			utf8_buffered_reader_error_check({});
+
+			TOML_ASSERT_ASSUME(history_.count);
+			TOML_ASSERT_ASSUME(negative_offset_ + count <= history_.count);
+
+			negative_offset_ += count;
+
+			return negative_offset_
+					 ? history_.buffer + ((history_.first + history_.count - negative_offset_) % history_buffer_size)
+					 : head_;
+		}
+
+		TOML_NODISCARD
+		bool peek_eof() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.peek_eof();
+		}
+
+#if !TOML_EXCEPTIONS
+
+		TOML_NODISCARD
+		optional<parse_error>&& error() noexcept
+		{
+			return reader_.error();
+		}
+
+#endif
+	};
+
+	// contiguous inputs don't need a history buffer; the reader can step back over the source directly.
+	template <typename Char>
+	class utf8_buffered_reader<utf8_reader<std::basic_string_view<Char>>>
+	{
+	  public:
+		static constexpr size_t max_history_length = static_cast<size_t>(-1);
+		static constexpr bool is_contiguous		   = true;
+
+	  private:
+		utf8_reader<std::basic_string_view<Char>>& reader_;
+
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit utf8_buffered_reader(utf8_reader<std::basic_string_view<Char>>& reader) noexcept //
+			: reader_{ reader }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		const source_path_ptr& source_path() const noexcept
+		{
+			return reader_.source_path();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return reader_.end_offset();
+		}
+
+		// fills in the line and column of a position that only has its offset
+		// (the ones that come from the reader's codepoints; see utf8_reader::position())
+		TOML_NODISCARD
+		source_position resolve(const source_position& pos) const
+		{
+			return pos.line ? pos : reader_.position(pos.offset);
+		}
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.read_next();
+		}
+
+		TOML_NODISCARD
+		const utf8_codepoint* step_back(size_t count) noexcept
+		{
+			return reader_.step_back(count);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view remaining() const noexcept
+		{
+			return reader_.remaining();
+		}
+
+		TOML_NODISCARD
+		const utf8_codepoint* skip_ascii(size_t count) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.skip_ascii(count);
+		}
+
+		TOML_NODISCARD
+		bool peek_eof() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.peek_eof();
+		}
+
+#if !TOML_EXCEPTIONS
+
+		TOML_NODISCARD
+		optional<parse_error>&& error() noexcept
+		{
+			return reader_.error();
+		}
+
+#endif
+	};
+}
+TOML_ANON_NAMESPACE_END;
+
+//#---------------------------------------------------------------------------------------------------------------------
+//# PARSER INTERNAL IMPLEMENTATION
+//#---------------------------------------------------------------------------------------------------------------------
+
+#if TOML_EXCEPTIONS
+#define TOML_RETURNS_BY_THROWING [[noreturn]]
+#else
+#define TOML_RETURNS_BY_THROWING
+#endif
+
+TOML_ANON_NAMESPACE_START
+{
+	template <typename... T>
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	constexpr bool is_match(char32_t codepoint, T... vals) noexcept
+	{
+		static_assert((std::is_same_v<char32_t, T> && ...));
+		return ((codepoint == vals) || ...);
+	}
+
+	// run scanners for parser::consume_ascii_run()
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t basic_string_prefix_length(const char* str, size_t len) noexcept
+	{
+		return impl::plain_string_prefix_length(str, len, '"', '\\');
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t literal_string_prefix_length(const char* str, size_t len) noexcept
+	{
+		return impl::plain_string_prefix_length(str, len, '\'', '\'');
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t printable_ascii_prefix_length(const char* str, size_t len) noexcept
+	{
+		// (line breaks are control characters so they'll end the run regardless)
+		return impl::plain_string_prefix_length(str, len, '\n', '\n');
+	}
+
+	template <uint64_t>
+	struct parse_integer_traits;
+	template <>
+	struct parse_integer_traits<2>
+	{
+		static constexpr auto scope_qualifier  = "binary integer"sv;
+		static constexpr auto is_digit		   = impl::is_binary_digit;
+		static constexpr auto is_signed		   = false;
+		static constexpr auto max_digits	   = 63;
+		static constexpr auto prefix_codepoint = U'b';
+		static constexpr auto prefix		   = "b"sv;
+		static constexpr auto full_prefix	   = "0b"sv;
+	};
+	template <>
+	struct parse_integer_traits<8>
+	{
+		static constexpr auto scope_qualifier  = "octal integer"sv;
+		static constexpr auto is_digit		   = impl::is_octal_digit;
+		static constexpr auto is_signed		   = false;
+		static constexpr auto max_digits	   = 21; // strlen("777777777777777777777")
+		static constexpr auto prefix_codepoint = U'o';
+		static constexpr auto prefix		   = "o"sv;
+		static constexpr auto full_prefix	   = "0o"sv;
+	};
+	template <>
+	struct parse_integer_traits<10>
+	{
+		static constexpr auto scope_qualifier = "decimal integer"sv;
+		static constexpr auto is_digit		  = impl::is_decimal_digit;
+		static constexpr auto is_signed		  = true;
+		static constexpr auto max_digits	  = 19; // strlen("9223372036854775807")
+		static constexpr auto full_prefix	  = ""sv;
+	};
+	template <>
+	struct parse_integer_traits<16>
+	{
+		static constexpr auto scope_qualifier  = "hexadecimal integer"sv;
+		static constexpr auto is_digit		   = impl::is_hexadecimal_digit;
+		static constexpr auto is_signed		   = false;
+		static constexpr auto max_digits	   = 16; // strlen("7FFFFFFFFFFFFFFF")
+		static constexpr auto prefix_codepoint = U'x';
+		static constexpr auto prefix		   = "x"sv;
+		static constexpr auto full_prefix	   = "0x"sv;
+	};
+
+	// is 'pos' the end of a value (i.e. the end of the source or a value-terminator)?
+	TOML_PURE_INLINE_GETTER
+	bool ends_value(const char* pos, const char* end) noexcept
+	{
+		return pos == end
+			|| (static_cast<unsigned char>(*pos) < 0x80u
+				&& impl::is_value_terminator(static_cast<char32_t>(static_cast<unsigned char>(*pos))));
+	}
+
+	// SWAR helpers for scan_integer()
+
+	TOML_PURE_INLINE_GETTER
+	uint64_t load_little_endian_u64(const char* str) noexcept
+	{
+#if TOML_MSVC_LIKE || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		uint64_t val;
+		std::memcpy(&val, str, sizeof(val));
+		return val;
+#else
+		uint64_t val = {};
+		for (size_t i = 0; i < 8u; i++)
+			val |= static_cast<uint64_t>(static_cast<unsigned char>(str[i])) << (i * 8u);
+		return val;
+#endif
+	}
+
+	TOML_CONST_INLINE_GETTER
+	constexpr uint64_t repeat_byte(uint8_t val) noexcept
+	{
+		return 0x0101010101010101ull * val;
+	}
+
+	// 0x80 in each byte of 'chunk' that's in the range [lo, hi] (which must all be ASCII)
+	template <uint8_t lo, uint8_t hi>
+	TOML_CONST_INLINE_GETTER
+	constexpr uint64_t bytes_in_range(uint64_t chunk) noexcept
+	{
+		return (chunk + repeat_byte(static_cast<uint8_t>(0x80u - lo))) & ~(chunk + repeat_byte(static_cast<uint8_t>(0x7Fu - hi))) & repeat_byte(0x80u);
+	}
+
+	// are all eight characters in 'chunk' digits of the given base?
+	template <uint64_t base>
+	TOML_CONST_INLINE_GETTER
+	constexpr bool is_digit_chunk(uint64_t chunk) noexcept
+	{
+		if constexpr (base == 2)
+			return (chunk & repeat_byte(0xFEu)) == repeat_byte(0x30u);
+		else if constexpr (base == 8)
+			return (chunk & repeat_byte(0xF8u)) == repeat_byte(0x30u);
+		else if constexpr (base == 10)
+			return ((chunk & repeat_byte(0xF0u)) | (((chunk + repeat_byte(0x06u)) & repeat_byte(0xF0u)) >> 4))
+				== repeat_byte(0x33u);
+		else
+		{
+			static_assert(base == 16);
+			if (chunk & repeat_byte(0x80u))
+				return false;
+			return (bytes_in_range<'0', '9'>(chunk) | bytes_in_range<'a', 'f'>(chunk | repeat_byte(0x20u)))
+				== repeat_byte(0x80u);
+		}
+	}
+
+	// the value of eight digits of the given base (which is_digit_chunk() has already vetted), the first being the
+	// most significant. each step combines adjacent pairs of lanes, doubling their width.
+	template <uint64_t base>
+	TOML_CONST_INLINE_GETTER
+	constexpr uint64_t digit_chunk_value(uint64_t chunk) noexcept
+	{
+		if constexpr (base == 16)
+			chunk = (chunk & repeat_byte(0x0Fu)) + ((chunk >> 6) & repeat_byte(0x01u)) * 9u;
+		else
+			chunk &= repeat_byte(0x0Fu);
+
+		chunk = (chunk * base + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+		chunk = (chunk * (base * base) + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+		chunk = (chunk * (base * base * base * base) + (chunk >> 32)) & 0x00000000FFFFFFFFull;
+		return chunk;
+	}
+
+	// converts the digits (and underscores) at the start of a value in one pass, eight digits at a time where
+	// possible. only succeeds if they make up the whole value and don't exceed 'max_value' or 'max_length' digits,
+	// otherwise returns zero so the caller can take the slow path (which is where errors are reported).
+	template <uint64_t base>
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_integer(const char* str, size_t len, uint64_t max_value, size_t max_length, uint64_t& value) noexcept
+	{
+		using traits = parse_integer_traits<base>;
+		constexpr auto is_digit = [](char c) noexcept
+		{ return traits::is_digit(static_cast<char32_t>(static_cast<unsigned char>(c))); };
+
+		// bin, oct and hex can't overflow 64 bits until the digits after any leading zeroes need more bits than
+		// are left; decimals don't allow leading zeroes so counting digits is enough
+		constexpr unsigned bits_per_digit = base == 2 ? 1u : (base == 8 ? 3u : (base == 16 ? 4u : 0u));
+		constexpr uint64_t chunk_multiplier =
+			base * base * base * base * base * base * base * base; // base ^ 8
+		const auto fits = [](uint64_t val, size_t digit_count, unsigned shift) noexcept
+		{
+			if constexpr (bits_per_digit)
+				return !(val >> (64u - shift * bits_per_digit));
+			else
+			{
+				TOML_UNUSED(val);
+				TOML_UNUSED(shift);
+				return digit_count <= traits::max_digits;
+			}
+		};
+
+		TOML_ASSERT_ASSUME(len);
+		TOML_ASSERT_ASSUME(is_digit(*str));
+		if constexpr (base == 10)
+		{
+			if (*str == '0' && len > 1u && (is_digit(str[1]) || str[1] == '_'))
+				return {};
+		}
+
+		const char* p		  = str;
+		const char* const end = str + len;
+		uint64_t result		  = {};
+		size_t digit_count	  = {};
+		while (p < end)
+		{
+			while (end - p >= 8)
+			{
+				const auto chunk = load_little_endian_u64(p);
+				if (!is_digit_chunk<base>(chunk))
+					break;
+
+				digit_count += 8u;
+				if (!fits(result, digit_count, 8u))
+					return {};
+				result = result * chunk_multiplier + digit_chunk_value<base>(chunk);
+				p += 8;
+			}
+			if (p == end)
+				break;
+
+			if (is_digit(*p))
+			{
+				digit_count++;
+				if (!fits(result, digit_count, 1u))
+					return {};
+				if constexpr (base == 16)
+					result = result * base + impl::hex_to_dec(*p);
+				else
+					result = result * base + static_cast<uint64_t>(*p - '0');
+				p++;
+			}
+			else if (*p == '_')
+			{
+				// underscores must be between two digits (and the first character is always a digit)
+				if (!is_digit(p[-1]) || end - p < 2 || !is_digit(p[1]))
+					return {};
+				p++;
+			}
+			else
+				break;
+		}
+
+		if (digit_count > max_length || result > max_value || !ends_value(p, end))
+			return {};
+
+		value = result;
+		return static_cast<size_t>(p - str);
+	}
+
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	constexpr uint32_t days_in_month(uint32_t year, uint32_t month) noexcept
+	{
+		const auto is_leap_year = (year % 4u == 0u) && ((year % 100u != 0u) || (year % 400u == 0u));
+		return month == 2u ? (is_leap_year ? 29u : 28u)
+						   : (month == 4u || month == 6u || month == 9u || month == 11u ? 30u : 31u);
+	}
+
+	// matches eight characters against a fixed layout in which '0' stands for any digit and anything else must
+	// appear as-is (e.g. "0000-00-"), and converts them in the same step: byte i of 'pairs' is the two-digit number
+	// starting at character i.
+	TOML_NODISCARD
+	TOML_ALWAYS_INLINE
+	bool match_fixed_width_digits(const char* str, const char (&layout)[9], uint64_t& pairs) noexcept
+	{
+		uint64_t separators		= {};
+		uint64_t separator_mask = {};
+		for (size_t i = 0; i < 8u; i++)
+		{
+			if (layout[i] != '0')
+			{
+				separators |= static_cast<uint64_t>(static_cast<unsigned char>(layout[i])) << (i * 8u);
+				separator_mask |= uint64_t{ 0xFFu } << (i * 8u);
+			}
+		}
 
-//#---------------------------------------------------------------------------------------------------------------------
-//# PARSER INTERNAL IMPLEMENTATION
-//#---------------------------------------------------------------------------------------------------------------------
+		auto chunk = load_little_endian_u64(str);
+		if ((chunk & separator_mask) != separators)
+			return false;
 
-#if TOML_EXCEPTIONS
-#define TOML_RETURNS_BY_THROWING [[noreturn]]
-#else
-#define TOML_RETURNS_BY_THROWING
-#endif
+		chunk = (chunk & ~separator_mask) | (repeat_byte('0') & separator_mask);
+		if (!is_digit_chunk<10>(chunk))
+			return false;
 
-TOML_ANON_NAMESPACE_START
-{
-	template <typename... T>
-	TOML_CONST_GETTER
+		chunk &= repeat_byte(0x0Fu);
+		pairs = chunk * 10u + (chunk >> 8);
+		return true;
+	}
+
+	TOML_CONST_INLINE_GETTER
+	uint32_t pair_at(uint64_t pairs, unsigned index) noexcept
+	{
+		return static_cast<uint32_t>((pairs >> (index * 8u)) & 0xFFu);
+	}
+
+	TOML_PURE_INLINE_GETTER
+	bool is_two_digits(const char* str) noexcept
+	{
+		return impl::is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(str[0])))
+			&& impl::is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(str[1])));
+	}
+
+	TOML_PURE_INLINE_GETTER
+	uint32_t two_digit_value(const char* str) noexcept
+	{
+		return static_cast<uint32_t>(str[0] - '0') * 10u + static_cast<uint32_t>(str[1] - '0');
+	}
+
+	// fast paths for date and time values in their canonical RFC 3339 layouts, for when the whole document is in
+	// memory. each returns the length of what it matched, or zero if it's anything unusual (or invalid), in which
+	// case the caller takes the slow path (which is where errors are reported).
+
+	// "YYYY-MM-DD"
+	TOML_NODISCARD
 	TOML_INTERNAL_LINKAGE
-	constexpr bool is_match(char32_t codepoint, T... vals) noexcept
+	size_t scan_date(const char* str, size_t len, date& value) noexcept
 	{
-		static_assert((std::is_same_v<char32_t, T> && ...));
-		return ((codepoint == vals) || ...);
+		uint64_t pairs;
+		if (len < 10u || !match_fixed_width_digits(str, "0000-00-", pairs) || !is_two_digits(str + 8))
+			return {};
+
+		const auto year	 = pair_at(pairs, 0u) * 100u + pair_at(pairs, 2u);
+		const auto month = pair_at(pairs, 5u);
+		const auto day	 = two_digit_value(str + 8);
+		if (month == 0u || month > 12u || day == 0u || day > days_in_month(year, month))
+			return {};
+
+		value = { year, month, day };
+		return 10u;
 	}
 
-	template <uint64_t>
-	struct parse_integer_traits;
-	template <>
-	struct parse_integer_traits<2>
+	// "HH:MM:SS" with up to nine fractional digits
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_time(const char* str, size_t len, toml::time& value) noexcept
 	{
-		static constexpr auto scope_qualifier  = "binary integer"sv;
-		static constexpr auto is_digit		   = impl::is_binary_digit;
-		static constexpr auto is_signed		   = false;
-		static constexpr auto max_digits	   = 63;
-		static constexpr auto prefix_codepoint = U'b';
-		static constexpr auto prefix		   = "b"sv;
-		static constexpr auto full_prefix	   = "0b"sv;
-	};
-	template <>
-	struct parse_integer_traits<8>
+		uint64_t pairs;
+		if (len < 8u || !match_fixed_width_digits(str, "00:00:00", pairs))
+			return {};
+
+		const auto hour	  = pair_at(pairs, 0u);
+		const auto minute = pair_at(pairs, 3u);
+		const auto second = pair_at(pairs, 6u);
+		if (hour > 23u || minute > 59u || second > 59u)
+			return {};
+
+		value = { hour, minute, second };
+		if (len == 8u || str[8] != '.')
+			return 8u;
+
+		uint32_t nanosecond = {};
+		size_t pos			= 9u;
+		for (; pos < len && pos < 18u && impl::is_decimal_digit(static_cast<char32_t>(str[pos])); pos++)
+			nanosecond = nanosecond * 10u + static_cast<uint32_t>(str[pos] - '0');
+		if (pos == 9u || (pos < len && impl::is_decimal_digit(static_cast<char32_t>(str[pos]))))
+			return {}; // no digits, or more than nine
+		for (auto i = pos; i < 18u; i++)
+			nanosecond *= 10u;
+
+		value.nanosecond = nanosecond;
+		return pos;
+	}
+
+	// "YYYY-MM-DDTHH:MM:SS" with up to nine fractional digits and an optional offset
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_date_time(const char* str, size_t len, date_time& value) noexcept
 	{
-		static constexpr auto scope_qualifier  = "octal integer"sv;
-		static constexpr auto is_digit		   = impl::is_octal_digit;
-		static constexpr auto is_signed		   = false;
-		static constexpr auto max_digits	   = 21; // strlen("777777777777777777777")
-		static constexpr auto prefix_codepoint = U'o';
-		static constexpr auto prefix		   = "o"sv;
-		static constexpr auto full_prefix	   = "0o"sv;
-	};
-	template <>
-	struct parse_integer_traits<10>
+		date d;
+		toml::time t;
+		if (len < 19u || !scan_date(str, 10u, d) || !is_match(static_cast<char32_t>(str[10]), U'T', U't', U' '))
+			return {};
+		auto pos = scan_time(str + 11, len - 11u, t);
+		if (!pos)
+			return {};
+		pos += 11u;
+
+		if (pos < len && (str[pos] == 'Z' || str[pos] == 'z'))
+		{
+			value = { d, t, time_offset{} };
+			return pos + 1u;
+		}
+
+		if (pos < len && (str[pos] == '+' || str[pos] == '-'))
+		{
+			if (len - pos < 6u || !is_two_digits(str + pos + 1u) || str[pos + 3u] != ':'
+				|| !is_two_digits(str + pos + 4u))
+				return {};
+
+			const auto hour	  = two_digit_value(str + pos + 1u);
+			const auto minute = two_digit_value(str + pos + 4u);
+			if (hour > 23u || minute > 59u)
+				return {};
+
+			time_offset offset{};
+			offset.minutes = static_cast<int16_t>(static_cast<int>(hour * 60u + minute) * (str[pos] == '-' ? -1 : 1));
+			value		   = { d, t, offset };
+			return pos + 6u;
+		}
+
+		value = { d, t };
+		return pos;
+	}
+
+	// runs one of the scanners above, but only accepts what it matched if that was the whole value
+	template <typename T>
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_whole_value(size_t (*scan)(const char*, size_t, T&) noexcept,
+							const char* str,
+							size_t len,
+							T& value) noexcept
 	{
-		static constexpr auto scope_qualifier = "decimal integer"sv;
-		static constexpr auto is_digit		  = impl::is_decimal_digit;
-		static constexpr auto is_signed		  = true;
-		static constexpr auto max_digits	  = 19; // strlen("9223372036854775807")
-		static constexpr auto full_prefix	  = ""sv;
-	};
-	template <>
-	struct parse_integer_traits<16>
+		const auto length = scan(str, len, value);
+		return length && ends_value(str + length, str + len) ? length : 0u;
+	}
+
+	// a decimal integer or float in its usual form: an optional sign, digits (with underscores between them), an
+	// optional fractional part and an optional exponent. the digits are classified and converted in the same pass;
+	// returns zero for anything unusual (or invalid) so the caller can take the slow path, same as the above.
+	struct decimal_number
 	{
-		static constexpr auto scope_qualifier  = "hexadecimal integer"sv;
-		static constexpr auto is_digit		   = impl::is_hexadecimal_digit;
-		static constexpr auto is_signed		   = false;
-		static constexpr auto max_digits	   = 16; // strlen("7FFFFFFFFFFFFFFF")
-		static constexpr auto prefix_codepoint = U'x';
-		static constexpr auto prefix		   = "x"sv;
-		static constexpr auto full_prefix	   = "0x"sv;
+		bool is_float;
+		int64_t integer;
+		double floating_point;
 	};
 
+	template <size_t MaxLength>
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_decimal_number(const char* str, size_t len, decimal_number& value) noexcept
+	{
+		static constexpr auto i64_max = static_cast<uint64_t>((std::numeric_limits<int64_t>::max)());
+		constexpr auto is_digit		  = [](char c) noexcept
+		{ return impl::is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(c))); };
+
+		const char* p		  = str;
+		const char* const end = str + len;
+
+		const bool negative = *p == '-';
+		if (*p == '+' || *p == '-')
+			p++;
+
+		// everything but the sign and underscores goes in here in case it turns out to be a float
+		char chars[MaxLength];
+		size_t length = {};
+
+		uint64_t mantissa  = {};
+		size_t digit_count = {};
+		const auto consume_digits = [&](bool integer_part) noexcept
+		{
+			if (p == end || !is_digit(*p))
+				return false;
+
+			while (true)
+			{
+				while (end - p >= 8 && MaxLength - length >= 8u)
+				{
+					const auto chunk = load_little_endian_u64(p);
+					if (!is_digit_chunk<10>(chunk))
+						break;
+
+					std::memcpy(chars + length, p, 8u);
+					length += 8u;
+					p += 8;
+					if (integer_part && (digit_count += 8u) <= 19u)
+						mantissa = mantissa * 100000000u + digit_chunk_value<10>(chunk);
+				}
+				if (p == end)
+					return true;
+
+				if (is_digit(*p))
+				{
+					if (length == MaxLength)
+						return false;
+					chars[length++] = *p;
+					if (integer_part && ++digit_count <= 19u)
+						mantissa = mantissa * 10u + static_cast<uint64_t>(*p - '0');
+					p++;
+				}
+				else if (*p == '_')
+				{
+					// always preceded by a digit, so it only needs to be followed by one
+					if (end - p < 2 || !is_digit(p[1]))
+						return false;
+					p++;
+				}
+				else
+					return true;
+			}
+		};
+		const auto append = [&](char c) noexcept
+		{
+			if (length == MaxLength)
+				return false;
+			chars[length++] = c;
+			return true;
+		};
+
+		// integer part (no leading zeroes)
+		if (!consume_digits(true) || (chars[0] == '0' && length > 1u))
+			return {};
+
+		// fractional part
+		bool is_float = false;
+		if (p < end && *p == '.')
+		{
+			if (!append(*p++) || !consume_digits(false))
+				return {};
+			is_float = true;
+		}
+
+		// exponent
+		if (p < end && (*p == 'e' || *p == 'E'))
+		{
+			if (!append(*p++))
+				return {};
+			if (p < end && (*p == '+' || *p == '-') && !append(*p++))
+				return {};
+			if (!consume_digits(false))
+				return {};
+			is_float = true;
+		}
+
+		if (!ends_value(p, end))
+			return {};
+
+		if (is_float)
+		{
+			double result;
+#if TOML_FLOAT_CHARCONV
+			// (from_chars reports values too small to represent as out-of-range; decimal_to_double rounds them to zero)
+			const auto ec = std::from_chars(chars, chars + length, result).ec;
+			if (ec == std::errc::result_out_of_range)
+			{
+				if (!impl::decimal_to_double(std::string_view{ chars, length }, result))
+					return {};
+			}
+			else if (ec != std::errc{})
+				return {};
+#else
+			if (!impl::decimal_to_double(std::string_view{ chars, length }, result))
+				return {};
+#endif
+			value = { true, {}, negative ? -result : result };
+		}
+		else
+		{
+			if (digit_count > 19u || mantissa > i64_max + (negative ? 1u : 0u))
+				return {};
+
+			// avoid signed negation UB for INT64_MIN
+			int64_t result;
+			if (!negative)
+				result = static_cast<int64_t>(mantissa);
+			else if (mantissa == i64_max + 1u)
+				result = (std::numeric_limits<int64_t>::min)();
+			else
+				result = -static_cast<int64_t>(mantissa);
+			value = { false, result, {} };
+		}
+		return static_cast<size_t>(p - str);
+	}
+
 	TOML_PURE_GETTER
 	TOML_INTERNAL_LINKAGE
 	std::string_view to_sv(node_type val) noexcept
@@ -857,54 +2013,6 @@ TOML_ANON_NAMESPACE_START
 #define push_parse_scope_1(scope, line) push_parse_scope_2(scope, line)
 #define push_parse_scope(scope)			push_parse_scope_1(scope, __LINE__)
 
-	struct parse_key_buffer
-	{
-		std::string buffer;
-		std::vector<std::pair<size_t, size_t>> segments;
-		std::vector<source_position> starts;
-		std::vector<source_position> ends;
-
-		void clear() noexcept
-		{
-			buffer.clear();
-			segments.clear();
-			starts.clear();
-			ends.clear();
-		}
-
-		void push_back(std::string_view segment, source_position b, source_position e)
-		{
-			segments.push_back({ buffer.length(), segment.length() });
-			buffer.append(segment);
-			starts.push_back(b);
-			ends.push_back(e);
-		}
-
-		TOML_PURE_INLINE_GETTER
-		std::string_view operator[](size_t i) const noexcept
-		{
-			return std::string_view{ buffer.c_str() + segments[i].first, segments[i].second };
-		}
-
-		TOML_PURE_INLINE_GETTER
-		std::string_view back() const noexcept
-		{
-			return (*this)[segments.size() - 1u];
-		}
-
-		TOML_PURE_INLINE_GETTER
-		bool empty() const noexcept
-		{
-			return segments.empty();
-		}
-
-		TOML_PURE_INLINE_GETTER
-		size_t size() const noexcept
-		{
-			return segments.size();
-		}
-	};
-
 	struct depth_counter_scope
 	{
 		size_t& depth_;
@@ -928,6 +2036,7 @@ TOML_ANON_NAMESPACE_START
 	{
 		std::string_view value;
 		bool was_multi_line;
+		bool borrowed = false; // value points into the document (see parse_flags::borrowed_strings)
 	};
 
 	struct table_vector_scope
@@ -1044,52 +2153,198 @@ TOML_ANON_NAMESPACE_END;
 	}                                                                                                                  \
 	while (false)
 
-#define advance_and_return_if_error_or_eof(...)                                                                        \
-	do                                                                                                                 \
-	{                                                                                                                  \
-		assert_not_eof();                                                                                              \
-		advance();                                                                                                     \
-		return_if_error(__VA_ARGS__);                                                                                  \
-		set_error_and_return_if_eof(__VA_ARGS__);                                                                      \
-	}                                                                                                                  \
-	while (false)
+#define advance_and_return_if_error_or_eof(...)                                                                        \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		assert_not_eof();                                                                                              \
+		advance();                                                                                                     \
+		return_if_error(__VA_ARGS__);                                                                                  \
+		set_error_and_return_if_eof(__VA_ARGS__);                                                                      \
+	}                                                                                                                  \
+	while (false)
+
+#endif // parser helper macros
+
+TOML_IMPL_NAMESPACE_START
+{
+	struct parse_key_buffer
+	{
+		std::string buffer;
+		std::vector<std::pair<size_t, size_t>> segments;
+		std::vector<source_position> starts;
+		std::vector<source_position> ends;
+		std::vector<const char*> sources; // where a segment is in the document, if keys can borrow it (or nullptr)
+
+		void clear() noexcept
+		{
+			buffer.clear();
+			segments.clear();
+			starts.clear();
+			ends.clear();
+			sources.clear();
+		}
+
+		void push_back(std::string_view segment, source_position b, source_position e, const char* source = nullptr)
+		{
+			segments.push_back({ buffer.length(), segment.length() });
+			buffer.append(segment);
+			starts.push_back(b);
+			ends.push_back(e);
+			sources.push_back(source);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view operator[](size_t i) const noexcept
+		{
+			return std::string_view{ buffer.c_str() + segments[i].first, segments[i].second };
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view back() const noexcept
+		{
+			return (*this)[segments.size() - 1u];
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool empty() const noexcept
+		{
+			return segments.empty();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t size() const noexcept
+		{
+			return segments.size();
+		}
+	};
+
+	// the parser's working storage; owned by a toml::parse_context when there is one, so it can be reused
+	// (already grown to size) by every document parsed with it
+	struct parse_scratch
+	{
+		std::vector<table*> implicit_tables;
+		std::vector<table*> dotted_key_tables;
+		std::vector<table*> open_inline_tables;
+		std::vector<array*> table_arrays;
+		parse_key_buffer key_buffer;
+		std::string string_buffer;
+		std::string recording_buffer; // for diagnostics
+		stream_chunk_buffer chunk_buffer;
+
+		// roughly how much of its arena the previous document used (see parse_flags::arena_allocation)
+		size_t arena_size_hint = {};
 
-#endif // parser helper macros
+		void clear() noexcept
+		{
+			implicit_tables.clear();
+			dotted_key_tables.clear();
+			open_inline_tables.clear();
+			table_arrays.clear();
+			key_buffer.clear();
+			string_buffer.clear();
+			recording_buffer.clear();
+		}
+	};
 
-TOML_IMPL_NAMESPACE_START
-{
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, impl_ex, impl_noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, impl_pmralloc, impl_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
+	template <typename Reader>
 	class parser
 	{
 	  private:
 		static constexpr size_t max_nested_values	  = TOML_MAX_NESTED_VALUES;
 		static constexpr size_t max_dotted_keys_depth = TOML_MAX_DOTTED_KEYS_DEPTH;
+		static constexpr size_t max_numeric_length	  = 128;
 
-		utf8_buffered_reader reader;
+		utf8_buffered_reader<Reader> reader;
 		table root;
 		source_position prev_pos = { 1, 1 };
 		const utf8_codepoint* cp = {};
-		std::vector<table*> implicit_tables;
-		std::vector<table*> dotted_key_tables;
-		std::vector<table*> open_inline_tables;
-		std::vector<array*> table_arrays;
-		parse_key_buffer key_buffer;
-		std::string string_buffer;
-		std::string recording_buffer; // for diagnostics
+		parse_scratch own_scratch; // used when there's no parse_context to borrow one from
+		parse_scratch& scratch;
 		bool recording = false, recording_whitespace = true;
 		std::string_view current_scope;
 		size_t nested_values = {};
+		table* current_table = &root;
+		bool parsed_any		 = false;
+		node_arena* arena	 = {};
+		bool track_sources	 = true;
+		bool pack_arrays	 = false;
+		bool compact_arrays	 = false;
+		bool borrow_strings	 = false;
+		node_ptr spare_value; // see append_packed()
 #if !TOML_EXCEPTIONS
 		mutable optional<parse_error> err;
 #endif
 
+		template <typename T, typename... Args>
 		TOML_NODISCARD
-		source_position current_position(source_index fallback_offset = 0) const noexcept
+		node_ptr new_node(Args&&... args)
+		{
+			if (arena)
+			{
+				const auto n = arena->create<T>(static_cast<Args&&>(args)...);
+				if constexpr (impl::is_one_of<T, table, array>)
+					n->arena_ = arena_ref{ arena }; // (so they can be moved out of the document)
+				return node_ptr{ n };
+			}
+			return node_ptr{ new T{ static_cast<Args&&>(args)... } };
+		}
+
+		template <typename T>
+		TOML_NODISCARD
+		node_ptr new_value(T&& val)
+		{
+			using native_type = impl::native_type_of<impl::remove_cvref<T>>;
+			if constexpr (!std::is_same_v<native_type, std::string>)
+			{
+				if (spare_value && spare_value->type() == impl::node_type_of<native_type>)
+				{
+					spare_value->ref_cast<native_type>().get() = static_cast<T&&>(val);
+					return std::move(spare_value);
+				}
+			}
+			return new_node<value<native_type>>(static_cast<T&&>(val));
+		}
+
+		TOML_NODISCARD
+		node_ptr new_string_value(const parsed_string& str)
+		{
+			// with an arena, strings too long for std::string's own buffer are stored there instead of on the heap
+			const bool in_arena = arena && !str.borrowed && str.value.length() > std::string{}.capacity();
+			if (!str.borrowed && !in_arena)
+				return new_value(str.value);
+
+			auto val = new_node<value<std::string>>();
+			const auto text = in_arena ? arena->copy_string(str.value) : str.value;
+			static_cast<value<std::string>*>(val.get())->borrow(text, in_arena);
+			return val;
+		}
+
+		// the region given to new nodes and keys (left empty with parse_flags::no_source_tracking)
+		TOML_NODISCARD
+		source_region make_source_region(source_position begin, source_position end) const
+		{
+			if (!track_sources)
+				return {};
+			return { reader.resolve(begin), reader.resolve(end), reader.source_path() };
+		}
+
+		// (positions may only have their offsets until they're given to make_source_region() or set_error_at())
+		TOML_NODISCARD
+		source_position current_position(source_index fallback_offset = 0) const
 		{
 			if (!is_eof())
 				return cp->position;
-			return { prev_pos.line, static_cast<source_index>(prev_pos.column + fallback_offset) };
+
+			// at EOF it's the position following the last character, on the same line
+			source_position pos = reader.resolve(prev_pos);
+			pos.column += fallback_offset;
+			if (fallback_offset)
+				pos.offset = reader.end_offset();
+			return pos;
 		}
 
 		template <typename... T>
@@ -1106,9 +2361,9 @@ TOML_IMPL_NAMESPACE_START
 			parse_error_break();
 
 #if TOML_EXCEPTIONS
-			builder.finish(pos, reader.source_path());
+			builder.finish(reader.resolve(pos), reader.source_path());
 #else
-			err.emplace(builder.finish(pos, reader.source_path()));
+			err.emplace(builder.finish(reader.resolve(pos), reader.source_path()));
 #endif
 		}
 
@@ -1147,7 +2402,7 @@ TOML_IMPL_NAMESPACE_START
 			if (recording && !is_eof())
 			{
 				if (recording_whitespace || !is_whitespace(*cp))
-					recording_buffer.append(cp->bytes, cp->count);
+					scratch.recording_buffer.append(cp->bytes, cp->count);
 			}
 		}
 
@@ -1157,9 +2412,9 @@ TOML_IMPL_NAMESPACE_START
 
 			recording			 = true;
 			recording_whitespace = true;
-			recording_buffer.clear();
+			scratch.recording_buffer.clear();
 			if (include_current && !is_eof())
-				recording_buffer.append(cp->bytes, cp->count);
+				scratch.recording_buffer.append(cp->bytes, cp->count);
 		}
 
 		void stop_recording(size_t pop_bytes = 0) noexcept
@@ -1169,14 +2424,71 @@ TOML_IMPL_NAMESPACE_START
 			recording = false;
 			if (pop_bytes)
 			{
-				if (pop_bytes >= recording_buffer.length())
-					recording_buffer.clear();
+				if (pop_bytes >= scratch.recording_buffer.length())
+					scratch.recording_buffer.clear();
 				else if (pop_bytes == 1u)
-					recording_buffer.pop_back();
+					scratch.recording_buffer.pop_back();
 				else
-					recording_buffer.erase(recording_buffer.begin()
-											   + static_cast<ptrdiff_t>(recording_buffer.length() - pop_bytes),
-										   recording_buffer.end());
+					scratch.recording_buffer.erase(scratch.recording_buffer.begin()
+											   + static_cast<ptrdiff_t>(scratch.recording_buffer.length() - pop_bytes),
+										   scratch.recording_buffer.end());
+			}
+		}
+
+		// consumes a run of ASCII characters (not including line breaks) in one go, rather than one at a time.
+		// 'scan' is given the remaining source starting at the current character and returns the length of the run.
+		// only possible when the whole document is in memory; returns the consumed characters (empty if none).
+		template <typename Func>
+		std::string_view consume_ascii_run(Func&& scan)
+		{
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				return_if_error_or_eof({});
+
+				// runs never start with a non-ASCII character, so don't bother going through the SIMD dispatch table
+				if (cp->count > 1u)
+					return {};
+
+				const auto source = reader.remaining();
+				const auto run	  = source.substr(0, static_cast<Func&&>(scan)(source.data(), source.length()));
+				if (run.empty())
+					return {};
+
+				if (recording)
+				{
+					if (recording_whitespace)
+						scratch.recording_buffer.append(run.data() + 1u, run.length() - 1u);
+					else
+					{
+						for (auto c : run.substr(1))
+							if (!is_ascii_horizontal_whitespace(static_cast<char32_t>(static_cast<unsigned char>(c))))
+								scratch.recording_buffer += c;
+					}
+				}
+
+				prev_pos = cp->position;
+				prev_pos.offset += static_cast<source_index>(run.length() - 1u);
+				cp = reader.skip_ascii(run.length());
+
+#if !TOML_EXCEPTIONS
+				if (reader.error())
+				{
+					err = std::move(reader.error());
+					return run;
+				}
+#endif
+
+				if (recording && !is_eof())
+				{
+					if (recording_whitespace || !is_whitespace(*cp))
+						scratch.recording_buffer.append(cp->bytes, cp->count);
+				}
+				return run;
+			}
+			else
+			{
+				TOML_UNUSED(scan);
+				return {};
 			}
 		}
 
@@ -1191,7 +2503,9 @@ TOML_IMPL_NAMESPACE_START
 					set_error_and_return_default("expected space or tab, saw '"sv, escaped_codepoint{ *cp }, "'"sv);
 
 				consumed = true;
-				advance_and_return_if_error({});
+				if (consume_ascii_run(impl::horizontal_whitespace_prefix_length).empty())
+					advance();
+				return_if_error({});
 			}
 			return consumed;
 		}
@@ -1231,7 +2545,7 @@ TOML_IMPL_NAMESPACE_START
 			{
 				if (is_ascii_vertical_whitespace(*cp))
 					return consume_line_break();
-				else
+				else if (consume_ascii_run(printable_ascii_prefix_length).empty())
 					advance();
 				return_if_error({});
 			}
@@ -1257,6 +2571,13 @@ TOML_IMPL_NAMESPACE_START
 					return true;
 				return_if_error({});
 
+				// skip runs of printable ASCII in one go
+				if (!consume_ascii_run(printable_ascii_prefix_length).empty())
+				{
+					return_if_error({});
+					continue;
+				}
+
 #if TOML_LANG_AT_LEAST(1, 0, 0)
 
 				// toml/issues/567 (disallow non-TAB control characters in comments)
@@ -1352,7 +2673,7 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_if_eof({});
 			}
 
-			auto& str = string_buffer;
+			auto& str = scratch.string_buffer;
 			str.clear();
 			bool escaped			 = false;
 			bool skipping_whitespace = false;
@@ -1469,6 +2790,17 @@ TOML_IMPL_NAMESPACE_START
 				}
 				else
 				{
+					// bulk-append runs of characters that don't need any special handling
+					if (!skipping_whitespace)
+					{
+						if (const auto run = consume_ascii_run(basic_string_prefix_length); !run.empty())
+						{
+							str.append(run);
+							return_if_error({});
+							continue;
+						}
+					}
+
 					// handle closing delimiters
 					if (*cp == U'"')
 					{
@@ -1594,12 +2926,19 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_if_eof({});
 			}
 
-			auto& str = string_buffer;
+			auto& str = scratch.string_buffer;
 			str.clear();
 			do
 			{
 				return_if_error({});
 
+				// bulk-append runs of characters that don't need any special handling
+				if (const auto run = consume_ascii_run(literal_string_prefix_length); !run.empty())
+				{
+					str.append(run);
+					continue;
+				}
+
 				// handle closing delimiters
 				if (*cp == U'\'')
 				{
@@ -1717,6 +3056,23 @@ TOML_IMPL_NAMESPACE_START
 				// character is the string delimiter
 				go_back(2u);
 
+				if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+				{
+					if (borrow_strings)
+					{
+						const auto source = reader.remaining();
+						const auto str	  = first == U'\'' ? parse_literal_string(false) : parse_basic_string(false);
+						return_if_error({});
+
+						// escape sequences are always longer than what they stand for, so a string without any is
+						// exactly as long as the text between its delimiters (and identical to it)
+						const auto consumed = source.length() - (is_eof() ? 0u : reader.remaining().length());
+						if (str.length() == consumed - 2u)
+							return { source.substr(1u, str.length()), false, true };
+						return { str, false };
+					}
+				}
+
 				return { first == U'\'' ? parse_literal_string(false) : parse_basic_string(false), false };
 			}
 		}
@@ -1729,18 +3085,18 @@ TOML_IMPL_NAMESPACE_START
 			assert_not_eof();
 			TOML_ASSERT_ASSUME(is_bare_key_character(*cp));
 
-			string_buffer.clear();
+			scratch.string_buffer.clear();
 
 			while (!is_eof())
 			{
 				if (!is_bare_key_character(*cp))
 					break;
 
-				string_buffer.append(cp->bytes, cp->count);
+				scratch.string_buffer.append(cp->bytes, cp->count);
 				advance_and_return_if_error({});
 			}
 
-			return string_buffer;
+			return scratch.string_buffer;
 		}
 
 		TOML_NODISCARD
@@ -1758,7 +3114,7 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_default("expected '"sv,
 											 to_sv(result),
 											 "', saw '"sv,
-											 to_sv(recording_buffer),
+											 to_sv(scratch.recording_buffer),
 											 "'"sv);
 			stop_recording();
 
@@ -1787,7 +3143,7 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_default("expected '"sv,
 											 inf ? "inf"sv : "nan"sv,
 											 "', saw '"sv,
-											 to_sv(recording_buffer),
+											 to_sv(scratch.recording_buffer),
 											 "'"sv);
 			stop_recording();
 
@@ -1813,7 +3169,7 @@ TOML_IMPL_NAMESPACE_START
 				advance_and_return_if_error_or_eof({});
 
 			// consume value chars
-			char chars[utf8_buffered_reader::max_history_length];
+			char chars[max_numeric_length];
 			size_t length			   = {};
 			const utf8_codepoint* prev = {};
 			bool seen_decimal = false, seen_exponent = false;
@@ -1929,6 +3285,9 @@ TOML_IMPL_NAMESPACE_START
 						break;
 
 					case std::errc::result_out_of_range:
+						// values too small to represent round to zero, same as without charconv
+						if (impl::decimal_to_double(std::string_view{ chars, length }, result))
+							return result * sign;
 						set_error_and_return_default("'"sv,
 													 std::string_view{ chars, length },
 													 "' is not representable in 64 bits"sv);
@@ -1941,17 +3300,12 @@ TOML_IMPL_NAMESPACE_START
 				}
 			}
 #else
-			{
-				std::stringstream ss;
-				ss.imbue(std::locale::classic());
-				ss.write(chars, static_cast<std::streamsize>(length));
-				if ((ss >> result))
-					return result * sign;
-				else
-					set_error_and_return_default("'"sv,
-												 std::string_view{ chars, length },
-												 "' could not be interpreted as a value"sv);
-			}
+			if TOML_LIKELY(impl::decimal_to_double(std::string_view{ chars, length }, result))
+				return result * sign;
+			else
+				set_error_and_return_default("'"sv,
+											 std::string_view{ chars, length },
+											 "' is not representable in 64 bits"sv);
 #endif
 		}
 
@@ -1988,7 +3342,6 @@ TOML_IMPL_NAMESPACE_START
 			{
 				char chars[24];
 				size_t length;
-				double value;
 			};
 			fragment fragments[] = {
 				{}, // mantissa, whole part
@@ -2077,51 +3430,19 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_default("underscores must be followed by digits"sv);
 			}
 
-			// calculate values for the three fragments
-			for (int fragment_idx = 0; fragment_idx < 3; fragment_idx++)
-			{
-				auto& f				= fragments[fragment_idx];
-				const uint32_t base = fragment_idx == 2 ? 10u : 16u;
-
-				// left-trim zeroes
-				const char* c = f.chars;
-				size_t sig	  = {};
-				while (f.length && *c == '0')
-				{
-					f.length--;
-					c++;
-					sig++;
-				}
-				if (!f.length)
-					continue;
-
-				// calculate value
-				auto place = 1u;
-				for (size_t i = 0; i < f.length - 1u; i++)
-					place *= base;
-				uint32_t val{};
-				while (place)
-				{
-					if (base == 16)
-						val += place * hex_to_dec(*c);
-					else
-						val += place * static_cast<uint32_t>(*c - '0');
-					if (fragment_idx == 1)
-						sig++;
-					c++;
-					place /= base;
-				}
-				f.value = static_cast<double>(val);
+			// exponent (clamped well past the point where the value is zero or infinite either way)
+			int64_t exponent = {};
+			for (size_t i = 0; i < fragments[2].length; i++)
+				exponent = impl::min(exponent * 10 + (fragments[2].chars[i] - '0'), int64_t{ 100000 });
 
-				// shift the fractional part
-				if (fragment_idx == 1)
-				{
-					while (sig--)
-						f.value /= base;
-				}
-			}
+			double result;
+			if (!impl::hex_to_double(std::string_view{ fragments[0].chars, fragments[0].length },
+									 std::string_view{ fragments[1].chars, fragments[1].length },
+									 exponent * exponent_sign,
+									 result))
+				set_error_and_return_default("value is not representable in 64 bits"sv);
 
-			return (fragments[0].value + fragments[1].value) * pow(2.0, fragments[2].value * exponent_sign) * sign;
+			return result * sign;
 
 #else // !TOML_LANG_UNRELEASED
 
@@ -2131,6 +3452,56 @@ TOML_IMPL_NAMESPACE_START
 #endif // !TOML_LANG_UNRELEASED
 		}
 
+		// the fast paths for contiguous inputs, shared by the typed parsers below and parse_value_single_pass().
+		// each converts a value in its usual form straight out of the source, consuming it, or returns false
+		// without consuming anything so the caller can take the slow path.
+
+		// (prefix_length is the length of the '0x'/'0o'/'0b' in front of the digits, if it hasn't been consumed yet)
+		template <uint64_t base>
+		TOML_NODISCARD
+		bool consume_integer(size_t prefix_length, bool negative, int64_t& value)
+		{
+			static constexpr auto i64_max = static_cast<uint64_t>((std::numeric_limits<int64_t>::max)());
+
+			uint64_t result = {};
+			const auto run	= consume_ascii_run(
+				 [&](const char* str, size_t len) noexcept -> size_t
+				 {
+					 if (len <= prefix_length
+						 || !parse_integer_traits<base>::is_digit(
+							 static_cast<char32_t>(static_cast<unsigned char>(str[prefix_length]))))
+						 return {};
+
+					 const auto length = scan_integer<base>(str + prefix_length,
+															len - prefix_length,
+															i64_max + (negative ? 1u : 0u),
+															max_numeric_length,
+															result);
+					 return length ? length + prefix_length : 0u;
+				 });
+			if (run.empty())
+				return false;
+
+			// avoid signed negation UB for INT64_MIN
+			if (!negative)
+				value = static_cast<int64_t>(result);
+			else if (result == i64_max + 1u)
+				value = (std::numeric_limits<int64_t>::min)();
+			else
+				value = -static_cast<int64_t>(result);
+			return true;
+		}
+
+		// dates, times and date-times in their canonical layout (see scan_date() etc.)
+		template <typename T>
+		TOML_NODISCARD
+		bool consume_canonical(size_t (*scan)(const char*, size_t, T&) noexcept, T& value)
+		{
+			return !consume_ascii_run([&](const char* str, size_t len) noexcept
+									  { return scan_whole_value(scan, str, len, value); })
+						.empty();
+		}
+
 		template <uint64_t base>
 		TOML_NODISCARD
 		TOML_NEVER_INLINE
@@ -2170,8 +3541,19 @@ TOML_IMPL_NAMESPACE_START
 					set_error_and_return_default("expected digit, saw '"sv, to_sv(*cp), "'"sv);
 			}
 
+			// convert the digits straight out of the source if they're all there (and well-formed)
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				int64_t result;
+				if (consume_integer<base>(0u, sign < 0, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			// consume digits
-			char digits[utf8_buffered_reader::max_history_length];
+			char digits[max_numeric_length];
 			size_t length			   = {};
 			const utf8_codepoint* prev = {};
 			while (!is_eof() && !is_value_terminator(*cp))
@@ -2292,12 +3674,22 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_decimal_digit(*cp));
 			push_parse_scope("date"sv);
 
+			// canonical layout, straight out of the source
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				date result;
+				if (!part_of_datetime && consume_canonical(scan_date, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			// "YYYY"
 			uint32_t digits[4];
 			if (!consume_digit_sequence(digits, 4u))
 				set_error_and_return_default("expected 4-digit year, saw '"sv, to_sv(cp), "'"sv);
-			const auto year			= digits[3] + digits[2] * 10u + digits[1] * 100u + digits[0] * 1000u;
-			const auto is_leap_year = (year % 4u == 0u) && ((year % 100u != 0u) || (year % 400u == 0u));
+			const auto year = digits[3] + digits[2] * 10u + digits[1] * 100u + digits[0] * 1000u;
 			set_error_and_return_if_eof({});
 
 			// '-'
@@ -2311,9 +3703,7 @@ TOML_IMPL_NAMESPACE_START
 			const auto month = digits[1] + digits[0] * 10u;
 			if (month == 0u || month > 12u)
 				set_error_and_return_default("expected month between 1 and 12 (inclusive), saw "sv, month);
-			const auto max_days_in_month = month == 2u
-											 ? (is_leap_year ? 29u : 28u)
-											 : (month == 4u || month == 6u || month == 9u || month == 11u ? 30u : 31u);
+			const auto max_days_in_month = days_in_month(year, month);
 			set_error_and_return_if_eof({});
 
 			// '-'
@@ -2346,6 +3736,17 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_decimal_digit(*cp));
 			push_parse_scope("time"sv);
 
+			// canonical layout, straight out of the source
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				time result;
+				if (!part_of_datetime && consume_canonical(scan_time, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			static constexpr size_t max_digits = 64; // far more than necessary but needed to allow fractional
 													 // millisecond truncation per the spec
 			uint32_t digits[max_digits];
@@ -2434,6 +3835,17 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_decimal_digit(*cp));
 			push_parse_scope("date-time"sv);
 
+			// canonical layout, straight out of the source
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				date_time result;
+				if (consume_canonical(scan_date_time, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			// "YYYY-MM-DD"
 			auto date = parse_date(true);
 			set_error_and_return_if_eof({});
@@ -2497,6 +3909,51 @@ TOML_IMPL_NAMESPACE_START
 		TOML_NODISCARD
 		node_ptr parse_array();
 
+		// appends a value to an array being parsed with parse_flags::packed_arrays or parse_flags::compact_arrays
+		// if it can be stored without its node, keeping the node around to be reused by the next new_value() of the
+		// same type
+		bool append_packed(array& arr, node_ptr& val)
+		{
+			const auto type = val->type();
+			const auto packable =
+				type == node_type::integer || type == node_type::floating_point || type == node_type::boolean;
+			if (!packable && !(compact_arrays && val->is_value() && type != node_type::string))
+				return false;
+			if (type == node_type::integer && val->ref_cast<int64_t>().flags() != value_flags::none)
+				return false;
+
+			if (!arr.packed_)
+			{
+				if (!arr.elems_.empty())
+					return false;
+				arr.packed_ = packed_array_storage::create(packable ? type : node_type::none, arr.node_resource());
+			}
+			else if (arr.packed_->type != type && arr.packed_->type != node_type::none)
+			{
+				if (!compact_arrays)
+					return false;
+				arr.packed_->convert_to_compact();
+			}
+
+			switch (arr.packed_->type)
+			{
+				case node_type::integer: arr.packed_->push_back(val->ref_cast<int64_t>().get()); break;
+				case node_type::floating_point: arr.packed_->push_back(val->ref_cast<double>().get()); break;
+				case node_type::boolean: arr.packed_->push_back(val->ref_cast<bool>().get()); break;
+				case node_type::none:
+				{
+					compact_value compact;
+					[[maybe_unused]] const auto assigned = compact.assign(*val);
+					TOML_ASSERT(assigned);
+					arr.packed_->push_back(compact);
+					break;
+				}
+				default: TOML_UNREACHABLE;
+			}
+			spare_value = std::move(val);
+			return true;
+		}
+
 		TOML_NODISCARD
 		node_ptr parse_inline_table();
 
@@ -2517,11 +3974,11 @@ TOML_IMPL_NAMESPACE_START
 				case U'{': return parse_inline_table();
 
 				// floats beginning with '.'
-				case U'.': return node_ptr{ new value{ parse_float() } };
+				case U'.': return new_value(parse_float());
 
 				// strings
 				case U'"': [[fallthrough]];
-				case U'\'': return node_ptr{ new value{ parse_string().value } };
+				case U'\'': return new_string_value(parse_string());
 
 				default:
 				{
@@ -2529,11 +3986,11 @@ TOML_IMPL_NAMESPACE_START
 
 					// bools
 					if (cp_upper == 70u || cp_upper == 84u) // F or T
-						return node_ptr{ new value{ parse_boolean() } };
+						return new_value(parse_boolean());
 
 					// inf/nan
 					else if (cp_upper == 73u || cp_upper == 78u) // I or N
-						return node_ptr{ new value{ parse_inf_or_nan() } };
+						return new_value(parse_inf_or_nan());
 
 					else
 						return nullptr;
@@ -2542,6 +3999,98 @@ TOML_IMPL_NAMESPACE_START
 			TOML_UNREACHABLE;
 		}
 
+		// identifies and converts the common forms of integers, floats, dates and times in a single pass straight
+		// out of the source, for when the whole document is in memory. returns nullptr without consuming anything
+		// if the value isn't one of those (or is malformed), leaving it to the trait scan in parse_value().
+		TOML_NODISCARD
+		node_ptr parse_value_single_pass()
+		{
+			return_if_error({});
+			assert_not_eof();
+
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				const auto source = reader.remaining();
+
+				// dates and date-times
+				if (source.length() >= 10u && source[4] == '-')
+				{
+					date_time dt;
+					if (consume_canonical(scan_date_time, dt))
+					{
+						return_if_error({});
+						return new_value(dt);
+					}
+
+					// (a date followed by a space and a digit is a malformed date-time, not a date)
+					if (source.length() >= 12u && source[10] == ' '
+						&& is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(source[11]))))
+						return nullptr;
+
+					if (!consume_canonical(scan_date, dt.date))
+						return nullptr;
+					return_if_error({});
+					return new_value(dt.date);
+				}
+
+				// times
+				if (source.length() >= 8u && source[2] == ':')
+				{
+					time t;
+					if (!consume_canonical(scan_time, t))
+						return nullptr;
+					return_if_error({});
+					return new_value(t);
+				}
+
+				// hexadecimal, octal and binary integers
+				if (source.length() >= 3u && source[0] == '0' && (source[1] == 'x' || source[1] == 'o' || source[1] == 'b'))
+				{
+					int64_t result;
+					value_flags flags;
+					bool consumed;
+					switch (source[1])
+					{
+						case 'x':
+							consumed = consume_integer<16>(2u, false, result);
+							flags	 = value_flags::format_as_hexadecimal;
+							break;
+
+						case 'o':
+							consumed = consume_integer<8>(2u, false, result);
+							flags	 = value_flags::format_as_octal;
+							break;
+
+						default:
+							consumed = consume_integer<2>(2u, false, result);
+							flags	 = value_flags::format_as_binary;
+							break;
+					}
+					if (!consumed)
+						return nullptr;
+					return_if_error({});
+
+					node_ptr val = new_value(result);
+					val->ref_cast<int64_t>().flags(flags);
+					return val;
+				}
+
+				// decimal integers and floats
+				decimal_number number;
+				if (consume_ascii_run([&](const char* str, size_t len) noexcept
+									  { return scan_decimal_number<max_numeric_length>(str, len, number); })
+						.empty())
+					return nullptr;
+				return_if_error({});
+
+				if (number.is_float)
+					return new_value(number.floating_point);
+				return new_value(number.integer);
+			}
+			else
+				return nullptr;
+		}
+
 		TOML_NODISCARD
 		node_ptr parse_value()
 		{
@@ -2583,6 +4132,11 @@ TOML_IMPL_NAMESPACE_START
 				if (val)
 					break;
 
+				val = parse_value_single_pass();
+				return_if_error({});
+				if (val)
+					break;
+
 				// value types from here down require more than one character to unambiguously identify
 				// so scan ahead and collect a set of value 'traits'.
 				enum TOML_CLOSED_FLAGS_ENUM value_traits : int
@@ -2627,20 +4181,24 @@ TOML_IMPL_NAMESPACE_START
 					break;
 
 				// scan the rest of the value to determine the remaining traits
-				char32_t chars[utf8_buffered_reader::max_history_length];
+				// (only the first few characters are actually needed to identify the type; the rest are just counted)
+				char32_t chars[16];
 				size_t char_count = {}, advance_count = {};
 				bool eof_while_scanning = false;
 				const auto scan			= [&]() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
 				{
-					if (is_eof())
+					// (is_value_terminator() is reachable when the date-time check below has consumed a
+					// date, a space and a single digit, e.g. "1979-05-27 0\n")
+					if (is_eof() || is_value_terminator(*cp))
 						return;
-					TOML_ASSERT_ASSUME(!is_value_terminator(*cp));
 
 					do
 					{
 						if (const auto c = **cp; c != U'_')
 						{
-							chars[char_count++] = c;
+							if (char_count < std::size(chars))
+								chars[char_count] = c;
+							char_count++;
 
 							if (is_decimal_digit(c))
 								add_trait(has_digits);
@@ -2698,7 +4256,7 @@ TOML_IMPL_NAMESPACE_START
 						advance_count++;
 						eof_while_scanning = is_eof();
 					}
-					while (advance_count < (utf8_buffered_reader::max_history_length - 1u) && !is_eof()
+					while (advance_count < (utf8_buffered_reader<Reader>::max_history_length - 1u) && !is_eof()
 						   && !is_value_terminator(*cp));
 				};
 				scan();
@@ -2754,7 +4312,7 @@ TOML_IMPL_NAMESPACE_START
 				{
 					if (has_any(begins_digit))
 					{
-						val.reset(new value{ static_cast<int64_t>(chars[0] - U'0') });
+						val = new_value(static_cast<int64_t>(chars[0] - U'0'));
 						advance(); // skip the digit
 						break;
 					}
@@ -2773,7 +4331,7 @@ TOML_IMPL_NAMESPACE_START
 				// typed parse functions to take over and show better diagnostics if there's an issue
 				// (as opposed to the fallback "could not determine type" message)
 				if (has_any(has_p))
-					val.reset(new value{ parse_hex_float() });
+					val = new_value(parse_hex_float());
 				else if (has_any(has_x | has_o | has_b))
 				{
 					int64_t i;
@@ -2795,17 +4353,17 @@ TOML_IMPL_NAMESPACE_START
 					}
 					return_if_error({});
 
-					val.reset(new value{ i });
+					val = new_value(i);
 					val->ref_cast<int64_t>().flags(flags);
 				}
 				else if (has_any(has_e) || (has_any(begins_digit) && chars[1] == U'.'))
-					val.reset(new value{ parse_float() });
+					val = new_value(parse_float());
 				else if (has_any(begins_sign))
 				{
 					// single-digit signed integers
 					if (char_count == 2u && has_any(has_digits))
 					{
-						val.reset(new value{ static_cast<int64_t>(chars[1] - U'0') * (chars[0] == U'-' ? -1LL : 1LL) });
+						val = new_value(static_cast<int64_t>(chars[1] - U'0') * (chars[0] == U'-' ? -1LL : 1LL));
 						advance(); // skip the sign
 						advance(); // skip the digit
 						break;
@@ -2813,11 +4371,11 @@ TOML_IMPL_NAMESPACE_START
 
 					// simple signed floats (e.g. +1.0)
 					if (is_decimal_digit(chars[1]) && chars[2] == U'.')
-						val.reset(new value{ parse_float() });
+						val = new_value(parse_float());
 
 					// signed infinity or nan
 					else if (is_match(chars[1], U'i', U'n', U'I', U'N'))
-						val.reset(new value{ parse_inf_or_nan() });
+						val = new_value(parse_inf_or_nan());
 				}
 
 				return_if_error({});
@@ -2833,14 +4391,14 @@ TOML_IMPL_NAMESPACE_START
 					// binary integers
 					// 0b10
 					case bzero_msk | has_b:
-						val.reset(new value{ parse_integer<2>() });
+						val = new_value(parse_integer<2>());
 						val->ref_cast<int64_t>().flags(value_flags::format_as_binary);
 						break;
 
 					// octal integers
 					// 0o10
 					case bzero_msk | has_o:
-						val.reset(new value{ parse_integer<8>() });
+						val = new_value(parse_integer<8>());
 						val->ref_cast<int64_t>().flags(value_flags::format_as_octal);
 						break;
 
@@ -2860,20 +4418,20 @@ TOML_IMPL_NAMESPACE_START
 						//
 						// (this will likely only come up during fuzzing and similar scenarios)
 						static constexpr size_t max_numeric_value_length =
-							utf8_buffered_reader::max_history_length - 2u;
+							utf8_buffered_reader<Reader>::max_history_length - 2u;
 						if TOML_UNLIKELY(!eof_while_scanning && advance_count > max_numeric_value_length)
 							set_error_and_return_default("numeric value too long to identify type - cannot exceed "sv,
 														 max_numeric_value_length,
 														 " characters"sv);
 
-						val.reset(new value{ parse_integer<10>() });
+						val = new_value(parse_integer<10>());
 						break;
 					}
 
 					// hexadecimal integers
 					// 0x10
 					case bzero_msk | has_x:
-						val.reset(new value{ parse_integer<16>() });
+						val = new_value(parse_integer<16>());
 						val->ref_cast<int64_t>().flags(value_flags::format_as_hexadecimal);
 						break;
 
@@ -2926,7 +4484,7 @@ TOML_IMPL_NAMESPACE_START
 					case begins_sign | has_digits | has_e | signs_msk: [[fallthrough]];
 					case begins_sign | has_digits | has_dot | has_minus: [[fallthrough]];
 					case begins_sign | has_digits | has_dot | has_e | has_minus:
-						val.reset(new value{ parse_float() });
+						val = new_value(parse_float());
 						break;
 
 					// hexadecimal floats
@@ -2960,7 +4518,7 @@ TOML_IMPL_NAMESPACE_START
 					case begins_sign | has_digits | has_x | has_dot | has_p | has_minus: [[fallthrough]];
 					case begins_sign | has_digits | has_x | has_dot | has_p | has_plus: [[fallthrough]];
 					case begins_sign | has_digits | has_x | has_dot | has_p | signs_msk:
-						val.reset(new value{ parse_hex_float() });
+						val = new_value(parse_hex_float());
 						break;
 
 					// times
@@ -2970,12 +4528,12 @@ TOML_IMPL_NAMESPACE_START
 					case bzero_msk | has_colon: [[fallthrough]];
 					case bzero_msk | has_colon | has_dot: [[fallthrough]];
 					case bdigit_msk | has_colon: [[fallthrough]];
-					case bdigit_msk | has_colon | has_dot: val.reset(new value{ parse_time() }); break;
+					case bdigit_msk | has_colon | has_dot: val = new_value(parse_time()); break;
 
 					// local dates
 					// YYYY-MM-DD
 					case bzero_msk | has_minus: [[fallthrough]];
-					case bdigit_msk | has_minus: val.reset(new value{ parse_date() }); break;
+					case bdigit_msk | has_minus: val = new_value(parse_date()); break;
 
 					// date-times
 					// YYYY-MM-DDTHH:MM
@@ -3014,7 +4572,7 @@ TOML_IMPL_NAMESPACE_START
 					case bzero_msk | has_minus | has_colon | has_dot | has_z | has_t: [[fallthrough]];
 					case bdigit_msk | has_minus | has_colon | has_z | has_t: [[fallthrough]];
 					case bdigit_msk | has_minus | has_colon | has_dot | has_z | has_t:
-						val.reset(new value{ parse_date_time() });
+						val = new_value(parse_date_time());
 						break;
 				}
 			}
@@ -3026,7 +4584,7 @@ TOML_IMPL_NAMESPACE_START
 				return_after_error({});
 			}
 
-			val->source_ = { begin_pos, current_position(1), reader.source_path() };
+			val->source_ = make_source_region(begin_pos, current_position(1));
 			return val;
 		}
 
@@ -3038,17 +4596,26 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_bare_key_character(*cp) || is_string_delimiter(*cp));
 			push_parse_scope("key"sv);
 
-			key_buffer.clear();
+			scratch.key_buffer.clear();
 			recording_whitespace = false;
 
 			while (!is_error())
 			{
 				std::string_view key_segment;
-				const auto key_begin = current_position();
+				const char* key_source = {}; // (see parse_flags::borrowed_strings)
+				const auto key_begin   = current_position();
 
 				// bare_key_segment
 				if (is_bare_key_character(*cp))
+				{
+					if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+					{
+						// bare keys are all ASCII, so one is always exactly the text it was parsed from
+						if (borrow_strings)
+							key_source = reader.remaining().data();
+					}
 					key_segment = parse_bare_key_segment();
+				}
 
 				// "quoted key segment"
 				else if (is_string_delimiter(*cp))
@@ -3064,12 +4631,16 @@ TOML_IMPL_NAMESPACE_START
 					{
 						set_error_at(begin_pos,
 									 "multi-line strings are prohibited in "sv,
-									 key_buffer.empty() ? ""sv : "dotted "sv,
+									 scratch.key_buffer.empty() ? ""sv : "dotted "sv,
 									 "keys"sv);
 						return_after_error({});
 					}
 					else
+					{
 						key_segment = str.value;
+						if (str.borrowed)
+							key_source = str.value.data();
+					}
 				}
 
 				// ???
@@ -3084,9 +4655,9 @@ TOML_IMPL_NAMESPACE_START
 				consume_leading_whitespace();
 
 				// store segment
-				key_buffer.push_back(key_segment, key_begin, key_end);
+				scratch.key_buffer.push_back(key_segment, key_begin, key_end, key_source);
 
-				if TOML_UNLIKELY(key_buffer.size() > max_dotted_keys_depth)
+				if TOML_UNLIKELY(scratch.key_buffer.size() > max_dotted_keys_depth)
 					set_error_and_return_default("exceeded maximum dotted keys depth of "sv,
 												 max_dotted_keys_depth,
 												 " (TOML_MAX_DOTTED_KEYS_DEPTH)"sv);
@@ -3108,12 +4679,19 @@ TOML_IMPL_NAMESPACE_START
 		TOML_NODISCARD
 		key make_key(size_t segment_index) const
 		{
-			TOML_ASSERT(key_buffer.size() > segment_index);
+			TOML_ASSERT(scratch.key_buffer.size() > segment_index);
 
-			return key{
-				key_buffer[segment_index],
-				source_region{ key_buffer.starts[segment_index], key_buffer.ends[segment_index], root.source().path }
-			};
+			const auto& buf = scratch.key_buffer;
+			const auto text = buf[segment_index];
+			auto region		= make_source_region(buf.starts[segment_index], buf.ends[segment_index]);
+
+			if (const auto source = buf.sources[segment_index])
+				return key{ key_text::borrow({ source, text.length() }), std::move(region) };
+
+			// with an arena, keys too long for std::string's own buffer are stored there (the same as long strings)
+			if (arena && text.length() > std::string{}.capacity())
+				return key{ key_text::borrow(arena->copy(text)), std::move(region) };
+			return key{ text, std::move(region) };
 		}
 
 		TOML_NODISCARD
@@ -3185,13 +4763,13 @@ TOML_IMPL_NAMESPACE_START
 				if (!is_eof() && !consume_comment() && !consume_line_break())
 					set_error_and_return_default("expected a comment or whitespace, saw '"sv, to_sv(cp), "'"sv);
 			}
-			TOML_ASSERT(!key_buffer.empty());
+			TOML_ASSERT(!scratch.key_buffer.empty());
 
 			// check if each parent is a table/table array, or can be created implicitly as a table.
 			table* parent = &root;
-			for (size_t i = 0, e = key_buffer.size() - 1u; i < e; i++)
+			for (size_t i = 0, e = scratch.key_buffer.size() - 1u; i < e; i++)
 			{
-				const std::string_view segment = key_buffer[i];
+				const std::string_view segment = scratch.key_buffer[i];
 				auto pit					   = parent->lower_bound(segment);
 
 				// parent already existed
@@ -3202,14 +4780,16 @@ TOML_IMPL_NAMESPACE_START
 					if (auto tbl = p.as_table())
 					{
 						// adding to closed inline tables is illegal
-						if (tbl->is_inline() && !impl::find(open_inline_tables.begin(), open_inline_tables.end(), tbl))
+						if (tbl->is_inline()
+							&& !impl::find(scratch.open_inline_tables.begin(), scratch.open_inline_tables.end(), tbl))
 							set_error_and_return_default("cannot insert '"sv,
-														 to_sv(recording_buffer),
+														 to_sv(scratch.recording_buffer),
 														 "' into existing inline table"sv);
 
 						parent = tbl;
 					}
-					else if (auto arr = p.as_array(); arr && impl::find(table_arrays.begin(), table_arrays.end(), arr))
+					else if (auto arr = p.as_array();
+							 arr && impl::find(scratch.table_arrays.begin(), scratch.table_arrays.end(), arr))
 					{
 						// table arrays are a special case;
 						// the spec dictates we select the most recently declared element in the array.
@@ -3221,13 +4801,13 @@ TOML_IMPL_NAMESPACE_START
 					{
 						if (!is_arr && p.type() == node_type::table)
 							set_error_and_return_default("cannot redefine existing table '"sv,
-														 to_sv(recording_buffer),
+														 to_sv(scratch.recording_buffer),
 														 "'"sv);
 						else
 							set_error_and_return_default("cannot redefine existing "sv,
 														 to_sv(p.type()),
 														 " '"sv,
-														 to_sv(recording_buffer),
+														 to_sv(scratch.recording_buffer),
 														 "' as "sv,
 														 is_arr ? "array-of-tables"sv : "table"sv);
 					}
@@ -3236,16 +4816,16 @@ TOML_IMPL_NAMESPACE_START
 				// need to create a new implicit table
 				else
 				{
-					pit		  = parent->emplace_hint<table>(pit, make_key(i));
+					pit		  = parent->emplace_hint<node_ptr>(pit, make_key(i), new_node<table>());
 					table& p  = pit->second.ref_cast<table>();
-					p.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					p.source_ = make_source_region(header_begin_pos, header_end_pos);
 
-					implicit_tables.push_back(&p);
+					scratch.implicit_tables.push_back(&p);
 					parent = &p;
 				}
 			}
 
-			const auto last_segment = key_buffer.back();
+			const auto last_segment = scratch.key_buffer.back();
 			auto it					= parent->lower_bound(last_segment);
 
 			// if there was already a matching node some sanity checking is necessary;
@@ -3256,15 +4836,16 @@ TOML_IMPL_NAMESPACE_START
 			{
 				node& matching_node = it->second;
 				if (auto arr = matching_node.as_array();
-					is_arr && arr && impl::find(table_arrays.begin(), table_arrays.end(), arr))
+					is_arr && arr && impl::find(scratch.table_arrays.begin(), scratch.table_arrays.end(), arr))
 				{
-					table& tbl	= arr->emplace_back<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					table& tbl	= arr->emplace_back<node_ptr>(new_node<table>()).template ref_cast<table>();
+					tbl.source_ = make_source_region(header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 
-				else if (auto tbl = matching_node.as_table(); !is_arr && tbl && !implicit_tables.empty())
+				else if (auto tbl = matching_node.as_table(); !is_arr && tbl && !scratch.implicit_tables.empty())
 				{
+					auto& implicit_tables = scratch.implicit_tables;
 					if (auto found = impl::find(implicit_tables.begin(), implicit_tables.end(), tbl); found)
 					{
 						bool ok = true;
@@ -3283,8 +4864,7 @@ TOML_IMPL_NAMESPACE_START
 						if (ok)
 						{
 							implicit_tables.erase(implicit_tables.cbegin() + (found - implicit_tables.data()));
-							tbl->source_.begin = header_begin_pos;
-							tbl->source_.end   = header_end_pos;
+							tbl->source_ = make_source_region(header_begin_pos, header_end_pos);
 							return tbl;
 						}
 					}
@@ -3295,7 +4875,7 @@ TOML_IMPL_NAMESPACE_START
 				{
 					set_error_at(header_begin_pos,
 								 "cannot redefine existing table '"sv,
-								 to_sv(recording_buffer),
+								 to_sv(scratch.recording_buffer),
 								 "'"sv);
 					return_after_error({});
 				}
@@ -3305,7 +4885,7 @@ TOML_IMPL_NAMESPACE_START
 								 "cannot redefine existing "sv,
 								 to_sv(matching_node.type()),
 								 " '"sv,
-								 to_sv(recording_buffer),
+								 to_sv(scratch.recording_buffer),
 								 "' as "sv,
 								 is_arr ? "array-of-tables"sv : "table"sv);
 					return_after_error({});
@@ -3315,28 +4895,28 @@ TOML_IMPL_NAMESPACE_START
 			// there was no matching node, sweet - we can freely instantiate a new table/table array.
 			else
 			{
-				auto last_key = make_key(key_buffer.size() - 1u);
+				auto last_key = make_key(scratch.key_buffer.size() - 1u);
 
 				// if it's an array we need to make the array and it's first table element,
 				// set the starting regions, and return the table element
 				if (is_arr)
 				{
-					it			   = parent->emplace_hint<array>(it, std::move(last_key));
+					it			   = parent->emplace_hint<node_ptr>(it, std::move(last_key), new_node<array>());
 					array& tbl_arr = it->second.ref_cast<array>();
-					table_arrays.push_back(&tbl_arr);
-					tbl_arr.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					scratch.table_arrays.push_back(&tbl_arr);
+					tbl_arr.source_ = make_source_region(header_begin_pos, header_end_pos);
 
-					table& tbl	= tbl_arr.emplace_back<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					table& tbl	= tbl_arr.emplace_back<node_ptr>(new_node<table>()).template ref_cast<table>();
+					tbl.source_ = make_source_region(header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 
 				// otherwise we're just making a table
 				else
 				{
-					it			= parent->emplace_hint<table>(it, std::move(last_key));
+					it			= parent->emplace_hint<node_ptr>(it, std::move(last_key), new_node<table>());
 					table& tbl	= it->second.ref_cast<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					tbl.source_ = make_source_region(header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 			}
@@ -3355,7 +4935,7 @@ TOML_IMPL_NAMESPACE_START
 			parse_key();
 			stop_recording(1u);
 			return_if_error({});
-			TOML_ASSERT(key_buffer.size() >= 1u);
+			TOML_ASSERT(scratch.key_buffer.size() >= 1u);
 
 			// skip past any whitespace that followed the key
 			consume_leading_whitespace();
@@ -3377,11 +4957,11 @@ TOML_IMPL_NAMESPACE_START
 
 			// if it's a dotted kvp we need to spawn the parent sub-tables if necessary,
 			// and set the target table to the second-to-last one in the chain
-			if (key_buffer.size() > 1u)
+			if (scratch.key_buffer.size() > 1u)
 			{
-				for (size_t i = 0; i < key_buffer.size() - 1u; i++)
+				for (size_t i = 0; i < scratch.key_buffer.size() - 1u; i++)
 				{
-					const std::string_view segment = key_buffer[i];
+					const std::string_view segment = scratch.key_buffer[i];
 					auto pit					   = tbl->lower_bound(segment);
 
 					// parent already existed
@@ -3391,10 +4971,10 @@ TOML_IMPL_NAMESPACE_START
 
 						// redefinition
 						if TOML_UNLIKELY(!p
-							|| !(impl::find(dotted_key_tables.begin(), dotted_key_tables.end(), p)
-								 || impl::find(implicit_tables.begin(), implicit_tables.end(), p)))
+							|| !(impl::find(scratch.dotted_key_tables.begin(), scratch.dotted_key_tables.end(), p)
+								 || impl::find(scratch.implicit_tables.begin(), scratch.implicit_tables.end(), p)))
 						{
-							set_error_at(key_buffer.starts[i],
+							set_error_at(scratch.key_buffer.starts[i],
 										 "cannot redefine existing "sv,
 										 to_sv(pit->second.type()),
 										 " as dotted key-value pair"sv);
@@ -3407,32 +4987,32 @@ TOML_IMPL_NAMESPACE_START
 					// need to create a new implicit table
 					else
 					{
-						pit		  = tbl->emplace_hint<table>(pit, make_key(i));
+						pit		  = tbl->emplace_hint<node_ptr>(pit, make_key(i), new_node<table>());
 						table& p  = pit->second.ref_cast<table>();
 						p.source_ = pit->first.source();
 
-						dotted_key_tables.push_back(&p);
+						scratch.dotted_key_tables.push_back(&p);
 						tbl = &p;
 					}
 				}
 			}
 
 			// ensure this isn't a redefinition
-			const std::string_view last_segment = key_buffer.back();
+			const std::string_view last_segment = scratch.key_buffer.back();
 			auto it								= tbl->lower_bound(last_segment);
 			if (it != tbl->end() && it->first == last_segment)
 			{
 				set_error("cannot redefine existing "sv,
 						  to_sv(it->second.type()),
 						  " '"sv,
-						  to_sv(recording_buffer),
+						  to_sv(scratch.recording_buffer),
 						  "'"sv);
 				return_after_error({});
 			}
 
 			// create the key first since the key buffer will likely get overwritten during value parsing (inline
 			// tables)
-			auto last_key = make_key(key_buffer.size() - 1u);
+			auto last_key = make_key(scratch.key_buffer.size() - 1u);
 
 			// now we can actually parse the value
 			node_ptr val = parse_value();
@@ -3448,8 +5028,6 @@ TOML_IMPL_NAMESPACE_START
 			assert_not_eof();
 			push_parse_scope("root table"sv);
 
-			table* current_table = &root;
-
 			do
 			{
 				return_if_error();
@@ -3485,6 +5063,12 @@ TOML_IMPL_NAMESPACE_START
 					set_error("expected keys, tables, whitespace or comments, saw '"sv, to_sv(cp), "'"sv);
 			}
 			while (!is_eof());
+		}
+
+		void finish_document()
+		{
+			if (!track_sources)
+				return;
 
 			auto eof_pos	 = current_position(1);
 			root.source_.end = eof_pos;
@@ -3517,7 +5101,10 @@ TOML_IMPL_NAMESPACE_START
 			else // arrays
 			{
 				auto& arr = nde.ref_cast<array>();
-				auto end  = nde.source_.end;
+				if (arr.is_packed()) // (the values don't have regions)
+					return;
+
+				auto end = nde.source_.end;
 				for (auto&& v : arr)
 				{
 					update_region_ends(v);
@@ -3528,11 +5115,31 @@ TOML_IMPL_NAMESPACE_START
 			}
 		}
 
+		void apply_flags(parse_flags flags)
+		{
+			if (!!(flags & parse_flags::arena_allocation))
+			{
+				root.arena_ = arena_ref{ new node_arena{ scratch.arena_size_hint } };
+				arena = root.arena_.get();
+			}
+
+			track_sources  = !(flags & parse_flags::no_source_tracking);
+			compact_arrays = !!(flags & parse_flags::compact_arrays);
+			pack_arrays	   = compact_arrays || !!(flags & parse_flags::packed_arrays);
+			borrow_strings = utf8_buffered_reader<Reader>::is_contiguous && !!(flags & parse_flags::borrowed_strings);
+			root.source_   = make_source_region(prev_pos, prev_pos);
+		}
+
 	  public:
-		parser(utf8_reader_interface&& reader_) //
-			: reader{ reader_ }
+		parser(Reader&& reader_, parse_flags flags = {}, parse_scratch* borrowed_scratch = nullptr) //
+			: reader{ reader_ },
+			  scratch{ borrowed_scratch ? *borrowed_scratch : own_scratch }
 		{
-			root.source_ = { prev_pos, prev_pos, reader.source_path() };
+			// whatever a previous document left behind (e.g. if it threw part-way through) isn't relevant
+			if (borrowed_scratch)
+				scratch.clear();
+
+			apply_flags(flags);
 
 			if (!reader.peek_eof())
 			{
@@ -3547,15 +5154,74 @@ TOML_IMPL_NAMESPACE_START
 #endif
 
 				if (cp)
+				{
 					parse_document();
+					finish_document();
+				}
+			}
+
+			if (track_sources)
+				update_region_ends(root);
+		}
+
+		// documents that arrive in pieces (see toml::push_parser) are parsed a batch of whole expressions at a time;
+		// the reader is pointed at each batch in turn and parse_next() called, then finish() once there are no more.
+		struct push_mode_t
+		{};
+
+		parser(Reader& reader_, push_mode_t, parse_flags flags = {}) //
+			: reader{ reader_ },
+			  scratch{ own_scratch }
+		{
+			// the chunks are gone by the time the document is finished, so there's nothing to borrow strings from
+			apply_flags(flags & ~parse_flags::borrowed_strings);
+		}
+
+		// returns false if there was an error (so there's no point reading any more of the document)
+		bool parse_next()
+		{
+			return_if_error(false);
+
+			cp = reader.read_next();
+
+#if !TOML_EXCEPTIONS
+			if (reader.error())
+			{
+				err = std::move(reader.error());
+				return false;
+			}
+#endif
+
+			if (cp)
+			{
+				parse_document();
+				parsed_any = true;
 			}
 
-			update_region_ends(root);
+			return_if_error(false);
+
+			// (the batch is gone by the time the next one arrives, so its line and column can't be worked out later)
+			prev_pos = reader.resolve(prev_pos);
+			return true;
+		}
+
+		void finish()
+		{
+			return_if_error();
+
+			if (parsed_any)
+				finish_document();
+			if (track_sources)
+				update_region_ends(root);
 		}
 
 		TOML_NODISCARD
 		operator parse_result() && noexcept
 		{
+			if (arena)
+				scratch.arena_size_hint = arena->used();
+			spare_value.reset(); // (might be in the arena)
+
 #if TOML_EXCEPTIONS
 
 			return { std::move(root) };
@@ -3571,8 +5237,8 @@ TOML_IMPL_NAMESPACE_START
 		}
 	};
 
-	TOML_EXTERNAL_LINKAGE
-	node_ptr parser::parse_array()
+	template <typename Reader>
+	node_ptr parser<Reader>::parse_array()
 	{
 		return_if_error({});
 		assert_not_eof();
@@ -3582,7 +5248,7 @@ TOML_IMPL_NAMESPACE_START
 		// skip opening '['
 		advance_and_return_if_error_or_eof({});
 
-		node_ptr arr_ptr{ new array{} };
+		node_ptr arr_ptr = new_node<array>();
 		array& arr = arr_ptr->ref_cast<array>();
 		enum class TOML_CLOSED_ENUM parse_type : int
 		{
@@ -3630,6 +5296,9 @@ TOML_IMPL_NAMESPACE_START
 				auto val = parse_value();
 				return_if_error({});
 
+				if (pack_arrays && append_packed(arr, val))
+					continue;
+
 				if (!arr.capacity())
 					arr.reserve(4u);
 				arr.emplace_back<node_ptr>(std::move(val));
@@ -3640,8 +5309,8 @@ TOML_IMPL_NAMESPACE_START
 		return arr_ptr;
 	}
 
-	TOML_EXTERNAL_LINKAGE
-	node_ptr parser::parse_inline_table()
+	template <typename Reader>
+	node_ptr parser<Reader>::parse_inline_table()
 	{
 		return_if_error({});
 		assert_not_eof();
@@ -3651,10 +5320,10 @@ TOML_IMPL_NAMESPACE_START
 		// skip opening '{'
 		advance_and_return_if_error_or_eof({});
 
-		node_ptr tbl_ptr{ new table{} };
+		node_ptr tbl_ptr = new_node<table>();
 		table& tbl = tbl_ptr->ref_cast<table>();
 		tbl.is_inline(true);
-		table_vector_scope table_scope{ open_inline_tables, tbl };
+		table_vector_scope table_scope{ scratch.open_inline_tables, tbl };
 
 		enum class TOML_CLOSED_ENUM parse_type : int
 		{
@@ -3726,6 +5395,8 @@ TOML_IMPL_NAMESPACE_START
 		return tbl_ptr;
 	}
 
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 }
 TOML_IMPL_NAMESPACE_END;
@@ -3759,16 +5430,139 @@ TOML_IMPL_NAMESPACE_END;
 
 TOML_ANON_NAMESPACE_START
 {
+	template <typename Reader>
 	TOML_NODISCARD
 	TOML_INTERNAL_LINKAGE
-	parse_result do_parse(utf8_reader_interface && reader)
+	parse_result do_parse(Reader && reader, parse_flags flags, impl::parse_scratch* scratch = nullptr)
 	{
-		return impl::parser{ std::move(reader) };
+		static_assert(!std::is_reference_v<Reader>);
+		if constexpr (!utf8_buffered_reader<Reader>::is_contiguous)
+		{
+			if (scratch)
+				reader.use_chunk_buffer(scratch->chunk_buffer);
+		}
+		return impl::parser<Reader>{ std::move(reader), flags, scratch };
 	}
 
+	// read-only memory mapping of a regular file; lets parse_file() hand the file contents straight to the
+	// string_view reader without copying them anywhere first (or going through iostreams for large files).
+	// any failure just leaves the mapping empty so the caller can fall back to the regular file I/O path.
+	class memory_mapped_file
+	{
+	  private:
+		const char* data_ = {};
+		size_t size_	  = {};
+
+	  public:
+		TOML_NODISCARD_CTOR
+		memory_mapped_file() noexcept = default;
+
+		TOML_NODISCARD
+		bool map(const std::string& file_path) noexcept
+		{
+#if TOML_WINDOWS
+
+			const auto wide_path = impl::widen(file_path);
+			void* const invalid_handle = reinterpret_cast<void*>(static_cast<intptr_t>(-1));
+			void* const file		   = ::CreateFileW(wide_path.c_str(),
+											   0x80000000ul, // GENERIC_READ
+											   0x00000001ul, // FILE_SHARE_READ
+											   nullptr,
+											   3ul,			 // OPEN_EXISTING
+											   0x00000080ul, // FILE_ATTRIBUTE_NORMAL
+											   nullptr);
+			if (file == invalid_handle)
+				return false;
+
+			bool ok = false;
+			if (::GetFileType(file) == 0x0001ul) // FILE_TYPE_DISK
+			{
+				unsigned long size_high = {};
+				const auto size_low		= ::GetFileSize(file, &size_high);
+				const auto size			= (static_cast<uint64_t>(size_high) << 32) | size_low;
+				if (size_low != 0xFFFFFFFFul && size <= static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+				{
+					if (!size)
+						ok = true;
+					else if (void* const mapping = ::CreateFileMappingW(file, nullptr, 0x02ul, 0ul, 0ul, nullptr))
+					{
+						// the view keeps the underlying mapping object alive after its handle is closed
+						data_ = static_cast<const char*>(::MapViewOfFile(mapping, 0x0004ul, 0ul, 0ul, 0u));
+						::CloseHandle(mapping);
+						if (data_)
+						{
+							size_ = static_cast<size_t>(size);
+							ok = true;
+						}
+					}
+				}
+			}
+			::CloseHandle(file);
+			return ok;
+
+#elif TOML_UNIX || defined(__APPLE__)
+
+			const int fd = ::open(file_path.c_str(), O_RDONLY);
+			if (fd == -1)
+				return false;
+
+			bool ok = false;
+			struct stat st;
+			if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size >= 0
+				&& static_cast<uint64_t>(st.st_size) <= static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+			{
+				if (!st.st_size)
+					ok = true;
+				else
+				{
+					const auto size = static_cast<size_t>(st.st_size);
+					void* const ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+					if (ptr != MAP_FAILED)
+					{
+#ifdef POSIX_MADV_SEQUENTIAL
+						::posix_madvise(ptr, size, POSIX_MADV_SEQUENTIAL);
+#endif
+						data_ = static_cast<const char*>(ptr);
+						size_ = size;
+						ok = true;
+					}
+				}
+			}
+			::close(fd); // the mapping keeps its own reference to the file
+			return ok;
+
+#else
+
+			TOML_UNUSED(file_path);
+			return false;
+
+#endif
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view view() const noexcept
+		{
+			return { data_, size_ };
+		}
+
+		~memory_mapped_file() noexcept
+		{
+			if (!data_)
+				return;
+
+#if TOML_WINDOWS
+			::UnmapViewOfFile(data_);
+#elif TOML_UNIX || defined(__APPLE__)
+			::munmap(const_cast<char*>(data_), size_);
+#endif
+		}
+
+		TOML_DELETE_DEFAULTS(memory_mapped_file);
+	};
+
 	TOML_NODISCARD
 	TOML_INTERNAL_LINKAGE
-	parse_result do_parse_file(std::string_view file_path)
+	parse_result do_parse_file(std::string_view file_path, parse_flags flags, impl::parse_scratch* scratch = nullptr)
 	{
 #if TOML_EXCEPTIONS
 #define TOML_PARSE_FILE_ERROR(msg, path)                                                                               \
@@ -3780,6 +5574,16 @@ TOML_ANON_NAMESPACE_START
 
 		std::string file_path_str(file_path);
 
+		// the file's contents only live as long as this function, so strings can't be borrowed from them
+		flags &= ~parse_flags::borrowed_strings;
+
+		// try memory-mapping the file first so it can be parsed in-place, regardless of size
+		{
+			memory_mapped_file mapped_file;
+			if (mapped_file.map(file_path_str))
+				return do_parse(utf8_reader{ mapped_file.view(), std::move(file_path_str) }, flags, scratch);
+		}
+
 		// open file with a custom-sized stack buffer
 		std::ifstream file;
 		TOML_OVERALIGNED char file_buffer[sizeof(void*) * 1024u];
@@ -3805,73 +5609,328 @@ TOML_ANON_NAMESPACE_START
 			std::vector<char> file_data;
 			file_data.resize(static_cast<size_t>(file_size));
 			file.read(file_data.data(), static_cast<std::streamsize>(file_size));
-			return parse(std::string_view{ file_data.data(), file_data.size() }, std::move(file_path_str));
+			const auto file_view = std::string_view{ file_data.data(), file_data.size() };
+			return do_parse(utf8_reader{ file_view, std::move(file_path_str) }, flags, scratch);
 		}
 
 		// otherwise parse it using the streams
 		else
-			return parse(file, std::move(file_path_str));
+			return do_parse(utf8_reader{ file, std::move(file_path_str) }, flags, scratch);
 
 #undef TOML_PARSE_FILE_ERROR
 	}
+
+	// finds the ends of complete top-level expressions in a document that's arriving in pieces.
+	// it only needs to understand enough of the grammar to tell whether a line break actually ends an expression
+	// (i.e. isn't inside a comment, string, array or inline table); the parser proper deals with everything else.
+	class expression_boundary_scanner
+	{
+	  private:
+		enum class TOML_CLOSED_ENUM mode_type : uint8_t
+		{
+			expression,
+			comment,
+			basic_string,
+			literal_string,
+			multi_line_basic_string,
+			multi_line_literal_string
+		};
+
+		mode_type mode_ = mode_type::expression;
+		size_t depth_	= {}; // of [brackets] and {braces}
+		size_t pos_		= {}; // how much of the pending data has been scanned already
+
+	  public:
+		// scans the pending data from wherever the last call left off, returning the end of the last complete
+		// expression found (or zero if there weren't any). stops early if it would have to look past the end of
+		// the data to work out what something is (e.g. whether a quote starts a multi-line string).
+		TOML_NODISCARD
+		size_t scan(std::string_view data) noexcept
+		{
+			const auto s = data.data();
+			const auto n = data.length();
+			size_t end	 = {};
+			size_t i	 = pos_;
+
+			while (i < n)
+			{
+				const auto c = s[i];
+				switch (mode_)
+				{
+					case mode_type::expression:
+					{
+						if (c == '\n')
+						{
+							if (!depth_)
+								end = i + 1u;
+						}
+						else if (c == '#')
+							mode_ = mode_type::comment;
+						else if (c == '[' || c == '{')
+							depth_++;
+						else if ((c == ']' || c == '}') && depth_)
+							depth_--;
+						else if (c == '"' || c == '\'')
+						{
+							if (n - i < 3u)
+								goto done;
+
+							if (s[i + 1u] != c)
+								mode_ = c == '"' ? mode_type::basic_string : mode_type::literal_string;
+							else if (s[i + 2u] != c) // empty string
+								i++;
+							else
+							{
+								mode_ = c == '"' ? mode_type::multi_line_basic_string
+												 : mode_type::multi_line_literal_string;
+								i += 2u;
+							}
+						}
+						break;
+					}
+
+					case mode_type::comment:
+					{
+						const auto nl = static_cast<const char*>(std::memchr(s + i, '\n', n - i));
+						if (!nl)
+						{
+							i = n;
+							continue;
+						}
+						i	  = static_cast<size_t>(nl - s);
+						mode_ = mode_type::expression;
+						continue; // the line break ends the expression too
+					}
+
+					case mode_type::basic_string: [[fallthrough]];
+					case mode_type::literal_string:
+					{
+						if (c == '\\' && mode_ == mode_type::basic_string)
+						{
+							if (n - i < 2u)
+								goto done;
+							i++;
+						}
+						else if (c == (mode_ == mode_type::basic_string ? '"' : '\''))
+							mode_ = mode_type::expression;
+						else if (c == '\n')
+						{
+							// unterminated; the parser will complain about it, but it might look a character or so
+							// past the line break first, so this one doesn't count as the end of the expression
+							mode_ = mode_type::expression;
+						}
+						break;
+					}
+
+					case mode_type::multi_line_basic_string: [[fallthrough]];
+					case mode_type::multi_line_literal_string:
+					{
+						const auto delim = mode_ == mode_type::multi_line_basic_string ? '"' : '\'';
+						if (c == '\\' && delim == '"')
+						{
+							if (n - i < 2u)
+								goto done;
+							i++;
+						}
+						else if (c == delim)
+						{
+							// a run of 3-5 closes the string (up to two of them being part of the string)
+							auto j = i + 1u;
+							while (j < n && s[j] == delim)
+								j++;
+							if (j == n)
+								goto done;
+							if (j - i >= 3u)
+								mode_ = mode_type::expression;
+							i = j;
+							continue;
+						}
+						break;
+					}
+
+					default: TOML_UNREACHABLE;
+				}
+				i++;
+			}
+
+		done:
+			pos_ = i;
+			return end;
+		}
+
+		// lets the scanner know the first 'count' bytes of the pending data have been parsed and discarded
+		void consumed(size_t count) noexcept
+		{
+			TOML_ASSERT_ASSUME(count <= pos_);
+			pos_ -= count;
+		}
+	};
+
+	// all the chunks handed to a push_parser are scanned for the ends of top-level expressions, and everything up to
+	// the last one is parsed; whatever's left is held over for the next chunk (or finish()). the parser and reader
+	// stick around between chunks so the document's tables and source positions carry on where they left off.
+	class push_parser_impl final : public impl::push_parser_state
+	{
+	  private:
+		using reader_type = utf8_reader<std::string_view>;
+
+		std::string pending_;
+		expression_boundary_scanner scanner_;
+		reader_type reader_;
+		impl::parser<reader_type> parser_;
+		bool bom_checked_ = false;
+		bool failed_	  = false;
+
+		void parse(std::string_view expressions)
+		{
+			reader_.reset(expressions);
+			failed_ = true;
+			failed_ = !parser_.parse_next();
+			if (!failed_)
+				reader_.finish_piece();
+		}
+
+	  public:
+		template <typename String>
+		TOML_NODISCARD_CTOR
+		explicit push_parser_impl(String&& source_path, parse_flags flags) //
+			: reader_{ std::string_view{}, static_cast<String&&>(source_path) },
+			  parser_{ reader_, impl::parser<reader_type>::push_mode_t{}, flags }
+		{}
+
+		void feed(std::string_view chunk) override
+		{
+			TOML_ASSERT(!failed_ || !TOML_EXCEPTIONS);
+			if (failed_ || chunk.empty())
+				return;
+
+			// when nothing was held over from the previous chunk, whole expressions are parsed straight out of
+			// this one and only the leftovers are copied
+			std::string_view data = chunk;
+
+			// the byte order mark (if any) can only appear at the very start of the document
+			if (!bom_checked_)
+			{
+				pending_.append(chunk);
+				const auto len = impl::min(pending_.length(), size_t{ 3u });
+				if (memcmp(utf8_byte_order_mark.data(), pending_.data(), len) == 0)
+				{
+					if (len < 3u)
+						return;
+					pending_.erase(0u, 3u);
+					reader_.skipped_bom();
+				}
+				bom_checked_ = true;
+				data		 = pending_;
+			}
+			else if (!pending_.empty())
+			{
+				pending_.append(chunk);
+				data = pending_;
+			}
+
+			const auto end = scanner_.scan(data);
+			if (end)
+			{
+				parse(data.substr(0u, end));
+				if (failed_)
+				{
+					pending_.clear();
+					return;
+				}
+				scanner_.consumed(end);
+			}
+
+			if (data.data() == pending_.data())
+				pending_.erase(0u, end);
+			else
+				pending_.assign(data.substr(end));
+		}
+
+		TOML_NODISCARD
+		parse_result finish() override
+		{
+			if (!failed_ && !pending_.empty())
+				parse(pending_);
+
+			parser_.finish();
+			return static_cast<parse_result>(std::move(parser_));
+		}
+	};
 }
 TOML_ANON_NAMESPACE_END;
 
 TOML_NAMESPACE_START
 {
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result TOML_CALLCONV parse(std::string_view doc, std::string_view source_path, parse_flags flags)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path }, flags);
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result TOML_CALLCONV parse(std::string_view doc, std::string && source_path, parse_flags flags)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) }, flags);
+	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string_view source_path)
+	parse_result TOML_CALLCONV parse(std::istream & doc, std::string_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string && source_path)
+	parse_result TOML_CALLCONV parse(std::istream & doc, std::string && source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string_view source_path)
+	parse_result TOML_CALLCONV parse(byte_source doc, std::string_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, source_path }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string && source_path)
+	parse_result TOML_CALLCONV parse(byte_source doc, std::string && source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(
+			TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, std::move(source_path) },
+			flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse_file(std::string_view file_path)
+	parse_result TOML_CALLCONV parse_file(std::string_view file_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse_file(file_path);
+		return TOML_ANON_NAMESPACE::do_parse_file(file_path, flags);
 	}
 
 #if TOML_HAS_CHAR8
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string_view source_path)
+	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string && source_path)
+	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string && source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path)
+	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path, parse_flags flags)
 	{
 		std::string file_path_str;
 		file_path_str.resize(file_path.length());
 		memcpy(file_path_str.data(), file_path.data(), file_path.length());
-		return TOML_ANON_NAMESPACE::do_parse_file(file_path_str);
+		return TOML_ANON_NAMESPACE::do_parse_file(file_path_str, flags);
 	}
 
 #endif // TOML_HAS_CHAR8
@@ -3879,21 +5938,29 @@ TOML_NAMESPACE_START
 #if TOML_ENABLE_WINDOWS_COMPAT
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::wstring_view source_path)
+	parse_result TOML_CALLCONV parse(std::string_view doc, std::wstring_view source_path, parse_flags flags)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) }, flags);
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result TOML_CALLCONV parse(std::istream & doc, std::wstring_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::wstring_view source_path)
+	parse_result TOML_CALLCONV parse(byte_source doc, std::wstring_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(
+			TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, impl::narrow(source_path) },
+			flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path)
+	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse_file(impl::narrow(file_path));
+		return TOML_ANON_NAMESPACE::do_parse_file(impl::narrow(file_path), flags);
 	}
 
 #endif // TOML_ENABLE_WINDOWS_COMPAT
@@ -3901,13 +5968,109 @@ TOML_NAMESPACE_START
 #if TOML_HAS_CHAR8 && TOML_ENABLE_WINDOWS_COMPAT
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::wstring_view source_path)
+	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::wstring_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) }, flags);
 	}
 
 #endif // TOML_HAS_CHAR8 && TOML_ENABLE_WINDOWS_COMPAT
 
+	TOML_EXTERNAL_LINKAGE
+	push_parser::push_parser(std::string_view source_path, parse_flags flags) //
+		: state_{ new TOML_ANON_NAMESPACE::push_parser_impl{ source_path, flags } }
+	{}
+
+	TOML_EXTERNAL_LINKAGE
+	push_parser::push_parser(std::string && source_path, parse_flags flags) //
+		: state_{ new TOML_ANON_NAMESPACE::push_parser_impl{ std::move(source_path), flags } }
+	{}
+
+#if TOML_ENABLE_WINDOWS_COMPAT
+
+	TOML_EXTERNAL_LINKAGE
+	push_parser::push_parser(std::wstring_view source_path, parse_flags flags) //
+		: state_{ new TOML_ANON_NAMESPACE::push_parser_impl{ impl::narrow(source_path), flags } }
+	{}
+
+#endif
+
+	TOML_EXTERNAL_LINKAGE
+	void push_parser::feed(std::string_view chunk)
+	{
+		TOML_ASSERT_ASSUME(state_);
+		state_->feed(chunk);
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result push_parser::finish()
+	{
+		TOML_ASSERT_ASSUME(state_);
+		return state_->finish();
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context::parse_context(parse_flags flags) //
+		: scratch_{ new impl::parse_scratch{} },
+		  flags_{ flags }
+	{}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context::parse_context(parse_context&&) noexcept = default;
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context& parse_context::operator=(parse_context&&) noexcept = default;
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context::~parse_context() noexcept = default;
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::string_view doc, std::string_view source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::string_view doc, std::string && source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::istream & doc, std::string_view source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::istream & doc, std::string && source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(byte_source doc, std::string_view source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, source_path },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse_file(std::string_view file_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse_file(file_path, flags_, scratch_.get());
+	}
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 }
 TOML_NAMESPACE_END;
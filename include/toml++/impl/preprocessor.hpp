@@ -1090,6 +1090,52 @@
 #define TOML_ENABLE_SIMD 1
 #endif
 
+// polymorphic allocators
+#if (defined(TOML_ENABLE_PMR) && TOML_ENABLE_PMR) || TOML_INTELLISENSE
+#undef TOML_ENABLE_PMR
+#define TOML_ENABLE_PMR 1
+#endif
+#ifndef TOML_ENABLE_PMR
+#define TOML_ENABLE_PMR 0
+#endif
+/// \cond
+#if !TOML_HAS_INCLUDE(<memory_resource>)
+#undef TOML_ENABLE_PMR
+#define TOML_ENABLE_PMR 0
+#endif
+/// \endcond
+/// \def TOML_ENABLE_PMR
+/// \brief Enables support for polymorphic allocators (`std::pmr`) in toml::table and toml::array.
+/// \detail Defaults to `0`. Ignored if the standard library doesn't provide `<memory_resource>`.
+/// \remark When enabled, tables and arrays store their entries in `std::pmr` containers and
+/// 		allocate child nodes from the same memory resource. This changes the layout of toml::table and
+/// 		toml::array, so every translation unit (and the library, if you're not using it header-only) must be
+/// 		compiled with the same setting; mismatches fail to link rather than misbehaving at runtime.
+/// \see
+///  - toml::table::allocator_type
+///  - toml::array::allocator_type
+
+// flat tables
+#if (defined(TOML_ENABLE_FLAT_TABLES) && TOML_ENABLE_FLAT_TABLES) || TOML_INTELLISENSE
+#undef TOML_ENABLE_FLAT_TABLES
+#define TOML_ENABLE_FLAT_TABLES 1
+#endif
+#ifndef TOML_ENABLE_FLAT_TABLES
+#define TOML_ENABLE_FLAT_TABLES 0
+#endif
+/// \def TOML_ENABLE_FLAT_TABLES
+/// \brief Stores the entries of a toml::table in a sorted, contiguous array instead of a `std::map`.
+/// \detail Defaults to `0`.
+/// \remark Lookups in tables with more than a handful of keys go through a hash index of the entries rather than a
+/// 		walk down a tree, which is considerably faster, as is iteration. Inserting and erasing have to shift the
+/// 		entries after them (and fix up the index), so building very large tables one key at a time (in anything
+/// 		but sorted order) gets slower.
+/// 		Tables behave the same either way, except that inserting or erasing entries invalidates
+/// 		<em>all</em> of a table's iterators (and references to its keys), not just those of the erased entries.
+/// 		References to the nodes themselves remain valid.
+/// \attention This changes the layout of toml::table, so it must be set the same way everywhere toml++ is used
+/// 		in a program; mismatches fail to link rather than misbehaving at runtime.
+
 // windows compat
 #if !defined(TOML_ENABLE_WINDOWS_COMPAT) && defined(TOML_WINDOWS_COMPAT) // was TOML_WINDOWS_COMPAT pre-3.0
 #define TOML_ENABLE_WINDOWS_COMPAT TOML_WINDOWS_COMPAT
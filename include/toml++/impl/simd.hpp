@@ -16,6 +16,18 @@
 #define TOML_HAS_SSE4_1 1
 #endif
 
+#if defined(__AVX2__)
+#define TOML_HAS_AVX2 1
+#endif
+
+// x86 compilers that can emit code for instruction sets beyond the ones enabled on the command line,
+// so kernels for newer instruction sets can be compiled in and selected at runtime based on what the CPU supports.
+// (clang-cl is excluded because its intrinsics headers only declare what's enabled on the command line)
+#if (TOML_ARCH_X86 || TOML_ARCH_AMD64) && !TOML_ICC                                                                  \
+	&& ((TOML_GCC_LIKE && !TOML_MSVC_LIKE) || (TOML_MSVC && !TOML_CLANG))
+#define TOML_SIMD_DISPATCH 1
+#endif
+
 #endif // TOML_ENABLE_SIMD
 
 #ifndef TOML_HAS_SSE2
@@ -24,12 +36,70 @@
 #ifndef TOML_HAS_SSE4_1
 #define TOML_HAS_SSE4_1 0
 #endif
+#ifndef TOML_HAS_AVX2
+#define TOML_HAS_AVX2 0
+#endif
+#ifndef TOML_SIMD_DISPATCH
+#define TOML_SIMD_DISPATCH 0
+#endif
+
+// which kernels get compiled in
+#define TOML_SSE2_KERNELS	(TOML_HAS_SSE2 || TOML_SIMD_DISPATCH)
+#define TOML_SSE4_1_KERNELS (TOML_HAS_SSE4_1 || TOML_SIMD_DISPATCH)
+#define TOML_AVX2_KERNELS	(TOML_HAS_AVX2 || TOML_SIMD_DISPATCH)
+
+// function attributes for kernels that use instruction sets beyond the ones enabled on the command line
+#if TOML_SIMD_DISPATCH && TOML_GCC_LIKE
+#define TOML_SSE2_TARGET   __attribute__((__target__("sse2")))
+#define TOML_SSE4_1_TARGET __attribute__((__target__("sse4.1")))
+#define TOML_AVX2_TARGET   __attribute__((__target__("avx2")))
+#else
+#define TOML_SSE2_TARGET
+#define TOML_SSE4_1_TARGET
+#define TOML_AVX2_TARGET
+#endif
 
 TOML_DISABLE_WARNINGS;
-#if TOML_HAS_SSE4_1
+#if TOML_SIMD_DISPATCH || TOML_HAS_AVX2
+#include <immintrin.h>
+#elif TOML_HAS_SSE4_1
 #include <smmintrin.h>
-#endif
-#if TOML_HAS_SSE2
+#elif TOML_HAS_SSE2
 #include <emmintrin.h>
 #endif
+#if TOML_MSVC_LIKE
+#include <intrin.h>
+#endif
 TOML_ENABLE_WARNINGS;
+#include "header_start.hpp"
+/// \cond
+
+TOML_IMPL_NAMESPACE_START
+{
+	// index of the lowest set bit in a (non-zero) SIMD comparison mask
+	TOML_CONST_INLINE_GETTER
+	unsigned countr_zero(uint32_t mask) noexcept
+	{
+		TOML_ASSERT_ASSUME(mask);
+
+#if TOML_GCC_LIKE || TOML_CLANG
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#elif TOML_MSVC_LIKE
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<unsigned>(index);
+#else
+		unsigned index = 0;
+		while (!(mask & 1u))
+		{
+			mask >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+}
+TOML_IMPL_NAMESPACE_END;
+
+/// \endcond
+#include "header_end.hpp"
@@ -18,7 +18,7 @@ TOML_NAMESPACE_START
 	/// \brief	A pointer to a shared string resource containing a source path.
 	using source_path_ptr = std::shared_ptr<const std::string>;
 
-	/// \brief	A source document line-and-column pair.
+	/// \brief	A source document line-and-column pair (and the byte offset they correspond to).
 	///
 	/// \detail \cpp
 	/// auto table = toml::parse_file("config.toml"sv);
@@ -38,7 +38,7 @@ TOML_NAMESPACE_START
 	/// 		 you may find that your source_positions don't match those given by a text editor
 	/// 		 (typically the line numbers will be accurate but column numbers will be too high).
 	/// 		 <strong>This is not an error.</strong> I've chosen this behaviour as a deliberate trade-off
-	/// 		 between parser complexity and correctness.
+	/// 		 between parser complexity and correctness. If you need an exact location, use the #offset.
 	struct TOML_TRIVIAL_ABI source_position
 	{
 		/// \brief The line number.
@@ -49,6 +49,25 @@ TOML_NAMESPACE_START
 		/// \remarks Valid column numbers start at 1.
 		source_index column;
 
+		/// \brief The offset of the position from the start of the document, in bytes.
+		///
+		/// \detail This makes it possible to slice the original text of a node straight out of the source
+		/// 		 (regions are half-open, so the end offset is one-past-the-end): \cpp
+		/// constexpr auto doc = "answer = 42 # the answer"sv;
+		///
+		/// auto tbl = toml::parse(doc);
+		/// auto src = tbl["answer"].node()->source();
+		/// std::cout << doc.substr(src.begin.offset, src.end.offset - src.begin.offset) << "\n";
+		/// \ecpp
+		///
+		/// \out
+		/// 42
+		/// \eout
+		///
+		/// \remarks Offsets count from the very first byte of the document (including a byte order mark, if present).
+		/// 		 They are not considered by the comparison operators; positions compare by line and column.
+		source_index offset = {};
+
 		/// \brief	Returns true if both line and column numbers are non-zero.
 		TOML_PURE_GETTER
 		explicit constexpr operator bool() const noexcept
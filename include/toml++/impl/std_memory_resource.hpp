@@ -0,0 +1,12 @@
+//# This file is a part of toml++ and is subject to the the terms of the MIT license.
+//# Copyright (c) Mark Gillard <mark.gillard@outlook.com.au>
+//# See https://github.com/marzer/tomlplusplus/blob/master/LICENSE for the full license text.
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "preprocessor.hpp"
+#if TOML_ENABLE_PMR
+TOML_DISABLE_WARNINGS;
+#include <memory_resource>
+TOML_ENABLE_WARNINGS;
+#endif
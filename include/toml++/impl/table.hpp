@@ -6,6 +6,7 @@
 
 #include "forward_declarations.hpp"
 #include "std_map.hpp"
+#include "std_vector.hpp"
 #include "std_initializer_list.hpp"
 #include "array.hpp"
 #include "make_node.hpp"
@@ -16,6 +17,352 @@
 /// \cond
 TOML_IMPL_NAMESPACE_START
 {
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
+#if TOML_ENABLE_FLAT_TABLES
+
+	// the subset of std::map's interface used by toml::table, implemented over a vector of entries kept sorted by key
+	// (see TOML_ENABLE_FLAT_TABLES). once there are enough entries for it to pay off, an open-addressing hash index
+	// of their positions sits alongside them so find() doesn't need to do a binary search.
+	class flat_table_map
+	{
+	  public:
+		using value_type = std::pair<toml::key, node_ptr>;
+#if TOML_ENABLE_PMR
+		using container_type = std::pmr::vector<value_type>;
+#else
+		using container_type = std::vector<value_type>;
+#endif
+		using allocator_type  = typename container_type::allocator_type;
+		using size_type		  = typename container_type::size_type;
+		using difference_type = typename container_type::difference_type;
+		using iterator		  = typename container_type::iterator;
+		using const_iterator  = typename container_type::const_iterator;
+
+	  private:
+		// tables smaller than this are just binary-searched
+		static constexpr size_t index_threshold = 16u;
+
+		container_type entries_;
+
+#if TOML_ENABLE_PMR
+		using slot_container = std::pmr::vector<uint32_t>;
+#else
+		using slot_container = std::vector<uint32_t>;
+#endif
+
+		// linear-probed; each slot is either 0 (empty) or the position of an entry + 1.
+		// always a power-of-two in size and at most half full, or empty if the table is below index_threshold.
+		slot_container slots_;
+
+		// (not std::lower_bound for the same reason as impl::find())
+		template <typename Iterator>
+		TOML_PURE_GETTER
+		static Iterator lower_bound(Iterator first, Iterator last, std::string_view key) noexcept
+		{
+			auto count = last - first;
+			while (count > 0)
+			{
+				const auto step = count / 2;
+				const auto mid	= first + step;
+				if (mid->first < key)
+				{
+					first = mid + 1;
+					count -= step + 1;
+				}
+				else
+					count = step;
+			}
+			return first;
+		}
+
+		// FNV-1a
+		TOML_PURE_GETTER
+		static size_t hash(std::string_view key) noexcept
+		{
+			uint64_t h = 0xcbf29ce484222325ull;
+			for (auto c : key)
+			{
+				h ^= static_cast<unsigned char>(c);
+				h *= 0x00000100000001B3ull;
+			}
+			return static_cast<size_t>(h ^ (h >> 32));
+		}
+
+		TOML_PURE_GETTER
+		size_t home_slot(size_t entry) const noexcept
+		{
+			return hash(entries_[entry].first.str()) & (slots_.size() - 1u);
+		}
+
+		void index(size_t entry) noexcept
+		{
+			const auto mask = slots_.size() - 1u;
+			auto i			= home_slot(entry);
+			while (slots_[i])
+				i = (i + 1u) & mask;
+			slots_[i] = static_cast<uint32_t>(entry + 1u);
+		}
+
+		// an empty index big enough for 'count' entries (or no index at all if that's below index_threshold).
+		// this is the only part of re-indexing that can fail, so it's done before entries_ is changed.
+		TOML_NODISCARD
+		slot_container make_index(size_t count) const
+		{
+			slot_container slots{ slots_.get_allocator() };
+			if (count >= index_threshold)
+			{
+				size_t slot_count = index_threshold * 2u;
+				while (slot_count < count * 2u)
+					slot_count *= 2u;
+				slots.assign(slot_count, 0u);
+			}
+			return slots;
+		}
+
+		void rebuild_index(slot_container& slots) noexcept
+		{
+			slots_.swap(slots);
+			if (!slots_.empty())
+			{
+				for (size_t i = 0; i < entries_.size(); i++)
+					index(i);
+			}
+		}
+
+		// called after an entry is inserted at 'entry' (when the index didn't need replacing)
+		void update_index_after_insert(size_t entry) noexcept
+		{
+			if (slots_.empty())
+				return;
+
+			// entries after the new one have all moved up a place
+			if (entry + 1u < entries_.size())
+			{
+				for (auto& slot : slots_)
+					slot += slot > entry ? 1u : 0u;
+			}
+			index(entry);
+		}
+
+		// called before the entry at 'entry' is erased
+		void update_index_before_erase(size_t entry) noexcept
+		{
+			if (slots_.empty())
+				return;
+
+			// find its slot, then shift back any later members of the same probe sequence to close the gap
+			const auto mask = slots_.size() - 1u;
+			auto hole		= home_slot(entry);
+			while (slots_[hole] != entry + 1u)
+				hole = (hole + 1u) & mask;
+			for (auto i = (hole + 1u) & mask; slots_[i]; i = (i + 1u) & mask)
+			{
+				const auto home = home_slot(slots_[i] - 1u);
+				if (((i - home) & mask) >= ((i - hole) & mask))
+				{
+					slots_[hole] = slots_[i];
+					hole		 = i;
+				}
+			}
+			slots_[hole] = 0u;
+
+			// entries after the erased one are all about to move down a place
+			for (auto& slot : slots_)
+				slot -= slot > entry + 1u ? 1u : 0u;
+		}
+
+		template <typename K, typename V>
+		iterator emplace_at(const_iterator pos, K&& key, V&& val)
+		{
+			const auto entry = static_cast<size_t>(pos - entries_.cbegin());
+			const bool grow	 = entries_.size() + 1u >= index_threshold && (entries_.size() + 1u) * 2u > slots_.size();
+			auto slots		 = grow ? make_index(entries_.size() + 1u) : slot_container{ slots_.get_allocator() };
+
+			const auto it = entries_.emplace(pos, static_cast<K&&>(key), static_cast<V&&>(val));
+			if (grow)
+				rebuild_index(slots);
+			else
+				update_index_after_insert(entry);
+			return it;
+		}
+
+		template <typename Iterator>
+		TOML_PURE_GETTER
+		static Iterator find(Iterator first,
+							 Iterator last,
+							 const uint32_t* slots,
+							 size_t slot_count,
+							 std::string_view key) noexcept
+		{
+			if (!slot_count)
+			{
+				const auto it = lower_bound(first, last, key);
+				return it != last && it->first == key ? it : last;
+			}
+
+			const auto mask = slot_count - 1u;
+			for (auto i = hash(key) & mask; slots[i]; i = (i + 1u) & mask)
+			{
+				const auto it = first + static_cast<difference_type>(slots[i] - 1u);
+				if (it->first == key)
+					return it;
+			}
+			return last;
+		}
+
+	  public:
+		TOML_NODISCARD_CTOR
+		flat_table_map() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		explicit flat_table_map(const allocator_type& alloc) noexcept //
+			: entries_{ alloc },
+			  slots_{ alloc }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		allocator_type get_allocator() const noexcept
+		{
+			return entries_.get_allocator();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		iterator begin() noexcept
+		{
+			return entries_.begin();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator begin() const noexcept
+		{
+			return entries_.begin();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator cbegin() const noexcept
+		{
+			return entries_.cbegin();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		iterator end() noexcept
+		{
+			return entries_.end();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator end() const noexcept
+		{
+			return entries_.end();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator cend() const noexcept
+		{
+			return entries_.cend();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool empty() const noexcept
+		{
+			return entries_.empty();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_type size() const noexcept
+		{
+			return entries_.size();
+		}
+
+		void clear() noexcept
+		{
+			entries_.clear();
+			slots_.clear();
+		}
+
+		TOML_NODISCARD
+		iterator lower_bound(std::string_view key) noexcept
+		{
+			return lower_bound(entries_.begin(), entries_.end(), key);
+		}
+
+		TOML_NODISCARD
+		const_iterator lower_bound(std::string_view key) const noexcept
+		{
+			return lower_bound(entries_.begin(), entries_.end(), key);
+		}
+
+		TOML_NODISCARD
+		iterator find(std::string_view key) noexcept
+		{
+			return find(entries_.begin(), entries_.end(), slots_.data(), slots_.size(), key);
+		}
+
+		TOML_NODISCARD
+		const_iterator find(std::string_view key) const noexcept
+		{
+			return find(entries_.begin(), entries_.end(), slots_.data(), slots_.size(), key);
+		}
+
+		// same semantics as std::map::emplace_hint(); a correct hint skips the search entirely
+		// (which is what makes building a table from sorted input linear)
+		template <typename K, typename V>
+		iterator emplace_hint(const_iterator hint, K&& key, V&& val)
+		{
+			const std::string_view key_view = key.str();
+			if ((hint == entries_.cend() || key_view < hint->first)
+				&& (hint == entries_.cbegin() || (hint - 1)->first < key_view))
+				return emplace_at(hint, static_cast<K&&>(key), static_cast<V&&>(val));
+
+			const auto pos = lower_bound(key_view);
+			if (pos != entries_.end() && pos->first == key_view)
+				return pos;
+			return emplace_at(pos, static_cast<K&&>(key), static_cast<V&&>(val));
+		}
+
+		template <typename V>
+		void insert_or_assign(toml::key&& key, V&& val)
+		{
+			const auto pos = lower_bound(key.str());
+			if (pos != entries_.end() && pos->first == key.str())
+				pos->second = static_cast<V&&>(val);
+			else
+				emplace_at(pos, std::move(key), static_cast<V&&>(val));
+		}
+
+		iterator erase(const_iterator pos) noexcept
+		{
+			update_index_before_erase(static_cast<size_t>(pos - entries_.cbegin()));
+			const auto it = entries_.erase(pos);
+			if (entries_.size() < index_threshold)
+				slots_.clear();
+			return it;
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			// (first and last are invalidated by the erase)
+			const bool any = first != last;
+			auto slots	   = any ? make_index(entries_.size() - static_cast<size_t>(last - first))
+							 : slot_container{ slots_.get_allocator() };
+
+			const auto it = entries_.erase(first, last);
+			if (any)
+				rebuild_index(slots);
+			return it;
+		}
+	};
+
+	using table_map = flat_table_map;
+
+#elif TOML_ENABLE_PMR
+	using table_map = std::pmr::map<toml::key, node_ptr, std::less<>>;
+#else
+	using table_map = std::map<toml::key, node_ptr, std::less<>>;
+#endif
+
 	template <bool IsConst>
 	struct table_proxy_pair
 	{
@@ -33,8 +380,8 @@ TOML_IMPL_NAMESPACE_START
 		friend class table_iterator;
 
 		using proxy_type		   = table_proxy_pair<IsConst>;
-		using mutable_map_iterator = std::map<toml::key, node_ptr, std::less<>>::iterator;
-		using const_map_iterator   = std::map<toml::key, node_ptr, std::less<>>::const_iterator;
+		using mutable_map_iterator = table_map::iterator;
+		using const_map_iterator   = table_map::const_iterator;
 		using map_iterator		   = std::conditional_t<IsConst, const_map_iterator, mutable_map_iterator>;
 
 		mutable map_iterator iter_;
@@ -91,7 +438,7 @@ TOML_IMPL_NAMESPACE_START
 		using reference			= value_type&;
 		using pointer			= value_type*;
 		using difference_type	= typename std::iterator_traits<map_iterator>::difference_type;
-		using iterator_category = typename std::iterator_traits<map_iterator>::iterator_category;
+		using iterator_category = std::bidirectional_iterator_tag;
 
 		table_iterator& operator++() noexcept // ++pre
 		{
@@ -173,6 +520,9 @@ TOML_IMPL_NAMESPACE_START
 			  value{ make_node(static_cast<V&&>(v), flags) }
 		{}
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_IMPL_NAMESPACE_END;
 /// \endcond
@@ -185,6 +535,9 @@ TOML_NAMESPACE_START
 	/// \brief A BidirectionalIterator for iterating over const key-value pairs in a toml::table.
 	using const_table_iterator = POXY_IMPLEMENTATION_DETAIL(impl::table_iterator<true>);
 
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
 	/// \brief	A TOML table.
 	///
 	/// \detail The interface of this type is modeled after std::map, with some
@@ -221,10 +574,14 @@ TOML_NAMESPACE_START
 	  private:
 		/// \cond
 
-		using map_type			 = std::map<toml::key, impl::node_ptr, std::less<>>;
-		using map_pair			 = std::pair<const toml::key, impl::node_ptr>;
+		using map_type			 = impl::table_map;
+		using map_pair			 = typename map_type::value_type;
 		using map_iterator		 = typename map_type::iterator;
 		using const_map_iterator = typename map_type::const_iterator;
+
+		template <typename>
+		friend class TOML_PARSER_TYPENAME;
+		impl::arena_ref arena_; // the arena the nodes are in, if any (declared before map_ so it outlives them)
 		map_type map_;
 
 		bool inline_ = false;
@@ -233,6 +590,17 @@ TOML_NAMESPACE_START
 		TOML_EXPORTED_MEMBER_FUNCTION
 		table(const impl::table_init_pair*, const impl::table_init_pair*);
 
+		// the resource new child nodes are allocated from (null means the global heap)
+		TOML_PURE_INLINE_GETTER
+		impl::memory_resource* node_resource() const noexcept
+		{
+#if TOML_ENABLE_PMR
+			return map_.get_allocator().resource();
+#else
+			return nullptr;
+#endif
+		}
+
 		/// \endcond
 
 	  public:
@@ -250,10 +618,60 @@ TOML_NAMESPACE_START
 		table(const table&);
 
 		/// \brief	Move constructor.
+		///
+		/// \remarks	Moving a table out of a document parsed with parse_flags::arena_allocation takes its nodes
+		/// 			along with a reference to the document's arena, which stays alive as long as either needs it.
 		TOML_NODISCARD_CTOR
 		TOML_EXPORTED_MEMBER_FUNCTION
 		table(table&& other) noexcept;
 
+#if TOML_ENABLE_PMR
+
+		/// \brief	The polymorphic allocator type used by tables.
+		///
+		/// \detail A table allocates its entries from the allocator's memory resource, as well as any tables,
+		/// 		arrays and values it creates for them (e.g. in insert(), emplace() or when being copied).
+		/// 		Child tables and arrays created this way use the same resource.
+		///
+		/// \availability This type (and the constructors that take it) are only available when
+		/// 		#TOML_ENABLE_PMR is enabled.
+		using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+		/// \brief	Constructs an empty table that allocates from the given allocator's memory resource.
+		///
+		/// \detail \cpp
+		/// std::pmr::monotonic_buffer_resource pool;
+		///
+		/// auto tbl = toml::table{ &pool };
+		/// tbl.insert("overlay", toml::table{ { "answer", 42 } }); // copied into the pool
+		/// \ecpp
+		///
+		/// \remarks The memory resource must outlive the table and every node it allocates.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit table(const allocator_type& alloc) noexcept;
+
+		/// \brief	Copy constructor that allocates the copy from the given allocator's memory resource.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		table(const table& other, const allocator_type& alloc);
+
+		/// \brief	Move constructor that allocates from the given allocator's memory resource.
+		///
+		/// \remarks If `other` uses a different memory resource its contents are copied instead of moved.
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		table(table&& other, const allocator_type& alloc);
+
+		/// \brief	Returns the table's allocator.
+		TOML_PURE_INLINE_GETTER
+		allocator_type get_allocator() const noexcept
+		{
+			return allocator_type{ map_.get_allocator().resource() };
+		}
+
+#endif
+
 		/// \brief	Constructs a table with one or more initial key-value pairs.
 		///
 		/// \detail \cpp
@@ -281,15 +699,23 @@ TOML_NAMESPACE_START
 		table& operator=(const table&);
 
 		/// \brief	Move-assignment operator.
+		///
+		/// \remarks	\parblock Moving from a table in a document parsed with parse_flags::arena_allocation takes its
+		/// 			nodes along with a reference to the document's arena (see the move constructor). `rhs` may
+		/// 			be one of this table's descendants.
+		///
+		/// 			With #TOML_ENABLE_PMR the table keeps its own allocator, so if `rhs` uses a different memory
+		/// 			resource its entries are copied instead, which can throw.
+		/// \endparblock
 		TOML_EXPORTED_MEMBER_FUNCTION
-		table& operator=(table&& rhs) noexcept;
+		table& operator=(table&& rhs) noexcept(!TOML_ENABLE_PMR);
 
 		/// \name Type checks
 		/// @{
 
 		/// \brief Returns #toml::node_type::table.
 		TOML_CONST_INLINE_GETTER
-		node_type type() const noexcept final
+		node_type type() const noexcept
 		{
 			return node_type::table;
 		}
@@ -322,14 +748,14 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `true`.
 		TOML_CONST_INLINE_GETTER
-		bool is_table() const noexcept final
+		bool is_table() const noexcept
 		{
 			return true;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_array() const noexcept final
+		bool is_array() const noexcept
 		{
 			return false;
 		}
@@ -343,63 +769,63 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_value() const noexcept final
+		bool is_value() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_string() const noexcept final
+		bool is_string() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_integer() const noexcept final
+		bool is_integer() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_floating_point() const noexcept final
+		bool is_floating_point() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_number() const noexcept final
+		bool is_number() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_boolean() const noexcept final
+		bool is_boolean() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_date() const noexcept final
+		bool is_date() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_time() const noexcept final
+		bool is_time() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_date_time() const noexcept final
+		bool is_date_time() const noexcept
 		{
 			return false;
 		}
@@ -411,126 +837,126 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns a pointer to the table.
 		TOML_CONST_INLINE_GETTER
-		table* as_table() noexcept final
+		table* as_table() noexcept
 		{
 			return this;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		array* as_array() noexcept final
+		array* as_array() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<std::string>* as_string() noexcept final
+		toml::value<std::string>* as_string() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<int64_t>* as_integer() noexcept final
+		toml::value<int64_t>* as_integer() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<double>* as_floating_point() noexcept final
+		toml::value<double>* as_floating_point() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<bool>* as_boolean() noexcept final
+		toml::value<bool>* as_boolean() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<date>* as_date() noexcept final
+		toml::value<date>* as_date() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<time>* as_time() noexcept final
+		toml::value<time>* as_time() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		toml::value<date_time>* as_date_time() noexcept final
+		toml::value<date_time>* as_date_time() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns a const-qualified pointer to the table.
 		TOML_CONST_INLINE_GETTER
-		const table* as_table() const noexcept final
+		const table* as_table() const noexcept
 		{
 			return this;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const array* as_array() const noexcept final
+		const array* as_array() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<std::string>* as_string() const noexcept final
+		const toml::value<std::string>* as_string() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<int64_t>* as_integer() const noexcept final
+		const toml::value<int64_t>* as_integer() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<double>* as_floating_point() const noexcept final
+		const toml::value<double>* as_floating_point() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<bool>* as_boolean() const noexcept final
+		const toml::value<bool>* as_boolean() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date>* as_date() const noexcept final
+		const toml::value<date>* as_date() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<time>* as_time() const noexcept final
+		const toml::value<time>* as_time() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date_time>* as_date_time() const noexcept final
+		const toml::value<date_time>* as_date_time() const noexcept
 		{
 			return nullptr;
 		}
@@ -1514,7 +1940,8 @@ TOML_NAMESPACE_START
 						{
 #endif
 							ipos->second.reset(
-								new impl::wrap_node<unwrapped_type>{ static_cast<ValueArgs&&>(args)... });
+								impl::create_node<impl::wrap_node<unwrapped_type>>(node_resource(),
+																				   static_cast<ValueArgs&&>(args)...));
 #if TOML_COMPILER_HAS_EXCEPTIONS
 						}
 						catch (...)
@@ -1615,7 +2042,7 @@ TOML_NAMESPACE_START
 				{
 					ipos = insert_with_hint(const_iterator{ ipos },
 											toml::key{ static_cast<KeyType&&>(key) },
-											impl::make_node(static_cast<ValueType&&>(val), flags));
+											impl::make_node(static_cast<ValueType&&>(val), flags, node_resource()));
 					return { iterator{ ipos }, true };
 				}
 				return { iterator{ ipos }, false };
@@ -1762,12 +2189,12 @@ TOML_NAMESPACE_START
 				{
 					ipos = insert_with_hint(const_iterator{ ipos },
 											toml::key{ static_cast<KeyType&&>(key) },
-											impl::make_node(static_cast<ValueType&&>(val), flags));
+											impl::make_node(static_cast<ValueType&&>(val), flags, node_resource()));
 					return { iterator{ ipos }, true };
 				}
 				else
 				{
-					(*ipos).second = impl::make_node(static_cast<ValueType&&>(val), flags);
+					(*ipos).second = impl::make_node(static_cast<ValueType&&>(val), flags, node_resource());
 					return { iterator{ ipos }, false };
 				}
 			}
@@ -1844,10 +2271,11 @@ TOML_NAMESPACE_START
 				auto ipos			= get_lower_bound(key_view);
 				if (ipos == map_.end() || ipos->first != key_view)
 				{
-					ipos = insert_with_hint(
-						const_iterator{ ipos },
-						toml::key{ static_cast<KeyType&&>(key) },
-						impl::node_ptr{ new impl::wrap_node<unwrapped_type>{ static_cast<ValueArgs&&>(args)... } });
+					ipos = insert_with_hint(const_iterator{ ipos },
+											toml::key{ static_cast<KeyType&&>(key) },
+											impl::node_ptr{ impl::create_node<impl::wrap_node<unwrapped_type>>(
+												node_resource(),
+												static_cast<ValueArgs&&>(args)...) });
 					return { iterator{ ipos }, true };
 				}
 				return { iterator{ ipos }, false };
@@ -1992,6 +2420,9 @@ TOML_NAMESPACE_START
 
 #endif
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_NAMESPACE_END;
 
@@ -18,7 +18,8 @@
 TOML_NAMESPACE_START
 {
 	TOML_EXTERNAL_LINKAGE
-	table::table() noexcept
+	table::table() noexcept //
+		: node(node_type::table)
 	{
 #if TOML_LIFETIME_HOOKS
 		TOML_TABLE_CREATED;
@@ -34,7 +35,8 @@ TOML_NAMESPACE_START
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	table::table(const impl::table_init_pair* b, const impl::table_init_pair* e)
+	table::table(const impl::table_init_pair* b, const impl::table_init_pair* e) //
+		: node(node_type::table)
 	{
 #if TOML_LIFETIME_HOOKS
 		TOML_TABLE_CREATED;
@@ -62,7 +64,7 @@ TOML_NAMESPACE_START
 		  inline_{ other.inline_ }
 	{
 		for (auto&& [k, v] : other.map_)
-			map_.emplace_hint(map_.end(), k, impl::make_node(*v));
+			map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
 
 #if TOML_LIFETIME_HOOKS
 		TOML_TABLE_CREATED;
@@ -72,14 +74,66 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	table::table(table && other) noexcept //
 		: node(std::move(other)),
+		  arena_{ std::move(other.arena_) },
 		  map_{ std::move(other.map_) },
 		  inline_{ other.inline_ }
 	{
+#if TOML_LIFETIME_HOOKS
+		TOML_TABLE_CREATED;
+#endif
+	}
+
+#if TOML_ENABLE_PMR
+
+	TOML_EXTERNAL_LINKAGE
+	table::table(const allocator_type& alloc) noexcept //
+		: node(node_type::table),
+		  map_{ alloc }
+	{
+#if TOML_LIFETIME_HOOKS
+		TOML_TABLE_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	table::table(const table& other, const allocator_type& alloc) //
+		: node(other),
+		  map_{ alloc },
+		  inline_{ other.inline_ }
+	{
+		for (auto&& [k, v] : other.map_)
+			map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
+
 #if TOML_LIFETIME_HOOKS
 		TOML_TABLE_CREATED;
 #endif
 	}
 
+	TOML_EXTERNAL_LINKAGE
+	table::table(table && other, const allocator_type& alloc) //
+		: node(std::move(other)),
+		  map_{ alloc },
+		  inline_{ other.inline_ }
+	{
+		if (other.map_.get_allocator() == map_.get_allocator())
+		{
+			arena_ = std::move(other.arena_);
+			map_   = std::move(other.map_);
+		}
+		else
+		{
+			for (auto&& [k, v] : other.map_)
+				map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
+			other.clear();
+		}
+
+#if TOML_LIFETIME_HOOKS
+		TOML_TABLE_CREATED;
+#endif
+	}
+
+#endif // TOML_ENABLE_PMR
+
 	TOML_EXTERNAL_LINKAGE
 	table& table::operator=(const table& rhs)
 	{
@@ -88,20 +142,32 @@ TOML_NAMESPACE_START
 			node::operator=(rhs);
 			map_.clear();
 			for (auto&& [k, v] : rhs.map_)
-				map_.emplace_hint(map_.end(), k, impl::make_node(*v));
+				map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
 			inline_ = rhs.inline_;
+			arena_.reset(); // (after map_, since the old nodes may have been in it)
 		}
 		return *this;
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	table& table::operator=(table&& rhs) noexcept
+	table& table::operator=(table&& rhs) noexcept(!TOML_ENABLE_PMR)
 	{
 		if (&rhs != this)
 		{
+#if TOML_ENABLE_PMR
+			// the table keeps its own allocator, so entries from a different memory resource get copied
+			if (rhs.map_.get_allocator() != map_.get_allocator())
+				return *this = table{ std::move(rhs), get_allocator() };
+#endif
+
+			// rhs might be one of the nodes about to be released, so everything's taken from it first
+			auto arena = std::move(rhs.arena_);
+			auto map   = std::move(rhs.map_);
 			node::operator=(std::move(rhs));
-			map_	= std::move(rhs.map_);
 			inline_ = rhs.inline_;
+
+			map_   = std::move(map);
+			arena_ = std::move(arena); // after map_, since the old nodes may have been in the old arena
 		}
 		return *this;
 	}
@@ -276,6 +342,7 @@ TOML_NAMESPACE_START
 	void table::clear() noexcept
 	{
 		map_.clear();
+		arena_.reset();
 	}
 
 	TOML_EXTERNAL_LINKAGE
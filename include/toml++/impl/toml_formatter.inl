@@ -62,7 +62,7 @@ TOML_ANON_NAMESPACE_START
 			{
 				// todo: proper utf8 decoding?
 				// todo: tab awareness?
-				auto& str = (*reinterpret_cast<const value<std::string>*>(&node)).get();
+				const auto str = (*reinterpret_cast<const value<std::string>*>(&node)).view();
 				return str.length() + 2u; // + ""
 			}
 
@@ -187,9 +187,47 @@ TOML_IMPL_NAMESPACE_START
 		}
 	};
 
+	// instruction sets the bulk-scanning functions below can be run with.
+	enum class simd_tier : uint8_t
+	{
+		scalar,
+		sse2,
+		sse4_1,
+		avx2
+	};
+
+	// the tier the bulk-scanning functions are using;
+	// by default this is the best one both compiled in and supported by the CPU, detected on first use.
+	// (not a pure function; it changes with force_simd_tier())
+	TOML_NODISCARD
+	simd_tier active_simd_tier() noexcept;
+
+	// switches the bulk-scanning functions to the given tier (or the best one available, if lower),
+	// returning the tier actually selected. Not thread-safe; intended for testing.
+	simd_tier force_simd_tier(simd_tier tier) noexcept;
+
 	TOML_PURE_GETTER
 	TOML_ATTR(nonnull)
 	bool is_ascii(const char* str, size_t len) noexcept;
+
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	size_t ascii_prefix_length(const char* str, size_t len) noexcept;
+
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	bool is_valid_utf8(const char* str, size_t len) noexcept;
+
+	// length of the leading run of spaces and tabs.
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	size_t horizontal_whitespace_prefix_length(const char* str, size_t len) noexcept;
+
+	// length of the leading run of printable ASCII characters (or TABs) that aren't one of the two given characters;
+	// i.e. the characters in string values and comments that need no special handling by the parser.
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	size_t plain_string_prefix_length(const char* str, size_t len, char special1, char special2) noexcept;
 }
 TOML_IMPL_NAMESPACE_END;
 
@@ -15,44 +15,742 @@
 #include "simd.hpp"
 #include "header_start.hpp"
 
-TOML_IMPL_NAMESPACE_START
+TOML_ANON_NAMESPACE_START
 {
+	//------------------------------------------------------------------------------------------------------------------
+	// scalar
+	//------------------------------------------------------------------------------------------------------------------
+
 	TOML_PURE_GETTER
-	TOML_EXTERNAL_LINKAGE
-	bool is_ascii(const char* str, size_t len) noexcept
+	TOML_INTERNAL_LINKAGE
+	bool is_ascii_scalar(const char* str, size_t len) noexcept
+	{
+		for (const char* const end = str + len; str < end; str++)
+			if (static_cast<unsigned char>(*str) > 127u)
+				return false;
+
+		return true;
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t ascii_prefix_length_scalar(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		for (const char* const end = str + len; str < end; str++)
+			if (static_cast<unsigned char>(*str) > 127u)
+				break;
+
+		return static_cast<size_t>(str - begin);
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	bool is_valid_utf8_scalar(const char* str, size_t len) noexcept
 	{
 		const char* const end = str + len;
 
-#if TOML_HAS_SSE2 && (128 % CHAR_BIT) == 0
+		impl::utf8_decoder decoder;
+		while (str < end)
 		{
-			constexpr size_t chars_per_vector = 128u / CHAR_BIT;
-
-			if (const size_t simdable = len - (len % chars_per_vector))
+			if (decoder.has_code_point())
 			{
-				__m128i mask = _mm_setzero_si128();
-				for (const char* const e = str + simdable; str < e; str += chars_per_vector)
-				{
-					const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
-					mask						= _mm_or_si128(mask, current_bytes);
-				}
-				const __m128i has_error = _mm_cmpgt_epi8(_mm_setzero_si128(), mask);
-
-#if TOML_HAS_SSE4_1
-				if (!_mm_testz_si128(has_error, has_error))
-					return false;
-#else
-				if (_mm_movemask_epi8(_mm_cmpeq_epi8(has_error, _mm_setzero_si128())) != 0xFFFF)
-					return false;
+				str += ascii_prefix_length_scalar(str, static_cast<size_t>(end - str));
+				if (str == end)
+					break;
+			}
+
+			decoder(*str++);
+			if (decoder.error())
+				return false;
+		}
+		return decoder.has_code_point();
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t horizontal_whitespace_prefix_length_scalar(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		for (const char* const end = str + len; str < end; str++)
+			if (*str != ' ' && *str != '\t')
+				break;
+
+		return static_cast<size_t>(str - begin);
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t plain_string_prefix_length_scalar(const char* str, size_t len, char special1, char special2) noexcept
+	{
+		const char* const begin = str;
+		for (const char* const end = str + len; str < end; str++)
+		{
+			const auto c = static_cast<unsigned char>(*str);
+			if ((c < 32u && c != '\t') || c >= 127u || *str == special1 || *str == special2)
+				break;
+		}
+
+		return static_cast<size_t>(str - begin);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// SSE2
+	//------------------------------------------------------------------------------------------------------------------
+
+#if TOML_SSE2_KERNELS
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	bool is_ascii_sse2(const char* str, size_t len) noexcept
+	{
+		const char* const end = str + len;
+
+		__m128i mask = _mm_setzero_si128();
+		for (; end - str >= 16; str += 16)
+			mask = _mm_or_si128(mask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(str)));
+		if (_mm_movemask_epi8(mask))
+			return false;
+
+		return is_ascii_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	size_t ascii_prefix_length_sse2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
+
+		for (; end - str >= 16; str += 16)
+		{
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			if (const auto high_bits = static_cast<uint32_t>(_mm_movemask_epi8(current_bytes)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(high_bits);
+		}
+
+		return static_cast<size_t>(str - begin) + ascii_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	size_t horizontal_whitespace_prefix_length_sse2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
+
+		const __m128i spaces = _mm_set1_epi8(' ');
+		const __m128i tabs	 = _mm_set1_epi8('\t');
+
+		for (; end - str >= 16; str += 16)
+		{
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			const __m128i whitespace =
+				_mm_or_si128(_mm_cmpeq_epi8(current_bytes, spaces), _mm_cmpeq_epi8(current_bytes, tabs));
+
+			if (const auto other_bits = static_cast<uint32_t>(~_mm_movemask_epi8(whitespace)) & 0xFFFFu)
+				return static_cast<size_t>(str - begin) + impl::countr_zero(other_bits);
+		}
+
+		return static_cast<size_t>(str - begin)
+			 + horizontal_whitespace_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	size_t plain_string_prefix_length_sse2(const char* str, size_t len, char special1, char special2) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
+
+		const __m128i specials1 = _mm_set1_epi8(special1);
+		const __m128i specials2 = _mm_set1_epi8(special2);
+		const __m128i spaces	= _mm_set1_epi8(' ');
+		const __m128i tabs		= _mm_set1_epi8('\t');
+		const __m128i deletes	= _mm_set1_epi8('\x7F');
+
+		for (; end - str >= 16; str += 16)
+		{
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+
+			// (signed comparison, so this catches control characters and non-ASCII bytes in one go)
+			__m128i special =
+				_mm_andnot_si128(_mm_cmpeq_epi8(current_bytes, tabs), _mm_cmplt_epi8(current_bytes, spaces));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, deletes));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, specials1));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, specials2));
+
+			if (const auto special_bits = static_cast<uint32_t>(_mm_movemask_epi8(special)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(special_bits);
+		}
+
+		return static_cast<size_t>(str - begin)
+			 + plain_string_prefix_length_scalar(str, static_cast<size_t>(end - str), special1, special2);
+	}
+
+#endif // TOML_SSE2_KERNELS
+
+#if TOML_SSE4_1_KERNELS || TOML_AVX2_KERNELS
+
+	// lookup tables for "Validating UTF-8 In Less Than One Instruction Per Byte" (John Keiser, Daniel Lemire)
+	// https://arxiv.org/abs/2010.03090
+	struct utf8_validation_tables
+	{
+		static constexpr uint8_t too_short		= 1u << 0;
+		static constexpr uint8_t too_long		= 1u << 1;
+		static constexpr uint8_t overlong_3		= 1u << 2;
+		static constexpr uint8_t too_large		= 1u << 3;
+		static constexpr uint8_t surrogate		= 1u << 4;
+		static constexpr uint8_t overlong_2		= 1u << 5;
+		static constexpr uint8_t too_large_1000 = 1u << 6;
+		static constexpr uint8_t overlong_4		= 1u << 6;
+		static constexpr uint8_t two_conts		= 1u << 7;
+		static constexpr uint8_t carry			= too_short | too_long | two_conts;
+
+		// indexed by the high nibble of the first byte of each pair
+		static constexpr uint8_t byte_1_high[16] = {
+			// 0_______ (ASCII)
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			// 10______ (continuation)
+			two_conts,
+			two_conts,
+			two_conts,
+			two_conts,
+			// 1100____ (two byte lead)
+			too_short | overlong_2,
+			// 1101____ (two byte lead)
+			too_short,
+			// 1110____ (three byte lead)
+			too_short | overlong_3 | surrogate,
+			// 1111____ (four+ byte lead)
+			too_short | too_large | too_large_1000 | overlong_4
+		};
+
+		// indexed by the low nibble of the first byte of each pair
+		static constexpr uint8_t byte_1_low[16] = {
+			carry | overlong_3 | overlong_2 | overlong_4, // ____0000
+			carry | overlong_2,							  // ____0001
+			carry,										  // ____001_
+			carry,										  //
+			carry | too_large,							  // ____0100
+			carry | too_large | too_large_1000,			  // ____0101
+			carry | too_large | too_large_1000,			  // ____011_
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  // ____1___
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000 | surrogate, // ____1101
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000			  //
+		};
+
+		// indexed by the high nibble of the second byte of each pair
+		static constexpr uint8_t byte_2_high[16] = {
+			// 0_______ (ASCII)
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			// 1000____
+			too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+			// 1001____
+			too_long | overlong_2 | two_conts | overlong_3 | too_large,
+			// 101_____
+			too_long | overlong_2 | two_conts | surrogate | too_large,
+			too_long | overlong_2 | two_conts | surrogate | too_large,
+			// 11______
+			too_short,
+			too_short,
+			too_short,
+			too_short
+		};
+
+		// the last 1, 2 or 3 bytes of a block can't be leads of 2, 3 or 4 byte sequences
+		// (SSE uses the last 16 bytes)
+		static constexpr uint8_t incomplete_limits[32] = {
+			0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+			0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+			0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xF0u - 1u, 0xE0u - 1u, 0xC0u - 1u
+		};
+	};
+
 #endif
+
+	//------------------------------------------------------------------------------------------------------------------
+	// SSE4.1
+	//------------------------------------------------------------------------------------------------------------------
+
+#if TOML_SSE4_1_KERNELS
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE4_1_TARGET
+	bool is_valid_utf8_sse4_1(const char* str, size_t len) noexcept
+	{
+		using tables			 = utf8_validation_tables;
+		const char* const end	 = str + len;
+		const auto load_table	 = [](const uint8_t* table) noexcept
+		{ return reinterpret_cast<const __m128i*>(table); };
+
+		const __m128i byte_1_high_table = _mm_loadu_si128(load_table(tables::byte_1_high));
+		const __m128i byte_1_low_table	= _mm_loadu_si128(load_table(tables::byte_1_low));
+		const __m128i byte_2_high_table = _mm_loadu_si128(load_table(tables::byte_2_high));
+		const __m128i incomplete_limits = _mm_loadu_si128(load_table(tables::incomplete_limits + 16));
+		const __m128i low_nibbles		= _mm_set1_epi8(0x0F);
+
+		__m128i errors			= _mm_setzero_si128();
+		__m128i prev_input		= _mm_setzero_si128();
+		__m128i prev_incomplete = _mm_setzero_si128();
+
+		char tail[16] = {};
+		while (str < end)
+		{
+			// pad the tail out with zeros (ASCII) so the last block can be checked the same way
+			const char* block = str;
+			if (end - str >= 16)
+				str += 16;
+			else
+			{
+				std::memcpy(tail, str, static_cast<size_t>(end - str));
+				block = tail;
+				str	  = end;
+			}
+
+			const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+
+			// pure ASCII; only an error if the previous block ended mid-sequence
+			if (!_mm_movemask_epi8(input))
+			{
+				errors	   = _mm_or_si128(errors, prev_incomplete);
+				prev_input = input;
+				continue;
 			}
+
+			const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+			const __m128i byte_1_high =
+				_mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibbles));
+			const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, low_nibbles));
+			const __m128i byte_2_high =
+				_mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibbles));
+			const __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+			const __m128i prev2			 = _mm_alignr_epi8(input, prev_input, 14);
+			const __m128i prev3			 = _mm_alignr_epi8(input, prev_input, 13);
+			const __m128i is_third_byte	 = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0u - 0x80u)));
+			const __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0u - 0x80u)));
+			const __m128i must_be_2_3_continuation =
+				_mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80u)));
+
+			errors			= _mm_or_si128(errors, _mm_xor_si128(must_be_2_3_continuation, special_cases));
+			prev_incomplete = _mm_subs_epu8(input, incomplete_limits);
+			prev_input		= input;
+		}
+		errors = _mm_or_si128(errors, prev_incomplete);
+
+		return _mm_testz_si128(errors, errors);
+	}
+
+#endif // TOML_SSE4_1_KERNELS
+
+	//------------------------------------------------------------------------------------------------------------------
+	// AVX2
+	//------------------------------------------------------------------------------------------------------------------
+
+#if TOML_AVX2_KERNELS
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	bool is_ascii_avx2(const char* str, size_t len) noexcept
+	{
+		const char* const end = str + len;
+
+		__m256i mask = _mm256_setzero_si256();
+		for (; end - str >= 32; str += 32)
+			mask = _mm256_or_si256(mask, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str)));
+		if (_mm256_movemask_epi8(mask))
+			return false;
+
+		return is_ascii_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	size_t ascii_prefix_length_avx2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
+
+		for (; end - str >= 32; str += 32)
+		{
+			const __m256i current_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+			if (const auto high_bits = static_cast<uint32_t>(_mm256_movemask_epi8(current_bytes)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(high_bits);
 		}
+
+		// short runs are common enough that it's worth finishing with a half-width step
+		if (end - str >= 16)
+		{
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			if (const auto high_bits = static_cast<uint32_t>(_mm_movemask_epi8(current_bytes)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(high_bits);
+			str += 16;
+		}
+
+		return static_cast<size_t>(str - begin) + ascii_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	bool is_valid_utf8_avx2(const char* str, size_t len) noexcept
+	{
+		using tables			 = utf8_validation_tables;
+		const char* const end	 = str + len;
+		const auto load_table	 = [](const uint8_t* table) noexcept
+		{ return reinterpret_cast<const __m128i*>(table); };
+
+		// (the shuffles work within each 128-bit lane, so the 16-byte tables are just repeated)
+		const __m256i byte_1_high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(load_table(tables::byte_1_high)));
+		const __m256i byte_1_low_table	= _mm256_broadcastsi128_si256(_mm_loadu_si128(load_table(tables::byte_1_low)));
+		const __m256i byte_2_high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(load_table(tables::byte_2_high)));
+		const __m256i incomplete_limits =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables::incomplete_limits));
+		const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+
+		__m256i errors			= _mm256_setzero_si256();
+		__m256i prev_input		= _mm256_setzero_si256();
+		__m256i prev_incomplete = _mm256_setzero_si256();
+
+		char tail[32] = {};
+		while (str < end)
+		{
+			// pad the tail out with zeros (ASCII) so the last block can be checked the same way
+			const char* block = str;
+			if (end - str >= 32)
+				str += 32;
+			else
+			{
+				std::memcpy(tail, str, static_cast<size_t>(end - str));
+				block = tail;
+				str	  = end;
+			}
+
+			const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+
+			// pure ASCII; only an error if the previous block ended mid-sequence
+			if (!_mm256_movemask_epi8(input))
+			{
+				errors	   = _mm256_or_si256(errors, prev_incomplete);
+				prev_input = input;
+				continue;
+			}
+
+			// (alignr works within each 128-bit lane, so the lanes need stitching together first)
+			const __m256i prev_straddle = _mm256_permute2x128_si256(prev_input, input, 0x21);
+
+			const __m256i prev1 = _mm256_alignr_epi8(input, prev_straddle, 15);
+			const __m256i byte_1_high =
+				_mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibbles));
+			const __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibbles));
+			const __m256i byte_2_high =
+				_mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibbles));
+			const __m256i special_cases =
+				_mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+			const __m256i prev2 = _mm256_alignr_epi8(input, prev_straddle, 14);
+			const __m256i prev3 = _mm256_alignr_epi8(input, prev_straddle, 13);
+			const __m256i is_third_byte =
+				_mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0u - 0x80u)));
+			const __m256i is_fourth_byte =
+				_mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0u - 0x80u)));
+			const __m256i must_be_2_3_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+																	  _mm256_set1_epi8(static_cast<char>(0x80u)));
+
+			errors = _mm256_or_si256(errors, _mm256_xor_si256(must_be_2_3_continuation, special_cases));
+			prev_incomplete = _mm256_subs_epu8(input, incomplete_limits);
+			prev_input		= input;
+		}
+		errors = _mm256_or_si256(errors, prev_incomplete);
+
+		return _mm256_testz_si256(errors, errors);
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	size_t horizontal_whitespace_prefix_length_avx2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
+
+		const __m256i spaces = _mm256_set1_epi8(' ');
+		const __m256i tabs	 = _mm256_set1_epi8('\t');
+
+		for (; end - str >= 32; str += 32)
+		{
+			const __m256i current_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+			const __m256i whitespace =
+				_mm256_or_si256(_mm256_cmpeq_epi8(current_bytes, spaces), _mm256_cmpeq_epi8(current_bytes, tabs));
+
+			if (const auto other_bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(whitespace)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(other_bits);
+		}
+
+		if (end - str >= 16)
+		{
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			const __m128i whitespace	= _mm_or_si128(_mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(spaces)),
+													   _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(tabs)));
+
+			if (const auto other_bits = static_cast<uint32_t>(~_mm_movemask_epi8(whitespace)) & 0xFFFFu)
+				return static_cast<size_t>(str - begin) + impl::countr_zero(other_bits);
+			str += 16;
+		}
+
+		return static_cast<size_t>(str - begin)
+			 + horizontal_whitespace_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	size_t plain_string_prefix_length_avx2(const char* str, size_t len, char special1, char special2) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
+
+		const __m256i specials1 = _mm256_set1_epi8(special1);
+		const __m256i specials2 = _mm256_set1_epi8(special2);
+		const __m256i spaces	= _mm256_set1_epi8(' ');
+		const __m256i tabs		= _mm256_set1_epi8('\t');
+		const __m256i deletes	= _mm256_set1_epi8('\x7F');
+
+		for (; end - str >= 32; str += 32)
+		{
+			const __m256i current_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+
+			// (signed comparison, so this catches control characters and non-ASCII bytes in one go)
+			__m256i special = _mm256_andnot_si256(_mm256_cmpeq_epi8(current_bytes, tabs),
+												  _mm256_cmpgt_epi8(spaces, current_bytes));
+			special			= _mm256_or_si256(special, _mm256_cmpeq_epi8(current_bytes, deletes));
+			special			= _mm256_or_si256(special, _mm256_cmpeq_epi8(current_bytes, specials1));
+			special			= _mm256_or_si256(special, _mm256_cmpeq_epi8(current_bytes, specials2));
+
+			if (const auto special_bits = static_cast<uint32_t>(_mm256_movemask_epi8(special)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(special_bits);
+		}
+
+		if (end - str >= 16)
+		{
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+
+			__m128i special = _mm_andnot_si128(_mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(tabs)),
+											   _mm_cmplt_epi8(current_bytes, _mm256_castsi256_si128(spaces)));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(deletes)));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(specials1)));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(specials2)));
+
+			if (const auto special_bits = static_cast<uint32_t>(_mm_movemask_epi8(special)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(special_bits);
+			str += 16;
+		}
+
+		return static_cast<size_t>(str - begin)
+			 + plain_string_prefix_length_scalar(str, static_cast<size_t>(end - str), special1, special2);
+	}
+
+#endif // TOML_AVX2_KERNELS
+
+	//------------------------------------------------------------------------------------------------------------------
+	// dispatch
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct simd_kernels
+	{
+		impl::simd_tier tier;
+		bool (*is_ascii)(const char*, size_t) noexcept;
+		size_t (*ascii_prefix_length)(const char*, size_t) noexcept;
+		bool (*is_valid_utf8)(const char*, size_t) noexcept;
+		size_t (*horizontal_whitespace_prefix_length)(const char*, size_t) noexcept;
+		size_t (*plain_string_prefix_length)(const char*, size_t, char, char) noexcept;
+	};
+
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	simd_kernels simd_kernels_for(impl::simd_tier tier) noexcept
+	{
+		switch (tier)
+		{
+#if TOML_AVX2_KERNELS
+			case impl::simd_tier::avx2:
+				return { impl::simd_tier::avx2,
+						 is_ascii_avx2,
+						 ascii_prefix_length_avx2,
+						 is_valid_utf8_avx2,
+						 horizontal_whitespace_prefix_length_avx2,
+						 plain_string_prefix_length_avx2 };
 #endif
+#if TOML_SSE4_1_KERNELS
+			case impl::simd_tier::sse4_1:
+				return { impl::simd_tier::sse4_1,
+						 is_ascii_sse2,
+						 ascii_prefix_length_sse2,
+						 is_valid_utf8_sse4_1,
+						 horizontal_whitespace_prefix_length_sse2,
+						 plain_string_prefix_length_sse2 };
+#endif
+#if TOML_SSE2_KERNELS
+			case impl::simd_tier::sse2:
+				return { impl::simd_tier::sse2,
+						 is_ascii_sse2,
+						 ascii_prefix_length_sse2,
+						 is_valid_utf8_scalar,
+						 horizontal_whitespace_prefix_length_sse2,
+						 plain_string_prefix_length_sse2 };
+#endif
+			default:
+				return { impl::simd_tier::scalar,
+						 is_ascii_scalar,
+						 ascii_prefix_length_scalar,
+						 is_valid_utf8_scalar,
+						 horizontal_whitespace_prefix_length_scalar,
+						 plain_string_prefix_length_scalar };
+		}
+	}
 
-		for (; str < end; str++)
-			if (static_cast<unsigned char>(*str) > 127u)
-				return false;
+	// the best tier that's both compiled in and supported by the CPU we're running on.
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	impl::simd_tier detect_simd_tier() noexcept
+	{
+#if TOML_SIMD_DISPATCH && TOML_GCC_LIKE
 
-		return true;
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return impl::simd_tier::avx2;
+		if (__builtin_cpu_supports("sse4.1"))
+			return impl::simd_tier::sse4_1;
+		if (__builtin_cpu_supports("sse2"))
+			return impl::simd_tier::sse2;
+		return impl::simd_tier::scalar;
+
+#elif TOML_SIMD_DISPATCH && TOML_MSVC
+
+		int info[4];
+		__cpuid(info, 0);
+		const int max_leaf = info[0];
+
+		__cpuid(info, 1);
+		const bool sse2	  = (info[3] & (1 << 26)) != 0;
+		const bool sse4_1 = (info[2] & (1 << 19)) != 0;
+
+		// AVX2 also needs the OS to be preserving the upper halves of the YMM registers (OSXSAVE + AVX + XCR0)
+		const bool ymm_enabled =
+			(info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6u) == 0x6u;
+		if (max_leaf >= 7 && ymm_enabled)
+		{
+			__cpuidex(info, 7, 0);
+			if (info[1] & (1 << 5))
+				return impl::simd_tier::avx2;
+		}
+		if (sse4_1)
+			return impl::simd_tier::sse4_1;
+		if (sse2)
+			return impl::simd_tier::sse2;
+		return impl::simd_tier::scalar;
+
+#else
+
+		return TOML_HAS_AVX2	 ? impl::simd_tier::avx2
+			 : TOML_HAS_SSE4_1 ? impl::simd_tier::sse4_1
+			 : TOML_HAS_SSE2   ? impl::simd_tier::sse2
+							   : impl::simd_tier::scalar;
+
+#endif
+	}
+
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	simd_kernels& active_simd_kernels() noexcept
+	{
+		static simd_kernels kernels = simd_kernels_for(detect_simd_tier());
+		return kernels;
+	}
+}
+TOML_ANON_NAMESPACE_END;
+
+TOML_IMPL_NAMESPACE_START
+{
+	TOML_NODISCARD
+	TOML_EXTERNAL_LINKAGE
+	simd_tier active_simd_tier() noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().tier;
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	simd_tier force_simd_tier(simd_tier tier) noexcept
+	{
+		const auto supported = TOML_ANON_NAMESPACE::detect_simd_tier();
+		if (tier > supported)
+			tier = supported;
+
+		TOML_ANON_NAMESPACE::active_simd_kernels() = TOML_ANON_NAMESPACE::simd_kernels_for(tier);
+		return tier;
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	bool is_ascii(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().is_ascii(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	size_t ascii_prefix_length(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().ascii_prefix_length(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	bool is_valid_utf8(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().is_valid_utf8(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	size_t horizontal_whitespace_prefix_length(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().horizontal_whitespace_prefix_length(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	size_t plain_string_prefix_length(const char* str, size_t len, char special1, char special2) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().plain_string_prefix_length(str, len, special1, special2);
 	}
 }
 TOML_IMPL_NAMESPACE_END;
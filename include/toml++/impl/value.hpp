@@ -8,6 +8,7 @@
 #include "node.hpp"
 #include "print_to_stream.hpp"
 #include "std_utility.hpp"
+#include "std_atomic.hpp"
 #include "header_start.hpp"
 TOML_DISABLE_ARITHMETIC_WARNINGS;
 
@@ -164,6 +165,65 @@ TOML_IMPL_NAMESPACE_START
 
 #endif // TOML_HAS_CHAR8 || TOML_ENABLE_WINDOWS_COMPAT
 
+	// the text of a string value borrowed from the source document or its arena (see parse_flags::borrowed_strings
+	// and arena_allocation).
+	// shares storage with the value's std::string, so it's empty for every other type of value.
+	template <typename T>
+	struct borrowed_text
+	{};
+
+	template <>
+	struct borrowed_text<std::string>
+	{
+		std::string_view text;
+		mutable std::atomic<std::string*> copy = {}; // made the first time something needs a std::string
+
+		TOML_NODISCARD_CTOR
+		explicit borrowed_text(std::string_view txt) noexcept //
+			: text{ txt }
+		{}
+
+		TOML_NODISCARD_CTOR
+		borrowed_text(borrowed_text&& other) noexcept //
+			: text{ other.text },
+			  copy{ other.copy.exchange(nullptr, std::memory_order_relaxed) }
+		{}
+
+		borrowed_text(const borrowed_text&)			   = delete;
+		borrowed_text& operator=(const borrowed_text&) = delete;
+		borrowed_text& operator=(borrowed_text&&)	   = delete;
+
+		~borrowed_text() noexcept
+		{
+			delete copy.load(std::memory_order_relaxed);
+		}
+
+		TOML_NODISCARD
+		std::string_view view() const noexcept
+		{
+			if (const auto str = copy.load(std::memory_order_acquire))
+				return *str;
+			return text;
+		}
+
+		// const member functions of values can get here, so other threads may be racing to make the copy too
+		TOML_NODISCARD
+		std::string& get() const
+		{
+			auto str = copy.load(std::memory_order_acquire);
+			if (!str)
+			{
+				auto fresh = new std::string{ text };
+				if (copy.compare_exchange_strong(str, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+					str = fresh;
+				else
+					delete fresh;
+			}
+			return *str;
+		}
+	};
+	static_assert(sizeof(borrowed_text<std::string>) <= sizeof(std::string));
+
 	template <typename T>
 	TOML_CONST_GETTER
 	inline optional<T> node_integer_cast(int64_t val) noexcept
@@ -226,6 +286,7 @@ TOML_NAMESPACE_START
 	  private:
 		/// \cond
 
+		template <typename>
 		friend class TOML_PARSER_TYPENAME;
 
 		template <typename T, typename U>
@@ -238,8 +299,131 @@ TOML_NAMESPACE_START
 				return nullptr;
 		}
 
-		ValueType val_;
+		union
+		{
+			ValueType val_;
+			impl::borrowed_text<ValueType> borrowed_; // used instead of val_ when is_borrowed_ is set
+		};
 		value_flags flags_ = value_flags::none;
+		bool is_borrowed_  = false; // only set by the parser (see parse_flags::borrowed_strings and arena_allocation)
+		bool in_arena_	   = false; // borrowed_ is text in a document's arena, which the value holds a reference to
+
+		static constexpr bool access_is_nothrow = !std::is_same_v<ValueType, std::string>;
+
+		// a string's text is only reached through these, which are kept out of line so that inlining node::value<T>()
+		// etc. for a value of some other (smaller) type never has the compiler following a path into is_borrowed_ and
+		// borrowed_ (which lie past the end of it) and warning about the access
+		TOML_NEVER_INLINE
+		std::string& string_val() const
+		{
+			if TOML_UNLIKELY(is_borrowed_)
+				return borrowed_.get();
+			return const_cast<std::string&>(val_);
+		}
+
+		TOML_NEVER_INLINE
+		std::string_view string_view_val() const noexcept
+		{
+			return is_borrowed_ ? borrowed_.view() : std::string_view{ val_ };
+		}
+
+		// the stored value (a borrowed string is copied the first time it's needed as a std::string)
+		TOML_ALWAYS_INLINE
+		ValueType& val() noexcept(access_is_nothrow)
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+				return string_val();
+			else
+				return val_;
+		}
+
+		TOML_ALWAYS_INLINE
+		const ValueType& val() const noexcept(access_is_nothrow)
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+				return string_val();
+			else
+				return val_;
+		}
+
+		// the stored value, or a view of a string's text (without copying a borrowed one)
+		TOML_PURE_INLINE_GETTER
+		decltype(auto) val_view() const noexcept
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+				return string_view_val();
+			else
+				return (val_);
+		}
+
+		// refers to text owned by something else: the source document, or a document's arena (text from
+		// node_arena::copy_string(), in which case the value keeps the arena alive until it's done with it)
+		void borrow(std::string_view text, bool in_arena = false) noexcept
+		{
+			static_assert(std::is_same_v<ValueType, std::string>);
+			TOML_ASSERT(!is_borrowed_);
+
+			val_.~basic_string();
+			::new (static_cast<void*>(&borrowed_)) impl::borrowed_text<std::string>{ text };
+			is_borrowed_ = true;
+			if (in_arena)
+			{
+				static_cast<void>(impl::arena_ref{ impl::node_arena::of(text) }.detach());
+				in_arena_ = true;
+			}
+		}
+
+		void destroy_borrowed() noexcept
+		{
+			const auto arena = in_arena_ ? impl::node_arena::of(borrowed_.text) : nullptr;
+			borrowed_.~borrowed_text();
+			is_borrowed_ = false;
+			in_arena_	 = false;
+			impl::arena_ref::adopt(arena).reset();
+		}
+
+		// replaces a borrowed string with one the value owns
+		void own(std::string&& str) noexcept
+		{
+			static_assert(std::is_same_v<ValueType, std::string>);
+			TOML_ASSERT(is_borrowed_);
+
+			std::string owned{ std::move(str) }; // str might belong to borrowed_
+			destroy_borrowed();
+			::new (static_cast<void*>(&val_)) std::string{ std::move(owned) };
+		}
+
+		// constructs val_ (or borrowed_) from another value's (for the move constructors)
+		void take_val(value& other) noexcept
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+			{
+				if (other.is_borrowed_)
+				{
+					// (along with the reference to the arena, if the text is in one)
+					::new (static_cast<void*>(&borrowed_))
+						impl::borrowed_text<std::string>{ std::move(other.borrowed_) };
+					is_borrowed_		 = true;
+					in_arena_			 = std::exchange(other.in_arena_, false);
+					other.borrowed_.text = {};
+					return;
+				}
+			}
+			::new (static_cast<void*>(&val_)) ValueType{ std::move(other.val_) };
+		}
+
+		void destroy_val() noexcept
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+			{
+				if (is_borrowed_)
+				{
+					destroy_borrowed();
+					return;
+				}
+			}
+			val_.~ValueType();
+		}
 
 		/// \endcond
 
@@ -268,7 +452,8 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		explicit value(Args&&... args) noexcept(noexcept(value_type(
 			impl::native_value_maker<value_type, std::decay_t<Args>...>::make(static_cast<Args&&>(args)...))))
-			: val_(impl::native_value_maker<value_type, std::decay_t<Args>...>::make(static_cast<Args&&>(args)...))
+			: node(impl::node_type_of<value_type>),
+			  val_(impl::native_value_maker<value_type, std::decay_t<Args>...>::make(static_cast<Args&&>(args)...))
 		{
 #if TOML_LIFETIME_HOOKS
 			TOML_VALUE_CREATED;
@@ -279,7 +464,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(const value& other) noexcept //
 			: node(other),
-			  val_{ other.val_ },
+			  val_(other.val_view()),
 			  flags_{ other.flags_ }
 		{
 #if TOML_LIFETIME_HOOKS
@@ -291,7 +476,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(const value& other, value_flags flags) noexcept //
 			: node(other),
-			  val_{ other.val_ },
+			  val_(other.val_view()),
 			  flags_{ flags == preserve_source_value_flags ? other.flags_ : flags }
 		{
 #if TOML_LIFETIME_HOOKS
@@ -303,9 +488,9 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(value&& other) noexcept //
 			: node(std::move(other)),
-			  val_{ std::move(other.val_) },
 			  flags_{ std::exchange(other.flags_, value_flags{}) }
 		{
+			take_val(other);
 #if TOML_LIFETIME_HOOKS
 			TOML_VALUE_CREATED;
 #endif
@@ -315,9 +500,9 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(value&& other, value_flags flags) noexcept //
 			: node(std::move(other)),
-			  val_{ std::move(other.val_) },
 			  flags_{ flags == preserve_source_value_flags ? other.flags_ : flags }
 		{
+			take_val(other);
 #if TOML_LIFETIME_HOOKS
 			TOML_VALUE_CREATED;
 #endif
@@ -328,8 +513,19 @@ TOML_NAMESPACE_START
 		value& operator=(const value& rhs) noexcept
 		{
 			node::operator=(rhs);
-			val_   = rhs.val_;
-			flags_ = rhs.flags_;
+			if (&rhs != this)
+			{
+				if constexpr (std::is_same_v<value_type, std::string>)
+				{
+					if (is_borrowed_)
+						own(std::string{ rhs.val_view() });
+					else
+						val_ = rhs.val_view();
+				}
+				else
+					val_ = rhs.val_;
+				flags_ = rhs.flags_;
+			}
 			return *this;
 		}
 
@@ -339,18 +535,20 @@ TOML_NAMESPACE_START
 			if (&rhs != this)
 			{
 				node::operator=(std::move(rhs));
-				val_   = std::move(rhs.val_);
+				destroy_val();
+				take_val(rhs);
 				flags_ = std::exchange(rhs.flags_, value_flags{});
 			}
 			return *this;
 		}
 
-#if TOML_LIFETIME_HOOKS
 		~value() noexcept
 		{
+#if TOML_LIFETIME_HOOKS
 			TOML_VALUE_DESTROYED;
-		}
 #endif
+			destroy_val();
+		}
 
 		/// \name Type checks
 		/// @{
@@ -366,7 +564,7 @@ TOML_NAMESPACE_START
 		/// 			- node_type::time
 		/// 			- node_type::date_time
 		TOML_CONST_INLINE_GETTER
-		node_type type() const noexcept final
+		node_type type() const noexcept
 		{
 			return impl::node_type_of<value_type>;
 		}
@@ -418,14 +616,14 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_table() const noexcept final
+		bool is_table() const noexcept
 		{
 			return false;
 		}
 
 		/// \brief Returns `false`.
 		TOML_CONST_INLINE_GETTER
-		bool is_array() const noexcept final
+		bool is_array() const noexcept
 		{
 			return false;
 		}
@@ -439,63 +637,63 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `true`.
 		TOML_CONST_INLINE_GETTER
-		bool is_value() const noexcept final
+		bool is_value() const noexcept
 		{
 			return true;
 		}
 
 		/// \brief Returns `true` if the #value_type is std::string.
 		TOML_CONST_INLINE_GETTER
-		bool is_string() const noexcept final
+		bool is_string() const noexcept
 		{
 			return std::is_same_v<value_type, std::string>;
 		}
 
 		/// \brief Returns `true` if the #value_type is int64_t.
 		TOML_CONST_INLINE_GETTER
-		bool is_integer() const noexcept final
+		bool is_integer() const noexcept
 		{
 			return std::is_same_v<value_type, int64_t>;
 		}
 
 		/// \brief Returns `true` if the #value_type is `double`.
 		TOML_CONST_INLINE_GETTER
-		bool is_floating_point() const noexcept final
+		bool is_floating_point() const noexcept
 		{
 			return std::is_same_v<value_type, double>;
 		}
 
 		/// \brief Returns `true` if the #value_type is int64_t or `double`.
 		TOML_CONST_INLINE_GETTER
-		bool is_number() const noexcept final
+		bool is_number() const noexcept
 		{
 			return impl::is_one_of<value_type, int64_t, double>;
 		}
 
 		/// \brief Returns `true` if the #value_type is `bool`.
 		TOML_CONST_INLINE_GETTER
-		bool is_boolean() const noexcept final
+		bool is_boolean() const noexcept
 		{
 			return std::is_same_v<value_type, bool>;
 		}
 
 		/// \brief Returns `true` if the #value_type is toml::date.
 		TOML_CONST_INLINE_GETTER
-		bool is_date() const noexcept final
+		bool is_date() const noexcept
 		{
 			return std::is_same_v<value_type, date>;
 		}
 
 		/// \brief Returns `true` if the #value_type is toml::time.
 		TOML_CONST_INLINE_GETTER
-		bool is_time() const noexcept final
+		bool is_time() const noexcept
 		{
 			return std::is_same_v<value_type, time>;
 		}
 
 		/// \brief Returns `true` if the #value_type is toml_date_time.
 		TOML_CONST_INLINE_GETTER
-		bool is_date_time() const noexcept final
+		bool is_date_time() const noexcept
 		{
 			return std::is_same_v<value_type, date_time>;
 		}
@@ -507,126 +705,126 @@ TOML_NAMESPACE_START
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		table* as_table() noexcept final
+		table* as_table() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		array* as_array() noexcept final
+		array* as_array() noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns a pointer to the value if it is a value<std::string>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		value<std::string>* as_string() noexcept final
+		value<std::string>* as_string() noexcept
 		{
 			return as_value<std::string>(this);
 		}
 
 		/// \brief Returns a pointer to the value if it is a value<int64_t>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		value<int64_t>* as_integer() noexcept final
+		value<int64_t>* as_integer() noexcept
 		{
 			return as_value<int64_t>(this);
 		}
 
 		/// \brief Returns a pointer to the value if it is a value<double>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		value<double>* as_floating_point() noexcept final
+		value<double>* as_floating_point() noexcept
 		{
 			return as_value<double>(this);
 		}
 
 		/// \brief Returns a pointer to the value if it is a value<bool>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		value<bool>* as_boolean() noexcept final
+		value<bool>* as_boolean() noexcept
 		{
 			return as_value<bool>(this);
 		}
 
 		/// \brief Returns a pointer to the value if it is a value<date>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		value<date>* as_date() noexcept final
+		value<date>* as_date() noexcept
 		{
 			return as_value<date>(this);
 		}
 
 		/// \brief Returns a pointer to the value if it is a value<time>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		value<time>* as_time() noexcept final
+		value<time>* as_time() noexcept
 		{
 			return as_value<time>(this);
 		}
 
 		/// \brief Returns a pointer to the value if it is a value<date_time>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		value<date_time>* as_date_time() noexcept final
+		value<date_time>* as_date_time() noexcept
 		{
 			return as_value<date_time>(this);
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const table* as_table() const noexcept final
+		const table* as_table() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const array* as_array() const noexcept final
+		const array* as_array() const noexcept
 		{
 			return nullptr;
 		}
 
 		/// \brief Returns a const-qualified pointer to the value if it is a value<std::string>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const value<std::string>* as_string() const noexcept final
+		const value<std::string>* as_string() const noexcept
 		{
 			return as_value<std::string>(this);
 		}
 
 		/// \brief Returns a const-qualified pointer to the value if it is a value<int64_t>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const value<int64_t>* as_integer() const noexcept final
+		const value<int64_t>* as_integer() const noexcept
 		{
 			return as_value<int64_t>(this);
 		}
 
 		/// \brief Returns a const-qualified pointer to the value if it is a value<double>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const value<double>* as_floating_point() const noexcept final
+		const value<double>* as_floating_point() const noexcept
 		{
 			return as_value<double>(this);
 		}
 
 		/// \brief Returns a const-qualified pointer to the value if it is a value<bool>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const value<bool>* as_boolean() const noexcept final
+		const value<bool>* as_boolean() const noexcept
 		{
 			return as_value<bool>(this);
 		}
 
 		/// \brief Returns a const-qualified pointer to the value if it is a value<date>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const value<date>* as_date() const noexcept final
+		const value<date>* as_date() const noexcept
 		{
 			return as_value<date>(this);
 		}
 
 		/// \brief Returns a const-qualified pointer to the value if it is a value<time>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const value<time>* as_time() const noexcept final
+		const value<time>* as_time() const noexcept
 		{
 			return as_value<time>(this);
 		}
 
 		/// \brief Returns a const-qualified pointer to the value if it is a value<date_time>, otherwise `nullptr`.
 		TOML_CONST_INLINE_GETTER
-		const value<date_time>* as_date_time() const noexcept final
+		const value<date_time>* as_date_time() const noexcept
 		{
 			return as_value<date_time>(this);
 		}
@@ -638,86 +836,86 @@ TOML_NAMESPACE_START
 
 		/// \brief	Returns a reference to the underlying value.
 		TOML_PURE_INLINE_GETTER
-		value_type& get() & noexcept
+		value_type& get() & noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		/// \brief	Returns a reference to the underlying value (rvalue overload).
 		TOML_PURE_INLINE_GETTER
-		value_type&& get() && noexcept
+		value_type&& get() && noexcept(access_is_nothrow)
 		{
-			return static_cast<value_type&&>(val_);
+			return static_cast<value_type&&>(val());
 		}
 
 		/// \brief	Returns a reference to the underlying value (const overload).
 		TOML_PURE_INLINE_GETTER
-		const value_type& get() const& noexcept
+		const value_type& get() const& noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		/// \brief	Returns a reference to the underlying value (const rvalue overload).
 		TOML_PURE_INLINE_GETTER
-		const value_type&& get() const&& noexcept
+		const value_type&& get() const&& noexcept(access_is_nothrow)
 		{
-			return static_cast<const value_type&&>(val_);
+			return static_cast<const value_type&&>(val());
 		}
 
 		/// \brief	Returns a reference to the underlying value.
 		TOML_PURE_INLINE_GETTER
-		value_type& operator*() & noexcept
+		value_type& operator*() & noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		/// \brief	Returns a reference to the underlying value (rvalue overload).
 		TOML_PURE_INLINE_GETTER
-		value_type&& operator*() && noexcept
+		value_type&& operator*() && noexcept(access_is_nothrow)
 		{
-			return static_cast<value_type&&>(val_);
+			return static_cast<value_type&&>(val());
 		}
 
 		/// \brief	Returns a reference to the underlying value (const overload).
 		TOML_PURE_INLINE_GETTER
-		const value_type& operator*() const& noexcept
+		const value_type& operator*() const& noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		/// \brief	Returns a reference to the underlying value (const rvalue overload).
 		TOML_PURE_INLINE_GETTER
-		const value_type&& operator*() const&& noexcept
+		const value_type&& operator*() const&& noexcept(access_is_nothrow)
 		{
-			return static_cast<const value_type&&>(val_);
+			return static_cast<const value_type&&>(val());
 		}
 
 		/// \brief	Returns a reference to the underlying value.
 		TOML_PURE_INLINE_GETTER
-		explicit operator value_type&() & noexcept
+		explicit operator value_type&() & noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		/// \brief	Returns a reference to the underlying value (rvalue overload).
 		TOML_PURE_INLINE_GETTER
-		explicit operator value_type&&() && noexcept
+		explicit operator value_type&&() && noexcept(access_is_nothrow)
 		{
-			return static_cast<value_type&&>(val_);
+			return static_cast<value_type&&>(val());
 		}
 
 		/// \brief	Returns a reference to the underlying value (const overload).
 		TOML_PURE_INLINE_GETTER
-		explicit operator const value_type&() const& noexcept
+		explicit operator const value_type&() const& noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		/// \brief	Returns a reference to the underlying value (const rvalue overload).
 		TOML_PURE_INLINE_GETTER
-		explicit operator const value_type&&() && noexcept
+		explicit operator const value_type&&() && noexcept(access_is_nothrow)
 		{
-			return static_cast<const value_type&&>(val_);
+			return static_cast<const value_type&&>(val());
 		}
 
 		/// \brief	Returns a pointer to the underlying value.
@@ -725,9 +923,9 @@ TOML_NAMESPACE_START
 		/// \availability This operator is only available when #value_type is a class/struct.
 		TOML_HIDDEN_CONSTRAINT(std::is_class_v<T>, typename T = value_type)
 		TOML_PURE_INLINE_GETTER
-		value_type* operator->() noexcept
+		value_type* operator->() noexcept(access_is_nothrow)
 		{
-			return &val_;
+			return &val();
 		}
 
 		/// \brief	Returns a pointer to the underlying value (const overload).
@@ -735,9 +933,22 @@ TOML_NAMESPACE_START
 		/// \availability This operator is only available when #value_type is a class/struct.
 		TOML_HIDDEN_CONSTRAINT(std::is_class_v<T>, typename T = value_type)
 		TOML_PURE_INLINE_GETTER
-		const value_type* operator->() const noexcept
+		const value_type* operator->() const noexcept(access_is_nothrow)
 		{
-			return &val_;
+			return &val();
+		}
+
+		/// \brief	Returns a view of the underlying string.
+		///
+		/// \detail Unlike get(), this never copies a string borrowed from the source document
+		/// 		(see parse_flags::borrowed_strings); the view points into the document instead.
+		///
+		/// \availability This function is only available when #value_type is std::string.
+		TOML_HIDDEN_CONSTRAINT((std::is_same_v<T, std::string>), typename T = value_type)
+		TOML_PURE_INLINE_GETTER
+		std::string_view view() const noexcept
+		{
+			return val_view();
 		}
 
 		/// @}
@@ -766,7 +977,12 @@ TOML_NAMESPACE_START
 		value& operator=(value_arg rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, std::string>)
-				val_.assign(rhs);
+			{
+				if TOML_UNLIKELY(is_borrowed_)
+					own(std::string{ rhs });
+				else
+					val_.assign(rhs);
+			}
 			else
 				val_ = rhs;
 			return *this;
@@ -775,7 +991,10 @@ TOML_NAMESPACE_START
 		TOML_CONSTRAINED_TEMPLATE((std::is_same_v<T, std::string>), typename T = value_type)
 		value& operator=(std::string&& rhs) noexcept
 		{
-			val_ = std::move(rhs);
+			if TOML_UNLIKELY(is_borrowed_)
+				own(std::move(rhs));
+			else
+				val_ = std::move(rhs);
 			return *this;
 		}
 
@@ -788,14 +1007,14 @@ TOML_NAMESPACE_START
 		{
 			if constexpr (std::is_same_v<value_type, double>)
 			{
-				const auto lhs_nan = impl::fpclassify(lhs.val_) == impl::fp_class::nan;
+				const auto lhs_nan = impl::fpclassify(lhs.val_view()) == impl::fp_class::nan;
 				const auto rhs_nan = impl::fpclassify(rhs) == impl::fp_class::nan;
 				if (lhs_nan != rhs_nan)
 					return false;
 				if (lhs_nan)
 					return true;
 			}
-			return lhs.val_ == rhs;
+			return lhs.val_view() == rhs;
 		}
 		TOML_ASYMMETRICAL_EQUALITY_OPS(const value&, value_arg, );
 
@@ -803,56 +1022,56 @@ TOML_NAMESPACE_START
 		TOML_PURE_GETTER
 		friend bool operator<(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ < rhs;
+			return lhs.val_view() < rhs;
 		}
 
 		/// \brief	Value less-than operator.
 		TOML_PURE_GETTER
 		friend bool operator<(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs < rhs.val_;
+			return lhs < rhs.val_view();
 		}
 
 		/// \brief	Value less-than-or-equal-to operator.
 		TOML_PURE_GETTER
 		friend bool operator<=(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ <= rhs;
+			return lhs.val_view() <= rhs;
 		}
 
 		/// \brief	Value less-than-or-equal-to operator.
 		TOML_PURE_GETTER
 		friend bool operator<=(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs <= rhs.val_;
+			return lhs <= rhs.val_view();
 		}
 
 		/// \brief	Value greater-than operator.
 		TOML_PURE_GETTER
 		friend bool operator>(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ > rhs;
+			return lhs.val_view() > rhs;
 		}
 
 		/// \brief	Value greater-than operator.
 		TOML_PURE_GETTER
 		friend bool operator>(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs > rhs.val_;
+			return lhs > rhs.val_view();
 		}
 
 		/// \brief	Value greater-than-or-equal-to operator.
 		TOML_PURE_GETTER
 		friend bool operator>=(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ >= rhs;
+			return lhs.val_view() >= rhs;
 		}
 
 		/// \brief	Value greater-than-or-equal-to operator.
 		TOML_PURE_GETTER
 		friend bool operator>=(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs >= rhs.val_;
+			return lhs >= rhs.val_view();
 		}
 
 		/// \brief	Equality operator.
@@ -866,7 +1085,7 @@ TOML_NAMESPACE_START
 		friend bool operator==(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs == rhs.val_; // calls asymmetrical value-equality operator defined above
+				return lhs == rhs.val_view(); // calls asymmetrical value-equality operator defined above
 			else
 				return false;
 		}
@@ -898,7 +1117,7 @@ TOML_NAMESPACE_START
 		friend bool operator<(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ < rhs.val_;
+				return lhs.val_view() < rhs.val_view();
 			else
 				return impl::node_type_of<value_type> < impl::node_type_of<T>;
 		}
@@ -917,7 +1136,7 @@ TOML_NAMESPACE_START
 		friend bool operator<=(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ <= rhs.val_;
+				return lhs.val_view() <= rhs.val_view();
 			else
 				return impl::node_type_of<value_type> <= impl::node_type_of<T>;
 		}
@@ -936,7 +1155,7 @@ TOML_NAMESPACE_START
 		friend bool operator>(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ > rhs.val_;
+				return lhs.val_view() > rhs.val_view();
 			else
 				return impl::node_type_of<value_type> > impl::node_type_of<T>;
 		}
@@ -955,7 +1174,7 @@ TOML_NAMESPACE_START
 		friend bool operator>=(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ >= rhs.val_;
+				return lhs.val_view() >= rhs.val_view();
 			else
 				return impl::node_type_of<value_type> >= impl::node_type_of<T>;
 		}
@@ -983,6 +1202,11 @@ TOML_NAMESPACE_START
 	template <typename T>
 	value(T, value_flags) -> value<impl::native_type_of<impl::remove_cvref<T>>>;
 
+	// the node's type is only checked at runtime (see node::type()), so once this has been inlined into node::value<T>()
+	// GCC can see paths that read a bigger value type than the one actually constructed, and warns about them
+	TOML_PUSH_WARNINGS;
+	TOML_PRAGMA_GCC(diagnostic ignored "-Warray-bounds")
+
 	template <typename T>
 	TOML_NODISCARD
 	inline decltype(auto) node::get_value_exact() const noexcept(impl::value_retrieval_is_nothrow<T>)
@@ -996,13 +1220,13 @@ TOML_NAMESPACE_START
 		static_assert(!is_cvref<T>);
 		TOML_ASSERT(this->type() == node_type_of<T>);
 
-		if constexpr (node_type_of<T> == node_type::string)
+		if constexpr (std::is_same_v<T, std::string_view>)
+			return ref_cast<std::string>().view(); // doesn't copy strings borrowed from the source document
+		else if constexpr (node_type_of<T> == node_type::string)
 		{
 			const auto& str = *ref_cast<std::string>();
 			if constexpr (std::is_same_v<T, std::string>)
 				return str;
-			else if constexpr (std::is_same_v<T, std::string_view>)
-				return T{ str };
 			else if constexpr (std::is_same_v<T, const char*>)
 				return str.c_str();
 
@@ -1031,6 +1255,8 @@ TOML_NAMESPACE_START
 			return static_cast<T>(*ref_cast<native_type_of<T>>());
 	}
 
+	TOML_POP_WARNINGS;
+
 	template <typename T>
 	TOML_NODISCARD
 	inline optional<T> node::value_exact() const noexcept(impl::value_retrieval_is_nothrow<T>)
@@ -23,14 +23,15 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void yaml_formatter::print_yaml_string(const value<std::string>& str)
 	{
-		if (str->empty())
+		const auto text = str.view();
+		if (text.empty())
 		{
 			base::print(str);
 			return;
 		}
 
 		bool contains_newline = false;
-		for (auto c = str->c_str(), e = str->c_str() + str->length(); c < e && !contains_newline; c++)
+		for (auto c = text.data(), e = text.data() + text.length(); c < e && !contains_newline; c++)
 			contains_newline = *c == '\n';
 
 		if (contains_newline)
@@ -39,8 +40,8 @@ TOML_NAMESPACE_START
 
 			increase_indent();
 
-			auto line_end  = str->c_str() - 1u;
-			const auto end = str->c_str() + str->length();
+			auto line_end  = text.data() - 1u;
+			const auto end = text.data() + text.length();
 			while (line_end != end)
 			{
 				auto line_start = line_end + 1u;
@@ -59,7 +60,7 @@ TOML_NAMESPACE_START
 			decrease_indent();
 		}
 		else
-			print_string(*str, false, true);
+			print_string(text, false, true);
 	}
 
 	TOML_EXTERNAL_LINKAGE
@@ -49,6 +49,7 @@ TOML_PRAGMA_CLANG(diagnostic ignored "-Wreserved-identifier")
 #include "impl/table.hpp"
 #include "impl/unicode_autogenerated.hpp"
 #include "impl/unicode.hpp"
+#include "impl/float_parsing.hpp"
 #include "impl/parse_error.hpp"
 #include "impl/parse_result.hpp"
 #include "impl/parser.hpp"
@@ -67,6 +68,7 @@ TOML_PRAGMA_CLANG(diagnostic ignored "-Wreserved-identifier")
 #include "impl/array.inl"
 #include "impl/table.inl"
 #include "impl/unicode.inl"
+#include "impl/float_parsing.inl"
 #include "impl/parser.inl"
 #include "impl/formatter.inl"
 #include "impl/toml_formatter.inl"
@@ -101,6 +103,8 @@ TOML_POP_WARNINGS;
 #undef TOML_ASSUME
 #undef TOML_ASYMMETRICAL_EQUALITY_OPS
 #undef TOML_ATTR
+#undef TOML_AVX2_KERNELS
+#undef TOML_AVX2_TARGET
 #undef TOML_CLANG
 #undef TOML_CLANG_VERSION
 #undef TOML_CLOSED_ENUM
@@ -148,6 +152,7 @@ TOML_POP_WARNINGS;
 #undef TOML_HAS_CUSTOM_OPTIONAL_TYPE
 #undef TOML_HAS_FEATURE
 #undef TOML_HAS_INCLUDE
+#undef TOML_HAS_AVX2
 #undef TOML_HAS_SSE2
 #undef TOML_HAS_SSE4_1
 #undef TOML_HIDDEN_CONSTRAINT
@@ -218,7 +223,12 @@ TOML_POP_WARNINGS;
 #undef TOML_SA_VALUE_MESSAGE_CONST_CHAR8
 #undef TOML_SA_VALUE_MESSAGE_U8STRING_VIEW
 #undef TOML_SA_VALUE_MESSAGE_WSTRING
+#undef TOML_SIMD_DISPATCH
 #undef TOML_SIMPLE_STATIC_ASSERT_MESSAGES
+#undef TOML_SSE2_KERNELS
+#undef TOML_SSE2_TARGET
+#undef TOML_SSE4_1_KERNELS
+#undef TOML_SSE4_1_TARGET
 #undef TOML_TRIVIAL_ABI
 #undef TOML_UINT128
 #undef TOML_UNIX
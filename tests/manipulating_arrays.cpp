@@ -627,3 +627,211 @@ TEST_CASE("arrays - for_each")
 
 #endif
 }
+
+TEST_CASE("arrays - packed")
+{
+	static constexpr auto doc = R"(
+		ints = [ 1, 2, 3, 4 ]
+		floats = [ 1.5, -2.0, nan ]
+		bools = [ true, false ]
+		hex = [ 0x10, 2 ]
+		mixed = [ 1, 'two', 3 ]
+		nested = [ [ 1, 2 ], [ 3.0 ] ]
+		empty = []
+	)"sv;
+
+	for (auto flags : { parse_flags::packed_arrays, parse_flags::packed_arrays | parse_flags::arena_allocation })
+	{
+		table tbl	   = parse_or_fail(doc, ""sv, flags);
+		table unpacked = parse_or_fail(doc);
+		CHECK(tbl == unpacked);
+
+		// only homogeneous decimal integer, float and boolean arrays are packed
+		CHECK(tbl["ints"].as_array()->is_packed());
+		CHECK(tbl["floats"].as_array()->is_packed());
+		CHECK(tbl["bools"].as_array()->is_packed());
+		CHECK(!tbl["hex"].as_array()->is_packed());
+		CHECK(!tbl["mixed"].as_array()->is_packed());
+		CHECK(!tbl["nested"].as_array()->is_packed());
+		CHECK(tbl["nested"][0].as_array()->is_packed());
+		CHECK(tbl["nested"][1].as_array()->is_packed());
+		CHECK(!tbl["empty"].as_array()->is_packed());
+
+		const array& ints = *tbl["ints"].as_array();
+		CHECK(ints.size() == 4u);
+		CHECK(ints.is_homogeneous(node_type::integer));
+		CHECK(ints.packed<double>().empty());
+		const auto span = ints.packed<int64_t>();
+		REQUIRE(span.size() == 4u);
+		CHECK(span[0] == 1);
+		CHECK(span[3] == 4);
+		int64_t sum = 0;
+		for (auto val : span)
+			sum += val;
+		CHECK(sum == 10);
+
+		// const node access keeps the values packed (and, like all element access, is noexcept)
+		static_assert(noexcept(ints[2]) && noexcept(ints.back()) && noexcept(ints.begin()));
+		static_assert(noexcept(std::declval<array&>().erase(ints.begin())));
+		CHECK(ints[2].value<int64_t>() == 3);
+		CHECK(ints.back().value<int64_t>() == 4);
+		CHECK(ints.is_packed());
+		CHECK(ints.packed<int64_t>().data() == span.data());
+
+		const auto floats = tbl["floats"].as_array()->packed<double>();
+		REQUIRE(floats.size() == 3u);
+		CHECK(floats[1] == -2.0);
+		CHECK(impl::fpclassify(floats[2]) == impl::fp_class::nan);
+		CHECK(tbl["bools"].as_array()->packed<bool>()[0]);
+
+		// copies stay packed
+		array copy = ints;
+		CHECK(copy.is_packed());
+		CHECK(copy == ints);
+		CHECK(copy == *unpacked["ints"].as_array());
+		CHECK(*unpacked["ints"].as_array() == copy);
+
+		// appending a value of the same type keeps the array packed; anything else unpacks it
+		copy.push_back(5);
+		CHECK(copy.is_packed());
+		CHECK(copy.packed<int64_t>().size() == 5u);
+		copy.pop_back();
+		copy.truncate(3);
+		CHECK(copy.is_packed());
+		CHECK(copy.size() == 3u);
+		CHECK(copy == array{ 1, 2, 3 });
+		copy.push_back("four"sv);
+		CHECK(!copy.is_packed());
+		CHECK(copy == array{ 1, 2, 3, "four"sv });
+
+		// non-const node access unpacks
+		array& floats_arr = *tbl["floats"].as_array();
+		floats_arr[0].ref<double>() = 2.5;
+		CHECK(!floats_arr.is_packed());
+		CHECK(floats_arr.packed<double>().empty());
+		CHECK(floats_arr.size() == 3u);
+		CHECK(floats_arr[0].value<double>() == 2.5);
+
+		// moves take the packed values along
+		array moved = std::move(*tbl["bools"].as_array());
+		CHECK(moved.is_packed());
+		CHECK(moved == array{ true, false });
+		moved.clear();
+		CHECK(!moved.is_packed());
+		CHECK(moved.empty());
+	}
+
+	// arrays built by hand can be packed explicitly
+	array arr{ 1, 2, 3 };
+	CHECK(!arr.is_packed());
+	CHECK(arr.pack());
+	CHECK(arr.is_packed());
+	CHECK(arr == array{ 1, 2, 3 });
+	CHECK(arr.packed<int64_t>().size() == 3u);
+
+	// resizing goes by the packed values' size
+	array resized{ 1, 2, 3, 4, 5 };
+	CHECK(resized.pack());
+	resized.resize(3, 0);
+	CHECK(resized.size() == 3u);
+	CHECK(resized == array{ 1, 2, 3 });
+	resized.resize(5, 0);
+	CHECK(resized.size() == 5u);
+	CHECK(resized == array{ 1, 2, 3, 0, 0 });
+
+	CHECK(!array{}.pack());
+	CHECK(!array{ 1, 2.0 }.pack());
+	CHECK(!array{ "a"sv, "b"sv }.pack());
+	array flagged{ 1, 2 };
+	flagged[0].as_integer()->flags(value_flags::format_as_hexadecimal);
+	CHECK(!flagged.pack());
+}
+
+TEST_CASE("arrays - compact")
+{
+	static constexpr auto doc = R"(
+		ints = [ 1, 2, 3 ]
+		numbers = [ 1, 2.5, true, 4 ]
+		dates = [ 1979-05-27, 1979-05-28 ]
+		times = [ 1979-05-27T07:32:00Z, 1979-05-27T00:32:00-07:00, 1979-05-27T00:32:00.999999, 07:32:00 ]
+		hex = [ 1, 0x10 ]
+		strings = [ 1, 'two' ]
+		nested = [ [ 1, 1979-05-27 ], [] ]
+	)"sv;
+
+	for (auto flags : { parse_flags::compact_arrays, parse_flags::compact_arrays | parse_flags::arena_allocation })
+	{
+		table tbl	   = parse_or_fail(doc, ""sv, flags);
+		table unpacked = parse_or_fail(doc);
+		CHECK(tbl == unpacked);
+
+		CHECK(tbl["ints"].as_array()->is_packed());
+		CHECK(tbl["ints"].as_array()->packed<int64_t>().size() == 3u);
+		CHECK(tbl["numbers"].as_array()->is_packed());
+		CHECK(tbl["dates"].as_array()->is_packed());
+		CHECK(tbl["times"].as_array()->is_packed());
+		CHECK(!tbl["hex"].as_array()->is_packed());
+		CHECK(!tbl["strings"].as_array()->is_packed());
+		CHECK(!tbl["nested"].as_array()->is_packed());
+		CHECK(tbl["nested"][0].as_array()->is_packed());
+
+		// compact arrays don't have a contiguous view
+		const array& numbers = *tbl["numbers"].as_array();
+		CHECK(numbers.packed<int64_t>().empty());
+		CHECK(numbers.packed<double>().empty());
+		CHECK(numbers.size() == 4u);
+		CHECK(!numbers.is_homogeneous());
+		CHECK(numbers.is_homogeneous(node_type::none) == unpacked["numbers"].as_array()->is_homogeneous());
+
+		const array& dates = *tbl["dates"].as_array();
+		CHECK(dates.is_homogeneous(node_type::date));
+		CHECK(!dates.is_homogeneous(node_type::integer));
+
+		// copies stay compact
+		array copy = *tbl["times"].as_array();
+		CHECK(copy.is_packed());
+
+		// const node access keeps the array compact, but the values themselves are swapped for the nodes
+		CHECK(numbers[1].value<double>() == 2.5);
+		CHECK(numbers[2].value<bool>() == true);
+		CHECK(dates[1].value<date>() == date{ 1979, 5, 28 });
+		const array& times = *tbl["times"].as_array();
+		CHECK(times[0].value<date_time>() == date_time{ { 1979, 5, 27 }, { 7, 32 }, {} });
+		CHECK(times[1].value<date_time>() == date_time{ { 1979, 5, 27 }, { 0, 32 }, { -7, 0 } });
+		CHECK(times[2].value<date_time>() == date_time{ { 1979, 5, 27 }, { 0, 32, 0, 999999000u } });
+		CHECK(times[3].value<toml::time>() == toml::time{ 7, 32 });
+		CHECK(numbers.is_packed());
+		CHECK(times.is_packed());
+
+		CHECK(copy == times);
+		CHECK(copy == *unpacked["times"].as_array());
+		CHECK(times == *unpacked["times"].as_array());
+		CHECK(dates.is_homogeneous(node_type::date));
+		CHECK(!numbers.is_homogeneous());
+
+		// ...so copying or moving the array from there on takes the nodes
+		array node_copy = times;
+		CHECK(!node_copy.is_packed());
+		CHECK(node_copy == times);
+		array moved = std::move(*tbl["dates"].as_array());
+		CHECK(!moved.is_packed());
+		CHECK(moved == *unpacked["dates"].as_array());
+
+		// non-const access expands them into nodes
+		copy[3].ref<toml::time>() = toml::time{ 8, 0 };
+		CHECK(!copy.is_packed());
+		CHECK(copy.size() == 4u);
+		CHECK(copy != times);
+		CHECK(copy[3].value<toml::time>() == toml::time{ 8, 0 });
+	}
+
+	// packed_arrays alone doesn't store mixed arrays compactly
+#if TOML_EXCEPTIONS
+	const table tbl = toml::parse(doc, ""sv, parse_flags::packed_arrays);
+#else
+	const table tbl = std::move(toml::parse(doc, ""sv, parse_flags::packed_arrays)).table();
+#endif
+	CHECK(tbl["ints"].as_array()->is_packed());
+	CHECK(!tbl["numbers"].as_array()->is_packed());
+	CHECK(!tbl["dates"].as_array()->is_packed());
+}
@@ -114,6 +114,186 @@ TEST_CASE("tables - moving")
 		filename);
 }
 
+TEST_CASE("tables - arena allocation")
+{
+	static constexpr auto doc = R"(
+		name = "a string long enough to not fit in the small-string buffer"
+		ints = [ 1, 2, 3 ]
+
+		[sub]
+		val = { x = 1, y = [ "two" ] }
+		a_key_too_long_to_be_stored_inline = "another string too long for the small-string buffer"
+	)"sv;
+
+	const table doc_tbl = parse_or_fail(doc);
+	REQUIRE(doc_tbl.size() == 3u);
+
+	// moving the whole document (and with it the arena) around is fine
+	{
+		table tbl = parse_or_fail(doc, ""sv, parse_flags::arena_allocation);
+		table moved{ std::move(tbl) };
+		CHECK(moved == doc_tbl);
+		CHECK(tbl.empty());
+	}
+
+	// moving a table or array out of the document takes its nodes with it, keeping the arena alive
+	static_assert(std::is_nothrow_move_constructible_v<table> && std::is_nothrow_move_constructible_v<array>);
+	static_assert(std::is_nothrow_move_constructible_v<value<std::string>>);
+	static_assert(std::is_nothrow_move_assignable_v<value<std::string>>);
+	static_assert(std::is_nothrow_constructible_v<toml::key, std::string&&>);
+#if !TOML_ENABLE_PMR
+	static_assert(std::is_nothrow_move_assignable_v<table> && std::is_nothrow_move_assignable_v<array>);
+#endif
+	table sub;
+	array ints;
+	array flattened{ 0 };
+	{
+		table tbl = parse_or_fail(doc, ""sv, parse_flags::arena_allocation);
+		CHECK(tbl == doc_tbl);
+
+		sub = std::move(*tbl["sub"].as_table());
+		CHECK(tbl["sub"].as_table()->empty());
+
+		ints = array{ std::move(*tbl["ints"].as_array()) };
+		CHECK(tbl["ints"].as_array()->empty());
+
+		table other = parse_or_fail(doc, ""sv, parse_flags::arena_allocation);
+		flattened.push_back(std::move(*other["sub"]["val"]["y"].as_array()));
+		flattened.flatten();
+	}
+	CHECK(sub == *doc_tbl["sub"].as_table());
+	CHECK(sub.contains("a_key_too_long_to_be_stored_inline"sv));
+	CHECK(ints == *doc_tbl["ints"].as_array());
+	CHECK(sub["val"]["y"][0] == "two"sv);
+	CHECK(flattened == array{ 0, "two" });
+
+	// long keys and strings are kept in the arena too; strings moved out of the document keep it alive
+	std::optional<toml::key> long_key;
+	std::optional<value<std::string>> name;
+	std::optional<value<std::string>> assigned;
+	{
+		table tbl = parse_or_fail(doc, ""sv, parse_flags::arena_allocation);
+
+		const auto kvp = tbl["sub"].as_table()->find("a_key_too_long_to_be_stored_inline"sv);
+		REQUIRE(kvp != tbl["sub"].as_table()->end());
+		long_key.emplace(kvp->first);
+		CHECK(kvp->second.value<std::string_view>() == "another string too long for the small-string buffer"sv);
+
+		name.emplace(std::move(*tbl["name"].as_string()));
+		assigned.emplace(std::string{ "x" });
+		*assigned = std::move(*tbl["sub"]["a_key_too_long_to_be_stored_inline"].as_string());
+	}
+	CHECK(long_key->str() == "a_key_too_long_to_be_stored_inline"sv);
+	CHECK(name->get() == "a string long enough to not fit in the small-string buffer"sv);
+	CHECK(*assigned == "another string too long for the small-string buffer"sv);
+
+	// moving a descendant over the root releases the rest of the document
+	{
+		table tbl = parse_or_fail(doc, ""sv, parse_flags::arena_allocation);
+		tbl		  = std::move(*tbl["sub"]["val"].as_table());
+		CHECK(tbl.size() == 2u);
+		CHECK(tbl["x"] == 1);
+		CHECK(tbl["y"][0] == "two"sv);
+	}
+
+	// copying and modifying work as normal
+	{
+		const table tbl = parse_or_fail(doc, ""sv, parse_flags::arena_allocation);
+		table copy{ tbl };
+		CHECK(copy == doc_tbl);
+		copy.insert_or_assign("extra", array{ 1, 2 });
+		copy["sub"].as_table()->erase("val");
+		CHECK(copy.size() == 4u);
+		CHECK(copy["sub"].as_table()->size() == 1u);
+	}
+}
+
+#if TOML_ENABLE_PMR
+
+namespace
+{
+	struct counting_resource final : std::pmr::memory_resource
+	{
+		size_t allocations = {};
+		size_t outstanding = {};
+
+		void* do_allocate(size_t bytes, size_t align) override
+		{
+			allocations++;
+			outstanding += bytes;
+			return std::pmr::new_delete_resource()->allocate(bytes, align);
+		}
+
+		void do_deallocate(void* ptr, size_t bytes, size_t align) override
+		{
+			outstanding -= bytes;
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+}
+
+TEST_CASE("tables - polymorphic allocators")
+{
+	counting_resource res;
+	{
+		const auto source = table{ { "a", 1 },
+								   { "b", array{ 1, table{ { "c", "a string too long for the small-string buffer" } } } } };
+
+		// copying into a table with an allocator copies every node into its resource
+		table tbl{ source, &res };
+		CHECK(tbl == source);
+		CHECK(tbl.get_allocator().resource() == &res);
+		CHECK(tbl["b"].as_array()->get_allocator().resource() == &res);
+		CHECK(tbl["b"][1].as_table()->get_allocator().resource() == &res);
+		const auto copy_allocations = res.allocations;
+		CHECK(copy_allocations > 0u);
+
+		// as does inserting and emplacing
+		tbl.insert_or_assign("d", 3.0);
+		tbl.emplace<array>("e", 4, 5);
+		CHECK(res.allocations > copy_allocations);
+		CHECK(tbl["e"].as_array()->get_allocator().resource() == &res);
+		CHECK(tbl["e"] == array{ 4, 5 });
+
+		// assignment keeps the target's allocator
+		table other{ &res };
+		other = source;
+		CHECK(other == source);
+		CHECK(other["b"].as_array()->get_allocator().resource() == &res);
+
+		table heap_tbl{ source };
+		tbl = std::move(heap_tbl);
+		CHECK(tbl == source);
+		CHECK(tbl.get_allocator().resource() == &res);
+		CHECK(tbl["b"][1].as_table()->get_allocator().resource() == &res);
+
+		// moving keeps the source's allocator
+		table moved{ std::move(other) };
+		CHECK(moved == source);
+		CHECK(moved.get_allocator().resource() == &res);
+
+		// plain copies go back to the default resource
+		table copy{ tbl };
+		CHECK(copy == source);
+		CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+		CHECK(copy["b"].as_array()->get_allocator().resource() == std::pmr::get_default_resource());
+
+		array arr{ &res };
+		arr.push_back("another string too long for the small-string buffer");
+		arr.emplace_back<table>();
+		CHECK(arr.size() == 2u);
+		CHECK(arr.back().as_table()->get_allocator().resource() == &res);
+	}
+	CHECK(res.outstanding == 0u);
+}
+
+#endif // TOML_ENABLE_PMR
+
 TEST_CASE("tables - copying")
 {
 	static constexpr auto filename = "foo.toml"sv;
@@ -422,6 +602,83 @@ TEST_CASE("tables - insertion and erasure")
 	}
 }
 
+TEST_CASE("tables - many keys")
+{
+	// enough keys to exercise the lookup index used by TOML_ENABLE_FLAT_TABLES, inserted out of order
+	static constexpr int64_t key_count = 300;
+	const auto make_key				   = [](int64_t i) { return "key_"s + std::to_string((i * 7919) % key_count); };
+
+	table tbl;
+	for (int64_t i = 0; i < key_count; i++)
+		CHECK(tbl.insert(make_key(i), (i * 7919) % key_count).second);
+	CHECK(tbl.size() == static_cast<size_t>(key_count));
+	CHECK(!tbl.insert(make_key(0), -1).second);
+
+	const auto check_contents = [&](int64_t stride)
+	{
+		const toml::key* prev = {};
+		for (auto&& [k, v] : tbl)
+		{
+			if (prev)
+				CHECK(*prev < k);
+			prev = &k;
+			CHECK(k.str() == "key_"s + std::to_string(*v.value<int64_t>()));
+		}
+		for (int64_t i = 0; i < key_count; i++)
+		{
+			const auto k = "key_"s + std::to_string(i);
+			if (i % stride)
+			{
+				CHECK(!tbl.contains(k));
+				CHECK(tbl.find(k) == tbl.end());
+			}
+			else
+			{
+				REQUIRE(tbl.get_as<int64_t>(k));
+				CHECK(*tbl.get_as<int64_t>(k) == i);
+				REQUIRE(tbl.find(k) != tbl.end());
+				CHECK(tbl.find(k)->first == k);
+			}
+		}
+	};
+	check_contents(1);
+
+	// erase every odd key one at a time
+	for (int64_t i = 1; i < key_count; i += 2)
+		CHECK(tbl.erase("key_"s + std::to_string(i)) == 1u);
+	CHECK(tbl.size() == static_cast<size_t>(key_count / 2));
+	check_contents(2);
+
+	// then every second remaining key via prune()
+	for (int64_t i = 2; i < key_count; i += 4)
+		tbl.insert_or_assign("key_"s + std::to_string(i), table{});
+	tbl.prune();
+	CHECK(tbl.size() == static_cast<size_t>(key_count / 4));
+	check_contents(4);
+
+	// copies and ranges
+	table copy = tbl;
+	CHECK(copy == tbl);
+	tbl.erase(tbl.begin(), tbl.end());
+	CHECK(tbl.empty());
+	CHECK(!tbl.contains("key_0"sv));
+	tbl = std::move(copy);
+	check_contents(4);
+
+	// a range that leaves enough keys behind to keep the index
+	auto first_kept = tbl.begin();
+	for (int i = 0; i < 10; i++)
+		++first_kept;
+	std::vector<std::string> kept;
+	for (auto it = first_kept; it != tbl.end(); ++it)
+		kept.emplace_back(it->first.str());
+	tbl.erase(tbl.begin(), first_kept);
+	CHECK(tbl.size() == kept.size());
+	for (const auto& k : kept)
+		CHECK(tbl.contains(k));
+	CHECK(!tbl.contains("key_0"sv));
+}
+
 TEST_CASE("tables - toml_formatter")
 {
 	static constexpr auto to_string = [](std::string_view some_toml,
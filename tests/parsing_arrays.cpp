@@ -184,6 +184,38 @@ TEST_CASE("parsing - arrays")
 							   CHECK(tbl["contributors"][1]["url"] == "https://example.com/bazqux"sv);
 						   });
 
+	// every kind of number and date-time side by side, with nothing but the delimiters to tell them apart
+	parsing_should_succeed(FILE_LINE_ARGS,
+						   "mixed = [-1_000,0x1F,0o17,0b11,+1.5e-3,6.02E23,1979-05-27,07:32:00.5,"
+						   "1979-05-27 07:32:00Z,1979-05-27T07:32:00-08:00,-0.0,1e1_0]"sv,
+						   [](table&& tbl)
+						   {
+							   REQUIRE(tbl["mixed"].as<array>());
+							   CHECK(tbl["mixed"].as<array>()->size() == 12);
+							   CHECK(tbl["mixed"][0] == -1000);
+							   CHECK(tbl["mixed"][1] == 0x1F);
+							   CHECK(tbl["mixed"][1].as<int64_t>()->flags() == value_flags::format_as_hexadecimal);
+							   CHECK(tbl["mixed"][2] == 017);
+							   CHECK(tbl["mixed"][2].as<int64_t>()->flags() == value_flags::format_as_octal);
+							   CHECK(tbl["mixed"][3] == 0b11);
+							   CHECK(tbl["mixed"][3].as<int64_t>()->flags() == value_flags::format_as_binary);
+							   CHECK(tbl["mixed"][4] == 1.5e-3);
+							   CHECK(tbl["mixed"][5] == 6.02E23);
+							   CHECK(tbl["mixed"][6] == date{ 1979, 5, 27 });
+							   CHECK(tbl["mixed"][7] == toml::time{ 7, 32, 0, 500000000 });
+							   CHECK(tbl["mixed"][8] == date_time{ { 1979, 5, 27 }, { 7, 32 }, {} });
+							   CHECK(tbl["mixed"][9] == date_time{ { 1979, 5, 27 }, { 7, 32 }, { -8, 0 } });
+							   CHECK(tbl["mixed"][10] == -0.0);
+							   CHECK(tbl["mixed"][11] == 1e10);
+							   CHECK(tbl["mixed"][4].node()->source().begin == source_position{ 1, 32 });
+							   CHECK(tbl["mixed"][4].node()->source().end == source_position{ 1, 39 });
+						   });
+	parsing_should_fail(FILE_LINE_ARGS, "mixed = [1979-05-27 0]"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "mixed = [1979-05-27 07:32:60]"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "mixed = [1.5e-3x]"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "mixed = [01.5]"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "mixed = [1_.5]"sv);
+
 #else
 
 	parsing_should_fail(FILE_LINE_ARGS, "numbers = [ 0.1, 0.2, 0.5, 1, 2, 5 ]"sv);
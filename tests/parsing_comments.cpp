@@ -107,4 +107,29 @@ TEST_CASE("parsing - comments")
 								 "# \u007F  "sv));
 	}
 #endif
+
+	// long comment banners and alignment padding (consumed in bulk when parsing from memory)
+	for (size_t i = 0; i < 40u; i++)
+	{
+		INFO("run length: "sv << i);
+		const auto padding = std::string(i, ' ') + std::string(i % 3u, '\t');
+		const auto banner  = "#"s + std::string(i, '=') + padding + "# \xE2\x95\x90 " + std::string(i, '-');
+
+		parsing_should_succeed(FILE_LINE_ARGS,
+							   banner + "\n" + padding + "a" + padding + "=" + padding + "1" + padding + banner + "\n"
+								   + padding + "[" + padding + "tbl" + padding + "]" + padding + "\n" + banner
+								   + "\r\n" + padding + "b = 2" + padding,
+							   [](table&& tbl)
+							   {
+								   CHECK(tbl["a"] == 1);
+								   CHECK(tbl["tbl"]["b"] == 2);
+							   });
+
+#if TOML_LANG_AT_LEAST(1, 0, 0)
+		const auto error_column = static_cast<source_index>(1u + banner.length() - 2u); // (-2 for the multi-byte character)
+		parsing_should_fail(FILE_LINE_ARGS, "a = 1\n"s + banner + "\x01", 2u, error_column);
+		parsing_should_fail(FILE_LINE_ARGS, "a = 1\n"s + banner + "\x7F", 2u, error_column);
+		parsing_should_fail(FILE_LINE_ARGS, "a = 1\n"s + banner + "\r", 2u, error_column + 1u);
+#endif
+	}
 }
@@ -171,4 +171,53 @@ TEST_CASE("parsing - dates and times")
 	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16 10:"sv);
 	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16 10"sv);
 	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16 1"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16 1\n"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16 1 # comment"sv);
+
+	// field ranges
+	parse_expected_value(FILE_LINE_ARGS, "2000-02-29"sv, date{ 2000, 2, 29 });
+	parse_expected_value(FILE_LINE_ARGS, "2024-02-29"sv, date{ 2024, 2, 29 });
+	parse_expected_value(FILE_LINE_ARGS, "0000-01-01"sv, date{ 0, 1, 1 });
+	parse_expected_value(FILE_LINE_ARGS, "9999-12-31"sv, date{ 9999, 12, 31 });
+	parse_expected_value(FILE_LINE_ARGS, "23:59:59"sv, toml::time{ 23, 59, 59 });
+	parse_expected_value(FILE_LINE_ARGS, "00:00:00"sv, toml::time{ 0, 0, 0 });
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1900-02-29"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 2023-02-29"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 2023-04-31"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 2023-00-01"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 2023-13-01"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 2023-01-00"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 24:00:00"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 23:60:00"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 23:59:60"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16T10:20:30+24:00"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16T10:20:30+09:60"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16T10:20:30Zx"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16x"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987-03-16T10:20:30x"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1987/03/16"sv);
+
+	// fractional seconds (anything past nanoseconds is truncated)
+	parse_expected_value(FILE_LINE_ARGS, "10:20:30.1"sv, toml::time{ 10, 20, 30, 100000000 });
+	parse_expected_value(FILE_LINE_ARGS, "10:20:30.123456789"sv, toml::time{ 10, 20, 30, 123456789 });
+	parse_expected_value(FILE_LINE_ARGS, "10:20:30.1234567891"sv, toml::time{ 10, 20, 30, 123456789 });
+	parse_expected_value(FILE_LINE_ARGS, "10:20:30.000000001"sv, toml::time{ 10, 20, 30, 1 });
+	{
+		const auto val = date_time{ { 1987, 3, 16 }, { 10, 20, 30, 123456789 }, { -9, -30 } };
+		parse_expected_value(FILE_LINE_ARGS, "1987-03-16T10:20:30.123456789-09:30"sv, val);
+		parse_expected_value(FILE_LINE_ARGS, "1987-03-16T10:20:30.12345678999-09:30"sv, val);
+	}
+	{
+		const auto val = date_time{ { 1987, 3, 16 }, { 10, 20, 30, 5000000 }, { 0, 0 } };
+		parse_expected_value(FILE_LINE_ARGS, "1987-03-16T10:20:30.005Z"sv, val);
+	}
+	parsing_should_succeed(FILE_LINE_ARGS,
+						   "vals = [1987-03-16T10:20:30Z,1987-03-16,10:20:30.5 ,1987-03-16 10:20:30]#"sv,
+						   [](table&& tbl)
+						   {
+							   CHECK(tbl["vals"][0] == date_time{ { 1987, 3, 16 }, { 10, 20, 30 }, { 0, 0 } });
+							   CHECK(tbl["vals"][1] == date{ 1987, 3, 16 });
+							   CHECK(tbl["vals"][2] == toml::time{ 10, 20, 30, 500000000 });
+							   CHECK(tbl["vals"][3] == date_time{ { 1987, 3, 16 }, { 10, 20, 30 } });
+						   });
 }
@@ -183,6 +183,87 @@ TEST_CASE("parsing - floats")
 #endif
 }
 
+TEST_CASE("parsing - floats (rounding)")
+{
+	// values that are hard to round correctly
+	parse_expected_value(FILE_LINE_ARGS, "2.2250738585072011e-308"sv, 2.2250738585072011e-308);
+	parse_expected_value(FILE_LINE_ARGS, "2.2250738585072014e-308"sv, 2.2250738585072014e-308);
+	parse_expected_value(FILE_LINE_ARGS, "4.9406564584124654e-324"sv, 4.9406564584124654e-324);
+	parse_expected_value(FILE_LINE_ARGS, "2.4703282292062328e-324"sv, 4.9406564584124654e-324);
+	parse_expected_value(FILE_LINE_ARGS, "2.4703282292062327e-324"sv, 0.0);
+	parse_expected_value(FILE_LINE_ARGS, "1e-400"sv, 0.0);
+	parse_expected_value(FILE_LINE_ARGS, "-1e-400"sv, -0.0);
+	parse_expected_value(FILE_LINE_ARGS, "1.7976931348623157e308"sv, 1.7976931348623157e308);
+	parse_expected_value(FILE_LINE_ARGS, "8.98846567431157953865e307"sv, 8.98846567431157953865e307);
+	parse_expected_value(FILE_LINE_ARGS, "9007199254740993.0"sv, 9007199254740993.0);
+	parse_expected_value(FILE_LINE_ARGS, "7.2057594037927933e16"sv, 7.2057594037927933e16);
+	parse_expected_value(FILE_LINE_ARGS, "1e23"sv, 1e23);
+	parse_expected_value(FILE_LINE_ARGS,
+						 "3.14159265358979323846264338327950288419716939937510"sv,
+						 3.14159265358979323846264338327950288419716939937510);
+	parse_expected_value(FILE_LINE_ARGS,
+						 "1.00000000000000011102230246251565404236316680908203124"sv,
+						 1.00000000000000011102230246251565404236316680908203124);
+	parse_expected_value(FILE_LINE_ARGS,
+						 "1.00000000000000011102230246251565404236316680908203125"sv,
+						 1.00000000000000011102230246251565404236316680908203125);
+	parse_expected_value(FILE_LINE_ARGS,
+						 "1.00000000000000011102230246251565404236316680908203126"sv,
+						 1.00000000000000011102230246251565404236316680908203126);
+	parse_expected_value(FILE_LINE_ARGS,
+						 "0.000000000000000000000000000000000000000000000000000000000000000000000000000000001e80"sv,
+						 0.000000000000000000000000000000000000000000000000000000000000000000000000000000001e80);
+
+	// values that overflow
+	parsing_should_fail(FILE_LINE_ARGS, " val = 1e309 "sv);
+	parsing_should_fail(FILE_LINE_ARGS, " val = -1.8e308 "sv);
+	parsing_should_fail(FILE_LINE_ARGS, " val = 1.7976931348623159e308 "sv);
+
+	// values printed with enough digits to round-trip
+	{
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		for (int i = 0; i < 1000; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+
+			double expected;
+			const auto bits = state & 0x7FEFFFFFFFFFFFFFull; // no infs or nans
+			std::memcpy(&expected, &bits, sizeof(expected));
+
+			char buf[64];
+			std::snprintf(buf, sizeof(buf), "val = %.16e", expected);
+			INFO(buf);
+
+			const auto result = toml::parse(std::string_view{ buf });
+#if TOML_EXCEPTIONS
+			const auto& tbl = result;
+#else
+			REQUIRE(result);
+			const auto& tbl = result.table();
+#endif
+			CHECK(tbl["val"].value_or(0.0) == expected);
+		}
+	}
+
+// toml/issues/562 (hexfloats)
+#if TOML_LANG_UNRELEASED
+	parse_expected_value(FILE_LINE_ARGS, "0x1.fffffffffffffp1023"sv, 0x1.fffffffffffffp1023);
+	parse_expected_value(FILE_LINE_ARGS, "0x1.fffffffffffff7ffp1023"sv, 0x1.fffffffffffffp1023);
+	parse_expected_value(FILE_LINE_ARGS, "0x1p-1074"sv, 0x1p-1074);
+	parse_expected_value(FILE_LINE_ARGS, "0x1p-1075"sv, 0.0);
+	parse_expected_value(FILE_LINE_ARGS, "0x1.8p-1075"sv, 0x1p-1074);
+	parse_expected_value(FILE_LINE_ARGS, "0x1.00000000000008p0"sv, 1.0);
+	parse_expected_value(FILE_LINE_ARGS, "0x1.00000000000008000001p0"sv, 0x1.0000000000001p0);
+	parse_expected_value(FILE_LINE_ARGS, "0x1.00000000000018p0"sv, 0x1.0000000000002p0);
+	parse_expected_value(FILE_LINE_ARGS, "0x123456789abcdef.123p-4"sv, 0x123456789abcdef.123p-4);
+	parse_expected_value(FILE_LINE_ARGS, "0x0.0000000000000000001p-900"sv, 0x0.0000000000000000001p-900);
+	parsing_should_fail(FILE_LINE_ARGS, " val = 0x1.fffffffffffff8p1023 "sv);
+	parsing_should_fail(FILE_LINE_ARGS, " val = 0x1p1024 "sv);
+#endif
+}
+
 TEST_CASE("parsing - inf and nan")
 {
 	parsing_should_succeed(FILE_LINE_ARGS,
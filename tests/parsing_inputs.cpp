@@ -0,0 +1,980 @@
+// This file is a part of toml++ and is subject to the the terms of the MIT license.
+// Copyright (c) Mark Gillard <mark.gillard@outlook.com.au>
+// See https://github.com/marzer/tomlplusplus/blob/master/LICENSE for the full license text.
+// SPDX-License-Identifier: MIT
+
+#include "tests.hpp"
+TOML_DISABLE_WARNINGS;
+#include <cstdio>
+#include <fstream>
+TOML_ENABLE_WARNINGS;
+
+namespace
+{
+	struct temp_file
+	{
+		std::string path;
+
+		temp_file(std::string_view name, std::string_view contents) //
+			: path{ name }
+		{
+			std::ofstream file{ path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc };
+			file.write(contents.data(), static_cast<std::streamsize>(contents.length()));
+		}
+
+		~temp_file() noexcept
+		{
+			std::remove(path.c_str());
+		}
+	};
+
+	static void check_parse_file_matches(std::string_view name, std::string_view contents)
+	{
+		INFO("file: "sv << name);
+		const temp_file file{ name, contents };
+
+		const table from_file	= parse_or_fail([&] { return toml::parse_file(file.path); });
+		const table from_string = parse_or_fail(contents);
+
+		CHECK(from_file == from_string);
+		CHECK(from_file.source().path);
+		CHECK(*from_file.source().path == file.path);
+		CHECK(from_file.source().end == from_string.source().end);
+	}
+
+	static void check_same_source_regions(const node& lhs, const node& rhs)
+	{
+		CHECK(lhs.source().begin == rhs.source().begin);
+		CHECK(lhs.source().end == rhs.source().end);
+		CHECK(lhs.source().begin.offset == rhs.source().begin.offset);
+		CHECK(lhs.source().end.offset == rhs.source().end.offset);
+
+		if (auto lhs_tbl = lhs.as_table())
+		{
+			REQUIRE(rhs.is_table());
+			for (auto&& [k, v] : *lhs_tbl)
+			{
+				INFO("key: "sv << k);
+				CHECK(k.source().begin == rhs.as_table()->find(k)->first.source().begin);
+				CHECK(k.source().begin.offset == rhs.as_table()->find(k)->first.source().begin.offset);
+				check_same_source_regions(v, *rhs.as_table()->get(k));
+			}
+		}
+		else if (auto lhs_arr = lhs.as_array())
+		{
+			REQUIRE(rhs.is_array());
+			for (size_t i = 0; i < lhs_arr->size(); i++)
+				check_same_source_regions(*lhs_arr->get(i), *rhs.as_array()->get(i));
+		}
+	}
+
+	static void check_no_source_regions(const node& n)
+	{
+		CHECK(!n.source().begin);
+		CHECK(!n.source().end);
+		CHECK(!n.source().path);
+
+		if (auto tbl = n.as_table())
+		{
+			for (auto&& [k, v] : *tbl)
+			{
+				INFO("key: "sv << k);
+				CHECK(!k.source().begin);
+				CHECK(!k.source().path);
+				check_no_source_regions(v);
+			}
+		}
+		else if (auto arr = n.as_array())
+		{
+			for (auto&& v : *arr)
+				check_no_source_regions(v);
+		}
+	}
+
+	// everything but the last 'tail' bytes of the document, 'chunk_size' bytes at a time
+	static void feed_in_chunks(push_parser& parser, std::string_view doc, size_t chunk_size, size_t tail = 0)
+	{
+		doc.remove_suffix(tail);
+		for (; !doc.empty(); doc.remove_prefix((std::min)(doc.length(), chunk_size)))
+			parser.feed(doc.substr(0u, chunk_size));
+	}
+}
+
+TEST_CASE("parsing - files")
+{
+	check_parse_file_matches("toml_parse_file_test_1.toml"sv, R"(
+		title = "parse_file"
+
+		[owner]
+		name = "Tom Preston-Werner"
+		dob = 1979-05-27T07:32:00-08:00
+
+		[[products]]
+		name = "Hammer"
+		sku = 738594937
+	)"sv);
+
+	// byte order marks
+	check_parse_file_matches("toml_parse_file_test_2.toml"sv, BOM_PREFIX "key = \"value\""sv);
+
+	// empty files
+	check_parse_file_matches("toml_parse_file_test_3.toml"sv, ""sv);
+	check_parse_file_matches("toml_parse_file_test_4.toml"sv, BOM_PREFIX ""sv);
+
+	// larger than the old 2 MB 'read the whole thing into memory' threshold
+	{
+		std::string doc;
+		doc.reserve(3u * 1024u * 1024u);
+		for (size_t i = 0; doc.length() < 3u * 1024u * 1024u; i++)
+		{
+			doc += "[service_"sv;
+			doc += std::to_string(i);
+			doc += "]\nname = \"service number "sv;
+			doc += std::to_string(i);
+			doc += "\"\nport = "sv;
+			doc += std::to_string(1024u + i % 60000u);
+			doc += "\nenabled = true\n\n"sv;
+		}
+		check_parse_file_matches("toml_parse_file_test_5.toml"sv, doc);
+	}
+
+	// errors in files still report the file path and position
+	{
+		const temp_file file{ "toml_parse_file_test_6.toml"sv, "a = 1\nb = \n"sv };
+#if TOML_EXCEPTIONS
+		try
+		{
+			[[maybe_unused]] auto result = toml::parse_file(file.path);
+			FORCE_FAIL("expected parse_file() to fail");
+		}
+		catch (const parse_error& err)
+		{
+			CHECK(err.source().begin.line == 2u);
+			REQUIRE(err.source().path);
+			CHECK(*err.source().path == file.path);
+		}
+#else
+		auto result = toml::parse_file(file.path);
+		REQUIRE(!result);
+		CHECK(result.error().source().begin.line == 2u);
+		REQUIRE(result.error().source().path);
+		CHECK(*result.error().source().path == file.path);
+#endif
+	}
+
+	// missing files
+	{
+#if TOML_EXCEPTIONS
+		CHECK_THROWS_AS(toml::parse_file("toml_parse_file_test_missing.toml"sv), parse_error);
+#else
+		CHECK(!toml::parse_file("toml_parse_file_test_missing.toml"sv));
+#endif
+	}
+}
+
+TEST_CASE("parsing - byte sources")
+{
+	const auto parse_ok = [](byte_source source) -> table
+	{ return parse_or_fail([&] { return toml::parse(source, "byte_source.toml"sv); }); };
+
+	// byte order marks handed over one byte at a time
+	{
+		auto doc	  = BOM_PREFIX "key = \"value\""sv;
+		auto one_byte = [&](char* buffer, size_t) noexcept -> size_t
+		{
+			if (doc.empty())
+				return 0u;
+			*buffer = doc.front();
+			doc.remove_prefix(1u);
+			return 1u;
+		};
+
+		const auto tbl = parse_ok(one_byte);
+		CHECK(tbl["key"] == "value"sv);
+		REQUIRE(tbl.source().path);
+		CHECK(*tbl.source().path == "byte_source.toml"sv);
+		CHECK(tbl["key"].node()->source().begin == source_position{ 1, 7 });
+	}
+
+	// empty documents
+	{
+		auto empty = [](char*, size_t) noexcept -> size_t { return 0u; };
+		CHECK(parse_ok(empty).empty());
+
+		auto bom_only = [done = false](char* buffer, size_t) mutable noexcept -> size_t
+		{
+			if (std::exchange(done, true))
+				return 0u;
+			std::memcpy(buffer, BOM_PREFIX, 3u);
+			return 3u;
+		};
+		CHECK(parse_ok(bom_only).empty());
+	}
+
+	// large documents, read in default-sized chunks, match parsing from a string
+	{
+		std::string doc;
+		for (size_t i = 0; doc.length() < 3u * byte_source::default_chunk_size; i++)
+		{
+			doc += "[table_"sv;
+			doc += std::to_string(i);
+			doc += "]\nname = \"\xE2\x9C\x93 number "sv;
+			doc += std::to_string(i);
+			doc += "\"\n\n"sv;
+		}
+
+		size_t requested = {};
+		auto remaining	 = std::string_view{ doc };
+		auto source		 = [&](char* buffer, size_t capacity) noexcept -> size_t
+		{
+			requested			= (std::max)(requested, capacity);
+			const auto count	= (std::min)(remaining.length(), capacity);
+			std::memcpy(buffer, remaining.data(), count);
+			remaining.remove_prefix(count);
+			return count;
+		};
+
+		const auto from_source = parse_ok(source);
+		CHECK(requested == byte_source::default_chunk_size);
+		CHECK(from_source == toml::parse(doc));
+	}
+
+	// read errors
+	{
+		auto failing = [calls = 0](char* buffer, size_t) mutable noexcept -> size_t
+		{
+			if (calls++)
+				return byte_source::read_error;
+			std::memcpy(buffer, "a = 1\n", 6u);
+			return 6u;
+		};
+
+#if TOML_EXCEPTIONS
+		CHECK_THROWS_AS(toml::parse(failing), parse_error);
+
+		auto throwing = [](char*, size_t) -> size_t { throw std::runtime_error{ "decompression failed" }; };
+		try
+		{
+			[[maybe_unused]] auto result = toml::parse(throwing);
+			FORCE_FAIL("expected parse() to fail");
+		}
+		catch (const parse_error& err)
+		{
+			CHECK(err.description() == "decompression failed"sv);
+		}
+#else
+		auto result = toml::parse(failing);
+		REQUIRE(!result);
+		CHECK(result.error().source().begin.line == 2u);
+#endif
+	}
+}
+
+TEST_CASE("parsing - push parser")
+{
+	static constexpr size_t chunk_sizes[] = { 1u, 2u, 3u, 4u, 7u, 16u, 64u, 1024u };
+
+	// documents split up in all sorts of awkward places give the same results as parsing them all at once
+	{
+		const auto doc = BOM_PREFIX R"(# comment with "quotes", 'apostrophes', [brackets] and {braces}
+title = "push \"parser\" # not a comment"
+literal = 'C:\path\[to]\{file}'
+ml_basic = """
+line one \"""
+line two "" ""
+"""" # closes after two quotes
+ml_literal = '''
+it's a 'multi-line' [literal]
+'''''
+array = [
+	1, # one
+	[ 2, 3 ], # two and three
+	"]", # a bracket
+]
+inline = { a = 1, b = { c = "}" } }
+
+[table]
+key = "caf)" "\xC3\xA9" R"(" # é
+"quoted [key]" = true
+
+[[products]]
+name = "Hammer"
+[[products]]
+date = 1979-05-27T07:32:00Z
+
+[table.sub] # sub-table
+value = 3.14)"
+								 "\r\nlast = \"no trailing newline\""sv;
+
+#if TOML_EXCEPTIONS
+		const table expected = toml::parse(doc, "push.toml"sv);
+#else
+		const table expected = std::move(toml::parse(doc, "push.toml"sv)).table();
+#endif
+		REQUIRE(expected.size() == 8u);
+
+		for (auto chunk_size : chunk_sizes)
+		{
+			INFO("chunk size: "sv << chunk_size);
+
+			push_parser parser{ "push.toml"sv };
+			feed_in_chunks(parser, doc, chunk_size);
+
+#if TOML_EXCEPTIONS
+			const table tbl = parser.finish();
+#else
+			auto result = parser.finish();
+			if (!result)
+				FORCE_FAIL("push_parser failed: "sv << result.error());
+			const table tbl = std::move(result).table();
+#endif
+
+			CHECK(tbl == expected);
+			REQUIRE(tbl.source().path);
+			CHECK(*tbl.source().path == "push.toml"sv);
+			check_same_source_regions(tbl, expected);
+		}
+	}
+
+	// empty documents
+	{
+		push_parser parser;
+		const auto result = parser.finish();
+		const table& tbl  = result;
+		CHECK(tbl.empty());
+		CHECK(tbl.source().begin == source_position{ 1, 1 });
+
+		push_parser bom_only;
+		bom_only.feed(BOM_PREFIX ""sv);
+		bom_only.feed(""sv);
+		const auto bom_only_result = bom_only.finish();
+		CHECK(static_cast<const table&>(bom_only_result).empty());
+	}
+
+	// errors are reported in the same place, whether they're found while feeding or when finishing
+	{
+		static constexpr std::string_view bad_docs[] = {
+			"a = 1\nb = 2\na = 3\n"sv,
+			"a = 1\n[t]\nx = \"\xC3\xA9\xFF\"\ny = 2\n"sv,
+			"a = [\n1,\n2\nb = 3\n"sv,
+			"a = \"\"\"\nunterminated\n"sv,
+			"a = 1\nb = \"oops\nc = 2\n"sv,
+			"a = 1\n\xE2\x9C"sv,
+		};
+
+		for (auto bad_doc : bad_docs)
+		{
+			INFO("document: "sv << bad_doc);
+
+#if TOML_EXCEPTIONS
+			source_position expected{};
+			try
+			{
+				[[maybe_unused]] auto res = toml::parse(bad_doc);
+				FORCE_FAIL("expected parse() to fail");
+			}
+			catch (const parse_error& err)
+			{
+				expected = err.source().begin;
+			}
+
+			for (auto chunk_size : chunk_sizes)
+			{
+				INFO("chunk size: "sv << chunk_size);
+				try
+				{
+					push_parser parser;
+					feed_in_chunks(parser, bad_doc, chunk_size);
+					[[maybe_unused]] auto res = parser.finish();
+					FORCE_FAIL("expected push_parser to fail");
+				}
+				catch (const parse_error& err)
+				{
+					CHECK(err.source().begin == expected);
+					CHECK(err.source().begin.offset == expected.offset);
+				}
+			}
+#else
+			const auto expected = toml::parse(bad_doc);
+			REQUIRE(!expected);
+
+			for (auto chunk_size : chunk_sizes)
+			{
+				INFO("chunk size: "sv << chunk_size);
+				push_parser parser;
+				feed_in_chunks(parser, bad_doc, chunk_size);
+
+				const auto result = parser.finish();
+				REQUIRE(!result);
+				CHECK(result.error().source().begin == expected.error().source().begin);
+				CHECK(result.error().source().begin.offset == expected.error().source().begin.offset);
+				CHECK(result.error().description() == expected.error().description());
+			}
+#endif
+		}
+
+#if !TOML_EXCEPTIONS
+		// anything fed in after an error has been found is ignored
+		push_parser parser;
+		parser.feed("a = 1\nb = 2\na = 3\n"sv);
+		parser.feed("c = \"unterminated\n"sv);
+		const auto result = parser.finish();
+		REQUIRE(!result);
+		CHECK(result.error().source().begin == source_position{ 3, 5 });
+#endif
+	}
+}
+
+TEST_CASE("parsing - without source tracking")
+{
+	static constexpr auto doc = R"(
+		a = 1
+		b.c = [ 2, { d = "three" } ]
+
+		[e.f]
+		g = 1979-05-27T07:32:00Z
+
+		[[h]]
+		i = true
+	)"sv;
+
+	const table tracked	  = parse_or_fail(doc, "doc.toml"sv);
+	const table untracked = parse_or_fail(doc, "doc.toml"sv, parse_flags::no_source_tracking);
+
+	CHECK(tracked == untracked);
+	CHECK(tracked.source().path);
+	CHECK(tracked["e"]["f"]["g"].node()->source().begin == source_position{ 6, 7 });
+	check_no_source_regions(untracked);
+
+	// errors are still reported in the right place
+#if TOML_EXCEPTIONS
+	try
+	{
+		[[maybe_unused]] auto tbl = toml::parse("a = 1\nb = nope"sv, "doc.toml"sv, parse_flags::no_source_tracking);
+		FORCE_FAIL("parse() succeeded unexpectedly");
+	}
+	catch (const parse_error& err)
+	{
+		CHECK(err.source().begin == source_position{ 2, 6 });
+		CHECK(*err.source().path == "doc.toml"sv);
+	}
+#else
+	auto result = toml::parse("a = 1\nb = nope"sv, "doc.toml"sv, parse_flags::no_source_tracking);
+	REQUIRE(!result);
+	CHECK(result.error().source().begin == source_position{ 2, 6 });
+	CHECK(*result.error().source().path == "doc.toml"sv);
+#endif
+}
+
+TEST_CASE("parsing - borrowed strings")
+{
+	static constexpr auto doc = R"(
+		plain = "plain"
+		literal = 'C:\path'
+		escaped = "tab\there"
+		multi = """multi"""
+		"quoted key" = 1
+		'esc\aped' = 2
+		"esc\taped" = 3
+		bare.dotted = 4
+	)"sv;
+
+	const auto in_doc = [](std::string_view str) noexcept
+	{ return str.data() >= doc.data() && str.data() + str.length() <= doc.data() + doc.length(); };
+
+	const table normal = parse_or_fail(doc, "doc.toml"sv);
+	table borrowed	   = parse_or_fail(doc, "doc.toml"sv, parse_flags::borrowed_strings);
+
+	CHECK(normal == borrowed);
+
+	// strings without escape sequences point into the document; everything else is a copy
+	CHECK(in_doc(*borrowed["plain"].value<std::string_view>()));
+	CHECK(in_doc(*borrowed["literal"].value<std::string_view>()));
+	CHECK(!in_doc(*borrowed["escaped"].value<std::string_view>()));
+	CHECK(*borrowed["escaped"].value<std::string_view>() == "tab\there"sv);
+	CHECK(!in_doc(*borrowed["multi"].value<std::string_view>()));
+
+	// the same goes for keys
+	for (auto&& [k, v] : borrowed)
+	{
+		INFO("key: "sv << k);
+		CHECK(in_doc(k.str()) == (k != "esc\taped"sv));
+	}
+	CHECK(in_doc(borrowed["bare"].as_table()->begin()->first.str()));
+	for (auto&& [k, v] : normal)
+		CHECK(!in_doc(k.str()));
+
+	// const access copies the text for get() (once), but not for view()
+	const auto& plain = *std::as_const(borrowed)["plain"].as_string();
+	CHECK(in_doc(plain.view()));
+	CHECK(plain.get() == "plain"sv);
+	CHECK(!in_doc(plain.get()));
+	CHECK(&plain.get() == &*plain);
+	CHECK(plain.view().data() == plain.get().data());
+
+	// moving a borrowed value keeps it borrowed
+	{
+		auto moved = value<std::string>{ std::move(*borrowed["literal"].as_string()) };
+		CHECK(in_doc(moved.view()));
+		CHECK(moved == "C:\\path"sv);
+		*borrowed["literal"].as_string() = std::move(moved);
+		CHECK(in_doc(*borrowed["literal"].value<std::string_view>()));
+	}
+
+	// copies have their own text
+	table copy = borrowed;
+	CHECK(copy == normal);
+	CHECK(!in_doc(*copy["literal"].value<std::string_view>()));
+	for (auto&& [k, v] : copy)
+		CHECK(!in_doc(k.str()));
+
+	// modifying a borrowed value makes it use its own string
+	auto& literal = *borrowed["literal"].as_string();
+	*literal += "\\more";
+	CHECK(literal == "C:\\path\\more"sv);
+	CHECK(!in_doc(literal.view()));
+	literal = literal.view().substr(0u, 2u);
+	CHECK(literal == "C:"sv);
+	CHECK(borrowed["plain"] == "plain"sv);
+}
+
+TEST_CASE("parsing - reusable context")
+{
+	static constexpr std::string_view docs[] = {
+		R"(a = 1
+		b.c = [ "two", { d = 3.0 } ]
+		[e]
+		f = 1979-05-27T07:32:00Z
+		[[g]]
+		h = true
+		[[g]]
+		i = """multi
+		line""")"sv,
+
+		// fails part-way through an inline table inside an array of tables, leaving the context's buffers dirty
+		R"(x.y = 1
+		[[z]]
+		w = [ { v = 'unterminated }, 2 ])"sv,
+
+		R"(k = 'reused'
+		[[g]]
+		l.m.n = [ [ 1 ], [ 2 ] ])"sv,
+	};
+
+	for (auto flags : { parse_flags::none, parse_flags::arena_allocation })
+	{
+		parse_context ctx{ flags };
+		CHECK(ctx.flags() == flags);
+
+		for (size_t pass = 0; pass < 2u; pass++)
+		{
+			for (auto doc : docs)
+			{
+				INFO("document: "sv << doc);
+
+#if TOML_EXCEPTIONS
+				table expected, actual;
+				bool expected_ok = true, actual_ok = true;
+				try
+				{
+					expected = toml::parse(doc, "ctx.toml"sv, flags);
+				}
+				catch (const parse_error&)
+				{
+					expected_ok = false;
+				}
+				try
+				{
+					actual = ctx.parse(doc, "ctx.toml"sv);
+				}
+				catch (const parse_error&)
+				{
+					actual_ok = false;
+				}
+				REQUIRE(actual_ok == expected_ok);
+#else
+				auto expected_result = toml::parse(doc, "ctx.toml"sv, flags);
+				auto actual_result	 = ctx.parse(doc, "ctx.toml"sv);
+				REQUIRE(!!actual_result == !!expected_result);
+				if (!expected_result)
+				{
+					CHECK(actual_result.error().description() == expected_result.error().description());
+					CHECK(actual_result.error().source().begin == expected_result.error().source().begin);
+					continue;
+				}
+				const table expected = std::move(expected_result).table();
+				const table actual	 = std::move(actual_result).table();
+#endif
+
+				CHECK(actual == expected);
+				check_same_source_regions(actual, expected);
+			}
+		}
+
+		// streams and files go through it too
+		std::stringstream ss;
+		ss << docs[0];
+		const temp_file file{ "toml_parse_context_test.toml"sv, docs[2] };
+#if TOML_EXCEPTIONS
+		CHECK(ctx.parse(ss) == toml::parse(docs[0]));
+		CHECK(ctx.parse_file(file.path) == toml::parse(docs[2]));
+#else
+		CHECK(ctx.parse(ss).table() == toml::parse(docs[0]).table());
+		CHECK(ctx.parse_file(file.path).table() == toml::parse(docs[2]).table());
+#endif
+
+		// byte sources share the context's chunk buffer, growing it when one asks for bigger chunks
+		for (size_t chunk_size : { 16u, 64u, 16u })
+		{
+			auto remaining = docs[2];
+			auto source	   = [&](char* buffer, size_t capacity) noexcept -> size_t
+			{
+				const auto count = (std::min)(remaining.length(), capacity);
+				std::memcpy(buffer, remaining.data(), count);
+				remaining.remove_prefix(count);
+				return count;
+			};
+#if TOML_EXCEPTIONS
+			CHECK(ctx.parse(byte_source{ source, chunk_size }) == toml::parse(docs[2]));
+#else
+			CHECK(ctx.parse(byte_source{ source, chunk_size }).table() == toml::parse(docs[2]).table());
+#endif
+		}
+
+		// moved-from contexts still work, they just don't have anything to reuse
+		parse_context moved{ std::move(ctx) };
+#if TOML_EXCEPTIONS
+		CHECK(moved.parse(docs[2]) == toml::parse(docs[2]));
+		CHECK(ctx.parse(docs[2]) == toml::parse(docs[2]));
+#else
+		CHECK(moved.parse(docs[2]).table() == toml::parse(docs[2]).table());
+		CHECK(ctx.parse(docs[2]).table() == toml::parse(docs[2]).table());
+#endif
+	}
+}
+
+TEST_CASE("parsing - source paths")
+{
+#if TOML_EXCEPTIONS
+	const table a = toml::parse("x = 1\ny = [ 2 ]"sv, "shared.toml"sv);
+	const table b = toml::parse("x = 1"sv, std::string{ "shared.toml" });
+#else
+	const table a = std::move(toml::parse("x = 1\ny = [ 2 ]"sv, "shared.toml"sv)).table();
+	const table b = std::move(toml::parse("x = 1"sv, std::string{ "shared.toml" })).table();
+#endif
+
+	// every node and key shares ownership of its document's path
+	const auto& path = a.source().path;
+	REQUIRE(path);
+	CHECK(*path == "shared.toml"sv);
+	CHECK(a["x"].node()->source().path == path);
+	CHECK(a["y"][0].node()->source().path == path);
+	CHECK(a.begin()->first.source().path == path);
+
+	// other documents have their own
+	REQUIRE(b.source().path);
+	CHECK(*b.source().path == "shared.toml"sv);
+	CHECK(b.source().path != path);
+	CHECK(b["x"].node()->source().path == b.source().path);
+
+	// so nodes moved out of a document still have it after the rest of the document is gone
+	table moved;
+	{
+#if TOML_EXCEPTIONS
+		table c = toml::parse("[sub]\nz = [ 3 ]"sv, "moved.toml"sv);
+#else
+		table c = std::move(toml::parse("[sub]\nz = [ 3 ]"sv, "moved.toml"sv)).table();
+#endif
+		moved = std::move(*c["sub"].as_table());
+	}
+	REQUIRE(moved.source().path);
+	CHECK(*moved.source().path == "moved.toml"sv);
+	REQUIRE(moved["z"][0].node()->source().path);
+	CHECK(*moved["z"][0].node()->source().path == "moved.toml"sv);
+
+	// (including when one is moved over the root)
+	{
+#if TOML_EXCEPTIONS
+		table c = toml::parse("[sub]\nz = [ 3 ]"sv, "moved.toml"sv);
+#else
+		table c = std::move(toml::parse("[sub]\nz = [ 3 ]"sv, "moved.toml"sv)).table();
+#endif
+		c = std::move(*c["sub"].as_table());
+		REQUIRE(c["z"].node()->source().path);
+		CHECK(*c["z"].node()->source().path == "moved.toml"sv);
+	}
+
+	// documents without a path don't get one
+#if TOML_EXCEPTIONS
+	CHECK(!toml::parse("x = 1"sv).source().path);
+#else
+	CHECK(!toml::parse("x = 1"sv).table().source().path);
+#endif
+}
+
+TEST_CASE("parsing - source offsets")
+{
+	static constexpr auto doc = BOM_PREFIX "a = 1\n"
+										   "b = \"caf\xC3\xA9\" # caf\xC3\xA9\n"
+										   "c = [ 2, \"\xE2\x9C\x93\" ]\n"
+										   "[d]\n"
+										   "ml = \"\"\"\n\xE2\x9C\x93\nx\"\"\" # \xE2\x9C\x93\n"
+										   "e = 'last'"sv;
+
+	const auto text_of = [](const source_region& src) noexcept
+	{ return doc.substr(src.begin.offset, src.end.offset - src.begin.offset); };
+
+#if TOML_EXCEPTIONS
+	table from_string, from_stream;
+	try
+	{
+		from_string = toml::parse(doc);
+
+		std::stringstream ss;
+		ss.write(doc.data(), static_cast<std::streamsize>(doc.length()));
+		from_stream = toml::parse(ss);
+	}
+	catch (const parse_error& err)
+	{
+		FORCE_FAIL("parse() failed: "sv << err);
+	}
+#else
+	const table from_string = std::move(toml::parse(doc)).table();
+
+	std::stringstream ss;
+	ss.write(doc.data(), static_cast<std::streamsize>(doc.length()));
+	const table from_stream = std::move(toml::parse(ss)).table();
+#endif
+
+	// the offsets count from the very first byte of the document, BOM and all
+	CHECK(from_string["a"].node()->source().begin.offset == 7u);
+	CHECK(text_of(from_string["a"].node()->source()) == "1"sv);
+	CHECK(text_of(from_string["b"].node()->source()) == "\"caf\xC3\xA9\""sv);
+	CHECK(text_of(from_string["c"].node()->source()) == "[ 2, \"\xE2\x9C\x93\" ]"sv);
+	CHECK(text_of(from_string["c"][1].node()->source()) == "\"\xE2\x9C\x93\""sv);
+	CHECK(text_of(from_string["d"]["ml"].node()->source()) == "\"\"\"\n\xE2\x9C\x93\nx\"\"\""sv);
+	CHECK(text_of(from_string["d"]["e"].node()->source()) == "'last'"sv);
+
+	// line and column still count codepoints
+	CHECK(from_string["c"][1].node()->source().begin == source_position{ 3, 10 });
+	CHECK(from_string["c"][1].node()->source().end == source_position{ 3, 13 });
+	CHECK(from_string["d"]["ml"].node()->source().end == source_position{ 7, 5 });
+	CHECK(from_string["d"]["e"].node()->source().begin == source_position{ 8, 5 });
+	CHECK(from_string.source().end.offset == doc.length());
+	for (auto&& [k, v] : *from_string["d"].as_table())
+		CHECK(doc.substr(k.source().begin.offset, k.str().length()) == k.str());
+
+	// streams and strings agree
+	check_same_source_regions(from_string, from_stream);
+
+	// errors carry offsets too
+#if TOML_EXCEPTIONS
+	try
+	{
+		[[maybe_unused]] auto tbl = toml::parse("a = \"\xC3\xA9\"\nb = nope"sv);
+		FORCE_FAIL("parse() succeeded unexpectedly");
+	}
+	catch (const parse_error& err)
+	{
+		CHECK(err.source().begin == source_position{ 2, 6 });
+		CHECK(err.source().begin.offset == 14u);
+	}
+#else
+	auto result = toml::parse("a = \"\xC3\xA9\"\nb = nope"sv);
+	REQUIRE(!result);
+	CHECK(result.error().source().begin == source_position{ 2, 6 });
+	CHECK(result.error().source().begin.offset == 14u);
+#endif
+}
+
+TEST_CASE("parsing - utf-8 input")
+{
+	// long runs of ASCII broken up by multi-byte sequences, straddling the reader's internal scan windows
+	{
+		std::string doc;
+		for (size_t i = 0; i < 200u; i++)
+		{
+			doc += "key_"sv;
+			doc += std::to_string(i);
+			doc += " = \""sv;
+			doc.append(i % 97u, 'x');
+			doc += "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"sv; // é€😀
+			doc += "\" # comment \xE2\x9C\x93\n"sv;			 // ✓
+		}
+
+		parsing_should_succeed(FILE_LINE_ARGS,
+							   doc,
+							   [](table&& tbl)
+							   {
+								   REQUIRE(tbl.size() == 200u);
+								   for (size_t i = 0; i < 200u; i++)
+								   {
+									   const auto key = "key_"s + std::to_string(i);
+									   INFO("key: "sv << key);
+									   REQUIRE(tbl[key].is_string());
+									   CHECK(tbl[key].ref<std::string>()
+											 == std::string(i % 97u, 'x') + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"s);
+									   CHECK(tbl[key].node()->source().begin.line == i + 1u);
+								   }
+							   });
+	}
+
+	// invalid sequences are reported at the last valid code point preceding them
+	parsing_should_fail(FILE_LINE_ARGS, "a = \"\xFF\""sv, 1u, 5u);
+	parsing_should_fail(FILE_LINE_ARGS, "a = 1\nbb = \"\xC3\xA9\xC3\""sv, 2u, 7u);
+	parsing_should_fail(FILE_LINE_ARGS, "a = 1\nb = \"\xE2\x82"sv, 2u, 5u);
+
+	// invalid sequences at various offsets either side of SIMD block boundaries
+	for (size_t i = 0; i < 24u; i++)
+	{
+		INFO("offset: "sv << i);
+		const auto prefix		= "s = \""s + std::string(i, 'a');
+		const auto error_column = static_cast<source_index>(5u + i);
+
+		parsing_should_fail(FILE_LINE_ARGS, prefix + "\xC0\x80\"", 1u, error_column);		   // overlong
+		parsing_should_fail(FILE_LINE_ARGS, prefix + "\xE0\x80\xAF\"", 1u, error_column);	   // overlong
+		parsing_should_fail(FILE_LINE_ARGS, prefix + "\xED\xA0\x80\"", 1u, error_column);	   // surrogate
+		parsing_should_fail(FILE_LINE_ARGS, prefix + "\xF4\x90\x80\x80\"", 1u, error_column); // > U+10FFFF
+		parsing_should_fail(FILE_LINE_ARGS, prefix + "\x80\"", 1u, error_column);			   // stray continuation
+		parsing_should_fail(FILE_LINE_ARGS, prefix + "\xE2\x82\"", 1u, error_column);		   // truncated
+		parsing_should_fail(FILE_LINE_ARGS, prefix + "\xF0\x9F\x98", 1u, error_column);	   // truncated at EOF
+
+		parse_expected_value(FILE_LINE_ARGS,
+							 "\""s + std::string(i, 'a') + "\xF4\x8F\xBF\xBF\xED\x9F\xBF\xC2\x80\"",
+							 std::string(i, 'a') + "\xF4\x8F\xBF\xBF\xED\x9F\xBF\xC2\x80");
+	}
+}
+
+TEST_CASE("parsing - lookahead")
+{
+	// the parser steps back after looking ahead; positions must survive stepping back over
+	// multi-byte sequences and line breaks
+	parsing_should_fail(FILE_LINE_ARGS, "a = 1\nb = '\n'"sv, 2u, 6u);
+	parsing_should_fail(FILE_LINE_ARGS, "a = 1\nb = \"\xC3\xA9\n\""sv, 2u, 7u);
+	parsing_should_fail(FILE_LINE_ARGS, "a = 1\nb = '\xC3\xA9'\nc = \"\xE2\x82\xAC\n"sv, 3u, 7u);
+
+	// documents parsed from memory can look ahead arbitrarily far when identifying value types
+	// (streams are limited by the size of their history buffer)
+	{
+		std::string doc = "f = "s;
+		for (size_t i = 0; i < 70u; i++)
+			doc += "1_"sv;
+		doc += "1.5e1"sv;
+		REQUIRE(doc.length() > 128u);
+
+		const table tbl = parse_or_fail(doc);
+		REQUIRE(tbl["f"].is_floating_point());
+		CHECK(tbl["f"].ref<double>() == Approx(1.1111111111111111e+71));
+		CHECK(tbl["f"].node()->source().end.column == doc.length() + 1u);
+	}
+}
+
+TEST_CASE("parsing - simd tiers")
+{
+	// run the bulk-scanning functions and the parser at each instruction set tier the CPU supports
+	// (tiers it doesn't support are clamped to the best one it does, so those are skipped)
+	const auto initial_tier = impl::active_simd_tier();
+
+	const auto ascii_prefix_length = [](std::string_view str) noexcept
+	{
+		size_t i = 0;
+		while (i < str.length() && static_cast<unsigned char>(str[i]) < 128u)
+			i++;
+		return i;
+	};
+	const auto horizontal_whitespace_prefix_length = [](std::string_view str) noexcept
+	{
+		size_t i = 0;
+		while (i < str.length() && (str[i] == ' ' || str[i] == '\t'))
+			i++;
+		return i;
+	};
+	const auto plain_string_prefix_length = [](std::string_view str) noexcept
+	{
+		size_t i = 0;
+		while (i < str.length() && (str[i] == '\t' || (str[i] >= ' ' && str[i] < '\x7F')) && str[i] != '"'
+			   && str[i] != '\\')
+			i++;
+		return i;
+	};
+
+	std::string doc;
+	for (size_t i = 0; i < 40u; i++)
+	{
+		doc += std::string(i, ' ');
+		doc += "key_"sv;
+		doc += std::to_string(i);
+		doc += " = \""sv;
+		doc.append(i * 3u, 'x');
+		doc += "\\t\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"sv;
+		doc += "\"\t"sv;
+		doc.append(i, '\t');
+		doc += "# "sv;
+		doc.append(i * 2u, '-');
+		doc += "\xE2\x9C\x93\n"sv;
+		doc += "lit_"sv;
+		doc += std::to_string(i);
+		doc += " = '''"sv;
+		doc.append(i, 'y');
+		doc += "\n"sv;
+		doc.append(i, 'z');
+		doc += "'''\n"sv;
+	}
+
+	impl::force_simd_tier(impl::simd_tier::scalar);
+	table expected;
+	parsing_should_succeed(FILE_LINE_ARGS, doc, [&](table&& tbl) { expected = std::move(tbl); });
+	REQUIRE(expected.size() == 80u);
+
+	for (auto tier : { impl::simd_tier::scalar, impl::simd_tier::sse2, impl::simd_tier::sse4_1, impl::simd_tier::avx2 })
+	{
+		if (impl::force_simd_tier(tier) != tier)
+			continue;
+		INFO("tier: "sv << static_cast<int>(tier));
+		CHECK(impl::active_simd_tier() == tier);
+
+		// every length up to a few blocks, with a 'special' character at every position
+		for (size_t len = 0; len <= 70u; len++)
+		{
+			INFO("length: "sv << len);
+			for (size_t pos = 0; pos <= len; pos++)
+			{
+				INFO("position: "sv << pos);
+				for (auto c : { '\t', ' ', '"', '\\', '\x7F', '\x1F', '\x80', '\xC3' })
+				{
+					std::string str(len + 1u, 'a');
+					if (c == ' ' || c == '\t')
+						std::fill(str.begin(), str.end(), c == ' ' ? '\t' : ' ');
+					str[pos] = c;
+					const auto view = std::string_view{ str }.substr(0, len);
+
+					CHECK(impl::is_ascii(view.data(), len) == (ascii_prefix_length(view) == len));
+					CHECK(impl::ascii_prefix_length(view.data(), len) == ascii_prefix_length(view));
+					CHECK(impl::horizontal_whitespace_prefix_length(view.data(), len)
+						  == horizontal_whitespace_prefix_length(view));
+					CHECK(impl::plain_string_prefix_length(view.data(), len, '"', '\\')
+						  == plain_string_prefix_length(view));
+				}
+
+				// (a trailing 'a' so each sequence can be cut short at the end of the input, too)
+				for (auto seq : { "\xC3\xA9"sv, "\xE2\x82\xAC"sv, "\xF0\x9F\x98\x80"sv, "\xF4\x8F\xBF\xBF"sv })
+				{
+					const auto str = std::string(pos, 'a') + std::string(seq) + std::string(len - pos, 'a');
+					CHECK(impl::is_valid_utf8(str.data(), str.length()));
+					CHECK(!impl::is_valid_utf8(str.data(), pos + seq.length() - 1u));
+				}
+				for (auto seq : { "\xC0\x80"sv, "\xE0\x80\xAF"sv, "\xED\xA0\x80"sv, "\xF4\x90\x80\x80"sv, "\x80"sv })
+				{
+					const auto str = std::string(pos, 'a') + std::string(seq) + std::string(len - pos, 'a');
+					CHECK(!impl::is_valid_utf8(str.data(), str.length()));
+				}
+			}
+		}
+
+		parsing_should_succeed(FILE_LINE_ARGS, doc, [&](table&& tbl) { CHECK(tbl == expected); });
+		parsing_should_fail(FILE_LINE_ARGS, "s = \"aaaaaaaaaaaaaaaa\xED\xA0\x80\""sv, 1u, 21u);
+		parsing_should_fail(FILE_LINE_ARGS, "s = \"aaaaaaaaaaaaaaaa\xE2\x82\""sv, 1u, 21u);
+	}
+
+	impl::force_simd_tier(initial_tier);
+}
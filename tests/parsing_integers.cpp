@@ -79,6 +79,23 @@ TEST_CASE("parsing - integers (decimal)")
 	parse_expected_value(FILE_LINE_ARGS, "+1_2_3_4"sv, 1234);
 	parse_expected_value(FILE_LINE_ARGS, "-1_2_3_4"sv, -1234);
 	parse_expected_value(FILE_LINE_ARGS, "123_456_789"sv, 123456789);
+	parse_expected_value(FILE_LINE_ARGS, "1234567890123456789"sv, 1234567890123456789);
+	parse_expected_value(FILE_LINE_ARGS, "-1234567890123456789"sv, -1234567890123456789);
+	parse_expected_value(FILE_LINE_ARGS, "12_345_678_901_234_567"sv, 12345678901234567);
+	parse_expected_value(FILE_LINE_ARGS, "123456781234567_8"sv, 1234567812345678);
+	parse_expected_value(FILE_LINE_ARGS, "1_23456781_2"sv, 1234567812);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 12345678901234567890"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1234567812345678_"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 12345678__12345678"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 1234567812345678x"sv);
+	parsing_should_succeed(FILE_LINE_ARGS,
+						   "vals = [12345678901,23456789012 ,34567890123]#"sv,
+						   [](table&& tbl)
+						   {
+							   CHECK(tbl["vals"][0] == 12345678901);
+							   CHECK(tbl["vals"][1] == 23456789012);
+							   CHECK(tbl["vals"][2] == 34567890123);
+						   });
 }
 
 TEST_CASE("parsing - integers (hex, bin, oct)")
@@ -174,4 +191,17 @@ TEST_CASE("parsing - integers (hex, bin, oct)")
 	parse_expected_value(FILE_LINE_ARGS, "0b010000"sv, 0b10000);
 	parse_expected_value(FILE_LINE_ARGS, "0b01_00_00"sv, 0b10000);
 	parse_expected_value(FILE_LINE_ARGS, "0b111111"sv, 0b111111);
+	parse_expected_value(FILE_LINE_ARGS, "0x0123456789abcdef"sv, 0x0123456789abcdef);
+	parse_expected_value(FILE_LINE_ARGS, "0x1234_5678_9ABC_DEF0"sv, 0x123456789ABCDEF0);
+	parse_expected_value(FILE_LINE_ARGS, "0x0000000000000000000000007FFFFFFFFFFFFFFF"sv, INT64_MAX);
+	parse_expected_value(FILE_LINE_ARGS, "0o0000000000000000000000777777777777777777777"sv, INT64_MAX);
+	parse_expected_value(FILE_LINE_ARGS, "0o1234567_01234567"sv, 0123456701234567);
+	parse_expected_value(FILE_LINE_ARGS,
+						 "0b0000000000000000000000000000000000000000000000000000000000000000000001"sv,
+						 1);
+	parse_expected_value(FILE_LINE_ARGS, "0b10101010_01010101_11110000"sv, 0b101010100101010111110000);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 0xFEDCBA98_76543210"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 0x12345678g"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 0o123456781"sv);
+	parsing_should_fail(FILE_LINE_ARGS, "val = 0b101010102"sv);
 }
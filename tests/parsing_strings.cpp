@@ -208,4 +208,45 @@ str = ''''That's still pointless', she said.'''
 	parsing_should_fail(FILE_LINE_ARGS, R"(v= '''''' '''       )"sv);
 	parse_expected_value(FILE_LINE_ARGS, R"( """""\""""""     )"sv, R"(""""")"sv);
 	parse_expected_value(FILE_LINE_ARGS, R"( """""\"""\"""""" )"sv, R"("""""""")"sv);
+
+	// runs of plain characters of various lengths either side of special characters
+	// (the parser consumes these in bulk when it can)
+	for (size_t i = 0; i < 40u; i++)
+	{
+		INFO("run length: "sv << i);
+		const auto run = std::string(i, 'a') + std::string(i % 3u, ' ') + std::string(i % 2u, '\t');
+
+		parse_expected_value(FILE_LINE_ARGS, "\""s + run + "\\t" + run + "\"", run + "\t" + run);
+		parse_expected_value(FILE_LINE_ARGS,
+							 "\""s + run + "\xC3\xA9" + run + "\\\"" + run + "\"",
+							 run + "\xC3\xA9" + run + "\"" + run);
+		parse_expected_value(FILE_LINE_ARGS, "'"s + run + "\\n" + run + "'", run + "\\n" + run);
+		parsing_should_succeed(FILE_LINE_ARGS,
+							   "a = \"\"\"\n"s + run + "\n" + run + "\\\n   " + run + "\"\"\"\n" //
+								   + "b = '''\n" + run + "\n" + run + "''" + run + "'''",
+							   [&](table&& tbl)
+							   {
+								   CHECK(tbl["a"] == run + "\n" + run + run);
+								   CHECK(tbl["b"] == run + "\n" + run + "''" + run);
+							   });
+
+		parsing_should_succeed(FILE_LINE_ARGS,
+							   "\""s + run + "\" = 1\n'" + run + "x' = 2",
+							   [&](table&& tbl)
+							   {
+								   CHECK(tbl[run] == 1);
+								   CHECK(tbl[run + "x"] == 2);
+							   });
+
+		const auto error_column = static_cast<source_index>(6u + run.length());
+		parsing_should_fail(FILE_LINE_ARGS, "s = \""s + run + "\x01\"", 1u, error_column);
+		parsing_should_fail(FILE_LINE_ARGS, "s = '"s + run + "\x7F'", 1u, error_column);
+		parsing_should_fail(FILE_LINE_ARGS, "s = \""s + run + "\n\"", 1u, error_column);
+		parsing_should_fail(FILE_LINE_ARGS, "s = \""s + run, 1u, error_column);
+
+		// invalid UTF-8 is reported at the last character before it, even when that was skipped in bulk
+		// (kept within the first 32 bytes so the stream reader's block boundaries don't come into play)
+		if (run.length() < 27u)
+			parsing_should_fail(FILE_LINE_ARGS, "s = \""s + run + "\xFF\"", 1u, error_column - 1u);
+	}
 }
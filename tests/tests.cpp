@@ -5,6 +5,33 @@
 
 #include "tests.hpp"
 
+namespace
+{
+	// hands documents over a few bytes at a time, so they straddle the byte source reader's chunks and blocks
+	struct trickling_byte_source
+	{
+		std::string_view remaining;
+
+		size_t operator()(char* buffer, size_t capacity) noexcept
+		{
+			const auto count = (std::min)((std::min)(remaining.length(), capacity), size_t{ 7 });
+			std::memcpy(buffer, remaining.data(), count);
+			remaining.remove_prefix(count);
+			return count;
+		}
+	};
+
+	// feeds documents to a push parser a few bytes at a time, so they're split in awkward places
+	parse_result parse_in_pieces(std::string_view toml_str, std::string_view source_path = {})
+	{
+		push_parser parser{ source_path };
+		for (; toml_str.length() > 5u; toml_str.remove_prefix(5u))
+			parser.feed(toml_str.substr(0u, 5u));
+		parser.feed(toml_str);
+		return parser.finish();
+	}
+}
+
 bool parsing_should_succeed(std::string_view test_file,
 							uint32_t test_line,
 							std::string_view toml_str,
@@ -49,6 +76,28 @@ bool parsing_should_succeed(std::string_view test_file,
 			else
 				validate_table(toml::parse(ss, source_path), source_path);
 		}
+		{
+			INFO("Parsing from a byte source"sv)
+			trickling_byte_source source{ toml_str };
+			if (func)
+				func(validate_table(toml::parse(byte_source{ source, 32u }, source_path), source_path));
+			else
+				validate_table(toml::parse(byte_source{ source, 32u }, source_path), source_path);
+		}
+		{
+			INFO("Parsing with a push parser"sv)
+			if (func)
+				func(validate_table(parse_in_pieces(toml_str, source_path), source_path));
+			else
+				validate_table(parse_in_pieces(toml_str, source_path), source_path);
+		}
+		{
+			INFO("Parsing string directly into an arena"sv)
+			if (func)
+				func(validate_table(toml::parse(toml_str, source_path, parse_flags::arena_allocation), source_path));
+			else
+				validate_table(toml::parse(toml_str, source_path, parse_flags::arena_allocation), source_path);
+		}
 	}
 	catch (const parse_error& err)
 	{
@@ -97,11 +146,71 @@ bool parsing_should_succeed(std::string_view test_file,
 		}
 	}
 
+	{
+		INFO("Parsing from a byte source"sv)
+		trickling_byte_source source{ toml_str };
+		parse_result result = toml::parse(byte_source{ source, 32u }, source_path);
+		if (result)
+		{
+			if (func)
+				func(validate_table(std::move(result), source_path));
+			else
+				validate_table(std::move(result), source_path);
+		}
+		else
+		{
+			FORCE_FAIL("Parse error on line "sv << result.error().source().begin.line << ", column "sv
+												<< result.error().source().begin.column << ":\n"sv
+												<< result.error().description());
+		}
+	}
+
+	{
+		INFO("Parsing with a push parser"sv)
+		parse_result result = parse_in_pieces(toml_str, source_path);
+		if (result)
+		{
+			if (func)
+				func(validate_table(std::move(result), source_path));
+			else
+				validate_table(std::move(result), source_path);
+		}
+		else
+		{
+			FORCE_FAIL("Parse error on line "sv << result.error().source().begin.line << ", column "sv
+												<< result.error().source().begin.column << ":\n"sv
+												<< result.error().description());
+		}
+	}
+
+	{
+		INFO("Parsing string directly into an arena"sv)
+		parse_result result = toml::parse(toml_str, source_path, parse_flags::arena_allocation);
+		if (result)
+		{
+			if (func)
+				func(validate_table(std::move(result), source_path));
+			else
+				validate_table(std::move(result), source_path);
+		}
+		else
+		{
+			FORCE_FAIL("Parse error on line "sv << result.error().source().begin.line << ", column "sv
+												<< result.error().source().begin.column << ":\n"sv
+												<< result.error().description());
+		}
+	}
+
 #endif
 
 	return true;
 }
 
+table parse_or_fail(std::string_view toml_str, std::string_view source_path, parse_flags flags)
+{
+	return parse_or_fail([&] { return toml::parse(toml_str, source_path, flags); });
+}
+
 bool parsing_should_fail(std::string_view test_file,
 						 uint32_t test_line,
 						 std::string_view toml_str,
@@ -165,6 +274,18 @@ bool parsing_should_fail(std::string_view test_file,
 						   ss.write(toml_str.data(), static_cast<std::streamsize>(toml_str.length()));
 						   [[maybe_unused]] auto res = toml::parse(ss);
 					   });
+	result = result
+		  && run_tests(expected_failure_line,
+					   expected_failure_column,
+					   [=]()
+					   {
+						   trickling_byte_source source{ toml_str };
+						   [[maybe_unused]] auto res = toml::parse(byte_source{ source, 32u });
+					   });
+	result = result
+		  && run_tests(expected_failure_line,
+					   expected_failure_column,
+					   [=]() { [[maybe_unused]] auto res = parse_in_pieces(toml_str); });
 	return result;
 
 #else
@@ -200,7 +321,17 @@ bool parsing_should_fail(std::string_view test_file,
 						 std::stringstream ss;
 						 ss.write(toml_str.data(), static_cast<std::streamsize>(toml_str.length()));
 						 return toml::parse(ss);
-					 });
+					 })
+		&& run_tests(expected_failure_line,
+					 expected_failure_column,
+					 [=]()
+					 {
+						 trickling_byte_source source{ toml_str };
+						 return toml::parse(byte_source{ source, 32u });
+					 })
+		&& run_tests(expected_failure_line,
+					 expected_failure_column,
+					 [=]() { return parse_in_pieces(toml_str); });
 
 #endif
 }
@@ -133,6 +133,32 @@ bool parsing_should_fail(std::string_view test_file,
 						 source_index expected_failure_line	  = static_cast<source_index>(-1),
 						 source_index expected_failure_column = static_cast<source_index>(-1));
 
+// runs a parse that's expected to succeed (e.g. [&]{ return toml::parse_file(path); }), failing the test if it doesn't
+template <typename Func, typename = std::enable_if_t<std::is_invocable_v<Func&&>>>
+table parse_or_fail(Func&& parse_func)
+{
+#if TOML_EXCEPTIONS
+	try
+	{
+		return static_cast<Func&&>(parse_func)();
+	}
+	catch (const parse_error& err)
+	{
+		FORCE_FAIL("parsing failed: "sv << err);
+	}
+	return {};
+#else
+	auto result = static_cast<Func&&>(parse_func)();
+	if (!result)
+		FORCE_FAIL("parsing failed: "sv << result.error());
+	return std::move(result).table();
+#endif
+}
+
+table parse_or_fail(std::string_view toml_str,
+					std::string_view source_path = {},
+					parse_flags flags			 = parse_flags::none);
+
 TOML_PURE_GETTER
 constexpr std::string_view trim_file_path(std::string_view sv) noexcept
 {
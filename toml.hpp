@@ -1036,6 +1036,29 @@
 #define TOML_ENABLE_SIMD 1
 #endif
 
+// polymorphic allocators
+#if (defined(TOML_ENABLE_PMR) && TOML_ENABLE_PMR) || TOML_INTELLISENSE
+#undef TOML_ENABLE_PMR
+#define TOML_ENABLE_PMR 1
+#endif
+#ifndef TOML_ENABLE_PMR
+#define TOML_ENABLE_PMR 0
+#endif
+
+#if !TOML_HAS_INCLUDE(<memory_resource>)
+#undef TOML_ENABLE_PMR
+#define TOML_ENABLE_PMR 0
+#endif
+
+// flat tables
+#if (defined(TOML_ENABLE_FLAT_TABLES) && TOML_ENABLE_FLAT_TABLES) || TOML_INTELLISENSE
+#undef TOML_ENABLE_FLAT_TABLES
+#define TOML_ENABLE_FLAT_TABLES 1
+#endif
+#ifndef TOML_ENABLE_FLAT_TABLES
+#define TOML_ENABLE_FLAT_TABLES 0
+#endif
+
 // windows compat
 #if !defined(TOML_ENABLE_WINDOWS_COMPAT) && defined(TOML_WINDOWS_COMPAT) // was TOML_WINDOWS_COMPAT pre-3.0
 #define TOML_ENABLE_WINDOWS_COMPAT TOML_WINDOWS_COMPAT
@@ -1409,6 +1432,14 @@ TOML_NAMESPACE_START
 }
 TOML_NAMESPACE_END;
 
+//********  impl/std_memory_resource.hpp  ******************************************************************************
+
+#if TOML_ENABLE_PMR
+TOML_DISABLE_WARNINGS;
+#include <memory_resource>
+TOML_ENABLE_WARNINGS;
+#endif
+
 //********  impl/forward_declarations.hpp  *****************************************************************************
 
 TOML_DISABLE_WARNINGS;
@@ -1496,8 +1527,12 @@ TOML_NAMESPACE_START
 	class node_view;
 
 	class key;
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
 	class array;
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 	class table;
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	template <typename>
 	class value;
 
@@ -1508,21 +1543,59 @@ TOML_NAMESPACE_START
 	class yaml_formatter;
 
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 #if TOML_EXCEPTIONS
 	using parse_result = table;
 #else
 	class parse_result;
 #endif
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 }
 TOML_NAMESPACE_END;
 
 TOML_IMPL_NAMESPACE_START
 {
-	using node_ptr = std::unique_ptr<node>;
+	class node_arena;
+
+#if TOML_ENABLE_PMR
+	using memory_resource = std::pmr::memory_resource;
+	using node_allocator  = std::pmr::polymorphic_allocator<std::byte>;
+
+	template <typename T>
+	inline constexpr bool is_node_allocator_arg = std::is_convertible_v<T, node_allocator>;
+#else
+	class memory_resource; // never defined; without TOML_ENABLE_PMR every resource pointer is null
+
+	template <typename T>
+	inline constexpr bool is_node_allocator_arg = false;
+#endif
+
+	enum class node_storage : uint8_t
+	{
+		heap,	 // new/delete
+		arena,	 // a node_arena
+		resource // a memory_resource (TOML_ENABLE_PMR), with a resource_node_header in front of the node
+	};
+
+	struct node_deleter
+	{
+		void operator()(node*) const noexcept;
+	};
+	using node_ptr = std::unique_ptr<node, node_deleter>;
+
+	template <typename T, typename... Args>
+	T* create_node(memory_resource*, Args&&...);
 
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, impl_ex, impl_noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, impl_pmralloc, impl_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+	template <typename>
 	class parser;
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 
 	// clang-format off
@@ -1663,6 +1736,17 @@ TOML_NAMESPACE_START // abi namespace
 	};
 	TOML_MAKE_FLAGS(format_flags);
 
+	enum class TOML_CLOSED_FLAGS_ENUM parse_flags : uint32_t
+	{
+		none,
+		arena_allocation = (1u << 0),
+		no_source_tracking = (1u << 1),
+		packed_arrays = (1u << 2),
+		compact_arrays = (1u << 3),
+		borrowed_strings = (1u << 4),
+	};
+	TOML_MAKE_FLAGS(parse_flags);
+
 	template <typename T>
 	struct TOML_TRIVIAL_ABI inserter
 	{
@@ -2543,6 +2627,8 @@ TOML_NAMESPACE_START
 
 		source_index column;
 
+		source_index offset = {};
+
 		TOML_PURE_GETTER
 		explicit constexpr operator bool() const noexcept
 		{
@@ -3631,6 +3717,224 @@ TOML_DISABLE_WARNINGS;
 #include <utility>
 TOML_ENABLE_WARNINGS;
 
+//********  impl/std_atomic.hpp  ***************************************************************************************
+
+TOML_DISABLE_WARNINGS;
+#include <atomic>
+TOML_ENABLE_WARNINGS;
+
+//********  impl/node_arena.hpp  ***************************************************************************************
+
+TOML_PUSH_WARNINGS;
+#ifdef _MSC_VER
+#ifndef __clang__
+#pragma inline_recursion(on)
+#endif
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+#endif
+
+TOML_IMPL_NAMESPACE_START
+{
+	// a monotonic allocator for the nodes, long keys and long strings of a single document
+	// (see parse_flags::arena_allocation).
+	// memory is handed out from a chain of geometrically-growing blocks and only released when the arena is destroyed;
+	// nodes created in it still have their destructors run (by node_deleter), they just don't free anything.
+	//
+	// the arena is reference-counted (see arena_ref) by the root table and every table, array and long string value
+	// using memory in it, so moving any of them out of the document keeps it alive for as long as they need it.
+	class TOML_EXPORTED_CLASS node_arena
+	{
+	  private:
+		struct block
+		{
+			block* next;
+		};
+
+		friend class arena_ref;
+		std::atomic<size_t> refs_ = {};
+
+		static constexpr size_t initial_block_size = 4u * 1024u;
+		static constexpr size_t max_block_size	   = 1024u * 1024u;
+
+		block* blocks_			= {};
+		char* cursor_			= {};
+		char* end_				= {};
+		size_t next_block_size_ = initial_block_size;
+		size_t reserved_		= {};
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void* allocate_from_new_block(size_t size, size_t align);
+
+	  public:
+		TOML_NODISCARD_CTOR
+		node_arena() noexcept = default;
+
+		// starts with a block of 'size_hint' bytes (e.g. what a similar document needed last time) rather than working
+		// up to it from a small one
+		TOML_NODISCARD_CTOR
+		explicit node_arena(size_t size_hint) noexcept //
+			: next_block_size_{ size_hint > initial_block_size ? size_hint : initial_block_size }
+		{}
+
+		node_arena(const node_arena&)			 = delete;
+		node_arena& operator=(const node_arena&) = delete;
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		~node_arena() noexcept;
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		void* allocate(size_t size, size_t align)
+		{
+			TOML_ASSERT_ASSUME(align && !(align & (align - 1u)));
+
+			const auto addr	   = reinterpret_cast<uintptr_t>(cursor_);
+			const auto aligned = (addr + (align - 1u)) & ~static_cast<uintptr_t>(align - 1u);
+			if TOML_LIKELY(cursor_ && aligned + size <= reinterpret_cast<uintptr_t>(end_))
+			{
+				cursor_ += (aligned - addr) + size;
+				return reinterpret_cast<void*>(aligned);
+			}
+			return allocate_from_new_block(size, align);
+		}
+
+		template <typename T, typename... Args>
+		TOML_NODISCARD
+		T* create(Args&&... args);
+
+		// copies text into the arena (for long keys, which only ever move along with the table holding them)
+		TOML_NODISCARD
+		std::string_view copy(std::string_view text)
+		{
+			const auto str = static_cast<char*>(allocate(text.length(), 1u));
+			std::char_traits<char>::copy(str, text.data(), text.length());
+			return { str, text.length() };
+		}
+
+		// copies text into the arena behind a pointer back to the arena, so a string value moved out of the document
+		// can find it again (see of())
+		TOML_NODISCARD
+		std::string_view copy_string(std::string_view text)
+		{
+			const auto header = static_cast<node_arena**>(
+				allocate(sizeof(node_arena*) + text.length(), alignof(node_arena*)));
+			*header			  = this;
+			const auto str	  = reinterpret_cast<char*>(header + 1);
+			std::char_traits<char>::copy(str, text.data(), text.length());
+			return { str, text.length() };
+		}
+
+		// the arena holding text from copy_string()
+		TOML_PURE_INLINE_GETTER
+		static node_arena* of(std::string_view copied_string) noexcept
+		{
+			return reinterpret_cast<node_arena* const*>(copied_string.data())[-1];
+		}
+
+		// total bytes of block storage obtained from the global heap
+		TOML_PURE_INLINE_GETTER
+		size_t reserved() const noexcept
+		{
+			return reserved_;
+		}
+
+		// bytes of block storage handed out so far (give or take the unused ends of previous blocks)
+		TOML_PURE_INLINE_GETTER
+		size_t used() const noexcept
+		{
+			return reserved_ - static_cast<size_t>(end_ - cursor_);
+		}
+	};
+
+	// a counted reference to a node_arena; the arena is destroyed along with the last one
+	class arena_ref
+	{
+	  private:
+		node_arena* arena_ = {};
+
+	  public:
+		TOML_NODISCARD_CTOR
+		arena_ref() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		explicit arena_ref(node_arena* arena) noexcept //
+			: arena_{ arena }
+		{
+			if (arena_)
+				arena_->refs_.fetch_add(1u, std::memory_order_relaxed);
+		}
+
+		TOML_NODISCARD_CTOR
+		arena_ref(const arena_ref& other) noexcept //
+			: arena_ref{ other.arena_ }
+		{}
+
+		TOML_NODISCARD_CTOR
+		arena_ref(arena_ref&& other) noexcept //
+			: arena_{ std::exchange(other.arena_, nullptr) }
+		{}
+
+		arena_ref& operator=(arena_ref rhs) noexcept
+		{
+			std::swap(arena_, rhs.arena_);
+			return *this;
+		}
+
+		~arena_ref() noexcept
+		{
+			reset();
+		}
+
+		// (for things holding a reference without an arena_ref of their own, e.g. a string value's borrowed text)
+		TOML_NODISCARD
+		static arena_ref adopt(node_arena* arena) noexcept
+		{
+			arena_ref ref;
+			ref.arena_ = arena;
+			return ref;
+		}
+
+		TOML_NODISCARD
+		node_arena* detach() noexcept
+		{
+			return std::exchange(arena_, nullptr);
+		}
+
+		void reset() noexcept
+		{
+			// (this might be in the arena itself, so it's cleared before the arena can go)
+			const auto arena = detach();
+			if (arena && arena->refs_.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+				delete arena;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		node_arena* get() const noexcept
+		{
+			return arena_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		explicit operator bool() const noexcept
+		{
+			return !!arena_;
+		}
+	};
+}
+TOML_IMPL_NAMESPACE_END;
+
+#ifdef _MSC_VER
+#pragma pop_macro("min")
+#pragma pop_macro("max")
+#ifndef __clang__
+#pragma inline_recursion(off)
+#endif
+#endif
+TOML_POP_WARNINGS;
+
 //********  impl/node.hpp  *********************************************************************************************
 
 TOML_PUSH_WARNINGS;
@@ -3660,8 +3964,15 @@ TOML_NAMESPACE_START
 	{
 	  private:
 
+		template <typename>
 		friend class TOML_PARSER_TYPENAME;
+		friend class impl::node_arena;
+		friend struct impl::node_deleter;
+		template <typename T, typename... Args>
+		friend T* impl::create_node(impl::memory_resource*, Args&&...);
 		source_region source_{};
+		impl::node_storage storage_ = impl::node_storage::heap; // describes the node, not its value; never copied
+		node_type type_;										 // set by the derived type's constructors; never changes
 
 		template <typename T>
 		TOML_NODISCARD
@@ -3706,7 +4017,7 @@ TOML_NAMESPACE_START
 
 	  protected:
 		TOML_EXPORTED_MEMBER_FUNCTION
-		node() noexcept;
+		explicit node(node_type type) noexcept;
 
 		TOML_EXPORTED_MEMBER_FUNCTION
 		node(const node&) noexcept;
@@ -3720,6 +4031,13 @@ TOML_NAMESPACE_START
 		TOML_EXPORTED_MEMBER_FUNCTION
 		node& operator=(node&&) noexcept;
 
+		// true if the node lives in a node_arena (see parse_flags::arena_allocation)
+		TOML_PURE_INLINE_GETTER
+		bool arena_allocated() const noexcept
+		{
+			return storage_ == impl::node_storage::arena;
+		}
+
 		template <typename T, typename N>
 		using ref_cast_type_ = std::conditional_t<											  //
 			std::is_reference_v<T>,															  //
@@ -3795,44 +4113,80 @@ TOML_NAMESPACE_START
 			return is_homogeneous(impl::node_type_of<type>);
 		}
 
-		TOML_PURE_GETTER
-		virtual node_type type() const noexcept TOML_NVCC_WORKAROUND;
+		TOML_PURE_INLINE_GETTER
+		node_type type() const noexcept
+		{
+			return type_;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_table() const noexcept TOML_NVCC_WORKAROUND;
+		TOML_PURE_INLINE_GETTER
+		bool is_table() const noexcept
+		{
+			return type_ == node_type::table;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_array() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_array() const noexcept
+		{
+			return type_ == node_type::array;
+		}
 
 		TOML_PURE_GETTER
 		virtual bool is_array_of_tables() const noexcept TOML_NVCC_WORKAROUND;
 
-		TOML_PURE_GETTER
-		virtual bool is_value() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_value() const noexcept
+		{
+			return type_ >= node_type::string;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_string() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_string() const noexcept
+		{
+			return type_ == node_type::string;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_integer() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_integer() const noexcept
+		{
+			return type_ == node_type::integer;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_floating_point() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_floating_point() const noexcept
+		{
+			return type_ == node_type::floating_point;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_number() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_number() const noexcept
+		{
+			return type_ == node_type::integer || type_ == node_type::floating_point;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_boolean() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_boolean() const noexcept
+		{
+			return type_ == node_type::boolean;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_date() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_date() const noexcept
+		{
+			return type_ == node_type::date;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_time() const noexcept
+		{
+			return type_ == node_type::time;
+		}
 
-		TOML_PURE_GETTER
-		virtual bool is_date_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		bool is_date_time() const noexcept
+		{
+			return type_ == node_type::date_time;
+		}
 
 		template <typename T>
 		TOML_PURE_INLINE_GETTER
@@ -3864,59 +4218,113 @@ TOML_NAMESPACE_START
 			TOML_UNREACHABLE;
 		}
 
-		TOML_PURE_GETTER
-		virtual table* as_table() noexcept = 0;
-
-		TOML_PURE_GETTER
-		virtual array* as_array() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		table* as_table() noexcept
+		{
+			return type_ == node_type::table ? &ref_cast<table>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual toml::value<std::string>* as_string() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		array* as_array() noexcept
+		{
+			return type_ == node_type::array ? &ref_cast<array>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual toml::value<int64_t>* as_integer() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<std::string>* as_string() noexcept
+		{
+			return type_ == node_type::string ? &ref_cast<std::string>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual toml::value<double>* as_floating_point() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<int64_t>* as_integer() noexcept
+		{
+			return type_ == node_type::integer ? &ref_cast<int64_t>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual toml::value<bool>* as_boolean() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<double>* as_floating_point() noexcept
+		{
+			return type_ == node_type::floating_point ? &ref_cast<double>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual toml::value<date>* as_date() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<bool>* as_boolean() noexcept
+		{
+			return type_ == node_type::boolean ? &ref_cast<bool>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual toml::value<time>* as_time() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<date>* as_date() noexcept
+		{
+			return type_ == node_type::date ? &ref_cast<date>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual toml::value<date_time>* as_date_time() noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<time>* as_time() noexcept
+		{
+			return type_ == node_type::time ? &ref_cast<time>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const table* as_table() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		toml::value<date_time>* as_date_time() noexcept
+		{
+			return type_ == node_type::date_time ? &ref_cast<date_time>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const array* as_array() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const table* as_table() const noexcept
+		{
+			return type_ == node_type::table ? &ref_cast<table>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const toml::value<std::string>* as_string() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const array* as_array() const noexcept
+		{
+			return type_ == node_type::array ? &ref_cast<array>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const toml::value<int64_t>* as_integer() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<std::string>* as_string() const noexcept
+		{
+			return type_ == node_type::string ? &ref_cast<std::string>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const toml::value<double>* as_floating_point() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<int64_t>* as_integer() const noexcept
+		{
+			return type_ == node_type::integer ? &ref_cast<int64_t>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const toml::value<bool>* as_boolean() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<double>* as_floating_point() const noexcept
+		{
+			return type_ == node_type::floating_point ? &ref_cast<double>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const toml::value<date>* as_date() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<bool>* as_boolean() const noexcept
+		{
+			return type_ == node_type::boolean ? &ref_cast<bool>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const toml::value<time>* as_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<date>* as_date() const noexcept
+		{
+			return type_ == node_type::date ? &ref_cast<date>() : nullptr;
+		}
 
-		TOML_PURE_GETTER
-		virtual const toml::value<date_time>* as_date_time() const noexcept = 0;
+		TOML_PURE_INLINE_GETTER
+		const toml::value<time>* as_time() const noexcept
+		{
+			return type_ == node_type::time ? &ref_cast<time>() : nullptr;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const toml::value<date_time>* as_date_time() const noexcept
+		{
+			return type_ == node_type::date_time ? &ref_cast<date_time>() : nullptr;
+		}
 
 		template <typename T>
 		TOML_PURE_INLINE_GETTER
@@ -4250,6 +4658,110 @@ TOML_IMPL_NAMESPACE_START
 	TOML_PURE_GETTER
 	TOML_EXPORTED_FREE_FUNCTION
 	bool TOML_CALLCONV node_deep_equality(const node*, const node*) noexcept;
+
+#if TOML_ENABLE_PMR
+
+	// prefixed to nodes allocated from a memory_resource so node_deleter knows where to give the memory back
+	struct resource_node_header
+	{
+		memory_resource* resource;
+		size_t size;
+	};
+
+	inline constexpr size_t resource_node_alignment = alignof(std::max_align_t);
+	inline constexpr size_t resource_node_header_size =
+		(sizeof(resource_node_header) + resource_node_alignment - 1u) & ~(resource_node_alignment - 1u);
+
+#endif
+
+	TOML_ALWAYS_INLINE
+	void node_deleter::operator()(node* n) const noexcept
+	{
+		switch (n->storage_)
+		{
+			case node_storage::heap: delete n; return;
+
+			// nodes in an arena are destroyed in-place; their storage goes away with the arena
+			case node_storage::arena: n->~node(); return;
+
+#if TOML_ENABLE_PMR
+			case node_storage::resource:
+			{
+				const auto header = reinterpret_cast<resource_node_header*>(reinterpret_cast<char*>(n)
+																			- resource_node_header_size);
+				const auto resource = header->resource;
+				const auto size		= header->size;
+				n->~node();
+				resource->deallocate(header, size, resource_node_alignment);
+				return;
+			}
+#endif
+
+			default: TOML_UNREACHABLE;
+		}
+	}
+
+	template <typename T, typename... Args>
+	T* node_arena::create(Args&&... args)
+	{
+		static_assert(std::is_base_of_v<node, T>);
+
+		T* n		= ::new (allocate(sizeof(T), alignof(T))) T{ static_cast<Args&&>(args)... };
+		n->storage_ = node_storage::arena;
+		return n;
+	}
+
+	template <typename T, typename... Args>
+	T* create_node([[maybe_unused]] memory_resource* resource, Args&&... args)
+	{
+		static_assert(std::is_base_of_v<node, T>);
+
+#if TOML_ENABLE_PMR
+		if (resource && resource != std::pmr::new_delete_resource())
+		{
+			static_assert(alignof(T) <= resource_node_alignment);
+
+			constexpr size_t size = resource_node_header_size + sizeof(T);
+			const auto header	  = ::new (resource->allocate(size, resource_node_alignment))
+				resource_node_header{ resource, size };
+			void* const storage = reinterpret_cast<char*>(header) + resource_node_header_size;
+
+			T* n;
+#if TOML_COMPILER_HAS_EXCEPTIONS
+			try
+			{
+#endif
+				// containers take the resource with them so their own children end up there too
+				if constexpr (is_one_of<T, table, array>)
+				{
+					if constexpr (sizeof...(Args) == 0u)
+						n = ::new (storage) T(node_allocator{ resource });
+					else if constexpr (sizeof...(Args) == 1u && (std::is_same_v<remove_cvref<Args>, T> && ...))
+						n = ::new (storage) T(static_cast<Args&&>(args)..., node_allocator{ resource });
+					else
+						n = ::new (storage) T(T(static_cast<Args&&>(args)...), node_allocator{ resource });
+				}
+				else
+					n = ::new (storage) T{ static_cast<Args&&>(args)... };
+#if TOML_COMPILER_HAS_EXCEPTIONS
+			}
+			catch (...)
+			{
+				resource->deallocate(header, size, resource_node_alignment);
+				throw;
+			}
+#endif
+			TOML_ASSERT(static_cast<void*>(static_cast<node*>(n)) == storage);
+			n->storage_ = node_storage::resource;
+			return n;
+		}
+#endif
+
+		if constexpr (is_one_of<T, table, array>)
+			return new T(static_cast<Args&&>(args)...);
+		else
+			return new T{ static_cast<Args&&>(args)... };
+	}
 }
 TOML_IMPL_NAMESPACE_END;
 
@@ -4951,6 +5463,65 @@ TOML_IMPL_NAMESPACE_START
 
 #endif // TOML_HAS_CHAR8 || TOML_ENABLE_WINDOWS_COMPAT
 
+	// the text of a string value borrowed from the source document or its arena (see parse_flags::borrowed_strings
+	// and arena_allocation).
+	// shares storage with the value's std::string, so it's empty for every other type of value.
+	template <typename T>
+	struct borrowed_text
+	{};
+
+	template <>
+	struct borrowed_text<std::string>
+	{
+		std::string_view text;
+		mutable std::atomic<std::string*> copy = {}; // made the first time something needs a std::string
+
+		TOML_NODISCARD_CTOR
+		explicit borrowed_text(std::string_view txt) noexcept //
+			: text{ txt }
+		{}
+
+		TOML_NODISCARD_CTOR
+		borrowed_text(borrowed_text&& other) noexcept //
+			: text{ other.text },
+			  copy{ other.copy.exchange(nullptr, std::memory_order_relaxed) }
+		{}
+
+		borrowed_text(const borrowed_text&)			   = delete;
+		borrowed_text& operator=(const borrowed_text&) = delete;
+		borrowed_text& operator=(borrowed_text&&)	   = delete;
+
+		~borrowed_text() noexcept
+		{
+			delete copy.load(std::memory_order_relaxed);
+		}
+
+		TOML_NODISCARD
+		std::string_view view() const noexcept
+		{
+			if (const auto str = copy.load(std::memory_order_acquire))
+				return *str;
+			return text;
+		}
+
+		// const member functions of values can get here, so other threads may be racing to make the copy too
+		TOML_NODISCARD
+		std::string& get() const
+		{
+			auto str = copy.load(std::memory_order_acquire);
+			if (!str)
+			{
+				auto fresh = new std::string{ text };
+				if (copy.compare_exchange_strong(str, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+					str = fresh;
+				else
+					delete fresh;
+			}
+			return *str;
+		}
+	};
+	static_assert(sizeof(borrowed_text<std::string>) <= sizeof(std::string));
+
 	template <typename T>
 	TOML_CONST_GETTER
 	inline optional<T> node_integer_cast(int64_t val) noexcept
@@ -5001,6 +5572,7 @@ TOML_NAMESPACE_START
 
 	  private:
 
+		template <typename>
 		friend class TOML_PARSER_TYPENAME;
 
 		template <typename T, typename U>
@@ -5013,8 +5585,131 @@ TOML_NAMESPACE_START
 				return nullptr;
 		}
 
-		ValueType val_;
+		union
+		{
+			ValueType val_;
+			impl::borrowed_text<ValueType> borrowed_; // used instead of val_ when is_borrowed_ is set
+		};
 		value_flags flags_ = value_flags::none;
+		bool is_borrowed_  = false; // only set by the parser (see parse_flags::borrowed_strings and arena_allocation)
+		bool in_arena_	   = false; // borrowed_ is text in a document's arena, which the value holds a reference to
+
+		static constexpr bool access_is_nothrow = !std::is_same_v<ValueType, std::string>;
+
+		// a string's text is only reached through these, which are kept out of line so that inlining node::value<T>()
+		// etc. for a value of some other (smaller) type never has the compiler following a path into is_borrowed_ and
+		// borrowed_ (which lie past the end of it) and warning about the access
+		TOML_NEVER_INLINE
+		std::string& string_val() const
+		{
+			if TOML_UNLIKELY(is_borrowed_)
+				return borrowed_.get();
+			return const_cast<std::string&>(val_);
+		}
+
+		TOML_NEVER_INLINE
+		std::string_view string_view_val() const noexcept
+		{
+			return is_borrowed_ ? borrowed_.view() : std::string_view{ val_ };
+		}
+
+		// the stored value (a borrowed string is copied the first time it's needed as a std::string)
+		TOML_ALWAYS_INLINE
+		ValueType& val() noexcept(access_is_nothrow)
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+				return string_val();
+			else
+				return val_;
+		}
+
+		TOML_ALWAYS_INLINE
+		const ValueType& val() const noexcept(access_is_nothrow)
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+				return string_val();
+			else
+				return val_;
+		}
+
+		// the stored value, or a view of a string's text (without copying a borrowed one)
+		TOML_PURE_INLINE_GETTER
+		decltype(auto) val_view() const noexcept
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+				return string_view_val();
+			else
+				return (val_);
+		}
+
+		// refers to text owned by something else: the source document, or a document's arena (text from
+		// node_arena::copy_string(), in which case the value keeps the arena alive until it's done with it)
+		void borrow(std::string_view text, bool in_arena = false) noexcept
+		{
+			static_assert(std::is_same_v<ValueType, std::string>);
+			TOML_ASSERT(!is_borrowed_);
+
+			val_.~basic_string();
+			::new (static_cast<void*>(&borrowed_)) impl::borrowed_text<std::string>{ text };
+			is_borrowed_ = true;
+			if (in_arena)
+			{
+				static_cast<void>(impl::arena_ref{ impl::node_arena::of(text) }.detach());
+				in_arena_ = true;
+			}
+		}
+
+		void destroy_borrowed() noexcept
+		{
+			const auto arena = in_arena_ ? impl::node_arena::of(borrowed_.text) : nullptr;
+			borrowed_.~borrowed_text();
+			is_borrowed_ = false;
+			in_arena_	 = false;
+			impl::arena_ref::adopt(arena).reset();
+		}
+
+		// replaces a borrowed string with one the value owns
+		void own(std::string&& str) noexcept
+		{
+			static_assert(std::is_same_v<ValueType, std::string>);
+			TOML_ASSERT(is_borrowed_);
+
+			std::string owned{ std::move(str) }; // str might belong to borrowed_
+			destroy_borrowed();
+			::new (static_cast<void*>(&val_)) std::string{ std::move(owned) };
+		}
+
+		// constructs val_ (or borrowed_) from another value's (for the move constructors)
+		void take_val(value& other) noexcept
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+			{
+				if (other.is_borrowed_)
+				{
+					// (along with the reference to the arena, if the text is in one)
+					::new (static_cast<void*>(&borrowed_))
+						impl::borrowed_text<std::string>{ std::move(other.borrowed_) };
+					is_borrowed_		 = true;
+					in_arena_			 = std::exchange(other.in_arena_, false);
+					other.borrowed_.text = {};
+					return;
+				}
+			}
+			::new (static_cast<void*>(&val_)) ValueType{ std::move(other.val_) };
+		}
+
+		void destroy_val() noexcept
+		{
+			if constexpr (std::is_same_v<ValueType, std::string>)
+			{
+				if (is_borrowed_)
+				{
+					destroy_borrowed();
+					return;
+				}
+			}
+			val_.~ValueType();
+		}
 
 	  public:
 
@@ -5032,7 +5727,8 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		explicit value(Args&&... args) noexcept(noexcept(value_type(
 			impl::native_value_maker<value_type, std::decay_t<Args>...>::make(static_cast<Args&&>(args)...))))
-			: val_(impl::native_value_maker<value_type, std::decay_t<Args>...>::make(static_cast<Args&&>(args)...))
+			: node(impl::node_type_of<value_type>),
+			  val_(impl::native_value_maker<value_type, std::decay_t<Args>...>::make(static_cast<Args&&>(args)...))
 		{
 #if TOML_LIFETIME_HOOKS
 			TOML_VALUE_CREATED;
@@ -5042,7 +5738,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(const value& other) noexcept //
 			: node(other),
-			  val_{ other.val_ },
+			  val_(other.val_view()),
 			  flags_{ other.flags_ }
 		{
 #if TOML_LIFETIME_HOOKS
@@ -5053,7 +5749,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(const value& other, value_flags flags) noexcept //
 			: node(other),
-			  val_{ other.val_ },
+			  val_(other.val_view()),
 			  flags_{ flags == preserve_source_value_flags ? other.flags_ : flags }
 		{
 #if TOML_LIFETIME_HOOKS
@@ -5064,9 +5760,9 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(value&& other) noexcept //
 			: node(std::move(other)),
-			  val_{ std::move(other.val_) },
 			  flags_{ std::exchange(other.flags_, value_flags{}) }
 		{
+			take_val(other);
 #if TOML_LIFETIME_HOOKS
 			TOML_VALUE_CREATED;
 #endif
@@ -5075,9 +5771,9 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD_CTOR
 		value(value&& other, value_flags flags) noexcept //
 			: node(std::move(other)),
-			  val_{ std::move(other.val_) },
 			  flags_{ flags == preserve_source_value_flags ? other.flags_ : flags }
 		{
+			take_val(other);
 #if TOML_LIFETIME_HOOKS
 			TOML_VALUE_CREATED;
 #endif
@@ -5087,8 +5783,19 @@ TOML_NAMESPACE_START
 		value& operator=(const value& rhs) noexcept
 		{
 			node::operator=(rhs);
-			val_   = rhs.val_;
-			flags_ = rhs.flags_;
+			if (&rhs != this)
+			{
+				if constexpr (std::is_same_v<value_type, std::string>)
+				{
+					if (is_borrowed_)
+						own(std::string{ rhs.val_view() });
+					else
+						val_ = rhs.val_view();
+				}
+				else
+					val_ = rhs.val_;
+				flags_ = rhs.flags_;
+			}
 			return *this;
 		}
 
@@ -5097,21 +5804,23 @@ TOML_NAMESPACE_START
 			if (&rhs != this)
 			{
 				node::operator=(std::move(rhs));
-				val_   = std::move(rhs.val_);
+				destroy_val();
+				take_val(rhs);
 				flags_ = std::exchange(rhs.flags_, value_flags{});
 			}
 			return *this;
 		}
 
-#if TOML_LIFETIME_HOOKS
 		~value() noexcept
 		{
+#if TOML_LIFETIME_HOOKS
 			TOML_VALUE_DESTROYED;
-		}
 #endif
+			destroy_val();
+		}
 
 		TOML_CONST_INLINE_GETTER
-		node_type type() const noexcept final
+		node_type type() const noexcept
 		{
 			return impl::node_type_of<value_type>;
 		}
@@ -5159,13 +5868,13 @@ TOML_NAMESPACE_START
 				return impl::node_type_of<type> == impl::node_type_of<value_type>;
 		}
 		TOML_CONST_INLINE_GETTER
-		bool is_table() const noexcept final
+		bool is_table() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_array() const noexcept final
+		bool is_array() const noexcept
 		{
 			return false;
 		}
@@ -5177,251 +5886,258 @@ TOML_NAMESPACE_START
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_value() const noexcept final
+		bool is_value() const noexcept
 		{
 			return true;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_string() const noexcept final
+		bool is_string() const noexcept
 		{
 			return std::is_same_v<value_type, std::string>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_integer() const noexcept final
+		bool is_integer() const noexcept
 		{
 			return std::is_same_v<value_type, int64_t>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_floating_point() const noexcept final
+		bool is_floating_point() const noexcept
 		{
 			return std::is_same_v<value_type, double>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_number() const noexcept final
+		bool is_number() const noexcept
 		{
 			return impl::is_one_of<value_type, int64_t, double>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_boolean() const noexcept final
+		bool is_boolean() const noexcept
 		{
 			return std::is_same_v<value_type, bool>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_date() const noexcept final
+		bool is_date() const noexcept
 		{
 			return std::is_same_v<value_type, date>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_time() const noexcept final
+		bool is_time() const noexcept
 		{
 			return std::is_same_v<value_type, time>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_date_time() const noexcept final
+		bool is_date_time() const noexcept
 		{
 			return std::is_same_v<value_type, date_time>;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		table* as_table() noexcept final
+		table* as_table() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		array* as_array() noexcept final
+		array* as_array() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		value<std::string>* as_string() noexcept final
+		value<std::string>* as_string() noexcept
 		{
 			return as_value<std::string>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		value<int64_t>* as_integer() noexcept final
+		value<int64_t>* as_integer() noexcept
 		{
 			return as_value<int64_t>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		value<double>* as_floating_point() noexcept final
+		value<double>* as_floating_point() noexcept
 		{
 			return as_value<double>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		value<bool>* as_boolean() noexcept final
+		value<bool>* as_boolean() noexcept
 		{
 			return as_value<bool>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		value<date>* as_date() noexcept final
+		value<date>* as_date() noexcept
 		{
 			return as_value<date>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		value<time>* as_time() noexcept final
+		value<time>* as_time() noexcept
 		{
 			return as_value<time>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		value<date_time>* as_date_time() noexcept final
+		value<date_time>* as_date_time() noexcept
 		{
 			return as_value<date_time>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const table* as_table() const noexcept final
+		const table* as_table() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const array* as_array() const noexcept final
+		const array* as_array() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const value<std::string>* as_string() const noexcept final
+		const value<std::string>* as_string() const noexcept
 		{
 			return as_value<std::string>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const value<int64_t>* as_integer() const noexcept final
+		const value<int64_t>* as_integer() const noexcept
 		{
 			return as_value<int64_t>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const value<double>* as_floating_point() const noexcept final
+		const value<double>* as_floating_point() const noexcept
 		{
 			return as_value<double>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const value<bool>* as_boolean() const noexcept final
+		const value<bool>* as_boolean() const noexcept
 		{
 			return as_value<bool>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const value<date>* as_date() const noexcept final
+		const value<date>* as_date() const noexcept
 		{
 			return as_value<date>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const value<time>* as_time() const noexcept final
+		const value<time>* as_time() const noexcept
 		{
 			return as_value<time>(this);
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const value<date_time>* as_date_time() const noexcept final
+		const value<date_time>* as_date_time() const noexcept
 		{
 			return as_value<date_time>(this);
 		}
 
 		TOML_PURE_INLINE_GETTER
-		value_type& get() & noexcept
+		value_type& get() & noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		value_type&& get() && noexcept
+		value_type&& get() && noexcept(access_is_nothrow)
 		{
-			return static_cast<value_type&&>(val_);
+			return static_cast<value_type&&>(val());
 		}
 
 		TOML_PURE_INLINE_GETTER
-		const value_type& get() const& noexcept
+		const value_type& get() const& noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		const value_type&& get() const&& noexcept
+		const value_type&& get() const&& noexcept(access_is_nothrow)
 		{
-			return static_cast<const value_type&&>(val_);
+			return static_cast<const value_type&&>(val());
 		}
 
 		TOML_PURE_INLINE_GETTER
-		value_type& operator*() & noexcept
+		value_type& operator*() & noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		value_type&& operator*() && noexcept
+		value_type&& operator*() && noexcept(access_is_nothrow)
 		{
-			return static_cast<value_type&&>(val_);
+			return static_cast<value_type&&>(val());
 		}
 
 		TOML_PURE_INLINE_GETTER
-		const value_type& operator*() const& noexcept
+		const value_type& operator*() const& noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		const value_type&& operator*() const&& noexcept
+		const value_type&& operator*() const&& noexcept(access_is_nothrow)
 		{
-			return static_cast<const value_type&&>(val_);
+			return static_cast<const value_type&&>(val());
 		}
 
 		TOML_PURE_INLINE_GETTER
-		explicit operator value_type&() & noexcept
+		explicit operator value_type&() & noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		explicit operator value_type&&() && noexcept
+		explicit operator value_type&&() && noexcept(access_is_nothrow)
 		{
-			return static_cast<value_type&&>(val_);
+			return static_cast<value_type&&>(val());
 		}
 
 		TOML_PURE_INLINE_GETTER
-		explicit operator const value_type&() const& noexcept
+		explicit operator const value_type&() const& noexcept(access_is_nothrow)
 		{
-			return val_;
+			return val();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		explicit operator const value_type&&() && noexcept
+		explicit operator const value_type&&() && noexcept(access_is_nothrow)
 		{
-			return static_cast<const value_type&&>(val_);
+			return static_cast<const value_type&&>(val());
 		}
 
 		TOML_HIDDEN_CONSTRAINT(std::is_class_v<T>, typename T = value_type)
 		TOML_PURE_INLINE_GETTER
-		value_type* operator->() noexcept
+		value_type* operator->() noexcept(access_is_nothrow)
 		{
-			return &val_;
+			return &val();
 		}
 
 		TOML_HIDDEN_CONSTRAINT(std::is_class_v<T>, typename T = value_type)
 		TOML_PURE_INLINE_GETTER
-		const value_type* operator->() const noexcept
+		const value_type* operator->() const noexcept(access_is_nothrow)
+		{
+			return &val();
+		}
+
+		TOML_HIDDEN_CONSTRAINT((std::is_same_v<T, std::string>), typename T = value_type)
+		TOML_PURE_INLINE_GETTER
+		std::string_view view() const noexcept
 		{
-			return &val_;
+			return val_view();
 		}
 
 		TOML_NODISCARD
@@ -5439,7 +6155,12 @@ TOML_NAMESPACE_START
 		value& operator=(value_arg rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, std::string>)
-				val_.assign(rhs);
+			{
+				if TOML_UNLIKELY(is_borrowed_)
+					own(std::string{ rhs });
+				else
+					val_.assign(rhs);
+			}
 			else
 				val_ = rhs;
 			return *this;
@@ -5448,7 +6169,10 @@ TOML_NAMESPACE_START
 		TOML_CONSTRAINED_TEMPLATE((std::is_same_v<T, std::string>), typename T = value_type)
 		value& operator=(std::string&& rhs) noexcept
 		{
-			val_ = std::move(rhs);
+			if TOML_UNLIKELY(is_borrowed_)
+				own(std::move(rhs));
+			else
+				val_ = std::move(rhs);
 			return *this;
 		}
 
@@ -5457,63 +6181,63 @@ TOML_NAMESPACE_START
 		{
 			if constexpr (std::is_same_v<value_type, double>)
 			{
-				const auto lhs_nan = impl::fpclassify(lhs.val_) == impl::fp_class::nan;
+				const auto lhs_nan = impl::fpclassify(lhs.val_view()) == impl::fp_class::nan;
 				const auto rhs_nan = impl::fpclassify(rhs) == impl::fp_class::nan;
 				if (lhs_nan != rhs_nan)
 					return false;
 				if (lhs_nan)
 					return true;
 			}
-			return lhs.val_ == rhs;
+			return lhs.val_view() == rhs;
 		}
 		TOML_ASYMMETRICAL_EQUALITY_OPS(const value&, value_arg, );
 
 		TOML_PURE_GETTER
 		friend bool operator<(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ < rhs;
+			return lhs.val_view() < rhs;
 		}
 
 		TOML_PURE_GETTER
 		friend bool operator<(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs < rhs.val_;
+			return lhs < rhs.val_view();
 		}
 
 		TOML_PURE_GETTER
 		friend bool operator<=(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ <= rhs;
+			return lhs.val_view() <= rhs;
 		}
 
 		TOML_PURE_GETTER
 		friend bool operator<=(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs <= rhs.val_;
+			return lhs <= rhs.val_view();
 		}
 
 		TOML_PURE_GETTER
 		friend bool operator>(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ > rhs;
+			return lhs.val_view() > rhs;
 		}
 
 		TOML_PURE_GETTER
 		friend bool operator>(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs > rhs.val_;
+			return lhs > rhs.val_view();
 		}
 
 		TOML_PURE_GETTER
 		friend bool operator>=(const value& lhs, value_arg rhs) noexcept
 		{
-			return lhs.val_ >= rhs;
+			return lhs.val_view() >= rhs;
 		}
 
 		TOML_PURE_GETTER
 		friend bool operator>=(value_arg lhs, const value& rhs) noexcept
 		{
-			return lhs >= rhs.val_;
+			return lhs >= rhs.val_view();
 		}
 
 		template <typename T>
@@ -5521,7 +6245,7 @@ TOML_NAMESPACE_START
 		friend bool operator==(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs == rhs.val_; // calls asymmetrical value-equality operator defined above
+				return lhs == rhs.val_view(); // calls asymmetrical value-equality operator defined above
 			else
 				return false;
 		}
@@ -5538,7 +6262,7 @@ TOML_NAMESPACE_START
 		friend bool operator<(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ < rhs.val_;
+				return lhs.val_view() < rhs.val_view();
 			else
 				return impl::node_type_of<value_type> < impl::node_type_of<T>;
 		}
@@ -5548,7 +6272,7 @@ TOML_NAMESPACE_START
 		friend bool operator<=(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ <= rhs.val_;
+				return lhs.val_view() <= rhs.val_view();
 			else
 				return impl::node_type_of<value_type> <= impl::node_type_of<T>;
 		}
@@ -5558,7 +6282,7 @@ TOML_NAMESPACE_START
 		friend bool operator>(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ > rhs.val_;
+				return lhs.val_view() > rhs.val_view();
 			else
 				return impl::node_type_of<value_type> > impl::node_type_of<T>;
 		}
@@ -5568,7 +6292,7 @@ TOML_NAMESPACE_START
 		friend bool operator>=(const value& lhs, const value<T>& rhs) noexcept
 		{
 			if constexpr (std::is_same_v<value_type, T>)
-				return lhs.val_ >= rhs.val_;
+				return lhs.val_view() >= rhs.val_view();
 			else
 				return impl::node_type_of<value_type> >= impl::node_type_of<T>;
 		}
@@ -5589,6 +6313,11 @@ TOML_NAMESPACE_START
 	template <typename T>
 	value(T, value_flags) -> value<impl::native_type_of<impl::remove_cvref<T>>>;
 
+	// the node's type is only checked at runtime (see node::type()), so once this has been inlined into node::value<T>()
+	// GCC can see paths that read a bigger value type than the one actually constructed, and warns about them
+	TOML_PUSH_WARNINGS;
+	TOML_PRAGMA_GCC(diagnostic ignored "-Warray-bounds")
+
 	template <typename T>
 	TOML_NODISCARD
 	inline decltype(auto) node::get_value_exact() const noexcept(impl::value_retrieval_is_nothrow<T>)
@@ -5602,13 +6331,13 @@ TOML_NAMESPACE_START
 		static_assert(!is_cvref<T>);
 		TOML_ASSERT(this->type() == node_type_of<T>);
 
-		if constexpr (node_type_of<T> == node_type::string)
+		if constexpr (std::is_same_v<T, std::string_view>)
+			return ref_cast<std::string>().view(); // doesn't copy strings borrowed from the source document
+		else if constexpr (node_type_of<T> == node_type::string)
 		{
 			const auto& str = *ref_cast<std::string>();
 			if constexpr (std::is_same_v<T, std::string>)
 				return str;
-			else if constexpr (std::is_same_v<T, std::string_view>)
-				return T{ str };
 			else if constexpr (std::is_same_v<T, const char*>)
 				return str.c_str();
 
@@ -5637,6 +6366,8 @@ TOML_NAMESPACE_START
 			return static_cast<T>(*ref_cast<native_type_of<T>>());
 	}
 
+	TOML_POP_WARNINGS;
+
 	template <typename T>
 	TOML_NODISCARD
 	inline optional<T> node::value_exact() const noexcept(impl::value_retrieval_is_nothrow<T>)
@@ -5898,7 +6629,7 @@ TOML_IMPL_NAMESPACE_START
 	template <typename T>
 	TOML_NODISCARD
 	TOML_ATTR(returns_nonnull)
-	auto* make_node_impl_specialized(T && val, [[maybe_unused]] value_flags flags)
+	auto* make_node_impl_specialized(T && val, [[maybe_unused]] value_flags flags, memory_resource* resource)
 	{
 		using unwrapped_type = unwrap_node<remove_cvref<T>>;
 		static_assert(!std::is_same_v<unwrapped_type, node>);
@@ -5907,7 +6638,7 @@ TOML_IMPL_NAMESPACE_START
 		// arrays + tables - invoke copy/move ctor
 		if constexpr (is_one_of<unwrapped_type, array, table>)
 		{
-			return new unwrapped_type(static_cast<T&&>(val));
+			return create_node<unwrapped_type>(resource, static_cast<T&&>(val));
 		}
 
 		// values
@@ -5921,7 +6652,7 @@ TOML_IMPL_NAMESPACE_START
 			// copy/move ctor
 			if constexpr (std::is_same_v<remove_cvref<T>, value_type>)
 			{
-				out = new value_type{ static_cast<T&&>(val), flags };
+				out = create_node<value_type>(resource, static_cast<T&&>(val), flags);
 			}
 
 			// creating from raw value
@@ -5948,13 +6679,13 @@ TOML_IMPL_NAMESPACE_START
 				if constexpr (is_wide_string<T>)
 				{
 #if TOML_ENABLE_WINDOWS_COMPAT
-					out = new value_type{ narrow(static_cast<T&&>(val)) };
+					out = create_node<value_type>(resource, narrow(static_cast<T&&>(val)));
 #else
 					static_assert(always_false<T>, "Evaluated unreachable branch!");
 #endif
 				}
 				else
-					out = new value_type{ static_cast<T&&>(val) };
+					out = create_node<value_type>(resource, static_cast<T&&>(val));
 
 				if (flags != preserve_source_value_flags)
 					out->flags(flags);
@@ -5966,7 +6697,7 @@ TOML_IMPL_NAMESPACE_START
 
 	template <typename T>
 	TOML_NODISCARD
-	auto* make_node_impl(T && val, value_flags flags = preserve_source_value_flags)
+	auto* make_node_impl(T && val, value_flags flags = preserve_source_value_flags, memory_resource* resource = nullptr)
 	{
 		using unwrapped_type = unwrap_node<remove_cvref<T>>;
 		if constexpr (std::is_same_v<unwrapped_type, node> || is_node_view<unwrapped_type>)
@@ -5978,20 +6709,22 @@ TOML_IMPL_NAMESPACE_START
 			}
 
 			return static_cast<T&&>(val).visit(
-				[flags](auto&& concrete) {
+				[flags, resource](auto&& concrete) {
 					return static_cast<toml::node*>(
-						make_node_impl_specialized(static_cast<decltype(concrete)&&>(concrete), flags));
+						make_node_impl_specialized(static_cast<decltype(concrete)&&>(concrete), flags, resource));
 				});
 		}
 		else
-			return make_node_impl_specialized(static_cast<T&&>(val), flags);
+			return make_node_impl_specialized(static_cast<T&&>(val), flags, resource);
 	}
 
 	template <typename T>
 	TOML_NODISCARD
-	auto* make_node_impl(inserter<T> && val, value_flags flags = preserve_source_value_flags)
+	auto* make_node_impl(inserter<T> && val,
+						 value_flags flags		   = preserve_source_value_flags,
+						 memory_resource* resource = nullptr)
 	{
-		return make_node_impl(static_cast<T&&>(val.value), flags);
+		return make_node_impl(static_cast<T&&>(val.value), flags, resource);
 	}
 
 	template <typename T, bool = (is_node<T> || is_node_view<T> || is_value<T> || can_partially_represent_native<T>)>
@@ -6014,9 +6747,9 @@ TOML_IMPL_NAMESPACE_START
 
 	template <typename T>
 	TOML_NODISCARD
-	node_ptr make_node(T && val, value_flags flags = preserve_source_value_flags)
+	node_ptr make_node(T && val, value_flags flags = preserve_source_value_flags, memory_resource* resource = nullptr)
 	{
-		return node_ptr{ make_node_impl(static_cast<T&&>(val), flags) };
+		return node_ptr{ make_node_impl(static_cast<T&&>(val), flags, resource) };
 	}
 
 	template <typename... T>
@@ -6060,6 +6793,12 @@ TOML_NAMESPACE_END;
 #endif
 TOML_POP_WARNINGS;
 
+//********  impl/std_mutex.hpp  ****************************************************************************************
+
+TOML_DISABLE_WARNINGS;
+#include <mutex>
+TOML_ENABLE_WARNINGS;
+
 //********  impl/array.hpp  ********************************************************************************************
 
 TOML_PUSH_WARNINGS;
@@ -6095,42 +6834,359 @@ TOML_PUSH_WARNINGS;
 
 TOML_IMPL_NAMESPACE_START
 {
-	template <bool IsConst>
-	class TOML_TRIVIAL_ABI array_iterator
-	{
-	  private:
-		template <bool>
-		friend class array_iterator;
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
 
-		using mutable_vector_iterator = std::vector<node_ptr>::iterator;
-		using const_vector_iterator	  = std::vector<node_ptr>::const_iterator;
-		using vector_iterator		  = std::conditional_t<IsConst, const_vector_iterator, mutable_vector_iterator>;
+#if TOML_ENABLE_PMR
+	using array_vector = std::pmr::vector<node_ptr>;
+#else
+	using array_vector = std::vector<node_ptr>;
+#endif
 
-		mutable vector_iterator iter_;
+	// a scalar value stored in a compact array without a node (see parse_flags::compact_arrays)
+	struct compact_value
+	{
+		union
+		{
+			int64_t integer;
+			double floating_point;
+			bool boolean;
+			toml::time time; // time, date_time
+		};
+		toml::date date;		// date, date_time
+		int16_t offset_minutes; // date_time
+		bool has_offset;		// date_time
+		node_type type;			// anything but none, table, array or string
 
-	  public:
-		using value_type		= std::conditional_t<IsConst, const node, node>;
-		using reference			= value_type&;
-		using pointer			= value_type*;
-		using difference_type	= ptrdiff_t;
-		using iterator_category = typename std::iterator_traits<vector_iterator>::iterator_category;
+		// (returns false if the node can't be stored as a compact_value; value_flags are not kept)
+		TOML_NODISCARD
+		bool assign(const node& n) noexcept
+		{
+			type = n.type();
+			switch (type)
+			{
+				case node_type::integer: integer = n.as_integer()->get(); return true;
+				case node_type::floating_point: floating_point = n.as_floating_point()->get(); return true;
+				case node_type::boolean: boolean = n.as_boolean()->get(); return true;
+				case node_type::date: date = n.as_date()->get(); return true;
+				case node_type::time: time = n.as_time()->get(); return true;
 
-		TOML_NODISCARD_CTOR
-		array_iterator() noexcept = default;
+				case node_type::date_time:
+				{
+					const auto& dt = n.as_date_time()->get();
+					date		   = dt.date;
+					time		   = dt.time;
+					has_offset	   = !!dt.offset;
+					offset_minutes = dt.offset ? dt.offset->minutes : int16_t{};
+					return true;
+				}
 
-		TOML_NODISCARD_CTOR
-		explicit array_iterator(mutable_vector_iterator iter) noexcept //
-			: iter_{ iter }
-		{}
+				default: return false;
+			}
+		}
 
-		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
-		TOML_NODISCARD_CTOR
-		explicit array_iterator(const_vector_iterator iter) noexcept //
-			: iter_{ iter }
-		{}
+		TOML_PURE_GETTER
+		friend bool operator==(const compact_value& lhs, const compact_value& rhs) noexcept
+		{
+			if (lhs.type != rhs.type)
+				return false;
+			switch (lhs.type)
+			{
+				case node_type::integer: return lhs.integer == rhs.integer;
+				case node_type::boolean: return lhs.boolean == rhs.boolean;
+				case node_type::date: return lhs.date == rhs.date;
+				case node_type::time: return lhs.time == rhs.time;
 
-		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
-		TOML_NODISCARD_CTOR
+				case node_type::floating_point:
+				{
+					// (same semantics as value<double>'s equality operators)
+					const auto lhs_nan = impl::fpclassify(lhs.floating_point) == impl::fp_class::nan;
+					const auto rhs_nan = impl::fpclassify(rhs.floating_point) == impl::fp_class::nan;
+					if (lhs_nan || rhs_nan)
+						return lhs_nan == rhs_nan;
+					return lhs.floating_point == rhs.floating_point;
+				}
+
+				case node_type::date_time:
+					return lhs.date == rhs.date && lhs.time == rhs.time && lhs.has_offset == rhs.has_offset
+						&& (!lhs.has_offset || lhs.offset_minutes == rhs.offset_minutes);
+
+				default: TOML_UNREACHABLE;
+			}
+		}
+	};
+	static_assert(std::is_trivially_copyable_v<compact_value>);
+
+	// the values of a packed array (see parse_flags::packed_arrays), stored contiguously instead of as nodes.
+	// allocated from the array's memory resource, the same as its nodes.
+	//
+	// the nodes are created from the values the first time something needs them, which can be through a const
+	// reference, and so from several threads at once; they're created exactly once (see array::create_packed_nodes()),
+	// and kept here until the array is next modified, at which point they're moved into the array.
+	struct packed_array_storage
+	{
+		node_type type; // integer, floating_point or boolean, or none for compact_values (parse_flags::compact_arrays)
+		size_t size				  = {};
+		size_t capacity			  = {};
+		void* data				  = {};
+		memory_resource* resource = {}; // null means the global heap
+
+		array_vector nodes; // empty until nodes_created is set
+		std::once_flag nodes_once;
+		std::atomic<bool> nodes_created = { false };
+
+		// packed integers, floats and booleans are kept until the array is next modified (there may be spans of them
+		// in use), but compact_values aren't needed once the nodes exist. const member functions reading them hold a
+		// reference, as does the storage itself until the nodes are created; whoever drops the last one releases them.
+		mutable std::atomic<uint32_t> value_refs = { 1u };
+
+		struct deleter
+		{
+			void operator()(packed_array_storage* storage) const noexcept
+			{
+				const auto resource = storage->resource;
+				storage->~packed_array_storage();
+				deallocate(resource, storage, sizeof(packed_array_storage), alignof(packed_array_storage));
+			}
+		};
+		using ptr = std::unique_ptr<packed_array_storage, deleter>;
+
+		TOML_NODISCARD
+		static ptr create(node_type t, memory_resource* resource)
+		{
+			return ptr{ ::new (allocate(resource, sizeof(packed_array_storage), alignof(packed_array_storage)))
+							packed_array_storage{ t, resource } };
+		}
+
+		// (copies the values, not the nodes)
+		TOML_NODISCARD
+		ptr clone(memory_resource* into) const
+		{
+			auto copy = create(type, into);
+			copy->reserve(size);
+			if (size)
+				std::memcpy(copy->data, data, size * element_size());
+			copy->size = size;
+			return copy;
+		}
+
+		packed_array_storage(const packed_array_storage&) = delete;
+		packed_array_storage& operator=(const packed_array_storage&) = delete;
+
+		~packed_array_storage() noexcept
+		{
+			if (data && !values_released())
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool has_nodes() const noexcept
+		{
+			return nodes_created.load(std::memory_order_acquire);
+		}
+
+		// (only meaningful outside of const member functions; see above)
+		TOML_PURE_INLINE_GETTER
+		bool values_released() const noexcept
+		{
+			return type == node_type::none && !value_refs.load(std::memory_order_acquire);
+		}
+
+		// returns false if the values have been released, in which case the nodes should be used instead
+		TOML_NODISCARD
+		bool begin_reading() const noexcept
+		{
+			if (type != node_type::none)
+				return true;
+
+			for (auto refs = value_refs.load(std::memory_order_relaxed); refs;)
+				if (value_refs.compare_exchange_weak(refs, refs + 1u, std::memory_order_acquire))
+					return true;
+			return false;
+		}
+
+		void end_reading() const noexcept
+		{
+			if (type == node_type::none && value_refs.fetch_sub(1u, std::memory_order_acq_rel) == 1u && data)
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t element_size() const noexcept
+		{
+			static_assert(sizeof(double) == sizeof(int64_t));
+			switch (type)
+			{
+				case node_type::none: return sizeof(compact_value);
+				case node_type::boolean: return sizeof(bool);
+				default: return sizeof(int64_t);
+			}
+		}
+
+		void reserve(size_t new_capacity)
+		{
+			if (new_capacity <= capacity)
+				return;
+
+			const auto new_data = allocate(resource, new_capacity * element_size(), alignof(compact_value));
+			if (size)
+				std::memcpy(new_data, data, size * element_size());
+			if (data)
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+			data	 = new_data;
+			capacity = new_capacity;
+		}
+
+		template <typename T>
+		void push_back(T val)
+		{
+			TOML_ASSERT(type == node_type_of<T>);
+
+			if (size == capacity)
+				reserve(capacity ? capacity * 2u : 8u);
+			::new (static_cast<void*>(static_cast<T*>(data) + size)) T{ val };
+			size++;
+		}
+
+		template <typename T>
+		TOML_PURE_INLINE_GETTER
+		const T* values() const noexcept
+		{
+			TOML_ASSERT(type == node_type_of<T>);
+
+			return static_cast<const T*>(data);
+		}
+
+		TOML_PURE_GETTER
+		bool is_homogeneous(node_type ntype) const noexcept
+		{
+			if (!size)
+				return false;
+			if (type != node_type::none)
+				return ntype == node_type::none || ntype == type;
+
+			const auto vals = values<compact_value>();
+			if (ntype == node_type::none)
+				ntype = vals[0].type;
+			for (size_t i = 0; i < size; i++)
+				if (vals[i].type != ntype)
+					return false;
+			return true;
+		}
+
+		// returns the value at the given index as a compact_value, whichever way the values are stored
+		TOML_PURE_GETTER
+		compact_value get(size_t index) const noexcept
+		{
+			TOML_ASSERT(index < size);
+
+			compact_value val;
+			val.type = type;
+			switch (type)
+			{
+				case node_type::none: return values<compact_value>()[index];
+				case node_type::integer: val.integer = values<int64_t>()[index]; break;
+				case node_type::floating_point: val.floating_point = values<double>()[index]; break;
+				case node_type::boolean: val.boolean = values<bool>()[index]; break;
+				default: TOML_UNREACHABLE;
+			}
+			return val;
+		}
+
+		// switches packed integers, floats or booleans to compact_values (so values of other types can be added)
+		void convert_to_compact()
+		{
+			if (type == node_type::none)
+				return;
+
+			const auto new_capacity = (std::max)(capacity, size_t{ 8u });
+			const auto new_data		= static_cast<compact_value*>(
+				allocate(resource, new_capacity * sizeof(compact_value), alignof(compact_value)));
+			for (size_t i = 0; i < size; i++)
+				::new (static_cast<void*>(new_data + i)) compact_value{ get(i) };
+
+			if (data)
+				deallocate(resource, data, capacity * element_size(), alignof(compact_value));
+			data	 = new_data;
+			capacity = new_capacity;
+			type	 = node_type::none;
+		}
+
+	  private:
+		TOML_NODISCARD_CTOR
+		packed_array_storage(node_type t, memory_resource* r) noexcept //
+			: type{ t },
+			  resource{ r }
+#if TOML_ENABLE_PMR
+			  ,
+			  nodes{ r ? r : std::pmr::get_default_resource() }
+#endif
+		{
+			TOML_ASSERT_ASSUME(t == node_type::none || t == node_type::integer || t == node_type::floating_point
+							   || t == node_type::boolean);
+		}
+
+		TOML_NODISCARD
+		static void* allocate([[maybe_unused]] memory_resource* resource, size_t size, [[maybe_unused]] size_t align)
+		{
+#if TOML_ENABLE_PMR
+			if (resource)
+				return resource->allocate(size, align);
+#endif
+			return ::operator new(size);
+		}
+
+		static void deallocate([[maybe_unused]] memory_resource* resource,
+							   void* ptr,
+							   [[maybe_unused]] size_t size,
+							   [[maybe_unused]] size_t align) noexcept
+		{
+#if TOML_ENABLE_PMR
+			if (resource)
+			{
+				resource->deallocate(ptr, size, align);
+				return;
+			}
+#endif
+			::operator delete(ptr);
+		}
+	};
+
+	template <bool IsConst>
+	class TOML_TRIVIAL_ABI array_iterator
+	{
+	  private:
+		template <bool>
+		friend class array_iterator;
+
+		using mutable_vector_iterator = array_vector::iterator;
+		using const_vector_iterator	  = array_vector::const_iterator;
+		using vector_iterator		  = std::conditional_t<IsConst, const_vector_iterator, mutable_vector_iterator>;
+
+		mutable vector_iterator iter_;
+
+	  public:
+		using value_type		= std::conditional_t<IsConst, const node, node>;
+		using reference			= value_type&;
+		using pointer			= value_type*;
+		using difference_type	= ptrdiff_t;
+		using iterator_category = typename std::iterator_traits<vector_iterator>::iterator_category;
+
+		TOML_NODISCARD_CTOR
+		array_iterator() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		explicit array_iterator(mutable_vector_iterator iter) noexcept //
+			: iter_{ iter }
+		{}
+
+		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
+		TOML_NODISCARD_CTOR
+		explicit array_iterator(const_vector_iterator iter) noexcept //
+			: iter_{ iter }
+		{}
+
+		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
+		TOML_NODISCARD_CTOR
 		array_iterator(const array_iterator<false>& other) noexcept //
 			: iter_{ other.iter_ }
 		{}
@@ -6280,6 +7336,8 @@ TOML_IMPL_NAMESPACE_START
 			: value{ make_node(static_cast<T&&>(val), flags) }
 		{}
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_IMPL_NAMESPACE_END;
 
@@ -6289,14 +7347,82 @@ TOML_NAMESPACE_START
 
 	using const_array_iterator = POXY_IMPLEMENTATION_DETAIL(impl::array_iterator<true>);
 
+	template <typename T>
+	class packed_span
+	{
+	  private:
+		const T* data_ = {};
+		size_t size_   = {};
+
+	  public:
+		using element_type	 = const T;
+		using value_type	 = T;
+		using size_type		 = size_t;
+		using iterator		 = const T*;
+		using const_iterator = const T*;
+
+		TOML_NODISCARD_CTOR
+		constexpr packed_span() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		constexpr packed_span(const T* data, size_t size) noexcept //
+			: data_{ data },
+			  size_{ size }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		constexpr const T* data() const noexcept
+		{
+			return data_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		constexpr size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		constexpr bool empty() const noexcept
+		{
+			return !size_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		constexpr const T& operator[](size_t index) const noexcept
+		{
+			return data_[index];
+		}
+
+		TOML_PURE_INLINE_GETTER
+		constexpr const T* begin() const noexcept
+		{
+			return data_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		constexpr const T* end() const noexcept
+		{
+			return data_ + size_;
+		}
+	};
+
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
+
 	class TOML_EXPORTED_CLASS array : public node
 	{
 	  private:
 
-		using vector_type			= std::vector<impl::node_ptr>;
+		template <typename>
+		friend class TOML_PARSER_TYPENAME;
+
+		using vector_type			= impl::array_vector;
 		using vector_iterator		= typename vector_type::iterator;
 		using const_vector_iterator = typename vector_type::const_iterator;
-		vector_type elems_;
+
+		impl::arena_ref arena_; // the arena the nodes are in, if any (declared before elems_ so it outlives them)
+		vector_type elems_;		// empty while the array is packed
+		impl::packed_array_storage::ptr packed_;
 
 		TOML_NODISCARD_CTOR
 		TOML_EXPORTED_MEMBER_FUNCTION
@@ -6307,6 +7433,17 @@ TOML_NAMESPACE_START
 			: array{ elems.begin(), elems.end() }
 		{}
 
+		// the resource new child nodes are allocated from (null means the global heap)
+		TOML_PURE_INLINE_GETTER
+		impl::memory_resource* node_resource() const noexcept
+		{
+#if TOML_ENABLE_PMR
+			return elems_.get_allocator().resource();
+#else
+			return nullptr;
+#endif
+		}
+
 		TOML_EXPORTED_MEMBER_FUNCTION
 		void preinsertion_resize(size_t idx, size_t count);
 
@@ -6324,7 +7461,7 @@ TOML_NAMESPACE_START
 				if (!val)
 					return;
 			}
-			insert_at_back(impl::make_node(static_cast<T&&>(val), flags));
+			insert_at_back(impl::make_node(static_cast<T&&>(val), flags, node_resource()));
 		}
 
 		TOML_NODISCARD
@@ -6332,7 +7469,32 @@ TOML_NAMESPACE_START
 		size_t total_leaf_count() const noexcept;
 
 		TOML_EXPORTED_MEMBER_FUNCTION
-		void flatten_child(array&& child, size_t& dest_index) noexcept;
+		void flatten_child(array&& child, size_t& dest_index);
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void create_packed_nodes() const;
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void release_packed_storage();
+
+		// the elements as nodes, for anything only reading them (a packed array's are created the first time)
+		TOML_ALWAYS_INLINE
+		const vector_type& elem_nodes() const
+		{
+			if TOML_LIKELY(!packed_)
+				return elems_;
+			if TOML_UNLIKELY(!packed_->has_nodes())
+				create_packed_nodes();
+			return packed_->nodes;
+		}
+
+		// for anything that might modify the elements (or hand out something that can)
+		TOML_ALWAYS_INLINE
+		void unpack()
+		{
+			if TOML_UNLIKELY(packed_)
+				release_packed_storage();
+		}
 
 	  public:
 		using value_type	  = node;
@@ -6356,7 +7518,33 @@ TOML_NAMESPACE_START
 		TOML_EXPORTED_MEMBER_FUNCTION
 		array(array&& other) noexcept;
 
-		TOML_CONSTRAINED_TEMPLATE((sizeof...(ElemTypes) > 0 || !std::is_same_v<impl::remove_cvref<ElemType>, array>),
+#if TOML_ENABLE_PMR
+
+		using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit array(const allocator_type& alloc) noexcept;
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		array(const array& other, const allocator_type& alloc);
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		array(array&& other, const allocator_type& alloc);
+
+		TOML_PURE_INLINE_GETTER
+		allocator_type get_allocator() const noexcept
+		{
+			return allocator_type{ elems_.get_allocator().resource() };
+		}
+
+#endif
+
+		TOML_CONSTRAINED_TEMPLATE((sizeof...(ElemTypes) > 0 || !std::is_same_v<impl::remove_cvref<ElemType>, array>)
+									  && !impl::is_node_allocator_arg<ElemType>
+									  && !(impl::is_node_allocator_arg<ElemTypes> || ...),
 								  typename ElemType,
 								  typename... ElemTypes)
 		TOML_NODISCARD_CTOR
@@ -6370,10 +7558,10 @@ TOML_NAMESPACE_START
 		array& operator=(const array&);
 
 		TOML_EXPORTED_MEMBER_FUNCTION
-		array& operator=(array&& rhs) noexcept;
+		array& operator=(array&& rhs) noexcept(!TOML_ENABLE_PMR);
 
 		TOML_CONST_INLINE_GETTER
-		node_type type() const noexcept final
+		node_type type() const noexcept
 		{
 			return node_type::array;
 		}
@@ -6402,13 +7590,13 @@ TOML_NAMESPACE_START
 			return is_homogeneous(impl::node_type_of<type>);
 		}
 		TOML_CONST_INLINE_GETTER
-		bool is_table() const noexcept final
+		bool is_table() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_array() const noexcept final
+		bool is_array() const noexcept
 		{
 			return true;
 		}
@@ -6420,177 +7608,179 @@ TOML_NAMESPACE_START
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_value() const noexcept final
+		bool is_value() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_string() const noexcept final
+		bool is_string() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_integer() const noexcept final
+		bool is_integer() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_floating_point() const noexcept final
+		bool is_floating_point() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_number() const noexcept final
+		bool is_number() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_boolean() const noexcept final
+		bool is_boolean() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_date() const noexcept final
+		bool is_date() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_time() const noexcept final
+		bool is_time() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_date_time() const noexcept final
+		bool is_date_time() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		table* as_table() noexcept final
+		table* as_table() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		array* as_array() noexcept final
+		array* as_array() noexcept
 		{
 			return this;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<std::string>* as_string() noexcept final
+		toml::value<std::string>* as_string() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<int64_t>* as_integer() noexcept final
+		toml::value<int64_t>* as_integer() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<double>* as_floating_point() noexcept final
+		toml::value<double>* as_floating_point() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<bool>* as_boolean() noexcept final
+		toml::value<bool>* as_boolean() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<date>* as_date() noexcept final
+		toml::value<date>* as_date() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<time>* as_time() noexcept final
+		toml::value<time>* as_time() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<date_time>* as_date_time() noexcept final
+		toml::value<date_time>* as_date_time() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const table* as_table() const noexcept final
+		const table* as_table() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const array* as_array() const noexcept final
+		const array* as_array() const noexcept
 		{
 			return this;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<std::string>* as_string() const noexcept final
+		const toml::value<std::string>* as_string() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<int64_t>* as_integer() const noexcept final
+		const toml::value<int64_t>* as_integer() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<double>* as_floating_point() const noexcept final
+		const toml::value<double>* as_floating_point() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<bool>* as_boolean() const noexcept final
+		const toml::value<bool>* as_boolean() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date>* as_date() const noexcept final
+		const toml::value<date>* as_date() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<time>* as_time() const noexcept final
+		const toml::value<time>* as_time() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date_time>* as_date_time() const noexcept final
+		const toml::value<date_time>* as_date_time() const noexcept
 		{
 			return nullptr;
 		}
 
-		TOML_PURE_INLINE_GETTER
+		TOML_NODISCARD
 		node* get(size_t index) noexcept
 		{
+			unpack();
 			return index < elems_.size() ? elems_[index].get() : nullptr;
 		}
 
-		TOML_PURE_INLINE_GETTER
+		TOML_NODISCARD
 		const node* get(size_t index) const noexcept
 		{
-			return const_cast<array&>(*this).get(index);
+			const auto& nodes = elem_nodes();
+			return index < nodes.size() ? nodes[index].get() : nullptr;
 		}
 
 		template <typename ElemType>
@@ -6606,20 +7796,23 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		const impl::wrap_node<ElemType>* get_as(size_t index) const noexcept
 		{
-			return const_cast<array&>(*this).template get_as<ElemType>(index);
+			if (auto val = get(index))
+				return val->template as<ElemType>();
+			return nullptr;
 		}
 
 		using node::operator[]; // inherit operator[toml::path]
 		TOML_NODISCARD
 		node& operator[](size_t index) noexcept
 		{
+			unpack();
 			return *elems_[index];
 		}
 
 		TOML_NODISCARD
 		const node& operator[](size_t index) const noexcept
 		{
-			return *elems_[index];
+			return *elem_nodes()[index];
 		}
 
 		TOML_NODISCARD
@@ -6627,33 +7820,33 @@ TOML_NAMESPACE_START
 		node& at(size_t index);
 
 		TOML_NODISCARD
-		const node& at(size_t index) const
-		{
-			return const_cast<array&>(*this).at(index);
-		}
+		TOML_EXPORTED_MEMBER_FUNCTION
+		const node& at(size_t index) const;
 
 		TOML_NODISCARD
 		node& front() noexcept
 		{
+			unpack();
 			return *elems_.front();
 		}
 
 		TOML_NODISCARD
 		const node& front() const noexcept
 		{
-			return *elems_.front();
+			return *elem_nodes().front();
 		}
 
 		TOML_NODISCARD
 		node& back() noexcept
 		{
+			unpack();
 			return *elems_.back();
 		}
 
 		TOML_NODISCARD
 		const node& back() const noexcept
 		{
-			return *elems_.back();
+			return *elem_nodes().back();
 		}
 
 		using iterator = array_iterator;
@@ -6663,37 +7856,39 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		iterator begin() noexcept
 		{
+			unpack();
 			return iterator{ elems_.begin() };
 		}
 
 		TOML_NODISCARD
 		const_iterator begin() const noexcept
 		{
-			return const_iterator{ elems_.cbegin() };
+			return const_iterator{ elem_nodes().cbegin() };
 		}
 
 		TOML_NODISCARD
 		const_iterator cbegin() const noexcept
 		{
-			return const_iterator{ elems_.cbegin() };
+			return const_iterator{ elem_nodes().cbegin() };
 		}
 
 		TOML_NODISCARD
 		iterator end() noexcept
 		{
+			unpack();
 			return iterator{ elems_.end() };
 		}
 
 		TOML_NODISCARD
 		const_iterator end() const noexcept
 		{
-			return const_iterator{ elems_.cend() };
+			return const_iterator{ elem_nodes().cend() };
 		}
 
 		TOML_NODISCARD
 		const_iterator cend() const noexcept
 		{
-			return const_iterator{ elems_.cend() };
+			return const_iterator{ elem_nodes().cend() };
 		}
 
 	  private:
@@ -6903,16 +8098,37 @@ TOML_NAMESPACE_START
 			return static_cast<const array&&>(*this);
 		}
 
-		TOML_NODISCARD
-		bool empty() const noexcept
+		TOML_PURE_INLINE_GETTER
+		bool is_packed() const noexcept
 		{
-			return elems_.empty();
+			return !!packed_;
 		}
 
-		TOML_NODISCARD
-		size_t size() const noexcept
+		template <typename T>
+		TOML_PURE_GETTER
+		packed_span<T> packed() const noexcept
 		{
-			return elems_.size();
+			static_assert(impl::is_one_of<T, int64_t, double, bool>,
+						  "The template type argument of array::packed() must be int64_t, double or bool");
+
+			if (packed_ && packed_->type == impl::node_type_of<T>)
+				return { packed_->values<T>(), packed_->size };
+			return {};
+		}
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		bool pack();
+
+		TOML_NODISCARD
+		bool empty() const noexcept
+		{
+			return packed_ ? !packed_->size : elems_.empty();
+		}
+
+		TOML_NODISCARD
+		size_t size() const noexcept
+		{
+			return packed_ ? packed_->size : elems_.size();
 		}
 
 		TOML_NODISCARD
@@ -6924,7 +8140,7 @@ TOML_NAMESPACE_START
 		TOML_NODISCARD
 		size_t capacity() const noexcept
 		{
-			return elems_.capacity();
+			return packed_ ? packed_->capacity : elems_.capacity();
 		}
 
 		TOML_EXPORTED_MEMBER_FUNCTION
@@ -6946,8 +8162,8 @@ TOML_NAMESPACE_START
 
 			if (!new_size)
 				clear();
-			else if (new_size > elems_.size())
-				insert(cend(), new_size - elems_.size(), static_cast<ElemType&&>(default_init_val), default_init_flags);
+			else if (new_size > size())
+				insert(cend(), new_size - size(), static_cast<ElemType&&>(default_init_val), default_init_flags);
 			else
 				truncate(new_size);
 		}
@@ -6989,7 +8205,7 @@ TOML_NAMESPACE_START
 					return end();
 			}
 			return iterator{ insert_at(const_vector_iterator{ pos },
-									   impl::make_node(static_cast<ElemType&&>(val), flags)) };
+									   impl::make_node(static_cast<ElemType&&>(val), flags, node_resource())) };
 		}
 
 		template <typename ElemType>
@@ -7003,6 +8219,7 @@ TOML_NAMESPACE_START
 				if (!val)
 					return end();
 			}
+			unpack();
 			switch (count)
 			{
 				case 0: return iterator{ elems_.begin() + (const_vector_iterator{ pos } - elems_.cbegin()) };
@@ -7013,9 +8230,9 @@ TOML_NAMESPACE_START
 					preinsertion_resize(start_idx, count);
 					size_t i = start_idx;
 					for (size_t e = start_idx + count - 1u; i < e; i++)
-						elems_[i] = impl::make_node(val, flags);
+						elems_[i] = impl::make_node(val, flags, node_resource());
 
-					elems_[i] = impl::make_node(static_cast<ElemType&&>(val), flags);
+					elems_[i] = impl::make_node(static_cast<ElemType&&>(val), flags, node_resource());
 					return iterator{ elems_.begin() + static_cast<ptrdiff_t>(start_idx) };
 				}
 			}
@@ -7024,6 +8241,7 @@ TOML_NAMESPACE_START
 		template <typename Iter>
 		iterator insert(const_iterator pos, Iter first, Iter last, value_flags flags = preserve_source_value_flags)
 		{
+			unpack();
 			const auto distance = std::distance(first, last);
 			if (distance <= 0)
 				return iterator{ elems_.begin() + (const_vector_iterator{ pos } - elems_.cbegin()) };
@@ -7050,9 +8268,9 @@ TOML_NAMESPACE_START
 							continue;
 					}
 					if constexpr (std::is_rvalue_reference_v<deref_type>)
-						elems_[i++] = impl::make_node(std::move(*it), flags);
+						elems_[i++] = impl::make_node(std::move(*it), flags, node_resource());
 					else
-						elems_[i++] = impl::make_node(*it, flags);
+						elems_[i++] = impl::make_node(*it, flags, node_resource());
 				}
 				return iterator{ elems_.begin() + static_cast<ptrdiff_t>(start_idx) };
 			}
@@ -7078,8 +8296,9 @@ TOML_NAMESPACE_START
 			static_assert(impl::is_native<type> || impl::is_one_of<type, table, array>,
 						  "Emplacement type parameter must be one of:" TOML_SA_UNWRAPPED_NODE_TYPE_LIST);
 
-			return iterator{ insert_at(const_vector_iterator{ pos },
-									   impl::node_ptr{ new impl::wrap_node<type>{ static_cast<Args&&>(args)... } }) };
+			impl::node_ptr elem{ impl::create_node<impl::wrap_node<type>>(node_resource(),
+																		  static_cast<Args&&>(args)...) };
+			return iterator{ insert_at(const_vector_iterator{ pos }, std::move(elem)) };
 		}
 
 		template <typename ElemType>
@@ -7093,14 +8312,31 @@ TOML_NAMESPACE_START
 					return end();
 			}
 
+			unpack();
 			const auto it = elems_.begin() + (const_vector_iterator{ pos } - elems_.cbegin());
-			*it			  = impl::make_node(static_cast<ElemType&&>(val), flags);
+			*it			  = impl::make_node(static_cast<ElemType&&>(val), flags, node_resource());
 			return iterator{ it };
 		}
 
 		template <typename ElemType>
 		void push_back(ElemType&& val, value_flags flags = preserve_source_value_flags)
 		{
+			using raw_elem_type = impl::remove_cvref<ElemType>;
+			if constexpr (std::is_arithmetic_v<raw_elem_type>)
+			{
+				if constexpr (impl::value_traits<raw_elem_type>::is_losslessly_convertible_to_native)
+				{
+					using native_type = impl::native_type_of<raw_elem_type>;
+					if (packed_ && packed_->type == impl::node_type_of<native_type>
+						&& !packed_->has_nodes()
+						&& (flags == value_flags::none || flags == preserve_source_value_flags))
+					{
+						packed_->push_back(static_cast<native_type>(val));
+						return;
+					}
+				}
+			}
+
 			emplace_back_if_not_empty_view(static_cast<ElemType&&>(val), flags);
 		}
 
@@ -7131,7 +8367,8 @@ TOML_NAMESPACE_START
 			}
 			else
 			{
-				auto ptr = new impl::wrap_node<unwrapped_type>{ static_cast<Args&&>(args)... };
+				auto ptr = impl::create_node<impl::wrap_node<unwrapped_type>>(node_resource(),
+																			  static_cast<Args&&>(args)...);
 				insert_at_back(impl::node_ptr{ ptr });
 				return *ptr;
 			}
@@ -7207,6 +8444,8 @@ TOML_NAMESPACE_START
 
 #endif
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_NAMESPACE_END;
 
@@ -7232,14 +8471,143 @@ TOML_PUSH_WARNINGS;
 #undef max
 #endif
 
+TOML_IMPL_NAMESPACE_START
+{
+	// the text of a key. usually a std::string, except in documents parsed with parse_flags::borrowed_strings (whose
+	// keys can point into the source document) or parse_flags::arena_allocation (whose long keys point into the
+	// document's arena). copies always have their own text.
+	class key_text
+	{
+	  private:
+		union
+		{
+			std::string str_;
+			std::string_view borrowed_; // used instead of str_ when is_borrowed_ is set
+		};
+		bool is_borrowed_ = false;
+
+		void take(key_text& other) noexcept
+		{
+			if (other.is_borrowed_)
+			{
+				::new (static_cast<void*>(&borrowed_)) std::string_view{ std::exchange(other.borrowed_, {}) };
+				is_borrowed_ = true;
+			}
+			else
+				::new (static_cast<void*>(&str_)) std::string{ std::move(other.str_) };
+		}
+
+		void release() noexcept
+		{
+			if (!is_borrowed_)
+				str_.~basic_string();
+			is_borrowed_ = false;
+		}
+
+	  public:
+		TOML_NODISCARD_CTOR
+		key_text() noexcept //
+			: str_{}
+		{}
+
+		TOML_NODISCARD_CTOR
+		explicit key_text(std::string_view text) //
+			: str_{ text }
+		{}
+
+		TOML_NODISCARD_CTOR
+		explicit key_text(std::string&& text) noexcept //
+			: str_{ std::move(text) }
+		{}
+
+		// refers to text owned by something else (the source document or a document's arena)
+		TOML_NODISCARD
+		static key_text borrow(std::string_view text) noexcept
+		{
+			key_text k;
+			k.release();
+			::new (static_cast<void*>(&k.borrowed_)) std::string_view{ text };
+			k.is_borrowed_ = true;
+			return k;
+		}
+
+		TOML_NODISCARD_CTOR
+		key_text(const key_text& other) //
+			: str_{ other.view() }
+		{}
+
+		TOML_NODISCARD_CTOR
+		key_text(key_text&& other) noexcept
+		{
+			take(other);
+		}
+
+		key_text& operator=(const key_text& rhs)
+		{
+			if (&rhs != this)
+			{
+				key_text copy{ rhs };
+				release();
+				take(copy);
+			}
+			return *this;
+		}
+
+		key_text& operator=(key_text&& rhs) noexcept
+		{
+			if (&rhs != this)
+			{
+				release();
+				take(rhs);
+			}
+			return *this;
+		}
+
+		~key_text() noexcept
+		{
+			release();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view view() const noexcept
+		{
+			return is_borrowed_ ? borrowed_ : std::string_view{ str_ };
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const char* data() const noexcept
+		{
+			return is_borrowed_ ? borrowed_.data() : str_.data();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t length() const noexcept
+		{
+			return is_borrowed_ ? borrowed_.length() : str_.length();
+		}
+	};
+}
+TOML_IMPL_NAMESPACE_END;
+
 TOML_NAMESPACE_START
 {
 	class key
 	{
 	  private:
-		std::string key_;
+
+		template <typename>
+		friend class TOML_PARSER_TYPENAME;
+
+		impl::key_text key_;
 		source_region source_;
 
+		// (for keys that point into a document's arena)
+		TOML_NODISCARD_CTOR
+		key(impl::key_text&& k, source_region&& src) noexcept //
+			: key_{ std::move(k) },
+			  source_{ std::move(src) }
+		{}
+
 	  public:
 
 		TOML_NODISCARD_CTOR
@@ -7259,25 +8627,25 @@ TOML_NAMESPACE_START
 
 		TOML_NODISCARD_CTOR
 		explicit key(std::string&& k, source_region&& src = {}) noexcept //
-			: key_{ std::move(k) },
+			: key_{ std::string{ std::move(k) } },
 			  source_{ std::move(src) }
 		{}
 
 		TOML_NODISCARD_CTOR
 		explicit key(std::string&& k, const source_region& src) noexcept //
-			: key_{ std::move(k) },
+			: key_{ std::string{ std::move(k) } },
 			  source_{ src }
 		{}
 
 		TOML_NODISCARD_CTOR
 		explicit key(const char* k, source_region&& src = {}) //
-			: key_{ k },
+			: key_{ std::string_view{ k } },
 			  source_{ std::move(src) }
 		{}
 
 		TOML_NODISCARD_CTOR
 		explicit key(const char* k, const source_region& src) //
-			: key_{ k },
+			: key_{ std::string_view{ k } },
 			  source_{ src }
 		{}
 
@@ -7300,7 +8668,7 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		std::string_view str() const noexcept
 		{
-			return std::string_view{ key_ };
+			return key_.view();
 		}
 
 		TOML_PURE_INLINE_GETTER
@@ -7312,7 +8680,7 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		bool empty() const noexcept
 		{
-			return key_.empty();
+			return !key_.length();
 		}
 
 		TOML_PURE_INLINE_GETTER
@@ -7336,109 +8704,109 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ == rhs.key_;
+			return lhs.str() == rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ != rhs.key_;
+			return lhs.str() != rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ < rhs.key_;
+			return lhs.str() < rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ <= rhs.key_;
+			return lhs.str() <= rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ > rhs.key_;
+			return lhs.str() > rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ >= rhs.key_;
+			return lhs.str() >= rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ == rhs;
+			return lhs.str() == rhs;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ != rhs;
+			return lhs.str() != rhs;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ < rhs;
+			return lhs.str() < rhs;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ <= rhs;
+			return lhs.str() <= rhs;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ > rhs;
+			return lhs.str() > rhs;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ >= rhs;
+			return lhs.str() >= rhs;
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs == rhs.key_;
+			return lhs == rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs != rhs.key_;
+			return lhs != rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs < rhs.key_;
+			return lhs < rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs <= rhs.key_;
+			return lhs <= rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs > rhs.key_;
+			return lhs > rhs.str();
 		}
 
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs >= rhs.key_;
+			return lhs >= rhs.str();
 		}
 
 		using const_iterator = const char*;
@@ -7459,7 +8827,7 @@ TOML_NAMESPACE_START
 
 		friend std::ostream& operator<<(std::ostream& lhs, const key& rhs)
 		{
-			impl::print_to_stream(lhs, rhs.key_);
+			impl::print_to_stream(lhs, rhs.str());
 			return lhs;
 		}
 	};
@@ -7504,152 +8872,498 @@ TOML_PUSH_WARNINGS;
 
 TOML_IMPL_NAMESPACE_START
 {
-	template <bool IsConst>
-	struct table_proxy_pair
-	{
-		using value_type = std::conditional_t<IsConst, const node, node>;
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
-		const toml::key& first;
-		value_type& second;
-	};
+#if TOML_ENABLE_FLAT_TABLES
 
-	template <bool IsConst>
-	class table_iterator
+	// the subset of std::map's interface used by toml::table, implemented over a vector of entries kept sorted by key
+	// (see TOML_ENABLE_FLAT_TABLES). once there are enough entries for it to pay off, an open-addressing hash index
+	// of their positions sits alongside them so find() doesn't need to do a binary search.
+	class flat_table_map
 	{
+	  public:
+		using value_type = std::pair<toml::key, node_ptr>;
+#if TOML_ENABLE_PMR
+		using container_type = std::pmr::vector<value_type>;
+#else
+		using container_type = std::vector<value_type>;
+#endif
+		using allocator_type  = typename container_type::allocator_type;
+		using size_type		  = typename container_type::size_type;
+		using difference_type = typename container_type::difference_type;
+		using iterator		  = typename container_type::iterator;
+		using const_iterator  = typename container_type::const_iterator;
+
 	  private:
-		template <bool>
-		friend class table_iterator;
+		// tables smaller than this are just binary-searched
+		static constexpr size_t index_threshold = 16u;
 
-		using proxy_type		   = table_proxy_pair<IsConst>;
-		using mutable_map_iterator = std::map<toml::key, node_ptr, std::less<>>::iterator;
-		using const_map_iterator   = std::map<toml::key, node_ptr, std::less<>>::const_iterator;
-		using map_iterator		   = std::conditional_t<IsConst, const_map_iterator, mutable_map_iterator>;
+		container_type entries_;
 
-		mutable map_iterator iter_;
-		alignas(proxy_type) mutable unsigned char proxy_[sizeof(proxy_type)];
-		mutable bool proxy_instantiated_ = false;
+#if TOML_ENABLE_PMR
+		using slot_container = std::pmr::vector<uint32_t>;
+#else
+		using slot_container = std::vector<uint32_t>;
+#endif
 
-		TOML_NODISCARD
-		proxy_type* get_proxy() const noexcept
+		// linear-probed; each slot is either 0 (empty) or the position of an entry + 1.
+		// always a power-of-two in size and at most half full, or empty if the table is below index_threshold.
+		slot_container slots_;
+
+		// (not std::lower_bound for the same reason as impl::find())
+		template <typename Iterator>
+		TOML_PURE_GETTER
+		static Iterator lower_bound(Iterator first, Iterator last, std::string_view key) noexcept
 		{
-			if (!proxy_instantiated_)
+			auto count = last - first;
+			while (count > 0)
 			{
-				auto p = ::new (static_cast<void*>(proxy_)) proxy_type{ iter_->first, *iter_->second.get() };
-				proxy_instantiated_ = true;
-				return p;
+				const auto step = count / 2;
+				const auto mid	= first + step;
+				if (mid->first < key)
+				{
+					first = mid + 1;
+					count -= step + 1;
+				}
+				else
+					count = step;
 			}
-			else
-				return TOML_LAUNDER(reinterpret_cast<proxy_type*>(proxy_));
+			return first;
 		}
 
-	  public:
-		TOML_NODISCARD_CTOR
-		table_iterator() noexcept = default;
-
-		TOML_NODISCARD_CTOR
-		explicit table_iterator(mutable_map_iterator iter) noexcept //
-			: iter_{ iter }
-		{}
+		// FNV-1a
+		TOML_PURE_GETTER
+		static size_t hash(std::string_view key) noexcept
+		{
+			uint64_t h = 0xcbf29ce484222325ull;
+			for (auto c : key)
+			{
+				h ^= static_cast<unsigned char>(c);
+				h *= 0x00000100000001B3ull;
+			}
+			return static_cast<size_t>(h ^ (h >> 32));
+		}
 
-		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
-		TOML_NODISCARD_CTOR
-		explicit table_iterator(const_map_iterator iter) noexcept //
-			: iter_{ iter }
-		{}
+		TOML_PURE_GETTER
+		size_t home_slot(size_t entry) const noexcept
+		{
+			return hash(entries_[entry].first.str()) & (slots_.size() - 1u);
+		}
 
-		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
-		TOML_NODISCARD_CTOR
-		table_iterator(const table_iterator<false>& other) noexcept //
-			: iter_{ other.iter_ }
-		{}
+		void index(size_t entry) noexcept
+		{
+			const auto mask = slots_.size() - 1u;
+			auto i			= home_slot(entry);
+			while (slots_[i])
+				i = (i + 1u) & mask;
+			slots_[i] = static_cast<uint32_t>(entry + 1u);
+		}
 
-		TOML_NODISCARD_CTOR
-		table_iterator(const table_iterator& other) noexcept //
-			: iter_{ other.iter_ }
-		{}
+		// an empty index big enough for 'count' entries (or no index at all if that's below index_threshold).
+		// this is the only part of re-indexing that can fail, so it's done before entries_ is changed.
+		TOML_NODISCARD
+		slot_container make_index(size_t count) const
+		{
+			slot_container slots{ slots_.get_allocator() };
+			if (count >= index_threshold)
+			{
+				size_t slot_count = index_threshold * 2u;
+				while (slot_count < count * 2u)
+					slot_count *= 2u;
+				slots.assign(slot_count, 0u);
+			}
+			return slots;
+		}
 
-		table_iterator& operator=(const table_iterator& rhs) noexcept
+		void rebuild_index(slot_container& slots) noexcept
 		{
-			iter_				= rhs.iter_;
-			proxy_instantiated_ = false;
-			return *this;
+			slots_.swap(slots);
+			if (!slots_.empty())
+			{
+				for (size_t i = 0; i < entries_.size(); i++)
+					index(i);
+			}
 		}
 
-		using value_type		= table_proxy_pair<IsConst>;
-		using reference			= value_type&;
-		using pointer			= value_type*;
-		using difference_type	= typename std::iterator_traits<map_iterator>::difference_type;
-		using iterator_category = typename std::iterator_traits<map_iterator>::iterator_category;
+		// called after an entry is inserted at 'entry' (when the index didn't need replacing)
+		void update_index_after_insert(size_t entry) noexcept
+		{
+			if (slots_.empty())
+				return;
 
-		table_iterator& operator++() noexcept // ++pre
+			// entries after the new one have all moved up a place
+			if (entry + 1u < entries_.size())
+			{
+				for (auto& slot : slots_)
+					slot += slot > entry ? 1u : 0u;
+			}
+			index(entry);
+		}
+
+		// called before the entry at 'entry' is erased
+		void update_index_before_erase(size_t entry) noexcept
 		{
-			++iter_;
-			proxy_instantiated_ = false;
-			return *this;
+			if (slots_.empty())
+				return;
+
+			// find its slot, then shift back any later members of the same probe sequence to close the gap
+			const auto mask = slots_.size() - 1u;
+			auto hole		= home_slot(entry);
+			while (slots_[hole] != entry + 1u)
+				hole = (hole + 1u) & mask;
+			for (auto i = (hole + 1u) & mask; slots_[i]; i = (i + 1u) & mask)
+			{
+				const auto home = home_slot(slots_[i] - 1u);
+				if (((i - home) & mask) >= ((i - hole) & mask))
+				{
+					slots_[hole] = slots_[i];
+					hole		 = i;
+				}
+			}
+			slots_[hole] = 0u;
+
+			// entries after the erased one are all about to move down a place
+			for (auto& slot : slots_)
+				slot -= slot > entry + 1u ? 1u : 0u;
 		}
 
-		table_iterator operator++(int) noexcept // post++
+		template <typename K, typename V>
+		iterator emplace_at(const_iterator pos, K&& key, V&& val)
 		{
-			table_iterator out{ iter_ };
-			++iter_;
-			proxy_instantiated_ = false;
-			return out;
+			const auto entry = static_cast<size_t>(pos - entries_.cbegin());
+			const bool grow	 = entries_.size() + 1u >= index_threshold && (entries_.size() + 1u) * 2u > slots_.size();
+			auto slots		 = grow ? make_index(entries_.size() + 1u) : slot_container{ slots_.get_allocator() };
+
+			const auto it = entries_.emplace(pos, static_cast<K&&>(key), static_cast<V&&>(val));
+			if (grow)
+				rebuild_index(slots);
+			else
+				update_index_after_insert(entry);
+			return it;
 		}
 
-		table_iterator& operator--() noexcept // --pre
+		template <typename Iterator>
+		TOML_PURE_GETTER
+		static Iterator find(Iterator first,
+							 Iterator last,
+							 const uint32_t* slots,
+							 size_t slot_count,
+							 std::string_view key) noexcept
 		{
-			--iter_;
-			proxy_instantiated_ = false;
-			return *this;
+			if (!slot_count)
+			{
+				const auto it = lower_bound(first, last, key);
+				return it != last && it->first == key ? it : last;
+			}
+
+			const auto mask = slot_count - 1u;
+			for (auto i = hash(key) & mask; slots[i]; i = (i + 1u) & mask)
+			{
+				const auto it = first + static_cast<difference_type>(slots[i] - 1u);
+				if (it->first == key)
+					return it;
+			}
+			return last;
 		}
 
-		table_iterator operator--(int) noexcept // post--
+	  public:
+		TOML_NODISCARD_CTOR
+		flat_table_map() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		explicit flat_table_map(const allocator_type& alloc) noexcept //
+			: entries_{ alloc },
+			  slots_{ alloc }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		allocator_type get_allocator() const noexcept
 		{
-			table_iterator out{ iter_ };
-			--iter_;
-			proxy_instantiated_ = false;
-			return out;
+			return entries_.get_allocator();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		reference operator*() const noexcept
+		iterator begin() noexcept
 		{
-			return *get_proxy();
+			return entries_.begin();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		pointer operator->() const noexcept
+		const_iterator begin() const noexcept
 		{
-			return get_proxy();
+			return entries_.begin();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		explicit operator const map_iterator&() const noexcept
+		const_iterator cbegin() const noexcept
 		{
-			return iter_;
+			return entries_.cbegin();
 		}
 
-		TOML_CONSTRAINED_TEMPLATE(!C, bool C = IsConst)
 		TOML_PURE_INLINE_GETTER
-		explicit operator const const_map_iterator() const noexcept
+		iterator end() noexcept
 		{
-			return iter_;
+			return entries_.end();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		friend bool operator==(const table_iterator& lhs, const table_iterator& rhs) noexcept
+		const_iterator end() const noexcept
 		{
-			return lhs.iter_ == rhs.iter_;
+			return entries_.end();
 		}
 
 		TOML_PURE_INLINE_GETTER
-		friend bool operator!=(const table_iterator& lhs, const table_iterator& rhs) noexcept
+		const_iterator cend() const noexcept
 		{
-			return lhs.iter_ != rhs.iter_;
+			return entries_.cend();
 		}
-	};
 
-	struct table_init_pair
+		TOML_PURE_INLINE_GETTER
+		bool empty() const noexcept
+		{
+			return entries_.empty();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_type size() const noexcept
+		{
+			return entries_.size();
+		}
+
+		void clear() noexcept
+		{
+			entries_.clear();
+			slots_.clear();
+		}
+
+		TOML_NODISCARD
+		iterator lower_bound(std::string_view key) noexcept
+		{
+			return lower_bound(entries_.begin(), entries_.end(), key);
+		}
+
+		TOML_NODISCARD
+		const_iterator lower_bound(std::string_view key) const noexcept
+		{
+			return lower_bound(entries_.begin(), entries_.end(), key);
+		}
+
+		TOML_NODISCARD
+		iterator find(std::string_view key) noexcept
+		{
+			return find(entries_.begin(), entries_.end(), slots_.data(), slots_.size(), key);
+		}
+
+		TOML_NODISCARD
+		const_iterator find(std::string_view key) const noexcept
+		{
+			return find(entries_.begin(), entries_.end(), slots_.data(), slots_.size(), key);
+		}
+
+		// same semantics as std::map::emplace_hint(); a correct hint skips the search entirely
+		// (which is what makes building a table from sorted input linear)
+		template <typename K, typename V>
+		iterator emplace_hint(const_iterator hint, K&& key, V&& val)
+		{
+			const std::string_view key_view = key.str();
+			if ((hint == entries_.cend() || key_view < hint->first)
+				&& (hint == entries_.cbegin() || (hint - 1)->first < key_view))
+				return emplace_at(hint, static_cast<K&&>(key), static_cast<V&&>(val));
+
+			const auto pos = lower_bound(key_view);
+			if (pos != entries_.end() && pos->first == key_view)
+				return pos;
+			return emplace_at(pos, static_cast<K&&>(key), static_cast<V&&>(val));
+		}
+
+		template <typename V>
+		void insert_or_assign(toml::key&& key, V&& val)
+		{
+			const auto pos = lower_bound(key.str());
+			if (pos != entries_.end() && pos->first == key.str())
+				pos->second = static_cast<V&&>(val);
+			else
+				emplace_at(pos, std::move(key), static_cast<V&&>(val));
+		}
+
+		iterator erase(const_iterator pos) noexcept
+		{
+			update_index_before_erase(static_cast<size_t>(pos - entries_.cbegin()));
+			const auto it = entries_.erase(pos);
+			if (entries_.size() < index_threshold)
+				slots_.clear();
+			return it;
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			// (first and last are invalidated by the erase)
+			const bool any = first != last;
+			auto slots	   = any ? make_index(entries_.size() - static_cast<size_t>(last - first))
+							 : slot_container{ slots_.get_allocator() };
+
+			const auto it = entries_.erase(first, last);
+			if (any)
+				rebuild_index(slots);
+			return it;
+		}
+	};
+
+	using table_map = flat_table_map;
+
+#elif TOML_ENABLE_PMR
+	using table_map = std::pmr::map<toml::key, node_ptr, std::less<>>;
+#else
+	using table_map = std::map<toml::key, node_ptr, std::less<>>;
+#endif
+
+	template <bool IsConst>
+	struct table_proxy_pair
+	{
+		using value_type = std::conditional_t<IsConst, const node, node>;
+
+		const toml::key& first;
+		value_type& second;
+	};
+
+	template <bool IsConst>
+	class table_iterator
+	{
+	  private:
+		template <bool>
+		friend class table_iterator;
+
+		using proxy_type		   = table_proxy_pair<IsConst>;
+		using mutable_map_iterator = table_map::iterator;
+		using const_map_iterator   = table_map::const_iterator;
+		using map_iterator		   = std::conditional_t<IsConst, const_map_iterator, mutable_map_iterator>;
+
+		mutable map_iterator iter_;
+		alignas(proxy_type) mutable unsigned char proxy_[sizeof(proxy_type)];
+		mutable bool proxy_instantiated_ = false;
+
+		TOML_NODISCARD
+		proxy_type* get_proxy() const noexcept
+		{
+			if (!proxy_instantiated_)
+			{
+				auto p = ::new (static_cast<void*>(proxy_)) proxy_type{ iter_->first, *iter_->second.get() };
+				proxy_instantiated_ = true;
+				return p;
+			}
+			else
+				return TOML_LAUNDER(reinterpret_cast<proxy_type*>(proxy_));
+		}
+
+	  public:
+		TOML_NODISCARD_CTOR
+		table_iterator() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		explicit table_iterator(mutable_map_iterator iter) noexcept //
+			: iter_{ iter }
+		{}
+
+		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
+		TOML_NODISCARD_CTOR
+		explicit table_iterator(const_map_iterator iter) noexcept //
+			: iter_{ iter }
+		{}
+
+		TOML_CONSTRAINED_TEMPLATE(C, bool C = IsConst)
+		TOML_NODISCARD_CTOR
+		table_iterator(const table_iterator<false>& other) noexcept //
+			: iter_{ other.iter_ }
+		{}
+
+		TOML_NODISCARD_CTOR
+		table_iterator(const table_iterator& other) noexcept //
+			: iter_{ other.iter_ }
+		{}
+
+		table_iterator& operator=(const table_iterator& rhs) noexcept
+		{
+			iter_				= rhs.iter_;
+			proxy_instantiated_ = false;
+			return *this;
+		}
+
+		using value_type		= table_proxy_pair<IsConst>;
+		using reference			= value_type&;
+		using pointer			= value_type*;
+		using difference_type	= typename std::iterator_traits<map_iterator>::difference_type;
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		table_iterator& operator++() noexcept // ++pre
+		{
+			++iter_;
+			proxy_instantiated_ = false;
+			return *this;
+		}
+
+		table_iterator operator++(int) noexcept // post++
+		{
+			table_iterator out{ iter_ };
+			++iter_;
+			proxy_instantiated_ = false;
+			return out;
+		}
+
+		table_iterator& operator--() noexcept // --pre
+		{
+			--iter_;
+			proxy_instantiated_ = false;
+			return *this;
+		}
+
+		table_iterator operator--(int) noexcept // post--
+		{
+			table_iterator out{ iter_ };
+			--iter_;
+			proxy_instantiated_ = false;
+			return out;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		reference operator*() const noexcept
+		{
+			return *get_proxy();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		pointer operator->() const noexcept
+		{
+			return get_proxy();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		explicit operator const map_iterator&() const noexcept
+		{
+			return iter_;
+		}
+
+		TOML_CONSTRAINED_TEMPLATE(!C, bool C = IsConst)
+		TOML_PURE_INLINE_GETTER
+		explicit operator const const_map_iterator() const noexcept
+		{
+			return iter_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		friend bool operator==(const table_iterator& lhs, const table_iterator& rhs) noexcept
+		{
+			return lhs.iter_ == rhs.iter_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		friend bool operator!=(const table_iterator& lhs, const table_iterator& rhs) noexcept
+		{
+			return lhs.iter_ != rhs.iter_;
+		}
+	};
+
+	struct table_init_pair
 	{
 		mutable toml::key key;
 		mutable node_ptr value;
@@ -7661,6 +9375,9 @@ TOML_IMPL_NAMESPACE_START
 			  value{ make_node(static_cast<V&&>(v), flags) }
 		{}
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_IMPL_NAMESPACE_END;
 
@@ -7670,14 +9387,21 @@ TOML_NAMESPACE_START
 
 	using const_table_iterator = POXY_IMPLEMENTATION_DETAIL(impl::table_iterator<true>);
 
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, pmralloc, stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
 	class TOML_EXPORTED_CLASS table : public node
 	{
 	  private:
 
-		using map_type			 = std::map<toml::key, impl::node_ptr, std::less<>>;
-		using map_pair			 = std::pair<const toml::key, impl::node_ptr>;
+		using map_type			 = impl::table_map;
+		using map_pair			 = typename map_type::value_type;
 		using map_iterator		 = typename map_type::iterator;
 		using const_map_iterator = typename map_type::const_iterator;
+
+		template <typename>
+		friend class TOML_PARSER_TYPENAME;
+		impl::arena_ref arena_; // the arena the nodes are in, if any (declared before map_ so it outlives them)
 		map_type map_;
 
 		bool inline_ = false;
@@ -7686,6 +9410,17 @@ TOML_NAMESPACE_START
 		TOML_EXPORTED_MEMBER_FUNCTION
 		table(const impl::table_init_pair*, const impl::table_init_pair*);
 
+		// the resource new child nodes are allocated from (null means the global heap)
+		TOML_PURE_INLINE_GETTER
+		impl::memory_resource* node_resource() const noexcept
+		{
+#if TOML_ENABLE_PMR
+			return map_.get_allocator().resource();
+#else
+			return nullptr;
+#endif
+		}
+
 	  public:
 
 		TOML_NODISCARD_CTOR
@@ -7703,6 +9438,30 @@ TOML_NAMESPACE_START
 		TOML_EXPORTED_MEMBER_FUNCTION
 		table(table&& other) noexcept;
 
+#if TOML_ENABLE_PMR
+
+		using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit table(const allocator_type& alloc) noexcept;
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		table(const table& other, const allocator_type& alloc);
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		table(table&& other, const allocator_type& alloc);
+
+		TOML_PURE_INLINE_GETTER
+		allocator_type get_allocator() const noexcept
+		{
+			return allocator_type{ map_.get_allocator().resource() };
+		}
+
+#endif
+
 		TOML_NODISCARD_CTOR
 		TOML_EXPORTED_MEMBER_FUNCTION
 		explicit table(std::initializer_list<impl::table_init_pair> kvps) //
@@ -7713,10 +9472,10 @@ TOML_NAMESPACE_START
 		table& operator=(const table&);
 
 		TOML_EXPORTED_MEMBER_FUNCTION
-		table& operator=(table&& rhs) noexcept;
+		table& operator=(table&& rhs) noexcept(!TOML_ENABLE_PMR);
 
 		TOML_CONST_INLINE_GETTER
-		node_type type() const noexcept final
+		node_type type() const noexcept
 		{
 			return node_type::table;
 		}
@@ -7745,13 +9504,13 @@ TOML_NAMESPACE_START
 			return is_homogeneous(impl::node_type_of<type>);
 		}
 		TOML_CONST_INLINE_GETTER
-		bool is_table() const noexcept final
+		bool is_table() const noexcept
 		{
 			return true;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_array() const noexcept final
+		bool is_array() const noexcept
 		{
 			return false;
 		}
@@ -7763,163 +9522,163 @@ TOML_NAMESPACE_START
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_value() const noexcept final
+		bool is_value() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_string() const noexcept final
+		bool is_string() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_integer() const noexcept final
+		bool is_integer() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_floating_point() const noexcept final
+		bool is_floating_point() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_number() const noexcept final
+		bool is_number() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_boolean() const noexcept final
+		bool is_boolean() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_date() const noexcept final
+		bool is_date() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_time() const noexcept final
+		bool is_time() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		bool is_date_time() const noexcept final
+		bool is_date_time() const noexcept
 		{
 			return false;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		table* as_table() noexcept final
+		table* as_table() noexcept
 		{
 			return this;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		array* as_array() noexcept final
+		array* as_array() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<std::string>* as_string() noexcept final
+		toml::value<std::string>* as_string() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<int64_t>* as_integer() noexcept final
+		toml::value<int64_t>* as_integer() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<double>* as_floating_point() noexcept final
+		toml::value<double>* as_floating_point() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<bool>* as_boolean() noexcept final
+		toml::value<bool>* as_boolean() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<date>* as_date() noexcept final
+		toml::value<date>* as_date() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<time>* as_time() noexcept final
+		toml::value<time>* as_time() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		toml::value<date_time>* as_date_time() noexcept final
+		toml::value<date_time>* as_date_time() noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const table* as_table() const noexcept final
+		const table* as_table() const noexcept
 		{
 			return this;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const array* as_array() const noexcept final
+		const array* as_array() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<std::string>* as_string() const noexcept final
+		const toml::value<std::string>* as_string() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<int64_t>* as_integer() const noexcept final
+		const toml::value<int64_t>* as_integer() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<double>* as_floating_point() const noexcept final
+		const toml::value<double>* as_floating_point() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<bool>* as_boolean() const noexcept final
+		const toml::value<bool>* as_boolean() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date>* as_date() const noexcept final
+		const toml::value<date>* as_date() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<time>* as_time() const noexcept final
+		const toml::value<time>* as_time() const noexcept
 		{
 			return nullptr;
 		}
 
 		TOML_CONST_INLINE_GETTER
-		const toml::value<date_time>* as_date_time() const noexcept final
+		const toml::value<date_time>* as_date_time() const noexcept
 		{
 			return nullptr;
 		}
@@ -8451,7 +10210,8 @@ TOML_NAMESPACE_START
 						{
 #endif
 							ipos->second.reset(
-								new impl::wrap_node<unwrapped_type>{ static_cast<ValueArgs&&>(args)... });
+								impl::create_node<impl::wrap_node<unwrapped_type>>(node_resource(),
+																				   static_cast<ValueArgs&&>(args)...));
 #if TOML_COMPILER_HAS_EXCEPTIONS
 						}
 						catch (...)
@@ -8501,7 +10261,7 @@ TOML_NAMESPACE_START
 				{
 					ipos = insert_with_hint(const_iterator{ ipos },
 											toml::key{ static_cast<KeyType&&>(key) },
-											impl::make_node(static_cast<ValueType&&>(val), flags));
+											impl::make_node(static_cast<ValueType&&>(val), flags, node_resource()));
 					return { iterator{ ipos }, true };
 				}
 				return { iterator{ ipos }, false };
@@ -8557,12 +10317,12 @@ TOML_NAMESPACE_START
 				{
 					ipos = insert_with_hint(const_iterator{ ipos },
 											toml::key{ static_cast<KeyType&&>(key) },
-											impl::make_node(static_cast<ValueType&&>(val), flags));
+											impl::make_node(static_cast<ValueType&&>(val), flags, node_resource()));
 					return { iterator{ ipos }, true };
 				}
 				else
 				{
-					(*ipos).second = impl::make_node(static_cast<ValueType&&>(val), flags);
+					(*ipos).second = impl::make_node(static_cast<ValueType&&>(val), flags, node_resource());
 					return { iterator{ ipos }, false };
 				}
 			}
@@ -8602,10 +10362,11 @@ TOML_NAMESPACE_START
 				auto ipos			= get_lower_bound(key_view);
 				if (ipos == map_.end() || ipos->first != key_view)
 				{
-					ipos = insert_with_hint(
-						const_iterator{ ipos },
-						toml::key{ static_cast<KeyType&&>(key) },
-						impl::node_ptr{ new impl::wrap_node<unwrapped_type>{ static_cast<ValueArgs&&>(args)... } });
+					ipos = insert_with_hint(const_iterator{ ipos },
+											toml::key{ static_cast<KeyType&&>(key) },
+											impl::node_ptr{ impl::create_node<impl::wrap_node<unwrapped_type>>(
+												node_resource(),
+												static_cast<ValueArgs&&>(args)...) });
 					return { iterator{ ipos }, true };
 				}
 				return { iterator{ ipos }, false };
@@ -8672,6 +10433,9 @@ TOML_NAMESPACE_START
 
 #endif
 	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 }
 TOML_NAMESPACE_END;
 
@@ -9067,20 +10831,100 @@ TOML_IMPL_NAMESPACE_START
 		}
 	};
 
+	// instruction sets the bulk-scanning functions below can be run with.
+	enum class simd_tier : uint8_t
+	{
+		scalar,
+		sse2,
+		sse4_1,
+		avx2
+	};
+
+	// the tier the bulk-scanning functions are using;
+	// by default this is the best one both compiled in and supported by the CPU, detected on first use.
+	// (not a pure function; it changes with force_simd_tier())
+	TOML_NODISCARD
+	simd_tier active_simd_tier() noexcept;
+
+	// switches the bulk-scanning functions to the given tier (or the best one available, if lower),
+	// returning the tier actually selected. Not thread-safe; intended for testing.
+	simd_tier force_simd_tier(simd_tier tier) noexcept;
+
 	TOML_PURE_GETTER
 	TOML_ATTR(nonnull)
 	bool is_ascii(const char* str, size_t len) noexcept;
-}
-TOML_IMPL_NAMESPACE_END;
-
-#ifdef _MSC_VER
-#pragma pop_macro("min")
-#pragma pop_macro("max")
-#ifndef __clang__
-#pragma inline_recursion(off)
-#endif
-#endif
-TOML_POP_WARNINGS;
+
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	size_t ascii_prefix_length(const char* str, size_t len) noexcept;
+
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	bool is_valid_utf8(const char* str, size_t len) noexcept;
+
+	// length of the leading run of spaces and tabs.
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	size_t horizontal_whitespace_prefix_length(const char* str, size_t len) noexcept;
+
+	// length of the leading run of printable ASCII characters (or TABs) that aren't one of the two given characters;
+	// i.e. the characters in string values and comments that need no special handling by the parser.
+	TOML_PURE_GETTER
+	TOML_ATTR(nonnull)
+	size_t plain_string_prefix_length(const char* str, size_t len, char special1, char special2) noexcept;
+}
+TOML_IMPL_NAMESPACE_END;
+
+#ifdef _MSC_VER
+#pragma pop_macro("min")
+#pragma pop_macro("max")
+#ifndef __clang__
+#pragma inline_recursion(off)
+#endif
+#endif
+TOML_POP_WARNINGS;
+
+//********  impl/float_parsing.hpp  ************************************************************************************
+
+#if TOML_ENABLE_PARSER
+
+TOML_PUSH_WARNINGS;
+#ifdef _MSC_VER
+#ifndef __clang__
+#pragma inline_recursion(on)
+#endif
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+#endif
+
+TOML_IMPL_NAMESPACE_START
+{
+	// converts the text of a decimal floating-point value (digits, an optional '.' and an optional exponent,
+	// e.g. "6.626e-34"; no sign or underscores) to the nearest double, without going through iostreams or locales.
+	// returns false if the value is too large to be represented.
+	TOML_NODISCARD
+	bool decimal_to_double(std::string_view text, double& value) noexcept;
+
+	// converts the whole and fractional hexadecimal digits of a hexadecimal floating-point value and its binary
+	// exponent (e.g. "1a", "8" and -3 for 0x1a.8p-3) to the nearest double.
+	// returns false if the value is too large to be represented.
+	TOML_NODISCARD
+	bool hex_to_double(std::string_view whole, std::string_view fraction, int64_t exponent, double& value) noexcept;
+}
+TOML_IMPL_NAMESPACE_END;
+
+#ifdef _MSC_VER
+#pragma pop_macro("min")
+#pragma pop_macro("max")
+#ifndef __clang__
+#pragma inline_recursion(off)
+#endif
+#endif
+TOML_POP_WARNINGS;
+
+#endif // TOML_ENABLE_PARSER
 
 //********  impl/parse_error.hpp  **************************************************************************************
 
@@ -9228,6 +11072,8 @@ TOML_PUSH_WARNINGS;
 TOML_NAMESPACE_START
 {
 	TOML_ABI_NAMESPACE_START(noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
 	class parse_result
 	{
@@ -9546,6 +11392,8 @@ TOML_NAMESPACE_START
 #endif
 	};
 
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END;
 }
 TOML_NAMESPACE_END;
@@ -9578,33 +11426,87 @@ TOML_PUSH_WARNINGS;
 
 TOML_NAMESPACE_START
 {
+	class byte_source
+	{
+	  public:
+
+		static constexpr size_t default_chunk_size = 64u * 1024u;
+
+		static constexpr size_t read_error = static_cast<size_t>(-1);
+
+	  private:
+
+		void* callable_;
+		size_t (*read_)(void*, char*, size_t);
+		size_t chunk_size_;
+
+	  public:
+
+		TOML_CONSTRAINED_TEMPLATE((std::is_invocable_r_v<size_t, std::remove_reference_t<Callable>&, char*, size_t>
+								   && !std::is_same_v<impl::remove_cvref<Callable>, byte_source>),
+								  typename Callable)
+		TOML_NODISCARD_CTOR
+		byte_source(Callable&& callable, size_t chunk_size = default_chunk_size) noexcept
+			: callable_{ const_cast<void*>(static_cast<const volatile void*>(std::addressof(callable))) },
+			  read_{ [](void* c, char* buffer, size_t capacity) -> size_t
+					 {
+						 auto& func = *static_cast<std::remove_reference_t<Callable>*>(c);
+						 return static_cast<size_t>(func(buffer, capacity));
+					 } },
+			  chunk_size_{ chunk_size ? chunk_size : default_chunk_size }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		size_t chunk_size() const noexcept
+		{
+			return chunk_size_;
+		}
+
+		TOML_NODISCARD
+		TOML_ATTR(nonnull)
+		size_t operator()(char* buffer, size_t capacity) const
+		{
+			return read_(callable_, buffer, capacity);
+		}
+	};
+
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string_view source_path = {});
+	parse_result TOML_CALLCONV parse(std::string_view doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string && source_path);
+	parse_result TOML_CALLCONV parse(std::string_view doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse_file(std::string_view file_path);
+	parse_result TOML_CALLCONV parse_file(std::string_view file_path, parse_flags flags = parse_flags::none);
 
 #if TOML_HAS_CHAR8
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string_view source_path = {});
+	parse_result TOML_CALLCONV parse(std::u8string_view doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string && source_path);
+	parse_result TOML_CALLCONV parse(std::u8string_view doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path);
+	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path, parse_flags flags = parse_flags::none);
 
 #endif // TOML_HAS_CHAR8
 
@@ -9612,15 +11514,25 @@ TOML_NAMESPACE_START
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::wstring_view source_path);
+	parse_result TOML_CALLCONV parse(std::string_view doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
+
+	TOML_NODISCARD
+	TOML_EXPORTED_FREE_FUNCTION
+	parse_result TOML_CALLCONV parse(std::istream & doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::wstring_view source_path);
+	parse_result TOML_CALLCONV parse(byte_source doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path);
+	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path, parse_flags flags = parse_flags::none);
 
 #endif // TOML_ENABLE_WINDOWS_COMPAT
 
@@ -9628,23 +11540,45 @@ TOML_NAMESPACE_START
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::wstring_view source_path);
+	parse_result TOML_CALLCONV parse(std::u8string_view doc,
+									 std::wstring_view source_path,
+									 parse_flags flags = parse_flags::none);
 
 #endif // TOML_HAS_CHAR8 && TOML_ENABLE_WINDOWS_COMPAT
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string_view source_path = {});
+	parse_result TOML_CALLCONV parse(std::istream & doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
+
+	TOML_NODISCARD
+	TOML_EXPORTED_FREE_FUNCTION
+	parse_result TOML_CALLCONV parse(std::istream & doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
+
+	TOML_NODISCARD
+	TOML_EXPORTED_FREE_FUNCTION
+	parse_result TOML_CALLCONV parse(byte_source doc,
+									 std::string_view source_path = {},
+									 parse_flags flags			  = parse_flags::none);
 
 	TOML_NODISCARD
 	TOML_EXPORTED_FREE_FUNCTION
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string && source_path);
+	parse_result TOML_CALLCONV parse(byte_source doc,
+									 std::string && source_path,
+									 parse_flags flags = parse_flags::none);
 
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 
 	inline namespace literals
 	{
 		TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, lit_ex, lit_noex);
+		TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, lit_pmralloc, lit_stdalloc);
+		TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
 		TOML_NODISCARD
 		TOML_ALWAYS_INLINE
@@ -9664,11 +11598,143 @@ TOML_NAMESPACE_START
 
 #endif // TOML_HAS_CHAR8
 
+		TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+		TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 		TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 	}
 }
 TOML_NAMESPACE_END;
 
+TOML_IMPL_NAMESPACE_START
+{
+	struct parse_scratch;
+
+	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, impl_ex, impl_noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, impl_pmralloc, impl_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
+	class push_parser_state
+	{
+	  public:
+		virtual void feed(std::string_view chunk) = 0;
+
+		TOML_NODISCARD
+		virtual parse_result finish() = 0;
+
+		virtual ~push_parser_state() noexcept = default;
+	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
+	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
+}
+TOML_IMPL_NAMESPACE_END;
+
+TOML_NAMESPACE_START
+{
+	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
+	class TOML_EXPORTED_CLASS push_parser
+	{
+	  private:
+
+		std::unique_ptr<impl::push_parser_state> state_;
+
+	  public:
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit push_parser(std::string_view source_path = {}, parse_flags flags = parse_flags::none);
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit push_parser(std::string && source_path, parse_flags flags = parse_flags::none);
+
+#if TOML_ENABLE_WINDOWS_COMPAT
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit push_parser(std::wstring_view source_path, parse_flags flags = parse_flags::none);
+
+#endif
+
+		TOML_NODISCARD_CTOR
+		push_parser(push_parser&&) noexcept = default;
+
+		push_parser& operator=(push_parser&&) noexcept = default;
+
+		~push_parser() noexcept = default;
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		void feed(std::string_view chunk);
+
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result finish();
+	};
+
+	class TOML_EXPORTED_CLASS parse_context
+	{
+	  private:
+
+		std::unique_ptr<impl::parse_scratch> scratch_;
+		parse_flags flags_;
+
+	  public:
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		explicit parse_context(parse_flags flags = parse_flags::none);
+
+		TOML_NODISCARD_CTOR
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_context(parse_context&&) noexcept;
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_context& operator=(parse_context&&) noexcept;
+
+		TOML_EXPORTED_MEMBER_FUNCTION
+		~parse_context() noexcept;
+
+		TOML_PURE_INLINE_GETTER
+		parse_flags flags() const noexcept
+		{
+			return flags_;
+		}
+
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::string_view doc, std::string_view source_path = {});
+
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::string_view doc, std::string && source_path);
+
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::istream & doc, std::string_view source_path = {});
+
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(std::istream & doc, std::string && source_path);
+
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse(byte_source doc, std::string_view source_path = {});
+
+		TOML_NODISCARD
+		TOML_EXPORTED_MEMBER_FUNCTION
+		parse_result parse_file(std::string_view file_path);
+	};
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
+	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
+}
+TOML_NAMESPACE_END;
+
 #ifdef _MSC_VER
 #pragma pop_macro("min")
 #pragma pop_macro("max")
@@ -10787,18 +12853,22 @@ TOML_PUSH_WARNINGS;
 TOML_NAMESPACE_START
 {
 	TOML_EXTERNAL_LINKAGE
-	node::node() noexcept = default;
+	node::node(node_type type) noexcept //
+		: type_{ type }
+	{}
 
 	TOML_EXTERNAL_LINKAGE
 	node::~node() noexcept = default;
 
 	TOML_EXTERNAL_LINKAGE
 	node::node(node && other) noexcept //
-		: source_{ std::exchange(other.source_, {}) }
+		: source_{ std::exchange(other.source_, {}) },
+		  type_{ other.type_ }
 	{}
 
 	TOML_EXTERNAL_LINKAGE
-	node::node(const node& /*other*/) noexcept
+	node::node(const node& other) noexcept //
+		: type_{ other.type_ }
 	{
 		// does not copy source information - this is not an error
 		//
@@ -10880,6 +12950,53 @@ TOML_NAMESPACE_END;
 
 TOML_IMPL_NAMESPACE_START
 {
+	TOML_EXTERNAL_LINKAGE
+	node_arena::~node_arena() noexcept
+	{
+		while (blocks_)
+		{
+			auto next = blocks_->next;
+			::operator delete(static_cast<void*>(blocks_));
+			blocks_ = next;
+		}
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	void* node_arena::allocate_from_new_block(size_t size, size_t align)
+	{
+		constexpr size_t header =
+			(sizeof(block) + (alignof(std::max_align_t) - 1u)) & ~(alignof(std::max_align_t) - 1u);
+		const size_t needed = header + size + (align > alignof(std::max_align_t) ? align : 0u);
+
+		// requests that wouldn't fit in a regular block get one of their own, linked in behind the current block
+		// so the remainder of the current block is still used for subsequent allocations
+		const bool oversized	= needed > next_block_size_;
+		const size_t block_size = oversized ? needed : next_block_size_;
+
+		auto blk = static_cast<block*>(::operator new(block_size));
+		reserved_ += block_size;
+
+		const auto begin   = reinterpret_cast<uintptr_t>(blk) + header;
+		const auto aligned = (begin + (align - 1u)) & ~static_cast<uintptr_t>(align - 1u);
+
+		if (oversized && blocks_)
+		{
+			blk->next	  = blocks_->next;
+			blocks_->next = blk;
+		}
+		else
+		{
+			blk->next = blocks_;
+			blocks_	  = blk;
+			cursor_	  = reinterpret_cast<char*>(aligned + size);
+			end_	  = reinterpret_cast<char*>(blk) + block_size;
+			if (!oversized && next_block_size_ < max_block_size)
+				next_block_size_ *= 2u;
+		}
+
+		return reinterpret_cast<void*>(aligned);
+	}
+
 	TOML_PURE_GETTER
 	TOML_EXTERNAL_LINKAGE
 	bool TOML_CALLCONV node_deep_equality(const node* lhs, const node* rhs) noexcept
@@ -11720,78 +13837,324 @@ TOML_PUSH_WARNINGS;
 #undef max
 #endif
 
-TOML_NAMESPACE_START
+TOML_ANON_NAMESPACE_START
 {
-	TOML_EXTERNAL_LINKAGE
-	array::array() noexcept
-	{
-#if TOML_LIFETIME_HOOKS
-		TOML_ARRAY_CREATED;
-#endif
-	}
-
-	TOML_EXTERNAL_LINKAGE
-	array::~array() noexcept
+	// keeps a compact array's values from being released while a const member function reads them
+	class packed_values_reader
 	{
-#if TOML_LIFETIME_HOOKS
-		TOML_ARRAY_DESTROYED;
-#endif
-	}
+		const impl::packed_array_storage* storage_;
 
-	TOML_EXTERNAL_LINKAGE
-	array::array(const impl::array_init_elem* b, const impl::array_init_elem* e)
-	{
-#if TOML_LIFETIME_HOOKS
-		TOML_ARRAY_CREATED;
-#endif
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit packed_values_reader(const impl::packed_array_storage* storage) noexcept //
+			: storage_{ storage && storage->begin_reading() ? storage : nullptr }
+		{}
 
-		TOML_ASSERT_ASSUME(b);
-		TOML_ASSERT_ASSUME(e);
-		TOML_ASSERT_ASSUME(b <= e);
+		packed_values_reader(const packed_values_reader&) = delete;
+		packed_values_reader& operator=(const packed_values_reader&) = delete;
 
-		if TOML_UNLIKELY(b == e)
-			return;
+		~packed_values_reader() noexcept
+		{
+			if (storage_)
+				storage_->end_reading();
+		}
 
-		size_t cap{};
-		for (auto it = b; it != e; it++)
+		TOML_PURE_INLINE_GETTER
+		explicit operator bool() const noexcept
 		{
-			if (it->value)
-				cap++;
+			return !!storage_;
 		}
-		if TOML_UNLIKELY(!cap)
-			return;
 
-		elems_.reserve(cap);
-		for (; b != e; b++)
+		TOML_PURE_INLINE_GETTER
+		const impl::packed_array_storage& operator*() const noexcept
 		{
-			if (b->value)
-				elems_.push_back(std::move(b->value));
+			return *storage_;
 		}
-	}
+	};
 
-	TOML_EXTERNAL_LINKAGE
-	array::array(const array& other) //
-		: node(other)
+	template <typename T>
+	TOML_INTERNAL_LINKAGE
+	bool packed_values_equal(const T* lhs, const T* rhs, size_t count) noexcept
 	{
-		elems_.reserve(other.elems_.size());
-		for (const auto& elem : other)
-			elems_.emplace_back(impl::make_node(elem));
-
-#if TOML_LIFETIME_HOOKS
-		TOML_ARRAY_CREATED;
-#endif
+		if constexpr (std::is_same_v<T, double>)
+		{
+			// (same semantics as value<double>'s equality operators)
+			for (size_t i = 0; i < count; i++)
+			{
+				const auto lhs_nan = impl::fpclassify(lhs[i]) == impl::fp_class::nan;
+				const auto rhs_nan = impl::fpclassify(rhs[i]) == impl::fp_class::nan;
+				if (lhs_nan != rhs_nan || (!lhs_nan && lhs[i] != rhs[i]))
+					return false;
+			}
+			return true;
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+				if (lhs[i] != rhs[i])
+					return false;
+			return true;
+		}
+	}
+
+	TOML_INTERNAL_LINKAGE
+	bool packed_values_equal(const impl::packed_array_storage& lhs, const impl::packed_array_storage& rhs) noexcept
+	{
+		TOML_ASSERT(lhs.size == rhs.size);
+
+		if (lhs.type == rhs.type)
+		{
+			switch (lhs.type)
+			{
+				case node_type::integer:
+					return packed_values_equal(lhs.values<int64_t>(), rhs.values<int64_t>(), lhs.size);
+				case node_type::floating_point:
+					return packed_values_equal(lhs.values<double>(), rhs.values<double>(), lhs.size);
+				case node_type::boolean: return packed_values_equal(lhs.values<bool>(), rhs.values<bool>(), lhs.size);
+				default: break;
+			}
+		}
+
+		for (size_t i = 0; i < lhs.size; i++)
+			if (!(lhs.get(i) == rhs.get(i)))
+				return false;
+		return true;
+	}
+
+	TOML_INTERNAL_LINKAGE
+	bool packed_values_equal(const impl::packed_array_storage& lhs, const impl::array_vector& rhs) noexcept
+	{
+		TOML_ASSERT(lhs.size == rhs.size());
+
+		impl::compact_value val;
+		for (size_t i = 0; i < lhs.size; i++)
+			if (!val.assign(*rhs[i]) || !(lhs.get(i) == val))
+				return false;
+		return true;
+	}
+
+	TOML_INTERNAL_LINKAGE
+	void create_nodes(const impl::packed_array_storage& storage,
+					  impl::array_vector& nodes,
+					  impl::memory_resource* resource)
+	{
+		nodes.clear();
+		nodes.reserve(storage.size);
+		switch (storage.type)
+		{
+			case node_type::integer:
+				for (auto val = storage.values<int64_t>(), end = val + storage.size; val != end; val++)
+					nodes.emplace_back(impl::create_node<toml::value<int64_t>>(resource, *val));
+				break;
+
+			case node_type::floating_point:
+				for (auto val = storage.values<double>(), end = val + storage.size; val != end; val++)
+					nodes.emplace_back(impl::create_node<toml::value<double>>(resource, *val));
+				break;
+
+			case node_type::boolean:
+				for (auto val = storage.values<bool>(), end = val + storage.size; val != end; val++)
+					nodes.emplace_back(impl::create_node<toml::value<bool>>(resource, *val));
+				break;
+
+			case node_type::none:
+				for (auto val = storage.values<impl::compact_value>(), end = val + storage.size; val != end;
+					 val++)
+				{
+					switch (val->type)
+					{
+						case node_type::integer:
+							nodes.emplace_back(impl::create_node<toml::value<int64_t>>(resource, val->integer));
+							break;
+
+						case node_type::floating_point:
+							nodes.emplace_back(
+								impl::create_node<toml::value<double>>(resource, val->floating_point));
+							break;
+
+						case node_type::boolean:
+							nodes.emplace_back(impl::create_node<toml::value<bool>>(resource, val->boolean));
+							break;
+
+						case node_type::date:
+							nodes.emplace_back(impl::create_node<toml::value<toml::date>>(resource, val->date));
+							break;
+
+						case node_type::time:
+							nodes.emplace_back(impl::create_node<toml::value<toml::time>>(resource, val->time));
+							break;
+
+						case node_type::date_time:
+						{
+							auto dt = val->has_offset ? toml::date_time{ val->date, val->time, toml::time_offset{} }
+													  : toml::date_time{ val->date, val->time };
+							if (val->has_offset)
+								dt.offset->minutes = val->offset_minutes;
+							nodes.emplace_back(impl::create_node<toml::value<toml::date_time>>(resource, dt));
+							break;
+						}
+
+						default: TOML_UNREACHABLE;
+					}
+				}
+				break;
+
+			default: TOML_UNREACHABLE;
+		}
+	}
+}
+TOML_ANON_NAMESPACE_END;
+
+TOML_NAMESPACE_START
+{
+	TOML_EXTERNAL_LINKAGE
+	array::array() noexcept //
+		: node(node_type::array)
+	{
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	array::~array() noexcept
+	{
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_DESTROYED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(const impl::array_init_elem* b, const impl::array_init_elem* e) //
+		: node(node_type::array)
+	{
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+
+		TOML_ASSERT_ASSUME(b);
+		TOML_ASSERT_ASSUME(e);
+		TOML_ASSERT_ASSUME(b <= e);
+
+		if TOML_UNLIKELY(b == e)
+			return;
+
+		size_t cap{};
+		for (auto it = b; it != e; it++)
+		{
+			if (it->value)
+				cap++;
+		}
+		if TOML_UNLIKELY(!cap)
+			return;
+
+		elems_.reserve(cap);
+		for (; b != e; b++)
+		{
+			if (b->value)
+				elems_.push_back(std::move(b->value));
+		}
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(const array& other) //
+		: node(other)
+	{
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ other.packed_.get() })
+			packed_ = (*values).clone(node_resource());
+		else
+		{
+			elems_.reserve(other.size());
+			for (const auto& elem : other)
+				elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+		}
+
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	array::array(array && other) noexcept //
 		: node(std::move(other)),
-		  elems_(std::move(other.elems_))
+		  arena_{ std::move(other.arena_) },
+		  elems_{ std::move(other.elems_) },
+		  packed_{ std::move(other.packed_) }
+	{
+		// (released compact values leave only the nodes)
+		if (packed_ && packed_->values_released())
+			release_packed_storage();
+
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+	}
+
+#if TOML_ENABLE_PMR
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(const allocator_type& alloc) noexcept //
+		: node(node_type::array),
+		  elems_{ alloc }
+	{
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(const array& other, const allocator_type& alloc) //
+		: node(other),
+		  elems_{ alloc }
+	{
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ other.packed_.get() })
+			packed_ = (*values).clone(node_resource());
+		else
+		{
+			elems_.reserve(other.size());
+			for (const auto& elem : other)
+				elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+		}
+
+#if TOML_LIFETIME_HOOKS
+		TOML_ARRAY_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	array::array(array && other, const allocator_type& alloc) //
+		: node(std::move(other)),
+		  elems_{ alloc }
 	{
+		if (other.packed_ && other.packed_->resource == node_resource())
+		{
+			arena_	= std::move(other.arena_);
+			packed_ = std::move(other.packed_);
+			if (packed_->values_released())
+				release_packed_storage();
+		}
+		else if (other.packed_ && !other.packed_->values_released())
+			packed_ = other.packed_->clone(node_resource());
+		else if (!other.packed_ && other.elems_.get_allocator() == elems_.get_allocator())
+		{
+			arena_ = std::move(other.arena_);
+			elems_ = std::move(other.elems_);
+		}
+		else
+		{
+			elems_.reserve(other.size());
+			for (const auto& elem : other)
+				elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+		}
+		other.clear();
+
 #if TOML_LIFETIME_HOOKS
 		TOML_ARRAY_CREATED;
 #endif
 	}
 
+#endif // TOML_ENABLE_PMR
+
 	TOML_EXTERNAL_LINKAGE
 	array& array::operator=(const array& rhs)
 	{
@@ -11799,20 +14162,44 @@ TOML_NAMESPACE_START
 		{
 			node::operator=(rhs);
 			elems_.clear();
-			elems_.reserve(rhs.elems_.size());
-			for (const auto& elem : rhs)
-				elems_.emplace_back(impl::make_node(elem));
+			packed_.reset();
+			arena_.reset(); // (after elems_, since the old nodes may have been in it)
+			if (const TOML_ANON_NAMESPACE::packed_values_reader values{ rhs.packed_.get() })
+				packed_ = (*values).clone(node_resource());
+			else
+			{
+				elems_.reserve(rhs.size());
+				for (const auto& elem : rhs)
+					elems_.emplace_back(impl::make_node(elem, preserve_source_value_flags, node_resource()));
+			}
 		}
 		return *this;
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	array& array::operator=(array&& rhs) noexcept
+	array& array::operator=(array&& rhs) noexcept(!TOML_ENABLE_PMR)
 	{
 		if (&rhs != this)
 		{
+#if TOML_ENABLE_PMR
+			// the array keeps its own allocator, so anything from a different memory resource gets copied
+			if (rhs.node_resource() != node_resource())
+				return *this = array{ std::move(rhs), get_allocator() };
+#endif
+
+			// rhs might be one of the nodes about to be released, so everything's taken from it first
+			auto arena	= std::move(rhs.arena_);
+			auto elems	= std::move(rhs.elems_);
+			auto packed = std::move(rhs.packed_);
 			node::operator=(std::move(rhs));
-			elems_ = std::move(rhs.elems_);
+
+			elems_	= std::move(elems);
+			packed_ = std::move(packed);
+			arena_	= std::move(arena); // after elems_, since the old nodes may have been in the old arena
+
+			// (released compact values leave only the nodes)
+			if (packed_ && packed_->values_released())
+				release_packed_storage();
 		}
 		return *this;
 	}
@@ -11820,6 +14207,7 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void array::preinsertion_resize(size_t idx, size_t count)
 	{
+		unpack();
 		TOML_ASSERT(idx <= elems_.size());
 		TOML_ASSERT_ASSUME(count >= 1u);
 		const auto old_size			= elems_.size();
@@ -11837,26 +14225,97 @@ TOML_NAMESPACE_START
 	void array::insert_at_back(impl::node_ptr && elem)
 	{
 		TOML_ASSERT(elem);
+		unpack();
 		elems_.push_back(std::move(elem));
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	array::vector_iterator array::insert_at(const_vector_iterator pos, impl::node_ptr && elem)
 	{
+		unpack();
 		return elems_.insert(pos, std::move(elem));
 	}
 
+	TOML_EXTERNAL_LINKAGE
+	void array::create_packed_nodes() const
+	{
+		TOML_ASSERT_ASSUME(packed_);
+
+		// the first call creates the nodes; any others needing them meanwhile block until it's done
+		// (if it throws, the next call tries again)
+		auto& storage = *packed_;
+		std::call_once(storage.nodes_once,
+					   [&]
+					   {
+						   TOML_ANON_NAMESPACE::create_nodes(storage, storage.nodes, node_resource());
+						   storage.nodes_created.store(true, std::memory_order_release);
+						   storage.end_reading(); // the storage's own reference to compact values
+					   });
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	void array::release_packed_storage()
+	{
+		TOML_ASSERT_ASSUME(packed_);
+
+		if (!packed_->has_nodes())
+			create_packed_nodes();
+		elems_ = std::move(packed_->nodes); // (elems_ is empty and has the same allocator, so iterators stay valid)
+		packed_.reset();
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	bool array::pack()
+	{
+		if (packed_)
+			return true;
+		if (elems_.empty())
+			return false;
+
+		const auto type = elems_[0]->type();
+		if (type != node_type::integer && type != node_type::floating_point && type != node_type::boolean)
+			return false;
+		for (const auto& elem : elems_)
+		{
+			if (elem->type() != type)
+				return false;
+			if (type == node_type::integer && elem->as_integer()->flags() != value_flags::none)
+				return false;
+		}
+
+		auto storage = impl::packed_array_storage::create(type, node_resource());
+		storage->reserve(elems_.size());
+		for (const auto& elem : elems_)
+		{
+			switch (type)
+			{
+				case node_type::integer: storage->push_back(elem->as_integer()->get()); break;
+				case node_type::floating_point: storage->push_back(elem->as_floating_point()->get()); break;
+				case node_type::boolean: storage->push_back(elem->as_boolean()->get()); break;
+				default: TOML_UNREACHABLE;
+			}
+		}
+
+		elems_.clear();
+		packed_ = std::move(storage);
+		return true;
+	}
+
 	TOML_PURE_GETTER
 	TOML_EXTERNAL_LINKAGE
 	bool array::is_homogeneous(node_type ntype) const noexcept
 	{
-		if (elems_.empty())
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ packed_.get() })
+			return (*values).is_homogeneous(ntype);
+
+		const auto& nodes = elem_nodes(); // (only packed if the values were released, in which case there are nodes)
+		if (nodes.empty())
 			return false;
 
 		if (ntype == node_type::none)
-			ntype = elems_[0]->type();
+			ntype = nodes[0]->type();
 
-		for (const auto& val : elems_)
+		for (const auto& val : nodes)
 			if (val->type() != ntype)
 				return false;
 
@@ -11867,14 +14326,37 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	bool array::is_homogeneous(node_type ntype, node * &first_nonmatch) noexcept
 	{
-		if (elems_.empty())
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ packed_.get() })
 		{
-			first_nonmatch = {};
-			return false;
+			if ((*values).is_homogeneous(ntype))
+				return true;
+		}
+
+		unpack();
+		const node* fnm	  = nullptr;
+		const auto result = static_cast<const array&>(*this).is_homogeneous(ntype, fnm);
+		if (!result)
+			first_nonmatch = const_cast<node*>(fnm);
+		return result;
+	}
+
+	TOML_NODISCARD
+	TOML_EXTERNAL_LINKAGE
+	bool array::is_homogeneous(node_type ntype, const node*& first_nonmatch) const noexcept
+	{
+		first_nonmatch = {};
+		if (const TOML_ANON_NAMESPACE::packed_values_reader values{ packed_.get() })
+		{
+			if ((*values).is_homogeneous(ntype))
+				return true;
 		}
+
+		const auto& nodes = elem_nodes();
+		if (nodes.empty())
+			return false;
 		if (ntype == node_type::none)
-			ntype = elems_[0]->type();
-		for (const auto& val : elems_)
+			ntype = nodes[0]->type();
+		for (const auto& val : nodes)
 		{
 			if (val->type() != ntype)
 			{
@@ -11885,22 +14367,19 @@ TOML_NAMESPACE_START
 		return true;
 	}
 
-	TOML_NODISCARD
 	TOML_EXTERNAL_LINKAGE
-	bool array::is_homogeneous(node_type ntype, const node*& first_nonmatch) const noexcept
+	node& array::at(size_t index)
 	{
-		node* fnm		  = nullptr;
-		const auto result = const_cast<array&>(*this).is_homogeneous(ntype, fnm);
-		first_nonmatch	  = fnm;
-		return result;
+		unpack();
+		return const_cast<node&>(static_cast<const array&>(*this).at(index));
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	node& array::at(size_t index)
+	const node& array::at(size_t index) const
 	{
 #if TOML_COMPILER_HAS_EXCEPTIONS
 
-		return *elems_.at(index);
+		return *elem_nodes().at(index);
 
 #else
 
@@ -11914,18 +14393,37 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void array::reserve(size_t new_capacity)
 	{
+		// (so appending values with push_back() afterwards keeps it packed)
+		if (packed_ && !packed_->has_nodes())
+		{
+			packed_->reserve(new_capacity);
+			return;
+		}
+
+		unpack();
 		elems_.reserve(new_capacity);
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	void array::shrink_to_fit()
 	{
+		if (packed_)
+			return;
+
 		elems_.shrink_to_fit();
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	void array::truncate(size_t new_size)
 	{
+		if (packed_ && !packed_->has_nodes())
+		{
+			if (new_size < packed_->size)
+				packed_->size = new_size;
+			return;
+		}
+
+		unpack();
 		if (new_size < elems_.size())
 			elems_.resize(new_size);
 	}
@@ -11933,18 +14431,23 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	array::iterator array::erase(const_iterator pos) noexcept
 	{
+		unpack();
 		return iterator{ elems_.erase(const_vector_iterator{ pos }) };
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	array::iterator array::erase(const_iterator first, const_iterator last) noexcept
 	{
+		unpack();
 		return iterator{ elems_.erase(const_vector_iterator{ first }, const_vector_iterator{ last }) };
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	size_t array::total_leaf_count() const noexcept
 	{
+		if (packed_)
+			return packed_->size;
+
 		size_t leaves{};
 		for (size_t i = 0, e = elems_.size(); i < e; i++)
 		{
@@ -11955,8 +14458,15 @@ TOML_NAMESPACE_START
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	void array::flatten_child(array && child, size_t & dest_index) noexcept
+	void array::flatten_child(array && child, size_t & dest_index)
 	{
+		child.unpack();
+
+		// nodes in a document's arena can only be moved into an array holding a reference to the same arena
+		if (child.arena_ && !arena_)
+			arena_ = child.arena_;
+		const bool can_move = !child.arena_ || child.arena_.get() == arena_.get();
+
 		for (size_t i = 0, e = child.size(); i < e; i++)
 		{
 			auto type = child.elems_[i]->type();
@@ -11966,15 +14476,17 @@ TOML_NAMESPACE_START
 				if (!arr.empty())
 					flatten_child(std::move(arr), dest_index);
 			}
-			else
+			else if (can_move)
 				elems_[dest_index++] = std::move(child.elems_[i]);
+			else
+				elems_[dest_index++] = impl::make_node(*child.elems_[i], preserve_source_value_flags, node_resource());
 		}
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	array& array::flatten()&
 	{
-		if (elems_.empty())
+		if (packed_ || elems_.empty())
 			return *this;
 
 		bool requires_flattening	 = false;
@@ -12023,7 +14535,7 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	array& array::prune(bool recursive)& noexcept
 	{
-		if (elems_.empty())
+		if (packed_ || elems_.empty())
 			return *this;
 
 		for (size_t i = elems_.size(); i-- > 0u;)
@@ -12050,13 +14562,22 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void array::pop_back() noexcept
 	{
+		if (packed_ && !packed_->has_nodes())
+		{
+			packed_->size--;
+			return;
+		}
+
+		unpack();
 		elems_.pop_back();
 	}
 
 	TOML_EXTERNAL_LINKAGE
 	void array::clear() noexcept
 	{
+		packed_.reset();
 		elems_.clear();
+		arena_.reset();
 	}
 
 	TOML_EXTERNAL_LINKAGE
@@ -12064,17 +14585,31 @@ TOML_NAMESPACE_START
 	{
 		if (&lhs == &rhs)
 			return true;
-		if (lhs.elems_.size() != rhs.elems_.size())
+		if (lhs.size() != rhs.size())
 			return false;
-		for (size_t i = 0, e = lhs.elems_.size(); i < e; i++)
-		{
-			const auto lhs_type = lhs.elems_[i]->type();
-			const node& rhs_	= *rhs.elems_[i];
+		if (lhs.empty())
+			return true;
+
+		// (arrays with released compact values have their nodes instead)
+		const TOML_ANON_NAMESPACE::packed_values_reader lhs_values{ lhs.packed_.get() };
+		const TOML_ANON_NAMESPACE::packed_values_reader rhs_values{ rhs.packed_.get() };
+		if (lhs_values && rhs_values)
+			return TOML_ANON_NAMESPACE::packed_values_equal(*lhs_values, *rhs_values);
+		if (lhs_values)
+			return TOML_ANON_NAMESPACE::packed_values_equal(*lhs_values, rhs.elem_nodes());
+		if (rhs_values)
+			return TOML_ANON_NAMESPACE::packed_values_equal(*rhs_values, lhs.elem_nodes());
+		const auto& lhs_nodes = lhs.elem_nodes();
+		const auto& rhs_nodes = rhs.elem_nodes();
+		for (size_t i = 0, e = lhs_nodes.size(); i < e; i++)
+		{
+			const auto lhs_type = lhs_nodes[i]->type();
+			const node& rhs_	= *rhs_nodes[i];
 			const auto rhs_type = rhs_.type();
 			if (lhs_type != rhs_type)
 				return false;
 
-			const bool equal = lhs.elems_[i]->visit(
+			const bool equal = lhs_nodes[i]->visit(
 				[&](const auto& lhs_) noexcept
 				{ return lhs_ == *reinterpret_cast<std::remove_reference_t<decltype(lhs_)>*>(&rhs_); });
 			if (!equal)
@@ -12110,7 +14645,8 @@ TOML_PUSH_WARNINGS;
 TOML_NAMESPACE_START
 {
 	TOML_EXTERNAL_LINKAGE
-	table::table() noexcept
+	table::table() noexcept //
+		: node(node_type::table)
 	{
 #if TOML_LIFETIME_HOOKS
 		TOML_TABLE_CREATED;
@@ -12126,7 +14662,8 @@ TOML_NAMESPACE_START
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	table::table(const impl::table_init_pair* b, const impl::table_init_pair* e)
+	table::table(const impl::table_init_pair* b, const impl::table_init_pair* e) //
+		: node(node_type::table)
 	{
 #if TOML_LIFETIME_HOOKS
 		TOML_TABLE_CREATED;
@@ -12154,7 +14691,7 @@ TOML_NAMESPACE_START
 		  inline_{ other.inline_ }
 	{
 		for (auto&& [k, v] : other.map_)
-			map_.emplace_hint(map_.end(), k, impl::make_node(*v));
+			map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
 
 #if TOML_LIFETIME_HOOKS
 		TOML_TABLE_CREATED;
@@ -12164,6 +14701,7 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	table::table(table && other) noexcept //
 		: node(std::move(other)),
+		  arena_{ std::move(other.arena_) },
 		  map_{ std::move(other.map_) },
 		  inline_{ other.inline_ }
 	{
@@ -12172,6 +14710,57 @@ TOML_NAMESPACE_START
 #endif
 	}
 
+#if TOML_ENABLE_PMR
+
+	TOML_EXTERNAL_LINKAGE
+	table::table(const allocator_type& alloc) noexcept //
+		: node(node_type::table),
+		  map_{ alloc }
+	{
+#if TOML_LIFETIME_HOOKS
+		TOML_TABLE_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	table::table(const table& other, const allocator_type& alloc) //
+		: node(other),
+		  map_{ alloc },
+		  inline_{ other.inline_ }
+	{
+		for (auto&& [k, v] : other.map_)
+			map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
+
+#if TOML_LIFETIME_HOOKS
+		TOML_TABLE_CREATED;
+#endif
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	table::table(table && other, const allocator_type& alloc) //
+		: node(std::move(other)),
+		  map_{ alloc },
+		  inline_{ other.inline_ }
+	{
+		if (other.map_.get_allocator() == map_.get_allocator())
+		{
+			arena_ = std::move(other.arena_);
+			map_   = std::move(other.map_);
+		}
+		else
+		{
+			for (auto&& [k, v] : other.map_)
+				map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
+			other.clear();
+		}
+
+#if TOML_LIFETIME_HOOKS
+		TOML_TABLE_CREATED;
+#endif
+	}
+
+#endif // TOML_ENABLE_PMR
+
 	TOML_EXTERNAL_LINKAGE
 	table& table::operator=(const table& rhs)
 	{
@@ -12180,20 +14769,32 @@ TOML_NAMESPACE_START
 			node::operator=(rhs);
 			map_.clear();
 			for (auto&& [k, v] : rhs.map_)
-				map_.emplace_hint(map_.end(), k, impl::make_node(*v));
+				map_.emplace_hint(map_.end(), k, impl::make_node(*v, preserve_source_value_flags, node_resource()));
 			inline_ = rhs.inline_;
+			arena_.reset(); // (after map_, since the old nodes may have been in it)
 		}
 		return *this;
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	table& table::operator=(table&& rhs) noexcept
+	table& table::operator=(table&& rhs) noexcept(!TOML_ENABLE_PMR)
 	{
 		if (&rhs != this)
 		{
+#if TOML_ENABLE_PMR
+			// the table keeps its own allocator, so entries from a different memory resource get copied
+			if (rhs.map_.get_allocator() != map_.get_allocator())
+				return *this = table{ std::move(rhs), get_allocator() };
+#endif
+
+			// rhs might be one of the nodes about to be released, so everything's taken from it first
+			auto arena = std::move(rhs.arena_);
+			auto map   = std::move(rhs.map_);
 			node::operator=(std::move(rhs));
-			map_	= std::move(rhs.map_);
 			inline_ = rhs.inline_;
+
+			map_   = std::move(map);
+			arena_ = std::move(arena); // after map_, since the old nodes may have been in the old arena
 		}
 		return *this;
 	}
@@ -12368,6 +14969,7 @@ TOML_NAMESPACE_START
 	void table::clear() noexcept
 	{
 		map_.clear();
+		arena_.reset();
 	}
 
 	TOML_EXTERNAL_LINKAGE
@@ -12429,6 +15031,18 @@ TOML_POP_WARNINGS;
 #define TOML_HAS_SSE4_1 1
 #endif
 
+#if defined(__AVX2__)
+#define TOML_HAS_AVX2 1
+#endif
+
+// x86 compilers that can emit code for instruction sets beyond the ones enabled on the command line,
+// so kernels for newer instruction sets can be compiled in and selected at runtime based on what the CPU supports.
+// (clang-cl is excluded because its intrinsics headers only declare what's enabled on the command line)
+#if (TOML_ARCH_X86 || TOML_ARCH_AMD64) && !TOML_ICC                                                                  \
+	&& ((TOML_GCC_LIKE && !TOML_MSVC_LIKE) || (TOML_MSVC && !TOML_CLANG))
+#define TOML_SIMD_DISPATCH 1
+#endif
+
 #endif // TOML_ENABLE_SIMD
 
 #ifndef TOML_HAS_SSE2
@@ -12437,18 +15051,41 @@ TOML_POP_WARNINGS;
 #ifndef TOML_HAS_SSE4_1
 #define TOML_HAS_SSE4_1 0
 #endif
+#ifndef TOML_HAS_AVX2
+#define TOML_HAS_AVX2 0
+#endif
+#ifndef TOML_SIMD_DISPATCH
+#define TOML_SIMD_DISPATCH 0
+#endif
+
+// which kernels get compiled in
+#define TOML_SSE2_KERNELS	(TOML_HAS_SSE2 || TOML_SIMD_DISPATCH)
+#define TOML_SSE4_1_KERNELS (TOML_HAS_SSE4_1 || TOML_SIMD_DISPATCH)
+#define TOML_AVX2_KERNELS	(TOML_HAS_AVX2 || TOML_SIMD_DISPATCH)
+
+// function attributes for kernels that use instruction sets beyond the ones enabled on the command line
+#if TOML_SIMD_DISPATCH && TOML_GCC_LIKE
+#define TOML_SSE2_TARGET   __attribute__((__target__("sse2")))
+#define TOML_SSE4_1_TARGET __attribute__((__target__("sse4.1")))
+#define TOML_AVX2_TARGET   __attribute__((__target__("avx2")))
+#else
+#define TOML_SSE2_TARGET
+#define TOML_SSE4_1_TARGET
+#define TOML_AVX2_TARGET
+#endif
 
 TOML_DISABLE_WARNINGS;
-#if TOML_HAS_SSE4_1
+#if TOML_SIMD_DISPATCH || TOML_HAS_AVX2
+#include <immintrin.h>
+#elif TOML_HAS_SSE4_1
 #include <smmintrin.h>
-#endif
-#if TOML_HAS_SSE2
+#elif TOML_HAS_SSE2
 #include <emmintrin.h>
 #endif
+#if TOML_MSVC_LIKE
+#include <intrin.h>
+#endif
 TOML_ENABLE_WARNINGS;
-
-//********  impl/unicode.inl  ******************************************************************************************
-
 TOML_PUSH_WARNINGS;
 #ifdef _MSC_VER
 #ifndef __clang__
@@ -12462,42 +15099,27 @@ TOML_PUSH_WARNINGS;
 
 TOML_IMPL_NAMESPACE_START
 {
-	TOML_PURE_GETTER
-	TOML_EXTERNAL_LINKAGE
-	bool is_ascii(const char* str, size_t len) noexcept
+	// index of the lowest set bit in a (non-zero) SIMD comparison mask
+	TOML_CONST_INLINE_GETTER
+	unsigned countr_zero(uint32_t mask) noexcept
 	{
-		const char* const end = str + len;
-
-#if TOML_HAS_SSE2 && (128 % CHAR_BIT) == 0
-		{
-			constexpr size_t chars_per_vector = 128u / CHAR_BIT;
-
-			if (const size_t simdable = len - (len % chars_per_vector))
-			{
-				__m128i mask = _mm_setzero_si128();
-				for (const char* const e = str + simdable; str < e; str += chars_per_vector)
-				{
-					const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
-					mask						= _mm_or_si128(mask, current_bytes);
-				}
-				const __m128i has_error = _mm_cmpgt_epi8(_mm_setzero_si128(), mask);
+		TOML_ASSERT_ASSUME(mask);
 
-#if TOML_HAS_SSE4_1
-				if (!_mm_testz_si128(has_error, has_error))
-					return false;
+#if TOML_GCC_LIKE || TOML_CLANG
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#elif TOML_MSVC_LIKE
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<unsigned>(index);
 #else
-				if (_mm_movemask_epi8(_mm_cmpeq_epi8(has_error, _mm_setzero_si128())) != 0xFFFF)
-					return false;
-#endif
-			}
+		unsigned index = 0;
+		while (!(mask & 1u))
+		{
+			mask >>= 1;
+			index++;
 		}
+		return index;
 #endif
-
-		for (; str < end; str++)
-			if (static_cast<unsigned char>(*str) > 127u)
-				return false;
-
-		return true;
 	}
 }
 TOML_IMPL_NAMESPACE_END;
@@ -12511,23 +15133,8 @@ TOML_IMPL_NAMESPACE_END;
 #endif
 TOML_POP_WARNINGS;
 
-//********  impl/parser.inl  *******************************************************************************************
-
-#if TOML_ENABLE_PARSER
+//********  impl/unicode.inl  ******************************************************************************************
 
-TOML_DISABLE_WARNINGS;
-#include <istream>
-#include <fstream>
-#if TOML_INT_CHARCONV || TOML_FLOAT_CHARCONV
-#include <charconv>
-#endif
-#if !TOML_INT_CHARCONV || !TOML_FLOAT_CHARCONV
-#include <sstream>
-#endif
-#if !TOML_INT_CHARCONV
-#include <iomanip>
-#endif
-TOML_ENABLE_WARNINGS;
 TOML_PUSH_WARNINGS;
 #ifdef _MSC_VER
 #ifndef __clang__
@@ -12541,619 +15148,3746 @@ TOML_PUSH_WARNINGS;
 
 TOML_ANON_NAMESPACE_START
 {
-	template <typename T>
-	class utf8_byte_stream;
+	// scalar
 
+	TOML_PURE_GETTER
 	TOML_INTERNAL_LINKAGE
-	constexpr auto utf8_byte_order_mark = "\xEF\xBB\xBF"sv;
+	bool is_ascii_scalar(const char* str, size_t len) noexcept
+	{
+		for (const char* const end = str + len; str < end; str++)
+			if (static_cast<unsigned char>(*str) > 127u)
+				return false;
 
-	template <typename Char>
-	class utf8_byte_stream<std::basic_string_view<Char>>
+		return true;
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t ascii_prefix_length_scalar(const char* str, size_t len) noexcept
 	{
-		static_assert(sizeof(Char) == 1);
+		const char* const begin = str;
+		for (const char* const end = str + len; str < end; str++)
+			if (static_cast<unsigned char>(*str) > 127u)
+				break;
 
-	  private:
-		std::basic_string_view<Char> source_;
-		size_t position_ = {};
+		return static_cast<size_t>(str - begin);
+	}
 
-	  public:
-		TOML_NODISCARD_CTOR
-		explicit constexpr utf8_byte_stream(std::basic_string_view<Char> sv) noexcept //
-			: source_{ sv }
-		{
-			// skip bom
-			if (source_.length() >= 3u && memcmp(utf8_byte_order_mark.data(), source_.data(), 3u) == 0)
-				position_ += 3u;
-		}
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	bool is_valid_utf8_scalar(const char* str, size_t len) noexcept
+	{
+		const char* const end = str + len;
 
-		TOML_CONST_INLINE_GETTER
-		constexpr bool error() const noexcept
+		impl::utf8_decoder decoder;
+		while (str < end)
 		{
-			return false;
-		}
+			if (decoder.has_code_point())
+			{
+				str += ascii_prefix_length_scalar(str, static_cast<size_t>(end - str));
+				if (str == end)
+					break;
+			}
 
-		TOML_PURE_INLINE_GETTER
-		constexpr bool eof() const noexcept
-		{
-			return position_ >= source_.length();
+			decoder(*str++);
+			if (decoder.error())
+				return false;
 		}
+		return decoder.has_code_point();
+	}
 
-		TOML_PURE_INLINE_GETTER
-		explicit constexpr operator bool() const noexcept
-		{
-			return !eof();
-		}
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t horizontal_whitespace_prefix_length_scalar(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		for (const char* const end = str + len; str < end; str++)
+			if (*str != ' ' && *str != '\t')
+				break;
 
-		TOML_PURE_INLINE_GETTER
-		constexpr bool peek_eof() const noexcept
+		return static_cast<size_t>(str - begin);
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t plain_string_prefix_length_scalar(const char* str, size_t len, char special1, char special2) noexcept
+	{
+		const char* const begin = str;
+		for (const char* const end = str + len; str < end; str++)
 		{
-			return eof();
+			const auto c = static_cast<unsigned char>(*str);
+			if ((c < 32u && c != '\t') || c >= 127u || *str == special1 || *str == special2)
+				break;
 		}
 
-		TOML_NODISCARD
-		TOML_ATTR(nonnull)
-		size_t operator()(void* dest, size_t num) noexcept
-		{
-			TOML_ASSERT_ASSUME(!eof());
+		return static_cast<size_t>(str - begin);
+	}
 
-			num = impl::min(position_ + num, source_.length()) - position_;
-			std::memcpy(dest, source_.data() + position_, num);
-			position_ += num;
-			return num;
-		}
-	};
+	// SSE2
 
-	template <>
-	class utf8_byte_stream<std::istream>
+#if TOML_SSE2_KERNELS
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	bool is_ascii_sse2(const char* str, size_t len) noexcept
 	{
-	  private:
-		std::istream* source_;
+		const char* const end = str + len;
 
-	  public:
-		TOML_NODISCARD_CTOR
-		explicit utf8_byte_stream(std::istream& stream) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) //
-			: source_{ &stream }
-		{
-			if (!*this) // eof, bad
-				return;
+		__m128i mask = _mm_setzero_si128();
+		for (; end - str >= 16; str += 16)
+			mask = _mm_or_si128(mask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(str)));
+		if (_mm_movemask_epi8(mask))
+			return false;
 
-			const auto initial_pos = source_->tellg();
-			char bom[3];
-			source_->read(bom, 3);
-			if (source_->bad() || (source_->gcount() == 3 && memcmp(utf8_byte_order_mark.data(), bom, 3u) == 0))
-				return;
+		return is_ascii_scalar(str, static_cast<size_t>(end - str));
+	}
 
-			source_->clear();
-			source_->seekg(initial_pos, std::istream::beg);
-		}
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	size_t ascii_prefix_length_sse2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
 
-		TOML_PURE_INLINE_GETTER
-		bool error() const noexcept
+		for (; end - str >= 16; str += 16)
 		{
-			return !!(source_->rdstate() & std::istream::badbit);
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			if (const auto high_bits = static_cast<uint32_t>(_mm_movemask_epi8(current_bytes)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(high_bits);
 		}
 
-		TOML_PURE_INLINE_GETTER
-		bool eof() const noexcept
-		{
-			return !!(source_->rdstate() & std::istream::eofbit);
-		}
+		return static_cast<size_t>(str - begin) + ascii_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
 
-		TOML_PURE_INLINE_GETTER
-		explicit operator bool() const noexcept
-		{
-			return !(source_->rdstate() & (std::istream::badbit | std::istream::eofbit));
-		}
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	size_t horizontal_whitespace_prefix_length_sse2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
 
-		TOML_NODISCARD
-		bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
-		{
-			return eof() || source_->peek() == std::istream::traits_type::eof();
-		}
+		const __m128i spaces = _mm_set1_epi8(' ');
+		const __m128i tabs	 = _mm_set1_epi8('\t');
 
-		TOML_NODISCARD
-		TOML_ATTR(nonnull)
-		size_t operator()(void* dest, size_t num) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		for (; end - str >= 16; str += 16)
 		{
-			TOML_ASSERT(*this);
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			const __m128i whitespace =
+				_mm_or_si128(_mm_cmpeq_epi8(current_bytes, spaces), _mm_cmpeq_epi8(current_bytes, tabs));
 
-			source_->read(static_cast<char*>(dest), static_cast<std::streamsize>(num));
-			return static_cast<size_t>(source_->gcount());
+			if (const auto other_bits = static_cast<uint32_t>(~_mm_movemask_epi8(whitespace)) & 0xFFFFu)
+				return static_cast<size_t>(str - begin) + impl::countr_zero(other_bits);
 		}
-	};
 
-	struct utf8_codepoint
+		return static_cast<size_t>(str - begin)
+			 + horizontal_whitespace_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE2_TARGET
+	size_t plain_string_prefix_length_sse2(const char* str, size_t len, char special1, char special2) noexcept
 	{
-		char32_t value;
-		char bytes[4];
-		size_t count;
-		source_position position;
+		const char* const begin = str;
+		const char* const end	= str + len;
 
-		TOML_PURE_INLINE_GETTER
-		constexpr operator const char32_t&() const noexcept
-		{
-			return value;
-		}
+		const __m128i specials1 = _mm_set1_epi8(special1);
+		const __m128i specials2 = _mm_set1_epi8(special2);
+		const __m128i spaces	= _mm_set1_epi8(' ');
+		const __m128i tabs		= _mm_set1_epi8('\t');
+		const __m128i deletes	= _mm_set1_epi8('\x7F');
 
-		TOML_PURE_INLINE_GETTER
-		constexpr const char32_t& operator*() const noexcept
+		for (; end - str >= 16; str += 16)
 		{
-			return value;
-		}
-	};
-	static_assert(std::is_trivial_v<utf8_codepoint>);
-	static_assert(std::is_standard_layout_v<utf8_codepoint>);
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
 
-	struct TOML_ABSTRACT_INTERFACE utf8_reader_interface
-	{
-		TOML_NODISCARD
-		virtual const source_path_ptr& source_path() const noexcept = 0;
+			// (signed comparison, so this catches control characters and non-ASCII bytes in one go)
+			__m128i special =
+				_mm_andnot_si128(_mm_cmpeq_epi8(current_bytes, tabs), _mm_cmplt_epi8(current_bytes, spaces));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, deletes));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, specials1));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, specials2));
 
-		TOML_NODISCARD
-		virtual const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) = 0;
+			if (const auto special_bits = static_cast<uint32_t>(_mm_movemask_epi8(special)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(special_bits);
+		}
 
-		TOML_NODISCARD
-		virtual bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) = 0;
+		return static_cast<size_t>(str - begin)
+			 + plain_string_prefix_length_scalar(str, static_cast<size_t>(end - str), special1, special2);
+	}
 
-#if !TOML_EXCEPTIONS
+#endif // TOML_SSE2_KERNELS
+
+#if TOML_SSE4_1_KERNELS || TOML_AVX2_KERNELS
+
+	// lookup tables for "Validating UTF-8 In Less Than One Instruction Per Byte" (John Keiser, Daniel Lemire)
+	// https://arxiv.org/abs/2010.03090
+	struct utf8_validation_tables
+	{
+		static constexpr uint8_t too_short		= 1u << 0;
+		static constexpr uint8_t too_long		= 1u << 1;
+		static constexpr uint8_t overlong_3		= 1u << 2;
+		static constexpr uint8_t too_large		= 1u << 3;
+		static constexpr uint8_t surrogate		= 1u << 4;
+		static constexpr uint8_t overlong_2		= 1u << 5;
+		static constexpr uint8_t too_large_1000 = 1u << 6;
+		static constexpr uint8_t overlong_4		= 1u << 6;
+		static constexpr uint8_t two_conts		= 1u << 7;
+		static constexpr uint8_t carry			= too_short | too_long | two_conts;
+
+		// indexed by the high nibble of the first byte of each pair
+		static constexpr uint8_t byte_1_high[16] = {
+			// 0_______ (ASCII)
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			too_long,
+			// 10______ (continuation)
+			two_conts,
+			two_conts,
+			two_conts,
+			two_conts,
+			// 1100____ (two byte lead)
+			too_short | overlong_2,
+			// 1101____ (two byte lead)
+			too_short,
+			// 1110____ (three byte lead)
+			too_short | overlong_3 | surrogate,
+			// 1111____ (four+ byte lead)
+			too_short | too_large | too_large_1000 | overlong_4
+		};
 
-		TOML_NODISCARD
-		virtual optional<parse_error>&& error() noexcept = 0;
+		// indexed by the low nibble of the first byte of each pair
+		static constexpr uint8_t byte_1_low[16] = {
+			carry | overlong_3 | overlong_2 | overlong_4, // ____0000
+			carry | overlong_2,							  // ____0001
+			carry,										  // ____001_
+			carry,										  //
+			carry | too_large,							  // ____0100
+			carry | too_large | too_large_1000,			  // ____0101
+			carry | too_large | too_large_1000,			  // ____011_
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  // ____1___
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000 | surrogate, // ____1101
+			carry | too_large | too_large_1000,			  //
+			carry | too_large | too_large_1000			  //
+		};
 
-#endif
+		// indexed by the high nibble of the second byte of each pair
+		static constexpr uint8_t byte_2_high[16] = {
+			// 0_______ (ASCII)
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			too_short,
+			// 1000____
+			too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+			// 1001____
+			too_long | overlong_2 | two_conts | overlong_3 | too_large,
+			// 101_____
+			too_long | overlong_2 | two_conts | surrogate | too_large,
+			too_long | overlong_2 | two_conts | surrogate | too_large,
+			// 11______
+			too_short,
+			too_short,
+			too_short,
+			too_short
+		};
 
-		virtual ~utf8_reader_interface() noexcept = default;
+		// the last 1, 2 or 3 bytes of a block can't be leads of 2, 3 or 4 byte sequences
+		// (SSE uses the last 16 bytes)
+		static constexpr uint8_t incomplete_limits[32] = {
+			0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+			0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+			0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xF0u - 1u, 0xE0u - 1u, 0xC0u - 1u
+		};
 	};
 
-#if TOML_EXCEPTIONS
-#define utf8_reader_error(...)				throw parse_error(__VA_ARGS__)
-#define utf8_reader_return_after_error(...) static_assert(true)
-#define utf8_reader_error_check(...)		static_assert(true)
-#else
-#define utf8_reader_error(...)				err_.emplace(__VA_ARGS__)
-#define utf8_reader_return_after_error(...) return __VA_ARGS__
-#define utf8_reader_error_check(...)                                                                                   \
-	do                                                                                                                 \
-	{                                                                                                                  \
-		if TOML_UNLIKELY(err_)                                                                                         \
-			return __VA_ARGS__;                                                                                        \
-	}                                                                                                                  \
-	while (false)
-
 #endif
 
-#if defined(__APPLE__) || defined(__MINGW32__) || defined(__MINGW64__)
-#define TOML_OVERALIGNED
-#else
-#define TOML_OVERALIGNED alignas(32)
-#endif
+	// SSE4.1
 
-	template <typename T>
-	class TOML_EMPTY_BASES utf8_reader final : public utf8_reader_interface
-	{
-	  private:
-		static constexpr size_t block_capacity = 32;
-		utf8_byte_stream<T> stream_;
-		source_position next_pos_ = { 1, 1 };
+#if TOML_SSE4_1_KERNELS
 
-		impl::utf8_decoder decoder_;
-		struct currently_decoding_t
-		{
-			char bytes[4];
-			size_t count;
-		} currently_decoding_;
-
-		struct codepoints_t
-		{
-			TOML_OVERALIGNED utf8_codepoint buffer[block_capacity];
-			size_t current;
-			size_t count;
-		} codepoints_;
-
-		source_path_ptr source_path_;
-
-#if !TOML_EXCEPTIONS
-		optional<parse_error> err_;
-#endif
-
-		bool read_next_block() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
-		{
-			TOML_ASSERT(stream_);
-
-			TOML_OVERALIGNED char raw_bytes[block_capacity];
-			size_t raw_bytes_read;
-
-			// read the next raw (encoded) block in from the stream
-			if constexpr (noexcept(stream_(raw_bytes, block_capacity)) || !TOML_EXCEPTIONS)
-			{
-				raw_bytes_read = stream_(raw_bytes, block_capacity);
-			}
-#if TOML_EXCEPTIONS
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_SSE4_1_TARGET
+	bool is_valid_utf8_sse4_1(const char* str, size_t len) noexcept
+	{
+		using tables			 = utf8_validation_tables;
+		const char* const end	 = str + len;
+		const auto load_table	 = [](const uint8_t* table) noexcept
+		{ return reinterpret_cast<const __m128i*>(table); };
+
+		const __m128i byte_1_high_table = _mm_loadu_si128(load_table(tables::byte_1_high));
+		const __m128i byte_1_low_table	= _mm_loadu_si128(load_table(tables::byte_1_low));
+		const __m128i byte_2_high_table = _mm_loadu_si128(load_table(tables::byte_2_high));
+		const __m128i incomplete_limits = _mm_loadu_si128(load_table(tables::incomplete_limits + 16));
+		const __m128i low_nibbles		= _mm_set1_epi8(0x0F);
+
+		__m128i errors			= _mm_setzero_si128();
+		__m128i prev_input		= _mm_setzero_si128();
+		__m128i prev_incomplete = _mm_setzero_si128();
+
+		char tail[16] = {};
+		while (str < end)
+		{
+			// pad the tail out with zeros (ASCII) so the last block can be checked the same way
+			const char* block = str;
+			if (end - str >= 16)
+				str += 16;
 			else
 			{
-				try
-				{
-					raw_bytes_read = stream_(raw_bytes, block_capacity);
-				}
-				catch (const std::exception& exc)
-				{
-					throw parse_error{ exc.what(), next_pos_, source_path_ };
-				}
-				catch (...)
-				{
-					throw parse_error{ "An unspecified error occurred", next_pos_, source_path_ };
-				}
+				std::memcpy(tail, str, static_cast<size_t>(end - str));
+				block = tail;
+				str	  = end;
 			}
-#endif // TOML_EXCEPTIONS
 
-			// handle a zero-byte read
-			if TOML_UNLIKELY(!raw_bytes_read)
+			const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+
+			// pure ASCII; only an error if the previous block ended mid-sequence
+			if (!_mm_movemask_epi8(input))
 			{
-				if (stream_.eof())
-				{
-					// EOF only sets the error state if the decoder wants more input, otherwise
-					// a zero-byte read might have just caused the underlying stream to realize it's exhaused and set
-					// the EOF flag, and that's totally fine
-					if (decoder_.needs_more_input())
-						utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
-										  next_pos_,
-										  source_path_);
-				}
-				else
-				{
-					utf8_reader_error("Reading from the underlying stream failed - zero bytes read",
-									  next_pos_,
-									  source_path_);
-				}
-				return false;
+				errors	   = _mm_or_si128(errors, prev_incomplete);
+				prev_input = input;
+				continue;
 			}
 
-			TOML_ASSERT_ASSUME(raw_bytes_read);
-			std::memset(&codepoints_, 0, sizeof(codepoints_));
+			const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+			const __m128i byte_1_high =
+				_mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibbles));
+			const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, low_nibbles));
+			const __m128i byte_2_high =
+				_mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibbles));
+			const __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
 
-			// helper for calculating decoded codepoint line+cols
-			const auto calc_positions = [&]() noexcept
-			{
-				for (size_t i = 0; i < codepoints_.count; i++)
-				{
-					auto& cp	= codepoints_.buffer[i];
-					cp.position = next_pos_;
+			const __m128i prev2			 = _mm_alignr_epi8(input, prev_input, 14);
+			const __m128i prev3			 = _mm_alignr_epi8(input, prev_input, 13);
+			const __m128i is_third_byte	 = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0u - 0x80u)));
+			const __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0u - 0x80u)));
+			const __m128i must_be_2_3_continuation =
+				_mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80u)));
 
-					if (cp == U'\n')
-					{
-						next_pos_.line++;
-						next_pos_.column = source_index{ 1 };
-					}
-					else
-						next_pos_.column++;
-				}
-			};
+			errors			= _mm_or_si128(errors, _mm_xor_si128(must_be_2_3_continuation, special_cases));
+			prev_incomplete = _mm_subs_epu8(input, incomplete_limits);
+			prev_input		= input;
+		}
+		errors = _mm_or_si128(errors, prev_incomplete);
 
-			// decide whether we need to use the UTF-8 decoder or if we can treat this block as plain ASCII
-			const auto ascii_fast_path = !decoder_.needs_more_input() && impl::is_ascii(raw_bytes, raw_bytes_read);
+		return _mm_testz_si128(errors, errors);
+	}
 
-			// ASCII fast-path
-			if (ascii_fast_path)
-			{
-				decoder_.reset();
-				currently_decoding_.count = {};
+#endif // TOML_SSE4_1_KERNELS
 
-				codepoints_.count = raw_bytes_read;
-				for (size_t i = 0; i < codepoints_.count; i++)
-				{
-					auto& cp	= codepoints_.buffer[i];
-					cp.value	= static_cast<char32_t>(raw_bytes[i]);
-					cp.bytes[0] = raw_bytes[i];
-					cp.count	= 1u;
-				}
-			}
+	// AVX2
 
-			// UTF-8 slow-path
-			else
-			{
-				// helper for getting precise error location
-				const auto error_pos = [&]() noexcept -> const source_position&
-				{ //
-					return codepoints_.count ? codepoints_.buffer[codepoints_.count - 1u].position : next_pos_;
-				};
+#if TOML_AVX2_KERNELS
 
-				for (size_t i = 0; i < raw_bytes_read; i++)
-				{
-					decoder_(static_cast<uint8_t>(raw_bytes[i]));
-					if TOML_UNLIKELY(decoder_.error())
-					{
-						calc_positions();
-						utf8_reader_error("Encountered invalid utf-8 sequence", error_pos(), source_path_);
-						utf8_reader_return_after_error(false);
-					}
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	bool is_ascii_avx2(const char* str, size_t len) noexcept
+	{
+		const char* const end = str + len;
 
-					currently_decoding_.bytes[currently_decoding_.count++] = raw_bytes[i];
+		__m256i mask = _mm256_setzero_si256();
+		for (; end - str >= 32; str += 32)
+			mask = _mm256_or_si256(mask, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str)));
+		if (_mm256_movemask_epi8(mask))
+			return false;
 
-					if (decoder_.has_code_point())
-					{
-						auto& cp = codepoints_.buffer[codepoints_.count++];
+		return is_ascii_scalar(str, static_cast<size_t>(end - str));
+	}
 
-						cp.value = decoder_.codepoint;
-						cp.count = currently_decoding_.count;
-						std::memcpy(cp.bytes, currently_decoding_.bytes, currently_decoding_.count);
-						currently_decoding_.count = {};
-					}
-					else if TOML_UNLIKELY(currently_decoding_.count == 4u)
-					{
-						calc_positions();
-						utf8_reader_error("Encountered overlong utf-8 sequence", error_pos(), source_path_);
-						utf8_reader_return_after_error(false);
-					}
-				}
-				if TOML_UNLIKELY(decoder_.needs_more_input() && stream_.eof())
-				{
-					calc_positions();
-					utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
-									  error_pos(),
-									  source_path_);
-					utf8_reader_return_after_error(false);
-				}
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	size_t ascii_prefix_length_avx2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
+
+		for (; end - str >= 32; str += 32)
+		{
+			const __m256i current_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+			if (const auto high_bits = static_cast<uint32_t>(_mm256_movemask_epi8(current_bytes)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(high_bits);
+		}
+
+		// short runs are common enough that it's worth finishing with a half-width step
+		if (end - str >= 16)
+		{
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			if (const auto high_bits = static_cast<uint32_t>(_mm_movemask_epi8(current_bytes)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(high_bits);
+			str += 16;
+		}
+
+		return static_cast<size_t>(str - begin) + ascii_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	bool is_valid_utf8_avx2(const char* str, size_t len) noexcept
+	{
+		using tables			 = utf8_validation_tables;
+		const char* const end	 = str + len;
+		const auto load_table	 = [](const uint8_t* table) noexcept
+		{ return reinterpret_cast<const __m128i*>(table); };
+
+		// (the shuffles work within each 128-bit lane, so the 16-byte tables are just repeated)
+		const __m256i byte_1_high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(load_table(tables::byte_1_high)));
+		const __m256i byte_1_low_table	= _mm256_broadcastsi128_si256(_mm_loadu_si128(load_table(tables::byte_1_low)));
+		const __m256i byte_2_high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(load_table(tables::byte_2_high)));
+		const __m256i incomplete_limits =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables::incomplete_limits));
+		const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+
+		__m256i errors			= _mm256_setzero_si256();
+		__m256i prev_input		= _mm256_setzero_si256();
+		__m256i prev_incomplete = _mm256_setzero_si256();
+
+		char tail[32] = {};
+		while (str < end)
+		{
+			// pad the tail out with zeros (ASCII) so the last block can be checked the same way
+			const char* block = str;
+			if (end - str >= 32)
+				str += 32;
+			else
+			{
+				std::memcpy(tail, str, static_cast<size_t>(end - str));
+				block = tail;
+				str	  = end;
 			}
 
-			TOML_ASSERT_ASSUME(codepoints_.count);
-			calc_positions();
+			const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
 
-			// handle general I/O errors
-			// (down here so the next_pos_ benefits from calc_positions())
-			if TOML_UNLIKELY(stream_.error())
+			// pure ASCII; only an error if the previous block ended mid-sequence
+			if (!_mm256_movemask_epi8(input))
 			{
-				utf8_reader_error("An I/O error occurred while reading from the underlying stream",
-								  next_pos_,
-								  source_path_);
-				utf8_reader_return_after_error(false);
+				errors	   = _mm256_or_si256(errors, prev_incomplete);
+				prev_input = input;
+				continue;
 			}
 
-			return true;
-		}
+			// (alignr works within each 128-bit lane, so the lanes need stitching together first)
+			const __m256i prev_straddle = _mm256_permute2x128_si256(prev_input, input, 0x21);
+
+			const __m256i prev1 = _mm256_alignr_epi8(input, prev_straddle, 15);
+			const __m256i byte_1_high =
+				_mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibbles));
+			const __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibbles));
+			const __m256i byte_2_high =
+				_mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibbles));
+			const __m256i special_cases =
+				_mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+			const __m256i prev2 = _mm256_alignr_epi8(input, prev_straddle, 14);
+			const __m256i prev3 = _mm256_alignr_epi8(input, prev_straddle, 13);
+			const __m256i is_third_byte =
+				_mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0u - 0x80u)));
+			const __m256i is_fourth_byte =
+				_mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0u - 0x80u)));
+			const __m256i must_be_2_3_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+																	  _mm256_set1_epi8(static_cast<char>(0x80u)));
+
+			errors = _mm256_or_si256(errors, _mm256_xor_si256(must_be_2_3_continuation, special_cases));
+			prev_incomplete = _mm256_subs_epu8(input, incomplete_limits);
+			prev_input		= input;
+		}
+		errors = _mm256_or_si256(errors, prev_incomplete);
+
+		return _mm256_testz_si256(errors, errors);
+	}
 
-	  public:
-		template <typename U, typename String = std::string_view>
-		TOML_NODISCARD_CTOR
-		explicit utf8_reader(U&& source, String&& source_path = {}) noexcept(
-			std::is_nothrow_constructible_v<utf8_byte_stream<T>, U&&>)
-			: stream_{ static_cast<U&&>(source) }
-		{
-			currently_decoding_.count = {};
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	size_t horizontal_whitespace_prefix_length_avx2(const char* str, size_t len) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
 
-			codepoints_.current = {};
-			codepoints_.count	= {};
+		const __m256i spaces = _mm256_set1_epi8(' ');
+		const __m256i tabs	 = _mm256_set1_epi8('\t');
 
-			if (!source_path.empty())
-				source_path_ = std::make_shared<const std::string>(static_cast<String&&>(source_path));
+		for (; end - str >= 32; str += 32)
+		{
+			const __m256i current_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+			const __m256i whitespace =
+				_mm256_or_si256(_mm256_cmpeq_epi8(current_bytes, spaces), _mm256_cmpeq_epi8(current_bytes, tabs));
+
+			if (const auto other_bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(whitespace)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(other_bits);
 		}
 
-		TOML_PURE_INLINE_GETTER
-		const source_path_ptr& source_path() const noexcept final
+		if (end - str >= 16)
 		{
-			return source_path_;
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+			const __m128i whitespace	= _mm_or_si128(_mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(spaces)),
+													   _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(tabs)));
+
+			if (const auto other_bits = static_cast<uint32_t>(~_mm_movemask_epi8(whitespace)) & 0xFFFFu)
+				return static_cast<size_t>(str - begin) + impl::countr_zero(other_bits);
+			str += 16;
 		}
 
-		TOML_NODISCARD
-		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) final
-		{
-			utf8_reader_error_check({});
+		return static_cast<size_t>(str - begin)
+			 + horizontal_whitespace_prefix_length_scalar(str, static_cast<size_t>(end - str));
+	}
 
-			if (codepoints_.current == codepoints_.count)
-			{
-				if TOML_UNLIKELY(!stream_ || !read_next_block())
-					return nullptr;
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	TOML_AVX2_TARGET
+	size_t plain_string_prefix_length_avx2(const char* str, size_t len, char special1, char special2) noexcept
+	{
+		const char* const begin = str;
+		const char* const end	= str + len;
 
-				TOML_ASSERT_ASSUME(!codepoints_.current);
-			}
-			TOML_ASSERT_ASSUME(codepoints_.count);
-			TOML_ASSERT_ASSUME(codepoints_.count <= block_capacity);
-			TOML_ASSERT_ASSUME(codepoints_.current < codepoints_.count);
+		const __m256i specials1 = _mm256_set1_epi8(special1);
+		const __m256i specials2 = _mm256_set1_epi8(special2);
+		const __m256i spaces	= _mm256_set1_epi8(' ');
+		const __m256i tabs		= _mm256_set1_epi8('\t');
+		const __m256i deletes	= _mm256_set1_epi8('\x7F');
 
-			return &codepoints_.buffer[codepoints_.current++];
+		for (; end - str >= 32; str += 32)
+		{
+			const __m256i current_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+
+			// (signed comparison, so this catches control characters and non-ASCII bytes in one go)
+			__m256i special = _mm256_andnot_si256(_mm256_cmpeq_epi8(current_bytes, tabs),
+												  _mm256_cmpgt_epi8(spaces, current_bytes));
+			special			= _mm256_or_si256(special, _mm256_cmpeq_epi8(current_bytes, deletes));
+			special			= _mm256_or_si256(special, _mm256_cmpeq_epi8(current_bytes, specials1));
+			special			= _mm256_or_si256(special, _mm256_cmpeq_epi8(current_bytes, specials2));
+
+			if (const auto special_bits = static_cast<uint32_t>(_mm256_movemask_epi8(special)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(special_bits);
 		}
 
-		TOML_NODISCARD
-		bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS) final
+		if (end - str >= 16)
 		{
-			return stream_.peek_eof();
-		}
+			const __m128i current_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
 
-#if !TOML_EXCEPTIONS
+			__m128i special = _mm_andnot_si128(_mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(tabs)),
+											   _mm_cmplt_epi8(current_bytes, _mm256_castsi256_si128(spaces)));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(deletes)));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(specials1)));
+			special = _mm_or_si128(special, _mm_cmpeq_epi8(current_bytes, _mm256_castsi256_si128(specials2)));
 
-		TOML_NODISCARD
-		optional<parse_error>&& error() noexcept final
-		{
-			return std::move(err_);
+			if (const auto special_bits = static_cast<uint32_t>(_mm_movemask_epi8(special)))
+				return static_cast<size_t>(str - begin) + impl::countr_zero(special_bits);
+			str += 16;
 		}
 
-#endif
+		return static_cast<size_t>(str - begin)
+			 + plain_string_prefix_length_scalar(str, static_cast<size_t>(end - str), special1, special2);
+	}
+
+#endif // TOML_AVX2_KERNELS
+
+	// dispatch
+
+	struct simd_kernels
+	{
+		impl::simd_tier tier;
+		bool (*is_ascii)(const char*, size_t) noexcept;
+		size_t (*ascii_prefix_length)(const char*, size_t) noexcept;
+		bool (*is_valid_utf8)(const char*, size_t) noexcept;
+		size_t (*horizontal_whitespace_prefix_length)(const char*, size_t) noexcept;
+		size_t (*plain_string_prefix_length)(const char*, size_t, char, char) noexcept;
 	};
 
-	template <typename Char>
-	utf8_reader(std::basic_string_view<Char>, std::string_view) -> utf8_reader<std::basic_string_view<Char>>;
-	template <typename Char>
-	utf8_reader(std::basic_string_view<Char>, std::string&&) -> utf8_reader<std::basic_string_view<Char>>;
-	template <typename Char>
-	utf8_reader(std::basic_istream<Char>&, std::string_view) -> utf8_reader<std::basic_istream<Char>>;
-	template <typename Char>
-	utf8_reader(std::basic_istream<Char>&, std::string&&) -> utf8_reader<std::basic_istream<Char>>;
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	simd_kernels simd_kernels_for(impl::simd_tier tier) noexcept
+	{
+		switch (tier)
+		{
+#if TOML_AVX2_KERNELS
+			case impl::simd_tier::avx2:
+				return { impl::simd_tier::avx2,
+						 is_ascii_avx2,
+						 ascii_prefix_length_avx2,
+						 is_valid_utf8_avx2,
+						 horizontal_whitespace_prefix_length_avx2,
+						 plain_string_prefix_length_avx2 };
+#endif
+#if TOML_SSE4_1_KERNELS
+			case impl::simd_tier::sse4_1:
+				return { impl::simd_tier::sse4_1,
+						 is_ascii_sse2,
+						 ascii_prefix_length_sse2,
+						 is_valid_utf8_sse4_1,
+						 horizontal_whitespace_prefix_length_sse2,
+						 plain_string_prefix_length_sse2 };
+#endif
+#if TOML_SSE2_KERNELS
+			case impl::simd_tier::sse2:
+				return { impl::simd_tier::sse2,
+						 is_ascii_sse2,
+						 ascii_prefix_length_sse2,
+						 is_valid_utf8_scalar,
+						 horizontal_whitespace_prefix_length_sse2,
+						 plain_string_prefix_length_sse2 };
+#endif
+			default:
+				return { impl::simd_tier::scalar,
+						 is_ascii_scalar,
+						 ascii_prefix_length_scalar,
+						 is_valid_utf8_scalar,
+						 horizontal_whitespace_prefix_length_scalar,
+						 plain_string_prefix_length_scalar };
+		}
+	}
+
+	// the best tier that's both compiled in and supported by the CPU we're running on.
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	impl::simd_tier detect_simd_tier() noexcept
+	{
+#if TOML_SIMD_DISPATCH && TOML_GCC_LIKE
+
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return impl::simd_tier::avx2;
+		if (__builtin_cpu_supports("sse4.1"))
+			return impl::simd_tier::sse4_1;
+		if (__builtin_cpu_supports("sse2"))
+			return impl::simd_tier::sse2;
+		return impl::simd_tier::scalar;
+
+#elif TOML_SIMD_DISPATCH && TOML_MSVC
+
+		int info[4];
+		__cpuid(info, 0);
+		const int max_leaf = info[0];
+
+		__cpuid(info, 1);
+		const bool sse2	  = (info[3] & (1 << 26)) != 0;
+		const bool sse4_1 = (info[2] & (1 << 19)) != 0;
+
+		// AVX2 also needs the OS to be preserving the upper halves of the YMM registers (OSXSAVE + AVX + XCR0)
+		const bool ymm_enabled =
+			(info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6u) == 0x6u;
+		if (max_leaf >= 7 && ymm_enabled)
+		{
+			__cpuidex(info, 7, 0);
+			if (info[1] & (1 << 5))
+				return impl::simd_tier::avx2;
+		}
+		if (sse4_1)
+			return impl::simd_tier::sse4_1;
+		if (sse2)
+			return impl::simd_tier::sse2;
+		return impl::simd_tier::scalar;
 
-#if TOML_EXCEPTIONS
-#define utf8_buffered_reader_error_check(...) static_assert(true)
 #else
-#define utf8_buffered_reader_error_check(...)                                                                          \
-	do                                                                                                                 \
-	{                                                                                                                  \
-		if TOML_UNLIKELY(reader_.error())                                                                              \
-			return __VA_ARGS__;                                                                                        \
-	}                                                                                                                  \
-	while (false)
+
+		return TOML_HAS_AVX2	 ? impl::simd_tier::avx2
+			 : TOML_HAS_SSE4_1 ? impl::simd_tier::sse4_1
+			 : TOML_HAS_SSE2   ? impl::simd_tier::sse2
+							   : impl::simd_tier::scalar;
 
 #endif
+	}
 
-	class TOML_EMPTY_BASES utf8_buffered_reader
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	simd_kernels& active_simd_kernels() noexcept
 	{
-	  public:
-		static constexpr size_t max_history_length = 128;
+		static simd_kernels kernels = simd_kernels_for(detect_simd_tier());
+		return kernels;
+	}
+}
+TOML_ANON_NAMESPACE_END;
+
+TOML_IMPL_NAMESPACE_START
+{
+	TOML_NODISCARD
+	TOML_EXTERNAL_LINKAGE
+	simd_tier active_simd_tier() noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().tier;
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	simd_tier force_simd_tier(simd_tier tier) noexcept
+	{
+		const auto supported = TOML_ANON_NAMESPACE::detect_simd_tier();
+		if (tier > supported)
+			tier = supported;
+
+		TOML_ANON_NAMESPACE::active_simd_kernels() = TOML_ANON_NAMESPACE::simd_kernels_for(tier);
+		return tier;
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	bool is_ascii(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().is_ascii(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	size_t ascii_prefix_length(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().ascii_prefix_length(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	bool is_valid_utf8(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().is_valid_utf8(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	size_t horizontal_whitespace_prefix_length(const char* str, size_t len) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().horizontal_whitespace_prefix_length(str, len);
+	}
+
+	TOML_PURE_GETTER
+	TOML_EXTERNAL_LINKAGE
+	size_t plain_string_prefix_length(const char* str, size_t len, char special1, char special2) noexcept
+	{
+		return TOML_ANON_NAMESPACE::active_simd_kernels().plain_string_prefix_length(str, len, special1, special2);
+	}
+}
+TOML_IMPL_NAMESPACE_END;
+
+#ifdef _MSC_VER
+#pragma pop_macro("min")
+#pragma pop_macro("max")
+#ifndef __clang__
+#pragma inline_recursion(off)
+#endif
+#endif
+TOML_POP_WARNINGS;
+
+//********  impl/float_parsing.inl  ************************************************************************************
+
+#if TOML_ENABLE_PARSER
+
+TOML_DISABLE_WARNINGS;
+#include <cfloat> // FLT_EVAL_METHOD
+TOML_ENABLE_WARNINGS;
+TOML_PUSH_WARNINGS;
+#ifdef _MSC_VER
+#ifndef __clang__
+#pragma inline_recursion(on)
+#endif
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+#endif
+
+TOML_ANON_NAMESPACE_START
+{
+	// a double broken up into its (explicit) mantissa bits and biased exponent
+	struct binary_float
+	{
+		uint64_t mantissa;
+		int32_t power2;
+
+		static constexpr int mantissa_bits		= 52;
+		static constexpr int32_t infinite_power = 0x7FF;
+
+		TOML_PURE_INLINE_GETTER
+		friend bool operator==(const binary_float& lhs, const binary_float& rhs) noexcept
+		{
+			return lhs.mantissa == rhs.mantissa && lhs.power2 == rhs.power2;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		friend bool operator!=(const binary_float& lhs, const binary_float& rhs) noexcept
+		{
+			return !(lhs == rhs);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		uint64_t bits() const noexcept
+		{
+			return (static_cast<uint64_t>(power2) << mantissa_bits) | mantissa;
+		}
+
+		TOML_CONST_INLINE_GETTER
+		static binary_float from_bits(uint64_t bits) noexcept
+		{
+			return { bits & ((uint64_t{ 1 } << mantissa_bits) - 1u), static_cast<int32_t>(bits >> mantissa_bits) };
+		}
+
+		TOML_PURE_INLINE_GETTER
+		double to_double() const noexcept
+		{
+			const auto b = bits();
+			double value;
+			std::memcpy(&value, &b, sizeof(value));
+			return value;
+		}
+	};
+
+	struct uint128_parts
+	{
+		uint64_t high;
+		uint64_t low;
+	};
+
+	TOML_CONST_INLINE_GETTER
+	uint128_parts multiply_full(uint64_t a, uint64_t b) noexcept
+	{
+#ifdef TOML_UINT128
+		const auto product = static_cast<TOML_UINT128>(a) * b;
+		return { static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product) };
+#else
+		const uint64_t a_lo = a & 0xFFFFFFFFu;
+		const uint64_t a_hi = a >> 32;
+		const uint64_t b_lo = b & 0xFFFFFFFFu;
+		const uint64_t b_hi = b >> 32;
+
+		const uint64_t lo_lo = a_lo * b_lo;
+		const uint64_t hi_lo = a_hi * b_lo;
+		const uint64_t lo_hi = a_lo * b_hi;
+		const uint64_t hi_hi = a_hi * b_hi;
+
+		const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+		return { (hi_lo >> 32) + (cross >> 32) + hi_hi, (cross << 32) | (lo_lo & 0xFFFFFFFFu) };
+#endif
+	}
+
+	TOML_CONST_INLINE_GETTER
+	int leading_zeroes(uint64_t value) noexcept
+	{
+		TOML_ASSERT_ASSUME(value);
+
+#if TOML_GCC_LIKE
+		return __builtin_clzll(value);
+#else
+		int count = 0;
+		for (; !(value & (uint64_t{ 1 } << 63)); value <<= 1)
+			count++;
+		return count;
+#endif
+	}
+
+	// 128-bit approximations of the powers of five from 5^-342 to 5^308 with the most significant bit set
+	// (rounded up for the negative powers, truncated for the positive ones). generated by:
+	//
+	// for q in range(-342, 309):
+	//     if q >= 0:
+	//         c = 5 ** q
+	//     else:
+	//         z = (5 ** -q - 1).bit_length()
+	//         c = 2 ** (z + 127 if q >= -27 else 2 * z + 128) // 5 ** -q + 1
+	//     while c < (1 << 127): c *= 2
+	//     while c >= (1 << 128): c //= 2
+	struct powers_of_five
+	{
+		static constexpr int64_t smallest = -342;
+		static constexpr int64_t largest  = 308;
+
+		static constexpr uint64_t values[] = {
+			0xEEF453D6923BD65A, 0x113FAA2906A13B3F, // 5^-342
+			0x9558B4661B6565F8, 0x4AC7CA59A424C507, // 5^-341
+			0xBAAEE17FA23EBF76, 0x5D79BCF00D2DF649, // 5^-340
+			0xE95A99DF8ACE6F53, 0xF4D82C2C107973DC, // 5^-339
+			0x91D8A02BB6C10594, 0x79071B9B8A4BE869, // 5^-338
+			0xB64EC836A47146F9, 0x9748E2826CDEE284, // 5^-337
+			0xE3E27A444D8D98B7, 0xFD1B1B2308169B25, // 5^-336
+			0x8E6D8C6AB0787F72, 0xFE30F0F5E50E20F7, // 5^-335
+			0xB208EF855C969F4F, 0xBDBD2D335E51A935, // 5^-334
+			0xDE8B2B66B3BC4723, 0xAD2C788035E61382, // 5^-333
+			0x8B16FB203055AC76, 0x4C3BCB5021AFCC31, // 5^-332
+			0xADDCB9E83C6B1793, 0xDF4ABE242A1BBF3D, // 5^-331
+			0xD953E8624B85DD78, 0xD71D6DAD34A2AF0D, // 5^-330
+			0x87D4713D6F33AA6B, 0x8672648C40E5AD68, // 5^-329
+			0xA9C98D8CCB009506, 0x680EFDAF511F18C2, // 5^-328
+			0xD43BF0EFFDC0BA48, 0x0212BD1B2566DEF2, // 5^-327
+			0x84A57695FE98746D, 0x014BB630F7604B57, // 5^-326
+			0xA5CED43B7E3E9188, 0x419EA3BD35385E2D, // 5^-325
+			0xCF42894A5DCE35EA, 0x52064CAC828675B9, // 5^-324
+			0x818995CE7AA0E1B2, 0x7343EFEBD1940993, // 5^-323
+			0xA1EBFB4219491A1F, 0x1014EBE6C5F90BF8, // 5^-322
+			0xCA66FA129F9B60A6, 0xD41A26E077774EF6, // 5^-321
+			0xFD00B897478238D0, 0x8920B098955522B4, // 5^-320
+			0x9E20735E8CB16382, 0x55B46E5F5D5535B0, // 5^-319
+			0xC5A890362FDDBC62, 0xEB2189F734AA831D, // 5^-318
+			0xF712B443BBD52B7B, 0xA5E9EC7501D523E4, // 5^-317
+			0x9A6BB0AA55653B2D, 0x47B233C92125366E, // 5^-316
+			0xC1069CD4EABE89F8, 0x999EC0BB696E840A, // 5^-315
+			0xF148440A256E2C76, 0xC00670EA43CA250D, // 5^-314
+			0x96CD2A865764DBCA, 0x380406926A5E5728, // 5^-313
+			0xBC807527ED3E12BC, 0xC605083704F5ECF2, // 5^-312
+			0xEBA09271E88D976B, 0xF7864A44C633682E, // 5^-311
+			0x93445B8731587EA3, 0x7AB3EE6AFBE0211D, // 5^-310
+			0xB8157268FDAE9E4C, 0x5960EA05BAD82964, // 5^-309
+			0xE61ACF033D1A45DF, 0x6FB92487298E33BD, // 5^-308
+			0x8FD0C16206306BAB, 0xA5D3B6D479F8E056, // 5^-307
+			0xB3C4F1BA87BC8696, 0x8F48A4899877186C, // 5^-306
+			0xE0B62E2929ABA83C, 0x331ACDABFE94DE87, // 5^-305
+			0x8C71DCD9BA0B4925, 0x9FF0C08B7F1D0B14, // 5^-304
+			0xAF8E5410288E1B6F, 0x07ECF0AE5EE44DD9, // 5^-303
+			0xDB71E91432B1A24A, 0xC9E82CD9F69D6150, // 5^-302
+			0x892731AC9FAF056E, 0xBE311C083A225CD2, // 5^-301
+			0xAB70FE17C79AC6CA, 0x6DBD630A48AAF406, // 5^-300
+			0xD64D3D9DB981787D, 0x092CBBCCDAD5B108, // 5^-299
+			0x85F0468293F0EB4E, 0x25BBF56008C58EA5, // 5^-298
+			0xA76C582338ED2621, 0xAF2AF2B80AF6F24E, // 5^-297
+			0xD1476E2C07286FAA, 0x1AF5AF660DB4AEE1, // 5^-296
+			0x82CCA4DB847945CA, 0x50D98D9FC890ED4D, // 5^-295
+			0xA37FCE126597973C, 0xE50FF107BAB528A0, // 5^-294
+			0xCC5FC196FEFD7D0C, 0x1E53ED49A96272C8, // 5^-293
+			0xFF77B1FCBEBCDC4F, 0x25E8E89C13BB0F7A, // 5^-292
+			0x9FAACF3DF73609B1, 0x77B191618C54E9AC, // 5^-291
+			0xC795830D75038C1D, 0xD59DF5B9EF6A2417, // 5^-290
+			0xF97AE3D0D2446F25, 0x4B0573286B44AD1D, // 5^-289
+			0x9BECCE62836AC577, 0x4EE367F9430AEC32, // 5^-288
+			0xC2E801FB244576D5, 0x229C41F793CDA73F, // 5^-287
+			0xF3A20279ED56D48A, 0x6B43527578C1110F, // 5^-286
+			0x9845418C345644D6, 0x830A13896B78AAA9, // 5^-285
+			0xBE5691EF416BD60C, 0x23CC986BC656D553, // 5^-284
+			0xEDEC366B11C6CB8F, 0x2CBFBE86B7EC8AA8, // 5^-283
+			0x94B3A202EB1C3F39, 0x7BF7D71432F3D6A9, // 5^-282
+			0xB9E08A83A5E34F07, 0xDAF5CCD93FB0CC53, // 5^-281
+			0xE858AD248F5C22C9, 0xD1B3400F8F9CFF68, // 5^-280
+			0x91376C36D99995BE, 0x23100809B9C21FA1, // 5^-279
+			0xB58547448FFFFB2D, 0xABD40A0C2832A78A, // 5^-278
+			0xE2E69915B3FFF9F9, 0x16C90C8F323F516C, // 5^-277
+			0x8DD01FAD907FFC3B, 0xAE3DA7D97F6792E3, // 5^-276
+			0xB1442798F49FFB4A, 0x99CD11CFDF41779C, // 5^-275
+			0xDD95317F31C7FA1D, 0x40405643D711D583, // 5^-274
+			0x8A7D3EEF7F1CFC52, 0x482835EA666B2572, // 5^-273
+			0xAD1C8EAB5EE43B66, 0xDA3243650005EECF, // 5^-272
+			0xD863B256369D4A40, 0x90BED43E40076A82, // 5^-271
+			0x873E4F75E2224E68, 0x5A7744A6E804A291, // 5^-270
+			0xA90DE3535AAAE202, 0x711515D0A205CB36, // 5^-269
+			0xD3515C2831559A83, 0x0D5A5B44CA873E03, // 5^-268
+			0x8412D9991ED58091, 0xE858790AFE9486C2, // 5^-267
+			0xA5178FFF668AE0B6, 0x626E974DBE39A872, // 5^-266
+			0xCE5D73FF402D98E3, 0xFB0A3D212DC8128F, // 5^-265
+			0x80FA687F881C7F8E, 0x7CE66634BC9D0B99, // 5^-264
+			0xA139029F6A239F72, 0x1C1FFFC1EBC44E80, // 5^-263
+			0xC987434744AC874E, 0xA327FFB266B56220, // 5^-262
+			0xFBE9141915D7A922, 0x4BF1FF9F0062BAA8, // 5^-261
+			0x9D71AC8FADA6C9B5, 0x6F773FC3603DB4A9, // 5^-260
+			0xC4CE17B399107C22, 0xCB550FB4384D21D3, // 5^-259
+			0xF6019DA07F549B2B, 0x7E2A53A146606A48, // 5^-258
+			0x99C102844F94E0FB, 0x2EDA7444CBFC426D, // 5^-257
+			0xC0314325637A1939, 0xFA911155FEFB5308, // 5^-256
+			0xF03D93EEBC589F88, 0x793555AB7EBA27CA, // 5^-255
+			0x96267C7535B763B5, 0x4BC1558B2F3458DE, // 5^-254
+			0xBBB01B9283253CA2, 0x9EB1AAEDFB016F16, // 5^-253
+			0xEA9C227723EE8BCB, 0x465E15A979C1CADC, // 5^-252
+			0x92A1958A7675175F, 0x0BFACD89EC191EC9, // 5^-251
+			0xB749FAED14125D36, 0xCEF980EC671F667B, // 5^-250
+			0xE51C79A85916F484, 0x82B7E12780E7401A, // 5^-249
+			0x8F31CC0937AE58D2, 0xD1B2ECB8B0908810, // 5^-248
+			0xB2FE3F0B8599EF07, 0x861FA7E6DCB4AA15, // 5^-247
+			0xDFBDCECE67006AC9, 0x67A791E093E1D49A, // 5^-246
+			0x8BD6A141006042BD, 0xE0C8BB2C5C6D24E0, // 5^-245
+			0xAECC49914078536D, 0x58FAE9F773886E18, // 5^-244
+			0xDA7F5BF590966848, 0xAF39A475506A899E, // 5^-243
+			0x888F99797A5E012D, 0x6D8406C952429603, // 5^-242
+			0xAAB37FD7D8F58178, 0xC8E5087BA6D33B83, // 5^-241
+			0xD5605FCDCF32E1D6, 0xFB1E4A9A90880A64, // 5^-240
+			0x855C3BE0A17FCD26, 0x5CF2EEA09A55067F, // 5^-239
+			0xA6B34AD8C9DFC06F, 0xF42FAA48C0EA481E, // 5^-238
+			0xD0601D8EFC57B08B, 0xF13B94DAF124DA26, // 5^-237
+			0x823C12795DB6CE57, 0x76C53D08D6B70858, // 5^-236
+			0xA2CB1717B52481ED, 0x54768C4B0C64CA6E, // 5^-235
+			0xCB7DDCDDA26DA268, 0xA9942F5DCF7DFD09, // 5^-234
+			0xFE5D54150B090B02, 0xD3F93B35435D7C4C, // 5^-233
+			0x9EFA548D26E5A6E1, 0xC47BC5014A1A6DAF, // 5^-232
+			0xC6B8E9B0709F109A, 0x359AB6419CA1091B, // 5^-231
+			0xF867241C8CC6D4C0, 0xC30163D203C94B62, // 5^-230
+			0x9B407691D7FC44F8, 0x79E0DE63425DCF1D, // 5^-229
+			0xC21094364DFB5636, 0x985915FC12F542E4, // 5^-228
+			0xF294B943E17A2BC4, 0x3E6F5B7B17B2939D, // 5^-227
+			0x979CF3CA6CEC5B5A, 0xA705992CEECF9C42, // 5^-226
+			0xBD8430BD08277231, 0x50C6FF782A838353, // 5^-225
+			0xECE53CEC4A314EBD, 0xA4F8BF5635246428, // 5^-224
+			0x940F4613AE5ED136, 0x871B7795E136BE99, // 5^-223
+			0xB913179899F68584, 0x28E2557B59846E3F, // 5^-222
+			0xE757DD7EC07426E5, 0x331AEADA2FE589CF, // 5^-221
+			0x9096EA6F3848984F, 0x3FF0D2C85DEF7621, // 5^-220
+			0xB4BCA50B065ABE63, 0x0FED077A756B53A9, // 5^-219
+			0xE1EBCE4DC7F16DFB, 0xD3E8495912C62894, // 5^-218
+			0x8D3360F09CF6E4BD, 0x64712DD7ABBBD95C, // 5^-217
+			0xB080392CC4349DEC, 0xBD8D794D96AACFB3, // 5^-216
+			0xDCA04777F541C567, 0xECF0D7A0FC5583A0, // 5^-215
+			0x89E42CAAF9491B60, 0xF41686C49DB57244, // 5^-214
+			0xAC5D37D5B79B6239, 0x311C2875C522CED5, // 5^-213
+			0xD77485CB25823AC7, 0x7D633293366B828B, // 5^-212
+			0x86A8D39EF77164BC, 0xAE5DFF9C02033197, // 5^-211
+			0xA8530886B54DBDEB, 0xD9F57F830283FDFC, // 5^-210
+			0xD267CAA862A12D66, 0xD072DF63C324FD7B, // 5^-209
+			0x8380DEA93DA4BC60, 0x4247CB9E59F71E6D, // 5^-208
+			0xA46116538D0DEB78, 0x52D9BE85F074E608, // 5^-207
+			0xCD795BE870516656, 0x67902E276C921F8B, // 5^-206
+			0x806BD9714632DFF6, 0x00BA1CD8A3DB53B6, // 5^-205
+			0xA086CFCD97BF97F3, 0x80E8A40ECCD228A4, // 5^-204
+			0xC8A883C0FDAF7DF0, 0x6122CD128006B2CD, // 5^-203
+			0xFAD2A4B13D1B5D6C, 0x796B805720085F81, // 5^-202
+			0x9CC3A6EEC6311A63, 0xCBE3303674053BB0, // 5^-201
+			0xC3F490AA77BD60FC, 0xBEDBFC4411068A9C, // 5^-200
+			0xF4F1B4D515ACB93B, 0xEE92FB5515482D44, // 5^-199
+			0x991711052D8BF3C5, 0x751BDD152D4D1C4A, // 5^-198
+			0xBF5CD54678EEF0B6, 0xD262D45A78A0635D, // 5^-197
+			0xEF340A98172AACE4, 0x86FB897116C87C34, // 5^-196
+			0x9580869F0E7AAC0E, 0xD45D35E6AE3D4DA0, // 5^-195
+			0xBAE0A846D2195712, 0x8974836059CCA109, // 5^-194
+			0xE998D258869FACD7, 0x2BD1A438703FC94B, // 5^-193
+			0x91FF83775423CC06, 0x7B6306A34627DDCF, // 5^-192
+			0xB67F6455292CBF08, 0x1A3BC84C17B1D542, // 5^-191
+			0xE41F3D6A7377EECA, 0x20CABA5F1D9E4A93, // 5^-190
+			0x8E938662882AF53E, 0x547EB47B7282EE9C, // 5^-189
+			0xB23867FB2A35B28D, 0xE99E619A4F23AA43, // 5^-188
+			0xDEC681F9F4C31F31, 0x6405FA00E2EC94D4, // 5^-187
+			0x8B3C113C38F9F37E, 0xDE83BC408DD3DD04, // 5^-186
+			0xAE0B158B4738705E, 0x9624AB50B148D445, // 5^-185
+			0xD98DDAEE19068C76, 0x3BADD624DD9B0957, // 5^-184
+			0x87F8A8D4CFA417C9, 0xE54CA5D70A80E5D6, // 5^-183
+			0xA9F6D30A038D1DBC, 0x5E9FCF4CCD211F4C, // 5^-182
+			0xD47487CC8470652B, 0x7647C3200069671F, // 5^-181
+			0x84C8D4DFD2C63F3B, 0x29ECD9F40041E073, // 5^-180
+			0xA5FB0A17C777CF09, 0xF468107100525890, // 5^-179
+			0xCF79CC9DB955C2CC, 0x7182148D4066EEB4, // 5^-178
+			0x81AC1FE293D599BF, 0xC6F14CD848405530, // 5^-177
+			0xA21727DB38CB002F, 0xB8ADA00E5A506A7C, // 5^-176
+			0xCA9CF1D206FDC03B, 0xA6D90811F0E4851C, // 5^-175
+			0xFD442E4688BD304A, 0x908F4A166D1DA663, // 5^-174
+			0x9E4A9CEC15763E2E, 0x9A598E4E043287FE, // 5^-173
+			0xC5DD44271AD3CDBA, 0x40EFF1E1853F29FD, // 5^-172
+			0xF7549530E188C128, 0xD12BEE59E68EF47C, // 5^-171
+			0x9A94DD3E8CF578B9, 0x82BB74F8301958CE, // 5^-170
+			0xC13A148E3032D6E7, 0xE36A52363C1FAF01, // 5^-169
+			0xF18899B1BC3F8CA1, 0xDC44E6C3CB279AC1, // 5^-168
+			0x96F5600F15A7B7E5, 0x29AB103A5EF8C0B9, // 5^-167
+			0xBCB2B812DB11A5DE, 0x7415D448F6B6F0E7, // 5^-166
+			0xEBDF661791D60F56, 0x111B495B3464AD21, // 5^-165
+			0x936B9FCEBB25C995, 0xCAB10DD900BEEC34, // 5^-164
+			0xB84687C269EF3BFB, 0x3D5D514F40EEA742, // 5^-163
+			0xE65829B3046B0AFA, 0x0CB4A5A3112A5112, // 5^-162
+			0x8FF71A0FE2C2E6DC, 0x47F0E785EABA72AB, // 5^-161
+			0xB3F4E093DB73A093, 0x59ED216765690F56, // 5^-160
+			0xE0F218B8D25088B8, 0x306869C13EC3532C, // 5^-159
+			0x8C974F7383725573, 0x1E414218C73A13FB, // 5^-158
+			0xAFBD2350644EEACF, 0xE5D1929EF90898FA, // 5^-157
+			0xDBAC6C247D62A583, 0xDF45F746B74ABF39, // 5^-156
+			0x894BC396CE5DA772, 0x6B8BBA8C328EB783, // 5^-155
+			0xAB9EB47C81F5114F, 0x066EA92F3F326564, // 5^-154
+			0xD686619BA27255A2, 0xC80A537B0EFEFEBD, // 5^-153
+			0x8613FD0145877585, 0xBD06742CE95F5F36, // 5^-152
+			0xA798FC4196E952E7, 0x2C48113823B73704, // 5^-151
+			0xD17F3B51FCA3A7A0, 0xF75A15862CA504C5, // 5^-150
+			0x82EF85133DE648C4, 0x9A984D73DBE722FB, // 5^-149
+			0xA3AB66580D5FDAF5, 0xC13E60D0D2E0EBBA, // 5^-148
+			0xCC963FEE10B7D1B3, 0x318DF905079926A8, // 5^-147
+			0xFFBBCFE994E5C61F, 0xFDF17746497F7052, // 5^-146
+			0x9FD561F1FD0F9BD3, 0xFEB6EA8BEDEFA633, // 5^-145
+			0xC7CABA6E7C5382C8, 0xFE64A52EE96B8FC0, // 5^-144
+			0xF9BD690A1B68637B, 0x3DFDCE7AA3C673B0, // 5^-143
+			0x9C1661A651213E2D, 0x06BEA10CA65C084E, // 5^-142
+			0xC31BFA0FE5698DB8, 0x486E494FCFF30A62, // 5^-141
+			0xF3E2F893DEC3F126, 0x5A89DBA3C3EFCCFA, // 5^-140
+			0x986DDB5C6B3A76B7, 0xF89629465A75E01C, // 5^-139
+			0xBE89523386091465, 0xF6BBB397F1135823, // 5^-138
+			0xEE2BA6C0678B597F, 0x746AA07DED582E2C, // 5^-137
+			0x94DB483840B717EF, 0xA8C2A44EB4571CDC, // 5^-136
+			0xBA121A4650E4DDEB, 0x92F34D62616CE413, // 5^-135
+			0xE896A0D7E51E1566, 0x77B020BAF9C81D17, // 5^-134
+			0x915E2486EF32CD60, 0x0ACE1474DC1D122E, // 5^-133
+			0xB5B5ADA8AAFF80B8, 0x0D819992132456BA, // 5^-132
+			0xE3231912D5BF60E6, 0x10E1FFF697ED6C69, // 5^-131
+			0x8DF5EFABC5979C8F, 0xCA8D3FFA1EF463C1, // 5^-130
+			0xB1736B96B6FD83B3, 0xBD308FF8A6B17CB2, // 5^-129
+			0xDDD0467C64BCE4A0, 0xAC7CB3F6D05DDBDE, // 5^-128
+			0x8AA22C0DBEF60EE4, 0x6BCDF07A423AA96B, // 5^-127
+			0xAD4AB7112EB3929D, 0x86C16C98D2C953C6, // 5^-126
+			0xD89D64D57A607744, 0xE871C7BF077BA8B7, // 5^-125
+			0x87625F056C7C4A8B, 0x11471CD764AD4972, // 5^-124
+			0xA93AF6C6C79B5D2D, 0xD598E40D3DD89BCF, // 5^-123
+			0xD389B47879823479, 0x4AFF1D108D4EC2C3, // 5^-122
+			0x843610CB4BF160CB, 0xCEDF722A585139BA, // 5^-121
+			0xA54394FE1EEDB8FE, 0xC2974EB4EE658828, // 5^-120
+			0xCE947A3DA6A9273E, 0x733D226229FEEA32, // 5^-119
+			0x811CCC668829B887, 0x0806357D5A3F525F, // 5^-118
+			0xA163FF802A3426A8, 0xCA07C2DCB0CF26F7, // 5^-117
+			0xC9BCFF6034C13052, 0xFC89B393DD02F0B5, // 5^-116
+			0xFC2C3F3841F17C67, 0xBBAC2078D443ACE2, // 5^-115
+			0x9D9BA7832936EDC0, 0xD54B944B84AA4C0D, // 5^-114
+			0xC5029163F384A931, 0x0A9E795E65D4DF11, // 5^-113
+			0xF64335BCF065D37D, 0x4D4617B5FF4A16D5, // 5^-112
+			0x99EA0196163FA42E, 0x504BCED1BF8E4E45, // 5^-111
+			0xC06481FB9BCF8D39, 0xE45EC2862F71E1D6, // 5^-110
+			0xF07DA27A82C37088, 0x5D767327BB4E5A4C, // 5^-109
+			0x964E858C91BA2655, 0x3A6A07F8D510F86F, // 5^-108
+			0xBBE226EFB628AFEA, 0x890489F70A55368B, // 5^-107
+			0xEADAB0ABA3B2DBE5, 0x2B45AC74CCEA842E, // 5^-106
+			0x92C8AE6B464FC96F, 0x3B0B8BC90012929D, // 5^-105
+			0xB77ADA0617E3BBCB, 0x09CE6EBB40173744, // 5^-104
+			0xE55990879DDCAABD, 0xCC420A6A101D0515, // 5^-103
+			0x8F57FA54C2A9EAB6, 0x9FA946824A12232D, // 5^-102
+			0xB32DF8E9F3546564, 0x47939822DC96ABF9, // 5^-101
+			0xDFF9772470297EBD, 0x59787E2B93BC56F7, // 5^-100
+			0x8BFBEA76C619EF36, 0x57EB4EDB3C55B65A, // 5^-99
+			0xAEFAE51477A06B03, 0xEDE622920B6B23F1, // 5^-98
+			0xDAB99E59958885C4, 0xE95FAB368E45ECED, // 5^-97
+			0x88B402F7FD75539B, 0x11DBCB0218EBB414, // 5^-96
+			0xAAE103B5FCD2A881, 0xD652BDC29F26A119, // 5^-95
+			0xD59944A37C0752A2, 0x4BE76D3346F0495F, // 5^-94
+			0x857FCAE62D8493A5, 0x6F70A4400C562DDB, // 5^-93
+			0xA6DFBD9FB8E5B88E, 0xCB4CCD500F6BB952, // 5^-92
+			0xD097AD07A71F26B2, 0x7E2000A41346A7A7, // 5^-91
+			0x825ECC24C873782F, 0x8ED400668C0C28C8, // 5^-90
+			0xA2F67F2DFA90563B, 0x728900802F0F32FA, // 5^-89
+			0xCBB41EF979346BCA, 0x4F2B40A03AD2FFB9, // 5^-88
+			0xFEA126B7D78186BC, 0xE2F610C84987BFA8, // 5^-87
+			0x9F24B832E6B0F436, 0x0DD9CA7D2DF4D7C9, // 5^-86
+			0xC6EDE63FA05D3143, 0x91503D1C79720DBB, // 5^-85
+			0xF8A95FCF88747D94, 0x75A44C6397CE912A, // 5^-84
+			0x9B69DBE1B548CE7C, 0xC986AFBE3EE11ABA, // 5^-83
+			0xC24452DA229B021B, 0xFBE85BADCE996168, // 5^-82
+			0xF2D56790AB41C2A2, 0xFAE27299423FB9C3, // 5^-81
+			0x97C560BA6B0919A5, 0xDCCD879FC967D41A, // 5^-80
+			0xBDB6B8E905CB600F, 0x5400E987BBC1C920, // 5^-79
+			0xED246723473E3813, 0x290123E9AAB23B68, // 5^-78
+			0x9436C0760C86E30B, 0xF9A0B6720AAF6521, // 5^-77
+			0xB94470938FA89BCE, 0xF808E40E8D5B3E69, // 5^-76
+			0xE7958CB87392C2C2, 0xB60B1D1230B20E04, // 5^-75
+			0x90BD77F3483BB9B9, 0xB1C6F22B5E6F48C2, // 5^-74
+			0xB4ECD5F01A4AA828, 0x1E38AEB6360B1AF3, // 5^-73
+			0xE2280B6C20DD5232, 0x25C6DA63C38DE1B0, // 5^-72
+			0x8D590723948A535F, 0x579C487E5A38AD0E, // 5^-71
+			0xB0AF48EC79ACE837, 0x2D835A9DF0C6D851, // 5^-70
+			0xDCDB1B2798182244, 0xF8E431456CF88E65, // 5^-69
+			0x8A08F0F8BF0F156B, 0x1B8E9ECB641B58FF, // 5^-68
+			0xAC8B2D36EED2DAC5, 0xE272467E3D222F3F, // 5^-67
+			0xD7ADF884AA879177, 0x5B0ED81DCC6ABB0F, // 5^-66
+			0x86CCBB52EA94BAEA, 0x98E947129FC2B4E9, // 5^-65
+			0xA87FEA27A539E9A5, 0x3F2398D747B36224, // 5^-64
+			0xD29FE4B18E88640E, 0x8EEC7F0D19A03AAD, // 5^-63
+			0x83A3EEEEF9153E89, 0x1953CF68300424AC, // 5^-62
+			0xA48CEAAAB75A8E2B, 0x5FA8C3423C052DD7, // 5^-61
+			0xCDB02555653131B6, 0x3792F412CB06794D, // 5^-60
+			0x808E17555F3EBF11, 0xE2BBD88BBEE40BD0, // 5^-59
+			0xA0B19D2AB70E6ED6, 0x5B6ACEAEAE9D0EC4, // 5^-58
+			0xC8DE047564D20A8B, 0xF245825A5A445275, // 5^-57
+			0xFB158592BE068D2E, 0xEED6E2F0F0D56712, // 5^-56
+			0x9CED737BB6C4183D, 0x55464DD69685606B, // 5^-55
+			0xC428D05AA4751E4C, 0xAA97E14C3C26B886, // 5^-54
+			0xF53304714D9265DF, 0xD53DD99F4B3066A8, // 5^-53
+			0x993FE2C6D07B7FAB, 0xE546A8038EFE4029, // 5^-52
+			0xBF8FDB78849A5F96, 0xDE98520472BDD033, // 5^-51
+			0xEF73D256A5C0F77C, 0x963E66858F6D4440, // 5^-50
+			0x95A8637627989AAD, 0xDDE7001379A44AA8, // 5^-49
+			0xBB127C53B17EC159, 0x5560C018580D5D52, // 5^-48
+			0xE9D71B689DDE71AF, 0xAAB8F01E6E10B4A6, // 5^-47
+			0x9226712162AB070D, 0xCAB3961304CA70E8, // 5^-46
+			0xB6B00D69BB55C8D1, 0x3D607B97C5FD0D22, // 5^-45
+			0xE45C10C42A2B3B05, 0x8CB89A7DB77C506A, // 5^-44
+			0x8EB98A7A9A5B04E3, 0x77F3608E92ADB242, // 5^-43
+			0xB267ED1940F1C61C, 0x55F038B237591ED3, // 5^-42
+			0xDF01E85F912E37A3, 0x6B6C46DEC52F6688, // 5^-41
+			0x8B61313BBABCE2C6, 0x2323AC4B3B3DA015, // 5^-40
+			0xAE397D8AA96C1B77, 0xABEC975E0A0D081A, // 5^-39
+			0xD9C7DCED53C72255, 0x96E7BD358C904A21, // 5^-38
+			0x881CEA14545C7575, 0x7E50D64177DA2E54, // 5^-37
+			0xAA242499697392D2, 0xDDE50BD1D5D0B9E9, // 5^-36
+			0xD4AD2DBFC3D07787, 0x955E4EC64B44E864, // 5^-35
+			0x84EC3C97DA624AB4, 0xBD5AF13BEF0B113E, // 5^-34
+			0xA6274BBDD0FADD61, 0xECB1AD8AEACDD58E, // 5^-33
+			0xCFB11EAD453994BA, 0x67DE18EDA5814AF2, // 5^-32
+			0x81CEB32C4B43FCF4, 0x80EACF948770CED7, // 5^-31
+			0xA2425FF75E14FC31, 0xA1258379A94D028D, // 5^-30
+			0xCAD2F7F5359A3B3E, 0x096EE45813A04330, // 5^-29
+			0xFD87B5F28300CA0D, 0x8BCA9D6E188853FC, // 5^-28
+			0x9E74D1B791E07E48, 0x775EA264CF55347E, // 5^-27
+			0xC612062576589DDA, 0x95364AFE032A819E, // 5^-26
+			0xF79687AED3EEC551, 0x3A83DDBD83F52205, // 5^-25
+			0x9ABE14CD44753B52, 0xC4926A9672793543, // 5^-24
+			0xC16D9A0095928A27, 0x75B7053C0F178294, // 5^-23
+			0xF1C90080BAF72CB1, 0x5324C68B12DD6339, // 5^-22
+			0x971DA05074DA7BEE, 0xD3F6FC16EBCA5E04, // 5^-21
+			0xBCE5086492111AEA, 0x88F4BB1CA6BCF585, // 5^-20
+			0xEC1E4A7DB69561A5, 0x2B31E9E3D06C32E6, // 5^-19
+			0x9392EE8E921D5D07, 0x3AFF322E62439FD0, // 5^-18
+			0xB877AA3236A4B449, 0x09BEFEB9FAD487C3, // 5^-17
+			0xE69594BEC44DE15B, 0x4C2EBE687989A9B4, // 5^-16
+			0x901D7CF73AB0ACD9, 0x0F9D37014BF60A11, // 5^-15
+			0xB424DC35095CD80F, 0x538484C19EF38C95, // 5^-14
+			0xE12E13424BB40E13, 0x2865A5F206B06FBA, // 5^-13
+			0x8CBCCC096F5088CB, 0xF93F87B7442E45D4, // 5^-12
+			0xAFEBFF0BCB24AAFE, 0xF78F69A51539D749, // 5^-11
+			0xDBE6FECEBDEDD5BE, 0xB573440E5A884D1C, // 5^-10
+			0x89705F4136B4A597, 0x31680A88F8953031, // 5^-9
+			0xABCC77118461CEFC, 0xFDC20D2B36BA7C3E, // 5^-8
+			0xD6BF94D5E57A42BC, 0x3D32907604691B4D, // 5^-7
+			0x8637BD05AF6C69B5, 0xA63F9A49C2C1B110, // 5^-6
+			0xA7C5AC471B478423, 0x0FCF80DC33721D54, // 5^-5
+			0xD1B71758E219652B, 0xD3C36113404EA4A9, // 5^-4
+			0x83126E978D4FDF3B, 0x645A1CAC083126EA, // 5^-3
+			0xA3D70A3D70A3D70A, 0x3D70A3D70A3D70A4, // 5^-2
+			0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCD, // 5^-1
+			0x8000000000000000, 0x0000000000000000, // 5^0
+			0xA000000000000000, 0x0000000000000000, // 5^1
+			0xC800000000000000, 0x0000000000000000, // 5^2
+			0xFA00000000000000, 0x0000000000000000, // 5^3
+			0x9C40000000000000, 0x0000000000000000, // 5^4
+			0xC350000000000000, 0x0000000000000000, // 5^5
+			0xF424000000000000, 0x0000000000000000, // 5^6
+			0x9896800000000000, 0x0000000000000000, // 5^7
+			0xBEBC200000000000, 0x0000000000000000, // 5^8
+			0xEE6B280000000000, 0x0000000000000000, // 5^9
+			0x9502F90000000000, 0x0000000000000000, // 5^10
+			0xBA43B74000000000, 0x0000000000000000, // 5^11
+			0xE8D4A51000000000, 0x0000000000000000, // 5^12
+			0x9184E72A00000000, 0x0000000000000000, // 5^13
+			0xB5E620F480000000, 0x0000000000000000, // 5^14
+			0xE35FA931A0000000, 0x0000000000000000, // 5^15
+			0x8E1BC9BF04000000, 0x0000000000000000, // 5^16
+			0xB1A2BC2EC5000000, 0x0000000000000000, // 5^17
+			0xDE0B6B3A76400000, 0x0000000000000000, // 5^18
+			0x8AC7230489E80000, 0x0000000000000000, // 5^19
+			0xAD78EBC5AC620000, 0x0000000000000000, // 5^20
+			0xD8D726B7177A8000, 0x0000000000000000, // 5^21
+			0x878678326EAC9000, 0x0000000000000000, // 5^22
+			0xA968163F0A57B400, 0x0000000000000000, // 5^23
+			0xD3C21BCECCEDA100, 0x0000000000000000, // 5^24
+			0x84595161401484A0, 0x0000000000000000, // 5^25
+			0xA56FA5B99019A5C8, 0x0000000000000000, // 5^26
+			0xCECB8F27F4200F3A, 0x0000000000000000, // 5^27
+			0x813F3978F8940984, 0x4000000000000000, // 5^28
+			0xA18F07D736B90BE5, 0x5000000000000000, // 5^29
+			0xC9F2C9CD04674EDE, 0xA400000000000000, // 5^30
+			0xFC6F7C4045812296, 0x4D00000000000000, // 5^31
+			0x9DC5ADA82B70B59D, 0xF020000000000000, // 5^32
+			0xC5371912364CE305, 0x6C28000000000000, // 5^33
+			0xF684DF56C3E01BC6, 0xC732000000000000, // 5^34
+			0x9A130B963A6C115C, 0x3C7F400000000000, // 5^35
+			0xC097CE7BC90715B3, 0x4B9F100000000000, // 5^36
+			0xF0BDC21ABB48DB20, 0x1E86D40000000000, // 5^37
+			0x96769950B50D88F4, 0x1314448000000000, // 5^38
+			0xBC143FA4E250EB31, 0x17D955A000000000, // 5^39
+			0xEB194F8E1AE525FD, 0x5DCFAB0800000000, // 5^40
+			0x92EFD1B8D0CF37BE, 0x5AA1CAE500000000, // 5^41
+			0xB7ABC627050305AD, 0xF14A3D9E40000000, // 5^42
+			0xE596B7B0C643C719, 0x6D9CCD05D0000000, // 5^43
+			0x8F7E32CE7BEA5C6F, 0xE4820023A2000000, // 5^44
+			0xB35DBF821AE4F38B, 0xDDA2802C8A800000, // 5^45
+			0xE0352F62A19E306E, 0xD50B2037AD200000, // 5^46
+			0x8C213D9DA502DE45, 0x4526F422CC340000, // 5^47
+			0xAF298D050E4395D6, 0x9670B12B7F410000, // 5^48
+			0xDAF3F04651D47B4C, 0x3C0CDD765F114000, // 5^49
+			0x88D8762BF324CD0F, 0xA5880A69FB6AC800, // 5^50
+			0xAB0E93B6EFEE0053, 0x8EEA0D047A457A00, // 5^51
+			0xD5D238A4ABE98068, 0x72A4904598D6D880, // 5^52
+			0x85A36366EB71F041, 0x47A6DA2B7F864750, // 5^53
+			0xA70C3C40A64E6C51, 0x999090B65F67D924, // 5^54
+			0xD0CF4B50CFE20765, 0xFFF4B4E3F741CF6D, // 5^55
+			0x82818F1281ED449F, 0xBFF8F10E7A8921A4, // 5^56
+			0xA321F2D7226895C7, 0xAFF72D52192B6A0D, // 5^57
+			0xCBEA6F8CEB02BB39, 0x9BF4F8A69F764490, // 5^58
+			0xFEE50B7025C36A08, 0x02F236D04753D5B4, // 5^59
+			0x9F4F2726179A2245, 0x01D762422C946590, // 5^60
+			0xC722F0EF9D80AAD6, 0x424D3AD2B7B97EF5, // 5^61
+			0xF8EBAD2B84E0D58B, 0xD2E0898765A7DEB2, // 5^62
+			0x9B934C3B330C8577, 0x63CC55F49F88EB2F, // 5^63
+			0xC2781F49FFCFA6D5, 0x3CBF6B71C76B25FB, // 5^64
+			0xF316271C7FC3908A, 0x8BEF464E3945EF7A, // 5^65
+			0x97EDD871CFDA3A56, 0x97758BF0E3CBB5AC, // 5^66
+			0xBDE94E8E43D0C8EC, 0x3D52EEED1CBEA317, // 5^67
+			0xED63A231D4C4FB27, 0x4CA7AAA863EE4BDD, // 5^68
+			0x945E455F24FB1CF8, 0x8FE8CAA93E74EF6A, // 5^69
+			0xB975D6B6EE39E436, 0xB3E2FD538E122B44, // 5^70
+			0xE7D34C64A9C85D44, 0x60DBBCA87196B616, // 5^71
+			0x90E40FBEEA1D3A4A, 0xBC8955E946FE31CD, // 5^72
+			0xB51D13AEA4A488DD, 0x6BABAB6398BDBE41, // 5^73
+			0xE264589A4DCDAB14, 0xC696963C7EED2DD1, // 5^74
+			0x8D7EB76070A08AEC, 0xFC1E1DE5CF543CA2, // 5^75
+			0xB0DE65388CC8ADA8, 0x3B25A55F43294BCB, // 5^76
+			0xDD15FE86AFFAD912, 0x49EF0EB713F39EBE, // 5^77
+			0x8A2DBF142DFCC7AB, 0x6E3569326C784337, // 5^78
+			0xACB92ED9397BF996, 0x49C2C37F07965404, // 5^79
+			0xD7E77A8F87DAF7FB, 0xDC33745EC97BE906, // 5^80
+			0x86F0AC99B4E8DAFD, 0x69A028BB3DED71A3, // 5^81
+			0xA8ACD7C0222311BC, 0xC40832EA0D68CE0C, // 5^82
+			0xD2D80DB02AABD62B, 0xF50A3FA490C30190, // 5^83
+			0x83C7088E1AAB65DB, 0x792667C6DA79E0FA, // 5^84
+			0xA4B8CAB1A1563F52, 0x577001B891185938, // 5^85
+			0xCDE6FD5E09ABCF26, 0xED4C0226B55E6F86, // 5^86
+			0x80B05E5AC60B6178, 0x544F8158315B05B4, // 5^87
+			0xA0DC75F1778E39D6, 0x696361AE3DB1C721, // 5^88
+			0xC913936DD571C84C, 0x03BC3A19CD1E38E9, // 5^89
+			0xFB5878494ACE3A5F, 0x04AB48A04065C723, // 5^90
+			0x9D174B2DCEC0E47B, 0x62EB0D64283F9C76, // 5^91
+			0xC45D1DF942711D9A, 0x3BA5D0BD324F8394, // 5^92
+			0xF5746577930D6500, 0xCA8F44EC7EE36479, // 5^93
+			0x9968BF6ABBE85F20, 0x7E998B13CF4E1ECB, // 5^94
+			0xBFC2EF456AE276E8, 0x9E3FEDD8C321A67E, // 5^95
+			0xEFB3AB16C59B14A2, 0xC5CFE94EF3EA101E, // 5^96
+			0x95D04AEE3B80ECE5, 0xBBA1F1D158724A12, // 5^97
+			0xBB445DA9CA61281F, 0x2A8A6E45AE8EDC97, // 5^98
+			0xEA1575143CF97226, 0xF52D09D71A3293BD, // 5^99
+			0x924D692CA61BE758, 0x593C2626705F9C56, // 5^100
+			0xB6E0C377CFA2E12E, 0x6F8B2FB00C77836C, // 5^101
+			0xE498F455C38B997A, 0x0B6DFB9C0F956447, // 5^102
+			0x8EDF98B59A373FEC, 0x4724BD4189BD5EAC, // 5^103
+			0xB2977EE300C50FE7, 0x58EDEC91EC2CB657, // 5^104
+			0xDF3D5E9BC0F653E1, 0x2F2967B66737E3ED, // 5^105
+			0x8B865B215899F46C, 0xBD79E0D20082EE74, // 5^106
+			0xAE67F1E9AEC07187, 0xECD8590680A3AA11, // 5^107
+			0xDA01EE641A708DE9, 0xE80E6F4820CC9495, // 5^108
+			0x884134FE908658B2, 0x3109058D147FDCDD, // 5^109
+			0xAA51823E34A7EEDE, 0xBD4B46F0599FD415, // 5^110
+			0xD4E5E2CDC1D1EA96, 0x6C9E18AC7007C91A, // 5^111
+			0x850FADC09923329E, 0x03E2CF6BC604DDB0, // 5^112
+			0xA6539930BF6BFF45, 0x84DB8346B786151C, // 5^113
+			0xCFE87F7CEF46FF16, 0xE612641865679A63, // 5^114
+			0x81F14FAE158C5F6E, 0x4FCB7E8F3F60C07E, // 5^115
+			0xA26DA3999AEF7749, 0xE3BE5E330F38F09D, // 5^116
+			0xCB090C8001AB551C, 0x5CADF5BFD3072CC5, // 5^117
+			0xFDCB4FA002162A63, 0x73D9732FC7C8F7F6, // 5^118
+			0x9E9F11C4014DDA7E, 0x2867E7FDDCDD9AFA, // 5^119
+			0xC646D63501A1511D, 0xB281E1FD541501B8, // 5^120
+			0xF7D88BC24209A565, 0x1F225A7CA91A4226, // 5^121
+			0x9AE757596946075F, 0x3375788DE9B06958, // 5^122
+			0xC1A12D2FC3978937, 0x0052D6B1641C83AE, // 5^123
+			0xF209787BB47D6B84, 0xC0678C5DBD23A49A, // 5^124
+			0x9745EB4D50CE6332, 0xF840B7BA963646E0, // 5^125
+			0xBD176620A501FBFF, 0xB650E5A93BC3D898, // 5^126
+			0xEC5D3FA8CE427AFF, 0xA3E51F138AB4CEBE, // 5^127
+			0x93BA47C980E98CDF, 0xC66F336C36B10137, // 5^128
+			0xB8A8D9BBE123F017, 0xB80B0047445D4184, // 5^129
+			0xE6D3102AD96CEC1D, 0xA60DC059157491E5, // 5^130
+			0x9043EA1AC7E41392, 0x87C89837AD68DB2F, // 5^131
+			0xB454E4A179DD1877, 0x29BABE4598C311FB, // 5^132
+			0xE16A1DC9D8545E94, 0xF4296DD6FEF3D67A, // 5^133
+			0x8CE2529E2734BB1D, 0x1899E4A65F58660C, // 5^134
+			0xB01AE745B101E9E4, 0x5EC05DCFF72E7F8F, // 5^135
+			0xDC21A1171D42645D, 0x76707543F4FA1F73, // 5^136
+			0x899504AE72497EBA, 0x6A06494A791C53A8, // 5^137
+			0xABFA45DA0EDBDE69, 0x0487DB9D17636892, // 5^138
+			0xD6F8D7509292D603, 0x45A9D2845D3C42B6, // 5^139
+			0x865B86925B9BC5C2, 0x0B8A2392BA45A9B2, // 5^140
+			0xA7F26836F282B732, 0x8E6CAC7768D7141E, // 5^141
+			0xD1EF0244AF2364FF, 0x3207D795430CD926, // 5^142
+			0x8335616AED761F1F, 0x7F44E6BD49E807B8, // 5^143
+			0xA402B9C5A8D3A6E7, 0x5F16206C9C6209A6, // 5^144
+			0xCD036837130890A1, 0x36DBA887C37A8C0F, // 5^145
+			0x802221226BE55A64, 0xC2494954DA2C9789, // 5^146
+			0xA02AA96B06DEB0FD, 0xF2DB9BAA10B7BD6C, // 5^147
+			0xC83553C5C8965D3D, 0x6F92829494E5ACC7, // 5^148
+			0xFA42A8B73ABBF48C, 0xCB772339BA1F17F9, // 5^149
+			0x9C69A97284B578D7, 0xFF2A760414536EFB, // 5^150
+			0xC38413CF25E2D70D, 0xFEF5138519684ABA, // 5^151
+			0xF46518C2EF5B8CD1, 0x7EB258665FC25D69, // 5^152
+			0x98BF2F79D5993802, 0xEF2F773FFBD97A61, // 5^153
+			0xBEEEFB584AFF8603, 0xAAFB550FFACFD8FA, // 5^154
+			0xEEAABA2E5DBF6784, 0x95BA2A53F983CF38, // 5^155
+			0x952AB45CFA97A0B2, 0xDD945A747BF26183, // 5^156
+			0xBA756174393D88DF, 0x94F971119AEEF9E4, // 5^157
+			0xE912B9D1478CEB17, 0x7A37CD5601AAB85D, // 5^158
+			0x91ABB422CCB812EE, 0xAC62E055C10AB33A, // 5^159
+			0xB616A12B7FE617AA, 0x577B986B314D6009, // 5^160
+			0xE39C49765FDF9D94, 0xED5A7E85FDA0B80B, // 5^161
+			0x8E41ADE9FBEBC27D, 0x14588F13BE847307, // 5^162
+			0xB1D219647AE6B31C, 0x596EB2D8AE258FC8, // 5^163
+			0xDE469FBD99A05FE3, 0x6FCA5F8ED9AEF3BB, // 5^164
+			0x8AEC23D680043BEE, 0x25DE7BB9480D5854, // 5^165
+			0xADA72CCC20054AE9, 0xAF561AA79A10AE6A, // 5^166
+			0xD910F7FF28069DA4, 0x1B2BA1518094DA04, // 5^167
+			0x87AA9AFF79042286, 0x90FB44D2F05D0842, // 5^168
+			0xA99541BF57452B28, 0x353A1607AC744A53, // 5^169
+			0xD3FA922F2D1675F2, 0x42889B8997915CE8, // 5^170
+			0x847C9B5D7C2E09B7, 0x69956135FEBADA11, // 5^171
+			0xA59BC234DB398C25, 0x43FAB9837E699095, // 5^172
+			0xCF02B2C21207EF2E, 0x94F967E45E03F4BB, // 5^173
+			0x8161AFB94B44F57D, 0x1D1BE0EEBAC278F5, // 5^174
+			0xA1BA1BA79E1632DC, 0x6462D92A69731732, // 5^175
+			0xCA28A291859BBF93, 0x7D7B8F7503CFDCFE, // 5^176
+			0xFCB2CB35E702AF78, 0x5CDA735244C3D43E, // 5^177
+			0x9DEFBF01B061ADAB, 0x3A0888136AFA64A7, // 5^178
+			0xC56BAEC21C7A1916, 0x088AAA1845B8FDD0, // 5^179
+			0xF6C69A72A3989F5B, 0x8AAD549E57273D45, // 5^180
+			0x9A3C2087A63F6399, 0x36AC54E2F678864B, // 5^181
+			0xC0CB28A98FCF3C7F, 0x84576A1BB416A7DD, // 5^182
+			0xF0FDF2D3F3C30B9F, 0x656D44A2A11C51D5, // 5^183
+			0x969EB7C47859E743, 0x9F644AE5A4B1B325, // 5^184
+			0xBC4665B596706114, 0x873D5D9F0DDE1FEE, // 5^185
+			0xEB57FF22FC0C7959, 0xA90CB506D155A7EA, // 5^186
+			0x9316FF75DD87CBD8, 0x09A7F12442D588F2, // 5^187
+			0xB7DCBF5354E9BECE, 0x0C11ED6D538AEB2F, // 5^188
+			0xE5D3EF282A242E81, 0x8F1668C8A86DA5FA, // 5^189
+			0x8FA475791A569D10, 0xF96E017D694487BC, // 5^190
+			0xB38D92D760EC4455, 0x37C981DCC395A9AC, // 5^191
+			0xE070F78D3927556A, 0x85BBE253F47B1417, // 5^192
+			0x8C469AB843B89562, 0x93956D7478CCEC8E, // 5^193
+			0xAF58416654A6BABB, 0x387AC8D1970027B2, // 5^194
+			0xDB2E51BFE9D0696A, 0x06997B05FCC0319E, // 5^195
+			0x88FCF317F22241E2, 0x441FECE3BDF81F03, // 5^196
+			0xAB3C2FDDEEAAD25A, 0xD527E81CAD7626C3, // 5^197
+			0xD60B3BD56A5586F1, 0x8A71E223D8D3B074, // 5^198
+			0x85C7056562757456, 0xF6872D5667844E49, // 5^199
+			0xA738C6BEBB12D16C, 0xB428F8AC016561DB, // 5^200
+			0xD106F86E69D785C7, 0xE13336D701BEBA52, // 5^201
+			0x82A45B450226B39C, 0xECC0024661173473, // 5^202
+			0xA34D721642B06084, 0x27F002D7F95D0190, // 5^203
+			0xCC20CE9BD35C78A5, 0x31EC038DF7B441F4, // 5^204
+			0xFF290242C83396CE, 0x7E67047175A15271, // 5^205
+			0x9F79A169BD203E41, 0x0F0062C6E984D386, // 5^206
+			0xC75809C42C684DD1, 0x52C07B78A3E60868, // 5^207
+			0xF92E0C3537826145, 0xA7709A56CCDF8A82, // 5^208
+			0x9BBCC7A142B17CCB, 0x88A66076400BB691, // 5^209
+			0xC2ABF989935DDBFE, 0x6ACFF893D00EA435, // 5^210
+			0xF356F7EBF83552FE, 0x0583F6B8C4124D43, // 5^211
+			0x98165AF37B2153DE, 0xC3727A337A8B704A, // 5^212
+			0xBE1BF1B059E9A8D6, 0x744F18C0592E4C5C, // 5^213
+			0xEDA2EE1C7064130C, 0x1162DEF06F79DF73, // 5^214
+			0x9485D4D1C63E8BE7, 0x8ADDCB5645AC2BA8, // 5^215
+			0xB9A74A0637CE2EE1, 0x6D953E2BD7173692, // 5^216
+			0xE8111C87C5C1BA99, 0xC8FA8DB6CCDD0437, // 5^217
+			0x910AB1D4DB9914A0, 0x1D9C9892400A22A2, // 5^218
+			0xB54D5E4A127F59C8, 0x2503BEB6D00CAB4B, // 5^219
+			0xE2A0B5DC971F303A, 0x2E44AE64840FD61D, // 5^220
+			0x8DA471A9DE737E24, 0x5CEAECFED289E5D2, // 5^221
+			0xB10D8E1456105DAD, 0x7425A83E872C5F47, // 5^222
+			0xDD50F1996B947518, 0xD12F124E28F77719, // 5^223
+			0x8A5296FFE33CC92F, 0x82BD6B70D99AAA6F, // 5^224
+			0xACE73CBFDC0BFB7B, 0x636CC64D1001550B, // 5^225
+			0xD8210BEFD30EFA5A, 0x3C47F7E05401AA4E, // 5^226
+			0x8714A775E3E95C78, 0x65ACFAEC34810A71, // 5^227
+			0xA8D9D1535CE3B396, 0x7F1839A741A14D0D, // 5^228
+			0xD31045A8341CA07C, 0x1EDE48111209A050, // 5^229
+			0x83EA2B892091E44D, 0x934AED0AAB460432, // 5^230
+			0xA4E4B66B68B65D60, 0xF81DA84D5617853F, // 5^231
+			0xCE1DE40642E3F4B9, 0x36251260AB9D668E, // 5^232
+			0x80D2AE83E9CE78F3, 0xC1D72B7C6B426019, // 5^233
+			0xA1075A24E4421730, 0xB24CF65B8612F81F, // 5^234
+			0xC94930AE1D529CFC, 0xDEE033F26797B627, // 5^235
+			0xFB9B7CD9A4A7443C, 0x169840EF017DA3B1, // 5^236
+			0x9D412E0806E88AA5, 0x8E1F289560EE864E, // 5^237
+			0xC491798A08A2AD4E, 0xF1A6F2BAB92A27E2, // 5^238
+			0xF5B5D7EC8ACB58A2, 0xAE10AF696774B1DB, // 5^239
+			0x9991A6F3D6BF1765, 0xACCA6DA1E0A8EF29, // 5^240
+			0xBFF610B0CC6EDD3F, 0x17FD090A58D32AF3, // 5^241
+			0xEFF394DCFF8A948E, 0xDDFC4B4CEF07F5B0, // 5^242
+			0x95F83D0A1FB69CD9, 0x4ABDAF101564F98E, // 5^243
+			0xBB764C4CA7A4440F, 0x9D6D1AD41ABE37F1, // 5^244
+			0xEA53DF5FD18D5513, 0x84C86189216DC5ED, // 5^245
+			0x92746B9BE2F8552C, 0x32FD3CF5B4E49BB4, // 5^246
+			0xB7118682DBB66A77, 0x3FBC8C33221DC2A1, // 5^247
+			0xE4D5E82392A40515, 0x0FABAF3FEAA5334A, // 5^248
+			0x8F05B1163BA6832D, 0x29CB4D87F2A7400E, // 5^249
+			0xB2C71D5BCA9023F8, 0x743E20E9EF511012, // 5^250
+			0xDF78E4B2BD342CF6, 0x914DA9246B255416, // 5^251
+			0x8BAB8EEFB6409C1A, 0x1AD089B6C2F7548E, // 5^252
+			0xAE9672ABA3D0C320, 0xA184AC2473B529B1, // 5^253
+			0xDA3C0F568CC4F3E8, 0xC9E5D72D90A2741E, // 5^254
+			0x8865899617FB1871, 0x7E2FA67C7A658892, // 5^255
+			0xAA7EEBFB9DF9DE8D, 0xDDBB901B98FEEAB7, // 5^256
+			0xD51EA6FA85785631, 0x552A74227F3EA565, // 5^257
+			0x8533285C936B35DE, 0xD53A88958F87275F, // 5^258
+			0xA67FF273B8460356, 0x8A892ABAF368F137, // 5^259
+			0xD01FEF10A657842C, 0x2D2B7569B0432D85, // 5^260
+			0x8213F56A67F6B29B, 0x9C3B29620E29FC73, // 5^261
+			0xA298F2C501F45F42, 0x8349F3BA91B47B8F, // 5^262
+			0xCB3F2F7642717713, 0x241C70A936219A73, // 5^263
+			0xFE0EFB53D30DD4D7, 0xED238CD383AA0110, // 5^264
+			0x9EC95D1463E8A506, 0xF4363804324A40AA, // 5^265
+			0xC67BB4597CE2CE48, 0xB143C6053EDCD0D5, // 5^266
+			0xF81AA16FDC1B81DA, 0xDD94B7868E94050A, // 5^267
+			0x9B10A4E5E9913128, 0xCA7CF2B4191C8326, // 5^268
+			0xC1D4CE1F63F57D72, 0xFD1C2F611F63A3F0, // 5^269
+			0xF24A01A73CF2DCCF, 0xBC633B39673C8CEC, // 5^270
+			0x976E41088617CA01, 0xD5BE0503E085D813, // 5^271
+			0xBD49D14AA79DBC82, 0x4B2D8644D8A74E18, // 5^272
+			0xEC9C459D51852BA2, 0xDDF8E7D60ED1219E, // 5^273
+			0x93E1AB8252F33B45, 0xCABB90E5C942B503, // 5^274
+			0xB8DA1662E7B00A17, 0x3D6A751F3B936243, // 5^275
+			0xE7109BFBA19C0C9D, 0x0CC512670A783AD4, // 5^276
+			0x906A617D450187E2, 0x27FB2B80668B24C5, // 5^277
+			0xB484F9DC9641E9DA, 0xB1F9F660802DEDF6, // 5^278
+			0xE1A63853BBD26451, 0x5E7873F8A0396973, // 5^279
+			0x8D07E33455637EB2, 0xDB0B487B6423E1E8, // 5^280
+			0xB049DC016ABC5E5F, 0x91CE1A9A3D2CDA62, // 5^281
+			0xDC5C5301C56B75F7, 0x7641A140CC7810FB, // 5^282
+			0x89B9B3E11B6329BA, 0xA9E904C87FCB0A9D, // 5^283
+			0xAC2820D9623BF429, 0x546345FA9FBDCD44, // 5^284
+			0xD732290FBACAF133, 0xA97C177947AD4095, // 5^285
+			0x867F59A9D4BED6C0, 0x49ED8EABCCCC485D, // 5^286
+			0xA81F301449EE8C70, 0x5C68F256BFFF5A74, // 5^287
+			0xD226FC195C6A2F8C, 0x73832EEC6FFF3111, // 5^288
+			0x83585D8FD9C25DB7, 0xC831FD53C5FF7EAB, // 5^289
+			0xA42E74F3D032F525, 0xBA3E7CA8B77F5E55, // 5^290
+			0xCD3A1230C43FB26F, 0x28CE1BD2E55F35EB, // 5^291
+			0x80444B5E7AA7CF85, 0x7980D163CF5B81B3, // 5^292
+			0xA0555E361951C366, 0xD7E105BCC332621F, // 5^293
+			0xC86AB5C39FA63440, 0x8DD9472BF3FEFAA7, // 5^294
+			0xFA856334878FC150, 0xB14F98F6F0FEB951, // 5^295
+			0x9C935E00D4B9D8D2, 0x6ED1BF9A569F33D3, // 5^296
+			0xC3B8358109E84F07, 0x0A862F80EC4700C8, // 5^297
+			0xF4A642E14C6262C8, 0xCD27BB612758C0FA, // 5^298
+			0x98E7E9CCCFBD7DBD, 0x8038D51CB897789C, // 5^299
+			0xBF21E44003ACDD2C, 0xE0470A63E6BD56C3, // 5^300
+			0xEEEA5D5004981478, 0x1858CCFCE06CAC74, // 5^301
+			0x95527A5202DF0CCB, 0x0F37801E0C43EBC8, // 5^302
+			0xBAA718E68396CFFD, 0xD30560258F54E6BA, // 5^303
+			0xE950DF20247C83FD, 0x47C6B82EF32A2069, // 5^304
+			0x91D28B7416CDD27E, 0x4CDC331D57FA5441, // 5^305
+			0xB6472E511C81471D, 0xE0133FE4ADF8E952, // 5^306
+			0xE3D8F9E563A198E5, 0x58180FDDD97723A6, // 5^307
+			0x8E679C2F5E44FF8F, 0x570F09EAA7EA7648, // 5^308
+		};
+	};
+
+	// the Eisel-Lemire algorithm (https://arxiv.org/abs/2101.11408), as refined in fast_float
+	// (https://github.com/fastfloat/fast_float): finds the double nearest to w * 10^q using one (occasionally two)
+	// 64x64->128 bit multiplications. the result is exact as long as w is.
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	binary_float eisel_lemire(int64_t q, uint64_t w) noexcept
+	{
+		constexpr int64_t min_exponent = -1023;
+
+		if (!w || q < powers_of_five::smallest)
+			return { 0u, 0 };
+		if (q > powers_of_five::largest)
+			return { 0u, binary_float::infinite_power };
+
+		const int lz = leading_zeroes(w);
+		w <<= lz;
+
+		// only the top mantissa_bits + 3 bits of the product need to be right; the low half of the power of five
+		// is only needed when they might be affected by it
+		constexpr auto precision_mask = ~uint64_t{} >> (binary_float::mantissa_bits + 3);
+		const auto index			  = static_cast<size_t>(q - powers_of_five::smallest) * 2u;
+		auto product				  = multiply_full(w, powers_of_five::values[index]);
+		if ((product.high & precision_mask) == precision_mask)
+		{
+			const auto second = multiply_full(w, powers_of_five::values[index + 1u]);
+			product.low += second.high;
+			if (second.high > product.low)
+				product.high++;
+		}
+
+		const auto upper_bit = static_cast<int>(product.high >> 63);
+		const auto shift	 = upper_bit + 64 - binary_float::mantissa_bits - 3;
+
+		// (152170 + 65536) / 2^16 approximates log2(10) closely enough over the range of q
+		binary_float result;
+		result.mantissa = product.high >> shift;
+		result.power2 =
+			static_cast<int32_t>(((((152170 + 65536) * q) >> 16) + 63) + upper_bit - lz - min_exponent);
 
+		// subnormals
+		if (result.power2 <= 0)
+		{
+			if (-result.power2 + 1 >= 64)
+				return { 0u, 0 };
+
+			result.mantissa >>= -result.power2 + 1;
+			result.mantissa += (result.mantissa & 1u);
+			result.mantissa >>= 1;
+			result.power2 = result.mantissa < (uint64_t{ 1 } << binary_float::mantissa_bits) ? 0 : 1;
+			return result;
+		}
+
+		// values exactly halfway between two doubles (only possible for small q) round to even, rather than up
+		if (product.low <= 1u && q >= -4 && q <= 23 && (result.mantissa & 3u) == 1u
+			&& (result.mantissa << shift) == product.high)
+			result.mantissa &= ~uint64_t{ 1 };
+
+		result.mantissa += (result.mantissa & 1u);
+		result.mantissa >>= 1;
+		if (result.mantissa >= (uint64_t{ 2 } << binary_float::mantissa_bits))
+		{
+			result.mantissa = uint64_t{ 1 } << binary_float::mantissa_bits;
+			result.power2++;
+		}
+		result.mantissa &= ~(uint64_t{ 1 } << binary_float::mantissa_bits);
+
+		if (result.power2 >= binary_float::infinite_power)
+			return { 0u, binary_float::infinite_power };
+		return result;
+	}
+
+	// just enough of an arbitrary-precision unsigned integer to compare a decimal value with a binary one exactly.
+	// the capacity covers the largest values round_to_nearest() works with.
+	class big_integer
+	{
 	  private:
-		static constexpr size_t history_buffer_size = max_history_length - 1; //'head' is stored in the reader
-		utf8_reader_interface& reader_;
-		struct
+		static constexpr size_t capacity = 100;
+
+		uint32_t limbs_[capacity];
+		size_t size_ = {};
+
+		void push_back(uint32_t limb) noexcept
 		{
-			utf8_codepoint buffer[history_buffer_size];
-			size_t count, first;
-		} history_					= {};
-		const utf8_codepoint* head_ = {};
-		size_t negative_offset_		= {};
+			TOML_ASSERT_ASSUME(size_ < capacity);
+			limbs_[size_++] = limb;
+		}
 
 	  public:
 		TOML_NODISCARD_CTOR
-		explicit utf8_buffered_reader(utf8_reader_interface& reader) noexcept //
-			: reader_{ reader }
-		{}
+		explicit big_integer(uint64_t value = 0u) noexcept
+		{
+			for (; value; value >>= 32)
+				push_back(static_cast<uint32_t>(value));
+		}
 
-		TOML_PURE_INLINE_GETTER
-		const source_path_ptr& source_path() const noexcept
+		void multiply_add(uint32_t multiplier, uint32_t addend) noexcept
 		{
-			return reader_.source_path();
+			uint64_t carry = addend;
+			for (size_t i = 0; i < size_; i++)
+			{
+				const auto val = static_cast<uint64_t>(limbs_[i]) * multiplier + carry;
+				limbs_[i]	   = static_cast<uint32_t>(val);
+				carry		   = val >> 32;
+			}
+			if (carry)
+				push_back(static_cast<uint32_t>(carry));
+		}
+
+		void multiply_pow5(uint64_t exponent) noexcept
+		{
+			static constexpr uint32_t small_powers[] = { 1u,		5u,		   25u,		   125u,	  625u,
+														 3125u,		15625u,	   78125u,	   390625u,	  1953125u,
+														 9765625u, 48828125u, 244140625u, 1220703125u };
+
+			for (; exponent >= 13u; exponent -= 13u)
+				multiply_add(small_powers[13], 0u);
+			if (exponent)
+				multiply_add(small_powers[exponent], 0u);
+		}
+
+		void shift_left(uint64_t bits) noexcept
+		{
+			if (!size_ || !bits)
+				return;
+
+			const auto limb_shift = static_cast<size_t>(bits / 32u);
+			const auto bit_shift  = static_cast<unsigned>(bits % 32u);
+
+			if (bit_shift)
+			{
+				uint32_t carry = {};
+				for (size_t i = 0; i < size_; i++)
+				{
+					const auto limb = limbs_[i];
+					limbs_[i]		= (limb << bit_shift) | carry;
+					carry			= limb >> (32u - bit_shift);
+				}
+				if (carry)
+					push_back(carry);
+			}
+
+			if (limb_shift)
+			{
+				TOML_ASSERT_ASSUME(size_ + limb_shift <= capacity);
+				std::memmove(limbs_ + limb_shift, limbs_, size_ * sizeof(uint32_t));
+				std::memset(limbs_, 0, limb_shift * sizeof(uint32_t));
+				size_ += limb_shift;
+			}
+		}
+
+		TOML_PURE_GETTER
+		friend int compare(const big_integer& lhs, const big_integer& rhs) noexcept
+		{
+			if (lhs.size_ != rhs.size_)
+				return lhs.size_ < rhs.size_ ? -1 : 1;
+
+			for (size_t i = lhs.size_; i-- > 0u;)
+				if (lhs.limbs_[i] != rhs.limbs_[i])
+					return lhs.limbs_[i] < rhs.limbs_[i] ? -1 : 1;
+
+			return 0;
+		}
+	};
+
+	// calls func(digit, fractional) for each significant digit of a decimal value (i.e. skipping leading zeroes),
+	// which returns how much that digit changes the power of ten the digits it kept need to be scaled by.
+	// returns the final power of ten (the explicit exponent included).
+	template <typename Func>
+	TOML_INTERNAL_LINKAGE
+	int64_t for_each_significant_digit(std::string_view text, Func&& func) noexcept
+	{
+		const char* p		  = text.data();
+		const char* const end = p + text.length();
+		bool seen_nonzero	  = false;
+		int64_t exponent	  = {};
+
+		for (bool fractional = false; p < end; p++)
+		{
+			if (*p == '.')
+			{
+				fractional = true;
+				continue;
+			}
+			if (*p == 'e' || *p == 'E')
+				break;
+
+			const auto digit = static_cast<uint32_t>(*p - '0');
+			if (!digit && !seen_nonzero)
+			{
+				exponent -= fractional ? 1 : 0;
+				continue;
+			}
+			seen_nonzero = true;
+			exponent += func(digit, fractional);
+		}
+
+		// explicit exponent (clamped well past the point where the value is zero or infinite either way)
+		if (p < end)
+		{
+			p++;
+			bool negative = false;
+			if (p < end && (*p == '+' || *p == '-'))
+				negative = *p++ == '-';
+
+			int64_t explicit_exponent = {};
+			for (; p < end; p++)
+				explicit_exponent = impl::min(explicit_exponent * 10 + (*p - '0'), int64_t{ 1000000 });
+			exponent += negative ? -explicit_exponent : explicit_exponent;
+		}
+
+		return exponent;
+	}
+
+	// values with more significant digits than eisel_lemire() can take are somewhere between two adjacent doubles;
+	// this works out which is nearest by comparing the value exactly with the point halfway between them.
+	// (slow, but only needed for values within a hair of that halfway point)
+	TOML_NEVER_INLINE
+	TOML_INTERNAL_LINKAGE
+	binary_float round_to_nearest(std::string_view text, binary_float lower) noexcept
+	{
+		// halfway points never need more than 767 significant digits to be represented exactly,
+		// so anything after that only matters if it isn't all zeroes
+		constexpr size_t max_digits = 768;
+
+		big_integer digits;
+		size_t digit_count = {};
+		bool nonzero_tail  = false;
+		int64_t exponent   = for_each_significant_digit(text,
+													[&](uint32_t digit, bool fractional) noexcept -> int64_t
+													{
+														if (digit_count < max_digits)
+														{
+															digits.multiply_add(10u, digit);
+															digit_count++;
+															return fractional ? -1 : 0;
+														}
+														nonzero_tail = nonzero_tail || digit;
+														return fractional ? 0 : 1;
+													});
+		if (nonzero_tail)
+		{
+			digits.multiply_add(10u, 1u);
+			exponent--;
+		}
+
+		// halfway = (2m + 1) * 2^(e - 1)
+		uint64_t m		   = lower.mantissa;
+		int64_t binary_exp = -1074;
+		if (lower.power2)
+		{
+			m |= uint64_t{ 1 } << binary_float::mantissa_bits;
+			binary_exp = lower.power2 - 1075;
+		}
+		big_integer halfway{ 2u * m + 1u };
+		binary_exp--;
+
+		// digits * 10^exponent = digits * 5^exponent * 2^exponent
+		if (exponent >= 0)
+			digits.multiply_pow5(static_cast<uint64_t>(exponent));
+		else
+			halfway.multiply_pow5(static_cast<uint64_t>(-exponent));
+		if (exponent > binary_exp)
+			digits.shift_left(static_cast<uint64_t>(exponent - binary_exp));
+		else
+			halfway.shift_left(static_cast<uint64_t>(binary_exp - exponent));
+
+		const auto cmp = compare(digits, halfway);
+		if (cmp > 0 || (cmp == 0 && (m & 1u)))
+			return binary_float::from_bits(lower.bits() + 1u);
+		return lower;
+	}
+
+	// rounds (mantissa + a little more, if 'sticky') * 2^exponent to the nearest double.
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	binary_float round_binary(uint64_t mantissa, int64_t exponent, bool sticky) noexcept
+	{
+		if (!mantissa)
+			return { 0u, 0 };
+
+		const auto lz = leading_zeroes(mantissa);
+		mantissa <<= lz;
+		exponent -= lz;
+
+		// the value is now 1.xxx * 2^e
+		const auto e = exponent + 63;
+		if (e > 1023)
+			return { 0u, binary_float::infinite_power };
+
+		// normal values keep the top 53 bits, subnormals fewer
+		const auto drop = e >= -1022 ? int64_t{ 11 } : 11 - 1022 - e;
+		uint64_t kept	= drop < 64 ? mantissa >> drop : 0u;
+		if (drop <= 64)
+		{
+			const auto half = uint64_t{ 1 } << (drop - 1);
+			const auto rest = drop < 64 ? mantissa & ((uint64_t{ 1 } << drop) - 1u) : mantissa;
+			if (rest > half || (rest == half && (sticky || (kept & 1u))))
+				kept++;
+		}
+
+		// normal values trade their implicit bit for the exponent (which rounding up may carry into);
+		// subnormals don't have one (and rounding up to it gives the smallest normal value)
+		const auto bits = e >= -1022 ? (static_cast<uint64_t>(e + 1022) << binary_float::mantissa_bits) + kept : kept;
+		if ((bits >> binary_float::mantissa_bits) >= static_cast<uint64_t>(binary_float::infinite_power))
+			return { 0u, binary_float::infinite_power };
+		return binary_float::from_bits(bits);
+	}
+}
+TOML_ANON_NAMESPACE_END;
+
+TOML_IMPL_NAMESPACE_START
+{
+	TOML_EXTERNAL_LINKAGE
+	bool decimal_to_double(std::string_view text, double& value) noexcept
+	{
+		// the first 19 significant digits (as many as are guaranteed to fit in 64 bits)
+		uint64_t w		   = {};
+		size_t digit_count = {};
+		bool truncated	   = false;
+		const auto q	   = TOML_ANON_NAMESPACE::for_each_significant_digit(
+			  text,
+			  [&](uint32_t digit, bool fractional) noexcept -> int64_t
+			  {
+				  if (digit_count < 19u)
+				  {
+					  w = w * 10u + digit;
+					  digit_count++;
+					  return fractional ? -1 : 0;
+				  }
+				  truncated = truncated || digit;
+				  return fractional ? 0 : 1;
+			  });
+
+		if (!w)
+		{
+			value = 0.0;
+			return true;
+		}
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+
+		// w and 10^q are both exactly representable so a single multiplication or division is correctly rounded.
+		// (only when doubles are evaluated as doubles; with x87 extended precision the result would be rounded twice)
+		if (!truncated && q >= -22 && q <= 22 && w <= (uint64_t{ 1 } << 53))
+		{
+			static constexpr double powers_of_ten[] = { 1e0,  1e1,	1e2,  1e3,	1e4,  1e5,	1e6,  1e7,
+														1e8,  1e9,	1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+														1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+			value = static_cast<double>(w);
+			if (q < 0)
+				value /= powers_of_ten[-q];
+			else
+				value *= powers_of_ten[q];
+			return true;
 		}
 
-		TOML_NODISCARD
-		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
-		{
-			utf8_buffered_reader_error_check({});
+#endif
+
+		auto result = TOML_ANON_NAMESPACE::eisel_lemire(q, w);
+
+		// w was rounded down; if rounding it up instead gives a different answer then the digits that were dropped
+		// matter, and it takes a closer look to work out which answer is right
+		if (truncated && result != TOML_ANON_NAMESPACE::eisel_lemire(q, w + 1u))
+			result = TOML_ANON_NAMESPACE::round_to_nearest(text, result);
+
+		if (result.power2 == TOML_ANON_NAMESPACE::binary_float::infinite_power)
+			return false;
+
+		value = result.to_double();
+		return true;
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	bool hex_to_double(std::string_view whole, std::string_view fraction, int64_t exponent, double& value) noexcept
+	{
+		// the first 16 significant digits (as many as fit in 64 bits); the rest only matter for rounding
+		uint64_t mantissa  = {};
+		size_t digit_count = {};
+		bool sticky		   = false;
+		const auto consume = [&](char c, bool fractional) noexcept
+		{
+			const auto digit = static_cast<uint64_t>(hex_to_dec(c));
+			if (!digit && !digit_count)
+			{
+				exponent -= fractional ? 4 : 0;
+				return;
+			}
+
+			if (digit_count < 16u)
+			{
+				mantissa = (mantissa << 4) | digit;
+				digit_count++;
+				exponent -= fractional ? 4 : 0;
+			}
+			else
+			{
+				sticky = sticky || digit;
+				exponent += fractional ? 0 : 4;
+			}
+		};
+		for (auto c : whole)
+			consume(c, false);
+		for (auto c : fraction)
+			consume(c, true);
+
+		const auto result = TOML_ANON_NAMESPACE::round_binary(mantissa, exponent, sticky);
+		if (result.power2 == TOML_ANON_NAMESPACE::binary_float::infinite_power)
+			return false;
+
+		value = result.to_double();
+		return true;
+	}
+}
+TOML_IMPL_NAMESPACE_END;
+
+#ifdef _MSC_VER
+#pragma pop_macro("min")
+#pragma pop_macro("max")
+#ifndef __clang__
+#pragma inline_recursion(off)
+#endif
+#endif
+TOML_POP_WARNINGS;
+
+#endif // TOML_ENABLE_PARSER
+
+//********  impl/parser.inl  *******************************************************************************************
+
+#if TOML_ENABLE_PARSER
+
+TOML_DISABLE_WARNINGS;
+#include <istream>
+#include <fstream>
+#if TOML_INT_CHARCONV || TOML_FLOAT_CHARCONV
+#include <charconv>
+#endif
+#if !TOML_INT_CHARCONV || !TOML_FLOAT_CHARCONV
+#include <sstream>
+#endif
+#if !TOML_INT_CHARCONV
+#include <iomanip>
+#endif
+#if !TOML_WINDOWS && (TOML_UNIX || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+TOML_ENABLE_WARNINGS;
+#if TOML_WINDOWS && !defined(_WINDOWS_)
+#if TOML_INCLUDE_WINDOWS_H
+#include <Windows.h>
+#else
+
+struct _SECURITY_ATTRIBUTES;
+
+extern "C" __declspec(dllimport) void* __stdcall CreateFileW(const wchar_t* lpFileName,
+															 unsigned long dwDesiredAccess,
+															 unsigned long dwShareMode,
+															 _SECURITY_ATTRIBUTES* lpSecurityAttributes,
+															 unsigned long dwCreationDisposition,
+															 unsigned long dwFlagsAndAttributes,
+															 void* hTemplateFile);
+
+extern "C" __declspec(dllimport) unsigned long __stdcall GetFileType(void* hFile);
+
+extern "C" __declspec(dllimport) unsigned long __stdcall GetFileSize(void* hFile, unsigned long* lpFileSizeHigh);
+
+extern "C" __declspec(dllimport) void* __stdcall CreateFileMappingW(void* hFile,
+																	_SECURITY_ATTRIBUTES* lpFileMappingAttributes,
+																	unsigned long flProtect,
+																	unsigned long dwMaximumSizeHigh,
+																	unsigned long dwMaximumSizeLow,
+																	const wchar_t* lpName);
+
+#ifdef _WIN64
+extern "C" __declspec(dllimport) void* __stdcall MapViewOfFile(void* hFileMappingObject,
+															   unsigned long dwDesiredAccess,
+															   unsigned long dwFileOffsetHigh,
+															   unsigned long dwFileOffsetLow,
+															   unsigned long long dwNumberOfBytesToMap);
+#else
+extern "C" __declspec(dllimport) void* __stdcall MapViewOfFile(void* hFileMappingObject,
+															   unsigned long dwDesiredAccess,
+															   unsigned long dwFileOffsetHigh,
+															   unsigned long dwFileOffsetLow,
+															   unsigned long dwNumberOfBytesToMap);
+#endif
+
+extern "C" __declspec(dllimport) int __stdcall UnmapViewOfFile(const void* lpBaseAddress);
+
+extern "C" __declspec(dllimport) int __stdcall CloseHandle(void* hObject);
+
+#endif // TOML_INCLUDE_WINDOWS_H
+#endif // TOML_WINDOWS && !_WINDOWS_
+
+TOML_PUSH_WARNINGS;
+#ifdef _MSC_VER
+#ifndef __clang__
+#pragma inline_recursion(on)
+#endif
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+#endif
+
+TOML_IMPL_NAMESPACE_START
+{
+	// the raw bytes read from a stream before they're decoded. kept in the parse_scratch when there's a
+	// toml::parse_context so each document parsed with it doesn't allocate a fresh chunk.
+	struct stream_chunk_buffer
+	{
+		std::unique_ptr<char[]> bytes;
+		size_t capacity = {};
+
+		char* reserve(size_t size)
+		{
+			if (capacity < size)
+			{
+				bytes.reset();
+				capacity = {};
+				bytes.reset(new char[size]);
+				capacity = size;
+			}
+			return bytes.get();
+		}
+	};
+}
+TOML_IMPL_NAMESPACE_END;
+
+TOML_ANON_NAMESPACE_START
+{
+	template <typename T>
+	class utf8_byte_stream;
+
+	TOML_INTERNAL_LINKAGE
+	constexpr auto utf8_byte_order_mark = "\xEF\xBB\xBF"sv;
+
+	template <>
+	class utf8_byte_stream<std::istream>
+	{
+	  private:
+		std::istream* source_;
+
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit utf8_byte_stream(std::istream& stream) noexcept //
+			: source_{ &stream }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		size_t chunk_size() const noexcept
+		{
+			return byte_source::default_chunk_size;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool error() const noexcept
+		{
+			return !!(source_->rdstate() & std::istream::badbit);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool eof() const noexcept
+		{
+			return !!(source_->rdstate() & std::istream::eofbit);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		explicit operator bool() const noexcept
+		{
+			return !(source_->rdstate() & (std::istream::badbit | std::istream::eofbit));
+		}
+
+		TOML_NODISCARD
+		TOML_ATTR(nonnull)
+		size_t operator()(char* dest, size_t num) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			TOML_ASSERT(*this);
+
+			source_->read(dest, static_cast<std::streamsize>(num));
+			return static_cast<size_t>(source_->gcount());
+		}
+	};
+
+	template <>
+	class utf8_byte_stream<byte_source>
+	{
+	  private:
+		byte_source source_;
+		bool eof_	= false;
+		bool error_ = false;
+
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit utf8_byte_stream(byte_source source) noexcept //
+			: source_{ source }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		size_t chunk_size() const noexcept
+		{
+			return source_.chunk_size();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool error() const noexcept
+		{
+			return error_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool eof() const noexcept
+		{
+			return eof_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		explicit operator bool() const noexcept
+		{
+			return !eof_ && !error_;
+		}
+
+		TOML_NODISCARD
+		TOML_ATTR(nonnull)
+		size_t operator()(char* dest, size_t num)
+		{
+			TOML_ASSERT(*this);
+
+			const auto read = source_(dest, num);
+			if TOML_UNLIKELY(read == byte_source::read_error)
+			{
+				error_ = true;
+				return {};
+			}
+			TOML_ASSERT(read <= num);
+
+			eof_ = !read;
+			return read;
+		}
+	};
+
+	struct utf8_codepoint
+	{
+		char32_t value;
+		char bytes[4];
+		size_t count;
+		source_position position;
+
+		TOML_PURE_INLINE_GETTER
+		constexpr operator const char32_t&() const noexcept
+		{
+			return value;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		constexpr const char32_t& operator*() const noexcept
+		{
+			return value;
+		}
+	};
+	static_assert(std::is_trivially_copyable_v<utf8_codepoint>);
+	static_assert(std::is_standard_layout_v<utf8_codepoint>);
+
+	// utf8_reader<T> specializations all provide the same interface:
+	//
+	//	const source_path_ptr& source_path() const noexcept;
+	//	const utf8_codepoint* read_next();
+	//	bool peek_eof();
+	//	source_index end_offset() const noexcept;
+	//	optional<parse_error>&& error() noexcept; // noexcept mode only
+	//
+	// the parser is templated on the concrete reader type so reading each codepoint can be inlined.
+
+#if TOML_EXCEPTIONS
+#define utf8_reader_error(...)				throw parse_error(__VA_ARGS__)
+#define utf8_reader_return_after_error(...) static_assert(true)
+#define utf8_reader_error_check(...)		static_assert(true)
+#else
+#define utf8_reader_error(...)				err_.emplace(__VA_ARGS__)
+#define utf8_reader_return_after_error(...) return __VA_ARGS__
+#define utf8_reader_error_check(...)                                                                                   \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if TOML_UNLIKELY(err_)                                                                                         \
+			return __VA_ARGS__;                                                                                        \
+	}                                                                                                                  \
+	while (false)
+
+#endif
+
+#if defined(__APPLE__) || defined(__MINGW32__) || defined(__MINGW64__)
+#define TOML_OVERALIGNED
+#else
+#define TOML_OVERALIGNED alignas(32)
+#endif
+
+	// reader for documents that arrive in pieces (streams, byte sources).
+	// raw bytes are read from the source in large chunks, then decoded into blocks of codepoints.
+	template <typename T>
+	class utf8_reader
+	{
+	  private:
+		static constexpr size_t block_capacity = 32;
+		utf8_byte_stream<T> stream_;
+		source_position next_pos_ = { 1, 1 };
+		source_position last_pos_ = { 1, 1 }; // position of the most recently decoded codepoint
+
+		impl::stream_chunk_buffer own_buffer_;
+		impl::stream_chunk_buffer* borrowed_buffer_ = {};
+
+		struct chunk_t
+		{
+			char* bytes;
+			size_t capacity;
+			size_t pos;
+			size_t count;
+			bool first;
+		} chunk_;
+
+		impl::utf8_decoder decoder_;
+		struct currently_decoding_t
+		{
+			char bytes[4];
+			size_t count;
+		} currently_decoding_;
+
+		struct codepoints_t
+		{
+			TOML_OVERALIGNED utf8_codepoint buffer[block_capacity];
+			size_t current;
+			size_t count;
+		} codepoints_;
+
+		source_path_ptr source_path_;
+
+#if !TOML_EXCEPTIONS
+		optional<parse_error> err_;
+#endif
+
+		size_t read_from_stream(char* dest, size_t num) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			if constexpr (noexcept(stream_(dest, num)) || !TOML_EXCEPTIONS)
+			{
+				return stream_(dest, num);
+			}
+#if TOML_EXCEPTIONS
+			else
+			{
+				try
+				{
+					return stream_(dest, num);
+				}
+				catch (const std::exception& exc)
+				{
+					throw parse_error{ exc.what(), next_pos_, source_path_ };
+				}
+				catch (...)
+				{
+					throw parse_error{ "An unspecified error occurred", next_pos_, source_path_ };
+				}
+			}
+#endif // TOML_EXCEPTIONS
+		}
+
+		bool read_next_chunk() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			TOML_ASSERT(chunk_.pos == chunk_.count);
+
+			if (!stream_)
+				return false;
+
+			if (!chunk_.bytes)
+				chunk_.bytes = (borrowed_buffer_ ? *borrowed_buffer_ : own_buffer_).reserve(chunk_.capacity);
+
+			chunk_.pos	 = {};
+			chunk_.count = read_from_stream(chunk_.bytes, chunk_.capacity);
+
+			// skip the BOM
+			// (sources are allowed to hand it over in pieces)
+			if (chunk_.first)
+			{
+				chunk_.first = false;
+				while (chunk_.count && chunk_.count < 3u && stream_
+					   && memcmp(utf8_byte_order_mark.data(), chunk_.bytes, chunk_.count) == 0)
+					chunk_.count += read_from_stream(chunk_.bytes + chunk_.count, chunk_.capacity - chunk_.count);
+
+				if (chunk_.count >= 3u && memcmp(utf8_byte_order_mark.data(), chunk_.bytes, 3u) == 0)
+				{
+					chunk_.pos		 = 3u;
+					next_pos_.offset = 3u;
+					if (chunk_.pos == chunk_.count)
+						return read_next_chunk();
+				}
+			}
+
+			// handle a zero-byte read
+			if TOML_UNLIKELY(chunk_.pos == chunk_.count)
+			{
+				if (stream_.eof())
+				{
+					// EOF only sets the error state if the decoder wants more input, otherwise
+					// a zero-byte read might have just caused the underlying stream to realize it's exhaused and set
+					// the EOF flag, and that's totally fine
+					if (decoder_.needs_more_input())
+						utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
+										  last_pos_,
+										  source_path_);
+				}
+				else if (stream_.error())
+				{
+					utf8_reader_error("An I/O error occurred while reading from the underlying stream",
+									  next_pos_,
+									  source_path_);
+				}
+				else
+				{
+					utf8_reader_error("Reading from the underlying stream failed - zero bytes read",
+									  next_pos_,
+									  source_path_);
+				}
+				return false;
+			}
+
+			return true;
+		}
+
+		bool read_next_block() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			// read the next raw (encoded) block in from the current chunk
+			if (chunk_.pos == chunk_.count && !read_next_chunk())
+				return false;
+
+			const char* const raw_bytes = chunk_.bytes + chunk_.pos;
+			const size_t raw_bytes_read = impl::min(chunk_.count - chunk_.pos, block_capacity);
+			chunk_.pos += raw_bytes_read;
+
+			TOML_ASSERT_ASSUME(raw_bytes_read);
+			std::memset(static_cast<void*>(&codepoints_), 0, sizeof(codepoints_));
+
+			// helper for calculating decoded codepoint line+cols (and offsets)
+			// (the text is gone once it's decoded, so unlike the contiguous reader these can't be worked out later)
+			const auto calc_positions = [&]() noexcept
+			{
+				for (size_t i = 0; i < codepoints_.count; i++)
+				{
+					auto& cp	= codepoints_.buffer[i];
+					cp.position = next_pos_;
+					next_pos_.offset += static_cast<source_index>(cp.count);
+
+					if (cp == U'\n')
+					{
+						next_pos_.line++;
+						next_pos_.column = source_index{ 1 };
+					}
+					else
+						next_pos_.column++;
+				}
+			};
+
+			// decide whether we need to use the UTF-8 decoder or if we can treat this block as plain ASCII
+			const auto ascii_fast_path = !decoder_.needs_more_input() && impl::is_ascii(raw_bytes, raw_bytes_read);
+
+			// ASCII fast-path
+			if (ascii_fast_path)
+			{
+				decoder_.reset();
+				currently_decoding_.count = {};
+
+				codepoints_.count = raw_bytes_read;
+				for (size_t i = 0; i < codepoints_.count; i++)
+				{
+					auto& cp	= codepoints_.buffer[i];
+					cp.value	= static_cast<char32_t>(raw_bytes[i]);
+					cp.bytes[0] = raw_bytes[i];
+					cp.count	= 1u;
+				}
+			}
+
+			// UTF-8 slow-path
+			else
+			{
+				// helper for getting precise error location
+				const auto error_pos = [&]() noexcept -> const source_position&
+				{ //
+					return codepoints_.count ? codepoints_.buffer[codepoints_.count - 1u].position : last_pos_;
+				};
+
+				for (size_t i = 0; i < raw_bytes_read; i++)
+				{
+					decoder_(static_cast<uint8_t>(raw_bytes[i]));
+					if TOML_UNLIKELY(decoder_.error())
+					{
+						calc_positions();
+						utf8_reader_error("Encountered invalid utf-8 sequence", error_pos(), source_path_);
+						utf8_reader_return_after_error(false);
+					}
+
+					currently_decoding_.bytes[currently_decoding_.count++] = raw_bytes[i];
+
+					if (decoder_.has_code_point())
+					{
+						auto& cp = codepoints_.buffer[codepoints_.count++];
+
+						cp.value = decoder_.codepoint;
+						cp.count = currently_decoding_.count;
+						std::memcpy(cp.bytes, currently_decoding_.bytes, currently_decoding_.count);
+						currently_decoding_.count = {};
+					}
+					else if TOML_UNLIKELY(currently_decoding_.count == 4u)
+					{
+						calc_positions();
+						utf8_reader_error("Encountered overlong utf-8 sequence", error_pos(), source_path_);
+						utf8_reader_return_after_error(false);
+					}
+				}
+				if TOML_UNLIKELY(decoder_.needs_more_input() && chunk_.pos == chunk_.count && stream_.eof())
+				{
+					calc_positions();
+					utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
+									  error_pos(),
+									  source_path_);
+					utf8_reader_return_after_error(false);
+				}
+
+				// the whole block was the start of a sequence that continues in the next one
+				if TOML_UNLIKELY(!codepoints_.count)
+					return read_next_block();
+			}
+
+			TOML_ASSERT_ASSUME(codepoints_.count);
+			calc_positions();
+			last_pos_ = codepoints_.buffer[codepoints_.count - 1u].position;
+
+			// handle general I/O errors
+			// (down here so the next_pos_ benefits from calc_positions())
+			if TOML_UNLIKELY(stream_.error())
+			{
+				utf8_reader_error("An I/O error occurred while reading from the underlying stream",
+								  next_pos_,
+								  source_path_);
+				utf8_reader_return_after_error(false);
+			}
+
+			return true;
+		}
+
+	  public:
+		template <typename U, typename String = std::string_view>
+		TOML_NODISCARD_CTOR
+		explicit utf8_reader(U&& source, String&& source_path = {}) noexcept(
+			std::is_nothrow_constructible_v<utf8_byte_stream<T>, U&&>)
+			: stream_{ static_cast<U&&>(source) }
+		{
+			chunk_.bytes	= {};
+			chunk_.capacity = stream_.chunk_size();
+			chunk_.pos		= {};
+			chunk_.count	= {};
+			chunk_.first	= true;
+
+			currently_decoding_.count = {};
+
+			codepoints_.current = {};
+			codepoints_.count	= {};
+
+			if (!source_path.empty())
+				source_path_ = std::make_shared<const std::string>(static_cast<String&&>(source_path));
+		}
+
+		// reads into the given buffer instead of one of the reader's own (must be called before anything is read)
+		void use_chunk_buffer(impl::stream_chunk_buffer& buffer) noexcept
+		{
+			TOML_ASSERT(!chunk_.bytes);
+			borrowed_buffer_ = &buffer;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const source_path_ptr& source_path() const noexcept
+		{
+			return source_path_;
+		}
+
+		// offset of the byte following everything read so far (i.e. of EOF, once it's been reached)
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return next_pos_.offset;
+		}
+
+		TOML_NODISCARD
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			utf8_reader_error_check({});
+
+			if (codepoints_.current == codepoints_.count)
+			{
+				if TOML_UNLIKELY(!read_next_block())
+					return nullptr;
+
+				TOML_ASSERT_ASSUME(!codepoints_.current);
+			}
+			TOML_ASSERT_ASSUME(codepoints_.count);
+			TOML_ASSERT_ASSUME(codepoints_.count <= block_capacity);
+			TOML_ASSERT_ASSUME(codepoints_.current < codepoints_.count);
+
+			return &codepoints_.buffer[codepoints_.current++];
+		}
+
+		TOML_NODISCARD
+		bool peek_eof() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			if (codepoints_.current < codepoints_.count || chunk_.pos < chunk_.count || read_next_chunk())
+				return false;
+
+#if TOML_EXCEPTIONS
+			return true;
+#else
+			return !err_; // errors are reported by the next read_next()
+#endif
+		}
+
+#if !TOML_EXCEPTIONS
+
+		TOML_NODISCARD
+		optional<parse_error>&& error() noexcept
+		{
+			return std::move(err_);
+		}
+
+#endif
+	};
+
+	// reader for documents that are entirely in memory already (strings, memory-mapped files).
+	// rather than decoding fixed-size blocks into an intermediate buffer, codepoints are produced one at a time
+	// straight from the source; runs of ASCII are located up-front with SIMD and converted without touching the
+	// utf-8 decoder. only non-ASCII sequences go through impl::utf8_decoder.
+	// read_next() still fills in a utf8_codepoint for everything it returns; it's remaining() and skip_ascii()
+	// that let the parser consume runs of bytes (strings, whitespace, comments) without one per character.
+	// the positions of those codepoints only have their offsets filled in; lines and columns are worked out on demand
+	// by position(), so they cost nothing for text that never ends up in a source region or error.
+	template <typename Char>
+	class utf8_reader<std::basic_string_view<Char>>
+	{
+		static_assert(sizeof(Char) == 1);
+
+	  private:
+		// codepoints handed out by read_next() are written into a small ring so the last few remain valid
+		// (the parser keeps hold of the previous codepoint in a few places)
+		static constexpr size_t ring_size	   = 4;
+		static constexpr size_t ascii_scan_size = 256;
+
+		const char* begin_;
+		const char* pos_;
+		const char* end_;
+		const char* ascii_end_;
+		source_index begin_offset_ = {}; // offset of begin_ from the start of the document
+		utf8_codepoint codepoints_[ring_size] = {};
+		size_t current_ = ring_size - 1u;
+		bool returned_eof_ = false;
+		bool valid_utf8_   = false;
+		source_path_ptr source_path_;
+
+		// the furthest position worked out by position() so far, and the offsets of the lines it's passed
+		// (the start of line N is line_starts_[N - 2], line 1 starting at first_line_offset_)
+		source_position known_			 = { 1, 1 };
+		source_index first_line_offset_ = {};
+		std::vector<source_index> line_starts_;
+		source_position previous_piece_last_ = { 1, 1 }; // (see finish_piece())
+
+#if !TOML_EXCEPTIONS
+		optional<parse_error> err_;
+#endif
+
+		TOML_PURE_INLINE_GETTER
+		source_index offset_of(const char* p) const noexcept
+		{
+			return static_cast<source_index>(begin_offset_ + static_cast<size_t>(p - begin_));
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const char* at_offset(source_index offset) const noexcept
+		{
+			TOML_ASSERT_ASSUME(offset >= begin_offset_);
+			return begin_ + (offset - begin_offset_);
+		}
+
+		// (every byte that isn't a utf-8 continuation byte begins a codepoint)
+		TOML_PURE_GETTER
+		static source_index count_codepoints(const char* str, const char* end) noexcept
+		{
+			size_t count = {};
+			while (str < end)
+			{
+				const auto ascii = impl::ascii_prefix_length(str, static_cast<size_t>(end - str));
+				count += ascii;
+				for (str += ascii; str < end && static_cast<unsigned char>(*str) >= 0x80u; str++)
+					count += (static_cast<unsigned char>(*str) & 0xC0u) != 0x80u;
+			}
+			return static_cast<source_index>(count);
+		}
+
+		TOML_NODISCARD
+		utf8_codepoint& next_codepoint() noexcept
+		{
+			current_ = (current_ + 1u) % ring_size;
+
+			auto& cp		   = codepoints_[current_];
+			cp.position.offset = offset_of(pos_);
+
+			return cp;
+		}
+
+		TOML_NODISCARD
+		TOML_NEVER_INLINE
+		const utf8_codepoint* read_next_non_ascii() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			// the whole document was already validated up-front, so we can decode without checking anything
+			if (valid_utf8_)
+			{
+				auto& cp		= next_codepoint();
+				const auto lead = static_cast<unsigned char>(*pos_);
+				TOML_ASSERT_ASSUME(lead >= 0xC0u);
+
+				cp.count = lead < 0xE0u ? 2u : (lead < 0xF0u ? 3u : 4u);
+				cp.value = static_cast<char32_t>(lead & (0x7Fu >> cp.count));
+				TOML_ASSERT_ASSUME(static_cast<size_t>(end_ - pos_) >= cp.count);
+
+				cp.bytes[0] = *pos_++;
+				for (size_t i = 1; i < cp.count; i++)
+				{
+					cp.bytes[i] = *pos_++;
+					cp.value	= (cp.value << 6) | (static_cast<unsigned char>(cp.bytes[i]) & 0x3Fu);
+				}
+
+				return &cp;
+			}
+
+			// errors are reported at the last successfully-decoded codepoint (same as the stream reader)
+			const auto last_offset = codepoints_[current_].position.offset;
+			const auto error_pos   = last_offset < begin_offset_ ? previous_piece_last_ : position(last_offset);
+
+			auto& cp = next_codepoint();
+			cp.count = {};
+
+			impl::utf8_decoder decoder;
+			do
+			{
+				if TOML_UNLIKELY(pos_ == end_)
+				{
+					utf8_reader_error("Encountered EOF during incomplete utf-8 code point sequence",
+									  error_pos,
+									  source_path_);
+					utf8_reader_return_after_error(nullptr);
+				}
+
+				decoder(static_cast<uint8_t>(*pos_));
+				if TOML_UNLIKELY(decoder.error())
+				{
+					utf8_reader_error("Encountered invalid utf-8 sequence", error_pos, source_path_);
+					utf8_reader_return_after_error(nullptr);
+				}
+
+				cp.bytes[cp.count++] = *pos_++;
+
+				if TOML_UNLIKELY(!decoder.has_code_point() && cp.count == 4u)
+				{
+					utf8_reader_error("Encountered overlong utf-8 sequence", error_pos, source_path_);
+					utf8_reader_return_after_error(nullptr);
+				}
+			}
+			while (!decoder.has_code_point());
+
+			cp.value = decoder.codepoint;
+			return &cp;
+		}
+
+		void validate() noexcept
+		{
+			// validate everything up-front; invalid documents fall back to checking each codepoint as it's read
+			// so errors are still reported in the right place.
+			// (only worth it with a vectorized validator, otherwise it's just decoding everything twice)
+			valid_utf8_ = false;
+			if (impl::active_simd_tier() >= impl::simd_tier::sse4_1)
+				valid_utf8_ = begin_ == end_ || impl::is_valid_utf8(begin_, static_cast<size_t>(end_ - begin_));
+		}
+
+	  public:
+		template <typename String = std::string_view>
+		TOML_NODISCARD_CTOR
+		explicit utf8_reader(std::basic_string_view<Char> source, String&& source_path = {}) noexcept(
+			std::is_nothrow_constructible_v<std::string, String&&>)
+			: begin_{ reinterpret_cast<const char*>(source.data()) },
+			  pos_{ begin_ },
+			  end_{ begin_ + source.length() },
+			  ascii_end_{ begin_ }
+		{
+			// skip bom
+			if (source.length() >= 3u && memcmp(utf8_byte_order_mark.data(), begin_, 3u) == 0)
+			{
+				ascii_end_ = pos_ = begin_ += 3u;
+				skipped_bom();
+			}
+
+			validate();
+
+			if (!source_path.empty())
+				source_path_ = std::make_shared<const std::string>(static_cast<String&&>(source_path));
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const source_path_ptr& source_path() const noexcept
+		{
+			return source_path_;
+		}
+
+		// offset of the end of the source (i.e. of EOF)
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return offset_of(end_);
+		}
+
+		// works out the line and column of an offset from one of the codepoints handed out by read_next().
+		// positions ahead of the furthest one so far are found by counting forward from it, and ones behind it from
+		// the start of their line (or back from the furthest one, if they're on the same line).
+		TOML_NODISCARD
+		source_position position(source_index offset)
+		{
+			if (offset >= known_.offset)
+			{
+				if (offset == known_.offset)
+					return known_;
+
+				auto str		  = at_offset(known_.offset);
+				const auto target = at_offset(offset);
+				while (const auto nl =
+						   static_cast<const char*>(std::memchr(str, '\n', static_cast<size_t>(target - str))))
+				{
+					str = nl + 1;
+					line_starts_.push_back(offset_of(str));
+					known_.line++;
+					known_.column = source_index{ 1 };
+				}
+				known_.column += count_codepoints(str, target);
+				known_.offset = offset;
+				return known_;
+			}
+
+			// (the number of lines starting at or before the offset, not using std::upper_bound to avoid <algorithm>)
+			size_t first = {}, count = line_starts_.size();
+			while (count)
+			{
+				const auto step = count / 2u;
+				if (line_starts_[first + step] <= offset)
+				{
+					first += step + 1u;
+					count -= step + 1u;
+				}
+				else
+					count = step;
+			}
+
+			const auto line = static_cast<source_index>(first + 1u);
+			if (line == known_.line)
+				return { line,
+						 static_cast<source_index>(known_.column
+												   - count_codepoints(at_offset(offset), at_offset(known_.offset))),
+						 offset };
+
+			const auto line_start = line == 1u ? first_line_offset_ : line_starts_[line - 2u];
+			return { line,
+					 static_cast<source_index>(1u + count_codepoints(at_offset(line_start), at_offset(offset))),
+					 offset };
+		}
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			utf8_reader_error_check({});
+
+			if TOML_UNLIKELY(pos_ == end_)
+			{
+				returned_eof_ = true;
+				return nullptr;
+			}
+
+			// find the next run of ASCII characters
+			// (checking the first byte here saves a trip through the SIMD dispatch table for every character
+			// of text that's mostly non-ASCII)
+			if (pos_ >= ascii_end_)
+			{
+				if (static_cast<unsigned char>(*pos_) >= 0x80u)
+					return read_next_non_ascii();
+
+				ascii_end_ = pos_ + 1
+						   + impl::ascii_prefix_length(pos_ + 1,
+													   impl::min(static_cast<size_t>(end_ - pos_) - 1u, ascii_scan_size));
+			}
+
+			// ASCII fast-path
+			TOML_ASSERT_ASSUME(pos_ < ascii_end_);
+			auto& cp	= next_codepoint();
+			cp.value	= static_cast<char32_t>(static_cast<unsigned char>(*pos_));
+			cp.bytes[0] = *pos_++;
+			cp.count	= 1u;
+			return &cp;
+		}
+
+		// the rest of the source, starting at the codepoint most recently returned by read_next()
+		TOML_PURE_INLINE_GETTER
+		std::string_view remaining() const noexcept
+		{
+			TOML_ASSERT_ASSUME(!returned_eof_);
+
+			const auto head = pos_ - codepoints_[current_].count;
+			return { head, static_cast<size_t>(end_ - head) };
+		}
+
+		// skips 'count' bytes of the source, starting at the codepoint most recently returned by read_next(),
+		// and returns the codepoint that follows them. the skipped bytes must all be ASCII and not line breaks.
+		TOML_NODISCARD
+		const utf8_codepoint* skip_ascii(size_t count) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			TOML_ASSERT_ASSUME(!returned_eof_);
+			TOML_ASSERT_ASSUME(count);
+
+			auto& head = codepoints_[current_];
+			TOML_ASSERT_ASSUME(head.count == 1u);
+			TOML_ASSERT_ASSUME(count <= static_cast<size_t>(end_ - pos_) + 1u);
+
+			pos_ += count - 1u;
+
+			// the head's slot in the ring now stands in for the last skipped character
+			// (it's what step_back() and error reporting work from)
+			head.position.offset = offset_of(pos_ - 1);
+			head.value			 = static_cast<char32_t>(static_cast<unsigned char>(pos_[-1]));
+			head.bytes[0]		 = pos_[-1];
+
+			return read_next();
+		}
+
+		// steps back to the codepoint 'count' positions before the one most recently returned by read_next()
+		// (or before EOF). the document is all in memory so this is just a matter of walking back over the source
+		// and decoding the codepoint found there again.
+		TOML_NODISCARD
+		const utf8_codepoint* step_back(size_t count) noexcept
+		{
+			utf8_reader_error_check({});
+			TOML_ASSERT_ASSUME(count);
+
+			const char* p;
+			bool all_ascii;
+			if (returned_eof_)
+			{
+				p		  = end_;
+				all_ascii = true;
+			}
+			else
+			{
+				const auto& head = codepoints_[current_];
+				p				 = pos_ - head.count;
+				all_ascii		 = head.count == 1u;
+			}
+
+			for (; count; count--)
+			{
+				TOML_ASSERT_ASSUME(p > begin_);
+
+				do
+					p--;
+				while ((static_cast<unsigned char>(*p) & 0xC0u) == 0x80u);
+
+				all_ascii = all_ascii && static_cast<unsigned char>(*p) < 0x80u;
+			}
+
+			// [p, pos_) is only known to be pure ASCII if we didn't step back over anything else
+			if (!all_ascii)
+				ascii_end_ = p;
+
+			returned_eof_ = false;
+			pos_		  = p;
+			return read_next();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool peek_eof() const noexcept
+		{
+			return pos_ == end_;
+		}
+
+		// moves on to the next piece of a document that's arriving in pieces (see toml::push_parser).
+		// positions carry on from where the previous piece left off, so the pieces must be split after line breaks
+		// (and follow on from one another directly, so the offsets stay correct).
+		void reset(std::basic_string_view<Char> source) noexcept
+		{
+			TOML_ASSERT(known_.offset == end_offset());
+
+			begin_offset_ = end_offset();
+			begin_		  = reinterpret_cast<const char*>(source.data());
+			pos_		  = begin_;
+			end_		  = begin_ + source.length();
+			ascii_end_	  = begin_;
+			returned_eof_ = false;
+
+			validate();
+		}
+
+		// counts the lines in the rest of the current piece, which must be done before it goes away
+		// (along with working out where its last codepoint is, in case an error is reported there)
+		void finish_piece()
+		{
+			static_cast<void>(position(end_offset()));
+			previous_piece_last_ = position(codepoints_[current_].position.offset);
+		}
+
+		// accounts for a byte order mark skipped at the start of the document
+		// (the push parser strips it itself, since it might arrive split across chunks)
+		void skipped_bom() noexcept
+		{
+			TOML_ASSERT(!known_.offset);
+
+			begin_offset_ += 3u;
+			known_.offset	   = begin_offset_;
+			first_line_offset_ = begin_offset_;
+			codepoints_[current_].position.offset = begin_offset_;
+		}
+
+#if !TOML_EXCEPTIONS
+
+		TOML_NODISCARD
+		optional<parse_error>&& error() noexcept
+		{
+			return std::move(err_);
+		}
+
+#endif
+	};
+
+	template <typename Char>
+	utf8_reader(std::basic_string_view<Char>, std::string_view) -> utf8_reader<std::basic_string_view<Char>>;
+	template <typename Char>
+	utf8_reader(std::basic_string_view<Char>, std::string&&) -> utf8_reader<std::basic_string_view<Char>>;
+	template <typename Char>
+	utf8_reader(std::basic_istream<Char>&, std::string_view) -> utf8_reader<std::basic_istream<Char>>;
+	template <typename Char>
+	utf8_reader(std::basic_istream<Char>&, std::string&&) -> utf8_reader<std::basic_istream<Char>>;
+
+#if TOML_EXCEPTIONS
+#define utf8_buffered_reader_error_check(...) static_assert(true)
+#else
+#define utf8_buffered_reader_error_check(...)                                                                          \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if TOML_UNLIKELY(reader_.error())                                                                              \
+			return __VA_ARGS__;                                                                                        \
+	}                                                                                                                  \
+	while (false)
+
+#endif
+
+	template <typename Reader>
+	class utf8_buffered_reader
+	{
+	  public:
+		static constexpr size_t max_history_length = 128;
+		static constexpr bool is_contiguous		   = false;
+
+	  private:
+		static constexpr size_t history_buffer_size = max_history_length - 1; //'head' is stored in the reader
+		Reader& reader_;
+		struct
+		{
+			utf8_codepoint buffer[history_buffer_size];
+			size_t count, first;
+		} history_					= {};
+		const utf8_codepoint* head_ = {};
+		size_t negative_offset_		= {};
+
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit utf8_buffered_reader(Reader& reader) noexcept //
+			: reader_{ reader }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		const source_path_ptr& source_path() const noexcept
+		{
+			return reader_.source_path();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return reader_.end_offset();
+		}
+
+		// (the reader works out the positions of codepoints as they're decoded)
+		TOML_PURE_INLINE_GETTER
+		const source_position& resolve(const source_position& pos) const noexcept
+		{
+			return pos;
+		}
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			utf8_buffered_reader_error_check({});
+
+			if (negative_offset_)
+			{
+				negative_offset_--;
+
+				// an entry negative offset of 1 just means "replay the current head"
+				if (!negative_offset_)
+					return head_;
+
+				// otherwise step back into the history buffer
+				else
+					return history_.buffer
+						 + ((history_.first + history_.count - negative_offset_) % history_buffer_size);
+			}
+			else
+			{
+				// first character read from stream
+				if TOML_UNLIKELY(!history_.count && !head_)
+					head_ = reader_.read_next();
+
+				// subsequent characters and not eof
+				else if (head_)
+				{
+					if TOML_UNLIKELY(history_.count < history_buffer_size)
+						history_.buffer[history_.count++] = *head_;
+					else
+						history_.buffer[(history_.first++ + history_buffer_size) % history_buffer_size] = *head_;
+
+					head_ = reader_.read_next();
+				}
+
+				return head_;
+			}
+		}
+
+		TOML_NODISCARD
+		const utf8_codepoint* step_back(size_t count) noexcept
+		{
+			utf8_buffered_reader_error_check({});
+
+			TOML_ASSERT_ASSUME(history_.count);
+			TOML_ASSERT_ASSUME(negative_offset_ + count <= history_.count);
+
+			negative_offset_ += count;
+
+			return negative_offset_
+					 ? history_.buffer + ((history_.first + history_.count - negative_offset_) % history_buffer_size)
+					 : head_;
+		}
+
+		TOML_NODISCARD
+		bool peek_eof() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.peek_eof();
+		}
+
+#if !TOML_EXCEPTIONS
+
+		TOML_NODISCARD
+		optional<parse_error>&& error() noexcept
+		{
+			return reader_.error();
+		}
+
+#endif
+	};
+
+	// contiguous inputs don't need a history buffer; the reader can step back over the source directly.
+	template <typename Char>
+	class utf8_buffered_reader<utf8_reader<std::basic_string_view<Char>>>
+	{
+	  public:
+		static constexpr size_t max_history_length = static_cast<size_t>(-1);
+		static constexpr bool is_contiguous		   = true;
+
+	  private:
+		utf8_reader<std::basic_string_view<Char>>& reader_;
+
+	  public:
+		TOML_NODISCARD_CTOR
+		explicit utf8_buffered_reader(utf8_reader<std::basic_string_view<Char>>& reader) noexcept //
+			: reader_{ reader }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		const source_path_ptr& source_path() const noexcept
+		{
+			return reader_.source_path();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		source_index end_offset() const noexcept
+		{
+			return reader_.end_offset();
+		}
+
+		// fills in the line and column of a position that only has its offset
+		// (the ones that come from the reader's codepoints; see utf8_reader::position())
+		TOML_NODISCARD
+		source_position resolve(const source_position& pos) const
+		{
+			return pos.line ? pos : reader_.position(pos.offset);
+		}
+
+		TOML_NODISCARD
+		TOML_ALWAYS_INLINE
+		const utf8_codepoint* read_next() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.read_next();
+		}
+
+		TOML_NODISCARD
+		const utf8_codepoint* step_back(size_t count) noexcept
+		{
+			return reader_.step_back(count);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view remaining() const noexcept
+		{
+			return reader_.remaining();
+		}
+
+		TOML_NODISCARD
+		const utf8_codepoint* skip_ascii(size_t count) noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.skip_ascii(count);
+		}
+
+		TOML_NODISCARD
+		bool peek_eof() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		{
+			return reader_.peek_eof();
+		}
+
+#if !TOML_EXCEPTIONS
+
+		TOML_NODISCARD
+		optional<parse_error>&& error() noexcept
+		{
+			return reader_.error();
+		}
+
+#endif
+	};
+}
+TOML_ANON_NAMESPACE_END;
+
+#if TOML_EXCEPTIONS
+#define TOML_RETURNS_BY_THROWING [[noreturn]]
+#else
+#define TOML_RETURNS_BY_THROWING
+#endif
+
+TOML_ANON_NAMESPACE_START
+{
+	template <typename... T>
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	constexpr bool is_match(char32_t codepoint, T... vals) noexcept
+	{
+		static_assert((std::is_same_v<char32_t, T> && ...));
+		return ((codepoint == vals) || ...);
+	}
+
+	// run scanners for parser::consume_ascii_run()
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t basic_string_prefix_length(const char* str, size_t len) noexcept
+	{
+		return impl::plain_string_prefix_length(str, len, '"', '\\');
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t literal_string_prefix_length(const char* str, size_t len) noexcept
+	{
+		return impl::plain_string_prefix_length(str, len, '\'', '\'');
+	}
+
+	TOML_PURE_GETTER
+	TOML_INTERNAL_LINKAGE
+	size_t printable_ascii_prefix_length(const char* str, size_t len) noexcept
+	{
+		// (line breaks are control characters so they'll end the run regardless)
+		return impl::plain_string_prefix_length(str, len, '\n', '\n');
+	}
+
+	template <uint64_t>
+	struct parse_integer_traits;
+	template <>
+	struct parse_integer_traits<2>
+	{
+		static constexpr auto scope_qualifier  = "binary integer"sv;
+		static constexpr auto is_digit		   = impl::is_binary_digit;
+		static constexpr auto is_signed		   = false;
+		static constexpr auto max_digits	   = 63;
+		static constexpr auto prefix_codepoint = U'b';
+		static constexpr auto prefix		   = "b"sv;
+		static constexpr auto full_prefix	   = "0b"sv;
+	};
+	template <>
+	struct parse_integer_traits<8>
+	{
+		static constexpr auto scope_qualifier  = "octal integer"sv;
+		static constexpr auto is_digit		   = impl::is_octal_digit;
+		static constexpr auto is_signed		   = false;
+		static constexpr auto max_digits	   = 21; // strlen("777777777777777777777")
+		static constexpr auto prefix_codepoint = U'o';
+		static constexpr auto prefix		   = "o"sv;
+		static constexpr auto full_prefix	   = "0o"sv;
+	};
+	template <>
+	struct parse_integer_traits<10>
+	{
+		static constexpr auto scope_qualifier = "decimal integer"sv;
+		static constexpr auto is_digit		  = impl::is_decimal_digit;
+		static constexpr auto is_signed		  = true;
+		static constexpr auto max_digits	  = 19; // strlen("9223372036854775807")
+		static constexpr auto full_prefix	  = ""sv;
+	};
+	template <>
+	struct parse_integer_traits<16>
+	{
+		static constexpr auto scope_qualifier  = "hexadecimal integer"sv;
+		static constexpr auto is_digit		   = impl::is_hexadecimal_digit;
+		static constexpr auto is_signed		   = false;
+		static constexpr auto max_digits	   = 16; // strlen("7FFFFFFFFFFFFFFF")
+		static constexpr auto prefix_codepoint = U'x';
+		static constexpr auto prefix		   = "x"sv;
+		static constexpr auto full_prefix	   = "0x"sv;
+	};
+
+	// is 'pos' the end of a value (i.e. the end of the source or a value-terminator)?
+	TOML_PURE_INLINE_GETTER
+	bool ends_value(const char* pos, const char* end) noexcept
+	{
+		return pos == end
+			|| (static_cast<unsigned char>(*pos) < 0x80u
+				&& impl::is_value_terminator(static_cast<char32_t>(static_cast<unsigned char>(*pos))));
+	}
+
+	// SWAR helpers for scan_integer()
+
+	TOML_PURE_INLINE_GETTER
+	uint64_t load_little_endian_u64(const char* str) noexcept
+	{
+#if TOML_MSVC_LIKE || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		uint64_t val;
+		std::memcpy(&val, str, sizeof(val));
+		return val;
+#else
+		uint64_t val = {};
+		for (size_t i = 0; i < 8u; i++)
+			val |= static_cast<uint64_t>(static_cast<unsigned char>(str[i])) << (i * 8u);
+		return val;
+#endif
+	}
+
+	TOML_CONST_INLINE_GETTER
+	constexpr uint64_t repeat_byte(uint8_t val) noexcept
+	{
+		return 0x0101010101010101ull * val;
+	}
+
+	// 0x80 in each byte of 'chunk' that's in the range [lo, hi] (which must all be ASCII)
+	template <uint8_t lo, uint8_t hi>
+	TOML_CONST_INLINE_GETTER
+	constexpr uint64_t bytes_in_range(uint64_t chunk) noexcept
+	{
+		return (chunk + repeat_byte(static_cast<uint8_t>(0x80u - lo))) & ~(chunk + repeat_byte(static_cast<uint8_t>(0x7Fu - hi))) & repeat_byte(0x80u);
+	}
+
+	// are all eight characters in 'chunk' digits of the given base?
+	template <uint64_t base>
+	TOML_CONST_INLINE_GETTER
+	constexpr bool is_digit_chunk(uint64_t chunk) noexcept
+	{
+		if constexpr (base == 2)
+			return (chunk & repeat_byte(0xFEu)) == repeat_byte(0x30u);
+		else if constexpr (base == 8)
+			return (chunk & repeat_byte(0xF8u)) == repeat_byte(0x30u);
+		else if constexpr (base == 10)
+			return ((chunk & repeat_byte(0xF0u)) | (((chunk + repeat_byte(0x06u)) & repeat_byte(0xF0u)) >> 4))
+				== repeat_byte(0x33u);
+		else
+		{
+			static_assert(base == 16);
+			if (chunk & repeat_byte(0x80u))
+				return false;
+			return (bytes_in_range<'0', '9'>(chunk) | bytes_in_range<'a', 'f'>(chunk | repeat_byte(0x20u)))
+				== repeat_byte(0x80u);
+		}
+	}
+
+	// the value of eight digits of the given base (which is_digit_chunk() has already vetted), the first being the
+	// most significant. each step combines adjacent pairs of lanes, doubling their width.
+	template <uint64_t base>
+	TOML_CONST_INLINE_GETTER
+	constexpr uint64_t digit_chunk_value(uint64_t chunk) noexcept
+	{
+		if constexpr (base == 16)
+			chunk = (chunk & repeat_byte(0x0Fu)) + ((chunk >> 6) & repeat_byte(0x01u)) * 9u;
+		else
+			chunk &= repeat_byte(0x0Fu);
+
+		chunk = (chunk * base + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+		chunk = (chunk * (base * base) + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+		chunk = (chunk * (base * base * base * base) + (chunk >> 32)) & 0x00000000FFFFFFFFull;
+		return chunk;
+	}
+
+	// converts the digits (and underscores) at the start of a value in one pass, eight digits at a time where
+	// possible. only succeeds if they make up the whole value and don't exceed 'max_value' or 'max_length' digits,
+	// otherwise returns zero so the caller can take the slow path (which is where errors are reported).
+	template <uint64_t base>
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_integer(const char* str, size_t len, uint64_t max_value, size_t max_length, uint64_t& value) noexcept
+	{
+		using traits = parse_integer_traits<base>;
+		constexpr auto is_digit = [](char c) noexcept
+		{ return traits::is_digit(static_cast<char32_t>(static_cast<unsigned char>(c))); };
+
+		// bin, oct and hex can't overflow 64 bits until the digits after any leading zeroes need more bits than
+		// are left; decimals don't allow leading zeroes so counting digits is enough
+		constexpr unsigned bits_per_digit = base == 2 ? 1u : (base == 8 ? 3u : (base == 16 ? 4u : 0u));
+		constexpr uint64_t chunk_multiplier =
+			base * base * base * base * base * base * base * base; // base ^ 8
+		const auto fits = [](uint64_t val, size_t digit_count, unsigned shift) noexcept
+		{
+			if constexpr (bits_per_digit)
+				return !(val >> (64u - shift * bits_per_digit));
+			else
+			{
+				TOML_UNUSED(val);
+				TOML_UNUSED(shift);
+				return digit_count <= traits::max_digits;
+			}
+		};
+
+		TOML_ASSERT_ASSUME(len);
+		TOML_ASSERT_ASSUME(is_digit(*str));
+		if constexpr (base == 10)
+		{
+			if (*str == '0' && len > 1u && (is_digit(str[1]) || str[1] == '_'))
+				return {};
+		}
+
+		const char* p		  = str;
+		const char* const end = str + len;
+		uint64_t result		  = {};
+		size_t digit_count	  = {};
+		while (p < end)
+		{
+			while (end - p >= 8)
+			{
+				const auto chunk = load_little_endian_u64(p);
+				if (!is_digit_chunk<base>(chunk))
+					break;
+
+				digit_count += 8u;
+				if (!fits(result, digit_count, 8u))
+					return {};
+				result = result * chunk_multiplier + digit_chunk_value<base>(chunk);
+				p += 8;
+			}
+			if (p == end)
+				break;
+
+			if (is_digit(*p))
+			{
+				digit_count++;
+				if (!fits(result, digit_count, 1u))
+					return {};
+				if constexpr (base == 16)
+					result = result * base + impl::hex_to_dec(*p);
+				else
+					result = result * base + static_cast<uint64_t>(*p - '0');
+				p++;
+			}
+			else if (*p == '_')
+			{
+				// underscores must be between two digits (and the first character is always a digit)
+				if (!is_digit(p[-1]) || end - p < 2 || !is_digit(p[1]))
+					return {};
+				p++;
+			}
+			else
+				break;
+		}
+
+		if (digit_count > max_length || result > max_value || !ends_value(p, end))
+			return {};
+
+		value = result;
+		return static_cast<size_t>(p - str);
+	}
+
+	TOML_CONST_GETTER
+	TOML_INTERNAL_LINKAGE
+	constexpr uint32_t days_in_month(uint32_t year, uint32_t month) noexcept
+	{
+		const auto is_leap_year = (year % 4u == 0u) && ((year % 100u != 0u) || (year % 400u == 0u));
+		return month == 2u ? (is_leap_year ? 29u : 28u)
+						   : (month == 4u || month == 6u || month == 9u || month == 11u ? 30u : 31u);
+	}
+
+	// matches eight characters against a fixed layout in which '0' stands for any digit and anything else must
+	// appear as-is (e.g. "0000-00-"), and converts them in the same step: byte i of 'pairs' is the two-digit number
+	// starting at character i.
+	TOML_NODISCARD
+	TOML_ALWAYS_INLINE
+	bool match_fixed_width_digits(const char* str, const char (&layout)[9], uint64_t& pairs) noexcept
+	{
+		uint64_t separators		= {};
+		uint64_t separator_mask = {};
+		for (size_t i = 0; i < 8u; i++)
+		{
+			if (layout[i] != '0')
+			{
+				separators |= static_cast<uint64_t>(static_cast<unsigned char>(layout[i])) << (i * 8u);
+				separator_mask |= uint64_t{ 0xFFu } << (i * 8u);
+			}
+		}
+
+		auto chunk = load_little_endian_u64(str);
+		if ((chunk & separator_mask) != separators)
+			return false;
+
+		chunk = (chunk & ~separator_mask) | (repeat_byte('0') & separator_mask);
+		if (!is_digit_chunk<10>(chunk))
+			return false;
+
+		chunk &= repeat_byte(0x0Fu);
+		pairs = chunk * 10u + (chunk >> 8);
+		return true;
+	}
+
+	TOML_CONST_INLINE_GETTER
+	uint32_t pair_at(uint64_t pairs, unsigned index) noexcept
+	{
+		return static_cast<uint32_t>((pairs >> (index * 8u)) & 0xFFu);
+	}
+
+	TOML_PURE_INLINE_GETTER
+	bool is_two_digits(const char* str) noexcept
+	{
+		return impl::is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(str[0])))
+			&& impl::is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(str[1])));
+	}
+
+	TOML_PURE_INLINE_GETTER
+	uint32_t two_digit_value(const char* str) noexcept
+	{
+		return static_cast<uint32_t>(str[0] - '0') * 10u + static_cast<uint32_t>(str[1] - '0');
+	}
+
+	// fast paths for date and time values in their canonical RFC 3339 layouts, for when the whole document is in
+	// memory. each returns the length of what it matched, or zero if it's anything unusual (or invalid), in which
+	// case the caller takes the slow path (which is where errors are reported).
+
+	// "YYYY-MM-DD"
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_date(const char* str, size_t len, date& value) noexcept
+	{
+		uint64_t pairs;
+		if (len < 10u || !match_fixed_width_digits(str, "0000-00-", pairs) || !is_two_digits(str + 8))
+			return {};
+
+		const auto year	 = pair_at(pairs, 0u) * 100u + pair_at(pairs, 2u);
+		const auto month = pair_at(pairs, 5u);
+		const auto day	 = two_digit_value(str + 8);
+		if (month == 0u || month > 12u || day == 0u || day > days_in_month(year, month))
+			return {};
+
+		value = { year, month, day };
+		return 10u;
+	}
+
+	// "HH:MM:SS" with up to nine fractional digits
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_time(const char* str, size_t len, toml::time& value) noexcept
+	{
+		uint64_t pairs;
+		if (len < 8u || !match_fixed_width_digits(str, "00:00:00", pairs))
+			return {};
+
+		const auto hour	  = pair_at(pairs, 0u);
+		const auto minute = pair_at(pairs, 3u);
+		const auto second = pair_at(pairs, 6u);
+		if (hour > 23u || minute > 59u || second > 59u)
+			return {};
+
+		value = { hour, minute, second };
+		if (len == 8u || str[8] != '.')
+			return 8u;
+
+		uint32_t nanosecond = {};
+		size_t pos			= 9u;
+		for (; pos < len && pos < 18u && impl::is_decimal_digit(static_cast<char32_t>(str[pos])); pos++)
+			nanosecond = nanosecond * 10u + static_cast<uint32_t>(str[pos] - '0');
+		if (pos == 9u || (pos < len && impl::is_decimal_digit(static_cast<char32_t>(str[pos]))))
+			return {}; // no digits, or more than nine
+		for (auto i = pos; i < 18u; i++)
+			nanosecond *= 10u;
+
+		value.nanosecond = nanosecond;
+		return pos;
+	}
+
+	// "YYYY-MM-DDTHH:MM:SS" with up to nine fractional digits and an optional offset
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_date_time(const char* str, size_t len, date_time& value) noexcept
+	{
+		date d;
+		toml::time t;
+		if (len < 19u || !scan_date(str, 10u, d) || !is_match(static_cast<char32_t>(str[10]), U'T', U't', U' '))
+			return {};
+		auto pos = scan_time(str + 11, len - 11u, t);
+		if (!pos)
+			return {};
+		pos += 11u;
+
+		if (pos < len && (str[pos] == 'Z' || str[pos] == 'z'))
+		{
+			value = { d, t, time_offset{} };
+			return pos + 1u;
+		}
+
+		if (pos < len && (str[pos] == '+' || str[pos] == '-'))
+		{
+			if (len - pos < 6u || !is_two_digits(str + pos + 1u) || str[pos + 3u] != ':'
+				|| !is_two_digits(str + pos + 4u))
+				return {};
+
+			const auto hour	  = two_digit_value(str + pos + 1u);
+			const auto minute = two_digit_value(str + pos + 4u);
+			if (hour > 23u || minute > 59u)
+				return {};
+
+			time_offset offset{};
+			offset.minutes = static_cast<int16_t>(static_cast<int>(hour * 60u + minute) * (str[pos] == '-' ? -1 : 1));
+			value		   = { d, t, offset };
+			return pos + 6u;
+		}
+
+		value = { d, t };
+		return pos;
+	}
+
+	// runs one of the scanners above, but only accepts what it matched if that was the whole value
+	template <typename T>
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_whole_value(size_t (*scan)(const char*, size_t, T&) noexcept,
+							const char* str,
+							size_t len,
+							T& value) noexcept
+	{
+		const auto length = scan(str, len, value);
+		return length && ends_value(str + length, str + len) ? length : 0u;
+	}
+
+	// a decimal integer or float in its usual form: an optional sign, digits (with underscores between them), an
+	// optional fractional part and an optional exponent. the digits are classified and converted in the same pass;
+	// returns zero for anything unusual (or invalid) so the caller can take the slow path, same as the above.
+	struct decimal_number
+	{
+		bool is_float;
+		int64_t integer;
+		double floating_point;
+	};
+
+	template <size_t MaxLength>
+	TOML_NODISCARD
+	TOML_INTERNAL_LINKAGE
+	size_t scan_decimal_number(const char* str, size_t len, decimal_number& value) noexcept
+	{
+		static constexpr auto i64_max = static_cast<uint64_t>((std::numeric_limits<int64_t>::max)());
+		constexpr auto is_digit		  = [](char c) noexcept
+		{ return impl::is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(c))); };
+
+		const char* p		  = str;
+		const char* const end = str + len;
 
-			if (negative_offset_)
-			{
-				negative_offset_--;
+		const bool negative = *p == '-';
+		if (*p == '+' || *p == '-')
+			p++;
 
-				// an entry negative offset of 1 just means "replay the current head"
-				if (!negative_offset_)
-					return head_;
+		// everything but the sign and underscores goes in here in case it turns out to be a float
+		char chars[MaxLength];
+		size_t length = {};
 
-				// otherwise step back into the history buffer
-				else
-					return history_.buffer
-						 + ((history_.first + history_.count - negative_offset_) % history_buffer_size);
-			}
-			else
-			{
-				// first character read from stream
-				if TOML_UNLIKELY(!history_.count && !head_)
-					head_ = reader_.read_next();
+		uint64_t mantissa  = {};
+		size_t digit_count = {};
+		const auto consume_digits = [&](bool integer_part) noexcept
+		{
+			if (p == end || !is_digit(*p))
+				return false;
 
-				// subsequent characters and not eof
-				else if (head_)
+			while (true)
+			{
+				while (end - p >= 8 && MaxLength - length >= 8u)
 				{
-					if TOML_UNLIKELY(history_.count < history_buffer_size)
-						history_.buffer[history_.count++] = *head_;
-					else
-						history_.buffer[(history_.first++ + history_buffer_size) % history_buffer_size] = *head_;
+					const auto chunk = load_little_endian_u64(p);
+					if (!is_digit_chunk<10>(chunk))
+						break;
 
-					head_ = reader_.read_next();
+					std::memcpy(chars + length, p, 8u);
+					length += 8u;
+					p += 8;
+					if (integer_part && (digit_count += 8u) <= 19u)
+						mantissa = mantissa * 100000000u + digit_chunk_value<10>(chunk);
 				}
+				if (p == end)
+					return true;
 
-				return head_;
+				if (is_digit(*p))
+				{
+					if (length == MaxLength)
+						return false;
+					chars[length++] = *p;
+					if (integer_part && ++digit_count <= 19u)
+						mantissa = mantissa * 10u + static_cast<uint64_t>(*p - '0');
+					p++;
+				}
+				else if (*p == '_')
+				{
+					// always preceded by a digit, so it only needs to be followed by one
+					if (end - p < 2 || !is_digit(p[1]))
+						return false;
+					p++;
+				}
+				else
+					return true;
 			}
-		}
-
-		TOML_NODISCARD
-		const utf8_codepoint* step_back(size_t count) noexcept
+		};
+		const auto append = [&](char c) noexcept
 		{
-			utf8_buffered_reader_error_check({});
-
-			TOML_ASSERT_ASSUME(history_.count);
-			TOML_ASSERT_ASSUME(negative_offset_ + count <= history_.count);
-
-			negative_offset_ += count;
+			if (length == MaxLength)
+				return false;
+			chars[length++] = c;
+			return true;
+		};
 
-			return negative_offset_
-					 ? history_.buffer + ((history_.first + history_.count - negative_offset_) % history_buffer_size)
-					 : head_;
-		}
+		// integer part (no leading zeroes)
+		if (!consume_digits(true) || (chars[0] == '0' && length > 1u))
+			return {};
 
-		TOML_NODISCARD
-		bool peek_eof() const noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
+		// fractional part
+		bool is_float = false;
+		if (p < end && *p == '.')
 		{
-			return reader_.peek_eof();
+			if (!append(*p++) || !consume_digits(false))
+				return {};
+			is_float = true;
 		}
 
-#if !TOML_EXCEPTIONS
-
-		TOML_NODISCARD
-		optional<parse_error>&& error() noexcept
+		// exponent
+		if (p < end && (*p == 'e' || *p == 'E'))
 		{
-			return reader_.error();
+			if (!append(*p++))
+				return {};
+			if (p < end && (*p == '+' || *p == '-') && !append(*p++))
+				return {};
+			if (!consume_digits(false))
+				return {};
+			is_float = true;
 		}
 
-#endif
-	};
-}
-TOML_ANON_NAMESPACE_END;
+		if (!ends_value(p, end))
+			return {};
 
-#if TOML_EXCEPTIONS
-#define TOML_RETURNS_BY_THROWING [[noreturn]]
+		if (is_float)
+		{
+			double result;
+#if TOML_FLOAT_CHARCONV
+			// (from_chars reports values too small to represent as out-of-range; decimal_to_double rounds them to zero)
+			const auto ec = std::from_chars(chars, chars + length, result).ec;
+			if (ec == std::errc::result_out_of_range)
+			{
+				if (!impl::decimal_to_double(std::string_view{ chars, length }, result))
+					return {};
+			}
+			else if (ec != std::errc{})
+				return {};
 #else
-#define TOML_RETURNS_BY_THROWING
+			if (!impl::decimal_to_double(std::string_view{ chars, length }, result))
+				return {};
 #endif
+			value = { true, {}, negative ? -result : result };
+		}
+		else
+		{
+			if (digit_count > 19u || mantissa > i64_max + (negative ? 1u : 0u))
+				return {};
 
-TOML_ANON_NAMESPACE_START
-{
-	template <typename... T>
-	TOML_CONST_GETTER
-	TOML_INTERNAL_LINKAGE
-	constexpr bool is_match(char32_t codepoint, T... vals) noexcept
-	{
-		static_assert((std::is_same_v<char32_t, T> && ...));
-		return ((codepoint == vals) || ...);
+			// avoid signed negation UB for INT64_MIN
+			int64_t result;
+			if (!negative)
+				result = static_cast<int64_t>(mantissa);
+			else if (mantissa == i64_max + 1u)
+				result = (std::numeric_limits<int64_t>::min)();
+			else
+				result = -static_cast<int64_t>(mantissa);
+			value = { false, result, {} };
+		}
+		return static_cast<size_t>(p - str);
 	}
 
-	template <uint64_t>
-	struct parse_integer_traits;
-	template <>
-	struct parse_integer_traits<2>
-	{
-		static constexpr auto scope_qualifier  = "binary integer"sv;
-		static constexpr auto is_digit		   = impl::is_binary_digit;
-		static constexpr auto is_signed		   = false;
-		static constexpr auto max_digits	   = 63;
-		static constexpr auto prefix_codepoint = U'b';
-		static constexpr auto prefix		   = "b"sv;
-		static constexpr auto full_prefix	   = "0b"sv;
-	};
-	template <>
-	struct parse_integer_traits<8>
-	{
-		static constexpr auto scope_qualifier  = "octal integer"sv;
-		static constexpr auto is_digit		   = impl::is_octal_digit;
-		static constexpr auto is_signed		   = false;
-		static constexpr auto max_digits	   = 21; // strlen("777777777777777777777")
-		static constexpr auto prefix_codepoint = U'o';
-		static constexpr auto prefix		   = "o"sv;
-		static constexpr auto full_prefix	   = "0o"sv;
-	};
-	template <>
-	struct parse_integer_traits<10>
-	{
-		static constexpr auto scope_qualifier = "decimal integer"sv;
-		static constexpr auto is_digit		  = impl::is_decimal_digit;
-		static constexpr auto is_signed		  = true;
-		static constexpr auto max_digits	  = 19; // strlen("9223372036854775807")
-		static constexpr auto full_prefix	  = ""sv;
-	};
-	template <>
-	struct parse_integer_traits<16>
-	{
-		static constexpr auto scope_qualifier  = "hexadecimal integer"sv;
-		static constexpr auto is_digit		   = impl::is_hexadecimal_digit;
-		static constexpr auto is_signed		   = false;
-		static constexpr auto max_digits	   = 16; // strlen("7FFFFFFFFFFFFFFF")
-		static constexpr auto prefix_codepoint = U'x';
-		static constexpr auto prefix		   = "x"sv;
-		static constexpr auto full_prefix	   = "0x"sv;
-	};
-
 	TOML_PURE_GETTER
 	TOML_INTERNAL_LINKAGE
 	std::string_view to_sv(node_type val) noexcept
@@ -13352,54 +19086,6 @@ TOML_ANON_NAMESPACE_START
 #define push_parse_scope_1(scope, line) push_parse_scope_2(scope, line)
 #define push_parse_scope(scope)			push_parse_scope_1(scope, __LINE__)
 
-	struct parse_key_buffer
-	{
-		std::string buffer;
-		std::vector<std::pair<size_t, size_t>> segments;
-		std::vector<source_position> starts;
-		std::vector<source_position> ends;
-
-		void clear() noexcept
-		{
-			buffer.clear();
-			segments.clear();
-			starts.clear();
-			ends.clear();
-		}
-
-		void push_back(std::string_view segment, source_position b, source_position e)
-		{
-			segments.push_back({ buffer.length(), segment.length() });
-			buffer.append(segment);
-			starts.push_back(b);
-			ends.push_back(e);
-		}
-
-		TOML_PURE_INLINE_GETTER
-		std::string_view operator[](size_t i) const noexcept
-		{
-			return std::string_view{ buffer.c_str() + segments[i].first, segments[i].second };
-		}
-
-		TOML_PURE_INLINE_GETTER
-		std::string_view back() const noexcept
-		{
-			return (*this)[segments.size() - 1u];
-		}
-
-		TOML_PURE_INLINE_GETTER
-		bool empty() const noexcept
-		{
-			return segments.empty();
-		}
-
-		TOML_PURE_INLINE_GETTER
-		size_t size() const noexcept
-		{
-			return segments.size();
-		}
-	};
-
 	struct depth_counter_scope
 	{
 		size_t& depth_;
@@ -13423,6 +19109,7 @@ TOML_ANON_NAMESPACE_START
 	{
 		std::string_view value;
 		bool was_multi_line;
+		bool borrowed = false; // value points into the document (see parse_flags::borrowed_strings)
 	};
 
 	struct table_vector_scope
@@ -13549,42 +19236,188 @@ TOML_ANON_NAMESPACE_END;
 	}                                                                                                                  \
 	while (false)
 
-#endif // parser helper macros
+#endif // parser helper macros
+
+TOML_IMPL_NAMESPACE_START
+{
+	struct parse_key_buffer
+	{
+		std::string buffer;
+		std::vector<std::pair<size_t, size_t>> segments;
+		std::vector<source_position> starts;
+		std::vector<source_position> ends;
+		std::vector<const char*> sources; // where a segment is in the document, if keys can borrow it (or nullptr)
+
+		void clear() noexcept
+		{
+			buffer.clear();
+			segments.clear();
+			starts.clear();
+			ends.clear();
+			sources.clear();
+		}
+
+		void push_back(std::string_view segment, source_position b, source_position e, const char* source = nullptr)
+		{
+			segments.push_back({ buffer.length(), segment.length() });
+			buffer.append(segment);
+			starts.push_back(b);
+			ends.push_back(e);
+			sources.push_back(source);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view operator[](size_t i) const noexcept
+		{
+			return std::string_view{ buffer.c_str() + segments[i].first, segments[i].second };
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view back() const noexcept
+		{
+			return (*this)[segments.size() - 1u];
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool empty() const noexcept
+		{
+			return segments.empty();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t size() const noexcept
+		{
+			return segments.size();
+		}
+	};
+
+	// the parser's working storage; owned by a toml::parse_context when there is one, so it can be reused
+	// (already grown to size) by every document parsed with it
+	struct parse_scratch
+	{
+		std::vector<table*> implicit_tables;
+		std::vector<table*> dotted_key_tables;
+		std::vector<table*> open_inline_tables;
+		std::vector<array*> table_arrays;
+		parse_key_buffer key_buffer;
+		std::string string_buffer;
+		std::string recording_buffer; // for diagnostics
+		stream_chunk_buffer chunk_buffer;
+
+		// roughly how much of its arena the previous document used (see parse_flags::arena_allocation)
+		size_t arena_size_hint = {};
+
+		void clear() noexcept
+		{
+			implicit_tables.clear();
+			dotted_key_tables.clear();
+			open_inline_tables.clear();
+			table_arrays.clear();
+			key_buffer.clear();
+			string_buffer.clear();
+			recording_buffer.clear();
+		}
+	};
 
-TOML_IMPL_NAMESPACE_START
-{
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, impl_ex, impl_noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, impl_pmralloc, impl_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
 
+	template <typename Reader>
 	class parser
 	{
 	  private:
 		static constexpr size_t max_nested_values	  = TOML_MAX_NESTED_VALUES;
 		static constexpr size_t max_dotted_keys_depth = TOML_MAX_DOTTED_KEYS_DEPTH;
+		static constexpr size_t max_numeric_length	  = 128;
 
-		utf8_buffered_reader reader;
+		utf8_buffered_reader<Reader> reader;
 		table root;
 		source_position prev_pos = { 1, 1 };
 		const utf8_codepoint* cp = {};
-		std::vector<table*> implicit_tables;
-		std::vector<table*> dotted_key_tables;
-		std::vector<table*> open_inline_tables;
-		std::vector<array*> table_arrays;
-		parse_key_buffer key_buffer;
-		std::string string_buffer;
-		std::string recording_buffer; // for diagnostics
+		parse_scratch own_scratch; // used when there's no parse_context to borrow one from
+		parse_scratch& scratch;
 		bool recording = false, recording_whitespace = true;
 		std::string_view current_scope;
 		size_t nested_values = {};
+		table* current_table = &root;
+		bool parsed_any		 = false;
+		node_arena* arena	 = {};
+		bool track_sources	 = true;
+		bool pack_arrays	 = false;
+		bool compact_arrays	 = false;
+		bool borrow_strings	 = false;
+		node_ptr spare_value; // see append_packed()
 #if !TOML_EXCEPTIONS
 		mutable optional<parse_error> err;
 #endif
 
+		template <typename T, typename... Args>
+		TOML_NODISCARD
+		node_ptr new_node(Args&&... args)
+		{
+			if (arena)
+			{
+				const auto n = arena->create<T>(static_cast<Args&&>(args)...);
+				if constexpr (impl::is_one_of<T, table, array>)
+					n->arena_ = arena_ref{ arena }; // (so they can be moved out of the document)
+				return node_ptr{ n };
+			}
+			return node_ptr{ new T{ static_cast<Args&&>(args)... } };
+		}
+
+		template <typename T>
+		TOML_NODISCARD
+		node_ptr new_value(T&& val)
+		{
+			using native_type = impl::native_type_of<impl::remove_cvref<T>>;
+			if constexpr (!std::is_same_v<native_type, std::string>)
+			{
+				if (spare_value && spare_value->type() == impl::node_type_of<native_type>)
+				{
+					spare_value->ref_cast<native_type>().get() = static_cast<T&&>(val);
+					return std::move(spare_value);
+				}
+			}
+			return new_node<value<native_type>>(static_cast<T&&>(val));
+		}
+
+		TOML_NODISCARD
+		node_ptr new_string_value(const parsed_string& str)
+		{
+			// with an arena, strings too long for std::string's own buffer are stored there instead of on the heap
+			const bool in_arena = arena && !str.borrowed && str.value.length() > std::string{}.capacity();
+			if (!str.borrowed && !in_arena)
+				return new_value(str.value);
+
+			auto val = new_node<value<std::string>>();
+			const auto text = in_arena ? arena->copy_string(str.value) : str.value;
+			static_cast<value<std::string>*>(val.get())->borrow(text, in_arena);
+			return val;
+		}
+
+		// the region given to new nodes and keys (left empty with parse_flags::no_source_tracking)
 		TOML_NODISCARD
-		source_position current_position(source_index fallback_offset = 0) const noexcept
+		source_region make_source_region(source_position begin, source_position end) const
+		{
+			if (!track_sources)
+				return {};
+			return { reader.resolve(begin), reader.resolve(end), reader.source_path() };
+		}
+
+		// (positions may only have their offsets until they're given to make_source_region() or set_error_at())
+		TOML_NODISCARD
+		source_position current_position(source_index fallback_offset = 0) const
 		{
 			if (!is_eof())
 				return cp->position;
-			return { prev_pos.line, static_cast<source_index>(prev_pos.column + fallback_offset) };
+
+			// at EOF it's the position following the last character, on the same line
+			source_position pos = reader.resolve(prev_pos);
+			pos.column += fallback_offset;
+			if (fallback_offset)
+				pos.offset = reader.end_offset();
+			return pos;
 		}
 
 		template <typename... T>
@@ -13601,9 +19434,9 @@ TOML_IMPL_NAMESPACE_START
 			parse_error_break();
 
 #if TOML_EXCEPTIONS
-			builder.finish(pos, reader.source_path());
+			builder.finish(reader.resolve(pos), reader.source_path());
 #else
-			err.emplace(builder.finish(pos, reader.source_path()));
+			err.emplace(builder.finish(reader.resolve(pos), reader.source_path()));
 #endif
 		}
 
@@ -13642,7 +19475,7 @@ TOML_IMPL_NAMESPACE_START
 			if (recording && !is_eof())
 			{
 				if (recording_whitespace || !is_whitespace(*cp))
-					recording_buffer.append(cp->bytes, cp->count);
+					scratch.recording_buffer.append(cp->bytes, cp->count);
 			}
 		}
 
@@ -13652,9 +19485,9 @@ TOML_IMPL_NAMESPACE_START
 
 			recording			 = true;
 			recording_whitespace = true;
-			recording_buffer.clear();
+			scratch.recording_buffer.clear();
 			if (include_current && !is_eof())
-				recording_buffer.append(cp->bytes, cp->count);
+				scratch.recording_buffer.append(cp->bytes, cp->count);
 		}
 
 		void stop_recording(size_t pop_bytes = 0) noexcept
@@ -13664,14 +19497,71 @@ TOML_IMPL_NAMESPACE_START
 			recording = false;
 			if (pop_bytes)
 			{
-				if (pop_bytes >= recording_buffer.length())
-					recording_buffer.clear();
+				if (pop_bytes >= scratch.recording_buffer.length())
+					scratch.recording_buffer.clear();
 				else if (pop_bytes == 1u)
-					recording_buffer.pop_back();
+					scratch.recording_buffer.pop_back();
 				else
-					recording_buffer.erase(recording_buffer.begin()
-											   + static_cast<ptrdiff_t>(recording_buffer.length() - pop_bytes),
-										   recording_buffer.end());
+					scratch.recording_buffer.erase(scratch.recording_buffer.begin()
+											   + static_cast<ptrdiff_t>(scratch.recording_buffer.length() - pop_bytes),
+										   scratch.recording_buffer.end());
+			}
+		}
+
+		// consumes a run of ASCII characters (not including line breaks) in one go, rather than one at a time.
+		// 'scan' is given the remaining source starting at the current character and returns the length of the run.
+		// only possible when the whole document is in memory; returns the consumed characters (empty if none).
+		template <typename Func>
+		std::string_view consume_ascii_run(Func&& scan)
+		{
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				return_if_error_or_eof({});
+
+				// runs never start with a non-ASCII character, so don't bother going through the SIMD dispatch table
+				if (cp->count > 1u)
+					return {};
+
+				const auto source = reader.remaining();
+				const auto run	  = source.substr(0, static_cast<Func&&>(scan)(source.data(), source.length()));
+				if (run.empty())
+					return {};
+
+				if (recording)
+				{
+					if (recording_whitespace)
+						scratch.recording_buffer.append(run.data() + 1u, run.length() - 1u);
+					else
+					{
+						for (auto c : run.substr(1))
+							if (!is_ascii_horizontal_whitespace(static_cast<char32_t>(static_cast<unsigned char>(c))))
+								scratch.recording_buffer += c;
+					}
+				}
+
+				prev_pos = cp->position;
+				prev_pos.offset += static_cast<source_index>(run.length() - 1u);
+				cp = reader.skip_ascii(run.length());
+
+#if !TOML_EXCEPTIONS
+				if (reader.error())
+				{
+					err = std::move(reader.error());
+					return run;
+				}
+#endif
+
+				if (recording && !is_eof())
+				{
+					if (recording_whitespace || !is_whitespace(*cp))
+						scratch.recording_buffer.append(cp->bytes, cp->count);
+				}
+				return run;
+			}
+			else
+			{
+				TOML_UNUSED(scan);
+				return {};
 			}
 		}
 
@@ -13686,7 +19576,9 @@ TOML_IMPL_NAMESPACE_START
 					set_error_and_return_default("expected space or tab, saw '"sv, escaped_codepoint{ *cp }, "'"sv);
 
 				consumed = true;
-				advance_and_return_if_error({});
+				if (consume_ascii_run(impl::horizontal_whitespace_prefix_length).empty())
+					advance();
+				return_if_error({});
 			}
 			return consumed;
 		}
@@ -13726,7 +19618,7 @@ TOML_IMPL_NAMESPACE_START
 			{
 				if (is_ascii_vertical_whitespace(*cp))
 					return consume_line_break();
-				else
+				else if (consume_ascii_run(printable_ascii_prefix_length).empty())
 					advance();
 				return_if_error({});
 			}
@@ -13752,6 +19644,13 @@ TOML_IMPL_NAMESPACE_START
 					return true;
 				return_if_error({});
 
+				// skip runs of printable ASCII in one go
+				if (!consume_ascii_run(printable_ascii_prefix_length).empty())
+				{
+					return_if_error({});
+					continue;
+				}
+
 #if TOML_LANG_AT_LEAST(1, 0, 0)
 
 				// toml/issues/567 (disallow non-TAB control characters in comments)
@@ -13847,7 +19746,7 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_if_eof({});
 			}
 
-			auto& str = string_buffer;
+			auto& str = scratch.string_buffer;
 			str.clear();
 			bool escaped			 = false;
 			bool skipping_whitespace = false;
@@ -13964,6 +19863,17 @@ TOML_IMPL_NAMESPACE_START
 				}
 				else
 				{
+					// bulk-append runs of characters that don't need any special handling
+					if (!skipping_whitespace)
+					{
+						if (const auto run = consume_ascii_run(basic_string_prefix_length); !run.empty())
+						{
+							str.append(run);
+							return_if_error({});
+							continue;
+						}
+					}
+
 					// handle closing delimiters
 					if (*cp == U'"')
 					{
@@ -14089,12 +19999,19 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_if_eof({});
 			}
 
-			auto& str = string_buffer;
+			auto& str = scratch.string_buffer;
 			str.clear();
 			do
 			{
 				return_if_error({});
 
+				// bulk-append runs of characters that don't need any special handling
+				if (const auto run = consume_ascii_run(literal_string_prefix_length); !run.empty())
+				{
+					str.append(run);
+					continue;
+				}
+
 				// handle closing delimiters
 				if (*cp == U'\'')
 				{
@@ -14212,6 +20129,23 @@ TOML_IMPL_NAMESPACE_START
 				// character is the string delimiter
 				go_back(2u);
 
+				if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+				{
+					if (borrow_strings)
+					{
+						const auto source = reader.remaining();
+						const auto str	  = first == U'\'' ? parse_literal_string(false) : parse_basic_string(false);
+						return_if_error({});
+
+						// escape sequences are always longer than what they stand for, so a string without any is
+						// exactly as long as the text between its delimiters (and identical to it)
+						const auto consumed = source.length() - (is_eof() ? 0u : reader.remaining().length());
+						if (str.length() == consumed - 2u)
+							return { source.substr(1u, str.length()), false, true };
+						return { str, false };
+					}
+				}
+
 				return { first == U'\'' ? parse_literal_string(false) : parse_basic_string(false), false };
 			}
 		}
@@ -14224,18 +20158,18 @@ TOML_IMPL_NAMESPACE_START
 			assert_not_eof();
 			TOML_ASSERT_ASSUME(is_bare_key_character(*cp));
 
-			string_buffer.clear();
+			scratch.string_buffer.clear();
 
 			while (!is_eof())
 			{
 				if (!is_bare_key_character(*cp))
 					break;
 
-				string_buffer.append(cp->bytes, cp->count);
+				scratch.string_buffer.append(cp->bytes, cp->count);
 				advance_and_return_if_error({});
 			}
 
-			return string_buffer;
+			return scratch.string_buffer;
 		}
 
 		TOML_NODISCARD
@@ -14253,7 +20187,7 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_default("expected '"sv,
 											 to_sv(result),
 											 "', saw '"sv,
-											 to_sv(recording_buffer),
+											 to_sv(scratch.recording_buffer),
 											 "'"sv);
 			stop_recording();
 
@@ -14282,7 +20216,7 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_default("expected '"sv,
 											 inf ? "inf"sv : "nan"sv,
 											 "', saw '"sv,
-											 to_sv(recording_buffer),
+											 to_sv(scratch.recording_buffer),
 											 "'"sv);
 			stop_recording();
 
@@ -14308,7 +20242,7 @@ TOML_IMPL_NAMESPACE_START
 				advance_and_return_if_error_or_eof({});
 
 			// consume value chars
-			char chars[utf8_buffered_reader::max_history_length];
+			char chars[max_numeric_length];
 			size_t length			   = {};
 			const utf8_codepoint* prev = {};
 			bool seen_decimal = false, seen_exponent = false;
@@ -14424,6 +20358,9 @@ TOML_IMPL_NAMESPACE_START
 						break;
 
 					case std::errc::result_out_of_range:
+						// values too small to represent round to zero, same as without charconv
+						if (impl::decimal_to_double(std::string_view{ chars, length }, result))
+							return result * sign;
 						set_error_and_return_default("'"sv,
 													 std::string_view{ chars, length },
 													 "' is not representable in 64 bits"sv);
@@ -14436,17 +20373,12 @@ TOML_IMPL_NAMESPACE_START
 				}
 			}
 #else
-			{
-				std::stringstream ss;
-				ss.imbue(std::locale::classic());
-				ss.write(chars, static_cast<std::streamsize>(length));
-				if ((ss >> result))
-					return result * sign;
-				else
-					set_error_and_return_default("'"sv,
-												 std::string_view{ chars, length },
-												 "' could not be interpreted as a value"sv);
-			}
+			if TOML_LIKELY(impl::decimal_to_double(std::string_view{ chars, length }, result))
+				return result * sign;
+			else
+				set_error_and_return_default("'"sv,
+											 std::string_view{ chars, length },
+											 "' is not representable in 64 bits"sv);
 #endif
 		}
 
@@ -14483,7 +20415,6 @@ TOML_IMPL_NAMESPACE_START
 			{
 				char chars[24];
 				size_t length;
-				double value;
 			};
 			fragment fragments[] = {
 				{}, // mantissa, whole part
@@ -14572,51 +20503,19 @@ TOML_IMPL_NAMESPACE_START
 				set_error_and_return_default("underscores must be followed by digits"sv);
 			}
 
-			// calculate values for the three fragments
-			for (int fragment_idx = 0; fragment_idx < 3; fragment_idx++)
-			{
-				auto& f				= fragments[fragment_idx];
-				const uint32_t base = fragment_idx == 2 ? 10u : 16u;
-
-				// left-trim zeroes
-				const char* c = f.chars;
-				size_t sig	  = {};
-				while (f.length && *c == '0')
-				{
-					f.length--;
-					c++;
-					sig++;
-				}
-				if (!f.length)
-					continue;
-
-				// calculate value
-				auto place = 1u;
-				for (size_t i = 0; i < f.length - 1u; i++)
-					place *= base;
-				uint32_t val{};
-				while (place)
-				{
-					if (base == 16)
-						val += place * hex_to_dec(*c);
-					else
-						val += place * static_cast<uint32_t>(*c - '0');
-					if (fragment_idx == 1)
-						sig++;
-					c++;
-					place /= base;
-				}
-				f.value = static_cast<double>(val);
+			// exponent (clamped well past the point where the value is zero or infinite either way)
+			int64_t exponent = {};
+			for (size_t i = 0; i < fragments[2].length; i++)
+				exponent = impl::min(exponent * 10 + (fragments[2].chars[i] - '0'), int64_t{ 100000 });
 
-				// shift the fractional part
-				if (fragment_idx == 1)
-				{
-					while (sig--)
-						f.value /= base;
-				}
-			}
+			double result;
+			if (!impl::hex_to_double(std::string_view{ fragments[0].chars, fragments[0].length },
+									 std::string_view{ fragments[1].chars, fragments[1].length },
+									 exponent * exponent_sign,
+									 result))
+				set_error_and_return_default("value is not representable in 64 bits"sv);
 
-			return (fragments[0].value + fragments[1].value) * pow(2.0, fragments[2].value * exponent_sign) * sign;
+			return result * sign;
 
 #else // !TOML_LANG_UNRELEASED
 
@@ -14626,6 +20525,56 @@ TOML_IMPL_NAMESPACE_START
 #endif // !TOML_LANG_UNRELEASED
 		}
 
+		// the fast paths for contiguous inputs, shared by the typed parsers below and parse_value_single_pass().
+		// each converts a value in its usual form straight out of the source, consuming it, or returns false
+		// without consuming anything so the caller can take the slow path.
+
+		// (prefix_length is the length of the '0x'/'0o'/'0b' in front of the digits, if it hasn't been consumed yet)
+		template <uint64_t base>
+		TOML_NODISCARD
+		bool consume_integer(size_t prefix_length, bool negative, int64_t& value)
+		{
+			static constexpr auto i64_max = static_cast<uint64_t>((std::numeric_limits<int64_t>::max)());
+
+			uint64_t result = {};
+			const auto run	= consume_ascii_run(
+				 [&](const char* str, size_t len) noexcept -> size_t
+				 {
+					 if (len <= prefix_length
+						 || !parse_integer_traits<base>::is_digit(
+							 static_cast<char32_t>(static_cast<unsigned char>(str[prefix_length]))))
+						 return {};
+
+					 const auto length = scan_integer<base>(str + prefix_length,
+															len - prefix_length,
+															i64_max + (negative ? 1u : 0u),
+															max_numeric_length,
+															result);
+					 return length ? length + prefix_length : 0u;
+				 });
+			if (run.empty())
+				return false;
+
+			// avoid signed negation UB for INT64_MIN
+			if (!negative)
+				value = static_cast<int64_t>(result);
+			else if (result == i64_max + 1u)
+				value = (std::numeric_limits<int64_t>::min)();
+			else
+				value = -static_cast<int64_t>(result);
+			return true;
+		}
+
+		// dates, times and date-times in their canonical layout (see scan_date() etc.)
+		template <typename T>
+		TOML_NODISCARD
+		bool consume_canonical(size_t (*scan)(const char*, size_t, T&) noexcept, T& value)
+		{
+			return !consume_ascii_run([&](const char* str, size_t len) noexcept
+									  { return scan_whole_value(scan, str, len, value); })
+						.empty();
+		}
+
 		template <uint64_t base>
 		TOML_NODISCARD
 		TOML_NEVER_INLINE
@@ -14665,8 +20614,19 @@ TOML_IMPL_NAMESPACE_START
 					set_error_and_return_default("expected digit, saw '"sv, to_sv(*cp), "'"sv);
 			}
 
+			// convert the digits straight out of the source if they're all there (and well-formed)
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				int64_t result;
+				if (consume_integer<base>(0u, sign < 0, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			// consume digits
-			char digits[utf8_buffered_reader::max_history_length];
+			char digits[max_numeric_length];
 			size_t length			   = {};
 			const utf8_codepoint* prev = {};
 			while (!is_eof() && !is_value_terminator(*cp))
@@ -14787,12 +20747,22 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_decimal_digit(*cp));
 			push_parse_scope("date"sv);
 
+			// canonical layout, straight out of the source
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				date result;
+				if (!part_of_datetime && consume_canonical(scan_date, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			// "YYYY"
 			uint32_t digits[4];
 			if (!consume_digit_sequence(digits, 4u))
 				set_error_and_return_default("expected 4-digit year, saw '"sv, to_sv(cp), "'"sv);
-			const auto year			= digits[3] + digits[2] * 10u + digits[1] * 100u + digits[0] * 1000u;
-			const auto is_leap_year = (year % 4u == 0u) && ((year % 100u != 0u) || (year % 400u == 0u));
+			const auto year = digits[3] + digits[2] * 10u + digits[1] * 100u + digits[0] * 1000u;
 			set_error_and_return_if_eof({});
 
 			// '-'
@@ -14806,9 +20776,7 @@ TOML_IMPL_NAMESPACE_START
 			const auto month = digits[1] + digits[0] * 10u;
 			if (month == 0u || month > 12u)
 				set_error_and_return_default("expected month between 1 and 12 (inclusive), saw "sv, month);
-			const auto max_days_in_month = month == 2u
-											 ? (is_leap_year ? 29u : 28u)
-											 : (month == 4u || month == 6u || month == 9u || month == 11u ? 30u : 31u);
+			const auto max_days_in_month = days_in_month(year, month);
 			set_error_and_return_if_eof({});
 
 			// '-'
@@ -14841,6 +20809,17 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_decimal_digit(*cp));
 			push_parse_scope("time"sv);
 
+			// canonical layout, straight out of the source
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				time result;
+				if (!part_of_datetime && consume_canonical(scan_time, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			static constexpr size_t max_digits = 64; // far more than necessary but needed to allow fractional
 													 // millisecond truncation per the spec
 			uint32_t digits[max_digits];
@@ -14929,6 +20908,17 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_decimal_digit(*cp));
 			push_parse_scope("date-time"sv);
 
+			// canonical layout, straight out of the source
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				date_time result;
+				if (consume_canonical(scan_date_time, result))
+				{
+					return_if_error({});
+					return result;
+				}
+			}
+
 			// "YYYY-MM-DD"
 			auto date = parse_date(true);
 			set_error_and_return_if_eof({});
@@ -14992,6 +20982,51 @@ TOML_IMPL_NAMESPACE_START
 		TOML_NODISCARD
 		node_ptr parse_array();
 
+		// appends a value to an array being parsed with parse_flags::packed_arrays or parse_flags::compact_arrays
+		// if it can be stored without its node, keeping the node around to be reused by the next new_value() of the
+		// same type
+		bool append_packed(array& arr, node_ptr& val)
+		{
+			const auto type = val->type();
+			const auto packable =
+				type == node_type::integer || type == node_type::floating_point || type == node_type::boolean;
+			if (!packable && !(compact_arrays && val->is_value() && type != node_type::string))
+				return false;
+			if (type == node_type::integer && val->ref_cast<int64_t>().flags() != value_flags::none)
+				return false;
+
+			if (!arr.packed_)
+			{
+				if (!arr.elems_.empty())
+					return false;
+				arr.packed_ = packed_array_storage::create(packable ? type : node_type::none, arr.node_resource());
+			}
+			else if (arr.packed_->type != type && arr.packed_->type != node_type::none)
+			{
+				if (!compact_arrays)
+					return false;
+				arr.packed_->convert_to_compact();
+			}
+
+			switch (arr.packed_->type)
+			{
+				case node_type::integer: arr.packed_->push_back(val->ref_cast<int64_t>().get()); break;
+				case node_type::floating_point: arr.packed_->push_back(val->ref_cast<double>().get()); break;
+				case node_type::boolean: arr.packed_->push_back(val->ref_cast<bool>().get()); break;
+				case node_type::none:
+				{
+					compact_value compact;
+					[[maybe_unused]] const auto assigned = compact.assign(*val);
+					TOML_ASSERT(assigned);
+					arr.packed_->push_back(compact);
+					break;
+				}
+				default: TOML_UNREACHABLE;
+			}
+			spare_value = std::move(val);
+			return true;
+		}
+
 		TOML_NODISCARD
 		node_ptr parse_inline_table();
 
@@ -15012,11 +21047,11 @@ TOML_IMPL_NAMESPACE_START
 				case U'{': return parse_inline_table();
 
 				// floats beginning with '.'
-				case U'.': return node_ptr{ new value{ parse_float() } };
+				case U'.': return new_value(parse_float());
 
 				// strings
 				case U'"': [[fallthrough]];
-				case U'\'': return node_ptr{ new value{ parse_string().value } };
+				case U'\'': return new_string_value(parse_string());
 
 				default:
 				{
@@ -15024,11 +21059,11 @@ TOML_IMPL_NAMESPACE_START
 
 					// bools
 					if (cp_upper == 70u || cp_upper == 84u) // F or T
-						return node_ptr{ new value{ parse_boolean() } };
+						return new_value(parse_boolean());
 
 					// inf/nan
 					else if (cp_upper == 73u || cp_upper == 78u) // I or N
-						return node_ptr{ new value{ parse_inf_or_nan() } };
+						return new_value(parse_inf_or_nan());
 
 					else
 						return nullptr;
@@ -15037,6 +21072,98 @@ TOML_IMPL_NAMESPACE_START
 			TOML_UNREACHABLE;
 		}
 
+		// identifies and converts the common forms of integers, floats, dates and times in a single pass straight
+		// out of the source, for when the whole document is in memory. returns nullptr without consuming anything
+		// if the value isn't one of those (or is malformed), leaving it to the trait scan in parse_value().
+		TOML_NODISCARD
+		node_ptr parse_value_single_pass()
+		{
+			return_if_error({});
+			assert_not_eof();
+
+			if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+			{
+				const auto source = reader.remaining();
+
+				// dates and date-times
+				if (source.length() >= 10u && source[4] == '-')
+				{
+					date_time dt;
+					if (consume_canonical(scan_date_time, dt))
+					{
+						return_if_error({});
+						return new_value(dt);
+					}
+
+					// (a date followed by a space and a digit is a malformed date-time, not a date)
+					if (source.length() >= 12u && source[10] == ' '
+						&& is_decimal_digit(static_cast<char32_t>(static_cast<unsigned char>(source[11]))))
+						return nullptr;
+
+					if (!consume_canonical(scan_date, dt.date))
+						return nullptr;
+					return_if_error({});
+					return new_value(dt.date);
+				}
+
+				// times
+				if (source.length() >= 8u && source[2] == ':')
+				{
+					time t;
+					if (!consume_canonical(scan_time, t))
+						return nullptr;
+					return_if_error({});
+					return new_value(t);
+				}
+
+				// hexadecimal, octal and binary integers
+				if (source.length() >= 3u && source[0] == '0' && (source[1] == 'x' || source[1] == 'o' || source[1] == 'b'))
+				{
+					int64_t result;
+					value_flags flags;
+					bool consumed;
+					switch (source[1])
+					{
+						case 'x':
+							consumed = consume_integer<16>(2u, false, result);
+							flags	 = value_flags::format_as_hexadecimal;
+							break;
+
+						case 'o':
+							consumed = consume_integer<8>(2u, false, result);
+							flags	 = value_flags::format_as_octal;
+							break;
+
+						default:
+							consumed = consume_integer<2>(2u, false, result);
+							flags	 = value_flags::format_as_binary;
+							break;
+					}
+					if (!consumed)
+						return nullptr;
+					return_if_error({});
+
+					node_ptr val = new_value(result);
+					val->ref_cast<int64_t>().flags(flags);
+					return val;
+				}
+
+				// decimal integers and floats
+				decimal_number number;
+				if (consume_ascii_run([&](const char* str, size_t len) noexcept
+									  { return scan_decimal_number<max_numeric_length>(str, len, number); })
+						.empty())
+					return nullptr;
+				return_if_error({});
+
+				if (number.is_float)
+					return new_value(number.floating_point);
+				return new_value(number.integer);
+			}
+			else
+				return nullptr;
+		}
+
 		TOML_NODISCARD
 		node_ptr parse_value()
 		{
@@ -15078,6 +21205,11 @@ TOML_IMPL_NAMESPACE_START
 				if (val)
 					break;
 
+				val = parse_value_single_pass();
+				return_if_error({});
+				if (val)
+					break;
+
 				// value types from here down require more than one character to unambiguously identify
 				// so scan ahead and collect a set of value 'traits'.
 				enum TOML_CLOSED_FLAGS_ENUM value_traits : int
@@ -15121,20 +21253,24 @@ TOML_IMPL_NAMESPACE_START
 					break;
 
 				// scan the rest of the value to determine the remaining traits
-				char32_t chars[utf8_buffered_reader::max_history_length];
+				// (only the first few characters are actually needed to identify the type; the rest are just counted)
+				char32_t chars[16];
 				size_t char_count = {}, advance_count = {};
 				bool eof_while_scanning = false;
 				const auto scan			= [&]() noexcept(!TOML_COMPILER_HAS_EXCEPTIONS)
 				{
-					if (is_eof())
+					// (is_value_terminator() is reachable when the date-time check below has consumed a
+					// date, a space and a single digit, e.g. "1979-05-27 0\n")
+					if (is_eof() || is_value_terminator(*cp))
 						return;
-					TOML_ASSERT_ASSUME(!is_value_terminator(*cp));
 
 					do
 					{
 						if (const auto c = **cp; c != U'_')
 						{
-							chars[char_count++] = c;
+							if (char_count < std::size(chars))
+								chars[char_count] = c;
+							char_count++;
 
 							if (is_decimal_digit(c))
 								add_trait(has_digits);
@@ -15192,7 +21328,7 @@ TOML_IMPL_NAMESPACE_START
 						advance_count++;
 						eof_while_scanning = is_eof();
 					}
-					while (advance_count < (utf8_buffered_reader::max_history_length - 1u) && !is_eof()
+					while (advance_count < (utf8_buffered_reader<Reader>::max_history_length - 1u) && !is_eof()
 						   && !is_value_terminator(*cp));
 				};
 				scan();
@@ -15248,7 +21384,7 @@ TOML_IMPL_NAMESPACE_START
 				{
 					if (has_any(begins_digit))
 					{
-						val.reset(new value{ static_cast<int64_t>(chars[0] - U'0') });
+						val = new_value(static_cast<int64_t>(chars[0] - U'0'));
 						advance(); // skip the digit
 						break;
 					}
@@ -15267,7 +21403,7 @@ TOML_IMPL_NAMESPACE_START
 				// typed parse functions to take over and show better diagnostics if there's an issue
 				// (as opposed to the fallback "could not determine type" message)
 				if (has_any(has_p))
-					val.reset(new value{ parse_hex_float() });
+					val = new_value(parse_hex_float());
 				else if (has_any(has_x | has_o | has_b))
 				{
 					int64_t i;
@@ -15289,17 +21425,17 @@ TOML_IMPL_NAMESPACE_START
 					}
 					return_if_error({});
 
-					val.reset(new value{ i });
+					val = new_value(i);
 					val->ref_cast<int64_t>().flags(flags);
 				}
 				else if (has_any(has_e) || (has_any(begins_digit) && chars[1] == U'.'))
-					val.reset(new value{ parse_float() });
+					val = new_value(parse_float());
 				else if (has_any(begins_sign))
 				{
 					// single-digit signed integers
 					if (char_count == 2u && has_any(has_digits))
 					{
-						val.reset(new value{ static_cast<int64_t>(chars[1] - U'0') * (chars[0] == U'-' ? -1LL : 1LL) });
+						val = new_value(static_cast<int64_t>(chars[1] - U'0') * (chars[0] == U'-' ? -1LL : 1LL));
 						advance(); // skip the sign
 						advance(); // skip the digit
 						break;
@@ -15307,11 +21443,11 @@ TOML_IMPL_NAMESPACE_START
 
 					// simple signed floats (e.g. +1.0)
 					if (is_decimal_digit(chars[1]) && chars[2] == U'.')
-						val.reset(new value{ parse_float() });
+						val = new_value(parse_float());
 
 					// signed infinity or nan
 					else if (is_match(chars[1], U'i', U'n', U'I', U'N'))
-						val.reset(new value{ parse_inf_or_nan() });
+						val = new_value(parse_inf_or_nan());
 				}
 
 				return_if_error({});
@@ -15327,14 +21463,14 @@ TOML_IMPL_NAMESPACE_START
 					// binary integers
 					// 0b10
 					case bzero_msk | has_b:
-						val.reset(new value{ parse_integer<2>() });
+						val = new_value(parse_integer<2>());
 						val->ref_cast<int64_t>().flags(value_flags::format_as_binary);
 						break;
 
 					// octal integers
 					// 0o10
 					case bzero_msk | has_o:
-						val.reset(new value{ parse_integer<8>() });
+						val = new_value(parse_integer<8>());
 						val->ref_cast<int64_t>().flags(value_flags::format_as_octal);
 						break;
 
@@ -15354,20 +21490,20 @@ TOML_IMPL_NAMESPACE_START
 						//
 						// (this will likely only come up during fuzzing and similar scenarios)
 						static constexpr size_t max_numeric_value_length =
-							utf8_buffered_reader::max_history_length - 2u;
+							utf8_buffered_reader<Reader>::max_history_length - 2u;
 						if TOML_UNLIKELY(!eof_while_scanning && advance_count > max_numeric_value_length)
 							set_error_and_return_default("numeric value too long to identify type - cannot exceed "sv,
 														 max_numeric_value_length,
 														 " characters"sv);
 
-						val.reset(new value{ parse_integer<10>() });
+						val = new_value(parse_integer<10>());
 						break;
 					}
 
 					// hexadecimal integers
 					// 0x10
 					case bzero_msk | has_x:
-						val.reset(new value{ parse_integer<16>() });
+						val = new_value(parse_integer<16>());
 						val->ref_cast<int64_t>().flags(value_flags::format_as_hexadecimal);
 						break;
 
@@ -15420,7 +21556,7 @@ TOML_IMPL_NAMESPACE_START
 					case begins_sign | has_digits | has_e | signs_msk: [[fallthrough]];
 					case begins_sign | has_digits | has_dot | has_minus: [[fallthrough]];
 					case begins_sign | has_digits | has_dot | has_e | has_minus:
-						val.reset(new value{ parse_float() });
+						val = new_value(parse_float());
 						break;
 
 					// hexadecimal floats
@@ -15454,7 +21590,7 @@ TOML_IMPL_NAMESPACE_START
 					case begins_sign | has_digits | has_x | has_dot | has_p | has_minus: [[fallthrough]];
 					case begins_sign | has_digits | has_x | has_dot | has_p | has_plus: [[fallthrough]];
 					case begins_sign | has_digits | has_x | has_dot | has_p | signs_msk:
-						val.reset(new value{ parse_hex_float() });
+						val = new_value(parse_hex_float());
 						break;
 
 					// times
@@ -15464,12 +21600,12 @@ TOML_IMPL_NAMESPACE_START
 					case bzero_msk | has_colon: [[fallthrough]];
 					case bzero_msk | has_colon | has_dot: [[fallthrough]];
 					case bdigit_msk | has_colon: [[fallthrough]];
-					case bdigit_msk | has_colon | has_dot: val.reset(new value{ parse_time() }); break;
+					case bdigit_msk | has_colon | has_dot: val = new_value(parse_time()); break;
 
 					// local dates
 					// YYYY-MM-DD
 					case bzero_msk | has_minus: [[fallthrough]];
-					case bdigit_msk | has_minus: val.reset(new value{ parse_date() }); break;
+					case bdigit_msk | has_minus: val = new_value(parse_date()); break;
 
 					// date-times
 					// YYYY-MM-DDTHH:MM
@@ -15508,7 +21644,7 @@ TOML_IMPL_NAMESPACE_START
 					case bzero_msk | has_minus | has_colon | has_dot | has_z | has_t: [[fallthrough]];
 					case bdigit_msk | has_minus | has_colon | has_z | has_t: [[fallthrough]];
 					case bdigit_msk | has_minus | has_colon | has_dot | has_z | has_t:
-						val.reset(new value{ parse_date_time() });
+						val = new_value(parse_date_time());
 						break;
 				}
 			}
@@ -15520,7 +21656,7 @@ TOML_IMPL_NAMESPACE_START
 				return_after_error({});
 			}
 
-			val->source_ = { begin_pos, current_position(1), reader.source_path() };
+			val->source_ = make_source_region(begin_pos, current_position(1));
 			return val;
 		}
 
@@ -15532,17 +21668,26 @@ TOML_IMPL_NAMESPACE_START
 			TOML_ASSERT_ASSUME(is_bare_key_character(*cp) || is_string_delimiter(*cp));
 			push_parse_scope("key"sv);
 
-			key_buffer.clear();
+			scratch.key_buffer.clear();
 			recording_whitespace = false;
 
 			while (!is_error())
 			{
 				std::string_view key_segment;
-				const auto key_begin = current_position();
+				const char* key_source = {}; // (see parse_flags::borrowed_strings)
+				const auto key_begin   = current_position();
 
 				// bare_key_segment
 				if (is_bare_key_character(*cp))
+				{
+					if constexpr (utf8_buffered_reader<Reader>::is_contiguous)
+					{
+						// bare keys are all ASCII, so one is always exactly the text it was parsed from
+						if (borrow_strings)
+							key_source = reader.remaining().data();
+					}
 					key_segment = parse_bare_key_segment();
+				}
 
 				// "quoted key segment"
 				else if (is_string_delimiter(*cp))
@@ -15558,12 +21703,16 @@ TOML_IMPL_NAMESPACE_START
 					{
 						set_error_at(begin_pos,
 									 "multi-line strings are prohibited in "sv,
-									 key_buffer.empty() ? ""sv : "dotted "sv,
+									 scratch.key_buffer.empty() ? ""sv : "dotted "sv,
 									 "keys"sv);
 						return_after_error({});
 					}
 					else
+					{
 						key_segment = str.value;
+						if (str.borrowed)
+							key_source = str.value.data();
+					}
 				}
 
 				// ???
@@ -15578,9 +21727,9 @@ TOML_IMPL_NAMESPACE_START
 				consume_leading_whitespace();
 
 				// store segment
-				key_buffer.push_back(key_segment, key_begin, key_end);
+				scratch.key_buffer.push_back(key_segment, key_begin, key_end, key_source);
 
-				if TOML_UNLIKELY(key_buffer.size() > max_dotted_keys_depth)
+				if TOML_UNLIKELY(scratch.key_buffer.size() > max_dotted_keys_depth)
 					set_error_and_return_default("exceeded maximum dotted keys depth of "sv,
 												 max_dotted_keys_depth,
 												 " (TOML_MAX_DOTTED_KEYS_DEPTH)"sv);
@@ -15602,12 +21751,19 @@ TOML_IMPL_NAMESPACE_START
 		TOML_NODISCARD
 		key make_key(size_t segment_index) const
 		{
-			TOML_ASSERT(key_buffer.size() > segment_index);
+			TOML_ASSERT(scratch.key_buffer.size() > segment_index);
 
-			return key{
-				key_buffer[segment_index],
-				source_region{ key_buffer.starts[segment_index], key_buffer.ends[segment_index], root.source().path }
-			};
+			const auto& buf = scratch.key_buffer;
+			const auto text = buf[segment_index];
+			auto region		= make_source_region(buf.starts[segment_index], buf.ends[segment_index]);
+
+			if (const auto source = buf.sources[segment_index])
+				return key{ key_text::borrow({ source, text.length() }), std::move(region) };
+
+			// with an arena, keys too long for std::string's own buffer are stored there (the same as long strings)
+			if (arena && text.length() > std::string{}.capacity())
+				return key{ key_text::borrow(arena->copy(text)), std::move(region) };
+			return key{ text, std::move(region) };
 		}
 
 		TOML_NODISCARD
@@ -15679,13 +21835,13 @@ TOML_IMPL_NAMESPACE_START
 				if (!is_eof() && !consume_comment() && !consume_line_break())
 					set_error_and_return_default("expected a comment or whitespace, saw '"sv, to_sv(cp), "'"sv);
 			}
-			TOML_ASSERT(!key_buffer.empty());
+			TOML_ASSERT(!scratch.key_buffer.empty());
 
 			// check if each parent is a table/table array, or can be created implicitly as a table.
 			table* parent = &root;
-			for (size_t i = 0, e = key_buffer.size() - 1u; i < e; i++)
+			for (size_t i = 0, e = scratch.key_buffer.size() - 1u; i < e; i++)
 			{
-				const std::string_view segment = key_buffer[i];
+				const std::string_view segment = scratch.key_buffer[i];
 				auto pit					   = parent->lower_bound(segment);
 
 				// parent already existed
@@ -15696,14 +21852,16 @@ TOML_IMPL_NAMESPACE_START
 					if (auto tbl = p.as_table())
 					{
 						// adding to closed inline tables is illegal
-						if (tbl->is_inline() && !impl::find(open_inline_tables.begin(), open_inline_tables.end(), tbl))
+						if (tbl->is_inline()
+							&& !impl::find(scratch.open_inline_tables.begin(), scratch.open_inline_tables.end(), tbl))
 							set_error_and_return_default("cannot insert '"sv,
-														 to_sv(recording_buffer),
+														 to_sv(scratch.recording_buffer),
 														 "' into existing inline table"sv);
 
 						parent = tbl;
 					}
-					else if (auto arr = p.as_array(); arr && impl::find(table_arrays.begin(), table_arrays.end(), arr))
+					else if (auto arr = p.as_array();
+							 arr && impl::find(scratch.table_arrays.begin(), scratch.table_arrays.end(), arr))
 					{
 						// table arrays are a special case;
 						// the spec dictates we select the most recently declared element in the array.
@@ -15715,13 +21873,13 @@ TOML_IMPL_NAMESPACE_START
 					{
 						if (!is_arr && p.type() == node_type::table)
 							set_error_and_return_default("cannot redefine existing table '"sv,
-														 to_sv(recording_buffer),
+														 to_sv(scratch.recording_buffer),
 														 "'"sv);
 						else
 							set_error_and_return_default("cannot redefine existing "sv,
 														 to_sv(p.type()),
 														 " '"sv,
-														 to_sv(recording_buffer),
+														 to_sv(scratch.recording_buffer),
 														 "' as "sv,
 														 is_arr ? "array-of-tables"sv : "table"sv);
 					}
@@ -15730,16 +21888,16 @@ TOML_IMPL_NAMESPACE_START
 				// need to create a new implicit table
 				else
 				{
-					pit		  = parent->emplace_hint<table>(pit, make_key(i));
+					pit		  = parent->emplace_hint<node_ptr>(pit, make_key(i), new_node<table>());
 					table& p  = pit->second.ref_cast<table>();
-					p.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					p.source_ = make_source_region(header_begin_pos, header_end_pos);
 
-					implicit_tables.push_back(&p);
+					scratch.implicit_tables.push_back(&p);
 					parent = &p;
 				}
 			}
 
-			const auto last_segment = key_buffer.back();
+			const auto last_segment = scratch.key_buffer.back();
 			auto it					= parent->lower_bound(last_segment);
 
 			// if there was already a matching node some sanity checking is necessary;
@@ -15750,15 +21908,16 @@ TOML_IMPL_NAMESPACE_START
 			{
 				node& matching_node = it->second;
 				if (auto arr = matching_node.as_array();
-					is_arr && arr && impl::find(table_arrays.begin(), table_arrays.end(), arr))
+					is_arr && arr && impl::find(scratch.table_arrays.begin(), scratch.table_arrays.end(), arr))
 				{
-					table& tbl	= arr->emplace_back<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					table& tbl	= arr->emplace_back<node_ptr>(new_node<table>()).template ref_cast<table>();
+					tbl.source_ = make_source_region(header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 
-				else if (auto tbl = matching_node.as_table(); !is_arr && tbl && !implicit_tables.empty())
+				else if (auto tbl = matching_node.as_table(); !is_arr && tbl && !scratch.implicit_tables.empty())
 				{
+					auto& implicit_tables = scratch.implicit_tables;
 					if (auto found = impl::find(implicit_tables.begin(), implicit_tables.end(), tbl); found)
 					{
 						bool ok = true;
@@ -15777,8 +21936,7 @@ TOML_IMPL_NAMESPACE_START
 						if (ok)
 						{
 							implicit_tables.erase(implicit_tables.cbegin() + (found - implicit_tables.data()));
-							tbl->source_.begin = header_begin_pos;
-							tbl->source_.end   = header_end_pos;
+							tbl->source_ = make_source_region(header_begin_pos, header_end_pos);
 							return tbl;
 						}
 					}
@@ -15789,7 +21947,7 @@ TOML_IMPL_NAMESPACE_START
 				{
 					set_error_at(header_begin_pos,
 								 "cannot redefine existing table '"sv,
-								 to_sv(recording_buffer),
+								 to_sv(scratch.recording_buffer),
 								 "'"sv);
 					return_after_error({});
 				}
@@ -15799,7 +21957,7 @@ TOML_IMPL_NAMESPACE_START
 								 "cannot redefine existing "sv,
 								 to_sv(matching_node.type()),
 								 " '"sv,
-								 to_sv(recording_buffer),
+								 to_sv(scratch.recording_buffer),
 								 "' as "sv,
 								 is_arr ? "array-of-tables"sv : "table"sv);
 					return_after_error({});
@@ -15809,28 +21967,28 @@ TOML_IMPL_NAMESPACE_START
 			// there was no matching node, sweet - we can freely instantiate a new table/table array.
 			else
 			{
-				auto last_key = make_key(key_buffer.size() - 1u);
+				auto last_key = make_key(scratch.key_buffer.size() - 1u);
 
 				// if it's an array we need to make the array and it's first table element,
 				// set the starting regions, and return the table element
 				if (is_arr)
 				{
-					it			   = parent->emplace_hint<array>(it, std::move(last_key));
+					it			   = parent->emplace_hint<node_ptr>(it, std::move(last_key), new_node<array>());
 					array& tbl_arr = it->second.ref_cast<array>();
-					table_arrays.push_back(&tbl_arr);
-					tbl_arr.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					scratch.table_arrays.push_back(&tbl_arr);
+					tbl_arr.source_ = make_source_region(header_begin_pos, header_end_pos);
 
-					table& tbl	= tbl_arr.emplace_back<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					table& tbl	= tbl_arr.emplace_back<node_ptr>(new_node<table>()).template ref_cast<table>();
+					tbl.source_ = make_source_region(header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 
 				// otherwise we're just making a table
 				else
 				{
-					it			= parent->emplace_hint<table>(it, std::move(last_key));
+					it			= parent->emplace_hint<node_ptr>(it, std::move(last_key), new_node<table>());
 					table& tbl	= it->second.ref_cast<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					tbl.source_ = make_source_region(header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 			}
@@ -15849,7 +22007,7 @@ TOML_IMPL_NAMESPACE_START
 			parse_key();
 			stop_recording(1u);
 			return_if_error({});
-			TOML_ASSERT(key_buffer.size() >= 1u);
+			TOML_ASSERT(scratch.key_buffer.size() >= 1u);
 
 			// skip past any whitespace that followed the key
 			consume_leading_whitespace();
@@ -15871,11 +22029,11 @@ TOML_IMPL_NAMESPACE_START
 
 			// if it's a dotted kvp we need to spawn the parent sub-tables if necessary,
 			// and set the target table to the second-to-last one in the chain
-			if (key_buffer.size() > 1u)
+			if (scratch.key_buffer.size() > 1u)
 			{
-				for (size_t i = 0; i < key_buffer.size() - 1u; i++)
+				for (size_t i = 0; i < scratch.key_buffer.size() - 1u; i++)
 				{
-					const std::string_view segment = key_buffer[i];
+					const std::string_view segment = scratch.key_buffer[i];
 					auto pit					   = tbl->lower_bound(segment);
 
 					// parent already existed
@@ -15885,10 +22043,10 @@ TOML_IMPL_NAMESPACE_START
 
 						// redefinition
 						if TOML_UNLIKELY(!p
-							|| !(impl::find(dotted_key_tables.begin(), dotted_key_tables.end(), p)
-								 || impl::find(implicit_tables.begin(), implicit_tables.end(), p)))
+							|| !(impl::find(scratch.dotted_key_tables.begin(), scratch.dotted_key_tables.end(), p)
+								 || impl::find(scratch.implicit_tables.begin(), scratch.implicit_tables.end(), p)))
 						{
-							set_error_at(key_buffer.starts[i],
+							set_error_at(scratch.key_buffer.starts[i],
 										 "cannot redefine existing "sv,
 										 to_sv(pit->second.type()),
 										 " as dotted key-value pair"sv);
@@ -15901,32 +22059,32 @@ TOML_IMPL_NAMESPACE_START
 					// need to create a new implicit table
 					else
 					{
-						pit		  = tbl->emplace_hint<table>(pit, make_key(i));
+						pit		  = tbl->emplace_hint<node_ptr>(pit, make_key(i), new_node<table>());
 						table& p  = pit->second.ref_cast<table>();
 						p.source_ = pit->first.source();
 
-						dotted_key_tables.push_back(&p);
+						scratch.dotted_key_tables.push_back(&p);
 						tbl = &p;
 					}
 				}
 			}
 
 			// ensure this isn't a redefinition
-			const std::string_view last_segment = key_buffer.back();
+			const std::string_view last_segment = scratch.key_buffer.back();
 			auto it								= tbl->lower_bound(last_segment);
 			if (it != tbl->end() && it->first == last_segment)
 			{
 				set_error("cannot redefine existing "sv,
 						  to_sv(it->second.type()),
 						  " '"sv,
-						  to_sv(recording_buffer),
+						  to_sv(scratch.recording_buffer),
 						  "'"sv);
 				return_after_error({});
 			}
 
 			// create the key first since the key buffer will likely get overwritten during value parsing (inline
 			// tables)
-			auto last_key = make_key(key_buffer.size() - 1u);
+			auto last_key = make_key(scratch.key_buffer.size() - 1u);
 
 			// now we can actually parse the value
 			node_ptr val = parse_value();
@@ -15942,8 +22100,6 @@ TOML_IMPL_NAMESPACE_START
 			assert_not_eof();
 			push_parse_scope("root table"sv);
 
-			table* current_table = &root;
-
 			do
 			{
 				return_if_error();
@@ -15979,6 +22135,12 @@ TOML_IMPL_NAMESPACE_START
 					set_error("expected keys, tables, whitespace or comments, saw '"sv, to_sv(cp), "'"sv);
 			}
 			while (!is_eof());
+		}
+
+		void finish_document()
+		{
+			if (!track_sources)
+				return;
 
 			auto eof_pos	 = current_position(1);
 			root.source_.end = eof_pos;
@@ -16011,7 +22173,10 @@ TOML_IMPL_NAMESPACE_START
 			else // arrays
 			{
 				auto& arr = nde.ref_cast<array>();
-				auto end  = nde.source_.end;
+				if (arr.is_packed()) // (the values don't have regions)
+					return;
+
+				auto end = nde.source_.end;
 				for (auto&& v : arr)
 				{
 					update_region_ends(v);
@@ -16022,11 +22187,31 @@ TOML_IMPL_NAMESPACE_START
 			}
 		}
 
+		void apply_flags(parse_flags flags)
+		{
+			if (!!(flags & parse_flags::arena_allocation))
+			{
+				root.arena_ = arena_ref{ new node_arena{ scratch.arena_size_hint } };
+				arena = root.arena_.get();
+			}
+
+			track_sources  = !(flags & parse_flags::no_source_tracking);
+			compact_arrays = !!(flags & parse_flags::compact_arrays);
+			pack_arrays	   = compact_arrays || !!(flags & parse_flags::packed_arrays);
+			borrow_strings = utf8_buffered_reader<Reader>::is_contiguous && !!(flags & parse_flags::borrowed_strings);
+			root.source_   = make_source_region(prev_pos, prev_pos);
+		}
+
 	  public:
-		parser(utf8_reader_interface&& reader_) //
-			: reader{ reader_ }
+		parser(Reader&& reader_, parse_flags flags = {}, parse_scratch* borrowed_scratch = nullptr) //
+			: reader{ reader_ },
+			  scratch{ borrowed_scratch ? *borrowed_scratch : own_scratch }
 		{
-			root.source_ = { prev_pos, prev_pos, reader.source_path() };
+			// whatever a previous document left behind (e.g. if it threw part-way through) isn't relevant
+			if (borrowed_scratch)
+				scratch.clear();
+
+			apply_flags(flags);
 
 			if (!reader.peek_eof())
 			{
@@ -16041,15 +22226,74 @@ TOML_IMPL_NAMESPACE_START
 #endif
 
 				if (cp)
+				{
 					parse_document();
+					finish_document();
+				}
+			}
+
+			if (track_sources)
+				update_region_ends(root);
+		}
+
+		// documents that arrive in pieces (see toml::push_parser) are parsed a batch of whole expressions at a time;
+		// the reader is pointed at each batch in turn and parse_next() called, then finish() once there are no more.
+		struct push_mode_t
+		{};
+
+		parser(Reader& reader_, push_mode_t, parse_flags flags = {}) //
+			: reader{ reader_ },
+			  scratch{ own_scratch }
+		{
+			// the chunks are gone by the time the document is finished, so there's nothing to borrow strings from
+			apply_flags(flags & ~parse_flags::borrowed_strings);
+		}
+
+		// returns false if there was an error (so there's no point reading any more of the document)
+		bool parse_next()
+		{
+			return_if_error(false);
+
+			cp = reader.read_next();
+
+#if !TOML_EXCEPTIONS
+			if (reader.error())
+			{
+				err = std::move(reader.error());
+				return false;
+			}
+#endif
+
+			if (cp)
+			{
+				parse_document();
+				parsed_any = true;
 			}
 
-			update_region_ends(root);
+			return_if_error(false);
+
+			// (the batch is gone by the time the next one arrives, so its line and column can't be worked out later)
+			prev_pos = reader.resolve(prev_pos);
+			return true;
+		}
+
+		void finish()
+		{
+			return_if_error();
+
+			if (parsed_any)
+				finish_document();
+			if (track_sources)
+				update_region_ends(root);
 		}
 
 		TOML_NODISCARD
 		operator parse_result() && noexcept
 		{
+			if (arena)
+				scratch.arena_size_hint = arena->used();
+			spare_value.reset(); // (might be in the arena)
+
 #if TOML_EXCEPTIONS
 
 			return { std::move(root) };
@@ -16065,8 +22309,8 @@ TOML_IMPL_NAMESPACE_START
 		}
 	};
 
-	TOML_EXTERNAL_LINKAGE
-	node_ptr parser::parse_array()
+	template <typename Reader>
+	node_ptr parser<Reader>::parse_array()
 	{
 		return_if_error({});
 		assert_not_eof();
@@ -16076,7 +22320,7 @@ TOML_IMPL_NAMESPACE_START
 		// skip opening '['
 		advance_and_return_if_error_or_eof({});
 
-		node_ptr arr_ptr{ new array{} };
+		node_ptr arr_ptr = new_node<array>();
 		array& arr = arr_ptr->ref_cast<array>();
 		enum class TOML_CLOSED_ENUM parse_type : int
 		{
@@ -16124,6 +22368,9 @@ TOML_IMPL_NAMESPACE_START
 				auto val = parse_value();
 				return_if_error({});
 
+				if (pack_arrays && append_packed(arr, val))
+					continue;
+
 				if (!arr.capacity())
 					arr.reserve(4u);
 				arr.emplace_back<node_ptr>(std::move(val));
@@ -16134,8 +22381,8 @@ TOML_IMPL_NAMESPACE_START
 		return arr_ptr;
 	}
 
-	TOML_EXTERNAL_LINKAGE
-	node_ptr parser::parse_inline_table()
+	template <typename Reader>
+	node_ptr parser<Reader>::parse_inline_table()
 	{
 		return_if_error({});
 		assert_not_eof();
@@ -16145,10 +22392,10 @@ TOML_IMPL_NAMESPACE_START
 		// skip opening '{'
 		advance_and_return_if_error_or_eof({});
 
-		node_ptr tbl_ptr{ new table{} };
+		node_ptr tbl_ptr = new_node<table>();
 		table& tbl = tbl_ptr->ref_cast<table>();
 		tbl.is_inline(true);
-		table_vector_scope table_scope{ open_inline_tables, tbl };
+		table_vector_scope table_scope{ scratch.open_inline_tables, tbl };
 
 		enum class TOML_CLOSED_ENUM parse_type : int
 		{
@@ -16219,6 +22466,8 @@ TOML_IMPL_NAMESPACE_START
 		return tbl_ptr;
 	}
 
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 }
 TOML_IMPL_NAMESPACE_END;
@@ -16248,16 +22497,139 @@ TOML_IMPL_NAMESPACE_END;
 
 TOML_ANON_NAMESPACE_START
 {
+	template <typename Reader>
 	TOML_NODISCARD
 	TOML_INTERNAL_LINKAGE
-	parse_result do_parse(utf8_reader_interface && reader)
+	parse_result do_parse(Reader && reader, parse_flags flags, impl::parse_scratch* scratch = nullptr)
 	{
-		return impl::parser{ std::move(reader) };
+		static_assert(!std::is_reference_v<Reader>);
+		if constexpr (!utf8_buffered_reader<Reader>::is_contiguous)
+		{
+			if (scratch)
+				reader.use_chunk_buffer(scratch->chunk_buffer);
+		}
+		return impl::parser<Reader>{ std::move(reader), flags, scratch };
 	}
 
+	// read-only memory mapping of a regular file; lets parse_file() hand the file contents straight to the
+	// string_view reader without copying them anywhere first (or going through iostreams for large files).
+	// any failure just leaves the mapping empty so the caller can fall back to the regular file I/O path.
+	class memory_mapped_file
+	{
+	  private:
+		const char* data_ = {};
+		size_t size_	  = {};
+
+	  public:
+		TOML_NODISCARD_CTOR
+		memory_mapped_file() noexcept = default;
+
+		TOML_NODISCARD
+		bool map(const std::string& file_path) noexcept
+		{
+#if TOML_WINDOWS
+
+			const auto wide_path = impl::widen(file_path);
+			void* const invalid_handle = reinterpret_cast<void*>(static_cast<intptr_t>(-1));
+			void* const file		   = ::CreateFileW(wide_path.c_str(),
+											   0x80000000ul, // GENERIC_READ
+											   0x00000001ul, // FILE_SHARE_READ
+											   nullptr,
+											   3ul,			 // OPEN_EXISTING
+											   0x00000080ul, // FILE_ATTRIBUTE_NORMAL
+											   nullptr);
+			if (file == invalid_handle)
+				return false;
+
+			bool ok = false;
+			if (::GetFileType(file) == 0x0001ul) // FILE_TYPE_DISK
+			{
+				unsigned long size_high = {};
+				const auto size_low		= ::GetFileSize(file, &size_high);
+				const auto size			= (static_cast<uint64_t>(size_high) << 32) | size_low;
+				if (size_low != 0xFFFFFFFFul && size <= static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+				{
+					if (!size)
+						ok = true;
+					else if (void* const mapping = ::CreateFileMappingW(file, nullptr, 0x02ul, 0ul, 0ul, nullptr))
+					{
+						// the view keeps the underlying mapping object alive after its handle is closed
+						data_ = static_cast<const char*>(::MapViewOfFile(mapping, 0x0004ul, 0ul, 0ul, 0u));
+						::CloseHandle(mapping);
+						if (data_)
+						{
+							size_ = static_cast<size_t>(size);
+							ok = true;
+						}
+					}
+				}
+			}
+			::CloseHandle(file);
+			return ok;
+
+#elif TOML_UNIX || defined(__APPLE__)
+
+			const int fd = ::open(file_path.c_str(), O_RDONLY);
+			if (fd == -1)
+				return false;
+
+			bool ok = false;
+			struct stat st;
+			if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size >= 0
+				&& static_cast<uint64_t>(st.st_size) <= static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+			{
+				if (!st.st_size)
+					ok = true;
+				else
+				{
+					const auto size = static_cast<size_t>(st.st_size);
+					void* const ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+					if (ptr != MAP_FAILED)
+					{
+#ifdef POSIX_MADV_SEQUENTIAL
+						::posix_madvise(ptr, size, POSIX_MADV_SEQUENTIAL);
+#endif
+						data_ = static_cast<const char*>(ptr);
+						size_ = size;
+						ok = true;
+					}
+				}
+			}
+			::close(fd); // the mapping keeps its own reference to the file
+			return ok;
+
+#else
+
+			TOML_UNUSED(file_path);
+			return false;
+
+#endif
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view view() const noexcept
+		{
+			return { data_, size_ };
+		}
+
+		~memory_mapped_file() noexcept
+		{
+			if (!data_)
+				return;
+
+#if TOML_WINDOWS
+			::UnmapViewOfFile(data_);
+#elif TOML_UNIX || defined(__APPLE__)
+			::munmap(const_cast<char*>(data_), size_);
+#endif
+		}
+
+		TOML_DELETE_DEFAULTS(memory_mapped_file);
+	};
+
 	TOML_NODISCARD
 	TOML_INTERNAL_LINKAGE
-	parse_result do_parse_file(std::string_view file_path)
+	parse_result do_parse_file(std::string_view file_path, parse_flags flags, impl::parse_scratch* scratch = nullptr)
 	{
 #if TOML_EXCEPTIONS
 #define TOML_PARSE_FILE_ERROR(msg, path)                                                                               \
@@ -16269,6 +22641,16 @@ TOML_ANON_NAMESPACE_START
 
 		std::string file_path_str(file_path);
 
+		// the file's contents only live as long as this function, so strings can't be borrowed from them
+		flags &= ~parse_flags::borrowed_strings;
+
+		// try memory-mapping the file first so it can be parsed in-place, regardless of size
+		{
+			memory_mapped_file mapped_file;
+			if (mapped_file.map(file_path_str))
+				return do_parse(utf8_reader{ mapped_file.view(), std::move(file_path_str) }, flags, scratch);
+		}
+
 		// open file with a custom-sized stack buffer
 		std::ifstream file;
 		TOML_OVERALIGNED char file_buffer[sizeof(void*) * 1024u];
@@ -16294,73 +22676,328 @@ TOML_ANON_NAMESPACE_START
 			std::vector<char> file_data;
 			file_data.resize(static_cast<size_t>(file_size));
 			file.read(file_data.data(), static_cast<std::streamsize>(file_size));
-			return parse(std::string_view{ file_data.data(), file_data.size() }, std::move(file_path_str));
+			const auto file_view = std::string_view{ file_data.data(), file_data.size() };
+			return do_parse(utf8_reader{ file_view, std::move(file_path_str) }, flags, scratch);
 		}
 
 		// otherwise parse it using the streams
 		else
-			return parse(file, std::move(file_path_str));
+			return do_parse(utf8_reader{ file, std::move(file_path_str) }, flags, scratch);
 
 #undef TOML_PARSE_FILE_ERROR
 	}
+
+	// finds the ends of complete top-level expressions in a document that's arriving in pieces.
+	// it only needs to understand enough of the grammar to tell whether a line break actually ends an expression
+	// (i.e. isn't inside a comment, string, array or inline table); the parser proper deals with everything else.
+	class expression_boundary_scanner
+	{
+	  private:
+		enum class TOML_CLOSED_ENUM mode_type : uint8_t
+		{
+			expression,
+			comment,
+			basic_string,
+			literal_string,
+			multi_line_basic_string,
+			multi_line_literal_string
+		};
+
+		mode_type mode_ = mode_type::expression;
+		size_t depth_	= {}; // of [brackets] and {braces}
+		size_t pos_		= {}; // how much of the pending data has been scanned already
+
+	  public:
+		// scans the pending data from wherever the last call left off, returning the end of the last complete
+		// expression found (or zero if there weren't any). stops early if it would have to look past the end of
+		// the data to work out what something is (e.g. whether a quote starts a multi-line string).
+		TOML_NODISCARD
+		size_t scan(std::string_view data) noexcept
+		{
+			const auto s = data.data();
+			const auto n = data.length();
+			size_t end	 = {};
+			size_t i	 = pos_;
+
+			while (i < n)
+			{
+				const auto c = s[i];
+				switch (mode_)
+				{
+					case mode_type::expression:
+					{
+						if (c == '\n')
+						{
+							if (!depth_)
+								end = i + 1u;
+						}
+						else if (c == '#')
+							mode_ = mode_type::comment;
+						else if (c == '[' || c == '{')
+							depth_++;
+						else if ((c == ']' || c == '}') && depth_)
+							depth_--;
+						else if (c == '"' || c == '\'')
+						{
+							if (n - i < 3u)
+								goto done;
+
+							if (s[i + 1u] != c)
+								mode_ = c == '"' ? mode_type::basic_string : mode_type::literal_string;
+							else if (s[i + 2u] != c) // empty string
+								i++;
+							else
+							{
+								mode_ = c == '"' ? mode_type::multi_line_basic_string
+												 : mode_type::multi_line_literal_string;
+								i += 2u;
+							}
+						}
+						break;
+					}
+
+					case mode_type::comment:
+					{
+						const auto nl = static_cast<const char*>(std::memchr(s + i, '\n', n - i));
+						if (!nl)
+						{
+							i = n;
+							continue;
+						}
+						i	  = static_cast<size_t>(nl - s);
+						mode_ = mode_type::expression;
+						continue; // the line break ends the expression too
+					}
+
+					case mode_type::basic_string: [[fallthrough]];
+					case mode_type::literal_string:
+					{
+						if (c == '\\' && mode_ == mode_type::basic_string)
+						{
+							if (n - i < 2u)
+								goto done;
+							i++;
+						}
+						else if (c == (mode_ == mode_type::basic_string ? '"' : '\''))
+							mode_ = mode_type::expression;
+						else if (c == '\n')
+						{
+							// unterminated; the parser will complain about it, but it might look a character or so
+							// past the line break first, so this one doesn't count as the end of the expression
+							mode_ = mode_type::expression;
+						}
+						break;
+					}
+
+					case mode_type::multi_line_basic_string: [[fallthrough]];
+					case mode_type::multi_line_literal_string:
+					{
+						const auto delim = mode_ == mode_type::multi_line_basic_string ? '"' : '\'';
+						if (c == '\\' && delim == '"')
+						{
+							if (n - i < 2u)
+								goto done;
+							i++;
+						}
+						else if (c == delim)
+						{
+							// a run of 3-5 closes the string (up to two of them being part of the string)
+							auto j = i + 1u;
+							while (j < n && s[j] == delim)
+								j++;
+							if (j == n)
+								goto done;
+							if (j - i >= 3u)
+								mode_ = mode_type::expression;
+							i = j;
+							continue;
+						}
+						break;
+					}
+
+					default: TOML_UNREACHABLE;
+				}
+				i++;
+			}
+
+		done:
+			pos_ = i;
+			return end;
+		}
+
+		// lets the scanner know the first 'count' bytes of the pending data have been parsed and discarded
+		void consumed(size_t count) noexcept
+		{
+			TOML_ASSERT_ASSUME(count <= pos_);
+			pos_ -= count;
+		}
+	};
+
+	// all the chunks handed to a push_parser are scanned for the ends of top-level expressions, and everything up to
+	// the last one is parsed; whatever's left is held over for the next chunk (or finish()). the parser and reader
+	// stick around between chunks so the document's tables and source positions carry on where they left off.
+	class push_parser_impl final : public impl::push_parser_state
+	{
+	  private:
+		using reader_type = utf8_reader<std::string_view>;
+
+		std::string pending_;
+		expression_boundary_scanner scanner_;
+		reader_type reader_;
+		impl::parser<reader_type> parser_;
+		bool bom_checked_ = false;
+		bool failed_	  = false;
+
+		void parse(std::string_view expressions)
+		{
+			reader_.reset(expressions);
+			failed_ = true;
+			failed_ = !parser_.parse_next();
+			if (!failed_)
+				reader_.finish_piece();
+		}
+
+	  public:
+		template <typename String>
+		TOML_NODISCARD_CTOR
+		explicit push_parser_impl(String&& source_path, parse_flags flags) //
+			: reader_{ std::string_view{}, static_cast<String&&>(source_path) },
+			  parser_{ reader_, impl::parser<reader_type>::push_mode_t{}, flags }
+		{}
+
+		void feed(std::string_view chunk) override
+		{
+			TOML_ASSERT(!failed_ || !TOML_EXCEPTIONS);
+			if (failed_ || chunk.empty())
+				return;
+
+			// when nothing was held over from the previous chunk, whole expressions are parsed straight out of
+			// this one and only the leftovers are copied
+			std::string_view data = chunk;
+
+			// the byte order mark (if any) can only appear at the very start of the document
+			if (!bom_checked_)
+			{
+				pending_.append(chunk);
+				const auto len = impl::min(pending_.length(), size_t{ 3u });
+				if (memcmp(utf8_byte_order_mark.data(), pending_.data(), len) == 0)
+				{
+					if (len < 3u)
+						return;
+					pending_.erase(0u, 3u);
+					reader_.skipped_bom();
+				}
+				bom_checked_ = true;
+				data		 = pending_;
+			}
+			else if (!pending_.empty())
+			{
+				pending_.append(chunk);
+				data = pending_;
+			}
+
+			const auto end = scanner_.scan(data);
+			if (end)
+			{
+				parse(data.substr(0u, end));
+				if (failed_)
+				{
+					pending_.clear();
+					return;
+				}
+				scanner_.consumed(end);
+			}
+
+			if (data.data() == pending_.data())
+				pending_.erase(0u, end);
+			else
+				pending_.assign(data.substr(end));
+		}
+
+		TOML_NODISCARD
+		parse_result finish() override
+		{
+			if (!failed_ && !pending_.empty())
+				parse(pending_);
+
+			parser_.finish();
+			return static_cast<parse_result>(std::move(parser_));
+		}
+	};
 }
 TOML_ANON_NAMESPACE_END;
 
 TOML_NAMESPACE_START
 {
 	TOML_ABI_NAMESPACE_BOOL(TOML_EXCEPTIONS, ex, noex);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_PMR, parse_pmralloc, parse_stdalloc);
+	TOML_ABI_NAMESPACE_BOOL(TOML_ENABLE_FLAT_TABLES, flattbl, maptbl);
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result TOML_CALLCONV parse(std::string_view doc, std::string_view source_path, parse_flags flags)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path }, flags);
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result TOML_CALLCONV parse(std::string_view doc, std::string && source_path, parse_flags flags)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) }, flags);
+	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string_view source_path)
+	parse_result TOML_CALLCONV parse(std::istream & doc, std::string_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::string && source_path)
+	parse_result TOML_CALLCONV parse(std::istream & doc, std::string && source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string_view source_path)
+	parse_result TOML_CALLCONV parse(byte_source doc, std::string_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, source_path }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::string && source_path)
+	parse_result TOML_CALLCONV parse(byte_source doc, std::string && source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(
+			TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, std::move(source_path) },
+			flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse_file(std::string_view file_path)
+	parse_result TOML_CALLCONV parse_file(std::string_view file_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse_file(file_path);
+		return TOML_ANON_NAMESPACE::do_parse_file(file_path, flags);
 	}
 
 #if TOML_HAS_CHAR8
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string_view source_path)
+	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string && source_path)
+	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::string && source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path)
+	parse_result TOML_CALLCONV parse_file(std::u8string_view file_path, parse_flags flags)
 	{
 		std::string file_path_str;
 		file_path_str.resize(file_path.length());
 		memcpy(file_path_str.data(), file_path.data(), file_path.length());
-		return TOML_ANON_NAMESPACE::do_parse_file(file_path_str);
+		return TOML_ANON_NAMESPACE::do_parse_file(file_path_str, flags);
 	}
 
 #endif // TOML_HAS_CHAR8
@@ -16368,21 +23005,29 @@ TOML_NAMESPACE_START
 #if TOML_ENABLE_WINDOWS_COMPAT
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::string_view doc, std::wstring_view source_path)
+	parse_result TOML_CALLCONV parse(std::string_view doc, std::wstring_view source_path, parse_flags flags)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) }, flags);
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result TOML_CALLCONV parse(std::istream & doc, std::wstring_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) }, flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::istream & doc, std::wstring_view source_path)
+	parse_result TOML_CALLCONV parse(byte_source doc, std::wstring_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(
+			TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, impl::narrow(source_path) },
+			flags);
 	}
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path)
+	parse_result TOML_CALLCONV parse_file(std::wstring_view file_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse_file(impl::narrow(file_path));
+		return TOML_ANON_NAMESPACE::do_parse_file(impl::narrow(file_path), flags);
 	}
 
 #endif // TOML_ENABLE_WINDOWS_COMPAT
@@ -16390,13 +23035,109 @@ TOML_NAMESPACE_START
 #if TOML_HAS_CHAR8 && TOML_ENABLE_WINDOWS_COMPAT
 
 	TOML_EXTERNAL_LINKAGE
-	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::wstring_view source_path)
+	parse_result TOML_CALLCONV parse(std::u8string_view doc, std::wstring_view source_path, parse_flags flags)
 	{
-		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) });
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, impl::narrow(source_path) }, flags);
 	}
 
 #endif // TOML_HAS_CHAR8 && TOML_ENABLE_WINDOWS_COMPAT
 
+	TOML_EXTERNAL_LINKAGE
+	push_parser::push_parser(std::string_view source_path, parse_flags flags) //
+		: state_{ new TOML_ANON_NAMESPACE::push_parser_impl{ source_path, flags } }
+	{}
+
+	TOML_EXTERNAL_LINKAGE
+	push_parser::push_parser(std::string && source_path, parse_flags flags) //
+		: state_{ new TOML_ANON_NAMESPACE::push_parser_impl{ std::move(source_path), flags } }
+	{}
+
+#if TOML_ENABLE_WINDOWS_COMPAT
+
+	TOML_EXTERNAL_LINKAGE
+	push_parser::push_parser(std::wstring_view source_path, parse_flags flags) //
+		: state_{ new TOML_ANON_NAMESPACE::push_parser_impl{ impl::narrow(source_path), flags } }
+	{}
+
+#endif
+
+	TOML_EXTERNAL_LINKAGE
+	void push_parser::feed(std::string_view chunk)
+	{
+		TOML_ASSERT_ASSUME(state_);
+		state_->feed(chunk);
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result push_parser::finish()
+	{
+		TOML_ASSERT_ASSUME(state_);
+		return state_->finish();
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context::parse_context(parse_flags flags) //
+		: scratch_{ new impl::parse_scratch{} },
+		  flags_{ flags }
+	{}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context::parse_context(parse_context&&) noexcept = default;
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context& parse_context::operator=(parse_context&&) noexcept = default;
+
+	TOML_EXTERNAL_LINKAGE
+	parse_context::~parse_context() noexcept = default;
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::string_view doc, std::string_view source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::string_view doc, std::string && source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::istream & doc, std::string_view source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, source_path },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(std::istream & doc, std::string && source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader{ doc, std::move(source_path) },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse(byte_source doc, std::string_view source_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse(TOML_ANON_NAMESPACE::utf8_reader<byte_source>{ doc, source_path },
+											 flags_,
+											 scratch_.get());
+	}
+
+	TOML_EXTERNAL_LINKAGE
+	parse_result parse_context::parse_file(std::string_view file_path)
+	{
+		return TOML_ANON_NAMESPACE::do_parse_file(file_path, flags_, scratch_.get());
+	}
+
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_FLAT_TABLES
+	TOML_ABI_NAMESPACE_END; // TOML_ENABLE_PMR
 	TOML_ABI_NAMESPACE_END; // TOML_EXCEPTIONS
 }
 TOML_NAMESPACE_END;
@@ -16768,7 +23509,7 @@ TOML_IMPL_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void formatter::print(const value<std::string>& val)
 	{
-		print_string(val.get());
+		print_string(val.view());
 	}
 
 	TOML_EXTERNAL_LINKAGE
@@ -16996,7 +23737,7 @@ TOML_ANON_NAMESPACE_START
 			{
 				// todo: proper utf8 decoding?
 				// todo: tab awareness?
-				auto& str = (*reinterpret_cast<const value<std::string>*>(&node)).get();
+				const auto str = (*reinterpret_cast<const value<std::string>*>(&node)).view();
 				return str.length() + 2u; // + ""
 			}
 
@@ -17490,14 +24231,15 @@ TOML_NAMESPACE_START
 	TOML_EXTERNAL_LINKAGE
 	void yaml_formatter::print_yaml_string(const value<std::string>& str)
 	{
-		if (str->empty())
+		const auto text = str.view();
+		if (text.empty())
 		{
 			base::print(str);
 			return;
 		}
 
 		bool contains_newline = false;
-		for (auto c = str->c_str(), e = str->c_str() + str->length(); c < e && !contains_newline; c++)
+		for (auto c = text.data(), e = text.data() + text.length(); c < e && !contains_newline; c++)
 			contains_newline = *c == '\n';
 
 		if (contains_newline)
@@ -17506,8 +24248,8 @@ TOML_NAMESPACE_START
 
 			increase_indent();
 
-			auto line_end  = str->c_str() - 1u;
-			const auto end = str->c_str() + str->length();
+			auto line_end  = text.data() - 1u;
+			const auto end = text.data() + text.length();
 			while (line_end != end)
 			{
 				auto line_start = line_end + 1u;
@@ -17526,7 +24268,7 @@ TOML_NAMESPACE_START
 			decrease_indent();
 		}
 		else
-			print_string(*str, false, true);
+			print_string(text, false, true);
 	}
 
 	TOML_EXTERNAL_LINKAGE
@@ -17667,6 +24409,8 @@ TOML_POP_WARNINGS;
 #undef TOML_ASSUME
 #undef TOML_ASYMMETRICAL_EQUALITY_OPS
 #undef TOML_ATTR
+#undef TOML_AVX2_KERNELS
+#undef TOML_AVX2_TARGET
 #undef TOML_CLANG
 #undef TOML_CLANG_VERSION
 #undef TOML_CLOSED_ENUM
@@ -17714,6 +24458,7 @@ TOML_POP_WARNINGS;
 #undef TOML_HAS_CUSTOM_OPTIONAL_TYPE
 #undef TOML_HAS_FEATURE
 #undef TOML_HAS_INCLUDE
+#undef TOML_HAS_AVX2
 #undef TOML_HAS_SSE2
 #undef TOML_HAS_SSE4_1
 #undef TOML_HIDDEN_CONSTRAINT
@@ -17784,7 +24529,12 @@ TOML_POP_WARNINGS;
 #undef TOML_SA_VALUE_MESSAGE_CONST_CHAR8
 #undef TOML_SA_VALUE_MESSAGE_U8STRING_VIEW
 #undef TOML_SA_VALUE_MESSAGE_WSTRING
+#undef TOML_SIMD_DISPATCH
 #undef TOML_SIMPLE_STATIC_ASSERT_MESSAGES
+#undef TOML_SSE2_KERNELS
+#undef TOML_SSE2_TARGET
+#undef TOML_SSE4_1_KERNELS
+#undef TOML_SSE4_1_TARGET
 #undef TOML_TRIVIAL_ABI
 #undef TOML_UINT128
 #undef TOML_UNIX
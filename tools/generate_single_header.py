@@ -211,8 +211,10 @@ def main():
 				r'TOML_CONCAT_1',
 				r'TOML_CONFIG_HEADER',
 				r'TOML_CUDA',
+				r'TOML_ENABLE_FLAT_TABLES',
 				r'TOML_ENABLE_FORMATTERS',
 				r'TOML_ENABLE_PARSER',
+				r'TOML_ENABLE_PMR',
 				r'TOML_ENABLE_SIMD',
 				r'TOML_ENABLE_UNRELEASED_FEATURES',
 				r'TOML_ENABLE_WINDOWS_COMPAT',
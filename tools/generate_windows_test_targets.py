@@ -139,6 +139,7 @@ def main():
 		<ClCompile Include="..\parsing_comments.cpp" />
 		<ClCompile Include="..\parsing_dates_and_times.cpp" />
 		<ClCompile Include="..\parsing_floats.cpp" />
+		<ClCompile Include="..\parsing_inputs.cpp" />
 		<ClCompile Include="..\parsing_integers.cpp" />
 		<ClCompile Include="..\parsing_key_value_pairs.cpp" />
 		<ClCompile Include="..\parsing_spec_example.cpp" />